@@ -0,0 +1,180 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Defines non-owning views on result data that can be handed to host languages without copying.
+ */
+
+#ifndef LIBCADET_DATAVIEW_HPP_
+#define LIBCADET_DATAVIEW_HPP_
+
+#include "cadet/LibExportImport.hpp"
+#include "cadet/cadetCompilerInfo.hpp"
+
+#include <cstddef>
+
+/**
+ * @brief Maximum number of dimensions of a DataView
+ */
+#define CADET_DATAVIEW_MAX_RANK 6
+
+namespace cadet
+{
+
+	class ISimulator;
+
+	/**
+	 * @brief Element type of a DataView
+	 */
+	enum class DataViewType : int
+	{
+		Double = 0, //!< IEEE 754 double precision (8 bytes)
+		Single = 1 //!< IEEE 754 single precision (4 bytes)
+	};
+
+	/**
+	 * @brief Non-owning view on a strided multi-dimensional array
+	 * @details The view describes the memory of a dataset by a pointer to its first element,
+	 *          the extent of each dimension (shape), and the distance in bytes between two
+	 *          consecutive elements of each dimension (strides). This matches the array
+	 *          interfaces of common host languages (e.g., Python buffer protocol, NumPy, Julia,
+	 *          MATLAB) such that the data can be wrapped without copying.
+	 *
+	 *          The memory is owned by the object that created the view. The view is invalidated
+	 *          when the owner modifies the dataset (e.g., by recording additional time points,
+	 *          by a subsequent simulation, or by reconfiguration) or is destroyed.
+	 *
+	 *          Datasets that are not available are represented by views with @c nullptr data
+	 *          and rank @c 0.
+	 *
+	 *          The type is a standard layout type and can be passed through the C API.
+	 */
+	struct DataView
+	{
+		void const* data; //!< Pointer to the first element or @c nullptr
+		DataViewType type; //!< Element type
+		unsigned int rank; //!< Number of dimensions
+		std::size_t shape[CADET_DATAVIEW_MAX_RANK]; //!< Extent of each dimension (only the first @c rank elements are used)
+		std::ptrdiff_t strides[CADET_DATAVIEW_MAX_RANK]; //!< Distance between consecutive elements of each dimension in bytes (only the first @c rank elements are used)
+	};
+
+	/**
+	 * @brief Returns the size of an element of a DataView in bytes
+	 * @param [in] type Element type
+	 * @return Size of an element in bytes
+	 */
+	inline std::size_t elementSize(DataViewType type) CADET_NOEXCEPT
+	{
+		return (type == DataViewType::Single) ? sizeof(float) : sizeof(double);
+	}
+
+	/**
+	 * @brief Creates a view on a contiguous array in row-major (C) order
+	 * @details If @p rank exceeds CADET_DATAVIEW_MAX_RANK or @p data is @c nullptr, an empty view is returned.
+	 * @param [in] data Pointer to the first element
+	 * @param [in] type Element type
+	 * @param [in] shape Extent of each dimension
+	 * @param [in] rank Number of dimensions
+	 * @return View on the given array
+	 */
+	inline DataView makeContiguousView(void const* data, DataViewType type, std::size_t const* shape, unsigned int rank) CADET_NOEXCEPT
+	{
+		DataView view;
+		view.data = nullptr;
+		view.type = type;
+		view.rank = 0;
+		for (unsigned int i = 0; i < CADET_DATAVIEW_MAX_RANK; ++i)
+		{
+			view.shape[i] = 0;
+			view.strides[i] = 0;
+		}
+
+		if (!data || (rank > CADET_DATAVIEW_MAX_RANK))
+			return view;
+
+		view.data = data;
+		view.rank = rank;
+
+		std::ptrdiff_t stride = static_cast<std::ptrdiff_t>(elementSize(type));
+		for (unsigned int i = rank; i > 0; --i)
+		{
+			view.shape[i-1] = shape[i-1];
+			view.strides[i-1] = stride;
+			stride *= static_cast<std::ptrdiff_t>(shape[i-1]);
+		}
+
+		return view;
+	}
+
+	/**
+	 * @brief Returns the total number of elements in a DataView
+	 * @param [in] view View
+	 * @return Number of elements
+	 */
+	inline std::size_t numElements(const DataView& view) CADET_NOEXCEPT
+	{
+		if (!view.data)
+			return 0;
+
+		std::size_t n = 1;
+		for (unsigned int i = 0; i < view.rank; ++i)
+			n *= view.shape[i];
+		return n;
+	}
+
+} // namespace cadet
+
+extern "C"
+{
+	/**
+	 * @brief Returns a view on the state vector of the last time point of a simulator
+	 * @details The view is one-dimensional and refers to the internal state of the simulator.
+	 *          It is invalidated by the next call to @c ISimulator::integrate() or by
+	 *          reconfiguration of the simulator.
+	 * @param [in] sim Simulator
+	 * @param [out] view View on the state vector
+	 * @return @c 0 on success, a negative value if @p sim or @p view is @c NULL
+	 */
+	CADET_API int cadetGetLastStateView(cadet::ISimulator const* sim, cadet::DataView* view);
+
+	/**
+	 * @brief Returns a view on the time derivative of the state vector of the last time point of a simulator
+	 * @details See cadetGetLastStateView().
+	 * @param [in] sim Simulator
+	 * @param [out] view View on the time derivative of the state vector
+	 * @return @c 0 on success, a negative value if @p sim or @p view is @c NULL
+	 */
+	CADET_API int cadetGetLastStateDerivativeView(cadet::ISimulator const* sim, cadet::DataView* view);
+
+	/**
+	 * @brief Returns a view on a sensitivity state vector of the last time point of a simulator
+	 * @details See cadetGetLastStateView().
+	 * @param [in] sim Simulator
+	 * @param [in] sensIdx Index of the sensitivity
+	 * @param [out] view View on the sensitivity state vector
+	 * @return @c 0 on success, a negative value if @p sim or @p view is @c NULL or if @p sensIdx is out of range
+	 */
+	CADET_API int cadetGetLastSensitivityView(cadet::ISimulator const* sim, unsigned int sensIdx, cadet::DataView* view);
+
+	/**
+	 * @brief Returns a view on the time derivative of a sensitivity state vector of the last time point of a simulator
+	 * @details See cadetGetLastStateView().
+	 * @param [in] sim Simulator
+	 * @param [in] sensIdx Index of the sensitivity
+	 * @param [out] view View on the time derivative of the sensitivity state vector
+	 * @return @c 0 on success, a negative value if @p sim or @p view is @c NULL or if @p sensIdx is out of range
+	 */
+	CADET_API int cadetGetLastSensitivityDerivativeView(cadet::ISimulator const* sim, unsigned int sensIdx, cadet::DataView* view);
+}
+
+#endif  // LIBCADET_DATAVIEW_HPP_
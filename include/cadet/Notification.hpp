@@ -78,6 +78,42 @@ public:
 	virtual bool timeIntegrationStep(unsigned int section, double time, double const* state, double const* stateDot, double progress) = 0;
 };
 
+/**
+ * @brief Defines callback functions for saving and restoring checkpoints of an ISimulator
+ * @details A checkpoint consists of the opaque state of the simulator, which contains the
+ *          state of the time integrator and the model, and the data recorded so far.
+ *          The simulator handles its own state, whereas this callback is responsible for
+ *          persisting it and for saving and restoring the recorded data.
+ */
+class CADET_API ICheckpointCallback
+{
+public:
+	virtual ~ICheckpointCallback() CADET_NOEXCEPT { }
+
+	/**
+	 * @brief Called when a checkpoint is due
+	 * @details The solution recorder contains all data up to (and including) the current time point.
+	 *          The state is only valid during the call.
+	 *
+	 * @param[in]  section   Index of the current time section
+	 * @param[in]  time      Current process time
+	 * @param[in]  state     Opaque state of the simulator
+	 * @param[in]  len       Length of the state array
+	 */
+	virtual void saveCheckpoint(unsigned int section, double time, double const* state, unsigned int len) = 0;
+
+	/**
+	 * @brief Called when time integration resumes from a checkpoint
+	 * @details This function is called after the solution recorder has been prepared for time
+	 *          integration, which discards all recorded data. The data recorded up to the
+	 *          checkpoint has to be restored here.
+	 *
+	 * @param[in]  section   Index of the time section of the checkpoint
+	 * @param[in]  time      Process time of the checkpoint
+	 */
+	virtual void resumeFromCheckpoint(unsigned int section, double time) = 0;
+};
+
 } // namespace cadet
 
 #endif  // LIBCADET_NOTIFICATION_HPP_
@@ -34,6 +34,7 @@ class IModelSystem;
 class ISolutionRecorder;
 class IParameterProvider;
 class INotificationCallback;
+class ICheckpointCallback;
 
 enum class ConsistentInitialization : int
 {
@@ -161,6 +162,119 @@ inline bool isValidConsistentInitialization(int ci) CADET_NOEXCEPT
 		&& (ci <= static_cast<typename std::underlying_type<ConsistentInitialization>::type>(ConsistentInitialization::NoneOnceThenLean));
 }
 
+/**
+ * @brief Quantity monitored by an event
+ */
+enum class EventType : int
+{
+	/**
+	 * @brief Concentration of a single component or total concentration at an outlet port
+	 */
+	OutletConcentration = 0,
+	/**
+	 * @brief Ratio of a component's concentration and the total concentration at an outlet port
+	 */
+	OutletPurity = 1,
+	/**
+	 * @brief Single entry of a unit operation's local state vector
+	 */
+	UnitState = 2,
+};
+
+/**
+ * @brief Action performed when an event is triggered
+ */
+enum class EventAction : int
+{
+	/**
+	 * @brief Record the event time and continue time integration
+	 */
+	Record = 0,
+	/**
+	 * @brief Record the event time and stop time integration
+	 */
+	Stop = 1,
+	/**
+	 * @brief Record the event time and start the next section at the event time
+	 * @details All subsequent section times are shifted such that the section durations are preserved.
+	 */
+	NextSection = 2,
+};
+
+/**
+ * @brief Time integration method
+ */
+enum class TimeIntegrator : int
+{
+	/**
+	 * @brief Variable order BDF method of IDAS (SUNDIALS)
+	 */
+	IDAS = 0,
+	/**
+	 * @brief Three-stage Radau IIA method of order 5 (without forward sensitivities, events, and checkpoints)
+	 */
+	RadauIIA = 1,
+};
+
+/**
+ * @brief Specifies an event that is located by root finding during time integration
+ * @details The event is triggered when the monitored quantity crosses the given threshold.
+ */
+struct SimulationEvent
+{
+	EventType type; //!< Monitored quantity
+	UnitOpIdx unitOp; //!< Index of the monitored unit operation
+	unsigned int port; //!< Index of the outlet port (ignored for EventType::UnitState)
+	int component; //!< Component index (@c -1 for total concentration) or index in local state vector for EventType::UnitState
+	double threshold; //!< Value of the monitored quantity at which the event is triggered
+	int direction; //!< Direction of crossing (@c 1: increasing, @c -1: decreasing, @c 0: both)
+	EventAction action; //!< Action performed when the event is triggered
+};
+
+/**
+ * @brief Statistics of a single step of the time integrator
+ * @details Failed attempts (e.g., due to convergence or error test failures) count towards the step
+ *          that is eventually taken.
+ */
+struct StepStatistics
+{
+	double time; //!< Time point of the (last attempt of the) step
+	double stepSize; //!< Size of the (last attempt of the) step
+	unsigned int nNewtonIter; //!< Number of Newton iterations
+	unsigned int nConvFails; //!< Number of nonlinear convergence failures
+	unsigned int nErrTestFails; //!< Number of error test failures
+	unsigned long nLinearIter; //!< Number of iterations of iterative linear solvers
+};
+
+/**
+ * @brief Accumulated statistics of the time integrator over all sections of a call to ISimulator::integrate()
+ * @details The Jacobian of the time integrator is updated along with each residual evaluation and
+ *          factorized in the subsequent linear solve. Hence, the number of Jacobian evaluations equals
+ *          the number of residual evaluations and the number of Jacobian factorizations is bounded by
+ *          the number of linear solves. For TimeIntegrator::RadauIIA, the Jacobian is only updated once
+ *          per step attempt, but each update is also counted as residual evaluation. Linear solves
+ *          include the solves required for preconditioning the complex stage system.
+ */
+struct IntegratorStatistics
+{
+	unsigned long nSteps; //!< Number of time steps
+	unsigned long nResEvals; //!< Number of residual evaluations (including Jacobian updates)
+	unsigned long nLinearSolves; //!< Number of linear solves (Newton iterations)
+	unsigned long nConvFails; //!< Number of nonlinear convergence failures
+	unsigned long nErrTestFails; //!< Number of error test failures
+	unsigned long nLinearIter; //!< Number of iterations of iterative linear solvers
+};
+
+/**
+ * @brief Handle of a parameter resolved by ISimulator::resolveParameterHandles()
+ */
+typedef unsigned int ParameterHandle;
+
+/**
+ * @brief Handle returned by ISimulator::resolveParameterHandles() for parameters that do not exist
+ */
+const ParameterHandle InvalidParameterHandle = static_cast<ParameterHandle>(-1);
+
 /**
  * @brief Provides functionality to simulate a model using a time integrator
  */
@@ -252,6 +366,56 @@ public:
 	//! \param  [in]    value Value of the parameter
 	virtual void setParameterValue(const ParameterId& id, double value) = 0;
 
+	/**
+	 * @brief Resolves parameters to handles for repeated updates
+	 * @details Setting a parameter by its ParameterId requires looking it up in the model system, its
+	 *          unit operations, and their binding and reaction models. The handles returned by this
+	 *          function store the locations of all values (including multiplexed copies) that are
+	 *          affected by a parameter. Updating parameters via setParameterValues() writes the values
+	 *          directly and is equivalent to calling setParameterValue() for each parameter.
+	 *          
+	 *          Parameters whose change requires further updates of the model (e.g., particle radii in
+	 *          the general rate model or inlet parameters) are forwarded to setParameterValue().
+	 *          
+	 *          Resolving a parameter that already has a handle returns the existing handle. Parameters
+	 *          that do not exist receive InvalidParameterHandle.
+	 *          
+	 *          Handles stay valid if the section times are set (also when an event restores shifted
+	 *          section times) and if the model is reconfigured via reconfigureModel(). Handles are
+	 *          invalidated by clearParameterHandles() and initializeModel(). Using an invalidated
+	 *          handle throws an InvalidParameterException.
+	 * @param [in] ids Array with IDs of the parameters
+	 * @param [in] numParams Number of parameters
+	 * @param [out] handles Array of size @p numParams that receives the handles of the parameters
+	 * @return @c true if all parameters exist, otherwise @c false
+	 */
+	virtual bool resolveParameterHandles(ParameterId const* ids, unsigned int numParams, ParameterHandle* handles) = 0;
+
+	/**
+	 * @brief Sets the values of parameters given by their handles
+	 * @details See resolveParameterHandles(). Throws an InvalidParameterException if a handle is
+	 *          invalid (e.g., InvalidParameterHandle or invalidated by clearParameterHandles()). Values
+	 *          preceding the invalid handle have already been set in this case.
+	 * @param [in] handles Array with handles of the parameters
+	 * @param [in] values Array with values of the parameters
+	 * @param [in] numParams Number of parameters
+	 */
+	virtual void setParameterValues(ParameterHandle const* handles, double const* values, unsigned int numParams) = 0;
+
+	/**
+	 * @brief Sets the values of all sensitive parameters
+	 * @details Equivalent to calling setSensitiveParameterValue(unsigned int, double) for each sensitive
+	 *          parameter. The parameters are resolved on first use (see resolveParameterHandles()), which
+	 *          is repeated when sensitive parameters are added or removed.
+	 * @param [in] values Array of size numSensParams() with values of the sensitive parameters
+	 */
+	virtual void setSensitiveParameterValues(double const* values) = 0;
+
+	/**
+	 * @brief Invalidates all parameter handles and releases their memory
+	 */
+	virtual void clearParameterHandles() CADET_NOEXCEPT = 0;
+
 	/**
 	 * @brief Checks whether a given parameter exists
 	 * @param [in] pId   pId   ParameterId that identifies the parameter uniquely
@@ -310,6 +474,21 @@ public:
 	//! \param  [in]    sectionContinuity   A vector determining the continuity of section transitions
 	virtual void setSectionTimes(const std::vector<double>& sectionTimes, const std::vector<bool>& sectionContinuity) = 0;
 
+	/**
+	 * @brief Restricts time integration to a contiguous range of sections
+	 * @details A subsequent call to integrate() starts from the current state at the beginning of
+	 *          section @p startSec and stops at the end of section <tt>endSec - 1</tt>. Before the
+	 *          first integrated section, all previous section transitions are replayed in the model
+	 *          in order to restore section dependent state. Solutions are only written for the integrated
+	 *          sections (the initial state is only written if the range starts with the first section).
+	 *          An @p endSec of @c 0 or beyond the number of sections refers to the last section.
+	 *          Calling setSectionRange(0, 0) integrates all sections (default).
+	 *
+	 * @param [in] startSec Index of the first integrated section
+	 * @param [in] endSec Index of the section after the last integrated section
+	 */
+	virtual void setSectionRange(unsigned int startSec, unsigned int endSec) = 0;
+
 	/**
 	 * @brief Initializes the time integrator with the given model system
 	 * @details Allocates internal memory and initializes and sets up the IDAS package.
@@ -449,6 +628,142 @@ public:
 	 */
 	virtual void integrate() = 0;
 
+	/**
+	 * @brief Adds an event that is monitored during time integration
+	 * @details Events are located by the root finding facility of the time integrator.
+	 *          Each time an event is triggered, its time and index are recorded (see
+	 *          getEventTimes() and getEventIndices()) and its action is performed.
+	 *
+	 * @param [in] evt Event specification
+	 */
+	virtual void addEvent(const SimulationEvent& evt) = 0;
+
+	/**
+	 * @brief Removes all events
+	 */
+	virtual void clearEvents() CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Returns the number of monitored events
+	 * @return Number of events
+	 */
+	virtual unsigned int numEvents() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Returns the times at which events have been triggered in the last call to integrate()
+	 * @return Vector with event times in chronological order
+	 */
+	virtual const std::vector<double>& getEventTimes() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Returns the indices of the events that have been triggered in the last call to integrate()
+	 * @details The i-th element corresponds to the i-th element of getEventTimes().
+	 * @return Vector with indices of triggered events
+	 */
+	virtual const std::vector<unsigned int>& getEventIndices() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Configures steady-state detection for fast-forwarding sections
+	 * @details In enabled sections, the time integrator checks for steady state after each
+	 *          returned time point. Steady state is reached if the state does not change by more
+	 *          than the given tolerance until the end of the section, that is, if
+	 *          @f[ \left(t_{\text{end}} - t\right) \max\left( \left\| \dot{y} \right\|_w, \left\| F(t, y, \dot{y}) \right\|_w \right) \leq \text{tol}, @f]
+	 *          where @f$ \| \cdot \|_w @f$ denotes the weighted root mean square norm using the
+	 *          error weights of the time integrator. If sensitivities are computed, their time
+	 *          derivatives are also taken into account. Once steady state is detected, the
+	 *          solution is held constant until the end of the section and time integration
+	 *          continues with the next section.
+	 *
+	 * @param [in] sections Flags indicating whether detection is enabled in a section; a single flag applies to all sections
+	 * @param [in] tol Tolerance of the steady-state test
+	 */
+	virtual void setSteadyStateDetection(const std::vector<bool>& sections, double tol) = 0;
+
+	/**
+	 * @brief Returns the time skipped by steady-state detection in each section in the last call to integrate()
+	 * @details The vector is empty if steady-state detection is disabled.
+	 * @return Vector with skipped time for each section
+	 */
+	virtual const std::vector<double>& getSteadyStateSkippedTimes() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Enables or disables adaptive tolerances of iterative linear solvers
+	 * @details By default, iterative linear solvers (e.g., GMRES on Schur-complements) use a fixed
+	 *          tolerance derived from the tolerance of the Newton iteration of the time integrator.
+	 *          If adaptive tolerances are enabled, the linear systems of the Newton iteration are only
+	 *          solved up to a relative residual given by the Eisenstat-Walker forcing term, which is
+	 *          chosen based on the reduction of the Newton residual. Adaptive tolerances are not applied
+	 *          if forward sensitivities are computed.
+	 *
+	 * @param [in] enabled Determines whether adaptive tolerances are used
+	 */
+	virtual void setAdaptiveLinearSolverTolerance(bool enabled) CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Selects the time integration method
+	 * @details IDAS is used by default. TimeIntegrator::RadauIIA takes fewer steps at tight tolerances
+	 *          and does not suffer from order reduction at section transitions, but it does not support
+	 *          forward sensitivities, events, and checkpoints.
+	 *
+	 * @param [in] ti Time integration method
+	 */
+	virtual void setTimeIntegrator(TimeIntegrator ti) = 0;
+
+	/**
+	 * @brief Returns the time integration method
+	 * @return Time integration method
+	 */
+	virtual TimeIntegrator getTimeIntegrator() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Enables or disables recording of statistics of each time step
+	 * @param [in] enabled Determines whether step statistics are recorded
+	 */
+	virtual void setStepStatisticsRecording(bool enabled) CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Returns the statistics of each time step of the last call to integrate()
+	 * @details The vector is empty if recording of step statistics is disabled.
+	 * @return Vector with statistics of each time step in chronological order
+	 */
+	virtual const std::vector<StepStatistics>& getStepStatistics() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Returns the accumulated statistics of the time integrator of the last call to integrate()
+	 * @details The statistics are always recorded and do not require setStepStatisticsRecording().
+	 * @return Statistics of the time integrator
+	 */
+	virtual const IntegratorStatistics& getIntegratorStatistics() const CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Configures periodic checkpoints during time integration
+	 * @details A checkpoint is taken at the first time point returned by the time integrator
+	 *          after the given wall time or simulated time has passed since the last checkpoint
+	 *          (or the start of the time integration). The checkpoint captures the full state of
+	 *          the time integrator (including its step size and order history) and of the model,
+	 *          such that resuming via restoreCheckpoint() yields identical results. The state is
+	 *          handed to the given callback, which is responsible for persisting it.
+	 *
+	 *          An interval less than or equal to @c 0 disables the respective trigger.
+	 *
+	 * @param [in] wallTime Wall time in seconds between checkpoints
+	 * @param [in] simTime Simulated time between checkpoints
+	 * @param [in] callback Callback that persists checkpoints or @c nullptr to disable checkpoints
+	 */
+	virtual void setCheckpointing(double wallTime, double simTime, ICheckpointCallback* callback) = 0;
+
+	/**
+	 * @brief Lets the next call to integrate() resume from a checkpoint
+	 * @details The simulator and the model have to be configured exactly like the ones that have
+	 *          created the checkpoint. Since the checkpoint contains internal data of IDAS, it can only
+	 *          be restored by a build that uses the same SUNDIALS version. The callback set by setCheckpointing() (which may disable
+	 *          periodic checkpoints) is notified to restore the recorded data once time integration
+	 *          resumes. The restored state is consumed by integrate().
+	 *
+	 * @param [in] state Opaque state of the simulator passed to ICheckpointCallback::saveCheckpoint()
+	 * @param [in] len Length of the state array
+	 */
+	virtual void restoreCheckpoint(double const* state, unsigned int len) = 0;
 
 	/**
 	 * @brief Returns the bare state vector for the last timepoint
@@ -703,6 +1018,15 @@ public:
 	 */
 	virtual void setMaxSensNewtonIteration(unsigned int nIter) = 0;
 
+	/**
+	 * @brief Sets the maximum number of simplified Newton iterations in a time step of TimeIntegrator::RadauIIA
+	 * @details The coupled stages of the Radau IIA method require more iterations than the BDF method
+	 *          of IDAS. Hence, this limit is independent of setMaxNewtonIteration() and defaults to 7.
+	 * 
+	 * @param [in] nIter Maximum number of Newton iterations for a time step
+	 */
+	virtual void setMaxRadauNewtonIteration(unsigned int nIter) = 0;
+
 	/**
 	 * @brief Returns the elapsed time of the last simulation run in seconds
 	 * @return Elapsed time the last call of integrate() took in seconds
@@ -45,4 +45,5 @@
 #include "cadet/SolutionRecorder.hpp"
 #include "cadet/Simulator.hpp"
 #include "cadet/FactoryFuncs.hpp"
+#include "cadet/DataView.hpp"
 #include "cadet/Notification.hpp"
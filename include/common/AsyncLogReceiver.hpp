@@ -0,0 +1,233 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a log receiver that decouples log producers from the actual output via a lock-free ring buffer.
+ */
+
+#ifndef CADET_ASYNCLOGRECEIVER_HPP_
+#define CADET_ASYNCLOGRECEIVER_HPP_
+
+#include "cadet/Logging.hpp"
+#include "common/CompilerSpecific.hpp"
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace cadet
+{
+
+	/**
+	 * @brief Log receiver that forwards messages asynchronously to another receiver
+	 * @details Messages are placed in a bounded lock-free multi-producer ring buffer (Vyukov's
+	 *          sequence number scheme). A background thread drains the buffer and forwards the
+	 *          messages to the downstream receiver. Thus, threads that emit log messages (e.g.,
+	 *          TBB workers) never wait for each other or for the output device. The downstream
+	 *          receiver is only called from the background thread and does not need to be
+	 *          thread-safe.
+	 *
+	 *          The message text is copied into a string owned by the ring buffer slot. Slots
+	 *          keep their capacity, so that no memory is allocated after a short warm-up phase.
+	 *          File name, function name, and level string are stored as pointers. They are
+	 *          required to have static storage duration, which holds for @c __FILE__, @c __func__,
+	 *          and cadet::to_string(LogLevel).
+	 *
+	 *          If the buffer is full, producers either yield until a slot is available or drop
+	 *          the message (see numDropped()).
+	 */
+	class AsyncLogReceiver : public ILogReceiver
+	{
+	public:
+
+		/**
+		 * @brief Creates the receiver and starts the background thread
+		 * @param [in] sink Downstream receiver that is called from the background thread
+		 * @param [in] capacity Number of messages in the ring buffer, rounded up to a power of @c 2
+		 * @param [in] dropWhenFull Determines whether messages are dropped (@c true) or producers wait (@c false) if the buffer is full
+		 */
+		AsyncLogReceiver(ILogReceiver& sink, std::size_t capacity = 4096, bool dropWhenFull = false)
+			: _sink(sink), _slots(roundUpToPowerOfTwo(capacity)), _mask(_slots.size() - 1), _enqueuePos(0), _dequeuePos(0),
+			_numDropped(0), _stop(false), _dropWhenFull(dropWhenFull)
+		{
+			for (std::size_t i = 0; i < _slots.size(); ++i)
+				_slots[i].seq.store(i, std::memory_order_relaxed);
+
+			_worker = std::thread([this]() { run(); });
+		}
+
+		virtual ~AsyncLogReceiver() CADET_NOEXCEPT
+		{
+			// The background thread drains all pending messages before terminating
+			_stop.store(true, std::memory_order_release);
+			if (_worker.joinable())
+				_worker.join();
+		}
+
+		AsyncLogReceiver(const AsyncLogReceiver&) = delete;
+		AsyncLogReceiver& operator=(const AsyncLogReceiver&) = delete;
+
+		virtual void message(const char* file, const char* func, const unsigned int line, LogLevel lvl, const char* lvlStr, const char* message)
+		{
+			std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+			Slot* slot = nullptr;
+			while (true)
+			{
+				slot = &_slots[pos & _mask];
+				const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+				const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+				if (diff == 0)
+				{
+					// Slot is free, try to claim it
+					if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+				{
+					// Buffer is full
+					if (_dropWhenFull)
+					{
+						_numDropped.fetch_add(1, std::memory_order_relaxed);
+						return;
+					}
+
+					std::this_thread::yield();
+					pos = _enqueuePos.load(std::memory_order_relaxed);
+				}
+				else
+					pos = _enqueuePos.load(std::memory_order_relaxed);
+			}
+
+			slot->file = file;
+			slot->func = func;
+			slot->line = line;
+			slot->lvl = lvl;
+			slot->lvlStr = lvlStr;
+			slot->msg.assign(message);
+
+			// Publish slot to the consumer
+			slot->seq.store(pos + 1, std::memory_order_release);
+		}
+
+		/**
+		 * @brief Waits until all messages that have been enqueued so far are forwarded to the sink
+		 */
+		inline void flush() const
+		{
+			const std::size_t target = _enqueuePos.load(std::memory_order_acquire);
+			while (_dequeuePos.load(std::memory_order_acquire) < target)
+				std::this_thread::yield();
+		}
+
+		/**
+		 * @brief Returns the number of messages dropped due to a full buffer
+		 * @return Number of dropped messages
+		 */
+		inline std::size_t numDropped() const CADET_NOEXCEPT { return _numDropped.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Returns the number of messages the ring buffer can hold
+		 * @return Capacity of the ring buffer
+		 */
+		inline std::size_t capacity() const CADET_NOEXCEPT { return _slots.size(); }
+
+	private:
+
+		struct Slot
+		{
+			std::atomic<std::size_t> seq;
+			const char* file;
+			const char* func;
+			unsigned int line;
+			LogLevel lvl;
+			const char* lvlStr;
+			std::string msg;
+
+			Slot() : seq(0), file(nullptr), func(nullptr), line(0), lvl(LogLevel::None), lvlStr(nullptr), msg() { }
+		};
+
+		static inline std::size_t roundUpToPowerOfTwo(std::size_t n) CADET_NOEXCEPT
+		{
+			std::size_t p = 2;
+			while (p < n)
+				p <<= 1;
+			return p;
+		}
+
+		/**
+		 * @brief Forwards the next message to the sink if there is one
+		 * @return @c true if a message has been forwarded, @c false if the buffer is empty
+		 */
+		inline bool forwardNext()
+		{
+			const std::size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+			Slot& slot = _slots[pos & _mask];
+			if (slot.seq.load(std::memory_order_acquire) != pos + 1)
+				return false;
+
+			_sink.message(slot.file, slot.func, slot.line, slot.lvl, slot.lvlStr, slot.msg.c_str());
+
+			// Release slot for the next round of producers
+			slot.seq.store(pos + _slots.size(), std::memory_order_release);
+			_dequeuePos.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		void run()
+		{
+			unsigned int idleRounds = 0;
+			while (true)
+			{
+				if (forwardNext())
+				{
+					idleRounds = 0;
+					continue;
+				}
+
+				if (_stop.load(std::memory_order_acquire))
+				{
+					// Producers may still be publishing a claimed slot
+					if (_dequeuePos.load(std::memory_order_relaxed) == _enqueuePos.load(std::memory_order_acquire))
+						break;
+
+					std::this_thread::yield();
+					continue;
+				}
+
+				// Back off gradually while the buffer is empty
+				++idleRounds;
+				if (idleRounds < 64)
+					std::this_thread::yield();
+				else
+					std::this_thread::sleep_for(std::chrono::microseconds(500));
+			}
+		}
+
+		ILogReceiver& _sink;
+		std::vector<Slot> _slots;
+		const std::size_t _mask;
+		std::atomic<std::size_t> _enqueuePos;
+		std::atomic<std::size_t> _dequeuePos;
+		std::atomic<std::size_t> _numDropped;
+		std::atomic<bool> _stop;
+		const bool _dropWhenFull;
+		std::thread _worker;
+	};
+
+} // namespace cadet
+
+#endif  // CADET_ASYNCLOGRECEIVER_HPP_
@@ -0,0 +1,135 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a checkpoint handler that persists checkpoints in a file
+ */
+
+#ifndef CADET_CHECKPOINTFILE_HPP_
+#define CADET_CHECKPOINTFILE_HPP_
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <fstream>
+
+#include "cadet/Notification.hpp"
+#include "common/SolutionRecorderImpl.hpp"
+#include "common/StateBuffer.hpp"
+
+namespace cadet
+{
+
+/**
+ * @brief Persists checkpoints of the simulator and the recorded data in a file
+ * @details Each checkpoint is written to a temporary file first, which then replaces the
+ *          previous checkpoint. Hence, a checkpoint file is always complete even if the
+ *          process is killed while writing a checkpoint.
+ *
+ *          The file contains the datasets @c SIMULATOR_STATE (opaque state of the simulator),
+ *          @c RECORDER_STATE (recorded data), @c SECTION, and @c TIME.
+ * @tparam Reader_t Type of the file reader
+ * @tparam Writer_t Type of the file writer
+ */
+template <class Reader_t, class Writer_t>
+class CheckpointFile : public ICheckpointCallback
+{
+public:
+	/**
+	 * @brief Creates the checkpoint handler
+	 * @param [in] fileName Name of the checkpoint file
+	 * @param [in] storage Recorder whose data is saved and restored
+	 */
+	CheckpointFile(const std::string& fileName, cadet::InternalStorageSystemRecorder& storage) : _fileName(fileName), _storage(storage) { }
+
+	virtual ~CheckpointFile() CADET_NOEXCEPT { }
+
+	virtual void saveCheckpoint(unsigned int section, double time, double const* state, unsigned int len)
+	{
+		_recorderState.clear();
+		StateBufferWriter buffer(_recorderState);
+		_storage.saveState(buffer);
+
+		const std::string tempFileName = _fileName + ".tmp";
+		{
+			Writer_t writer;
+			writer.openFile(tempFileName, "co");
+			writer.vector("SIMULATOR_STATE", len, state);
+			writer.vector("RECORDER_STATE", _recorderState);
+			writer.scalar("SECTION", static_cast<int>(section));
+			writer.scalar("TIME", time);
+			writer.closeFile();
+		}
+
+#ifdef _WIN32
+		// Renaming does not replace existing files on Windows
+		std::remove(_fileName.c_str());
+#endif
+		if (std::rename(tempFileName.c_str(), _fileName.c_str()) != 0)
+		{
+			LOG(Error) << "Failed to replace checkpoint file " << _fileName;
+			return;
+		}
+
+		LOG(Info) << "Checkpoint at t = " << time << " (section " << section << ") written to " << _fileName;
+	}
+
+	virtual void resumeFromCheckpoint(unsigned int section, double time)
+	{
+		if (_recorderState.empty())
+			return;
+
+		StateBufferReader buffer(_recorderState.data(), _recorderState.size());
+		_storage.restoreState(buffer);
+		_recorderState.clear();
+
+		LOG(Info) << "Resuming from checkpoint at t = " << time << " (section " << section << ")";
+	}
+
+	/**
+	 * @brief Reads the checkpoint file if it exists
+	 * @details The recorded data is kept until resumeFromCheckpoint() is called.
+	 * @return @c true if a checkpoint has been read, otherwise @c false
+	 */
+	bool load()
+	{
+		if (!std::ifstream(_fileName).good())
+			return false;
+
+		Reader_t reader;
+		reader.openFile(_fileName, "r");
+		_simulatorState = reader.template vector<double>("SIMULATOR_STATE");
+		_recorderState = reader.template vector<double>("RECORDER_STATE");
+		reader.closeFile();
+
+		return true;
+	}
+
+	/**
+	 * @brief Deletes the checkpoint file (e.g., after the simulation has finished)
+	 */
+	inline void remove() const { std::remove(_fileName.c_str()); }
+
+	inline const std::vector<double>& simulatorState() const CADET_NOEXCEPT { return _simulatorState; }
+	inline const std::string& fileName() const CADET_NOEXCEPT { return _fileName; }
+
+protected:
+	std::string _fileName; //!< Name of the checkpoint file
+	cadet::InternalStorageSystemRecorder& _storage; //!< Recorder whose data is saved and restored
+	std::vector<double> _simulatorState; //!< State of the simulator read by load()
+	std::vector<double> _recorderState; //!< Buffer for the recorded data
+};
+
+} // namespace cadet
+
+#endif  // CADET_CHECKPOINTFILE_HPP_
@@ -161,6 +161,29 @@ void configureSystemRecorder(cadet::InternalStorageSystemRecorder& recorder, Par
 		subRec->splitComponents(splitComponents);
 		subRec->splitPorts(splitPorts);
 		subRec->treatSingleAsMultiPortUnitOps(singleAsMultiPort);
+
+		// Decimation of spatially resolved fields
+		const auto readStride = [&pp](const char* name) -> unsigned int { return pp.exists(name) ? static_cast<unsigned int>(std::max(pp.getInt(name), 1)) : 1u; };
+		subRec->timeStride(readStride("DECIMATE_TIME"));
+		subRec->spatialStrides(readStride("DECIMATE_AXIAL"), readStride("DECIMATE_RADIAL"), readStride("DECIMATE_SHELL"));
+
+		if (pp.exists("SINGLE_PRECISION_DATA"))
+			subRec->singlePrecision(pp.getBool("SINGLE_PRECISION_DATA"));
+
+		// Outlet KPIs accumulated on the fly
+		const bool writeKpi = pp.exists("WRITE_SOLUTION_KPI") && pp.getBool("WRITE_SOLUTION_KPI");
+		const bool writeSensKpi = pp.exists("WRITE_SENS_KPI") && pp.getBool("WRITE_SENS_KPI");
+		if (writeKpi || writeSensKpi)
+		{
+			cadet::OutletKpiRecorder* const kpiRec = new cadet::OutletKpiRecorder(i);
+			kpiRec->storeSensitivities(writeSensKpi);
+
+			if (pp.exists("KPI_FRACTION_START") && pp.exists("KPI_FRACTION_END"))
+				kpiRec->collectionWindows(pp.getDoubleArray("KPI_FRACTION_START"), pp.getDoubleArray("KPI_FRACTION_END"));
+
+			recorder.addKpiRecorder(kpiRec);
+		}
+
 		pp.popScope();
 
 		recorder.addRecorder(subRec);
@@ -194,7 +217,8 @@ void readSensitivityInitialState(ParamProvider_t& pp, const char* prefix, std::v
 class Driver
 {
 public:
-	Driver() : _sim(nullptr), _builder(nullptr), _storage(nullptr), _writeLastState(false), _writeLastStateSens(false)
+	Driver() : _sim(nullptr), _builder(nullptr), _storage(nullptr), _writeLastState(false), _writeLastStateSens(false),
+		_checkpoint(nullptr), _checkpointWallTime(0.0), _checkpointSimTime(0.0)
 	{
 		_builder = cadetCreateModelBuilder();
 	}
@@ -261,6 +285,24 @@ public:
 		std::vector<bool> secCont;
 		extractSectionTimes(pp, secTimes, secCont);
 
+		// Configure periodic checkpoints
+		_checkpointWallTime = 0.0;
+		_checkpointSimTime = 0.0;
+		_checkpointFile.clear();
+		if (pp.exists("checkpoint"))
+		{
+			pp.pushScope("checkpoint");
+
+			if (pp.exists("WALL_TIME_INTERVAL"))
+				_checkpointWallTime = pp.getDouble("WALL_TIME_INTERVAL");
+			if (pp.exists("SIM_TIME_INTERVAL"))
+				_checkpointSimTime = pp.getDouble("SIM_TIME_INTERVAL");
+			if (pp.exists("FILE"))
+				_checkpointFile = pp.getString("FILE");
+
+			pp.popScope(); // checkpoint scope
+		}
+
 		pp.popScope(); // solver scope
 
 		pp.pushScope("model");
@@ -369,6 +411,46 @@ public:
 		_sim->setSolutionRecorder(_storage);
 	}
 
+	/**
+	 * @brief Reconfigures an already configured simulator and model for another run
+	 * @details In contrast to configure(), the simulator, model, and result storage are
+	 *          kept alive. Only solver settings, section times, parameter values, and
+	 *          initial conditions are overwritten, and the time integrator is reinitialized
+	 *          instead of reallocated. Stored results are cleared while keeping their
+	 *          capacity.
+	 *
+	 *          The given configuration has to be structure-identical to the one the driver
+	 *          has been configured with (i.e., same unit operations, discretizations, binding
+	 *          models, sensitive parameters, and return configuration).
+	 * @param [in] pp Implementation of cadet::IParameterProvider used as input
+	 * @tparam ParamProvider_t Type of the parameter provider
+	 */
+	template <typename ParamProvider_t>
+	void reconfigure(ParamProvider_t& pp)
+	{
+		if (!_sim || !_sim->model())
+		{
+			configure(pp);
+			return;
+		}
+
+		// Reconfigure main solver parameters and section times
+		pp.pushScope("solver");
+		_sim->reconfigure(pp);
+		setSectionTimes(pp);
+		pp.popScope(); // solver scope
+
+		// Overwrite parameter values and initial conditions
+		pp.pushScope("model");
+		if (!_sim->reconfigureModel(pp))
+			throw cadet::InvalidParameterException("Reconfiguration of model failed");
+
+		setInitialCondition(pp);
+		pp.popScope(); // scope model
+
+		clearResults();
+	}
+
 	/**
 	 * @brief Sets initial conditions from the given parameter provider
 	 * @details Assumes that the simulator is already configured
@@ -462,6 +544,11 @@ public:
 			_writeLastStateSens = pp.getBool("WRITE_SENS_LAST");
 		else
 			_writeLastStateSens = false;
+
+		if (pp.exists("WRITE_STEP_STATISTICS"))
+			_sim->setStepStatisticsRecording(pp.getBool("WRITE_STEP_STATISTICS"));
+		else
+			_sim->setStepStatisticsRecording(false);
 		
 		pp.popScope(); // scope return
 
@@ -472,13 +559,51 @@ public:
 	/**
 	 * @brief Performs time integration
 	 * @details The simulator has to be setup and configured for time integration.
+	 *          Periodic checkpoints are taken if configured and a checkpoint handler
+	 *          has been set (see setCheckpointHandler()).
 	 */
 	void run()
 	{
+		_sim->setCheckpointing(_checkpointWallTime, _checkpointSimTime, _checkpoint);
+		if (!_resumeState.empty())
+		{
+			_sim->restoreCheckpoint(_resumeState.data(), _resumeState.size());
+			_resumeState.clear();
+		}
+
 		// Run simulation
 		_sim->integrate();
+
+		_sim->setCheckpointing(0.0, 0.0, nullptr);
 	}
 
+	/**
+	 * @brief Sets the handler that persists checkpoints taken by run()
+	 * @details Checkpoints are only taken if intervals are configured in the @c checkpoint
+	 *          group of the solver scope.
+	 * @param [in] cb Checkpoint handler or @c nullptr
+	 */
+	inline void setCheckpointHandler(cadet::ICheckpointCallback* cb) CADET_NOEXCEPT { _checkpoint = cb; }
+
+	/**
+	 * @brief Lets the next call to run() resume from the given checkpoint
+	 * @details The checkpoint handler is responsible for restoring the recorded data.
+	 * @param [in] state Opaque state of the simulator saved in the checkpoint
+	 */
+	inline void resumeFrom(const std::vector<double>& state) { _resumeState = state; }
+
+	/**
+	 * @brief Returns whether periodic checkpoints are configured
+	 * @return @c true if checkpoints are taken, otherwise @c false
+	 */
+	inline bool checkpointsConfigured() const CADET_NOEXCEPT { return (_checkpointWallTime > 0.0) || (_checkpointSimTime > 0.0); }
+
+	/**
+	 * @brief Returns the checkpoint file name given in the configuration
+	 * @return File name or empty string if none is given
+	 */
+	inline const std::string& checkpointFile() const CADET_NOEXCEPT { return _checkpointFile; }
+
 	/**
 	 * @brief Writes the current results to the given writer
 	 * @param [in] writer Writer to write to
@@ -508,8 +633,47 @@ public:
 
 		writer.pushGroup("solution");
 		_storage->writeSolution(writer);
+
+		if (!_sim->getEventTimes().empty())
+		{
+			const std::vector<unsigned int>& eventIdx = _sim->getEventIndices();
+			writer.vector("EVENT_TIMES", _sim->getEventTimes());
+			writer.vector("EVENT_INDEX", std::vector<int>(eventIdx.begin(), eventIdx.end()));
+		}
+
+		if (!_sim->getSteadyStateSkippedTimes().empty())
+			writer.vector("STEADY_STATE_SKIPPED_TIME", _sim->getSteadyStateSkippedTimes());
 		writer.popGroup();
 
+		const std::vector<cadet::StepStatistics>& stepStats = _sim->getStepStatistics();
+		if (!stepStats.empty())
+		{
+			std::vector<double> time(stepStats.size());
+			std::vector<double> stepSize(stepStats.size());
+			std::vector<int> nNewtonIter(stepStats.size());
+			std::vector<int> nConvFails(stepStats.size());
+			std::vector<int> nErrTestFails(stepStats.size());
+			std::vector<int> nLinearIter(stepStats.size());
+			for (std::size_t i = 0; i < stepStats.size(); ++i)
+			{
+				time[i] = stepStats[i].time;
+				stepSize[i] = stepStats[i].stepSize;
+				nNewtonIter[i] = stepStats[i].nNewtonIter;
+				nConvFails[i] = stepStats[i].nConvFails;
+				nErrTestFails[i] = stepStats[i].nErrTestFails;
+				nLinearIter[i] = static_cast<int>(stepStats[i].nLinearIter);
+			}
+
+			writer.pushGroup("statistics");
+			writer.vector("STEP_TIME", time);
+			writer.vector("STEP_SIZE", stepSize);
+			writer.vector("STEP_NEWTON_ITER", nNewtonIter);
+			writer.vector("STEP_CONV_FAILS", nConvFails);
+			writer.vector("STEP_ERRTEST_FAILS", nErrTestFails);
+			writer.vector("STEP_LINEAR_ITER", nLinearIter);
+			writer.popGroup();
+		}
+
 		if (_sim->numSensParams() > 0)
 		{
 			writer.pushGroup("sensitivity");
@@ -608,6 +772,12 @@ protected:
 	bool _writeLastState;
 	bool _writeLastStateSens;
 
+	cadet::ICheckpointCallback* _checkpoint; //!< Handler that persists checkpoints, not owned by this driver
+	double _checkpointWallTime; //!< Wall time in seconds between checkpoints
+	double _checkpointSimTime; //!< Simulated time between checkpoints
+	std::string _checkpointFile; //!< Name of the checkpoint file (may be empty)
+	std::vector<double> _resumeState; //!< Checkpoint the next run() resumes from
+
 	/**
 	 * @brief Sets section times and section continuity from the given parameter provider
 	 * @details Assumes that the simulator is already configured
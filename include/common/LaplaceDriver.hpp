@@ -0,0 +1,1010 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a driver that solves linear column models in the Laplace domain
+ */
+
+#ifndef CADET_LAPLACEDRIVER_HPP_
+#define CADET_LAPLACEDRIVER_HPP_
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+
+#include "common/WaveformRelaxationDriver.hpp"
+#include "common/LaplaceTransform.hpp"
+#include "common/Timer.hpp"
+
+#ifdef CADET_PARALLELIZE
+	#include <tbb/parallel_for.h>
+#endif
+
+namespace cadet
+{
+
+/**
+ * @brief Driver that computes outlet profiles of linear column models by inverting their transfer functions
+ * @details The lumped rate models with and without pores and the general rate model with linear binding
+ *          (or without binding) are linear in the concentrations. Each component of an initially empty
+ *          column is governed by a transfer function (see laplace::columnTransferFunction()). Piecewise
+ *          polynomial inlet profiles have closed-form Laplace transforms, which are combinations of
+ *          @f$ \exp(-s t_i) / s^{j+1} @f$. Hence, the outlet profile is a sum of shifted inverse transforms
+ *          of @f$ G(s) / s^{j+1} @f$, which are computed by the method of de Hoog et al. The number of
+ *          terms is doubled until the outlet profiles change less than the tolerances of the time
+ *          integrator. Parameter sensitivities are obtained by inverting derivatives of the transfer
+ *          function, which are computed by forward mode AD.
+ *
+ *          The solver is configured in the @c laplace group of the solver scope. If the group is missing,
+ *          the driver behaves exactly like a cadet::WaveformRelaxationDriver. Otherwise, the system is
+ *          checked: It has to consist of one column fed by @c PIECEWISE_CUBIC_POLY inlets and may feed
+ *          outlets. Parameters must not depend on the section and only inlet and outlet concentrations
+ *          can be returned. If the system does not qualify, a warning is issued and the simulation is
+ *          integrated in time.
+ */
+class LaplaceDriver : public WaveformRelaxationDriver
+{
+public:
+	LaplaceDriver() : WaveformRelaxationDriver(), _useLaplace(false), _model(laplace::ColumnModel::GeneralRate), _column(0), _nComp(0),
+		_nTerms(0), _maxTerms(0), _lapRelTol(0.0), _lapAbsTol(0.0), _termsUsed(0), _lapWallTime(0.0) { }
+
+	~LaplaceDriver() CADET_NOEXCEPT { }
+
+	/**
+	 * @brief Configures the simulator and checks whether the system can be solved in the Laplace domain
+	 * @details The simulator is always configured in order to provide the structure of the results.
+	 * @param [in] pp Implementation of cadet::IParameterProvider used as input
+	 * @tparam ParamProvider_t Type of the parameter provider
+	 */
+	template <typename ParamProvider_t>
+	void configure(ParamProvider_t& pp)
+	{
+		_useLaplace = false;
+		_termsUsed = 0;
+
+		WaveformRelaxationDriver::configure(pp);
+
+		pp.pushScope("solver");
+		if (!pp.exists("laplace"))
+		{
+			pp.popScope();
+			return;
+		}
+
+		pp.pushScope("laplace");
+		_nTerms = pp.exists("NTERMS") ? static_cast<unsigned int>(std::max(pp.getInt("NTERMS"), 1)) : 40;
+		_maxTerms = pp.exists("MAX_TERMS") ? static_cast<unsigned int>(std::max(pp.getInt("MAX_TERMS"), 1)) : 1280;
+		pp.popScope(); // laplace scope
+
+		if (_maxTerms < _nTerms)
+			throw cadet::InvalidParameterException("MAX_TERMS of Laplace domain solver has to be at least NTERMS");
+
+		// Tolerances of the time integrator serve as target accuracy
+		pp.pushScope("time_integrator");
+		_lapRelTol = pp.getDouble("RELTOL");
+		if (pp.isArray("ABSTOL"))
+		{
+			const std::vector<double> absTol = pp.getDoubleArray("ABSTOL");
+			_lapAbsTol = *std::min_element(absTol.begin(), absTol.end());
+		}
+		else
+			_lapAbsTol = pp.getDouble("ABSTOL");
+		pp.popScope(); // time_integrator scope
+
+		const bool hasUserTimes = pp.exists("USER_SOLUTION_TIMES");
+		if (hasUserTimes)
+			_times = pp.getDoubleArray("USER_SOLUTION_TIMES");
+
+		std::vector<bool> secCont;
+		extractSectionTimes(pp, _secTimes, secCont);
+
+		pp.popScope(); // solver scope
+
+		const std::string reason = hasUserTimes ? checkSystem(pp) : std::string("missing USER_SOLUTION_TIMES");
+		if (!reason.empty())
+		{
+			LOG(Warning) << "Laplace domain solver does not support " << reason << ", falling back to time integration";
+			return;
+		}
+
+		// Output is restricted to the simulated time domain
+		_times.erase(std::remove_if(_times.begin(), _times.end(), [&](double t) { return (t < _secTimes.front()) || (t > _secTimes.back()); }), _times.end());
+
+		_useLaplace = true;
+		LOG(Debug) << "Laplace domain solver for unit operation " << _column << " with " << _inlets.size() << " inlets and " << _sens.size() << " sensitivities";
+	}
+
+	/**
+	 * @brief Computes the solution
+	 * @details Uses the transfer functions if the system qualifies. Otherwise, the simulation is
+	 *          integrated by the cadet::WaveformRelaxationDriver.
+	 */
+	void run()
+	{
+		if (!_useLaplace)
+		{
+			WaveformRelaxationDriver::run();
+			return;
+		}
+
+		Timer timer;
+		timer.start();
+
+		const unsigned int nTimes = _times.size();
+		const unsigned int nSens = _sens.size();
+
+		// Mixed inlet of the column
+		std::vector<double> mixCoeff(_inletCoeff.front().size(), 0.0);
+		for (unsigned int i = 0; i < _inlets.size(); ++i)
+		{
+			for (unsigned int j = 0; j < mixCoeff.size(); ++j)
+				mixCoeff[j] += _inletFraction[i] * _inletCoeff[i][j];
+		}
+
+		std::vector<double> colInlet(nTimes * _nComp);
+		std::vector<double> colOutlet(nTimes * _nComp);
+		std::vector<std::vector<double>> sensInlet(nSens, std::vector<double>(nTimes * _nComp, 0.0));
+		std::vector<std::vector<double>> sensOutlet(nSens, std::vector<double>(nTimes * _nComp, 0.0));
+		std::vector<unsigned int> termsUsed(_nComp, 0);
+
+		const auto solve = [&](std::size_t comp)
+			{
+				termsUsed[comp] = solveComponent(comp, mixCoeff, colOutlet, sensOutlet);
+			};
+
+#ifdef CADET_PARALLELIZE
+		tbb::parallel_for(std::size_t(0), std::size_t(_nComp), solve);
+#else
+		for (std::size_t comp = 0; comp < _nComp; ++comp)
+			solve(comp);
+#endif
+
+		_termsUsed = *std::max_element(termsUsed.begin(), termsUsed.end());
+
+		for (unsigned int i = 0; i < nTimes; ++i)
+			evaluateInlet(mixCoeff, _times[i], colInlet.data() + i * _nComp);
+
+		for (unsigned int s = 0; s < nSens; ++s)
+		{
+			for (const SensEntry& e : _sens[s])
+			{
+				if (e.inlet < 0)
+					continue;
+
+				for (unsigned int i = 0; i < nTimes; ++i)
+					sensInlet[s][i * _nComp + e.comp] += e.factor * _inletFraction[e.inlet] * inletBasis(e.section, e.degree, _times[i]);
+			}
+		}
+
+		// Hand results to the recorders
+		for (unsigned int r = 0; r < _storage->numRecorders(); ++r)
+		{
+			cadet::InternalStorageUnitOpRecorder* const rec = _storage->recorder(r);
+			const UnitOpIdx idx = rec->unitOperation();
+
+			if (idx == _column)
+				rec->assignPorts(_times, colInlet, colOutlet, sensInlet, sensOutlet);
+			else if (std::find(_outlets.begin(), _outlets.end(), idx) != _outlets.end())
+				rec->assignPorts(_times, colOutlet, colOutlet, sensOutlet, sensOutlet);
+			else
+			{
+				const std::vector<UnitOpIdx>::const_iterator it = std::find(_inlets.begin(), _inlets.end(), idx);
+				if (it == _inlets.end())
+					continue;
+
+				const int inletIdx = it - _inlets.begin();
+				std::vector<double> profile(nTimes * _nComp);
+				std::vector<std::vector<double>> sensProfile(nSens, std::vector<double>(nTimes * _nComp, 0.0));
+				for (unsigned int i = 0; i < nTimes; ++i)
+					evaluateInlet(_inletCoeff[inletIdx], _times[i], profile.data() + i * _nComp);
+
+				for (unsigned int s = 0; s < nSens; ++s)
+				{
+					for (const SensEntry& e : _sens[s])
+					{
+						if (e.inlet != inletIdx)
+							continue;
+
+						for (unsigned int i = 0; i < nTimes; ++i)
+							sensProfile[s][i * _nComp + e.comp] += e.factor * inletBasis(e.section, e.degree, _times[i]);
+					}
+				}
+
+				rec->assignPorts(_times, profile, profile, sensProfile, sensProfile);
+			}
+		}
+
+		_storage->assignTime(_times);
+
+		_lapWallTime = timer.stop();
+
+		LOG(Info) << "Laplace domain solver finished with " << _termsUsed << " terms in " << _lapWallTime << " s";
+	}
+
+	/**
+	 * @brief Writes the current results to the given writer
+	 * @details Adds statistics of the Laplace domain solver to the @c meta group.
+	 * @param [in] writer Writer to write to
+	 * @tparam Writer_t Type of the writer
+	 */
+	template <typename Writer_t>
+	void write(Writer_t& writer)
+	{
+		WaveformRelaxationDriver::write(writer);
+
+		if (!_useLaplace || (_termsUsed == 0))
+			return;
+
+		writer.pushGroup("meta");
+
+		const char* const names[] = {"TIME_SIM", "LAPLACE_TERMS"};
+		for (const char* name : names)
+		{
+			if (writer.exists(name))
+				writer.unlinkDataset(name);
+		}
+
+		writer.scalar("TIME_SIM", _lapWallTime);
+		writer.scalar("LAPLACE_TERMS", static_cast<int>(_termsUsed));
+
+		writer.popGroup();
+	}
+
+	/**
+	 * @brief Returns whether the last configuration is solved in the Laplace domain
+	 * @return @c true if the transfer functions are used, otherwise @c false
+	 */
+	inline bool usesLaplaceSolver() const CADET_NOEXCEPT { return _useLaplace; }
+
+	/**
+	 * @brief Returns the largest number of terms of the inversion used in the last run
+	 * @return Number of terms
+	 */
+	inline unsigned int numTerms() const CADET_NOEXCEPT { return _termsUsed; }
+
+protected:
+
+	/**
+	 * @brief Contribution of a parameter to a sensitivity
+	 */
+	struct SensEntry
+	{
+		int inlet; //!< Index of the inlet in _inlets, or @c -1 for a column parameter
+		unsigned int param; //!< Column parameter (see laplace::ColumnParameters::Index)
+		int comp; //!< Component index, or @c -1 for all components
+		unsigned int section; //!< Section of an inlet coefficient
+		unsigned int degree; //!< Degree of the monomial of an inlet coefficient
+		double factor; //!< Factor of the parameter in the linear combination
+	};
+
+	/**
+	 * @brief Checks whether the system qualifies for the Laplace domain solver and reads its parameters
+	 * @param [in] pp Implementation of cadet::IParameterProvider used as input
+	 * @return Description of the feature that prevents using the Laplace domain solver, or an empty string
+	 */
+	template <typename ParamProvider_t>
+	std::string checkSystem(ParamProvider_t& pp)
+	{
+		if (numGroups() > 0)
+			return "waveform relaxation";
+		if (!sliceBoundaries().empty())
+			return "Parareal";
+		if (_sim->numEvents() > 0)
+			return "events";
+		if (_storage->numKpiRecorders() > 0)
+			return "outlet KPIs";
+		if (_writeLastState || _writeLastStateSens)
+			return "last states";
+
+		for (unsigned int r = 0; r < _storage->numRecorders(); ++r)
+		{
+			cadet::InternalStorageUnitOpRecorder const* const rec = _storage->recorder(r);
+			if (!onlyPorts(rec->solutionConfig()) || !onlyPorts(rec->sensitivityConfig()) || storesAny(rec->solutionDotConfig()) || storesAny(rec->sensitivityDotConfig()))
+				return "returning fields other than inlet and outlet";
+		}
+
+		const Flowsheet fs = readFlowsheet(pp);
+		if (fs.hasInitState)
+			return "full initial states";
+		if (fs.connections.size() != 1)
+			return "valve switches";
+
+		// Identify column
+		const unsigned int nUnits = fs.unitType.size();
+		int column = -1;
+		for (unsigned int i = 0; i < nUnits; ++i)
+		{
+			if ((fs.unitType[i] == "INLET") || (fs.unitType[i] == "OUTLET"))
+				continue;
+
+			if (column >= 0)
+				return "multiple unit operations other than inlets and outlets";
+			column = i;
+		}
+
+		if (column < 0)
+			return "systems without column";
+
+		_column = column;
+		if (fs.unitType[column] == "LUMPED_RATE_MODEL_WITHOUT_PORES")
+			_model = laplace::ColumnModel::LumpedRateWithoutPores;
+		else if (fs.unitType[column] == "LUMPED_RATE_MODEL_WITH_PORES")
+			_model = laplace::ColumnModel::LumpedRateWithPores;
+		else if (fs.unitType[column] == "GENERAL_RATE_MODEL")
+			_model = laplace::ColumnModel::GeneralRate;
+		else
+			return "unit operation type " + fs.unitType[column];
+
+		_nComp = fs.nComp[column];
+
+		// Inlets feed the column, which feeds outlets
+		_inlets.clear();
+		_outlets.clear();
+		std::vector<double> inletFlow;
+		const std::vector<double>& conn = fs.connections.front();
+		for (std::size_t r = 0; r < conn.size(); r += fs.nCols)
+		{
+			const int src = static_cast<int>(conn[r]);
+			const int dest = static_cast<int>(conn[r + 1]);
+			const unsigned int compOffset = (fs.nCols == 7) ? 4 : 2;
+
+			if ((conn[r + compOffset] >= 0.0) || (conn[r + compOffset + 1] >= 0.0))
+				return "component-wise connections";
+			if ((fs.nCols == 7) && ((conn[r + 2] > 0.0) || (conn[r + 3] > 0.0)))
+				return "multiple ports";
+
+			if ((dest == column) && (src >= 0) && (src < static_cast<int>(nUnits)) && (fs.unitType[src] == "INLET"))
+			{
+				const std::vector<UnitOpIdx>::const_iterator it = std::find(_inlets.begin(), _inlets.end(), static_cast<UnitOpIdx>(src));
+				if (it == _inlets.end())
+				{
+					_inlets.push_back(src);
+					inletFlow.push_back(conn[r + fs.nCols - 1]);
+				}
+				else
+					inletFlow[it - _inlets.begin()] += conn[r + fs.nCols - 1];
+			}
+			else if ((src == column) && (dest >= 0) && (dest < static_cast<int>(nUnits)) && (fs.unitType[dest] == "OUTLET"))
+			{
+				if (std::find(_outlets.begin(), _outlets.end(), static_cast<UnitOpIdx>(dest)) == _outlets.end())
+					_outlets.push_back(dest);
+			}
+			else
+				return "connections other than from inlets to the column and from the column to outlets";
+		}
+
+		if (_inlets.size() + _outlets.size() + 1 != nUnits)
+			return "unconnected unit operations";
+
+		const double flowRate = std::accumulate(inletFlow.begin(), inletFlow.end(), 0.0);
+		if (flowRate <= 0.0)
+			return "columns without inflow";
+
+		_inletFraction.resize(_inlets.size());
+		for (unsigned int i = 0; i < _inlets.size(); ++i)
+			_inletFraction[i] = inletFlow[i] / flowRate;
+
+		pp.pushScope("model");
+
+		// Inlet profiles
+		const unsigned int nSec = _secTimes.size() - 1;
+		_inletCoeff.clear();
+		for (UnitOpIdx idx : _inlets)
+		{
+			pp.pushScope(unitScope(idx));
+			const std::string reason = readInlet(pp, nSec);
+			pp.popScope();
+
+			if (!reason.empty())
+			{
+				pp.popScope(); // model scope
+				return reason;
+			}
+		}
+
+		// Column parameters
+		pp.pushScope(unitScope(_column));
+		const std::string reason = readColumn(pp, nSec, flowRate);
+		pp.popScope();
+
+		pp.popScope(); // model scope
+
+		if (!reason.empty())
+			return reason;
+
+		return readSensitivities(pp);
+	}
+
+	template <typename ParamProvider_t>
+	std::string readInlet(ParamProvider_t& pp, unsigned int nSec)
+	{
+		if (pp.getString("INLET_TYPE") != "PIECEWISE_CUBIC_POLY")
+			return "inlet profile " + pp.getString("INLET_TYPE");
+
+		// Coefficients in section-degree-component ordering
+		const char* const names[] = {"CONST_COEFF", "LIN_COEFF", "QUAD_COEFF", "CUBE_COEFF"};
+		std::vector<double> coeff(nSec * 4 * _nComp);
+		for (unsigned int sec = 0; sec < nSec; ++sec)
+		{
+			std::ostringstream oss;
+			oss << "sec_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << sec;
+			if (!pp.exists(oss.str()))
+				throw cadet::InvalidParameterException("Inlet requires coefficients for section " + std::to_string(sec));
+
+			pp.pushScope(oss.str());
+			for (unsigned int deg = 0; deg < 4; ++deg)
+			{
+				const std::vector<double> c = pp.getDoubleArray(names[deg]);
+				if (c.size() < _nComp)
+					throw cadet::InvalidParameterException(std::string("Field ") + names[deg] + " requires NCOMP elements");
+				std::copy_n(c.begin(), _nComp, coeff.begin() + (sec * 4 + deg) * _nComp);
+			}
+			pp.popScope();
+		}
+
+		_inletCoeff.push_back(std::move(coeff));
+		return std::string();
+	}
+
+	template <typename ParamProvider_t>
+	std::string readColumn(ParamProvider_t& pp, unsigned int nSec, double flowRate)
+	{
+		typedef laplace::ColumnParameters P;
+
+		if (pp.exists("NPARTYPE") && (pp.getInt("NPARTYPE") > 1))
+			return "multiple particle types";
+
+		const char* const reactions[] = {"REACTION_MODEL", "REACTION_MODEL_PARTICLES"};
+		for (const char* name : reactions)
+		{
+			if (pp.exists(name) && (pp.getString(name) != "NONE"))
+				return "reactions";
+		}
+
+		if (!allEqual(pp, "INIT_C", 0.0) || !allEqual(pp, "INIT_CP", 0.0) || !allEqual(pp, "INIT_Q", 0.0))
+			return "non-zero initial conditions";
+		if (!allEqual(pp, "PAR_SURFDIFFUSION", 0.0))
+			return "surface diffusion";
+		if (!allEqual(pp, "PAR_CORERADIUS", 0.0))
+			return "particle cores";
+		if (!allEqual(pp, "PORE_ACCESSIBILITY", 1.0))
+			return "pore accessibility";
+
+		const std::vector<std::string> bindModel = pp.getStringArray("ADSORPTION_MODEL");
+		if ((bindModel.size() != 1) || ((bindModel[0] != "NONE") && (bindModel[0] != "LINEAR")))
+			return "binding model " + bindModel[0];
+
+		pp.pushScope("discretization");
+		const std::vector<int> nBound = pp.getIntArray("NBOUND");
+		pp.popScope();
+
+		if (nBound.size() < _nComp)
+			throw cadet::InvalidParameterException("Field NBOUND contains too few elements (NCOMP = " + std::to_string(_nComp) + " required)");
+
+		P base;
+		std::fill(base.value, base.value + P::NumParameters, 0.0);
+		base.binding = false;
+		base.kinetic = true;
+		base.value[P::FlowRate] = flowRate;
+
+		if (!uniformScalar(pp, "COL_LENGTH", base.value[P::Length]))
+			return "section dependent parameters";
+
+		if (pp.exists("CROSS_SECTION_AREA"))
+			base.value[P::CrossSection] = pp.getDouble("CROSS_SECTION_AREA");
+
+		if (pp.exists("VELOCITY"))
+		{
+			if (!uniformScalar(pp, "VELOCITY", base.value[P::Velocity]))
+				return "section dependent parameters";
+		}
+		else if (base.value[P::CrossSection] <= 0.0)
+			throw cadet::InvalidParameterException("At least one of CROSS_SECTION_AREA and VELOCITY has to be set");
+
+		if (base.value[P::Velocity] < 0.0)
+			return "backward flow";
+
+		const bool lrm = (_model == laplace::ColumnModel::LumpedRateWithoutPores);
+		if (!uniformScalar(pp, lrm ? "TOTAL_POROSITY" : "COL_POROSITY", base.value[P::ColPorosity]))
+			return "section dependent parameters";
+
+		std::vector<double> dispersion;
+		std::vector<double> filmDiff(_nComp, 0.0);
+		std::vector<double> parDiff(_nComp, 0.0);
+		if (!uniformComponentParam(pp, "COL_DISPERSION", nSec, dispersion))
+			return "section dependent parameters";
+
+		if (!lrm)
+		{
+			if (!uniformScalar(pp, "PAR_POROSITY", base.value[P::ParPorosity]) || !uniformScalar(pp, "PAR_RADIUS", base.value[P::ParRadius])
+				|| !uniformComponentParam(pp, "FILM_DIFFUSION", nSec, filmDiff))
+				return "section dependent parameters";
+
+			if ((_model == laplace::ColumnModel::GeneralRate) && !uniformComponentParam(pp, "PAR_DIFFUSION", nSec, parDiff))
+				return "section dependent parameters";
+		}
+		else
+			base.value[P::ParPorosity] = 1.0;
+
+		// Linear binding is stated per bound state
+		std::vector<double> kA;
+		std::vector<double> kD;
+		std::vector<int> kinetic;
+		const bool linear = (bindModel[0] == "LINEAR");
+		if (linear)
+		{
+			pp.pushScope("adsorption");
+			kA = pp.getDoubleArray("LIN_KA");
+			kD = pp.getDoubleArray("LIN_KD");
+			if (pp.isArray("IS_KINETIC"))
+				kinetic = pp.getIntArray("IS_KINETIC");
+			else
+				kinetic.assign(1, pp.getInt("IS_KINETIC"));
+			pp.popScope();
+		}
+
+		_params.assign(_nComp, base);
+		_boundIdx.assign(_nComp, -1);
+		unsigned int bnd = 0;
+		for (unsigned int comp = 0; comp < _nComp; ++comp)
+		{
+			P& p = _params[comp];
+			p.value[P::Dispersion] = dispersion[comp];
+			p.value[P::FilmDiffusion] = filmDiff[comp];
+			p.value[P::ParDiffusion] = parDiff[comp];
+
+			if (nBound[comp] > 1)
+				return "multiple bound states";
+			if ((nBound[comp] == 0) || !linear)
+				continue;
+
+			if ((kA.size() <= bnd) || (kD.size() <= bnd))
+				throw cadet::InvalidParameterException("Fields LIN_KA and LIN_KD require an element for each bound state");
+
+			_boundIdx[comp] = bnd;
+			p.binding = true;
+			p.kinetic = (kinetic.size() == 1) ? (kinetic[0] != 0) : ((kinetic.size() > bnd) && (kinetic[bnd] != 0));
+			p.value[P::LinKA] = kA[bnd];
+			p.value[P::LinKD] = kD[bnd];
+			++bnd;
+
+			if (!p.kinetic && (p.value[P::LinKD] <= 0.0))
+				return "rapid equilibrium without desorption";
+		}
+
+		return std::string();
+	}
+
+	template <typename ParamProvider_t>
+	std::string readSensitivities(ParamProvider_t& pp)
+	{
+		typedef laplace::ColumnParameters P;
+
+		_sens.clear();
+		if (!pp.exists("sensitivity"))
+			return std::string();
+
+		pp.pushScope("sensitivity");
+		const unsigned int numSens = static_cast<unsigned int>(pp.getInt("NSENS"));
+		const bool lrm = (_model == laplace::ColumnModel::LumpedRateWithoutPores);
+		const bool grm = (_model == laplace::ColumnModel::GeneralRate);
+
+		std::string reason;
+		for (unsigned int i = 0; (i < numSens) && reason.empty(); ++i)
+		{
+			std::ostringstream oss;
+			oss << "param_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
+			pp.pushScope(oss.str());
+
+			const std::vector<std::string> sensName = pp.getStringArray("SENS_NAME");
+			const std::vector<int> sensUnit = pp.getIntArray("SENS_UNIT");
+			const std::vector<int> sensComp = pp.getIntArray("SENS_COMP");
+			const std::vector<int> sensSection = pp.getIntArray("SENS_SECTION");
+			const std::vector<int> sensBoundState = pp.getIntArray("SENS_BOUNDPHASE");
+			std::vector<double> sensFactor(sensName.size(), 1.0);
+			if (pp.exists("SENS_FACTOR"))
+				sensFactor = pp.getDoubleArray("SENS_FACTOR");
+
+			pp.popScope();
+
+			std::vector<SensEntry> entries;
+			for (unsigned int j = 0; (j < sensName.size()) && reason.empty(); ++j)
+			{
+				// Independent indices are normalized by conversion to ParameterId
+				const std::string& name = sensName[j];
+				const cadet::ParameterId id = cadet::makeParamId(name, sensUnit[j], sensComp[j], cadet::ParTypeIndep, sensBoundState[j], cadet::ReactionIndep, sensSection[j]);
+
+				SensEntry e;
+				e.inlet = -1;
+				e.param = P::NumParameters;
+				e.comp = (id.component == cadet::CompIndep) ? -1 : static_cast<int>(id.component);
+				e.section = 0;
+				e.degree = 0;
+				e.factor = sensFactor[j];
+
+				const std::vector<UnitOpIdx>::const_iterator itInlet = std::find(_inlets.begin(), _inlets.end(), id.unitOperation);
+				if (itInlet != _inlets.end())
+				{
+					const char* const names[] = {"CONST_COEFF", "LIN_COEFF", "QUAD_COEFF", "CUBE_COEFF"};
+					e.degree = std::find(names, names + 4, name) - names;
+					if ((e.degree >= 4) || (e.comp < 0) || (e.comp >= static_cast<int>(_nComp)) || (id.section == cadet::SectionIndep) || (id.section >= _secTimes.size() - 1))
+						reason = "sensitivities of inlet parameter " + name;
+
+					e.inlet = itInlet - _inlets.begin();
+					e.section = id.section;
+				}
+				else if ((id.unitOperation == _column) && (id.section == cadet::SectionIndep))
+				{
+					if (name == "COL_LENGTH")
+						e.param = P::Length;
+					else if (name == (lrm ? "TOTAL_POROSITY" : "COL_POROSITY"))
+						e.param = P::ColPorosity;
+					else if ((name == "VELOCITY") && (_params.front().value[P::CrossSection] <= 0.0))
+						e.param = P::Velocity;
+					else if ((name == "CROSS_SECTION_AREA") && (_params.front().value[P::CrossSection] > 0.0))
+						e.param = P::CrossSection;
+					else if (name == "COL_DISPERSION")
+						e.param = P::Dispersion;
+					else if (!lrm && (name == "PAR_POROSITY"))
+						e.param = P::ParPorosity;
+					else if (!lrm && (name == "PAR_RADIUS"))
+						e.param = P::ParRadius;
+					else if (!lrm && (name == "FILM_DIFFUSION"))
+						e.param = P::FilmDiffusion;
+					else if (grm && (name == "PAR_DIFFUSION"))
+						e.param = P::ParDiffusion;
+					else if (((name == "LIN_KA") || (name == "LIN_KD")) && (e.comp >= 0) && (e.comp < static_cast<int>(_nComp)) && (_boundIdx[e.comp] >= 0) && ((id.boundState == cadet::BoundStateIndep) || (id.boundState == 0)))
+						e.param = (name == "LIN_KA") ? P::LinKA : P::LinKD;
+					else
+						reason = "sensitivities of parameter " + name;
+
+					if (e.comp >= static_cast<int>(_nComp))
+						reason = "sensitivities of parameter " + name;
+				}
+				else
+					reason = "sensitivities of parameter " + name;
+
+				entries.push_back(e);
+			}
+
+			_sens.push_back(std::move(entries));
+		}
+
+		pp.popScope(); // sensitivity scope
+		return reason;
+	}
+
+	/**
+	 * @brief Computes outlet profile and its sensitivities of one component
+	 * @param [in] comp Index of the component
+	 * @param [in] mixCoeff Coefficients of the mixed inlet profile of the column
+	 * @param [out] outlet Outlet profiles
+	 * @param [out] sensOutlet Sensitivities of the outlet profiles
+	 * @return Number of terms used for inverting the transfer function
+	 */
+	unsigned int solveComponent(unsigned int comp, const std::vector<double>& mixCoeff, std::vector<double>& outlet, std::vector<std::vector<double>>& sensOutlet) const
+	{
+		typedef laplace::ColumnParameters P;
+
+		const unsigned int nTimes = _times.size();
+		const double tMax = _secTimes.back() - _secTimes.front();
+		const double contourTol = std::min(1e-10, 1e-2 * _lapAbsTol);
+
+		std::vector<double> weights;
+		shiftWeights(mixCoeff, comp, 1.0, weights);
+
+		// Double the number of terms until the outlet profile has converged
+		laplace::DeHoogInversion inv;
+		std::vector<laplace::complex_t> G;
+		std::vector<std::vector<laplace::complex_t>> coeffs;
+		std::vector<double> cur(nTimes, 0.0);
+		std::vector<double> prev;
+
+		unsigned int nTerms = _nTerms;
+		while (true)
+		{
+			inv.configure(nTerms, tMax, contourTol);
+
+			// Sampling points of smaller number of terms are reused
+			const std::vector<laplace::complex_t>& abscissas = inv.abscissas();
+			for (std::size_t k = G.size(); k < abscissas.size(); ++k)
+				G.push_back(laplace::columnTransferFunction(_model, _params[comp], P::NumParameters, abscissas[k]).value());
+
+			fitResponses(inv, G, coeffs);
+			evaluateResponse(inv, coeffs, weights, cur.data());
+
+			if (!prev.empty())
+			{
+				double maxChange = 0.0;
+				for (unsigned int i = 0; i < nTimes; ++i)
+					maxChange = std::max(maxChange, std::abs(cur[i] - prev[i]) / (_lapRelTol * std::abs(cur[i]) + _lapAbsTol));
+
+				LOG(Debug) << "Laplace domain solver component " << comp << " with " << nTerms << " terms: max weighted change " << maxChange;
+				if (maxChange <= 1.0)
+					break;
+			}
+
+			if (2 * nTerms > _maxTerms)
+			{
+				if (nTerms > _nTerms)
+					LOG(Warning) << "Inversion of transfer function of component " << comp << " has not converged with " << nTerms << " terms";
+				break;
+			}
+
+			prev.swap(cur);
+			cur.assign(nTimes, 0.0);
+			nTerms *= 2;
+		}
+
+		for (unsigned int i = 0; i < nTimes; ++i)
+			outlet[i * _nComp + comp] = cur[i];
+
+		// Sensitivities use the converged number of terms
+		const std::vector<laplace::complex_t>& abscissas = inv.abscissas();
+		std::vector<laplace::complex_t> dG(abscissas.size());
+		std::vector<std::vector<laplace::complex_t>> dCoeffs;
+		std::vector<double> sensWeights;
+		std::vector<double> res(nTimes);
+		for (unsigned int s = 0; s < _sens.size(); ++s)
+		{
+			for (const SensEntry& e : _sens[s])
+			{
+				if ((e.comp >= 0) && (e.comp != static_cast<int>(comp)))
+					continue;
+
+				std::fill(res.begin(), res.end(), 0.0);
+				if (e.inlet >= 0)
+				{
+					// Inlet profile is linear in its coefficients
+					std::vector<double> unit(mixCoeff.size(), 0.0);
+					unit[(e.section * 4 + e.degree) * _nComp + comp] = _inletFraction[e.inlet];
+					shiftWeights(unit, comp, e.factor, sensWeights);
+					evaluateResponse(inv, coeffs, sensWeights, res.data());
+				}
+				else
+				{
+					for (std::size_t k = 0; k < abscissas.size(); ++k)
+						dG[k] = laplace::columnTransferFunction(_model, _params[comp], e.param, abscissas[k]).derivative();
+
+					fitResponses(inv, dG, dCoeffs);
+					shiftWeights(mixCoeff, comp, e.factor, sensWeights);
+					evaluateResponse(inv, dCoeffs, sensWeights, res.data());
+				}
+
+				for (unsigned int i = 0; i < nTimes; ++i)
+					sensOutlet[s][i * _nComp + comp] += res[i];
+			}
+		}
+
+		return nTerms;
+	}
+
+	/**
+	 * @brief Computes the continued fractions of the step responses @f$ F(s) / s^{j+1} @f$, @f$ j = 0, \dots, 3 @f$
+	 * @param [in] inv Inversion method
+	 * @param [in] F Transfer function sampled at the abscissas of the inversion method
+	 * @param [out] coeffs Continued fraction coefficients of each response
+	 */
+	static void fitResponses(const laplace::DeHoogInversion& inv, const std::vector<laplace::complex_t>& F, std::vector<std::vector<laplace::complex_t>>& coeffs)
+	{
+		const std::vector<laplace::complex_t>& abscissas = inv.abscissas();
+		std::vector<laplace::complex_t> samples(abscissas.size());
+
+		coeffs.resize(4);
+		for (unsigned int j = 0; j < 4; ++j)
+		{
+			for (std::size_t k = 0; k < abscissas.size(); ++k)
+				samples[k] = F[k] / std::pow(abscissas[k], static_cast<int>(j + 1));
+			inv.fit(samples.data(), coeffs[j]);
+		}
+	}
+
+	/**
+	 * @brief Evaluates the response to a piecewise polynomial inlet profile at all output times
+	 * @details The response is @f$ \sum_i \sum_j w_{ij} h_j(t - \tau_i) @f$, where @f$ h_j @f$ is the inverse
+	 *          transform of @f$ F(s) / s^{j+1} @f$ and @f$ \tau_i @f$ are the section times.
+	 * @param [in] inv Inversion method
+	 * @param [in] coeffs Continued fraction coefficients of the responses
+	 * @param [in] weights Weights @f$ w_{ij} @f$ computed by shiftWeights()
+	 * @param [out] res Response at each output time
+	 */
+	void evaluateResponse(const laplace::DeHoogInversion& inv, const std::vector<std::vector<laplace::complex_t>>& coeffs, const std::vector<double>& weights, double* res) const
+	{
+		for (unsigned int i = 0; i < _times.size(); ++i)
+		{
+			double val = 0.0;
+			for (unsigned int sec = 0; sec < _secTimes.size(); ++sec)
+			{
+				const double t = _times[i] - _secTimes[sec];
+				if (t <= 0.0)
+					break;
+
+				for (unsigned int j = 0; j < 4; ++j)
+				{
+					const double w = weights[sec * 4 + j];
+					if (w != 0.0)
+						val += w * inv.evaluate(coeffs[j], t);
+				}
+			}
+			res[i] = val;
+		}
+	}
+
+	/**
+	 * @brief Expresses the Laplace transform of a piecewise polynomial profile by shifted powers of @f$ 1/s @f$
+	 * @details The profile @f$ \sum_k a_{ik} (t - t_i)^k @f$ on section @f$ [t_i, t_{i+1}) @f$ has the Laplace transform
+	 *          @f[ \exp(-s t_i) \sum_k \frac{a_{ik} k!}{s^{k+1}} - \exp(-s t_{i+1}) \sum_k a_{ik} \sum_{j=0}^k \frac{k!}{(k-j)!} \frac{\Delta t_i^{k-j}}{s^{j+1}}. @f]
+	 * @param [in] coeff Coefficients in section-degree-component ordering
+	 * @param [in] comp Index of the component
+	 * @param [in] factor Factor applied to all weights
+	 * @param [out] weights Weight of @f$ \exp(-s t_i) / s^{j+1} @f$ at index @f$ 4i + j @f$
+	 */
+	void shiftWeights(const std::vector<double>& coeff, unsigned int comp, double factor, std::vector<double>& weights) const
+	{
+		static const double factorial[] = {1.0, 1.0, 2.0, 6.0};
+
+		weights.assign(_secTimes.size() * 4, 0.0);
+		for (unsigned int sec = 0; sec + 1 < _secTimes.size(); ++sec)
+		{
+			const double dt = _secTimes[sec + 1] - _secTimes[sec];
+			for (unsigned int k = 0; k < 4; ++k)
+			{
+				const double a = factor * coeff[(sec * 4 + k) * _nComp + comp];
+				if (a == 0.0)
+					continue;
+
+				weights[sec * 4 + k] += a * factorial[k];
+				for (unsigned int j = 0; j <= k; ++j)
+					weights[(sec + 1) * 4 + j] -= a * factorial[k] / factorial[k - j] * std::pow(dt, static_cast<int>(k - j));
+			}
+		}
+	}
+
+	/**
+	 * @brief Evaluates a piecewise polynomial inlet profile
+	 * @details Section transitions belong to the preceding section.
+	 * @param [in] coeff Coefficients in section-degree-component ordering
+	 * @param [in] t Time point
+	 * @param [out] conc Concentration of each component
+	 */
+	void evaluateInlet(const std::vector<double>& coeff, double t, double* conc) const
+	{
+		const unsigned int sec = sectionIndex(t);
+		const double dt = t - _secTimes[sec];
+		double const* const c = coeff.data() + sec * 4 * _nComp;
+		for (unsigned int comp = 0; comp < _nComp; ++comp)
+			conc[comp] = c[comp] + dt * (c[_nComp + comp] + dt * (c[2 * _nComp + comp] + dt * c[3 * _nComp + comp]));
+	}
+
+	inline double inletBasis(unsigned int section, unsigned int degree, double t) const
+	{
+		if (sectionIndex(t) != section)
+			return 0.0;
+		return std::pow(t - _secTimes[section], static_cast<int>(degree));
+	}
+
+	inline unsigned int sectionIndex(double t) const
+	{
+		const std::vector<double>::const_iterator it = std::lower_bound(_secTimes.begin() + 1, _secTimes.end() - 1, t);
+		return it - _secTimes.begin() - 1;
+	}
+
+	static inline bool storesAny(const cadet::InternalStorageUnitOpRecorder::StorageConfig& cfg)
+	{
+		return cfg.storeInlet || cfg.storeOutlet || cfg.storeVolume || !onlyPorts(cfg);
+	}
+
+	static inline bool onlyPorts(const cadet::InternalStorageUnitOpRecorder::StorageConfig& cfg)
+	{
+		// Volumes are ignored since neither inlets, outlets, nor columns have one
+		return !cfg.storeBulk && !cfg.storeParticle && !cfg.storeSolid && !cfg.storeFlux;
+	}
+
+	/**
+	 * @brief Checks whether all elements of an optional array equal a given value
+	 */
+	template <typename ParamProvider_t>
+	static bool allEqual(ParamProvider_t& pp, const std::string& name, double val)
+	{
+		if (!pp.exists(name))
+			return true;
+
+		const std::vector<double> v = pp.getDoubleArray(name);
+		return std::all_of(v.begin(), v.end(), [=](double x) { return x == val; });
+	}
+
+	/**
+	 * @brief Reads a scalar parameter that may be given for each section with identical values
+	 */
+	template <typename ParamProvider_t>
+	static bool uniformScalar(ParamProvider_t& pp, const std::string& name, double& val)
+	{
+		const std::vector<double> v = pp.getDoubleArray(name);
+		val = v.front();
+		return std::all_of(v.begin(), v.end(), [=](double x) { return x == val; });
+	}
+
+	/**
+	 * @brief Reads a component dependent parameter that may be given for each section with identical values
+	 * @details The layout is taken from the optional @c _MULTIPLEX field (@c 0 independent, @c 1 component dependent,
+	 *          @c 2 section dependent, @c 3 component and section dependent) or inferred from the number of elements.
+	 */
+	template <typename ParamProvider_t>
+	bool uniformComponentParam(ParamProvider_t& pp, const std::string& name, unsigned int nSec, std::vector<double>& val) const
+	{
+		const std::vector<double> v = pp.getDoubleArray(name);
+
+		int mode = -1;
+		if (pp.exists(name + "_MULTIPLEX"))
+			mode = pp.getInt(name + "_MULTIPLEX");
+		else if (v.size() == 1)
+			mode = 0;
+		else if (v.size() == _nComp)
+			mode = 1;
+		else if (v.size() == nSec)
+			mode = 2;
+		else if (v.size() == _nComp * nSec)
+			mode = 3;
+		else
+			throw cadet::InvalidParameterException("Number of elements in field " + name + " is not 1, NCOMP, NSEC, or NCOMP * NSEC");
+
+		const unsigned int blockSize = (mode % 2 == 1) ? _nComp : 1;
+		const unsigned int nBlocks = (mode >= 2) ? nSec : 1;
+		if (v.size() < blockSize * nBlocks)
+			throw cadet::InvalidParameterException("Field " + name + " contains too few elements");
+
+		for (unsigned int i = blockSize; i < blockSize * nBlocks; ++i)
+		{
+			if (v[i] != v[i % blockSize])
+				return false;
+		}
+
+		if (blockSize == 1)
+			val.assign(_nComp, v[0]);
+		else
+			val.assign(v.begin(), v.begin() + _nComp);
+		return true;
+	}
+
+	bool _useLaplace; //!< Determines whether the transfer functions are used
+	laplace::ColumnModel _model; //!< Model of the column
+	UnitOpIdx _column; //!< Index of the column
+	unsigned int _nComp; //!< Number of components
+	std::vector<laplace::ColumnParameters> _params; //!< Parameters of the column for each component
+	std::vector<int> _boundIdx; //!< Bound state index of each component, or @c -1 if it does not bind
+	std::vector<UnitOpIdx> _inlets; //!< Inlet unit operations feeding the column
+	std::vector<double> _inletFraction; //!< Fraction of the column flow rate of each inlet
+	std::vector<std::vector<double>> _inletCoeff; //!< Polynomial coefficients of each inlet in section-degree-component ordering
+	std::vector<UnitOpIdx> _outlets; //!< Outlet unit operations fed by the column
+	std::vector<std::vector<SensEntry>> _sens; //!< Parameters of each sensitivity
+	std::vector<double> _secTimes; //!< Section times
+	std::vector<double> _times; //!< Output times
+
+	unsigned int _nTerms; //!< Initial number of terms of the inversion
+	unsigned int _maxTerms; //!< Maximum number of terms of the inversion
+	double _lapRelTol; //!< Relative tolerance of the outlet profiles
+	double _lapAbsTol; //!< Absolute tolerance of the outlet profiles
+
+	unsigned int _termsUsed; //!< Largest number of terms used in the last run
+	double _lapWallTime; //!< Wall time of the last run
+
+private:
+	LaplaceDriver(const LaplaceDriver&) = delete;
+};
+
+} // namespace cadet
+
+#endif  // CADET_LAPLACEDRIVER_HPP_
@@ -0,0 +1,374 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides transfer functions of linear column models and numerical inversion of Laplace transforms
+ */
+
+#ifndef CADET_LAPLACETRANSFORM_HPP_
+#define CADET_LAPLACETRANSFORM_HPP_
+
+#include <vector>
+#include <complex>
+#include <cmath>
+
+#include "cadet/cadetCompilerInfo.hpp"
+
+namespace cadet
+{
+
+namespace laplace
+{
+
+typedef std::complex<double> complex_t;
+
+/**
+ * @brief Complex number with derivative in one direction (forward mode AD)
+ */
+class ComplexDual
+{
+public:
+	ComplexDual() CADET_NOEXCEPT : _v(0.0), _d(0.0) { }
+	ComplexDual(const complex_t& v) CADET_NOEXCEPT : _v(v), _d(0.0) { }
+	ComplexDual(double v) CADET_NOEXCEPT : _v(v), _d(0.0) { }
+	ComplexDual(const complex_t& v, const complex_t& d) CADET_NOEXCEPT : _v(v), _d(d) { }
+
+	inline const complex_t& value() const CADET_NOEXCEPT { return _v; }
+	inline const complex_t& derivative() const CADET_NOEXCEPT { return _d; }
+
+	inline ComplexDual operator-() const CADET_NOEXCEPT { return ComplexDual(-_v, -_d); }
+
+	friend inline ComplexDual operator+(const ComplexDual& a, const ComplexDual& b) CADET_NOEXCEPT { return ComplexDual(a._v + b._v, a._d + b._d); }
+	friend inline ComplexDual operator-(const ComplexDual& a, const ComplexDual& b) CADET_NOEXCEPT { return ComplexDual(a._v - b._v, a._d - b._d); }
+	friend inline ComplexDual operator*(const ComplexDual& a, const ComplexDual& b) CADET_NOEXCEPT { return ComplexDual(a._v * b._v, a._d * b._v + a._v * b._d); }
+	friend inline ComplexDual operator/(const ComplexDual& a, const ComplexDual& b) CADET_NOEXCEPT
+	{
+		const complex_t q = a._v / b._v;
+		return ComplexDual(q, (a._d - q * b._d) / b._v);
+	}
+
+	friend inline ComplexDual exp(const ComplexDual& a) CADET_NOEXCEPT
+	{
+		const complex_t e = std::exp(a._v);
+		return ComplexDual(e, e * a._d);
+	}
+
+	friend inline ComplexDual sqrt(const ComplexDual& a) CADET_NOEXCEPT
+	{
+		const complex_t r = std::sqrt(a._v);
+		return ComplexDual(r, a._d / (2.0 * r));
+	}
+
+	/**
+	 * @brief Computes @f$ x \coth(x) - 1 @f$ for @f$ \operatorname{Re}(x) \geq 0 @f$
+	 * @details Uses the Taylor series for small arguments to avoid cancellation.
+	 */
+	friend inline ComplexDual xCothXm1(const ComplexDual& a) CADET_NOEXCEPT
+	{
+		const complex_t& x = a._v;
+		if (std::abs(x) < 0.5)
+		{
+			// x coth(x) - 1 = x^2/3 - x^4/45 + 2x^6/945 - x^8/4725 + 2x^10/93555 - ...
+			const complex_t x2 = x * x;
+			const complex_t v = x2 * (1.0 / 3.0 + x2 * (-1.0 / 45.0 + x2 * (2.0 / 945.0 + x2 * (-1.0 / 4725.0 + x2 * (2.0 / 93555.0 - x2 * 1382.0 / 638512875.0)))));
+			const complex_t dv = x * (2.0 / 3.0 + x2 * (-4.0 / 45.0 + x2 * (12.0 / 945.0 + x2 * (-8.0 / 4725.0 + x2 * (20.0 / 93555.0 - x2 * 16584.0 / 638512875.0)))));
+			return ComplexDual(v, dv * a._d);
+		}
+
+		// coth(x) = (1 + exp(-2x)) / (1 - exp(-2x)) does not overflow for Re(x) >= 0
+		const complex_t e = std::exp(-2.0 * x);
+		const complex_t coth = (1.0 + e) / (1.0 - e);
+
+		// d/dx [x coth(x)] = coth(x) + x (1 - coth(x)^2)
+		return ComplexDual(x * coth - 1.0, (coth + x * (1.0 - coth * coth)) * a._d);
+	}
+
+private:
+	complex_t _v;
+	complex_t _d;
+};
+
+
+/**
+ * @brief Column models with known transfer functions
+ */
+enum class ColumnModel
+{
+	LumpedRateWithoutPores,
+	LumpedRateWithPores,
+	GeneralRate
+};
+
+/**
+ * @brief Parameters of a column model for one component
+ */
+struct ColumnParameters
+{
+	enum Index : unsigned int
+	{
+		Length = 0,
+		ColPorosity, //!< Column porosity (total porosity for the lumped rate model without pores)
+		ParPorosity,
+		Velocity, //!< Interstitial velocity (only used if the cross section area is not positive)
+		CrossSection,
+		FlowRate,
+		Dispersion,
+		FilmDiffusion,
+		ParDiffusion,
+		ParRadius,
+		LinKA,
+		LinKD,
+		NumParameters
+	};
+
+	double value[NumParameters];
+	bool binding; //!< Determines whether the component binds
+	bool kinetic; //!< Determines whether binding is kinetic (@c true) or in rapid equilibrium (@c false)
+};
+
+/**
+ * @brief Evaluates the transfer function of a column with linear binding
+ * @details The transfer function @f$ G(s) = \hat{c}_{\text{out}}(s) / \hat{c}_{\text{in}}(s) @f$ relates
+ *          the Laplace transforms of outlet and inlet concentration of a column that is initially empty.
+ *          The bulk phase has Danckwerts boundary conditions. Binding enters through
+ *          @f$ \hat{q} = K(s) \hat{c}_p @f$ with @f$ K(s) = k_a / (s + k_d) @f$ for kinetic binding and
+ *          @f$ K = k_a / k_d @f$ for rapid equilibrium.
+ * @param [in] model Column model
+ * @param [in] p Parameters of the column
+ * @param [in] seed Index of the parameter (see ColumnParameters::Index) the derivative is taken with
+ *             respect to, or ColumnParameters::NumParameters for no derivative
+ * @param [in] s Laplace variable
+ * @return Transfer function and its derivative with respect to the seeded parameter
+ */
+inline ComplexDual columnTransferFunction(ColumnModel model, const ColumnParameters& p, unsigned int seed, const complex_t& s)
+{
+	ComplexDual v[ColumnParameters::NumParameters];
+	for (unsigned int i = 0; i < ColumnParameters::NumParameters; ++i)
+		v[i] = ComplexDual(p.value[i], (i == seed) ? 1.0 : 0.0);
+
+	const ComplexDual one(1.0);
+	const ComplexDual& colPor = v[ColumnParameters::ColPorosity];
+	const ComplexDual& parPor = v[ColumnParameters::ParPorosity];
+
+	ComplexDual K(0.0);
+	if (p.binding)
+	{
+		if (p.kinetic)
+			K = v[ColumnParameters::LinKA] / (s + v[ColumnParameters::LinKD]);
+		else
+			K = v[ColumnParameters::LinKA] / v[ColumnParameters::LinKD];
+	}
+
+	// Volumetric capacity of the particles relative to their pore volume
+	const ComplexDual B = one + (one - parPor) / parPor * K;
+	const ComplexDual phaseRatio = (one - colPor) / colPor;
+
+	// Effective rate g(s) of the bulk phase balance s c = -u c' + D_ax c'' - (g(s) - s) c
+	ComplexDual g;
+	switch (model)
+	{
+		case ColumnModel::LumpedRateWithoutPores:
+			g = s * (one + phaseRatio * K);
+			break;
+		case ColumnModel::LumpedRateWithPores:
+		{
+			const ComplexDual& kf = v[ColumnParameters::FilmDiffusion];
+			const ComplexDual& rp = v[ColumnParameters::ParRadius];
+			const ComplexDual sB = s * B;
+			g = s + phaseRatio * 3.0 * kf / rp * sB / (sB + 3.0 * kf / (parPor * rp));
+			break;
+		}
+		case ColumnModel::GeneralRate:
+		{
+			const ComplexDual& kf = v[ColumnParameters::FilmDiffusion];
+			const ComplexDual& dp = v[ColumnParameters::ParDiffusion];
+			const ComplexDual& rp = v[ColumnParameters::ParRadius];
+
+			// Flux into a spherical particle relative to the bulk concentration
+			const ComplexDual phi = rp * sqrt(s * B / dp);
+			const ComplexDual Y = one / (one / kf + rp / (parPor * dp * xCothXm1(phi)));
+			g = s + phaseRatio * 3.0 / rp * Y;
+			break;
+		}
+	}
+
+	const ComplexDual& L = v[ColumnParameters::Length];
+	const ComplexDual& dAx = v[ColumnParameters::Dispersion];
+	const ComplexDual u = (p.value[ColumnParameters::CrossSection] > 0.0) ? v[ColumnParameters::FlowRate] / (v[ColumnParameters::CrossSection] * colPor) : v[ColumnParameters::Velocity];
+
+	if (p.value[ColumnParameters::Dispersion] <= 0.0)
+		return exp(-g * L / u);
+
+	// G(s) = 4a exp(Pe (1 - a) / 2) / ((1 + a)^2 - (1 - a)^2 exp(-a Pe)) with a = sqrt(1 + 4 D_ax g / u^2)
+	const ComplexDual pe = u * L / dAx;
+	const ComplexDual a = sqrt(one + 4.0 * dAx * g / (u * u));
+	const ComplexDual ap = one + a;
+	const ComplexDual am = one - a;
+	return 4.0 * a * exp(0.5 * pe * am) / (ap * ap - am * am * exp(-a * pe));
+}
+
+
+/**
+ * @brief Numerical inversion of Laplace transforms by the method of de Hoog, Knight, and Stokes
+ * @details The inverse transform is approximated by a Fourier series on a contour parallel to the
+ *          imaginary axis,
+ *          @f[ f(t) \approx \frac{\exp(\gamma t)}{T} \operatorname{Re}\left[ \frac{F(\gamma)}{2} + \sum_{k=1}^{2M} F\left(\gamma + \frac{ik\pi}{T}\right) \exp\left(\frac{ik\pi t}{T}\right) \right], @f]
+ *          whose convergence is accelerated by a continued fraction (computed by the quotient-difference
+ *          algorithm) with improved remainder. The transform is sampled once and the inverse can then
+ *          be evaluated at arbitrary time points in @f$ (0, t_{\text{max}}] @f$.
+ *
+ *          See de Hoog, Knight, Stokes (1982). An improved method for numerical inversion of Laplace
+ *          transforms. SIAM J. Sci. Stat. Comput. 3(3), 357-366.
+ */
+class DeHoogInversion
+{
+public:
+	DeHoogInversion() CADET_NOEXCEPT : _nTerms(0), _T(0.0), _gamma(0.0) { }
+
+	/**
+	 * @brief Sets up the sampling contour
+	 * @param [in] nTerms Number of terms @f$ M @f$ (the transform is sampled at @f$ 2M+1 @f$ points)
+	 * @param [in] tMax Largest time point
+	 * @param [in] tol Target relative error of the discretization
+	 */
+	void configure(unsigned int nTerms, double tMax, double tol)
+	{
+		_nTerms = nTerms;
+		_T = 2.0 * tMax;
+		_gamma = -std::log(tol) / (2.0 * _T);
+
+		_abscissas.resize(2 * nTerms + 1);
+		for (unsigned int k = 0; k < _abscissas.size(); ++k)
+			_abscissas[k] = complex_t(_gamma, k * pi() / _T);
+	}
+
+	/**
+	 * @brief Returns the points at which the transform has to be sampled
+	 * @return Sampling points
+	 */
+	inline const std::vector<complex_t>& abscissas() const CADET_NOEXCEPT { return _abscissas; }
+
+	/**
+	 * @brief Computes the continued fraction coefficients from the sampled transform
+	 * @param [in] F Transform sampled at all abscissas()
+	 * @param [out] d Coefficients of the continued fraction
+	 */
+	void fit(complex_t const* F, std::vector<complex_t>& d) const
+	{
+		const unsigned int M = _nTerms;
+		const unsigned int nSamples = 2 * M + 1;
+		d.assign(nSamples, complex_t(0.0));
+
+		std::vector<complex_t> a(F, F + nSamples);
+		a[0] *= 0.5;
+		d[0] = a[0];
+
+		if (a[0] == 0.0)
+		{
+			// Skip leading zero coefficient by falling back to plain summation
+			d.assign(a.begin(), a.end());
+			d.push_back(complex_t(0.0));
+			return;
+		}
+
+		// Quotient-difference table, columns are overwritten in place
+		std::vector<complex_t> q(2 * M);
+		std::vector<complex_t> e(2 * M + 1, complex_t(0.0));
+		for (unsigned int i = 0; i < 2 * M; ++i)
+			q[i] = safeDivide(a[i + 1], a[i]);
+
+		for (unsigned int r = 1; r <= M; ++r)
+		{
+			const unsigned int nE = 2 * (M - r) + 1;
+			for (unsigned int i = 0; i < nE; ++i)
+				e[i] = q[i + 1] - q[i] + e[i + 1];
+
+			d[2 * r - 1] = -q[0];
+			d[2 * r] = -e[0];
+
+			if (r == M)
+				break;
+
+			const unsigned int nQ = nE - 1;
+			for (unsigned int i = 0; i < nQ; ++i)
+				q[i] = safeDivide(q[i + 1] * e[i + 1], e[i]);
+		}
+	}
+
+	/**
+	 * @brief Evaluates the inverse transform
+	 * @param [in] d Coefficients of the continued fraction as computed by fit()
+	 * @param [in] t Time point in @f$ (0, t_{\text{max}}] @f$
+	 * @return Value of the inverse transform
+	 */
+	double evaluate(const std::vector<complex_t>& d, double t) const
+	{
+		const complex_t z = std::polar(1.0, pi() * t / _T);
+
+		if (d.size() > 2 * _nTerms + 1)
+		{
+			// Plain Fourier series
+			complex_t sum(0.0);
+			complex_t zk(1.0);
+			for (unsigned int k = 0; k < 2 * _nTerms + 1; ++k, zk *= z)
+				sum += d[k] * zk;
+			return std::exp(_gamma * t) / _T * sum.real();
+		}
+
+		// Recurrence for numerator and denominator of the continued fraction
+		const unsigned int n = 2 * _nTerms;
+		complex_t aPrev(0.0);
+		complex_t aCur = d[0];
+		complex_t bPrev(1.0);
+		complex_t bCur(1.0);
+		for (unsigned int i = 1; i < n; ++i)
+		{
+			const complex_t aNext = aCur + d[i] * z * aPrev;
+			const complex_t bNext = bCur + d[i] * z * bPrev;
+			aPrev = aCur;
+			aCur = aNext;
+			bPrev = bCur;
+			bCur = bNext;
+		}
+
+		// Improved remainder
+		const complex_t h = 0.5 * (1.0 + (d[n - 1] - d[n]) * z);
+		const complex_t rem = -h * (1.0 - std::sqrt(1.0 + d[n] * z / (h * h)));
+
+		const complex_t num = aCur + rem * aPrev;
+		const complex_t den = bCur + rem * bPrev;
+		return std::exp(_gamma * t) / _T * (num / den).real();
+	}
+
+	inline unsigned int numTerms() const CADET_NOEXCEPT { return _nTerms; }
+
+protected:
+
+	static inline double pi() CADET_NOEXCEPT { return 3.14159265358979323846; }
+
+	static inline complex_t safeDivide(const complex_t& a, const complex_t& b) CADET_NOEXCEPT
+	{
+		return (b == 0.0) ? complex_t(0.0) : a / b;
+	}
+
+	unsigned int _nTerms; //!< Number of terms M
+	double _T; //!< Half period of the Fourier series
+	double _gamma; //!< Real part of the sampling contour
+	std::vector<complex_t> _abscissas; //!< Sampling points
+};
+
+} // namespace laplace
+
+} // namespace cadet
+
+#endif  // CADET_LAPLACETRANSFORM_HPP_
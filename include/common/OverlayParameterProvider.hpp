@@ -0,0 +1,301 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Defines a ParameterProvider that modifies the view on another ParameterProvider.
+ */
+
+#ifndef CADET_OVERLAYPARAMETERPROVIDER_HPP_
+#define CADET_OVERLAYPARAMETERPROVIDER_HPP_
+
+#include "cadet/ParameterProvider.hpp"
+#include "cadet/Exceptions.hpp"
+#include "common/CompilerSpecific.hpp"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace cadet
+{
+
+/**
+ * @brief ParameterProvider that overlays scopes and values on top of another ParameterProvider
+ * @details Scopes are addressed by their path relative to the root scope, e.g., @c model/unit_001
+ *          (the root scope itself is addressed by the empty string). Values set on a scope take
+ *          precedence over the ones of the underlying provider. Added scopes replace scopes of the
+ *          underlying provider of the same path entirely, and hidden scopes appear to be missing.
+ *
+ *          The underlying provider is optional. It has to be in its root scope when this provider
+ *          is in its root scope. Only the scopes of the underlying provider that are not replaced
+ *          or hidden are entered.
+ */
+class OverlayParameterProvider : public cadet::IParameterProvider
+{
+public:
+
+	/**
+	 * @brief Creates an overlay of the given ParameterProvider
+	 * @param [in] base Underlying ParameterProvider or @c nullptr
+	 */
+	OverlayParameterProvider(cadet::IParameterProvider* base) : _base(base), _baseDepth(0) { }
+	virtual ~OverlayParameterProvider() CADET_NOEXCEPT { }
+
+	virtual double getDouble(const std::string& paramName) { return numbers(paramName, &IParameterProvider::getDouble)[0]; }
+	virtual int getInt(const std::string& paramName) { return static_cast<int>(numbers(paramName, &IParameterProvider::getInt)[0]); }
+	virtual uint64_t getUint64(const std::string& paramName) { return static_cast<uint64_t>(numbers(paramName, &IParameterProvider::getUint64)[0]); }
+	virtual bool getBool(const std::string& paramName) { return numbers(paramName, &IParameterProvider::getBool)[0] != 0.0; }
+	virtual std::string getString(const std::string& paramName) { return strings(paramName, &IParameterProvider::getString)[0]; }
+	virtual std::vector<double> getDoubleArray(const std::string& paramName) { return numbers(paramName, &IParameterProvider::getDoubleArray); }
+	virtual std::vector<int> getIntArray(const std::string& paramName) { return convertNumbers(paramName, &IParameterProvider::getIntArray); }
+	virtual std::vector<uint64_t> getUint64Array(const std::string& paramName) { return convertNumbers(paramName, &IParameterProvider::getUint64Array); }
+	virtual std::vector<std::string> getStringArray(const std::string& paramName) { return strings(paramName, &IParameterProvider::getStringArray); }
+
+	virtual std::vector<bool> getBoolArray(const std::string& paramName)
+	{
+		Value const* const v = findValue(paramName);
+		if (!v)
+			return base(paramName).getBoolArray(paramName);
+
+		std::vector<bool> res(v->numbers.size());
+		for (std::size_t i = 0; i < res.size(); ++i)
+			res[i] = (v->numbers[i] != 0.0);
+		return res;
+	}
+
+	virtual bool exists(const std::string& paramName)
+	{
+		if (findValue(paramName))
+			return true;
+
+		const std::unordered_map<std::string, Scope>::const_iterator it = _scopes.find(childPath(paramName));
+		if (it != _scopes.end())
+		{
+			if (it->second.kind == ScopeKind::Hidden)
+				return false;
+			if (it->second.kind == ScopeKind::Replaced)
+				return true;
+		}
+
+		return inBase() && _base->exists(paramName);
+	}
+
+	virtual bool isArray(const std::string& paramName)
+	{
+		Value const* const v = findValue(paramName);
+		if (v)
+			return v->isArray;
+
+		return base(paramName).isArray(paramName);
+	}
+
+	virtual std::size_t numElements(const std::string& paramName)
+	{
+		Value const* const v = findValue(paramName);
+		if (v)
+			return v->strings.empty() ? v->numbers.size() : v->strings.size();
+
+		return base(paramName).numElements(paramName);
+	}
+
+	virtual void pushScope(const std::string& scope)
+	{
+		const std::string path = childPath(scope);
+		const std::unordered_map<std::string, Scope>::const_iterator it = _scopes.find(path);
+		const bool enterBase = inBase() && ((it == _scopes.end()) || (it->second.kind == ScopeKind::Merged));
+
+		if (enterBase)
+		{
+			_base->pushScope(scope);
+			++_baseDepth;
+		}
+
+		_path.push_back(path);
+	}
+
+	virtual void popScope()
+	{
+		if (inBase() && (_baseDepth > 0))
+		{
+			_base->popScope();
+			--_baseDepth;
+		}
+
+		_path.pop_back();
+	}
+
+	/**
+	 * @brief Adds a scope that replaces the one of the underlying provider
+	 * @param [in] path Path of the scope
+	 */
+	inline void addScope(const std::string& path) { _scopes[path].kind = ScopeKind::Replaced; }
+
+	/**
+	 * @brief Hides a scope of the underlying provider
+	 * @param [in] path Path of the scope
+	 */
+	inline void hideScope(const std::string& path) { _scopes[path].kind = ScopeKind::Hidden; }
+
+	/**
+	 * @brief Sets a value in the given scope
+	 * @details If the scope has not been added before, the underlying provider
+	 *          remains visible in this scope.
+	 * @param [in] path Path of the scope
+	 * @param [in] paramName Name of the value
+	 * @param [in] val Value
+	 */
+	inline void set(const std::string& path, const std::string& paramName, const std::vector<double>& val) { value(path, paramName, true).numbers = val; }
+	inline void set(const std::string& path, const std::string& paramName, double val) { value(path, paramName, false).numbers.assign(1, val); }
+	inline void set(const std::string& path, const std::string& paramName, int val) { value(path, paramName, false).numbers.assign(1, val); }
+	inline void set(const std::string& path, const std::string& paramName, bool val) { value(path, paramName, false).numbers.assign(1, val ? 1.0 : 0.0); }
+	inline void set(const std::string& path, const std::string& paramName, const std::string& val) { value(path, paramName, false).strings.assign(1, val); }
+	inline void set(const std::string& path, const std::string& paramName, char const* val) { set(path, paramName, std::string(val)); }
+
+protected:
+
+	enum class ScopeKind
+	{
+		Merged,
+		Replaced,
+		Hidden
+	};
+
+	struct Value
+	{
+		std::vector<double> numbers;
+		std::vector<std::string> strings;
+		bool isArray;
+	};
+
+	struct Scope
+	{
+		Scope() : kind(ScopeKind::Merged) { }
+
+		ScopeKind kind;
+		std::unordered_map<std::string, Value> values;
+	};
+
+	inline const std::string& currentPath() const CADET_NOEXCEPT
+	{
+		static const std::string root;
+		return _path.empty() ? root : _path.back();
+	}
+
+	inline std::string childPath(const std::string& name) const
+	{
+		const std::string& cur = currentPath();
+		return cur.empty() ? name : cur + "/" + name;
+	}
+
+	inline bool inBase() const CADET_NOEXCEPT { return _base && (_baseDepth == _path.size()); }
+
+	inline Value& value(const std::string& path, const std::string& paramName, bool isArray)
+	{
+		Value& v = _scopes[path].values[paramName];
+		v.numbers.clear();
+		v.strings.clear();
+		v.isArray = isArray;
+		return v;
+	}
+
+	inline Value const* findValue(const std::string& paramName) const
+	{
+		const std::unordered_map<std::string, Scope>::const_iterator it = _scopes.find(currentPath());
+		if (it == _scopes.end())
+			return nullptr;
+
+		const std::unordered_map<std::string, Value>::const_iterator itVal = it->second.values.find(paramName);
+		if (itVal == it->second.values.end())
+			return nullptr;
+
+		return &itVal->second;
+	}
+
+	inline cadet::IParameterProvider& base(const std::string& paramName)
+	{
+		if (!inBase())
+			throw InvalidParameterException("Parameter " + paramName + " does not exist in scope " + currentPath());
+
+		return *_base;
+	}
+
+	template <typename T>
+	std::vector<double> numbers(const std::string& paramName, T (IParameterProvider::*getter)(const std::string&))
+	{
+		Value const* const v = findValue(paramName);
+		if (!v)
+			return std::vector<double>(1, static_cast<double>((base(paramName).*getter)(paramName)));
+
+		if (v->numbers.empty())
+			throw InvalidParameterException("Parameter " + paramName + " in scope " + currentPath() + " is not numeric");
+
+		return v->numbers;
+	}
+
+	template <typename T>
+	std::vector<double> numbers(const std::string& paramName, std::vector<T> (IParameterProvider::*getter)(const std::string&))
+	{
+		Value const* const v = findValue(paramName);
+		if (!v)
+		{
+			const std::vector<T> res = (base(paramName).*getter)(paramName);
+			return std::vector<double>(res.begin(), res.end());
+		}
+
+		return v->numbers;
+	}
+
+	template <typename T>
+	std::vector<T> convertNumbers(const std::string& paramName, std::vector<T> (IParameterProvider::*getter)(const std::string&))
+	{
+		Value const* const v = findValue(paramName);
+		if (!v)
+			return (base(paramName).*getter)(paramName);
+
+		std::vector<T> res(v->numbers.size());
+		for (std::size_t i = 0; i < res.size(); ++i)
+			res[i] = static_cast<T>(v->numbers[i]);
+		return res;
+	}
+
+	template <typename T>
+	std::vector<std::string> strings(const std::string& paramName, T (IParameterProvider::*getter)(const std::string&))
+	{
+		Value const* const v = findValue(paramName);
+		if (!v)
+			return std::vector<std::string>(1, (base(paramName).*getter)(paramName));
+
+		if (v->strings.empty())
+			throw InvalidParameterException("Parameter " + paramName + " in scope " + currentPath() + " is not a string");
+
+		return v->strings;
+	}
+
+	std::vector<std::string> strings(const std::string& paramName, std::vector<std::string> (IParameterProvider::*getter)(const std::string&))
+	{
+		Value const* const v = findValue(paramName);
+		if (!v)
+			return (base(paramName).*getter)(paramName);
+
+		return v->strings;
+	}
+
+	cadet::IParameterProvider* _base; //!< Underlying ParameterProvider
+	std::size_t _baseDepth; //!< Number of scopes entered in the underlying provider
+	std::vector<std::string> _path; //!< Paths of the entered scopes
+	std::unordered_map<std::string, Scope> _scopes; //!< Overlaid scopes by path
+};
+
+} // namespace cadet
+
+#endif  // CADET_OVERLAYPARAMETERPROVIDER_HPP_
@@ -0,0 +1,485 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a driver that integrates long multi-section simulations time-parallel using Parareal
+ */
+
+#ifndef CADET_PARAREALDRIVER_HPP_
+#define CADET_PARAREALDRIVER_HPP_
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+
+#include "common/Driver.hpp"
+#include "common/Timer.hpp"
+
+#ifdef CADET_PARALLELIZE
+	#include <tbb/parallel_for.h>
+	#include <tbb/task_arena.h>
+#endif
+
+namespace cadet
+{
+
+/**
+ * @brief Driver that integrates a simulation time-parallel using the Parareal algorithm
+ * @details The time domain is split into slices along discontinuous section transitions. A coarse
+ *          propagator (same model with loosened time integrator tolerances) sequentially predicts
+ *          the states at the slice boundaries. The fine propagators (one simulator per slice with the
+ *          original settings) then integrate all slices concurrently from these states. The boundary
+ *          states are corrected by
+ *          @f[ U_{k+1}^{n+1} = G\left(U_k^{n+1}\right) + F\left(U_k^n\right) - G\left(U_k^n\right) @f]
+ *          until their change falls below a tolerance. After @f$ n @f$ iterations, the first
+ *          @f$ n @f$ slices are exact, so the algorithm terminates after at most as many iterations as
+ *          there are slices. The outputs of the fine slices are concatenated.
+ *
+ *          Parareal is configured in the @c parareal group of the solver scope. If the group is
+ *          missing, the driver behaves exactly like a cadet::Driver. Parareal is not applied (and a
+ *          warning is issued) if sensitivities, events, or outlet KPIs are requested, since they
+ *          depend on the full trajectory.
+ *
+ *          The fine slices share the global number of AD directions, which is identical for all of
+ *          them since they are configured from the same input.
+ *
+ *          The slices are distributed over @c NTHREADS threads of the solver scope. Each fine slice is
+ *          integrated single-threaded in its own task arena, so that the thread limit set up by
+ *          Simulator::integrate() does not oversubscribe the threads that process the slices. The
+ *          coarse propagator runs outside of these arenas and uses all threads.
+ */
+class PararealDriver : public Driver
+{
+public:
+	PararealDriver() : Driver(), _maxIter(0), _tol(1.0), _coarseTolFactor(100.0), _relTol(0.0), _iterations(0), _defect(0.0), _converged(false), _nThreads(0), _wallTime(0.0), _coarseTime(0.0), _fineTime(0.0) { }
+
+	~PararealDriver() CADET_NOEXCEPT { }
+
+	/**
+	 * @brief Builds and configures the simulators of all slices and the coarse propagator
+	 * @details The driver itself integrates the first slice and holds the combined results.
+	 * @param [in] pp Implementation of cadet::IParameterProvider used as input
+	 * @tparam ParamProvider_t Type of the parameter provider
+	 */
+	template <typename ParamProvider_t>
+	void configure(ParamProvider_t& pp)
+	{
+		_coarse.reset();
+		_fine.clear();
+		_sliceBounds.clear();
+		_iterations = 0;
+
+		Driver::configure(pp);
+
+		pp.pushScope("solver");
+		_nThreads = pp.exists("NTHREADS") ? static_cast<unsigned int>(std::max(pp.getInt("NTHREADS"), 0)) : 0;
+		if (!pp.exists("parareal"))
+		{
+			pp.popScope();
+			return;
+		}
+
+		pp.pushScope("parareal");
+		const int nSlicesReq = pp.getInt("NSLICES");
+		_maxIter = pp.exists("MAX_ITER") ? static_cast<unsigned int>(std::max(pp.getInt("MAX_ITER"), 1)) : 0;
+		_tol = pp.exists("TOL") ? pp.getDouble("TOL") : 1.0;
+		_coarseTolFactor = pp.exists("COARSE_TOL_FACTOR") ? pp.getDouble("COARSE_TOL_FACTOR") : 100.0;
+		pp.popScope(); // parareal scope
+
+		if (_tol <= 0.0)
+			throw cadet::InvalidParameterException("Parareal tolerance TOL has to be positive");
+		if (_coarseTolFactor < 1.0)
+			throw cadet::InvalidParameterException("Parareal COARSE_TOL_FACTOR has to be at least 1");
+
+		// Error weights of the fine time integrator for judging convergence
+		pp.pushScope("time_integrator");
+		_relTol = pp.getDouble("RELTOL");
+		if (pp.isArray("ABSTOL"))
+			_absTol = pp.getDoubleArray("ABSTOL");
+		else
+			_absTol = std::vector<double>(1, pp.getDouble("ABSTOL"));
+		pp.popScope(); // time_integrator scope
+
+		std::vector<double> secTimes;
+		std::vector<bool> secCont;
+		extractSectionTimes(pp, secTimes, secCont);
+
+		pp.popScope(); // solver scope
+
+		if (_sim->numSensParams() > 0)
+		{
+			LOG(Warning) << "Parareal does not support sensitivities, falling back to sequential time integration";
+			return;
+		}
+		if (_sim->numEvents() > 0)
+		{
+			LOG(Warning) << "Parareal does not support events, falling back to sequential time integration";
+			return;
+		}
+		if (_storage->numKpiRecorders() > 0)
+		{
+			LOG(Warning) << "Parareal does not support outlet KPIs, falling back to sequential time integration";
+			return;
+		}
+
+		partitionSections(secTimes, secCont, static_cast<unsigned int>(std::max(nSlicesReq, 1)));
+		const unsigned int nSlices = _sliceBounds.size() - 1;
+		if (nSlices < 2)
+		{
+			LOG(Warning) << "Parareal requires at least two slices separated by discontinuous section transitions, falling back to sequential time integration";
+			_sliceBounds.clear();
+			return;
+		}
+
+		if (_maxIter == 0)
+			_maxIter = nSlices;
+
+		// Coarse propagator does not record any solution
+		_coarse = std::unique_ptr<Driver>(new Driver());
+		_coarse->configure(pp);
+		_coarse->simulator()->setSolutionRecorder(nullptr);
+		_coarse->simulator()->setRelativeErrorTolerance(_relTol * _coarseTolFactor);
+
+		std::vector<double> coarseAbsTol = _absTol;
+		for (double& v : coarseAbsTol)
+			v *= _coarseTolFactor;
+		_coarse->simulator()->setAbsoluteErrorTolerance(coarseAbsTol);
+
+		// Fine propagators of the remaining slices record all time points, which are decimated when
+		// their results are appended to the ones of the first slice
+		_fine.reserve(nSlices - 1);
+		for (unsigned int i = 1; i < nSlices; ++i)
+		{
+			std::unique_ptr<Driver> drv(new Driver());
+			drv->configure(pp);
+			drv->simulator()->setNumThreads(1);
+
+			cadet::InternalStorageSystemRecorder* const rec = drv->solution();
+			rec->storeTime(true);
+			for (unsigned int j = 0; j < rec->numRecorders(); ++j)
+				rec->recorder(j)->timeStride(1);
+
+			_fine.push_back(std::move(drv));
+		}
+
+		LOG(Debug) << "Parareal with " << nSlices << " slices starting at sections " << _sliceBounds << ", at most " << _maxIter << " iterations";
+	}
+
+	/**
+	 * @brief Performs time integration
+	 * @details Uses Parareal if configured. Otherwise, the simulation is integrated sequentially.
+	 */
+	void run()
+	{
+		if (_fine.empty())
+		{
+			Driver::run();
+			return;
+		}
+
+		Timer timer;
+		Timer coarseTimer;
+		Timer fineTimer;
+		timer.start();
+
+		const unsigned int nSlices = _sliceBounds.size() - 1;
+		const unsigned int nDof = _sim->numDofs();
+
+		// State (and its time derivative) at the beginning of each slice and at the end of the last one
+		std::vector<std::vector<double>> u(nSlices + 1);
+		std::vector<std::vector<double>> coarse(nSlices);
+		std::vector<std::vector<double>> fine(nSlices);
+
+		unsigned int len = 0;
+		double const* const y0 = _sim->getLastSolution(len);
+		double const* const yDot0 = _sim->getLastSolutionDerivative(len);
+		u[0].assign(y0, y0 + nDof);
+		u[0].insert(u[0].end(), yDot0, yDot0 + nDof);
+
+		// Coarse prediction
+		coarseTimer.start();
+		for (unsigned int k = 0; k < nSlices; ++k)
+		{
+			propagate(*_coarse->simulator(), k, u[k], coarse[k]);
+			u[k + 1] = coarse[k];
+		}
+		coarseTimer.stop();
+
+		// First slice is integrated by the driver's own simulator, which is restricted to one thread like the other fine propagators
+		_sim->setNumThreads(1);
+
+#ifdef CADET_PARALLELIZE
+		tbb::task_arena arena(_nThreads > 0 ? static_cast<int>(_nThreads) : tbb::task_arena::automatic);
+#endif
+
+		_iterations = 0;
+		_defect = 0.0;
+		for (unsigned int iter = 0; iter < _maxIter; ++iter)
+		{
+			// Slices before iter are already exact and keep their results
+			const auto fineSolve = [&](std::size_t k)
+				{
+					cadet::ISimulator& sim = (k == 0) ? *_sim : *_fine[k - 1]->simulator();
+					propagate(sim, k, u[k], fine[k]);
+				};
+
+			fineTimer.start();
+#ifdef CADET_PARALLELIZE
+			arena.execute([&]()
+				{
+					tbb::parallel_for(std::size_t(iter), std::size_t(nSlices), [&](std::size_t k)
+						{
+							tbb::task_arena sliceArena(1);
+							sliceArena.execute([&]() { fineSolve(k); });
+						});
+				});
+#else
+			for (std::size_t k = iter; k < nSlices; ++k)
+				fineSolve(k);
+#endif
+			fineTimer.stop();
+
+			// Sequential correction sweep
+			double maxChange = 0.0;
+			std::vector<double> coarseNew;
+			std::vector<double> next(2 * nDof);
+			for (unsigned int k = iter; k < nSlices; ++k)
+			{
+				// Starting state of the first unconverged slice has not changed
+				if (k > iter)
+				{
+					coarseTimer.start();
+					propagate(*_coarse->simulator(), k, u[k], coarseNew);
+					coarseTimer.stop();
+				}
+				else
+					coarseNew = coarse[k];
+
+				for (unsigned int i = 0; i < 2 * nDof; ++i)
+					next[i] = coarseNew[i] + fine[k][i] - coarse[k][i];
+
+				for (unsigned int i = 0; i < nDof; ++i)
+				{
+					const double absTol = (_absTol.size() > 1) ? _absTol[i] : _absTol[0];
+					maxChange = std::max(maxChange, std::abs(next[i] - u[k + 1][i]) / (_relTol * std::abs(next[i]) + absTol));
+				}
+
+				coarse[k].swap(coarseNew);
+				u[k + 1] = next;
+			}
+
+			++_iterations;
+			_defect = maxChange;
+			LOG(Debug) << "Parareal iteration " << _iterations << ": max weighted change of slice boundary states " << maxChange;
+
+			if (maxChange <= _tol)
+				break;
+		}
+
+		// After one iteration per slice, all slices have been integrated by the fine propagator from exact starting states
+		_converged = (_defect <= _tol) || (_iterations >= nSlices);
+		if (!_converged)
+		{
+			LOG(Warning) << "Parareal did not converge within " << _maxIter << " iterations, max weighted change of slice boundary states is "
+				<< _defect << " (TOL = " << _tol << ")";
+		}
+
+		// Concatenate results of all slices
+		for (std::unique_ptr<Driver>& drv : _fine)
+			_storage->append(*drv->solution());
+
+		// Final state of the last fine slice is the last state of the simulation
+		_sim->applyInitialCondition(fine.back().data(), fine.back().data() + nDof);
+		_sim->setSectionRange(0, 0);
+		_sim->setNumThreads(_nThreads);
+
+		_wallTime = timer.stop();
+		_coarseTime = coarseTimer.totalElapsedTime();
+		_fineTime = fineTimer.totalElapsedTime();
+
+		LOG(Info) << "Parareal with " << nSlices << " slices finished after " << _iterations << " iterations in " << _wallTime
+			<< " s (coarse propagation " << _coarseTime << " s, fine propagation " << _fineTime << " s)";
+	}
+
+	/**
+	 * @brief Writes the current results to the given writer
+	 * @details Adds Parareal statistics to the @c meta group.
+	 * @param [in] writer Writer to write to
+	 * @tparam Writer_t Type of the writer
+	 */
+	template <typename Writer_t>
+	void write(Writer_t& writer)
+	{
+		Driver::write(writer);
+
+		if (_fine.empty() || (_iterations == 0))
+			return;
+
+		// Time skipped by steady-state detection is spread over all slices
+		if (!_sim->getSteadyStateSkippedTimes().empty())
+		{
+			std::vector<double> skipped = _sim->getSteadyStateSkippedTimes();
+			for (std::unique_ptr<Driver>& drv : _fine)
+			{
+				const std::vector<double>& s = drv->simulator()->getSteadyStateSkippedTimes();
+				for (std::size_t i = 0; i < std::min(skipped.size(), s.size()); ++i)
+					skipped[i] += s[i];
+			}
+
+			writer.pushGroup("output");
+			writer.pushGroup("solution");
+			writer.unlinkDataset("STEADY_STATE_SKIPPED_TIME");
+			writer.vector("STEADY_STATE_SKIPPED_TIME", skipped);
+			writer.popGroup();
+			writer.popGroup();
+		}
+
+		writer.pushGroup("meta");
+
+		const char* const names[] = {"TIME_SIM", "PARAREAL_SLICES", "PARAREAL_ITERATIONS", "PARAREAL_CONVERGED", "PARAREAL_DEFECT", "PARAREAL_THREADS", "PARAREAL_TIME_COARSE", "PARAREAL_TIME_FINE"};
+		for (const char* name : names)
+		{
+			if (writer.exists(name))
+				writer.unlinkDataset(name);
+		}
+
+		writer.scalar("TIME_SIM", _wallTime);
+		writer.scalar("PARAREAL_SLICES", static_cast<int>(numSlices()));
+		writer.scalar("PARAREAL_ITERATIONS", static_cast<int>(_iterations));
+		writer.scalar("PARAREAL_CONVERGED", static_cast<int>(_converged));
+		writer.scalar("PARAREAL_DEFECT", _defect);
+		writer.scalar("PARAREAL_THREADS", static_cast<int>(_nThreads));
+		writer.scalar("PARAREAL_TIME_COARSE", _coarseTime);
+		writer.scalar("PARAREAL_TIME_FINE", _fineTime);
+
+		writer.popGroup();
+	}
+
+	/**
+	 * @brief Returns the number of time slices
+	 * @return Number of time slices, or @c 1 if Parareal is not used
+	 */
+	inline unsigned int numSlices() const CADET_NOEXCEPT { return _fine.size() + 1; }
+
+	/**
+	 * @brief Returns the index of the first section of each slice
+	 * @details The last element is the number of sections. The vector is empty if Parareal is not used.
+	 * @return Section indices of the slice boundaries
+	 */
+	inline const std::vector<unsigned int>& sliceBoundaries() const CADET_NOEXCEPT { return _sliceBounds; }
+
+	inline unsigned int numIterations() const CADET_NOEXCEPT { return _iterations; }
+
+	/**
+	 * @brief Returns whether the last run converged
+	 * @details A run has converged if the weighted change of the slice boundary states in the last
+	 *          iteration is below the tolerance, or if as many iterations as slices have been performed
+	 *          (which yields the sequential solution). Otherwise, the results of the last iteration are
+	 *          returned and a warning is logged.
+	 * @return @c true if the last run converged, otherwise @c false
+	 */
+	inline bool converged() const CADET_NOEXCEPT { return _converged; }
+
+	/**
+	 * @brief Returns the maximum weighted change of the slice boundary states in the last iteration
+	 * @return Final defect of the last run
+	 */
+	inline double finalDefect() const CADET_NOEXCEPT { return _defect; }
+	inline double wallTime() const CADET_NOEXCEPT { return _wallTime; }
+
+	/**
+	 * @brief Returns the measured wall-clock time of all coarse propagations in the last run
+	 * @return Wall-clock time of the coarse propagator in seconds
+	 */
+	inline double coarseTime() const CADET_NOEXCEPT { return _coarseTime; }
+
+	/**
+	 * @brief Returns the measured wall-clock time of all (concurrent) fine propagations in the last run
+	 * @return Wall-clock time of the fine propagators in seconds
+	 */
+	inline double fineTime() const CADET_NOEXCEPT { return _fineTime; }
+
+protected:
+
+	/**
+	 * @brief Splits the sections into slices of roughly equal duration
+	 * @details Slices only begin at discontinuous section transitions.
+	 * @param [in] secTimes Section times
+	 * @param [in] secCont Continuity of section transitions
+	 * @param [in] nSlices Requested number of slices
+	 */
+	void partitionSections(const std::vector<double>& secTimes, const std::vector<bool>& secCont, unsigned int nSlices)
+	{
+		const unsigned int nSections = secTimes.size() - 1;
+		const double sliceLength = (secTimes.back() - secTimes.front()) / nSlices;
+
+		_sliceBounds.clear();
+		_sliceBounds.push_back(0);
+		for (unsigned int i = 1; (i < nSections) && (_sliceBounds.size() < nSlices); ++i)
+		{
+			if ((i - 1 < secCont.size()) && secCont[i - 1])
+				continue;
+
+			if (secTimes[i] >= secTimes.front() + _sliceBounds.size() * sliceLength)
+				_sliceBounds.push_back(i);
+		}
+		_sliceBounds.push_back(nSections);
+	}
+
+	/**
+	 * @brief Integrates a slice
+	 * @param [in] sim Simulator used for integration
+	 * @param [in] slice Index of the slice
+	 * @param [in] start State and its time derivative at the beginning of the slice
+	 * @param [out] end State and its time derivative at the end of the slice
+	 */
+	void propagate(cadet::ISimulator& sim, unsigned int slice, const std::vector<double>& start, std::vector<double>& end) const
+	{
+		const unsigned int nDof = sim.numDofs();
+		sim.setSectionRange(_sliceBounds[slice], _sliceBounds[slice + 1]);
+		sim.applyInitialCondition(start.data(), start.data() + nDof);
+		sim.integrate();
+
+		unsigned int len = 0;
+		double const* const y = sim.getLastSolution(len);
+		double const* const yDot = sim.getLastSolutionDerivative(len);
+		end.assign(y, y + nDof);
+		end.insert(end.end(), yDot, yDot + nDof);
+	}
+
+	std::unique_ptr<Driver> _coarse; //!< Coarse propagator
+	std::vector<std::unique_ptr<Driver>> _fine; //!< Fine propagators of all slices except for the first one
+	std::vector<unsigned int> _sliceBounds; //!< Index of the first section of each slice and number of sections
+
+	unsigned int _maxIter; //!< Maximum number of Parareal iterations
+	double _tol; //!< Tolerance on the weighted change of slice boundary states
+	double _coarseTolFactor; //!< Factor applied to the time integrator tolerances of the coarse propagator
+	double _relTol; //!< Relative tolerance of the fine time integrator
+	std::vector<double> _absTol; //!< Absolute tolerances of the fine time integrator
+
+	unsigned int _iterations; //!< Number of Parareal iterations in the last run
+	double _defect; //!< Maximum weighted change of the slice boundary states in the last iteration of the last run
+	bool _converged; //!< Determines whether the last run converged
+	unsigned int _nThreads; //!< Number of threads that process the slices, @c 0 uses all available threads
+	double _wallTime; //!< Wall time of the last run
+	double _coarseTime; //!< Wall time of the coarse propagations in the last run
+	double _fineTime; //!< Wall time of the fine propagations in the last run
+
+private:
+	PararealDriver(const PararealDriver&) = delete;
+};
+
+} // namespace cadet
+
+#endif  // CADET_PARAREALDRIVER_HPP_
@@ -0,0 +1,398 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a pool of reusable simulators for many runs of structure-identical models
+ */
+
+#ifndef CADET_SIMULATORPOOL_HPP_
+#define CADET_SIMULATORPOOL_HPP_
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+
+#include "common/Driver.hpp"
+
+namespace cadet
+{
+
+namespace detail
+{
+
+template <class ParamProvider_t>
+void appendIntFingerprint(ParamProvider_t& pp, const char* name, std::ostringstream& fp)
+{
+	fp << name << '=';
+	if (pp.exists(name))
+	{
+		for (int v : pp.getIntArray(name))
+			fp << v << ',';
+	}
+	fp << ';';
+}
+
+template <class ParamProvider_t>
+void appendStringFingerprint(ParamProvider_t& pp, const char* name, std::ostringstream& fp)
+{
+	fp << name << '=';
+	if (pp.exists(name))
+	{
+		for (const std::string& v : pp.getStringArray(name))
+			fp << v << ',';
+	}
+	fp << ';';
+}
+
+template <class ParamProvider_t>
+void appendDoubleFingerprint(ParamProvider_t& pp, const char* name, std::ostringstream& fp)
+{
+	fp << name << '=';
+	if (pp.exists(name))
+	{
+		for (double v : pp.getDoubleArray(name))
+			fp << v << ',';
+	}
+	fp << ';';
+}
+
+/**
+ * @brief Computes a fingerprint of the structure of a configuration
+ * @details The fingerprint covers all settings that Driver::reconfigure() does not overwrite:
+ *          unit operation types, numbers of components and bound states, discretizations,
+ *          binding and reaction models, sensitive parameters, and the return configuration.
+ *          Configurations with equal fingerprint can be run by the same driver.
+ * @param [in] pp Implementation of cadet::IParameterProvider used as input
+ * @tparam ParamProvider_t Type of the parameter provider
+ * @return Fingerprint of the structure
+ */
+template <class ParamProvider_t>
+std::string structureFingerprint(ParamProvider_t& pp)
+{
+	std::ostringstream fp;
+	fp << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+	std::ostringstream oss;
+	const auto unitScope = [&oss](int i) -> std::string
+	{
+		oss.str("");
+		oss << "unit_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
+		return oss.str();
+	};
+
+	pp.pushScope("model");
+	const int nUnits = pp.getInt("NUNITS");
+	fp << "NUNITS=" << nUnits << ';';
+	for (int i = 0; i < nUnits; ++i)
+	{
+		const std::string scope = unitScope(i);
+		fp << scope << '{';
+		if (pp.exists(scope))
+		{
+			pp.pushScope(scope);
+			appendStringFingerprint(pp, "UNIT_TYPE", fp);
+			appendIntFingerprint(pp, "NCOMP", fp);
+			appendIntFingerprint(pp, "NBOUND", fp);
+			appendStringFingerprint(pp, "ADSORPTION_MODEL", fp);
+			appendIntFingerprint(pp, "ADSORPTION_MODEL_MULTIPLEX", fp);
+			appendStringFingerprint(pp, "REACTION_MODEL", fp);
+			appendStringFingerprint(pp, "REACTION_MODEL_PARTICLES", fp);
+			appendIntFingerprint(pp, "REACTION_MODEL_PARTICLES_MULTIPLEX", fp);
+
+			if (pp.exists("discretization"))
+			{
+				pp.pushScope("discretization");
+				appendIntFingerprint(pp, "NCOL", fp);
+				appendIntFingerprint(pp, "NRAD", fp);
+				appendIntFingerprint(pp, "NPAR", fp);
+				appendIntFingerprint(pp, "NPARTYPE", fp);
+				appendIntFingerprint(pp, "NBOUND", fp);
+				appendIntFingerprint(pp, "NTANK", fp);
+				appendIntFingerprint(pp, "USE_JFNK", fp);
+				pp.popScope();
+			}
+			pp.popScope();
+		}
+		fp << '}';
+	}
+	pp.popScope();
+
+	if (pp.exists("sensitivity"))
+	{
+		pp.pushScope("sensitivity");
+		const int nSens = pp.getInt("NSENS");
+		fp << "NSENS=" << nSens << ';';
+		for (int i = 0; i < nSens; ++i)
+		{
+			oss.str("");
+			oss << "param_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
+			fp << oss.str() << '{';
+
+			pp.pushScope(oss.str());
+			appendStringFingerprint(pp, "SENS_NAME", fp);
+			appendIntFingerprint(pp, "SENS_UNIT", fp);
+			appendIntFingerprint(pp, "SENS_COMP", fp);
+			appendIntFingerprint(pp, "SENS_REACTION", fp);
+			appendIntFingerprint(pp, "SENS_SECTION", fp);
+			appendIntFingerprint(pp, "SENS_BOUNDPHASE", fp);
+			appendIntFingerprint(pp, "SENS_PARTYPE", fp);
+			appendDoubleFingerprint(pp, "SENS_FACTOR", fp);
+			pp.popScope();
+
+			fp << '}';
+		}
+		pp.popScope();
+	}
+
+	if (pp.exists("return"))
+	{
+		pp.pushScope("return");
+		appendIntFingerprint(pp, "SPLIT_COMPONENTS_DATA", fp);
+		appendIntFingerprint(pp, "SPLIT_PORTS_DATA", fp);
+		appendIntFingerprint(pp, "SINGLE_AS_MULTI_PORT", fp);
+		appendIntFingerprint(pp, "WRITE_SOLUTION_TIMES", fp);
+		appendIntFingerprint(pp, "WRITE_SOLUTION_LAST", fp);
+		appendIntFingerprint(pp, "WRITE_SENS_LAST", fp);
+		appendIntFingerprint(pp, "WRITE_STEP_STATISTICS", fp);
+
+		static const char* const dataTypes[] = {"SOLUTION", "SOLDOT", "SENS", "SENSDOT"};
+		static const char* const dataParts[] = {"BULK", "COLUMN", "PARTICLE", "SOLID", "FLUX", "INLET", "COLUMN_INLET", "OUTLET", "COLUMN_OUTLET", "VOLUME"};
+		for (int i = 0; i < nUnits; ++i)
+		{
+			const std::string scope = unitScope(i);
+			if (!pp.exists(scope))
+				continue;
+
+			fp << scope << '{';
+			pp.pushScope(scope);
+			for (const char* type : dataTypes)
+			{
+				for (const char* part : dataParts)
+					appendIntFingerprint(pp, ("WRITE_" + std::string(type) + "_" + part).c_str(), fp);
+			}
+			appendIntFingerprint(pp, "WRITE_COORDINATES", fp);
+			appendIntFingerprint(pp, "DECIMATE_TIME", fp);
+			appendIntFingerprint(pp, "DECIMATE_AXIAL", fp);
+			appendIntFingerprint(pp, "DECIMATE_RADIAL", fp);
+			appendIntFingerprint(pp, "DECIMATE_SHELL", fp);
+			appendIntFingerprint(pp, "SINGLE_PRECISION_DATA", fp);
+			appendIntFingerprint(pp, "WRITE_SOLUTION_KPI", fp);
+			appendIntFingerprint(pp, "WRITE_SENS_KPI", fp);
+			appendDoubleFingerprint(pp, "KPI_FRACTION_START", fp);
+			appendDoubleFingerprint(pp, "KPI_FRACTION_END", fp);
+			pp.popScope();
+			fp << '}';
+		}
+		pp.popScope();
+	}
+
+	return fp.str();
+}
+
+} // namespace detail
+
+/**
+ * @brief Pool of configured drivers that are reused for structure-identical simulations
+ * @details Building a model and a simulator allocates the IDAS memory, state vectors, AD vectors,
+ *          and result storage. For many short runs (e.g., parameter estimation or Monte Carlo studies),
+ *          this setup dominates the run time. The pool keeps drivers alive after they have been
+ *          released. A subsequent acquire() with the same key reuses an idle driver and only
+ *          overwrites parameter values and initial conditions (see Driver::reconfigure()).
+ *
+ *          The key identifies the structure of a configuration. The caller should only use the same
+ *          key for structure-identical configurations (i.e., same unit operations, discretizations,
+ *          binding models, sensitive parameters, and return configuration). Each driver stores a
+ *          fingerprint of the structure it has been configured with (see detail::structureFingerprint()),
+ *          which is checked before the driver is reused.
+ *
+ *          Acquiring and releasing drivers is thread-safe. Note that concurrent simulations
+ *          share the global number of AD directions.
+ */
+class SimulatorPool
+{
+public:
+	SimulatorPool() { }
+
+	~SimulatorPool() CADET_NOEXCEPT
+	{
+		for (Entry& e : _entries)
+			delete e.driver;
+	}
+
+	/**
+	 * @brief Obtains a driver configured with the given parameters
+	 * @details Reuses an idle driver of the same key if available. Otherwise, a new driver
+	 *          is created and configured. The driver is ready for Driver::run() on exit and
+	 *          has to be returned to the pool by release().
+	 * @param [in] key Identifies the structure of the configuration
+	 * @param [in] pp Implementation of cadet::IParameterProvider used as input
+	 * @tparam ParamProvider_t Type of the parameter provider
+	 * @throws InvalidParameterException if the structure of the configuration does not match
+	 *         the structure of the drivers with the same key
+	 * @return Configured driver owned by the pool
+	 */
+	template <typename ParamProvider_t>
+	Driver& acquire(const std::string& key, ParamProvider_t& pp)
+	{
+		const std::string fingerprint = detail::structureFingerprint(pp);
+
+		Driver* drv = nullptr;
+		bool reuse = false;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			for (Entry& e : _entries)
+			{
+				if (e.key != key)
+					continue;
+
+				if (e.fingerprint != fingerprint)
+					throw InvalidParameterException("Structure of configuration does not match pooled drivers with key " + key);
+
+				if (!e.inUse)
+				{
+					e.inUse = true;
+					drv = e.driver;
+					reuse = true;
+					break;
+				}
+			}
+
+			if (!drv)
+			{
+				drv = new Driver();
+				_entries.push_back(Entry{key, fingerprint, drv, true});
+			}
+		}
+
+		try
+		{
+			if (reuse)
+				drv->reconfigure(pp);
+			else
+				drv->configure(pp);
+		}
+		catch (...)
+		{
+			// Do not keep drivers in an unknown state
+			remove(drv);
+			throw;
+		}
+
+		return *drv;
+	}
+
+	/**
+	 * @brief Returns a driver to the pool
+	 * @details The driver and its results remain valid until the driver is acquired again.
+	 * @param [in] drv Driver obtained from acquire()
+	 */
+	void release(Driver& drv)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		for (Entry& e : _entries)
+		{
+			if (e.driver == &drv)
+			{
+				e.inUse = false;
+				return;
+			}
+		}
+	}
+
+	/**
+	 * @brief Destroys all idle drivers
+	 */
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		for (auto it = _entries.begin(); it != _entries.end(); )
+		{
+			if (it->inUse)
+			{
+				++it;
+				continue;
+			}
+
+			delete it->driver;
+			it = _entries.erase(it);
+		}
+	}
+
+	/**
+	 * @brief Returns the number of drivers owned by the pool
+	 * @return Number of drivers owned by the pool
+	 */
+	inline unsigned int size() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _entries.size();
+	}
+
+	/**
+	 * @brief Returns the number of idle drivers owned by the pool
+	 * @return Number of idle drivers owned by the pool
+	 */
+	inline unsigned int numIdle() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		unsigned int n = 0;
+		for (const Entry& e : _entries)
+		{
+			if (!e.inUse)
+				++n;
+		}
+		return n;
+	}
+
+protected:
+
+	struct Entry
+	{
+		std::string key; //!< Structure key
+		std::string fingerprint; //!< Fingerprint of the structure the driver has been configured with
+		Driver* driver; //!< Driver owned by the pool
+		bool inUse; //!< Determines whether the driver is currently acquired
+	};
+
+	/**
+	 * @brief Removes the given driver from the pool and destroys it
+	 * @param [in] drv Driver to be removed
+	 */
+	void remove(Driver* drv)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		for (auto it = _entries.begin(); it != _entries.end(); ++it)
+		{
+			if (it->driver == drv)
+			{
+				_entries.erase(it);
+				break;
+			}
+		}
+		delete drv;
+	}
+
+	std::vector<Entry> _entries; //!< Drivers owned by the pool
+	mutable std::mutex _mutex; //!< Guards the list of drivers
+
+private:
+	SimulatorPool(const SimulatorPool&) = delete;
+	SimulatorPool& operator=(const SimulatorPool&) = delete;
+};
+
+} // namespace cadet
+
+#endif  // CADET_SIMULATORPOOL_HPP_
@@ -22,8 +22,11 @@
 #include <sstream>
 #include <algorithm>
 #include <numeric>
+#include <functional>
 
 #include "cadet/SolutionRecorder.hpp"
+#include "cadet/DataView.hpp"
+#include "common/StateBuffer.hpp"
 
 namespace cadet
 {
@@ -36,6 +39,10 @@ namespace detail
 /**
  * @brief Stores pieces of the solution of one single unit operation in internal buffers
  * @details The pieces of stored solutions are selectable at runtime.
+ *          Spatially resolved fields (bulk, particle, solid, flux) can be decimated in time (only
+ *          every k-th time point is stored) and in space (only every k-th axial cell, radial cell,
+ *          or particle shell is stored). They can also be stored in single precision. The layouts
+ *          describe the shape of the reduced data.
  * @todo Use better storage than std::vector (control growth, maybe chunked storage -> needs chunked writes)
  */
 class InternalStorageUnitOpRecorder : public ISolutionRecorder
@@ -59,7 +66,8 @@ public:
 		_cfgSolutionDot({false, false, false, false, false, false}), _cfgSensitivity({false, false, false, true, false, false}),
 		_cfgSensitivityDot({false, false, false, true, false, false}), _storeTime(false), _storeCoordinates(false), _splitComponents(true), _splitPorts(true),
 		_singleAsMultiPortUnitOps(false), _curCfg(nullptr), _nComp(0), _nVolumeDof(0), _numTimesteps(0), _numSens(0), _unitOp(idx), _needsReAlloc(false),
-		_axialCoords(0), _radialCoords(0), _particleCoords(0)
+		_axialCoords(0), _radialCoords(0), _particleCoords(0), _timeStride(1), _axialStride(1), _radialStride(1), _shellStride(1),
+		_singlePrecision(false)
 	{
 	}
 
@@ -71,6 +79,7 @@ public:
 	{
 		// Clear solution storage
 		_time.clear();
+		_decimatedTime.clear();
 		clear(_data);
 		clear(_dataDot);
 
@@ -140,6 +149,7 @@ public:
 		_bulkLayout.clear();
 		_bulkLayout.reserve(len + 1); // First slot is time
 		_bulkLayout.push_back(0);
+		std::vector<unsigned int> bulkStrides(1, 1u);
 		_bulkCount = 1;
 		for (unsigned int i = 0; i < len; ++i)
 		{
@@ -147,13 +157,16 @@ public:
 			{
 				case StateOrdering::Component:
 					_bulkLayout.push_back(exporter.numComponents());
+					bulkStrides.push_back(1u);
 					break;
 				case StateOrdering::AxialCell:
 					_bulkLayout.push_back(exporter.numAxialCells());
+					bulkStrides.push_back(_axialStride);
 					_bulkCount *= exporter.numAxialCells();
 					break;
 				case StateOrdering::RadialCell:
 					_bulkLayout.push_back(exporter.numRadialCells());
+					bulkStrides.push_back(_radialStride);
 					_bulkCount *= exporter.numRadialCells();
 				case StateOrdering::ParticleType:
 				case StateOrdering::ParticleShell:
@@ -165,6 +178,7 @@ public:
 		order = exporter.mobilePhaseOrdering(len);
 		_particleLayout.clear();
 		_particleLayout.resize(numParTypes, std::vector<std::size_t>(len + 1, 0)); // First slot is time
+		std::vector<unsigned int> particleStrides(len + 1, 1u);
 		_particleCount = std::vector<unsigned int>(numParTypes, 1u);
 		unsigned int idxLayout = 1;
 		for (unsigned int i = 0; i < len; ++i)
@@ -187,6 +201,8 @@ public:
 						_particleCount[j] *= exporter.numAxialCells();
 					}
 
+					particleStrides[idxLayout] = _axialStride;
+
 					++idxLayout;
 					break;
 				}
@@ -198,6 +214,8 @@ public:
 						_particleCount[j] *= exporter.numRadialCells();
 					}
 
+					particleStrides[idxLayout] = _radialStride;
+
 					++idxLayout;
 					break;
 				}
@@ -211,6 +229,8 @@ public:
 						_particleCount[j] *= _nParShells[j];
 					}
 
+					particleStrides[idxLayout] = _shellStride;
+
 					++idxLayout;
 					break;
 				}
@@ -221,10 +241,12 @@ public:
 
 		for (unsigned int j = 0; j < numParTypes; ++j)
 			_particleLayout[j].resize(idxLayout);
+		particleStrides.resize(idxLayout);
 
 		order = exporter.solidPhaseOrdering(len);
 		_solidLayout.clear();
 		_solidLayout.resize(numParTypes, std::vector<std::size_t>(len + 1, 0)); // First slot is time
+		std::vector<unsigned int> solidStrides(len + 1, 1u);
 		_solidCount = std::vector<unsigned int>(numParTypes, 1u);
 		idxLayout = 1;
 		for (unsigned int i = 0; i < len; ++i)
@@ -241,6 +263,8 @@ public:
 						_solidCount[j] *= exporter.numAxialCells();
 					}
 
+					solidStrides[idxLayout] = _axialStride;
+
 					++idxLayout;
 					break;
 				}
@@ -252,6 +276,8 @@ public:
 						_solidCount[j] *= exporter.numRadialCells();
 					}
 
+					solidStrides[idxLayout] = _radialStride;
+
 					++idxLayout;
 					break;
 				}
@@ -265,6 +291,8 @@ public:
 						_solidCount[j] *= _nParShells[j];
 					}
 
+					solidStrides[idxLayout] = _shellStride;
+
 					++idxLayout;
 					break;
 				}
@@ -281,26 +309,32 @@ public:
 
 		for (unsigned int j = 0; j < numParTypes; ++j)
 			_solidLayout[j].resize(idxLayout);
+		solidStrides.resize(idxLayout);
 
 		order = exporter.fluxOrdering(len);
 		_fluxLayout.clear();
 		_fluxLayout.reserve(len + 1); // First slot is time
 		_fluxLayout.push_back(0);
+		std::vector<unsigned int> fluxStrides(1, 1u);
 		for (unsigned int i = 0; i < len; ++i)
 		{
 			switch (order[i])
 			{
 				case StateOrdering::Component:
 					_fluxLayout.push_back(exporter.numComponents());
+					fluxStrides.push_back(1u);
 					break;
 				case StateOrdering::AxialCell:
 					_fluxLayout.push_back(exporter.numAxialCells());
+					fluxStrides.push_back(_axialStride);
 					break;
 				case StateOrdering::ParticleType:
 					_fluxLayout.push_back(numParTypes);
+					fluxStrides.push_back(1u);
 					break;
 				case StateOrdering::RadialCell:
 					_fluxLayout.push_back(exporter.numRadialCells());
+					fluxStrides.push_back(_radialStride);
 					break;
 				case StateOrdering::ParticleShell:
 				case StateOrdering::BoundState:
@@ -308,6 +342,19 @@ public:
 			}
 		}
 
+		// Select stored blocks and reduce layouts (innermost component or bound state dimension is always stored completely)
+		decimateLayout(_bulkLayout, bulkStrides, true, _bulkBlocks);
+
+		_particleBlocks.resize(numParTypes);
+		_solidBlocks.resize(numParTypes);
+		for (unsigned int j = 0; j < numParTypes; ++j)
+		{
+			decimateLayout(_particleLayout[j], particleStrides, true, _particleBlocks[j]);
+			decimateLayout(_solidLayout[j], solidStrides, true, _solidBlocks[j]);
+		}
+
+		decimateLayout(_fluxLayout, fluxStrides, false, _fluxEntries);
+
 		// Obtain coordinates
 		if (_storeCoordinates)
 		{
@@ -379,6 +426,8 @@ public:
 		++_numTimesteps;
 		if (_storeTime)
 			_time.push_back(t);
+		if ((_timeStride > 1) && recordSpatialFields())
+			_decimatedTime.push_back(t);
 	}
 
 	virtual void beginUnitOperation(cadet::UnitOpIdx idx, const cadet::IModel& model, const cadet::ISolutionExporter& exporter)
@@ -388,6 +437,7 @@ public:
 			return;
 
 		unsigned int stride = 0;
+		const bool recordSpatial = recordSpatialFields();
 
 		if (_curCfg->storeOutlet)
 		{
@@ -411,52 +461,50 @@ public:
 			}
 		}
 
-		if (_curCfg->storeBulk)
+		if (_curCfg->storeBulk && recordSpatial)
 		{
-			std::vector<double>& v = _curStorage->bulk;
-			double const* data = exporter.concentration();
 			stride = exporter.bulkMobilePhaseStride();
 			const unsigned int blockSize = exporter.numBulkDofs() / _bulkCount;
-			for (unsigned int i = 0; i < _bulkCount; ++i, data += stride)
-			{
-				v.insert(v.end(), data, data + blockSize);
-			}
+			if (_singlePrecision)
+				appendBlocks(_curStorage->bulkSingle, exporter.concentration(), stride, blockSize, _bulkBlocks);
+			else
+				appendBlocks(_curStorage->bulk, exporter.concentration(), stride, blockSize, _bulkBlocks);
 		}
 
-		if (_curCfg->storeParticle)
+		if (_curCfg->storeParticle && recordSpatial)
 		{
 			for (unsigned int parType = 0; parType < _nParShells.size(); ++parType)
 			{
-				std::vector<double>& cp = _curStorage->particle[parType];
-				double const* data = exporter.particleMobilePhase(parType);
+				double const* const data = exporter.particleMobilePhase(parType);
 				stride = exporter.particleMobilePhaseStride(parType);
 				const unsigned int blockSize = exporter.numParticleMobilePhaseDofs(parType) / _particleCount[parType];
-				for (unsigned int i = 0; i < _particleCount[parType]; ++i, data += stride)
-				{
-					cp.insert(cp.end(), data, data + blockSize);
-				}
+				if (_singlePrecision)
+					appendBlocks(_curStorage->particleSingle[parType], data, stride, blockSize, _particleBlocks[parType]);
+				else
+					appendBlocks(_curStorage->particle[parType], data, stride, blockSize, _particleBlocks[parType]);
 			}
 		}
 
-		if (_curCfg->storeSolid)
+		if (_curCfg->storeSolid && recordSpatial)
 		{
 			for (unsigned int parType = 0; parType < _nParShells.size(); ++parType)
 			{
-				std::vector<double>& cs = _curStorage->solid[parType];
-				double const* data = exporter.solidPhase(parType);
+				double const* const data = exporter.solidPhase(parType);
 				stride = exporter.solidPhaseStride(parType);
 				const unsigned int blockSize = exporter.numSolidPhaseDofs(parType) / _solidCount[parType];
-				for (unsigned int i = 0; i < _solidCount[parType]; ++i, data += stride)
-				{
-					cs.insert(cs.end(), data, data + blockSize);
-				}
+				if (_singlePrecision)
+					appendBlocks(_curStorage->solidSingle[parType], data, stride, blockSize, _solidBlocks[parType]);
+				else
+					appendBlocks(_curStorage->solid[parType], data, stride, blockSize, _solidBlocks[parType]);
 			}
 		}
 
-		if (_curCfg->storeFlux)
+		if (_curCfg->storeFlux && recordSpatial)
 		{
-			double const* const data = exporter.flux();
-			_curStorage->flux.insert(_curStorage->flux.end(), data, data + exporter.numFluxDofs());
+			if (_singlePrecision)
+				appendBlocks(_curStorage->fluxSingle, exporter.flux(), 1, 1, _fluxEntries);
+			else
+				appendBlocks(_curStorage->flux, exporter.flux(), 1, 1, _fluxEntries);
 		}
 
 		if (_curCfg->storeVolume)
@@ -517,9 +565,9 @@ public:
 			return;
 
 		if (!_axialCoords.empty())
-			writer.template vector<double>("AXIAL_COORDINATES", _axialCoords);
+			writer.template vector<double>("AXIAL_COORDINATES", decimatedCount(_axialCoords.size(), _axialStride), _axialCoords.data(), _axialStride);
 		if (!_radialCoords.empty())
-			writer.template vector<double>("RADIAL_COORDINATES", _radialCoords);
+			writer.template vector<double>("RADIAL_COORDINATES", decimatedCount(_radialCoords.size(), _radialStride), _radialCoords.data(), _radialStride);
 
 		if (!_particleCoords.empty())
 		{
@@ -533,7 +581,7 @@ public:
 				oss.str("");
 				oss << "PARTICLE_COORDINATES_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << pt;
 
-				writer.template vector<double>(oss.str(), _nParShells[pt], _particleCoords.data() + offset);
+				writer.template vector<double>(oss.str(), decimatedCount(_nParShells[pt], _shellStride), _particleCoords.data() + offset, _shellStride);
 
 				offset += _nParShells[pt];
 			}
@@ -547,6 +595,8 @@ public:
 
 		if (_storeTime)
 			writer.template vector<double>("SOLUTION_TIMES", _time.size(), _time.data());
+		if (_timeStride > 1)
+			writer.template vector<double>("SOLUTION_TIMES_DECIMATED", _decimatedTime.size(), _decimatedTime.data());
 
 		beginSolution();
 		writeData(writer, "SOLUTION", oss);
@@ -625,10 +675,24 @@ public:
 	inline bool treatSingleAsMultiPortUnitOps() const CADET_NOEXCEPT { return _singleAsMultiPortUnitOps; }
 	inline void treatSingleAsMultiPortUnitOps(bool smp) CADET_NOEXCEPT { _singleAsMultiPortUnitOps = smp; }
 
+	inline unsigned int timeStride() const CADET_NOEXCEPT { return _timeStride; }
+	inline void timeStride(unsigned int stride) CADET_NOEXCEPT { _timeStride = std::max(stride, 1u); }
+
+	inline void spatialStrides(unsigned int axial, unsigned int radial, unsigned int shell) CADET_NOEXCEPT
+	{
+		_axialStride = std::max(axial, 1u);
+		_radialStride = std::max(radial, 1u);
+		_shellStride = std::max(shell, 1u);
+	}
+
+	inline bool singlePrecision() const CADET_NOEXCEPT { return _singlePrecision; }
+	inline void singlePrecision(bool sp) CADET_NOEXCEPT { _singlePrecision = sp; }
+
 	inline UnitOpIdx unitOperation() const CADET_NOEXCEPT { return _unitOp; }
 	inline void unitOperation(UnitOpIdx idx) CADET_NOEXCEPT { _unitOp = idx; }
 
 	inline unsigned int numDataPoints() const CADET_NOEXCEPT { return _numTimesteps; }
+	inline unsigned int numSpatialDataPoints() const CADET_NOEXCEPT { return decimatedCount(_numTimesteps, _timeStride); }
 	inline unsigned int numComponents() const CADET_NOEXCEPT { return _nComp; }
 	inline unsigned int numInletPorts() const CADET_NOEXCEPT { return _nInletPorts; }
 	inline unsigned int numOutletPorts() const CADET_NOEXCEPT { return _nOutletPorts; }
@@ -648,6 +712,14 @@ public:
 	inline double const* solidDot(unsigned int parType = 0) const CADET_NOEXCEPT { return _dataDot.solid[parType].data(); }
 	inline double const* fluxDot() const CADET_NOEXCEPT { return _dataDot.flux.data(); }
 	inline double const* volumeDot() const CADET_NOEXCEPT { return _dataDot.volume.data(); }
+	inline float const* bulkSingle() const CADET_NOEXCEPT { return _data.bulkSingle.data(); }
+	inline float const* particleSingle(unsigned int parType = 0) const CADET_NOEXCEPT { return _data.particleSingle[parType].data(); }
+	inline float const* solidSingle(unsigned int parType = 0) const CADET_NOEXCEPT { return _data.solidSingle[parType].data(); }
+	inline float const* fluxSingle() const CADET_NOEXCEPT { return _data.fluxSingle.data(); }
+	inline std::vector<std::size_t> const& bulkLayout() const CADET_NOEXCEPT { return _bulkLayout; }
+	inline std::vector<std::size_t> const& particleLayout(unsigned int parType = 0) const CADET_NOEXCEPT { return _particleLayout[parType]; }
+	inline std::vector<std::size_t> const& solidLayout(unsigned int parType = 0) const CADET_NOEXCEPT { return _solidLayout[parType]; }
+	inline std::vector<std::size_t> const& fluxLayout() const CADET_NOEXCEPT { return _fluxLayout; }
 	inline double const* sensInlet(unsigned int idx) const CADET_NOEXCEPT { return _sens[idx].inlet.data(); }
 	inline double const* sensOutlet(unsigned int idx) const CADET_NOEXCEPT { return _sens[idx].outlet.data(); }
 	inline double const* sensBulk(unsigned int idx) const CADET_NOEXCEPT { return _sens[idx].bulk.data(); }
@@ -662,6 +734,147 @@ public:
 	inline double const* sensSolidDot(unsigned int idx, unsigned int parType = 0) const CADET_NOEXCEPT { return _sensDot[idx].solid[parType].data(); }
 	inline double const* sensFluxDot(unsigned int idx) const CADET_NOEXCEPT { return _sensDot[idx].flux.data(); }
 	inline double const* sensVolumeDot(unsigned int idx) const CADET_NOEXCEPT { return _sensDot[idx].volume.data(); }
+
+	/**
+	 * @brief Views on the recorded data that can be wrapped without copying (see DataView)
+	 * @details Inlet and outlet have the shape time x port x component. Spatial fields (bulk, particle,
+	 *          solid, flux) follow bulkLayout(), particleLayout(), solidLayout(), and fluxLayout() with
+	 *          the number of decimated time points (see numSpatialDataPoints()) in the first dimension.
+	 *          They refer to single precision data if singlePrecision() is enabled. The volume has the
+	 *          shape time x volume DOF. Fields that have not been recorded result in empty views.
+	 *
+	 *          The views are invalidated by recording further time points and by clearing the recorder.
+	 */
+	inline DataView timeView() const CADET_NOEXCEPT
+	{
+		const std::size_t shape = _numTimesteps;
+		return makeContiguousView(_time.empty() ? nullptr : _time.data(), DataViewType::Double, &shape, 1);
+	}
+
+	inline DataView inletView() const CADET_NOEXCEPT { return portView(_data.inlet, _nInletPorts); }
+	inline DataView outletView() const CADET_NOEXCEPT { return portView(_data.outlet, _nOutletPorts); }
+	inline DataView bulkView() const CADET_NOEXCEPT { return fieldView(_data.bulk, _data.bulkSingle, _bulkLayout); }
+	inline DataView particleView(unsigned int parType = 0) const CADET_NOEXCEPT { return particleFieldView(_data.particle, _data.particleSingle, _particleLayout, parType); }
+	inline DataView solidView(unsigned int parType = 0) const CADET_NOEXCEPT { return particleFieldView(_data.solid, _data.solidSingle, _solidLayout, parType); }
+	inline DataView fluxView() const CADET_NOEXCEPT { return fieldView(_data.flux, _data.fluxSingle, _fluxLayout); }
+	inline DataView volumeView() const CADET_NOEXCEPT { return vectorView(_data.volume, _numTimesteps, _nVolumeDof); }
+	inline DataView inletDotView() const CADET_NOEXCEPT { return portView(_dataDot.inlet, _nInletPorts); }
+	inline DataView outletDotView() const CADET_NOEXCEPT { return portView(_dataDot.outlet, _nOutletPorts); }
+	inline DataView bulkDotView() const CADET_NOEXCEPT { return fieldView(_dataDot.bulk, _dataDot.bulkSingle, _bulkLayout); }
+	inline DataView particleDotView(unsigned int parType = 0) const CADET_NOEXCEPT { return particleFieldView(_dataDot.particle, _dataDot.particleSingle, _particleLayout, parType); }
+	inline DataView solidDotView(unsigned int parType = 0) const CADET_NOEXCEPT { return particleFieldView(_dataDot.solid, _dataDot.solidSingle, _solidLayout, parType); }
+	inline DataView fluxDotView() const CADET_NOEXCEPT { return fieldView(_dataDot.flux, _dataDot.fluxSingle, _fluxLayout); }
+	inline DataView volumeDotView() const CADET_NOEXCEPT { return vectorView(_dataDot.volume, _numTimesteps, _nVolumeDof); }
+	inline DataView sensInletView(unsigned int idx) const CADET_NOEXCEPT { return portView(_sens[idx].inlet, _nInletPorts); }
+	inline DataView sensOutletView(unsigned int idx) const CADET_NOEXCEPT { return portView(_sens[idx].outlet, _nOutletPorts); }
+	inline DataView sensBulkView(unsigned int idx) const CADET_NOEXCEPT { return fieldView(_sens[idx].bulk, _sens[idx].bulkSingle, _bulkLayout); }
+	inline DataView sensParticleView(unsigned int idx, unsigned int parType = 0) const CADET_NOEXCEPT { return particleFieldView(_sens[idx].particle, _sens[idx].particleSingle, _particleLayout, parType); }
+	inline DataView sensSolidView(unsigned int idx, unsigned int parType = 0) const CADET_NOEXCEPT { return particleFieldView(_sens[idx].solid, _sens[idx].solidSingle, _solidLayout, parType); }
+	inline DataView sensFluxView(unsigned int idx) const CADET_NOEXCEPT { return fieldView(_sens[idx].flux, _sens[idx].fluxSingle, _fluxLayout); }
+	inline DataView sensVolumeView(unsigned int idx) const CADET_NOEXCEPT { return vectorView(_sens[idx].volume, _numTimesteps, _nVolumeDof); }
+	inline DataView sensInletDotView(unsigned int idx) const CADET_NOEXCEPT { return portView(_sensDot[idx].inlet, _nInletPorts); }
+	inline DataView sensOutletDotView(unsigned int idx) const CADET_NOEXCEPT { return portView(_sensDot[idx].outlet, _nOutletPorts); }
+	inline DataView sensBulkDotView(unsigned int idx) const CADET_NOEXCEPT { return fieldView(_sensDot[idx].bulk, _sensDot[idx].bulkSingle, _bulkLayout); }
+	inline DataView sensParticleDotView(unsigned int idx, unsigned int parType = 0) const CADET_NOEXCEPT { return particleFieldView(_sensDot[idx].particle, _sensDot[idx].particleSingle, _particleLayout, parType); }
+	inline DataView sensSolidDotView(unsigned int idx, unsigned int parType = 0) const CADET_NOEXCEPT { return particleFieldView(_sensDot[idx].solid, _sensDot[idx].solidSingle, _solidLayout, parType); }
+	inline DataView sensFluxDotView(unsigned int idx) const CADET_NOEXCEPT { return fieldView(_sensDot[idx].flux, _sensDot[idx].fluxSingle, _fluxLayout); }
+	inline DataView sensVolumeDotView(unsigned int idx) const CADET_NOEXCEPT { return vectorView(_sensDot[idx].volume, _numTimesteps, _nVolumeDof); }
+
+	/**
+	 * @brief Appends the time steps recorded by another recorder of the same unit operation
+	 * @details Both recorders have to share structure and configuration except for the time stride.
+	 *          The other recorder has to store all time points (i.e., time stride @c 1). Spatially
+	 *          resolved fields are decimated according to the time stride of this recorder as if
+	 *          the time steps had been recorded directly. Sensitivities are not appended.
+	 * @param [in] other Recorder whose time steps are appended
+	 * @param [in] time Time points of the other recorder
+	 */
+	void append(const InternalStorageUnitOpRecorder& other, double const* time)
+	{
+		const unsigned int n = other._numTimesteps;
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			++_numTimesteps;
+			if (_storeTime)
+				_time.push_back(time[i]);
+
+			const bool recordSpatial = recordSpatialFields();
+			if ((_timeStride > 1) && recordSpatial)
+				_decimatedTime.push_back(time[i]);
+
+			appendTimestep(_data, other._data, n, i, recordSpatial);
+			appendTimestep(_dataDot, other._dataDot, n, i, recordSpatial);
+		}
+	}
+
+	/**
+	 * @brief Replaces all recorded data by given inlet and outlet concentrations
+	 * @details Used for results that are not obtained by time integration. All other fields
+	 *          remain empty. All ports of the unit operation share the given concentrations.
+	 * @param [in] time Time points
+	 * @param [in] inlet Inlet concentrations in time-major ordering (i.e., components are fastest)
+	 * @param [in] outlet Outlet concentrations in time-major ordering
+	 * @param [in] sensInlet Sensitivities of the inlet concentrations for each sensitive parameter
+	 * @param [in] sensOutlet Sensitivities of the outlet concentrations for each sensitive parameter
+	 */
+	void assignPorts(const std::vector<double>& time, const std::vector<double>& inlet, const std::vector<double>& outlet,
+		const std::vector<std::vector<double>>& sensInlet, const std::vector<std::vector<double>>& sensOutlet)
+	{
+		clear();
+
+		_numTimesteps = time.size();
+		if (_storeTime)
+			_time = time;
+
+		assignPorts(_data, inlet, outlet);
+		for (unsigned int i = 0; i < _sens.size(); ++i)
+			assignPorts(_sens[i], sensInlet[i], sensOutlet[i]);
+	}
+
+	/**
+	 * @brief Saves all recorded data (e.g., for a checkpoint)
+	 * @param [in,out] buffer Buffer the data is appended to
+	 */
+	void saveState(StateBufferWriter& buffer) const
+	{
+		buffer.scalar(_numTimesteps);
+		buffer.vector(_time);
+		buffer.vector(_decimatedTime);
+		saveState(buffer, _data);
+		saveState(buffer, _dataDot);
+
+		buffer.scalar(_sens.size());
+		for (unsigned int i = 0; i < _sens.size(); ++i)
+		{
+			saveState(buffer, _sens[i]);
+			saveState(buffer, _sensDot[i]);
+		}
+	}
+
+	/**
+	 * @brief Replaces all recorded data by previously saved data
+	 * @details The structure of the unit operation has to be reported before (see
+	 *          unitOperationStructure()). Recording continues after the restored time points.
+	 * @param [in,out] buffer Buffer the data is read from
+	 */
+	void restoreState(StateBufferReader& buffer)
+	{
+		_numTimesteps = buffer.scalar<unsigned int>();
+		buffer.vector(_time);
+		buffer.vector(_decimatedTime);
+		restoreState(buffer, _data);
+		restoreState(buffer, _dataDot);
+
+		if (buffer.scalar<std::size_t>() != _sens.size())
+			throw InvalidParameterException("Number of sensitivities in saved state of unit operation " + std::to_string(_unitOp) + " does not match");
+
+		for (unsigned int i = 0; i < _sens.size(); ++i)
+		{
+			restoreState(buffer, _sens[i]);
+			restoreState(buffer, _sensDot[i]);
+		}
+	}
+
 protected:
 
 	struct Storage
@@ -673,6 +886,10 @@ protected:
 		std::vector<std::vector<double>> solid;
 		std::vector<double> flux;
 		std::vector<double> volume;
+		std::vector<float> bulkSingle;
+		std::vector<std::vector<float>> particleSingle;
+		std::vector<std::vector<float>> solidSingle;
+		std::vector<float> fluxSingle;
 	};
 
 	inline void beginSensitivity(unsigned int sensIdx)
@@ -708,26 +925,52 @@ protected:
 		if (_curCfg->storeInlet)
 			_curStorage->inlet.reserve(nAllocTimesteps * _nComp * _nInletPorts);
 
+		const unsigned int nAllocSpatial = decimatedCount(nAllocTimesteps, _timeStride);
 		if (_curCfg->storeBulk)
-			_curStorage->bulk.reserve(nAllocTimesteps * exporter.numBulkDofs());
-		
+		{
+			const std::size_t n = nAllocSpatial * _bulkBlocks.size() * (exporter.numBulkDofs() / _bulkCount);
+			if (_singlePrecision)
+				_curStorage->bulkSingle.reserve(n);
+			else
+				_curStorage->bulk.reserve(n);
+		}
+
+		_curStorage->particle.resize(_nParShells.size());
+		_curStorage->particleSingle.resize(_nParShells.size());
 		if (_curCfg->storeParticle)
 		{
-			_curStorage->particle.resize(_nParShells.size());
 			for (unsigned int i = 0; i < _nParShells.size(); ++i)
-				_curStorage->particle[i].reserve(nAllocTimesteps * exporter.numParticleMobilePhaseDofs(i));
+			{
+				const std::size_t n = nAllocSpatial * _particleBlocks[i].size() * (exporter.numParticleMobilePhaseDofs(i) / _particleCount[i]);
+				if (_singlePrecision)
+					_curStorage->particleSingle[i].reserve(n);
+				else
+					_curStorage->particle[i].reserve(n);
+			}
 		}
-		
+
+		_curStorage->solid.resize(_nParShells.size());
+		_curStorage->solidSingle.resize(_nParShells.size());
 		if (_curCfg->storeSolid)
 		{
-			_curStorage->solid.resize(_nParShells.size());
 			for (unsigned int i = 0; i < _nParShells.size(); ++i)
-				_curStorage->solid[i].reserve(nAllocTimesteps * exporter.numSolidPhaseDofs(i));
+			{
+				const std::size_t n = nAllocSpatial * _solidBlocks[i].size() * (exporter.numSolidPhaseDofs(i) / _solidCount[i]);
+				if (_singlePrecision)
+					_curStorage->solidSingle[i].reserve(n);
+				else
+					_curStorage->solid[i].reserve(n);
+			}
 		}
 
 		if (_curCfg->storeFlux)
-			_curStorage->flux.reserve(nAllocTimesteps * exporter.numFluxDofs());
-		
+		{
+			if (_singlePrecision)
+				_curStorage->fluxSingle.reserve(nAllocSpatial * _fluxEntries.size());
+			else
+				_curStorage->flux.reserve(nAllocSpatial * _fluxEntries.size());
+		}
+
 		if (_curCfg->storeVolume)
 			_curStorage->volume.reserve(nAllocTimesteps * exporter.numVolumeDofs());
 	}
@@ -877,12 +1120,13 @@ protected:
 			}
 		}
 
+		const std::size_t nSpatialTimesteps = numSpatialDataPoints();
 		if (_curCfg->storeBulk)
 		{
 			oss.str("");
 			oss << prefix << "_BULK";
-			_bulkLayout[0] = _numTimesteps;
-			writer.template tensor<double>(oss.str(), _bulkLayout.size(), _bulkLayout.data(), _curStorage->bulk.data());
+			_bulkLayout[0] = nSpatialTimesteps;
+			writeField(writer, oss.str(), _bulkLayout, _curStorage->bulk, _curStorage->bulkSingle);
 		}
 
 		if (_curCfg->storeParticle)
@@ -891,8 +1135,8 @@ protected:
 			{
 				oss.str("");
 				oss << prefix << "_PARTICLE";
-				_particleLayout[0][0] = _numTimesteps;
-				writer.template tensor<double>(oss.str(), _particleLayout[0].size(), _particleLayout[0].data(), _curStorage->particle[0].data());
+				_particleLayout[0][0] = nSpatialTimesteps;
+				writeField(writer, oss.str(), _particleLayout[0], _curStorage->particle[0], _curStorage->particleSingle[0]);
 			}
 			else
 			{
@@ -901,8 +1145,8 @@ protected:
 					std::vector<std::size_t>& pl = _particleLayout[parType];
 					oss.str("");
 					oss << prefix << "_PARTICLE_PARTYPE_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << parType;
-					pl[0] = _numTimesteps;
-					writer.template tensor<double>(oss.str(), pl.size(), pl.data(), _curStorage->particle[parType].data());
+					pl[0] = nSpatialTimesteps;
+					writeField(writer, oss.str(), pl, _curStorage->particle[parType], _curStorage->particleSingle[parType]);
 				}
 			}
 		}
@@ -913,8 +1157,8 @@ protected:
 			{
 				oss.str("");
 				oss << prefix << "_SOLID";
-				_solidLayout[0][0] = _numTimesteps;
-				writer.template tensor<double>(oss.str(), _solidLayout[0].size(), _solidLayout[0].data(), _curStorage->solid[0].data());
+				_solidLayout[0][0] = nSpatialTimesteps;
+				writeField(writer, oss.str(), _solidLayout[0], _curStorage->solid[0], _curStorage->solidSingle[0]);
 			}
 			else
 			{
@@ -923,8 +1167,8 @@ protected:
 					std::vector<std::size_t>& pl = _solidLayout[parType];
 					oss.str("");
 					oss << prefix << "_SOLID_PARTYPE_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << parType;
-					pl[0] = _numTimesteps;
-					writer.template tensor<double>(oss.str(), pl.size(), pl.data(), _curStorage->solid[parType].data());
+					pl[0] = nSpatialTimesteps;
+					writeField(writer, oss.str(), pl, _curStorage->solid[parType], _curStorage->solidSingle[parType]);
 				}
 			}
 		}
@@ -933,8 +1177,8 @@ protected:
 		{
 			oss.str("");
 			oss << prefix << "_FLUX";
-			_fluxLayout[0] = _numTimesteps;
-			writer.template tensor<double>(oss.str(), _fluxLayout.size(), _fluxLayout.data(), _curStorage->flux.data());
+			_fluxLayout[0] = nSpatialTimesteps;
+			writeField(writer, oss.str(), _fluxLayout, _curStorage->flux, _curStorage->fluxSingle);
 		}
 
 		if (_curCfg->storeVolume)
@@ -946,6 +1190,173 @@ protected:
 		}
 	}
 
+	inline bool recordSpatialFields() const CADET_NOEXCEPT { return (_numTimesteps - 1) % _timeStride == 0; }
+
+	static inline unsigned int decimatedCount(std::size_t n, unsigned int stride) CADET_NOEXCEPT { return (n + stride - 1) / stride; }
+
+	/**
+	 * @brief Selects the stored blocks of a field and reduces its layout accordingly
+	 * @details Every @c strides[d]-th index of layout dimension @c d is kept, always starting with
+	 *          the first one. The linear (row-major) indices of the kept blocks are returned.
+	 * @param [in,out] layout Layout of the field with time in the first slot
+	 * @param [in] strides Stride for each layout dimension
+	 * @param [in] innerBlock Determines whether the last dimension forms a contiguous block that is always stored completely
+	 * @param [out] blocks Linear indices of the stored blocks
+	 */
+	static inline void decimateLayout(std::vector<std::size_t>& layout, const std::vector<unsigned int>& strides, bool innerBlock, std::vector<unsigned int>& blocks)
+	{
+		const std::size_t nDims = (layout.size() > 1) ? layout.size() - 1 - (innerBlock ? 1 : 0) : 0;
+		const std::size_t nBlocks = std::accumulate(layout.begin() + 1, layout.begin() + 1 + nDims, std::size_t(1), std::multiplies<std::size_t>());
+
+		blocks.clear();
+		for (std::size_t i = 0; i < nBlocks; ++i)
+		{
+			// Decompose linear index into multi-index and check each dimension
+			std::size_t rem = i;
+			bool keep = true;
+			for (std::size_t d = nDims; d > 0; --d)
+			{
+				keep = keep && ((rem % layout[d]) % strides[d] == 0);
+				rem /= layout[d];
+			}
+
+			if (keep)
+				blocks.push_back(i);
+		}
+
+		for (std::size_t d = 1; d <= nDims; ++d)
+			layout[d] = decimatedCount(layout[d], strides[d]);
+	}
+
+	template <typename T>
+	static inline void appendBlocks(std::vector<T>& v, double const* data, unsigned int stride, unsigned int blockSize, const std::vector<unsigned int>& blocks)
+	{
+		for (unsigned int b : blocks)
+		{
+			double const* const block = data + static_cast<std::size_t>(b) * stride;
+			v.insert(v.end(), block, block + blockSize);
+		}
+	}
+
+	template <typename T>
+	static inline void appendTimestep(std::vector<T>& v, const std::vector<T>& src, unsigned int nTimesteps, unsigned int idx)
+	{
+		// Storage is time-major with equally sized blocks per time step
+		const std::size_t blockSize = src.size() / nTimesteps;
+		v.insert(v.end(), src.begin() + idx * blockSize, src.begin() + (idx + 1) * blockSize);
+	}
+
+	static inline void appendTimestep(Storage& dest, const Storage& src, unsigned int nTimesteps, unsigned int idx, bool recordSpatial)
+	{
+		appendTimestep(dest.outlet, src.outlet, nTimesteps, idx);
+		appendTimestep(dest.inlet, src.inlet, nTimesteps, idx);
+		appendTimestep(dest.volume, src.volume, nTimesteps, idx);
+
+		if (!recordSpatial)
+			return;
+
+		appendTimestep(dest.bulk, src.bulk, nTimesteps, idx);
+		appendTimestep(dest.flux, src.flux, nTimesteps, idx);
+		appendTimestep(dest.bulkSingle, src.bulkSingle, nTimesteps, idx);
+		appendTimestep(dest.fluxSingle, src.fluxSingle, nTimesteps, idx);
+		for (std::size_t i = 0; i < src.particle.size(); ++i)
+			appendTimestep(dest.particle[i], src.particle[i], nTimesteps, idx);
+		for (std::size_t i = 0; i < src.solid.size(); ++i)
+			appendTimestep(dest.solid[i], src.solid[i], nTimesteps, idx);
+		for (std::size_t i = 0; i < src.particleSingle.size(); ++i)
+			appendTimestep(dest.particleSingle[i], src.particleSingle[i], nTimesteps, idx);
+		for (std::size_t i = 0; i < src.solidSingle.size(); ++i)
+			appendTimestep(dest.solidSingle[i], src.solidSingle[i], nTimesteps, idx);
+	}
+
+	inline DataView vectorView(const std::vector<double>& data, std::size_t nRows, std::size_t nCols) const CADET_NOEXCEPT
+	{
+		const std::size_t shape[] = {nRows, nCols};
+		return makeContiguousView(data.empty() ? nullptr : data.data(), DataViewType::Double, shape, 2);
+	}
+
+	inline DataView portView(const std::vector<double>& data, unsigned int nPorts) const CADET_NOEXCEPT
+	{
+		const std::size_t shape[] = {_numTimesteps, nPorts, _nComp};
+		return makeContiguousView(data.empty() ? nullptr : data.data(), DataViewType::Double, shape, 3);
+	}
+
+	inline DataView fieldView(const std::vector<double>& data, const std::vector<float>& dataSingle, const std::vector<std::size_t>& layout) const CADET_NOEXCEPT
+	{
+		if (layout.empty() || (layout.size() > CADET_DATAVIEW_MAX_RANK))
+			return makeContiguousView(nullptr, DataViewType::Double, nullptr, 0);
+
+		// First dimension of the layout is only set when writing
+		std::size_t shape[CADET_DATAVIEW_MAX_RANK];
+		std::copy(layout.begin(), layout.end(), shape);
+		shape[0] = numSpatialDataPoints();
+
+		if (_singlePrecision)
+			return makeContiguousView(dataSingle.empty() ? nullptr : dataSingle.data(), DataViewType::Single, shape, layout.size());
+		return makeContiguousView(data.empty() ? nullptr : data.data(), DataViewType::Double, shape, layout.size());
+	}
+
+	inline DataView particleFieldView(const std::vector<std::vector<double>>& data, const std::vector<std::vector<float>>& dataSingle,
+		const std::vector<std::vector<std::size_t>>& layout, unsigned int parType) const CADET_NOEXCEPT
+	{
+		if ((parType >= layout.size()) || (parType >= data.size()) || (parType >= dataSingle.size()))
+			return makeContiguousView(nullptr, DataViewType::Double, nullptr, 0);
+
+		return fieldView(data[parType], dataSingle[parType], layout[parType]);
+	}
+	template <typename Writer_t>
+	void writeField(Writer_t& writer, const std::string& name, const std::vector<std::size_t>& layout, const std::vector<double>& data, const std::vector<float>& dataSingle)
+	{
+		if (_singlePrecision)
+			writer.template tensor<float>(name, layout.size(), layout.data(), dataSingle.data());
+		else
+			writer.template tensor<double>(name, layout.size(), layout.data(), data.data());
+	}
+
+	inline void assignPorts(Storage& s, const std::vector<double>& inlet, const std::vector<double>& outlet) const
+	{
+		s.inlet.resize(_numTimesteps * _nInletPorts * _nComp);
+		s.outlet.resize(_numTimesteps * _nOutletPorts * _nComp);
+
+		for (unsigned int i = 0; i < _numTimesteps; ++i)
+		{
+			for (unsigned int port = 0; port < _nInletPorts; ++port)
+				std::copy_n(inlet.begin() + i * _nComp, _nComp, s.inlet.begin() + (i * _nInletPorts + port) * _nComp);
+			for (unsigned int port = 0; port < _nOutletPorts; ++port)
+				std::copy_n(outlet.begin() + i * _nComp, _nComp, s.outlet.begin() + (i * _nOutletPorts + port) * _nComp);
+		}
+	}
+
+	static inline void saveState(StateBufferWriter& buffer, const Storage& s)
+	{
+		buffer.vector(s.outlet);
+		buffer.vector(s.inlet);
+		buffer.vector(s.bulk);
+		buffer.vectors(s.particle);
+		buffer.vectors(s.solid);
+		buffer.vector(s.flux);
+		buffer.vector(s.volume);
+		buffer.vector(s.bulkSingle);
+		buffer.vectors(s.particleSingle);
+		buffer.vectors(s.solidSingle);
+		buffer.vector(s.fluxSingle);
+	}
+
+	static inline void restoreState(StateBufferReader& buffer, Storage& s)
+	{
+		buffer.vector(s.outlet);
+		buffer.vector(s.inlet);
+		buffer.vector(s.bulk);
+		buffer.vectors(s.particle);
+		buffer.vectors(s.solid);
+		buffer.vector(s.flux);
+		buffer.vector(s.volume);
+		buffer.vector(s.bulkSingle);
+		buffer.vectors(s.particleSingle);
+		buffer.vectors(s.solidSingle);
+		buffer.vector(s.fluxSingle);
+	}
+
 	inline void clear(Storage& s)
 	{
 		s.outlet.clear();
@@ -960,6 +1371,15 @@ protected:
 
 		s.flux.clear();
 		s.volume.clear();
+
+		s.bulkSingle.clear();
+		for (auto& v : s.particleSingle)
+			v.clear();
+
+		for (auto& v : s.solidSingle)
+			v.clear();
+
+		s.fluxSingle.clear();
 	}
 
 	StorageConfig _cfgSolution;
@@ -1005,13 +1425,484 @@ protected:
 	std::vector<double> _axialCoords;
 	std::vector<double> _radialCoords;
 	std::vector<double> _particleCoords;
+
+	unsigned int _timeStride; //!< Only every k-th time point of spatially resolved fields is stored
+	unsigned int _axialStride; //!< Only every k-th axial cell is stored
+	unsigned int _radialStride; //!< Only every k-th radial cell is stored
+	unsigned int _shellStride; //!< Only every k-th particle shell is stored
+	bool _singlePrecision; //!< Determines whether spatially resolved fields are stored in single precision
+	std::vector<double> _decimatedTime; //!< Time points of spatially resolved fields if decimated in time
+	std::vector<unsigned int> _bulkBlocks; //!< Stored blocks of bulk mobile phase
+	std::vector<std::vector<unsigned int>> _particleBlocks; //!< Stored blocks of particle mobile phase for each particle type
+	std::vector<std::vector<unsigned int>> _solidBlocks; //!< Stored blocks of solid phase for each particle type
+	std::vector<unsigned int> _fluxEntries; //!< Stored flux entries
+};
+
+
+/**
+ * @brief Accumulates key performance indicators of the outlet of a single unit operation on the fly
+ * @details Instead of storing the full outlet trace, this recorder integrates the outlet concentration
+ *          profiles over the recorded time points and only keeps a handful of numbers per component
+ *          and outlet port:
+ *          - Area (zeroth moment) @f$ \mu_0 = \int c(t) \,\mathrm{d}t @f$
+ *          - Mean residence time @f$ \mu_1 / \mu_0 @f$
+ *          - Variance @f$ \mu_2 / \mu_0 - (\mu_1 / \mu_0)^2 @f$ (second central moment)
+ *          - Peak maximum and time of the peak maximum
+ *          - Yield and purity of each collection window @f$ [t_s, t_e] @f$
+ *
+ *          The outlet is assumed to be piecewise linear between two recorded time points, which
+ *          renders the integrals of the profile exact with respect to this interpolation. Moments
+ *          are accumulated relative to the first recorded time point to reduce cancellation.
+ *          Yield is the fraction of the total area of a component that falls into a collection
+ *          window, purity is the fraction of the collected area of a component with respect to
+ *          all components of the same port. Both assume a constant flow rate through the outlet.
+ *          KPIs that involve a division by a zero area are reported as @c 0.
+ *
+ *          If requested, parameter sensitivities of the KPIs are computed from the recorded
+ *          sensitivity vectors. The sensitivity of the peak time is not available.
+ *
+ *          Data is stored in port-major ordering, i.e., port, component.
+ */
+class OutletKpiRecorder : public ISolutionRecorder
+{
+public:
+
+	OutletKpiRecorder() : OutletKpiRecorder(UnitOpIndep) { }
+
+	OutletKpiRecorder(UnitOpIdx idx) : _unitOp(idx), _nComp(0), _nOutletPorts(0), _numSens(0), _storeSens(false), 
+		_numTimesteps(0), _tRef(0.0), _tPrev(0.0), _tCur(0.0), _cur(nullptr)
+	{
+	}
+
+	virtual ~OutletKpiRecorder() CADET_NOEXCEPT
+	{
+	}
+
+	virtual void clear()
+	{
+		_numTimesteps = 0;
+		reset(_data);
+		for (Accumulator& acc : _sens)
+			reset(acc);
+	}
+
+	virtual void prepare(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
+	{
+		_numSens = numSens;
+		_sens.resize(_storeSens ? numSens : 0);
+	}
+
+	virtual void notifyIntegrationStart(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
+	{
+		_numSens = numSens;
+		_sens.resize(_storeSens ? numSens : 0);
+		clear();
+	}
+
+	virtual void unitOperationStructure(UnitOpIdx idx, const IModel& model, const ISolutionExporter& exporter)
+	{
+		// Only record one unit operation
+		if (idx != _unitOp)
+			return;
+
+		_nComp = exporter.numComponents();
+		_nOutletPorts = exporter.numOutletPorts();
+		_peakTime.resize(numValues());
+		_peakUpdated.resize(numValues());
+		_buffer.resize(numValues());
+
+		allocate(_data);
+		for (Accumulator& acc : _sens)
+			allocate(acc);
+
+		clear();
+	}
+
+	virtual void beginTimestep(double t)
+	{
+		_tPrev = _tCur;
+		_tCur = t;
+		if (_numTimesteps == 0)
+			_tRef = t;
+
+		++_numTimesteps;
+	}
+
+	virtual void beginUnitOperation(cadet::UnitOpIdx idx, const cadet::IModel& model, const cadet::ISolutionExporter& exporter)
+	{
+		// Only record one unit operation
+		if ((idx != _unitOp) || !_cur)
+			return;
+
+		unsigned int stride = 0;
+		for (unsigned int j = 0; j < _nOutletPorts; ++j)
+		{
+			double const* outlet = exporter.outlet(j, stride);
+			for (unsigned int i = 0; i < _nComp; ++i)
+				_buffer[j * _nComp + i] = outlet[i * stride];
+		}
+
+		accumulate(*_cur);
+
+		if (_cur == &_data)
+		{
+			// Track peak maximum
+			for (unsigned int i = 0; i < numValues(); ++i)
+			{
+				_peakUpdated[i] = (_numTimesteps == 1) || (_buffer[i] > _data.peak[i]);
+				if (_peakUpdated[i])
+				{
+					_data.peak[i] = _buffer[i];
+					_peakTime[i] = _tCur;
+				}
+			}
+		}
+		else
+		{
+			// Sensitivity of the peak maximum is the sensitivity at the peak time point
+			for (unsigned int i = 0; i < numValues(); ++i)
+			{
+				if (_peakUpdated[i])
+					_cur->peak[i] = _buffer[i];
+			}
+		}
+	}
+
+	virtual void endUnitOperation() { }
+	virtual void endTimestep() { }
+
+	virtual void beginSolution() { _cur = &_data; }
+	virtual void endSolution() { _cur = nullptr; }
+	virtual void beginSolutionDerivative() { }
+	virtual void endSolutionDerivative() { }
+
+	virtual void beginSensitivity(const cadet::ParameterId& pId, unsigned int sensIdx)
+	{
+		if (sensIdx < _sens.size())
+			_cur = &_sens[sensIdx];
+	}
+
+	virtual void endSensitivity(const cadet::ParameterId& pId, unsigned int sensIdx) { _cur = nullptr; }
+	virtual void beginSensitivityDerivative(const cadet::ParameterId& pId, unsigned int sensIdx) { }
+	virtual void endSensitivityDerivative(const cadet::ParameterId& pId, unsigned int sensIdx) { }
+
+	template <typename Writer_t>
+	void writeSolution(Writer_t& writer)
+	{
+		std::vector<double> buffer(numValues());
+		const unsigned int nWin = numCollectionWindows();
+
+		writeKpi(writer, "KPI_AREA", buffer, [this](unsigned int i) { return area(i); });
+		writeKpi(writer, "KPI_MEAN_TIME", buffer, [this](unsigned int i) { return meanTime(i); });
+		writeKpi(writer, "KPI_VARIANCE", buffer, [this](unsigned int i) { return variance(i); });
+		writeKpi(writer, "KPI_PEAK_MAX", buffer, [this](unsigned int i) { return peakMax(i); });
+		writeKpi(writer, "KPI_PEAK_TIME", buffer, [this](unsigned int i) { return peakTime(i); });
+
+		if (nWin == 0)
+			return;
+
+		buffer.resize(nWin * numValues());
+		writeFractionKpi(writer, "KPI_FRACTION_YIELD", buffer, [this](unsigned int w, unsigned int i) { return fractionYield(w, i); });
+		writeFractionKpi(writer, "KPI_FRACTION_PURITY", buffer, [this](unsigned int w, unsigned int i) { return fractionPurity(w, i); });
+	}
+
+	template <typename Writer_t>
+	void writeSensitivity(Writer_t& writer, unsigned int param)
+	{
+		if (param >= _sens.size())
+			return;
+
+		std::vector<double> buffer(numValues());
+		const unsigned int nWin = numCollectionWindows();
+
+		writeKpi(writer, "KPI_AREA", buffer, [=](unsigned int i) { return sensArea(param, i); });
+		writeKpi(writer, "KPI_MEAN_TIME", buffer, [=](unsigned int i) { return sensMeanTime(param, i); });
+		writeKpi(writer, "KPI_VARIANCE", buffer, [=](unsigned int i) { return sensVariance(param, i); });
+		writeKpi(writer, "KPI_PEAK_MAX", buffer, [=](unsigned int i) { return sensPeakMax(param, i); });
+
+		if (nWin == 0)
+			return;
+
+		buffer.resize(nWin * numValues());
+		writeFractionKpi(writer, "KPI_FRACTION_YIELD", buffer, [=](unsigned int w, unsigned int i) { return sensFractionYield(param, w, i); });
+		writeFractionKpi(writer, "KPI_FRACTION_PURITY", buffer, [=](unsigned int w, unsigned int i) { return sensFractionPurity(param, w, i); });
+	}
+
+	/**
+	 * @brief Sets the collection windows used for yield and purity
+	 * @param [in] start Start times of the collection windows
+	 * @param [in] end End times of the collection windows
+	 */
+	inline void collectionWindows(const std::vector<double>& start, const std::vector<double>& end)
+	{
+		_fracStart = start;
+		_fracEnd = end;
+		_fracStart.resize(std::min(start.size(), end.size()));
+		_fracEnd.resize(_fracStart.size());
+	}
+
+	inline bool storeSensitivities() const CADET_NOEXCEPT { return _storeSens; }
+	inline void storeSensitivities(bool ss) CADET_NOEXCEPT { _storeSens = ss; }
+
+	inline UnitOpIdx unitOperation() const CADET_NOEXCEPT { return _unitOp; }
+	inline void unitOperation(UnitOpIdx idx) CADET_NOEXCEPT { _unitOp = idx; }
+
+	inline unsigned int numDataPoints() const CADET_NOEXCEPT { return _numTimesteps; }
+	inline unsigned int numComponents() const CADET_NOEXCEPT { return _nComp; }
+	inline unsigned int numOutletPorts() const CADET_NOEXCEPT { return _nOutletPorts; }
+	inline unsigned int numCollectionWindows() const CADET_NOEXCEPT { return _fracStart.size(); }
+
+	inline double area(unsigned int idx) const CADET_NOEXCEPT { return _data.moment0[idx]; }
+	inline double meanTime(unsigned int idx) const CADET_NOEXCEPT { return _tRef + safeDiv(_data.moment1[idx], _data.moment0[idx]); }
+	inline double variance(unsigned int idx) const CADET_NOEXCEPT
+	{
+		const double mean = safeDiv(_data.moment1[idx], _data.moment0[idx]);
+		return safeDiv(_data.moment2[idx], _data.moment0[idx]) - mean * mean;
+	}
+	inline double peakMax(unsigned int idx) const CADET_NOEXCEPT { return _data.peak[idx]; }
+	inline double peakTime(unsigned int idx) const CADET_NOEXCEPT { return _peakTime[idx]; }
+	inline double fractionYield(unsigned int win, unsigned int idx) const CADET_NOEXCEPT { return safeDiv(_data.fraction[win * numValues() + idx], _data.moment0[idx]); }
+	inline double fractionPurity(unsigned int win, unsigned int idx) const CADET_NOEXCEPT
+	{
+		return safeDiv(_data.fraction[win * numValues() + idx], collectedArea(_data, win, idx));
+	}
+
+	inline double sensArea(unsigned int sensIdx, unsigned int idx) const CADET_NOEXCEPT { return _sens[sensIdx].moment0[idx]; }
+	inline double sensMeanTime(unsigned int sensIdx, unsigned int idx) const CADET_NOEXCEPT
+	{
+		const Accumulator& s = _sens[sensIdx];
+		const double mean = safeDiv(_data.moment1[idx], _data.moment0[idx]);
+		return safeDiv(s.moment1[idx] - mean * s.moment0[idx], _data.moment0[idx]);
+	}
+	inline double sensVariance(unsigned int sensIdx, unsigned int idx) const CADET_NOEXCEPT
+	{
+		const Accumulator& s = _sens[sensIdx];
+		const double mean = safeDiv(_data.moment1[idx], _data.moment0[idx]);
+		const double second = safeDiv(_data.moment2[idx], _data.moment0[idx]);
+		return safeDiv(s.moment2[idx] - second * s.moment0[idx], _data.moment0[idx]) - 2.0 * mean * sensMeanTime(sensIdx, idx);
+	}
+	inline double sensPeakMax(unsigned int sensIdx, unsigned int idx) const CADET_NOEXCEPT { return _sens[sensIdx].peak[idx]; }
+	inline double sensFractionYield(unsigned int sensIdx, unsigned int win, unsigned int idx) const CADET_NOEXCEPT
+	{
+		const Accumulator& s = _sens[sensIdx];
+		return safeDiv(s.fraction[win * numValues() + idx] - fractionYield(win, idx) * s.moment0[idx], _data.moment0[idx]);
+	}
+	inline double sensFractionPurity(unsigned int sensIdx, unsigned int win, unsigned int idx) const CADET_NOEXCEPT
+	{
+		const Accumulator& s = _sens[sensIdx];
+		return safeDiv(s.fraction[win * numValues() + idx] - fractionPurity(win, idx) * collectedArea(s, win, idx), collectedArea(_data, win, idx));
+	}
+
+	/**
+	 * @brief Saves the accumulated KPIs (e.g., for a checkpoint)
+	 * @param [in,out] buffer Buffer the data is appended to
+	 */
+	void saveState(StateBufferWriter& buffer) const
+	{
+		buffer.scalar(_numTimesteps);
+		buffer.scalar(_tRef);
+		buffer.scalar(_tPrev);
+		buffer.scalar(_tCur);
+		buffer.vector(_peakTime);
+		buffer.vector(_peakUpdated);
+
+		saveState(buffer, _data);
+		buffer.scalar(_sens.size());
+		for (const Accumulator& acc : _sens)
+			saveState(buffer, acc);
+	}
+
+	/**
+	 * @brief Replaces the accumulated KPIs by previously saved data
+	 * @details The structure of the unit operation has to be reported before (see
+	 *          unitOperationStructure()).
+	 * @param [in,out] buffer Buffer the data is read from
+	 */
+	void restoreState(StateBufferReader& buffer)
+	{
+		_numTimesteps = buffer.scalar<unsigned int>();
+		_tRef = buffer.scalar<double>();
+		_tPrev = buffer.scalar<double>();
+		_tCur = buffer.scalar<double>();
+		buffer.vector(_peakTime);
+		buffer.vector(_peakUpdated);
+
+		restoreState(buffer, _data);
+		if (buffer.scalar<std::size_t>() != _sens.size())
+			throw InvalidParameterException("Number of sensitivities in saved KPI state of unit operation " + std::to_string(_unitOp) + " does not match");
+
+		for (Accumulator& acc : _sens)
+			restoreState(buffer, acc);
+	}
+
+protected:
+
+	/**
+	 * @brief Running integrals of the outlet profile or of its sensitivity
+	 */
+	struct Accumulator
+	{
+		std::vector<double> last; //!< Values at the previous time point
+		std::vector<double> moment0; //!< Zeroth moment
+		std::vector<double> moment1; //!< First moment with respect to the reference time
+		std::vector<double> moment2; //!< Second moment with respect to the reference time
+		std::vector<double> peak; //!< Peak maximum (or its sensitivity)
+		std::vector<double> fraction; //!< Area inside each collection window (window-major)
+	};
+
+	inline unsigned int numValues() const CADET_NOEXCEPT { return _nComp * _nOutletPorts; }
+
+	static inline void saveState(StateBufferWriter& buffer, const Accumulator& acc)
+	{
+		buffer.vector(acc.last);
+		buffer.vector(acc.moment0);
+		buffer.vector(acc.moment1);
+		buffer.vector(acc.moment2);
+		buffer.vector(acc.peak);
+		buffer.vector(acc.fraction);
+	}
+
+	static inline void restoreState(StateBufferReader& buffer, Accumulator& acc)
+	{
+		buffer.vector(acc.last);
+		buffer.vector(acc.moment0);
+		buffer.vector(acc.moment1);
+		buffer.vector(acc.moment2);
+		buffer.vector(acc.peak);
+		buffer.vector(acc.fraction);
+	}
+
+	static inline double safeDiv(double num, double denom) CADET_NOEXCEPT { return (denom == 0.0) ? 0.0 : num / denom; }
+
+	inline double collectedArea(const Accumulator& acc, unsigned int win, unsigned int idx) const CADET_NOEXCEPT
+	{
+		double const* const frac = acc.fraction.data() + win * numValues() + (idx / _nComp) * _nComp;
+		return std::accumulate(frac, frac + _nComp, 0.0);
+	}
+
+	inline void allocate(Accumulator& acc)
+	{
+		const unsigned int n = numValues();
+		acc.last.resize(n);
+		acc.moment0.resize(n);
+		acc.moment1.resize(n);
+		acc.moment2.resize(n);
+		acc.peak.resize(n);
+		acc.fraction.resize(n * numCollectionWindows());
+	}
+
+	inline void reset(Accumulator& acc)
+	{
+		std::fill(acc.last.begin(), acc.last.end(), 0.0);
+		std::fill(acc.moment0.begin(), acc.moment0.end(), 0.0);
+		std::fill(acc.moment1.begin(), acc.moment1.end(), 0.0);
+		std::fill(acc.moment2.begin(), acc.moment2.end(), 0.0);
+		std::fill(acc.peak.begin(), acc.peak.end(), 0.0);
+		std::fill(acc.fraction.begin(), acc.fraction.end(), 0.0);
+	}
+
+	/**
+	 * @brief Adds the contribution of the last time interval to the given accumulator
+	 * @details Takes the current values from the internal buffer and integrates the linear
+	 *          interpolant between the previous and the current time point.
+	 * @param [in,out] acc Accumulator
+	 */
+	inline void accumulate(Accumulator& acc)
+	{
+		const unsigned int n = numValues();
+		if (acc.moment0.size() < n)
+			allocate(acc);
+
+		if (_numTimesteps > 1)
+		{
+			const double h = _tCur - _tPrev;
+			const double t0 = _tPrev - _tRef;
+			const unsigned int nWin = numCollectionWindows();
+
+			for (unsigned int i = 0; i < n; ++i)
+			{
+				const double a = acc.last[i];
+				const double slope = (h > 0.0) ? (_buffer[i] - a) / h : 0.0;
+
+				// Integrals of tau^k * c(t_0 + tau) over [0, h]
+				const double int0 = h * (a + 0.5 * slope * h);
+				const double int1 = h * h * (0.5 * a + slope * h / 3.0);
+				const double int2 = h * h * h * (a / 3.0 + 0.25 * slope * h);
+
+				acc.moment0[i] += int0;
+				acc.moment1[i] += t0 * int0 + int1;
+				acc.moment2[i] += t0 * t0 * int0 + 2.0 * t0 * int1 + int2;
+
+				for (unsigned int w = 0; w < nWin; ++w)
+				{
+					const double lo = std::max(_fracStart[w], _tPrev);
+					const double hi = std::min(_fracEnd[w], _tCur);
+					if (hi <= lo)
+						continue;
+
+					const double cLo = a + slope * (lo - _tPrev);
+					const double cHi = a + slope * (hi - _tPrev);
+					acc.fraction[w * n + i] += 0.5 * (hi - lo) * (cLo + cHi);
+				}
+			}
+		}
+
+		std::copy(_buffer.begin(), _buffer.end(), acc.last.begin());
+	}
+
+	template <typename Writer_t, typename Func_t>
+	void writeKpi(Writer_t& writer, const char* name, std::vector<double>& buffer, Func_t kpi)
+	{
+		for (unsigned int i = 0; i < numValues(); ++i)
+			buffer[i] = kpi(i);
+
+		if (_nOutletPorts == 1)
+			writer.template vector<double>(name, buffer.size(), buffer.data());
+		else
+			writer.template matrix<double>(name, _nOutletPorts, _nComp, buffer);
+	}
+
+	template <typename Writer_t, typename Func_t>
+	void writeFractionKpi(Writer_t& writer, const char* name, std::vector<double>& buffer, Func_t kpi)
+	{
+		const unsigned int n = numValues();
+		for (unsigned int w = 0; w < numCollectionWindows(); ++w)
+		{
+			for (unsigned int i = 0; i < n; ++i)
+				buffer[w * n + i] = kpi(w, i);
+		}
+
+		writer.template matrix<double>(name, numCollectionWindows(), n, buffer);
+	}
+
+	UnitOpIdx _unitOp;
+	unsigned int _nComp;
+	unsigned int _nOutletPorts;
+	unsigned int _numSens;
+	bool _storeSens;
+
+	unsigned int _numTimesteps;
+	double _tRef; //!< Reference time of the moments (first recorded time point)
+	double _tPrev;
+	double _tCur;
+
+	std::vector<double> _fracStart; //!< Start times of the collection windows
+	std::vector<double> _fracEnd; //!< End times of the collection windows
+
+	Accumulator _data;
+	std::vector<Accumulator> _sens;
+	std::vector<double> _peakTime;
+	std::vector<bool> _peakUpdated; //!< Determines whether the peak maximum has been updated in the current time step
+	std::vector<double> _buffer; //!< Outlet values of the current time point
+
+	Accumulator* _cur; //!< Accumulator that receives the current data
 };
 
 
 /**
  * @brief Stores pieces of the solution of the whole model system in recorders of single unit operations
- * @details Maintains a collection of InternalStorageUnitOpRecorder objects that store individual unit operations.
- *          The individual unit operation recorders are owned by this object and destroyed upon its own
+ * @details Maintains a collection of InternalStorageUnitOpRecorder objects that store individual unit operations
+ *          and OutletKpiRecorder objects that accumulate outlet KPIs of individual unit operations. The individual unit operation recorders are owned by this object and destroyed upon its own
  *          destruction.
  */
 class InternalStorageSystemRecorder : public ISolutionRecorder
@@ -1033,6 +1924,9 @@ public:
 
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->clear();
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->clear();
 	}
 
 	virtual void prepare(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
@@ -1045,6 +1939,9 @@ public:
 
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->prepare(numDofs, numSens, numTimesteps);
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->prepare(numDofs, numSens, numTimesteps);
 	}
 
 	virtual void notifyIntegrationStart(unsigned int numDofs, unsigned int numSens, unsigned int numTimesteps)
@@ -1059,6 +1956,9 @@ public:
 
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->notifyIntegrationStart(numDofs, numSens, numTimesteps);
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->notifyIntegrationStart(numDofs, numSens, numTimesteps);
 	}
 
 	virtual void unitOperationStructure(UnitOpIdx idx, const IModel& model, const ISolutionExporter& exporter)
@@ -1066,6 +1966,9 @@ public:
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->unitOperationStructure(idx, model, exporter);
 
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->unitOperationStructure(idx, model, exporter);
+
 		// Reset for counting actual number of time steps
 		_numTimesteps = 0;
 	}
@@ -1078,72 +1981,108 @@ public:
 
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->beginTimestep(t);
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->beginTimestep(t);
 	}
 
 	virtual void beginUnitOperation(cadet::UnitOpIdx idx, const cadet::IModel& model, const cadet::ISolutionExporter& exporter)
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->beginUnitOperation(idx, model, exporter);
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->beginUnitOperation(idx, model, exporter);
 	}
 
 	virtual void endUnitOperation()
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->endUnitOperation();
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->endUnitOperation();
 	}
 
 	virtual void endTimestep()
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->endTimestep();
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->endTimestep();
 	}
 
 	virtual void beginSolution()
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->beginSolution();
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->beginSolution();
 	}
 
 	virtual void endSolution()
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->endSolution();
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->endSolution();
 	}
 
 	virtual void beginSolutionDerivative()
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->beginSolutionDerivative();
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->beginSolutionDerivative();
 	}
 
 	virtual void endSolutionDerivative()
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->endSolutionDerivative();
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->endSolutionDerivative();
 	}
 
 	virtual void beginSensitivity(const cadet::ParameterId& pId, unsigned int sensIdx)
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->beginSensitivity(pId, sensIdx);
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->beginSensitivity(pId, sensIdx);
 	}
 
 	virtual void endSensitivity(const cadet::ParameterId& pId, unsigned int sensIdx)
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->endSensitivity(pId, sensIdx);
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->endSensitivity(pId, sensIdx);
 	}
 
 	virtual void beginSensitivityDerivative(const cadet::ParameterId& pId, unsigned int sensIdx)
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->beginSensitivityDerivative(pId, sensIdx);
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->beginSensitivityDerivative(pId, sensIdx);
 	}
 
 	virtual void endSensitivityDerivative(const cadet::ParameterId& pId, unsigned int sensIdx)
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			rec->endSensitivityDerivative(pId, sensIdx);
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->endSensitivityDerivative(pId, sensIdx);
 	}
 
 	template <typename Writer_t>
@@ -1180,6 +2119,10 @@ public:
 
 			writer.pushGroup(oss.str());
 			rec->writeSolution(writer);
+
+			if (OutletKpiRecorder* const kpiRec = kpiUnitOperation(rec->unitOperation()))
+				kpiRec->writeSolution(writer);
+
 			writer.popGroup();
 		}
 	}
@@ -1202,6 +2145,10 @@ public:
 
 				writer.pushGroup(oss.str());
 				rec->writeSensitivity(writer, param);
+
+				if (OutletKpiRecorder* const kpiRec = kpiUnitOperation(rec->unitOperation()))
+					kpiRec->writeSensitivity(writer, param);
+
 				writer.popGroup();
 			}
 
@@ -1253,18 +2200,162 @@ public:
 		return nullptr;
 	}
 
+	inline void addKpiRecorder(OutletKpiRecorder* rec)
+	{
+		_kpiRecorders.push_back(rec);
+	}
+
+	inline unsigned int numKpiRecorders() const CADET_NOEXCEPT { return _kpiRecorders.size(); }
+
+	inline OutletKpiRecorder* kpiUnitOperation(UnitOpIdx idx) CADET_NOEXCEPT
+	{
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+		{
+			if (rec->unitOperation() == idx)
+				return rec;
+		}
+		return nullptr;
+	}
+	inline OutletKpiRecorder const* kpiUnitOperation(UnitOpIdx idx) const CADET_NOEXCEPT
+	{
+		for (OutletKpiRecorder const* rec : _kpiRecorders)
+		{
+			if (rec->unitOperation() == idx)
+				return rec;
+		}
+		return nullptr;
+	}
+
 	inline void deleteRecorders()
 	{
 		for (InternalStorageUnitOpRecorder* rec : _recorders)
 			delete rec;
 		_recorders.clear();
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			delete rec;
+		_kpiRecorders.clear();
 	}
 
 	inline double const* time() const CADET_NOEXCEPT { return _time.data(); }
 
+	/**
+	 * @brief Returns a view on the recorded time points that can be wrapped without copying (see DataView)
+	 * @return View on the time points
+	 */
+	inline DataView timeView() const CADET_NOEXCEPT
+	{
+		const std::size_t shape = _numTimesteps;
+		return makeContiguousView(_time.empty() ? nullptr : _time.data(), DataViewType::Double, &shape, 1);
+	}
+
+	/**
+	 * @brief Appends the time steps recorded by another system recorder
+	 * @details Both recorders have to share structure and configuration except for the time
+	 *          stride of the unit operation recorders (see InternalStorageUnitOpRecorder::append()).
+	 *          The other recorder has to store time points. Outlet KPIs and sensitivities are not appended.
+	 * @param [in] other Recorder whose time steps are appended
+	 */
+	void append(const InternalStorageSystemRecorder& other)
+	{
+		for (unsigned int i = 0; i < _recorders.size(); ++i)
+			_recorders[i]->append(*other._recorders[i], other._time.data());
+
+		_numTimesteps += other._numTimesteps;
+		if (_storeTime)
+			_time.insert(_time.end(), other._time.begin(), other._time.end());
+	}
+
+	/**
+	 * @brief Saves the data recorded so far by all unit operation and KPI recorders (e.g., for a checkpoint)
+	 * @param [in,out] buffer Buffer the data is appended to
+	 */
+	void saveState(StateBufferWriter& buffer) const
+	{
+		buffer.scalar(_numTimesteps);
+		buffer.vector(_time);
+
+		buffer.scalar(_recorders.size());
+		for (InternalStorageUnitOpRecorder const* rec : _recorders)
+			rec->saveState(buffer);
+
+		buffer.scalar(_kpiRecorders.size());
+		for (OutletKpiRecorder const* rec : _kpiRecorders)
+			rec->saveState(buffer);
+	}
+
+	/**
+	 * @brief Replaces the data of all unit operation and KPI recorders by previously saved data
+	 * @details The recorder has to be configured like the one that saved the data, and the structure
+	 *          of the model has to be reported (i.e., notifyIntegrationStart() and unitOperationStructure()
+	 *          have been called). Recording continues after the restored time points.
+	 * @param [in,out] buffer Buffer the data is read from
+	 */
+	void restoreState(StateBufferReader& buffer)
+	{
+		_numTimesteps = buffer.scalar<unsigned int>();
+		buffer.vector(_time);
+
+		if (buffer.scalar<std::size_t>() != _recorders.size())
+			throw InvalidParameterException("Number of unit operation recorders in saved state does not match");
+
+		for (InternalStorageUnitOpRecorder* rec : _recorders)
+			rec->restoreState(buffer);
+
+		if (buffer.scalar<std::size_t>() != _kpiRecorders.size())
+			throw InvalidParameterException("Number of KPI recorders in saved state does not match");
+
+		for (OutletKpiRecorder* rec : _kpiRecorders)
+			rec->restoreState(buffer);
+	}
+
+	/**
+	 * @brief Exchanges the recorder of a unit operation with the one of another system recorder
+	 * @details Used for assembling results of unit operations that have been computed by different
+	 *          simulators. Exchanging a second time restores the original state.
+	 * @param [in,out] other Recorder to exchange with
+	 * @param [in] idx Index of the unit operation
+	 * @return @c true if both recorders have a recorder for the unit operation, otherwise @c false
+	 */
+	bool exchangeUnitOperation(InternalStorageSystemRecorder& other, UnitOpIdx idx)
+	{
+		const auto isUnit = [=](InternalStorageUnitOpRecorder const* rec) { return rec->unitOperation() == idx; };
+		const std::vector<InternalStorageUnitOpRecorder*>::iterator it = std::find_if(_recorders.begin(), _recorders.end(), isUnit);
+		const std::vector<InternalStorageUnitOpRecorder*>::iterator itOther = std::find_if(other._recorders.begin(), other._recorders.end(), isUnit);
+
+		if ((it == _recorders.end()) || (itOther == other._recorders.end()))
+			return false;
+
+		std::swap(*it, *itOther);
+		return true;
+	}
+
+	/**
+	 * @brief Takes over the time points recorded by another system recorder
+	 * @param [in] other Recorder whose time points are copied
+	 */
+	void assignTime(const InternalStorageSystemRecorder& other)
+	{
+		_numTimesteps = other._numTimesteps;
+		if (_storeTime)
+			_time = other._time;
+	}
+
+	/**
+	 * @brief Sets the time points of results that are not obtained by time integration
+	 * @param [in] time Time points
+	 */
+	void assignTime(const std::vector<double>& time)
+	{
+		_numTimesteps = time.size();
+		if (_storeTime)
+			_time = time;
+	}
+
 protected:
 
 	std::vector<InternalStorageUnitOpRecorder*> _recorders;
+	std::vector<OutletKpiRecorder*> _kpiRecorders;
 	unsigned int _numTimesteps;
 	unsigned int _numSens;
 	std::vector<double> _time;
@@ -0,0 +1,137 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides serialization of internal state into flat buffers of doubles (e.g., for checkpoints).
+ */
+
+#ifndef CADET_STATEBUFFER_HPP_
+#define CADET_STATEBUFFER_HPP_
+
+#include "cadet/cadetCompilerInfo.hpp"
+#include "cadet/Exceptions.hpp"
+
+#include <vector>
+#include <cstddef>
+
+namespace cadet
+{
+
+	/**
+	 * @brief Appends scalars and arrays to a flat buffer of doubles
+	 * @details Integral and boolean values are converted to double, which is exact for integers
+	 *          up to @f$ 2^{53} @f$. Arrays are prefixed by their length. The buffer is read back by
+	 *          a StateBufferReader in the same order.
+	 */
+	class StateBufferWriter
+	{
+	public:
+		StateBufferWriter(std::vector<double>& buffer) : _buffer(buffer) { }
+
+		template <typename T>
+		inline void scalar(T val) { _buffer.push_back(static_cast<double>(val)); }
+
+		template <typename T>
+		inline void array(T const* data, std::size_t len)
+		{
+			scalar(len);
+			for (std::size_t i = 0; i < len; ++i)
+				_buffer.push_back(static_cast<double>(data[i]));
+		}
+
+		template <typename T>
+		inline void vector(const std::vector<T>& data)
+		{
+			scalar(data.size());
+			for (std::size_t i = 0; i < data.size(); ++i)
+				_buffer.push_back(static_cast<double>(data[i]));
+		}
+
+		template <typename T>
+		inline void vectors(const std::vector<std::vector<T>>& data)
+		{
+			scalar(data.size());
+			for (const std::vector<T>& v : data)
+				vector(v);
+		}
+
+	private:
+		std::vector<double>& _buffer;
+	};
+
+	/**
+	 * @brief Reads scalars and arrays from a flat buffer of doubles written by a StateBufferWriter
+	 * @details Throws an InvalidParameterException if the buffer ends prematurely or if the length
+	 *          of an array does not match the expected length.
+	 */
+	class StateBufferReader
+	{
+	public:
+		StateBufferReader(double const* data, std::size_t len) : _cur(data), _end(data + len) { }
+
+		template <typename T>
+		inline T scalar()
+		{
+			require(1);
+			return static_cast<T>(*(_cur++));
+		}
+
+		template <typename T>
+		inline void array(T* data, std::size_t len)
+		{
+			if (scalar<std::size_t>() != len)
+				throw InvalidParameterException("Size mismatch in saved state");
+
+			require(len);
+			for (std::size_t i = 0; i < len; ++i)
+				data[i] = static_cast<T>(_cur[i]);
+			_cur += len;
+		}
+
+		template <typename T>
+		inline void vector(std::vector<T>& data)
+		{
+			const std::size_t len = scalar<std::size_t>();
+			require(len);
+
+			data.resize(len);
+			for (std::size_t i = 0; i < len; ++i)
+				data[i] = static_cast<T>(_cur[i]);
+			_cur += len;
+		}
+
+		template <typename T>
+		inline void vectors(std::vector<std::vector<T>>& data)
+		{
+			data.resize(scalar<std::size_t>());
+			for (std::vector<T>& v : data)
+				vector(v);
+		}
+
+		inline bool atEnd() const CADET_NOEXCEPT { return _cur == _end; }
+
+	private:
+
+		inline void require(std::size_t n) const
+		{
+			if (static_cast<std::size_t>(_end - _cur) < n)
+				throw InvalidParameterException("Saved state is truncated");
+		}
+
+		double const* _cur;
+		double const* _end;
+	};
+
+} // namespace cadet
+
+#endif  // CADET_STATEBUFFER_HPP_
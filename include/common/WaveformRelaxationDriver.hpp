@@ -0,0 +1,788 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a driver that integrates groups of unit operations separately using waveform relaxation
+ */
+
+#ifndef CADET_WAVEFORMRELAXATIONDRIVER_HPP_
+#define CADET_WAVEFORMRELAXATIONDRIVER_HPP_
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <cmath>
+
+#include "common/PararealDriver.hpp"
+#include "common/OverlayParameterProvider.hpp"
+#include "common/Timer.hpp"
+
+#ifdef CADET_PARALLELIZE
+	#include <tbb/parallel_for.h>
+#endif
+
+namespace cadet
+{
+
+/**
+ * @brief Driver that integrates groups of unit operations separately using waveform relaxation
+ * @details The flowsheet is partitioned into groups of unit operations. Each group is integrated by
+ *          its own simulator with its own time steps over the whole time domain. Unit operations of
+ *          other groups that feed a group are replaced by inlets (see WAVEFORM inlet profile) that
+ *          interpolate the outlet concentrations recorded by the upstream group. Outflows to other
+ *          groups end in additional outlet units. Inlet unit operations are replicated in each group
+ *          they feed.
+ *
+ *          Groups are integrated in topological order. Groups on the same level of the dependency
+ *          graph do not depend on each other and are integrated in parallel. Without recycles, the
+ *          result is obtained after one sweep. Recycles are resolved by repeating sweeps until the
+ *          weighted change of the outlet waveforms passed between groups falls below a tolerance.
+ *
+ *          Waveform relaxation is configured in the @c waveform_relaxation group of the solver scope.
+ *          If the group is missing, the driver behaves exactly like a cadet::PararealDriver. Since the
+ *          waveforms are sampled at the user-defined solution times, @c USER_SOLUTION_TIMES have to be
+ *          given. Waveform relaxation is not applied (and a warning is issued) if sensitivities,
+ *          events, outlet KPIs, full initial or last states, or unit operations with multiple ports
+ *          are used, or if Parareal is enabled.
+ */
+class WaveformRelaxationDriver : public PararealDriver
+{
+public:
+	WaveformRelaxationDriver() : PararealDriver(), _startTime(0.0), _maxSweeps(0), _sweepTol(1.0), _wrRelTol(0.0), _wrAbsTol(0.0),
+		_cyclic(false), _exchanged(false), _sweeps(0), _wrWallTime(0.0) { }
+
+	~WaveformRelaxationDriver() CADET_NOEXCEPT { }
+
+	/**
+	 * @brief Builds and configures the simulators of all groups of unit operations
+	 * @details The driver itself holds the full model and the combined results.
+	 * @param [in] pp Implementation of cadet::IParameterProvider used as input
+	 * @tparam ParamProvider_t Type of the parameter provider
+	 */
+	template <typename ParamProvider_t>
+	void configure(ParamProvider_t& pp)
+	{
+		_groups.clear();
+		_levels.clear();
+		_unitGroup.clear();
+		_exchanged = false;
+		_sweeps = 0;
+
+		PararealDriver::configure(pp);
+
+		pp.pushScope("solver");
+		if (!pp.exists("waveform_relaxation"))
+		{
+			pp.popScope();
+			return;
+		}
+
+		pp.pushScope("waveform_relaxation");
+		std::vector<int> unitGroup;
+		if (pp.exists("UNIT_GROUP"))
+			unitGroup = pp.getIntArray("UNIT_GROUP");
+		_maxSweeps = pp.exists("MAX_ITER") ? static_cast<unsigned int>(std::max(pp.getInt("MAX_ITER"), 1)) : 20;
+		_sweepTol = pp.exists("TOL") ? pp.getDouble("TOL") : 1.0;
+		pp.popScope(); // waveform_relaxation scope
+
+		if (_sweepTol <= 0.0)
+			throw cadet::InvalidParameterException("Waveform relaxation tolerance TOL has to be positive");
+
+		// Error weights of the time integrator for judging convergence
+		pp.pushScope("time_integrator");
+		_wrRelTol = pp.getDouble("RELTOL");
+		if (pp.isArray("ABSTOL"))
+		{
+			const std::vector<double> absTol = pp.getDoubleArray("ABSTOL");
+			_wrAbsTol = *std::min_element(absTol.begin(), absTol.end());
+		}
+		else
+			_wrAbsTol = pp.getDouble("ABSTOL");
+		pp.popScope(); // time_integrator scope
+
+		const bool hasUserTimes = pp.exists("USER_SOLUTION_TIMES");
+
+		std::vector<double> secTimes;
+		std::vector<bool> secCont;
+		extractSectionTimes(pp, secTimes, secCont);
+		_startTime = secTimes.front();
+
+		pp.popScope(); // solver scope
+
+		const Flowsheet fs = readFlowsheet(pp);
+
+		if (!supported(hasUserTimes, fs))
+			return;
+
+		if (!partitionUnits(fs, unitGroup))
+		{
+			LOG(Warning) << "Waveform relaxation requires at least two groups of unit operations, falling back to monolithic time integration";
+			return;
+		}
+
+		for (unsigned int g = 0; g < _groups.size(); ++g)
+		{
+			OverlayParameterProvider view(&pp);
+			createGroupView(fs, g, view);
+
+			UnitGroup& grp = _groups[g];
+			grp.driver = std::unique_ptr<Driver>(new Driver());
+			grp.driver->configure(view);
+			grp.driver->solution()->storeTime(true);
+
+			unsigned int len = 0;
+			double const* const y0 = grp.driver->simulator()->getLastSolution(len);
+			double const* const yDot0 = grp.driver->simulator()->getLastSolutionDerivative(len);
+			grp.init.assign(y0, y0 + len);
+			grp.init.insert(grp.init.end(), yDot0, yDot0 + len);
+		}
+
+		LOG(Debug) << "Waveform relaxation with " << _groups.size() << " groups on " << _levels.size() << " levels, " << (_cyclic ? "cyclic" : "acyclic");
+	}
+
+	/**
+	 * @brief Performs time integration
+	 * @details Uses waveform relaxation if configured. Otherwise, the simulation is integrated by the
+	 *          cadet::PararealDriver.
+	 */
+	void run()
+	{
+		if (_groups.empty())
+		{
+			PararealDriver::run();
+			return;
+		}
+
+		// Return recorders of the previous run to their groups
+		if (_exchanged)
+			exchangeResults();
+
+		Timer timer;
+		timer.start();
+
+		std::vector<bool> integrated(_groups.size(), false);
+		std::vector<std::vector<double>> lastOutlet(_unitGroup.size());
+
+		_sweeps = 0;
+		for (unsigned int sweep = 0; sweep < _maxSweeps; ++sweep)
+		{
+			for (const std::vector<unsigned int>& level : _levels)
+			{
+				// Collect inputs beforehand since inputs along recycles may be produced by groups of the same level
+				for (unsigned int g : level)
+				{
+					UnitGroup& grp = _groups[g];
+					for (unsigned int i = 0; i < grp.proxies.size(); ++i)
+						sampleOutlet(grp.proxies[i], integrated[_unitGroup[grp.proxies[i]]], grp.waveTime[i], grp.waveData[i]);
+				}
+
+				const auto solve = [&](std::size_t i)
+					{
+						UnitGroup& grp = _groups[level[i]];
+						cadet::ISimulator& sim = *grp.driver->simulator();
+
+						for (unsigned int j = 0; j < grp.proxies.size(); ++j)
+						{
+							OverlayParameterProvider wave(nullptr);
+							wave.set("", "TIME", grp.waveTime[j]);
+							wave.set("", "DATA", grp.waveData[j]);
+							sim.reconfigureModel(wave, grp.proxies[j]);
+						}
+
+						const unsigned int nDof = sim.numDofs();
+						sim.applyInitialCondition(grp.init.data(), grp.init.data() + nDof);
+						sim.integrate();
+					};
+
+#ifdef CADET_PARALLELIZE
+				tbb::parallel_for(std::size_t(0), level.size(), solve);
+#else
+				for (std::size_t i = 0; i < level.size(); ++i)
+					solve(i);
+#endif
+
+				for (unsigned int g : level)
+					integrated[g] = true;
+			}
+
+			++_sweeps;
+
+			// All groups have seen the final waveforms of their inputs
+			if (!_cyclic)
+				break;
+
+			const double maxChange = outletChange(lastOutlet);
+			LOG(Debug) << "Waveform relaxation sweep " << _sweeps << ": max weighted change of outlet waveforms " << maxChange;
+
+			if ((sweep > 0) && (maxChange <= _sweepTol))
+				break;
+		}
+
+		exchangeResults();
+
+		_wrWallTime = timer.stop();
+
+		LOG(Info) << "Waveform relaxation with " << _groups.size() << " groups finished after " << _sweeps << " sweeps in " << _wrWallTime << " s";
+	}
+
+	/**
+	 * @brief Writes the current results to the given writer
+	 * @details Adds waveform relaxation statistics to the @c meta group.
+	 * @param [in] writer Writer to write to
+	 * @tparam Writer_t Type of the writer
+	 */
+	template <typename Writer_t>
+	void write(Writer_t& writer)
+	{
+		PararealDriver::write(writer);
+
+		if (_groups.empty() || (_sweeps == 0))
+			return;
+
+		writer.pushGroup("meta");
+
+		const char* const names[] = {"TIME_SIM", "WAVEFORM_GROUPS", "WAVEFORM_ITERATIONS"};
+		for (const char* name : names)
+		{
+			if (writer.exists(name))
+				writer.unlinkDataset(name);
+		}
+
+		writer.scalar("TIME_SIM", _wrWallTime);
+		writer.scalar("WAVEFORM_GROUPS", static_cast<int>(_groups.size()));
+		writer.scalar("WAVEFORM_ITERATIONS", static_cast<int>(_sweeps));
+
+		writer.popGroup();
+	}
+
+	/**
+	 * @brief Returns the number of separately integrated groups of unit operations
+	 * @return Number of groups, or @c 0 if waveform relaxation is not used
+	 */
+	inline unsigned int numGroups() const CADET_NOEXCEPT { return _groups.size(); }
+
+	/**
+	 * @brief Returns the group of each unit operation
+	 * @details Inlet unit operations are replicated in all groups they feed and have group @c -1.
+	 *          The vector is empty if waveform relaxation is not used.
+	 * @return Group index of each unit operation
+	 */
+	inline const std::vector<int>& unitGroups() const CADET_NOEXCEPT { return _unitGroup; }
+
+	inline unsigned int numSweeps() const CADET_NOEXCEPT { return _sweeps; }
+	inline bool isCyclic() const CADET_NOEXCEPT { return _cyclic; }
+
+protected:
+
+	/**
+	 * @brief Structure of the flowsheet as read from the input
+	 */
+	struct Flowsheet
+	{
+		std::vector<std::string> unitType; //!< Type of each unit operation
+		std::vector<int> nComp; //!< Number of components of each unit operation
+		std::vector<bool> hasReturn; //!< Determines whether output is requested for each unit operation
+		std::vector<std::vector<double>> connections; //!< Connection list of each valve switch
+		unsigned int nCols; //!< Number of columns of the connection lists
+		bool hasInitState; //!< Determines whether the full initial state is given
+	};
+
+	struct UnitGroup
+	{
+		std::unique_ptr<Driver> driver; //!< Driver of the group
+		std::vector<UnitOpIdx> units; //!< Unit operations whose results are taken from this group
+		std::vector<UnitOpIdx> proxies; //!< Unit operations of other groups that feed this group
+		std::vector<double> init; //!< Initial state and its time derivative
+		std::vector<std::vector<double>> waveTime; //!< Sample times of the waveform of each proxy
+		std::vector<std::vector<double>> waveData; //!< Samples of the waveform of each proxy
+	};
+
+	static inline std::string unitScope(unsigned int idx)
+	{
+		std::ostringstream oss;
+		oss << "unit_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << idx;
+		return oss.str();
+	}
+
+	template <typename ParamProvider_t>
+	Flowsheet readFlowsheet(ParamProvider_t& pp)
+	{
+		Flowsheet fs;
+
+		pp.pushScope("model");
+		fs.hasInitState = pp.exists("INIT_STATE_Y");
+
+		for (unsigned int i = 0; pp.exists(unitScope(i)); ++i)
+		{
+			pp.pushScope(unitScope(i));
+			fs.unitType.push_back(pp.getString("UNIT_TYPE"));
+			fs.nComp.push_back(pp.getInt("NCOMP"));
+			pp.popScope();
+		}
+
+		pp.pushScope("connections");
+		const bool hasPorts = pp.exists("CONNECTIONS_INCLUDE_PORTS") && pp.getBool("CONNECTIONS_INCLUDE_PORTS");
+		fs.nCols = hasPorts ? 7 : 5;
+
+		const int nSwitches = pp.getInt("NSWITCHES");
+		std::ostringstream oss;
+		for (int i = 0; i < nSwitches; ++i)
+		{
+			oss.str("");
+			oss << "switch_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
+			pp.pushScope(oss.str());
+			fs.connections.push_back(pp.getDoubleArray("CONNECTIONS"));
+			pp.popScope();
+
+			if (fs.connections.back().size() % fs.nCols != 0)
+				throw cadet::InvalidParameterException("CONNECTIONS matrix has to have " + std::to_string(fs.nCols) + " columns");
+		}
+		pp.popScope(); // connections scope
+		pp.popScope(); // model scope
+
+		pp.pushScope("return");
+		for (unsigned int i = 0; i < fs.unitType.size(); ++i)
+			fs.hasReturn.push_back(pp.exists(unitScope(i)));
+		pp.popScope(); // return scope
+
+		return fs;
+	}
+
+	bool supported(bool hasUserTimes, const Flowsheet& fs) const
+	{
+		const char* reason = nullptr;
+		if (!sliceBoundaries().empty())
+			reason = "Parareal";
+		else if (_sim->numSensParams() > 0)
+			reason = "sensitivities";
+		else if (_sim->numEvents() > 0)
+			reason = "events";
+		else if (_storage->numKpiRecorders() > 0)
+			reason = "outlet KPIs";
+		else if (!hasUserTimes)
+			reason = "missing USER_SOLUTION_TIMES";
+		else if (fs.hasInitState || _writeLastState || _writeLastStateSens)
+			reason = "full initial or last states";
+		else if (std::find(fs.unitType.begin(), fs.unitType.end(), "GENERAL_RATE_MODEL_2D") != fs.unitType.end())
+			reason = "unit operations with multiple ports";
+
+		if (reason)
+		{
+			LOG(Warning) << "Waveform relaxation does not support " << reason << ", falling back to monolithic time integration";
+			return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * @brief Assigns unit operations to groups and orders the groups
+	 * @details By default, each unit operation forms its own group except for outlet unit operations,
+	 *          which join the group of their first upstream unit operation. Edges that close a
+	 *          recycle are determined by depth-first search and ignored for ordering the groups.
+	 * @param [in] fs Flowsheet
+	 * @param [in] userGroup Group index of each unit operation as given by the user (may be empty)
+	 * @return @c true if there are at least two groups, otherwise @c false
+	 */
+	bool partitionUnits(const Flowsheet& fs, const std::vector<int>& userGroup)
+	{
+		const unsigned int nUnits = fs.unitType.size();
+		if (!userGroup.empty() && (userGroup.size() < nUnits))
+			throw cadet::InvalidParameterException("UNIT_GROUP has to contain an element for each unit operation");
+
+		// Group as given by user or default group
+		std::vector<int> rawGroup(nUnits, -1);
+		for (unsigned int i = 0; i < nUnits; ++i)
+		{
+			if (fs.unitType[i] == "INLET")
+				continue;
+
+			if (!userGroup.empty())
+			{
+				if (userGroup[i] < 0)
+					throw cadet::InvalidParameterException("UNIT_GROUP of unit operation " + std::to_string(i) + " has to be non-negative");
+				rawGroup[i] = userGroup[i];
+				continue;
+			}
+
+			rawGroup[i] = i;
+			if (fs.unitType[i] != "OUTLET")
+				continue;
+
+			forEachConnection(fs, [&](int src, int dest)
+				{
+					if ((dest == static_cast<int>(i)) && (rawGroup[i] == static_cast<int>(i)) && (fs.unitType[src] != "INLET") && (fs.unitType[src] != "OUTLET"))
+						rawGroup[i] = src;
+				});
+		}
+
+		// Compact group indices in order of appearance
+		std::vector<int> ids;
+		_unitGroup.assign(nUnits, -1);
+		for (unsigned int i = 0; i < nUnits; ++i)
+		{
+			if (rawGroup[i] < 0)
+				continue;
+
+			const std::vector<int>::const_iterator it = std::find(ids.begin(), ids.end(), rawGroup[i]);
+			_unitGroup[i] = it - ids.begin();
+			if (it == ids.end())
+				ids.push_back(rawGroup[i]);
+		}
+
+		const unsigned int nGroups = ids.size();
+		if (nGroups < 2)
+		{
+			_unitGroup.clear();
+			return false;
+		}
+
+		// Dependencies between groups
+		_groups = std::vector<UnitGroup>(nGroups);
+		std::vector<std::vector<bool>> edge(nGroups, std::vector<bool>(nGroups, false));
+		std::vector<int> inletOwner(nUnits, -1);
+		forEachConnection(fs, [&](int src, int dest)
+			{
+				const int gSrc = _unitGroup[src];
+				const int gDest = _unitGroup[dest];
+				if (gDest < 0)
+					return;
+
+				if (gSrc < 0)
+				{
+					if (inletOwner[src] < 0)
+						inletOwner[src] = gDest;
+				}
+				else if (gSrc != gDest)
+				{
+					edge[gSrc][gDest] = true;
+					std::vector<UnitOpIdx>& proxies = _groups[gDest].proxies;
+					if (std::find(proxies.begin(), proxies.end(), static_cast<UnitOpIdx>(src)) == proxies.end())
+						proxies.push_back(src);
+				}
+			});
+
+		for (unsigned int i = 0; i < nUnits; ++i)
+		{
+			if (_unitGroup[i] >= 0)
+				_groups[_unitGroup[i]].units.push_back(i);
+			else
+				_groups[std::max(inletOwner[i], 0)].units.push_back(i);
+		}
+
+		for (UnitGroup& grp : _groups)
+		{
+			grp.waveTime.resize(grp.proxies.size());
+			grp.waveData.resize(grp.proxies.size());
+		}
+
+		// Depth-first search for finding recycle edges and a topological order of the remaining graph
+		std::vector<int> state(nGroups, 0);
+		std::vector<unsigned int> postOrder;
+		postOrder.reserve(nGroups);
+		_cyclic = false;
+
+		std::function<void(unsigned int)> visit = [&](unsigned int g)
+			{
+				state[g] = 1;
+				for (unsigned int h = 0; h < nGroups; ++h)
+				{
+					if (!edge[g][h])
+						continue;
+
+					if (state[h] == 1)
+					{
+						// Edge closes a recycle
+						edge[g][h] = false;
+						_cyclic = true;
+					}
+					else if (state[h] == 0)
+						visit(h);
+				}
+				state[g] = 2;
+				postOrder.push_back(g);
+			};
+
+		for (unsigned int g = 0; g < nGroups; ++g)
+		{
+			if (state[g] == 0)
+				visit(g);
+		}
+
+		// Level of each group is the length of the longest path leading to it
+		std::vector<unsigned int> level(nGroups, 0);
+		for (std::vector<unsigned int>::const_reverse_iterator it = postOrder.rbegin(); it != postOrder.rend(); ++it)
+		{
+			for (unsigned int h = 0; h < nGroups; ++h)
+			{
+				if (edge[*it][h])
+					level[h] = std::max(level[h], level[*it] + 1);
+			}
+		}
+
+		_levels = std::vector<std::vector<unsigned int>>(*std::max_element(level.begin(), level.end()) + 1);
+		for (unsigned int g = 0; g < nGroups; ++g)
+			_levels[level[g]].push_back(g);
+
+		return true;
+	}
+
+	/**
+	 * @brief Sets up the input of a group
+	 * @details Unit operations that feed the group but belong to other groups are replaced by
+	 *          waveform inlets, all other unit operations that are not simulated by the group are
+	 *          replaced by outlets. Outflows to other groups are redirected to additional outlets.
+	 * @param [in] fs Flowsheet
+	 * @param [in] g Index of the group
+	 * @param [out] view Overlay of the input
+	 */
+	void createGroupView(const Flowsheet& fs, unsigned int g, OverlayParameterProvider& view) const
+	{
+		const unsigned int nUnits = fs.unitType.size();
+		const UnitGroup& grp = _groups[g];
+
+		// Unit operations that are simulated by this group
+		std::vector<bool> simulated(nUnits, false);
+		for (unsigned int i = 0; i < nUnits; ++i)
+			simulated[i] = (_unitGroup[i] == static_cast<int>(g));
+		for (UnitOpIdx i : grp.units)
+			simulated[i] = true;
+		forEachConnection(fs, [&](int src, int dest)
+			{
+				if ((_unitGroup[src] < 0) && (_unitGroup[dest] == static_cast<int>(g)))
+					simulated[src] = true;
+			});
+
+		for (unsigned int i = 0; i < nUnits; ++i)
+		{
+			if (simulated[i])
+				continue;
+
+			const std::string path = "model/" + unitScope(i);
+			view.addScope(path);
+			view.set(path, "NCOMP", fs.nComp[i]);
+
+			if (std::find(grp.proxies.begin(), grp.proxies.end(), i) != grp.proxies.end())
+			{
+				view.set(path, "UNIT_TYPE", "INLET");
+				view.set(path, "INLET_TYPE", "WAVEFORM");
+				view.set(path, "TIME", std::vector<double>(1, _startTime));
+				view.set(path, "DATA", std::vector<double>(fs.nComp[i], 0.0));
+			}
+			else
+				view.set(path, "UNIT_TYPE", "OUTLET");
+		}
+
+		// Redirect outflows to other groups into additional outlets
+		std::vector<int> sink(nUnits, -1);
+		unsigned int nSinks = 0;
+		for (unsigned int s = 0; s < fs.connections.size(); ++s)
+		{
+			const std::vector<double>& conn = fs.connections[s];
+			std::vector<double> filtered;
+			filtered.reserve(conn.size());
+
+			for (std::size_t r = 0; r < conn.size(); r += fs.nCols)
+			{
+				const int src = static_cast<int>(conn[r]);
+				const int dest = static_cast<int>(conn[r + 1]);
+
+				if (_unitGroup[dest] == static_cast<int>(g))
+				{
+					filtered.insert(filtered.end(), conn.begin() + r, conn.begin() + r + fs.nCols);
+					continue;
+				}
+
+				if (_unitGroup[src] != static_cast<int>(g))
+					continue;
+
+				if (sink[src] < 0)
+				{
+					sink[src] = nUnits + nSinks;
+					++nSinks;
+
+					const std::string path = "model/" + unitScope(sink[src]);
+					view.addScope(path);
+					view.set(path, "UNIT_TYPE", "OUTLET");
+					view.set(path, "NCOMP", fs.nComp[src]);
+					view.hideScope("return/" + unitScope(sink[src]));
+				}
+
+				filtered.insert(filtered.end(), conn.begin() + r, conn.begin() + r + fs.nCols);
+				filtered[filtered.size() - fs.nCols + 1] = sink[src];
+
+				// Outlet has one port and the same components
+				if (fs.nCols == 7)
+					filtered[filtered.size() - 4] = (conn[r + 2] >= 0.0) ? 0.0 : -1.0;
+				filtered[filtered.size() - 2] = conn[r + fs.nCols - 3];
+			}
+
+			std::ostringstream oss;
+			oss << "model/connections/switch_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << s;
+			view.set(oss.str(), "CONNECTIONS", filtered);
+		}
+
+		view.set("model", "NUNITS", static_cast<int>(nUnits + nSinks));
+
+		// Record results of own unit operations and outlets of unit operations that feed other groups
+		for (unsigned int i = 0; i < nUnits; ++i)
+		{
+			const std::string path = "return/" + unitScope(i);
+			const bool own = std::find(grp.units.begin(), grp.units.end(), i) != grp.units.end();
+			if (!own)
+				view.hideScope(path);
+			else if (feedsOtherGroup(i))
+			{
+				if (!fs.hasReturn[i])
+					view.addScope(path);
+				view.set(path, "WRITE_SOLUTION_OUTLET", true);
+			}
+		}
+	}
+
+	/**
+	 * @brief Calls a function for each connection of all valve switches
+	 * @param [in] fs Flowsheet
+	 * @param [in] f Function receiving source and destination unit operation
+	 */
+	template <typename Func_t>
+	static void forEachConnection(const Flowsheet& fs, Func_t f)
+	{
+		const int nUnits = fs.unitType.size();
+		for (const std::vector<double>& conn : fs.connections)
+		{
+			for (std::size_t r = 0; r < conn.size(); r += fs.nCols)
+			{
+				const int src = static_cast<int>(conn[r]);
+				const int dest = static_cast<int>(conn[r + 1]);
+				if ((src >= 0) && (src < nUnits) && (dest >= 0) && (dest < nUnits))
+					f(src, dest);
+			}
+		}
+	}
+
+	inline bool feedsOtherGroup(UnitOpIdx idx) const
+	{
+		for (const UnitGroup& grp : _groups)
+		{
+			if (std::find(grp.proxies.begin(), grp.proxies.end(), idx) != grp.proxies.end())
+				return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Samples the outlet of a unit operation as computed by its group
+	 * @param [in] idx Index of the unit operation
+	 * @param [in] available Determines whether the group of the unit operation has been integrated
+	 * @param [out] time Sample times
+	 * @param [out] data Samples in time-major ordering
+	 */
+	void sampleOutlet(UnitOpIdx idx, bool available, std::vector<double>& time, std::vector<double>& data) const
+	{
+		cadet::InternalStorageSystemRecorder const* const sol = _groups[_unitGroup[idx]].driver->solution();
+		cadet::InternalStorageUnitOpRecorder const* const rec = sol->unitOperation(idx);
+		if (!available || (rec->numDataPoints() == 0))
+		{
+			// Initial guess is a zero waveform
+			time.assign(1, _startTime);
+			data.assign(rec->numComponents(), 0.0);
+			return;
+		}
+
+		time.assign(sol->time(), sol->time() + sol->numDataPoints());
+		data.assign(rec->outlet(), rec->outlet() + rec->numDataPoints() * rec->numComponents());
+	}
+
+	/**
+	 * @brief Computes the weighted change of all outlet waveforms passed between groups
+	 * @param [in,out] last Outlet waveforms of the previous sweep, updated to the current ones
+	 * @return Maximum weighted change
+	 */
+	double outletChange(std::vector<std::vector<double>>& last) const
+	{
+		double maxChange = 0.0;
+		for (unsigned int i = 0; i < _unitGroup.size(); ++i)
+		{
+			if ((_unitGroup[i] < 0) || !feedsOtherGroup(i))
+				continue;
+
+			cadet::InternalStorageUnitOpRecorder const* const rec = _groups[_unitGroup[i]].driver->solution()->unitOperation(i);
+			double const* const outlet = rec->outlet();
+			const unsigned int n = rec->numDataPoints() * rec->numComponents();
+
+			if (last[i].size() != n)
+				maxChange = std::numeric_limits<double>::infinity();
+			else
+			{
+				for (unsigned int j = 0; j < n; ++j)
+					maxChange = std::max(maxChange, std::abs(outlet[j] - last[i][j]) / (_wrRelTol * std::abs(outlet[j]) + _wrAbsTol));
+			}
+
+			last[i].assign(outlet, outlet + n);
+		}
+		return maxChange;
+	}
+
+	/**
+	 * @brief Moves the results of all groups into the storage of this driver, or back
+	 * @details Outlets that are only recorded for feeding other groups are not written.
+	 */
+	void exchangeResults()
+	{
+		for (UnitGroup& grp : _groups)
+		{
+			for (UnitOpIdx i : grp.units)
+			{
+				if (!_storage->exchangeUnitOperation(*grp.driver->solution(), i))
+					continue;
+
+				if (!feedsOtherGroup(i))
+					continue;
+
+				// Recorder configured by the user is never used for recording
+				cadet::InternalStorageUnitOpRecorder const* const user = _exchanged ? _storage->unitOperation(i) : grp.driver->solution()->unitOperation(i);
+				cadet::InternalStorageUnitOpRecorder* const res = _exchanged ? grp.driver->solution()->unitOperation(i) : _storage->unitOperation(i);
+				res->solutionConfig().storeOutlet = _exchanged || user->solutionConfig().storeOutlet;
+			}
+		}
+
+		_exchanged = !_exchanged;
+		if (_exchanged)
+			_storage->assignTime(*_groups.front().driver->solution());
+	}
+
+	std::vector<UnitGroup> _groups; //!< Groups of unit operations
+	std::vector<std::vector<unsigned int>> _levels; //!< Groups on each level of the dependency graph
+	std::vector<int> _unitGroup; //!< Group of each unit operation (@c -1 for replicated inlets)
+	double _startTime; //!< Beginning of the time domain
+
+	unsigned int _maxSweeps; //!< Maximum number of sweeps
+	double _sweepTol; //!< Tolerance on the weighted change of outlet waveforms
+	double _wrRelTol; //!< Relative tolerance of the time integrator
+	double _wrAbsTol; //!< Smallest absolute tolerance of the time integrator
+	bool _cyclic; //!< Determines whether the flowsheet contains recycles between groups
+	bool _exchanged; //!< Determines whether the results of the groups reside in the storage of this driver
+
+	unsigned int _sweeps; //!< Number of sweeps in the last run
+	double _wrWallTime; //!< Wall time of the last run
+
+private:
+	WaveformRelaxationDriver(const WaveformRelaxationDriver&) = delete;
+};
+
+} // namespace cadet
+
+#endif  // CADET_WAVEFORMRELAXATIONDRIVER_HPP_
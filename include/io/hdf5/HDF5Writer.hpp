@@ -119,6 +119,12 @@ void HDF5Writer::write<double>(const std::string& dataSetName, const size_t rank
 	writeWork(dataSetName, H5T_NATIVE_DOUBLE, H5T_IEEE_F64LE, rank, dims, buffer, stride, blockSize);
 }
 
+template <>
+void HDF5Writer::write<float>(const std::string& dataSetName, const size_t rank, const size_t* dims, const float* buffer, const size_t stride, const size_t blockSize)
+{
+	writeWork(dataSetName, H5T_NATIVE_FLOAT, H5T_IEEE_F32LE, rank, dims, buffer, stride, blockSize);
+}
+
 template <>
 void HDF5Writer::write<int>(const std::string& dataSetName, const size_t rank, const size_t* dims, const int* buffer, const size_t stride, const size_t blockSize)
 {
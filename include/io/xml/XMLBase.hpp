@@ -75,6 +75,10 @@ public:
 	inline bool isDouble(const std::string& elementName) { return isDataType<double>(elementName, _typeDouble); }
 	inline bool isDouble(const char* elementName) { return isDouble(std::string(elementName)); }
 
+	/// \brief Checks if the given dataset is a float
+	inline bool isFloat(const std::string& elementName) { return isDataType<float>(elementName, _typeFloat); }
+	inline bool isFloat(const char* elementName) { return isFloat(std::string(elementName)); }
+
 	/// \brief Checks whether the given element is a group
 	inline bool isGroup(const std::string& elementName);
 	inline bool isGroup(const char* elementName) { return isGroup(std::string(elementName)); }
@@ -119,6 +123,7 @@ protected:
 	static const std::string _typeInt;          //!< Name used for 'type' attributes of type 'int'
 	static const std::string _typeUint64;       //!< Name used for 'type' attributes of type 'uint64_t'
 	static const std::string _typeDouble;       //!< Name used for 'type' attributes of type 'double'
+	static const std::string _typeFloat;        //!< Name used for 'type' attributes of type 'float'
 	static const std::string _typeBool;         //!< Name used for 'type' attributes of type 'bool'
 
 	xpath_node               _groupOpened;      //!< Holds the group that is currently opened
@@ -157,6 +162,7 @@ const std::string XMLBase::_typeChar   = "char";
 const std::string XMLBase::_typeInt    = "int";
 const std::string XMLBase::_typeUint64 = "uint64_t";
 const std::string XMLBase::_typeDouble = "double";
+const std::string XMLBase::_typeFloat  = "float";
 const std::string XMLBase::_typeBool   = "bool";
 
 
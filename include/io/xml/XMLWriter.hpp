@@ -115,6 +115,13 @@ void XMLWriter::write<double>(const std::string& dataSetName, const size_t rank,
 	writeWork<double>(dataSetName, rank, dims, buffer, stride, blockSize);
 }
 
+template <>
+void XMLWriter::write<float>(const std::string& dataSetName, const size_t rank, const size_t* dims, const float* buffer, const size_t stride, const size_t blockSize)
+{
+	_typeName = _typeFloat;
+	writeWork<float>(dataSetName, rank, dims, buffer, stride, blockSize);
+}
+
 template <>
 void XMLWriter::write<int>(const std::string& dataSetName, const size_t rank, const size_t* dims, const int* buffer, const size_t stride, const size_t blockSize)
 {
@@ -25,7 +25,9 @@
 
 #include "common/CompilerSpecific.hpp"
 #include "common/ParameterProviderImpl.hpp"
-#include "common/Driver.hpp"
+#include "common/AsyncLogReceiver.hpp"
+#include "common/LaplaceDriver.hpp"
+#include "common/CheckpointFile.hpp"
 
 #ifdef CADET_BENCHMARK_MODE
 	#include "common/Timer.hpp"
@@ -35,6 +37,7 @@
 #include <iomanip>
 #include <sstream>
 #include <cctype>
+#include <memory>
 
 #ifndef CADET_LOGGING_DISABLE
 	template <>
@@ -159,7 +162,8 @@ class FileReaderDriverConfigurator
 public:
 	FileReaderDriverConfigurator() { }
 
-	void configure(cadet::Driver& drv, const std::string& inFileName)
+	template <typename Driver_t>
+	void configure(Driver_t& drv, const std::string& inFileName)
 	{
 		Reader_t rd;
 		rd.openFile(inFileName, "r");
@@ -176,7 +180,8 @@ class JsonDriverConfigurator
 public:
 	JsonDriverConfigurator() { }
 
-	void configure(cadet::Driver& drv, const std::string& inFileName)
+	template <typename Driver_t>
+	void configure(Driver_t& drv, const std::string& inFileName)
 	{
 		cadet::JsonParameterProvider pp = cadet::JsonParameterProvider::fromFile(inFileName);
 
@@ -189,9 +194,9 @@ public:
 };
 
 template <class DriverConfigurator_t, class Writer_t>
-void run(const std::string& inFileName, const std::string& outFileName, bool showProgressBar)
+void run(const std::string& inFileName, const std::string& outFileName, bool showProgressBar, bool resume)
 {
-	cadet::Driver drv;
+	cadet::LaplaceDriver drv;
 	
 	{
 		DriverConfigurator_t dc;
@@ -206,6 +211,25 @@ void run(const std::string& inFileName, const std::string& outFileName, bool sho
 #endif
 
 	drv.simulator()->setNotificationCallback(pb.get());
+
+	// Checkpoints are always stored in HDF5 files
+	typedef cadet::CheckpointFile<cadet::io::HDF5Reader, cadet::io::HDF5Writer> CheckpointFile_t;
+	std::unique_ptr<CheckpointFile_t> checkpoint = nullptr;
+	if (drv.checkpointsConfigured() || resume)
+	{
+		const std::string cpFileName = drv.checkpointFile().empty() ? outFileName + ".checkpoint.h5" : drv.checkpointFile();
+		checkpoint = std::make_unique<CheckpointFile_t>(cpFileName, *drv.solution());
+		drv.setCheckpointHandler(checkpoint.get());
+
+		if (resume)
+		{
+			if (checkpoint->load())
+				drv.resumeFrom(checkpoint->simulatorState());
+			else
+				LOG(Warning) << "Checkpoint file " << cpFileName << " not found, starting from the beginning";
+		}
+	}
+
 	drv.run();
 
 	Writer_t writer;
@@ -217,6 +241,10 @@ void run(const std::string& inFileName, const std::string& outFileName, bool sho
 	drv.write(writer);
 	writer.closeFile();
 
+	// Simulation has finished, so the checkpoint is obsolete
+	if (checkpoint)
+		checkpoint->remove();
+
 #ifdef CADET_BENCHMARK_MODE
 	// Write timings in JSON format
 
@@ -265,6 +293,8 @@ int main(int argc, char** argv)
 	std::string outFileName = "";
 	cadet::LogLevel logLevel = cadet::LogLevel::Trace;
 	bool showProgressBar = false;
+	bool asyncLog = false;
+	bool resume = false;
 
 	try
 	{
@@ -274,6 +304,8 @@ int main(int argc, char** argv)
 
 		cmd >> (new TCLAP::SwitchArg("", "progress", "Show a progress bar"))->storeIn(&showProgressBar);
 		cmd >> (new TCLAP::ValueArg<cadet::LogLevel>("L", "loglevel", "Set the log level", false, cadet::LogLevel::Trace, "LogLevel"))->storeIn(&logLevel);
+		cmd >> (new TCLAP::SwitchArg("", "async-log", "Write log messages from a background thread"))->storeIn(&asyncLog);
+		cmd >> (new TCLAP::SwitchArg("", "resume", "Resume from the checkpoint file if it exists"))->storeIn(&resume);
 		cmd >> (new TCLAP::UnlabeledValueArg<std::string>("input", "Input file", true, "", "File"))->storeIn(&inFileName);
 		cmd >> (new TCLAP::UnlabeledValueArg<std::string>("output", "Output file (defaults to input file)", false, "", "File"))->storeIn(&outFileName);
 
@@ -293,7 +325,14 @@ int main(int argc, char** argv)
 
 	// Set LogLevel in library and locally
 	LogReceiver lr;
-	cadetSetLogReceiver(&lr);
+	std::unique_ptr<cadet::AsyncLogReceiver> alr;
+	if (asyncLog)
+	{
+		alr.reset(new cadet::AsyncLogReceiver(lr));
+		cadetSetLogReceiver(alr.get());
+	}
+	else
+		cadetSetLogReceiver(&lr);
 	cadetSetLogLevel(static_cast<typename std::underlying_type<cadet::LogLevel>::type>(logLevel));
 	setLocalLogLevel(logLevel);
 
@@ -321,11 +360,11 @@ int main(int argc, char** argv)
 		{
 			if (cadet::util::caseInsensitiveEquals(fileExtOut, "h5"))
 			{
-				run<FileReaderDriverConfigurator<cadet::io::HDF5Reader>, cadet::io::HDF5Writer>(inFileName, outFileName, showProgressBar);
+				run<FileReaderDriverConfigurator<cadet::io::HDF5Reader>, cadet::io::HDF5Writer>(inFileName, outFileName, showProgressBar, resume);
 			}
 			else if (cadet::util::caseInsensitiveEquals(fileExtOut, "xml"))
 			{
-				run<FileReaderDriverConfigurator<cadet::io::HDF5Reader>, cadet::io::XMLWriter>(inFileName, outFileName, showProgressBar);
+				run<FileReaderDriverConfigurator<cadet::io::HDF5Reader>, cadet::io::XMLWriter>(inFileName, outFileName, showProgressBar, resume);
 			}
 			else
 			{
@@ -337,11 +376,11 @@ int main(int argc, char** argv)
 		{
 			if (cadet::util::caseInsensitiveEquals(fileExtOut, "xml"))
 			{
-				run<FileReaderDriverConfigurator<cadet::io::XMLReader>, cadet::io::XMLWriter>(inFileName, outFileName, showProgressBar);
+				run<FileReaderDriverConfigurator<cadet::io::XMLReader>, cadet::io::XMLWriter>(inFileName, outFileName, showProgressBar, resume);
 			}
 			else if (cadet::util::caseInsensitiveEquals(fileExtOut, "h5"))
 			{
-				run<FileReaderDriverConfigurator<cadet::io::XMLReader>, cadet::io::HDF5Writer>(inFileName, outFileName, showProgressBar);
+				run<FileReaderDriverConfigurator<cadet::io::XMLReader>, cadet::io::HDF5Writer>(inFileName, outFileName, showProgressBar, resume);
 			}
 			else
 			{
@@ -353,11 +392,11 @@ int main(int argc, char** argv)
 		{
 			if (cadet::util::caseInsensitiveEquals(fileExtOut, "xml"))
 			{
-				run<JsonDriverConfigurator, cadet::io::XMLWriter>(inFileName, outFileName, showProgressBar);
+				run<JsonDriverConfigurator, cadet::io::XMLWriter>(inFileName, outFileName, showProgressBar, resume);
 			}
 			else if (cadet::util::caseInsensitiveEquals(fileExtOut, "h5"))
 			{
-				run<JsonDriverConfigurator, cadet::io::HDF5Writer>(inFileName, outFileName, showProgressBar);
+				run<JsonDriverConfigurator, cadet::io::HDF5Writer>(inFileName, outFileName, showProgressBar, resume);
 			}
 			else
 			{
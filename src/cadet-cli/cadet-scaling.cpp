@@ -0,0 +1,293 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "cadet/cadet.hpp"
+#include "io/hdf5/HDF5Reader.hpp"
+#include "common/JsonParameterProvider.hpp"
+
+#include <tclap/CmdLine.h>
+#include "common/TclapUtils.hpp"
+
+#include "Logging.hpp"
+
+#include "common/CompilerSpecific.hpp"
+#include "common/ParameterProviderImpl.hpp"
+#include "common/Driver.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#ifndef CADET_LOGGING_DISABLE
+	template <>
+	cadet::LogLevel cadet::log::RuntimeFilteringLogger<cadet::log::GlobalLogger>::_minLvl = cadet::LogLevel::Warning;
+
+	#ifdef __clang__
+		// Silence -Wundefined-var-template warning
+		template class cadet::log::RuntimeFilteringLogger<cadet::log::GlobalLogger>;
+	#endif
+#endif
+
+namespace
+{
+	class LogReceiver : public cadet::ILogReceiver
+	{
+	public:
+		LogReceiver() { }
+
+		virtual void message(const char* file, const char* func, const unsigned int line, cadet::LogLevel lvl, const char* lvlStr, const char* message)
+		{
+			std::cerr << '[' << lvlStr << ": " << func << "::" << line << "] " << message << std::flush;
+		}
+	};
+
+	/**
+	 * @brief Result of a single benchmark run
+	 */
+	struct RunResult
+	{
+		std::string fileName; //!< Input file
+		std::string integrator; //!< Time integrator (empty if given by input file)
+		unsigned int nDof; //!< Number of degrees of freedom
+		unsigned int nThreads; //!< Number of threads
+		double wallTime; //!< Minimum wall time of time integration over all repetitions in seconds
+		cadet::IntegratorStatistics stats; //!< Statistics of the time integrator
+		double speedup; //!< Speedup with respect to the reference run
+		double efficiency; //!< Parallel efficiency with respect to the reference run
+	};
+
+	/**
+	 * @brief Configures a driver from an HDF5 or JSON file
+	 * @param [in] drv Driver
+	 * @param [in] fileName Input file
+	 */
+	void configureDriver(cadet::Driver& drv, const std::string& fileName)
+	{
+		const std::size_t dotPos = fileName.find_last_of('.');
+		const std::string fileExt = (dotPos == std::string::npos) ? std::string() : fileName.substr(dotPos + 1);
+
+		if (cadet::util::caseInsensitiveEquals(fileExt, "h5"))
+		{
+			cadet::io::HDF5Reader rd;
+			rd.openFile(fileName, "r");
+
+			cadet::ParameterProviderImpl<cadet::io::HDF5Reader> pp(rd);
+			drv.configure(pp);
+
+			rd.closeFile();
+		}
+		else if (cadet::util::caseInsensitiveEquals(fileExt, "json"))
+		{
+			cadet::JsonParameterProvider pp = cadet::JsonParameterProvider::fromFile(fileName);
+			if (pp.exists("input"))
+				pp.pushScope("input");
+
+			drv.configure(pp);
+		}
+		else
+			throw std::invalid_argument("Input file format ('." + fileExt + "') not supported");
+	}
+
+	/**
+	 * @brief Converts a string to a TimeIntegrator
+	 * @param [in] ti Time integrator as string
+	 * @return TimeIntegrator corresponding to the given string
+	 */
+	cadet::TimeIntegrator toTimeIntegrator(const std::string& ti)
+	{
+		if (cadet::util::caseInsensitiveEquals(ti, "IDAS"))
+			return cadet::TimeIntegrator::IDAS;
+		else if (cadet::util::caseInsensitiveEquals(ti, "RADAU_IIA"))
+			return cadet::TimeIntegrator::RadauIIA;
+
+		throw std::invalid_argument("Unknown time integrator " + ti);
+	}
+
+	/**
+	 * @brief Simulates a problem with the given number of threads
+	 * @param [in] fileName Input file
+	 * @param [in] integrator Time integrator (empty string uses the time integrator of the input file)
+	 * @param [in] nThreads Number of threads
+	 * @param [in] nRepeat Number of repetitions
+	 * @return Result of the runs
+	 */
+	RunResult runBenchmark(const std::string& fileName, const std::string& integrator, unsigned int nThreads, unsigned int nRepeat)
+	{
+		cadet::Driver drv;
+		configureDriver(drv, fileName);
+
+		// Thread count and time integrator of the input file are overridden
+		drv.simulator()->setNumThreads(nThreads);
+		if (!integrator.empty())
+			drv.simulator()->setTimeIntegrator(toTimeIntegrator(integrator));
+
+		RunResult result{fileName, integrator, drv.simulator()->numDofs(), nThreads, std::numeric_limits<double>::infinity(), cadet::IntegratorStatistics{0ul, 0ul, 0ul, 0ul, 0ul, 0ul}, 1.0, 1.0};
+		for (unsigned int i = 0; i < nRepeat; ++i)
+		{
+			drv.clearResults();
+			drv.run();
+
+			const double wallTime = drv.simulator()->lastSimulationDuration();
+			if (wallTime < result.wallTime)
+			{
+				result.wallTime = wallTime;
+				result.stats = drv.simulator()->getIntegratorStatistics();
+			}
+		}
+
+		std::cerr << fileName << (integrator.empty() ? "" : " (" + integrator + ")") << " with " << nThreads << " threads: " << result.wallTime << " sec" << std::endl;
+		return result;
+	}
+
+	void writeReport(std::ostream& os, const std::vector<RunResult>& results, bool weak)
+	{
+		os << "mode,file,integrator,ndof,threads,wall_time,speedup,efficiency,steps,res_evals,linear_solves,linear_iter,conv_fails,err_test_fails\n";
+		os << std::setprecision(std::numeric_limits<double>::digits10 + 1);
+		for (const RunResult& r : results)
+		{
+			os << (weak ? "weak" : "strong") << ',' << r.fileName << ',' << r.integrator << ',' << r.nDof << ',' << r.nThreads << ','
+				<< r.wallTime << ',' << r.speedup << ',' << r.efficiency << ','
+				<< r.stats.nSteps << ',' << r.stats.nResEvals << ',' << r.stats.nLinearSolves << ',' << r.stats.nLinearIter << ','
+				<< r.stats.nConvFails << ',' << r.stats.nErrTestFails << '\n';
+		}
+		os << std::flush;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> inFileNames;
+	std::vector<unsigned int> threads;
+	std::vector<std::string> integrators;
+	std::string reportFileName = "";
+	unsigned int nRepeat = 1;
+	bool weak = false;
+
+	try
+	{
+		TCLAP::CustomOutput customOut("cadet-scaling");
+		TCLAP::CmdLine cmd("Measures strong and weak scaling of CADET simulations across thread counts", ' ', "1.0");
+		cmd.setOutput(&customOut);
+
+		cmd >> (new TCLAP::MultiArg<unsigned int>("j", "threads", "Number of threads (can be given multiple times, default: powers of 2 up to the number of cores)", false, "Value"))->storeIn(&threads);
+		cmd >> (new TCLAP::ValueArg<unsigned int>("r", "repeat", "Number of repetitions, the fastest run is reported (default: 1)", false, 1, "Value"))->storeIn(&nRepeat);
+		cmd >> (new TCLAP::MultiArg<std::string>("t", "integrator", "Time integrator IDAS or RADAU_IIA (can be given multiple times for comparison, default: as in input file)", false, "Value"))->storeIn(&integrators);
+		cmd >> (new TCLAP::SwitchArg("", "weak", "Weak scaling: the i-th input file is simulated with the i-th thread count"))->storeIn(&weak);
+		cmd >> (new TCLAP::ValueArg<std::string>("o", "report", "Write CSV report to file (default: standard output)", false, "", "File"))->storeIn(&reportFileName);
+		cmd >> (new TCLAP::UnlabeledMultiArg<std::string>("input", "Input files", true, "File"))->storeIn(&inFileNames);
+
+		cmd.parse(argc, argv);
+	}
+	catch (const TCLAP::ArgException &e)
+	{
+		std::cerr << "ERROR: " << e.error() << " for argument " << e.argId() << std::endl;
+		return 1;
+	}
+
+	if (threads.empty())
+	{
+		const unsigned int maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		for (unsigned int t = 1; t < maxThreads; t *= 2)
+			threads.push_back(t);
+		threads.push_back(maxThreads);
+	}
+
+	if (std::find(threads.begin(), threads.end(), 0u) != threads.end())
+	{
+		std::cerr << "ERROR: Thread counts have to be positive" << std::endl;
+		return 1;
+	}
+
+	if (weak && (inFileNames.size() != threads.size()))
+	{
+		std::cerr << "ERROR: Weak scaling requires as many input files (" << inFileNames.size() << ") as thread counts (" << threads.size() << ")" << std::endl;
+		return 1;
+	}
+
+	nRepeat = std::max(nRepeat, 1u);
+
+	// Empty string keeps the time integrator of the input file
+	if (integrators.empty())
+		integrators.push_back("");
+
+	LogReceiver lr;
+	cadetSetLogReceiver(&lr);
+	cadetSetLogLevel(static_cast<typename std::underlying_type<cadet::LogLevel>::type>(cadet::LogLevel::Warning));
+
+	std::vector<RunResult> results;
+	try
+	{
+		if (weak)
+		{
+			// Problem size grows with the number of threads, ideally the wall time stays constant
+			for (const std::string& integrator : integrators)
+			{
+				const std::size_t ref = results.size();
+				for (std::size_t i = 0; i < inFileNames.size(); ++i)
+				{
+					RunResult r = runBenchmark(inFileNames[i], integrator, threads[i], nRepeat);
+					r.efficiency = (results.size() > ref) ? results[ref].wallTime / r.wallTime : 1.0;
+					r.speedup = r.efficiency * static_cast<double>(r.nThreads) / static_cast<double>(threads.front());
+					results.push_back(r);
+				}
+			}
+		}
+		else
+		{
+			// Fixed problem size, speedup is relative to the first thread count
+			for (const std::string& fileName : inFileNames)
+			{
+				for (const std::string& integrator : integrators)
+				{
+					const std::size_t ref = results.size();
+					for (unsigned int t : threads)
+					{
+						RunResult r = runBenchmark(fileName, integrator, t, nRepeat);
+						if (results.size() > ref)
+						{
+							r.speedup = results[ref].wallTime / r.wallTime;
+							r.efficiency = r.speedup * static_cast<double>(results[ref].nThreads) / static_cast<double>(t);
+						}
+						results.push_back(r);
+					}
+				}
+			}
+		}
+	}
+	catch (const cadet::IntegrationException& e)
+	{
+		std::cerr << "SOLVER ERROR: " << e.what() << std::endl;
+		return 3;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "ERROR: " << e.what() << std::endl;
+		return 1;
+	}
+
+	if (reportFileName.empty())
+		writeReport(std::cout, results, weak);
+	else
+	{
+		std::ofstream fs(reportFileName);
+		writeReport(fs, results, weak);
+	}
+
+	return 0;
+}
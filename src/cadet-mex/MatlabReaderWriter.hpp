@@ -530,6 +530,22 @@ void MatlabReaderWriter::write<double>(const std::string& dataSetName, const siz
 	}
 }
 
+template <>
+void MatlabReaderWriter::write<float>(const std::string& dataSetName, const size_t rank, const size_t* dims, const float* buffer, const size_t stride, const size_t blockSize)
+{
+	mxArray* matData = createStructField(dataSetName, rank, dims, buffer, stride, mxSINGLE_CLASS);
+
+	size_t numEl = mxGetNumberOfElements(matData);
+	float* data = static_cast<float*>(mxGetData(matData));
+
+	// Write data to matlab
+	for (size_t i = 0; i < numEl / blockSize; ++i)
+	{
+		for (size_t j = 0; j < blockSize; ++j, ++data)
+			*data = buffer[i * stride + j];
+	}
+}
+
 template <>
 void MatlabReaderWriter::write<int>(const std::string& dataSetName, const size_t rank, const size_t* dims, const int* buffer, const size_t stride, const size_t blockSize)
 {
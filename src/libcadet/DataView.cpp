@@ -0,0 +1,77 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "cadet/DataView.hpp"
+#include "cadet/Simulator.hpp"
+
+#include <vector>
+
+namespace
+{
+	inline int makeStateView(double const* data, unsigned int len, cadet::DataView* view)
+	{
+		const std::size_t shape = len;
+		*view = cadet::makeContiguousView(data, cadet::DataViewType::Double, &shape, 1);
+		return 0;
+	}
+
+	inline int makeSensitivityView(const std::vector<double const*>& data, unsigned int len, unsigned int sensIdx, cadet::DataView* view)
+	{
+		if (sensIdx >= data.size())
+			return -2;
+
+		return makeStateView(data[sensIdx], len, view);
+	}
+}
+
+extern "C"
+{
+	int cadetGetLastStateView(cadet::ISimulator const* sim, cadet::DataView* view)
+	{
+		if (!sim || !view)
+			return -1;
+
+		unsigned int len = 0;
+		double const* const data = sim->getLastSolution(len);
+		return makeStateView(data, len, view);
+	}
+
+	int cadetGetLastStateDerivativeView(cadet::ISimulator const* sim, cadet::DataView* view)
+	{
+		if (!sim || !view)
+			return -1;
+
+		unsigned int len = 0;
+		double const* const data = sim->getLastSolutionDerivative(len);
+		return makeStateView(data, len, view);
+	}
+
+	int cadetGetLastSensitivityView(cadet::ISimulator const* sim, unsigned int sensIdx, cadet::DataView* view)
+	{
+		if (!sim || !view)
+			return -1;
+
+		unsigned int len = 0;
+		const std::vector<double const*> data = sim->getLastSensitivities(len);
+		return makeSensitivityView(data, len, sensIdx, view);
+	}
+
+	int cadetGetLastSensitivityDerivativeView(cadet::ISimulator const* sim, unsigned int sensIdx, cadet::DataView* view)
+	{
+		if (!sim || !view)
+			return -1;
+
+		unsigned int len = 0;
+		const std::vector<double const*> data = sim->getLastSensitivityDerivatives(len);
+		return makeSensitivityView(data, len, sensIdx, view);
+	}
+}
@@ -76,6 +76,24 @@ namespace log
 	typedef Logger<GlobalLogger, LogLevel::None> DiscardingLogger;
 #endif
 
+	/**
+	 * @brief Determines whether log statements of the given level are passed on to the receiver
+	 * @details The compile time part of the check is a constant expression. Hence, code guarded
+	 *          by this function is removed in builds that filter out the log level at compile time.
+	 *          This is useful for expensive computations that only feed log statements.
+	 * @tparam lvl LogLevel to check
+	 * @return @c true if log statements of the given level are emitted, otherwise @c false
+	 */
+	template <LogLevel lvl>
+	inline bool isActive() CADET_NOEXCEPT
+	{
+#ifndef CADET_LOGGING_DISABLE
+		return (LogLevel::CADET_LOGLEVEL_MIN >= lvl) && (lvl <= RuntimeFilteringLogger<GlobalLogger>::level());
+#else
+		return false;
+#endif
+	}
+
 } // namespace log
 } // namespace cadet
 
@@ -101,4 +119,11 @@ namespace log
 
 #endif
 
+/**
+ * @brief Checks whether log statements of the given level are emitted
+ * @details Guards computations that only feed log statements:
+ *          <pre>if (LOG_ACTIVE(Debug)) { ... }</pre>
+ */
+#define LOG_ACTIVE(lvl) cadet::log::isActive<cadet::LogLevel::lvl>()
+
 #endif  // LIBCADET_LOGGING_IMPL_HPP_
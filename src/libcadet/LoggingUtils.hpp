@@ -25,6 +25,8 @@
 	#include <ostream>
 #endif
 
+#include <utility>
+
 namespace cadet
 {
 namespace log
@@ -58,6 +60,30 @@ namespace log
 		MatrixPtr(T const* d, unsigned int nr, unsigned int nc, bool cm) : data(d), nRows(nr), nCols(nc), colMajor(cm) { }
 	};
 
+	/**
+	 * @brief Container for lazily evaluated log arguments
+	 * @details The wrapped function is only called when the log message is actually formatted,
+	 *          that is, if the statement passes both compile time and runtime filtering.
+	 *          Use lazy() to create objects of this type.
+	 * @tparam Func_t Type of a callable without arguments whose result is written to the log
+	 */
+	template <class Func_t>
+	struct Lazy
+	{
+		Func_t func;
+
+		Lazy(Func_t f) : func(std::move(f)) { }
+	};
+
+	/**
+	 * @brief Wraps an expensive log argument such that it is only evaluated if the log level is active
+	 * @details Usage: <pre>LOG(Debug) << "Norm: " << log::lazy([&]() { return expensiveNorm(); });</pre>
+	 * @param [in] f Callable without arguments that computes the log argument
+	 * @return Lazy log argument
+	 */
+	template <class Func_t>
+	inline Lazy<Func_t> lazy(Func_t f) { return Lazy<Func_t>(std::move(f)); }
+
 #ifndef CADET_LOGGING_DISABLE
 /*
 	inline std::ostream& operator<<(std::ostream& os, const cadet::ISolutionExporter& v)
@@ -120,6 +146,13 @@ namespace log
 		return os;
 	}
 
+	template <class Func_t>
+	inline std::ostream& operator<<(std::ostream& os, const cadet::log::Lazy<Func_t>& v)
+	{
+		os << v.func();
+		return os;
+	}
+
 	template <class T>
 	inline std::ostream& operator<<(std::ostream& os, const cadet::log::MatrixPtr<T>& v)
 	{
@@ -34,6 +34,7 @@ namespace cadet
 		void registerLumpedRateModelWithPores(std::unordered_map<std::string, std::function<IUnitOperation*(UnitOpIdx)>>& models);
 		void registerLumpedRateModelWithoutPores(std::unordered_map<std::string, std::function<IUnitOperation*(UnitOpIdx)>>& models);
 		void registerCSTRModel(std::unordered_map<std::string, std::function<IUnitOperation*(UnitOpIdx)>>& models);
+		void registerCSTRArrayModel(std::unordered_map<std::string, std::function<IUnitOperation*(UnitOpIdx)>>& models);
 #ifdef ENABLE_GRM_2D
 		void registerGeneralRateModel2D(std::unordered_map<std::string, std::function<IUnitOperation*(UnitOpIdx)>>& models);
 #endif
@@ -41,6 +42,7 @@ namespace cadet
 		namespace inlet
 		{
 			void registerPiecewiseCubicPoly(std::unordered_map<std::string, std::function<IInletProfile*()>>& inlets);
+			void registerWaveform(std::unordered_map<std::string, std::function<IInletProfile*()>>& inlets);
 		} // namespace inlet
 
 		namespace extfun
@@ -59,6 +61,7 @@ namespace cadet
 		model::registerLumpedRateModelWithPores(_modelCreators);
 		model::registerLumpedRateModelWithoutPores(_modelCreators);
 		model::registerCSTRModel(_modelCreators);
+		model::registerCSTRArrayModel(_modelCreators);
 
 #ifdef ENABLE_GRM_2D
 		model::registerGeneralRateModel2D(_modelCreators);
@@ -66,6 +69,7 @@ namespace cadet
 
 		// Register all available inlet profiles
 		model::inlet::registerPiecewiseCubicPoly(_inletCreators);
+		model::inlet::registerWaveform(_inletCreators);
 
 		// Register all available external functions
 		model::extfun::registerLinearInterpolation(_extFunCreators);
@@ -22,13 +22,15 @@
 #include "common/CompilerSpecific.hpp"
 #include "Memory.hpp"
 
+#include <vector>
+#include <algorithm>
+
 #ifdef CADET_PARALLELIZE
 	#define CADET_PARFOR_END )
 	#define CADET_PARNODE_END )
 	#define CADET_PAR_CONTINUE return
 
 	#include "tbb/task_arena.h"
-	#include <vector>
 
 	namespace cadet
 	{
@@ -71,8 +73,7 @@
 				if (numThreads < _data.size())
 				{
 					// Remove superfluous buffers at the end
-					for (unsigned int i = 0; i < numThreads - _data.size(); ++i)
-						_data.pop_back();
+					_data.resize(numThreads);
 				}
 				else if (numThreads > _data.size())
 				{
@@ -243,4 +244,84 @@
 
 #endif
 
+namespace cadet
+{
+namespace util
+{
+
+	/**
+	 * @brief Distributes a number of threads among tasks proportional to their weights
+	 * @details Each task receives at least one thread, hence the total budget exceeds
+	 *          @p numThreads if there are more tasks than threads. Otherwise, the threads
+	 *          are assigned by the largest remainder method, which distributes exactly
+	 *          @p numThreads threads. Non-positive weights are treated as uniform weights.
+	 * @param [in] weights Weight (e.g., estimated cost) of each task
+	 * @param [in] numThreads Total number of available threads
+	 * @return Number of threads assigned to each task
+	 */
+	inline std::vector<unsigned int> distributeThreads(const std::vector<double>& weights, unsigned int numThreads)
+	{
+		std::vector<unsigned int> budget(weights.size(), 1u);
+		if (numThreads <= weights.size())
+			return budget;
+
+		double totalWeight = 0.0;
+		for (double w : weights)
+			totalWeight += std::max(w, 0.0);
+
+		std::vector<double> ideal(weights.size(), static_cast<double>(numThreads) / static_cast<double>(weights.size()));
+		if (totalWeight > 0.0)
+		{
+			for (unsigned int i = 0; i < weights.size(); ++i)
+				ideal[i] = static_cast<double>(numThreads) * std::max(weights[i], 0.0) / totalWeight;
+		}
+
+		unsigned int assigned = 0;
+		for (unsigned int i = 0; i < weights.size(); ++i)
+		{
+			budget[i] = std::max(1u, static_cast<unsigned int>(ideal[i]));
+			assigned += budget[i];
+		}
+
+		// Enforcing the minimum of one thread per task may have overcommitted threads,
+		// take them from the tasks that received the most surplus
+		while (assigned > numThreads)
+		{
+			unsigned int idx = 0;
+			double maxSurplus = -1.0;
+			for (unsigned int i = 0; i < budget.size(); ++i)
+			{
+				if ((budget[i] > 1) && (budget[i] - ideal[i] > maxSurplus))
+				{
+					maxSurplus = budget[i] - ideal[i];
+					idx = i;
+				}
+			}
+			--budget[idx];
+			--assigned;
+		}
+
+		// Hand out remaining threads to the tasks with the largest remainder
+		while (assigned < numThreads)
+		{
+			unsigned int idx = 0;
+			double maxRemainder = -static_cast<double>(numThreads);
+			for (unsigned int i = 0; i < budget.size(); ++i)
+			{
+				if (ideal[i] - budget[i] > maxRemainder)
+				{
+					maxRemainder = ideal[i] - budget[i];
+					idx = i;
+				}
+			}
+			++budget[idx];
+			++assigned;
+		}
+
+		return budget;
+	}
+
+} // namespace util
+} // namespace cadet
+
 #endif  // LIBCADET_PARALLEL_SUPPORT_HPP_
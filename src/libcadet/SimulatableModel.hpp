@@ -19,6 +19,7 @@
 #define LIBCADET_SIMULATABLEMODEL_HPP_
 
 #include <vector>
+#include <limits>
 
 #include "cadet/Model.hpp"
 #include "AutoDiff.hpp"
@@ -37,6 +38,11 @@ struct SimulationTime;
 struct SimulationState;
 struct ConstSimulationState;
 
+/**
+ * @brief Offset returned by ISimulatableModel::unitOperationDofOffset() for unknown unit operations
+ */
+const unsigned int InvalidDofOffset = std::numeric_limits<unsigned int>::max();
+
 /**
  * @brief Defines a model that can be simulated
  */
@@ -61,6 +67,13 @@ public:
 	 */
 	virtual unsigned int numPureDofs() const CADET_NOEXCEPT = 0;
 
+	/**
+	 * @brief Returns the offset of a unit operation's local state vector in the global state vector
+	 * @param [in] unitOpIdx Index of the unit operation
+	 * @return Offset of the first DOF of the unit operation or InvalidDofOffset if the unit operation does not exist
+	 */
+	virtual unsigned int unitOperationDofOffset(UnitOpIdx unitOpIdx) const CADET_NOEXCEPT = 0;
+
 	/**
 	 * @brief Returns whether AD is used for computing the system Jacobian
 	 * @details This is independent of any parameter sensitivity.
@@ -155,6 +168,23 @@ public:
 	 */
 	virtual void setSensitiveParameterValue(const ParameterId& id, double value) = 0;
 
+	/**
+	 * @brief Resolves the storage of a parameter
+	 * @details Appends the addresses of all values that are set by setParameter() to @p storage, including
+	 *          all multiplexed copies of the parameter. Writing a value to each address is then equivalent to
+	 *          calling setParameter(), which allows to skip the parameter lookup on repeated updates.
+	 *          
+	 *          Some parameters cannot be written directly since changing them requires further updates of
+	 *          the model (e.g., of derived quantities or caches). In this case, @c false is returned
+	 *          and the contents of @p storage are undefined. Such parameters have to be set by setParameter().
+	 *          
+	 *          The addresses are invalidated when the model is (re)configured.
+	 * @param [in] pId Parameter ID
+	 * @param [in,out] storage Vector the addresses of the parameter values are appended to
+	 * @return @c true if the parameter can be written directly, otherwise @c false
+	 */
+	virtual bool resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage) = 0;
+
 	/**
 	 * @brief Clears all sensitive parameters
 	 */
@@ -395,6 +425,36 @@ public:
 	virtual int linearSolve(double t, double alpha, double tol, double* const rhs, double const* const weight,
 		const ConstSimulationState& simState) = 0;
 
+	/**
+	 * @brief Multiplies the time derivative Jacobian @f$ \frac{\partial F}{\partial \dot{y}}(t, y, \dot{y}) @f$ with a given vector
+	 * @details The residual is linear in @f$ \dot{y} @f$, so the time derivative Jacobian does not depend
+	 *          on the state. The operation @f$ z = \frac{\partial F}{\partial \dot{y}} x @f$ is performed.
+	 *
+	 * @param [in] simTime Simulation time information (time point, section index, pre-factor of time derivatives)
+	 * @param [in] simState State of the simulation (state vector and its time derivative)
+	 * @param [in] yS Vector @f$ x @f$ that is transformed by the Jacobian @f$ \frac{\partial F}{\partial \dot{y}} @f$
+	 * @param [out] ret Vector @f$ z @f$ which stores the result of the operation
+	 */
+	virtual void multiplyWithDerivativeJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, double const* yS, double* ret) = 0;
+
+	/**
+	 * @brief Selects the meaning of the tolerance passed to linearSolve()
+	 * @details By default, the tolerance @c tol passed to linearSolve() is the tolerance of the outer
+	 *          Newton iteration, which is scaled by a safety factor before it is used by iterative
+	 *          linear solvers. If adaptive tolerances are enabled, @c tol is a forcing term @f$ \eta @f$
+	 *          and iterative linear solvers reduce their residual relative to their right hand side by
+	 *          this factor.
+	 *
+	 * @param [in] adaptive Determines whether the tolerance passed to linearSolve() is a forcing term
+	 */
+	virtual void setAdaptiveLinearSolverTolerance(bool adaptive) CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Returns the total number of iterations of iterative linear solvers in linearSolve()
+	 * @return Number of iterations of iterative linear solvers
+	 */
+	virtual unsigned long numLinearSolverIterations() const CADET_NOEXCEPT = 0;
+
 	/**
 	 * @brief Prepares the AD system vectors by constructing seed vectors
 	 * @details Sets the seed vectors used in AD. Since the AD vector is fully managed by the model,
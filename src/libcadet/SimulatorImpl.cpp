@@ -19,6 +19,7 @@
 #include "UnitOperation.hpp"
 #include "ParamIdUtil.hpp"
 #include "SimulationTypes.hpp"
+#include "common/CompilerSpecific.hpp"
 
 #include <idas/idas.h>
 #include <idas/idas_impl.h>
@@ -26,8 +27,11 @@
 
 #include <vector>
 #include <sstream>
+#include <iomanip>
 #include <algorithm>
 #include <cstdlib>
+#include <cmath>
+#include <memory>
 
 #include "AutoDiff.hpp"
 #include "LoggingUtils.hpp"
@@ -42,6 +46,21 @@
 
 namespace
 {
+	/**
+	 * @brief Version of the checkpoint layout written by Simulator::writeCheckpoint()
+	 */
+	const int checkpointFormatVersion = 2;
+
+	/**
+	 * @brief Version of SUNDIALS whose internal IDAS state is stored in checkpoints
+	 * @details The internal IDAS data structures may change between SUNDIALS versions.
+	 */
+#ifdef CADET_SUNDIALS_VERSION
+	const int checkpointSundialsVersion = CADET_SUNDIALS_VERSION;
+#else
+	const int checkpointSundialsVersion = 0;
+#endif
+
 	template <class T>
 	const std::vector<T> convertNVectorToStdVectorPtrs(N_Vector* vec, unsigned int numVec)
 	{
@@ -154,6 +173,14 @@ namespace
 		return hasNaN(NVEC_DATA(p), NVEC_LENGTH(p));
 	}
 
+	inline double weightedRmsNorm(double const* const x, double const* const weight, unsigned int size)
+	{
+		double sum = 0.0;
+		for (unsigned int i = 0; i < size; ++i)
+			sum += (x[i] * weight[i]) * (x[i] * weight[i]);
+		return std::sqrt(sum / size);
+	}
+
 	inline std::string getIDAReturnFlagName(int solverFlag)
 	{
 		char const* const retFlagName = IDAGetReturnFlagName(solverFlag);
@@ -162,6 +189,75 @@ namespace
 
 		return flagName;
 	}
+
+	/**
+	 * @brief Converts a string to an EventType
+	 * @param [in] type Event type as string
+	 * @return EventType corresponding to the given string
+	 */
+	inline cadet::EventType toEventType(const std::string& type)
+	{
+		if (type == "OUTLET_CONCENTRATION")
+			return cadet::EventType::OutletConcentration;
+		else if (type == "OUTLET_PURITY")
+			return cadet::EventType::OutletPurity;
+		else if (type == "UNIT_STATE")
+			return cadet::EventType::UnitState;
+
+		throw cadet::InvalidParameterException("Unknown event type " + type);
+	}
+
+	/**
+	 * @brief Converts a string to an EventAction
+	 * @param [in] action Event action as string
+	 * @return EventAction corresponding to the given string
+	 */
+	inline cadet::EventAction toEventAction(const std::string& action)
+	{
+		if (action == "RECORD")
+			return cadet::EventAction::Record;
+		else if (action == "STOP")
+			return cadet::EventAction::Stop;
+		else if (action == "NEXT_SECTION")
+			return cadet::EventAction::NextSection;
+
+		throw cadet::InvalidParameterException("Unknown event action " + action);
+	}
+
+	/**
+	 * @brief Converts a string to a TimeIntegrator
+	 * @param [in] ti Time integrator as string
+	 * @return TimeIntegrator corresponding to the given string
+	 */
+	inline cadet::TimeIntegrator toTimeIntegrator(const std::string& ti)
+	{
+		if (ti == "IDAS")
+			return cadet::TimeIntegrator::IDAS;
+		else if (ti == "RADAU_IIA")
+			return cadet::TimeIntegrator::RadauIIA;
+
+		throw cadet::InvalidParameterException("Unknown time integrator " + ti);
+	}
+
+	inline std::string getRadauStatusName(cadet::timeint::RadauIIA::Status status)
+	{
+		switch (status)
+		{
+			case cadet::timeint::RadauIIA::Status::Success:
+				return "RADAU_SUCCESS";
+			case cadet::timeint::RadauIIA::Status::TooMuchWork:
+				return "RADAU_TOO_MUCH_WORK";
+			case cadet::timeint::RadauIIA::Status::ErrTestFailure:
+				return "RADAU_ERR_FAIL";
+			case cadet::timeint::RadauIIA::Status::ConvFailure:
+				return "RADAU_CONV_FAIL";
+			case cadet::timeint::RadauIIA::Status::StepSizeTooSmall:
+				return "RADAU_STEP_TOO_SMALL";
+			case cadet::timeint::RadauIIA::Status::SystemFailure:
+				return "RADAU_SYSTEM_FAIL";
+		}
+		return "RADAU_UNKNOWN";
+	}
 }
 
 namespace cadet
@@ -213,10 +309,54 @@ namespace cadet
 
 		LOG(Trace) << "==> Residual at t = " << t << " sec = " << secIdx;
 
+		++sim->_intStats.nResEvals;
+
 		return sim->_model->residualWithJacobian(cadet::SimulationTime{t, secIdx}, cadet::ConstSimulationState{NVEC_DATA(y), NVEC_DATA(yDot)}, NVEC_DATA(res), 
 			cadet::AdJacobianParams{sim->_vecADres, sim->_vecADy, sim->numSensitivityAdDirections()});
 	}
 
+	/**
+	* @brief IDAS wrapper function to evaluate the event functions
+	* @details The i-th event function has a root when the monitored quantity of the i-th
+	*          event crosses its threshold. Purity events are evaluated as @f$ c_i - p \sum_j c_j @f$
+	*          in order to avoid a division by zero when the outlet is empty.
+	*/
+	int eventRootWrapper(double t, N_Vector y, N_Vector yDot, double* gout, void* userData)
+	{
+		cadet::Simulator* const sim = static_cast<cadet::Simulator*>(userData);
+		double const* const localY = NVEC_DATA(y);
+
+		for (unsigned int i = 0; i < sim->_events.size(); ++i)
+		{
+			const cadet::SimulationEvent& evt = sim->_events[i];
+			double const* const val = localY + sim->_eventOffset[i];
+			const unsigned int stride = sim->_eventStride[i];
+
+			if (evt.type == cadet::EventType::UnitState)
+			{
+				gout[i] = val[0] - evt.threshold;
+				continue;
+			}
+
+			if ((evt.type == cadet::EventType::OutletConcentration) && (evt.component >= 0))
+			{
+				gout[i] = val[evt.component * stride] - evt.threshold;
+				continue;
+			}
+
+			double total = 0.0;
+			for (unsigned int comp = 0; comp < sim->_eventNumComp[i]; ++comp)
+				total += val[comp * stride];
+
+			if (evt.type == cadet::EventType::OutletPurity)
+				gout[i] = val[evt.component * stride] - evt.threshold * total;
+			else
+				gout[i] = total - evt.threshold;
+		}
+
+		return 0;
+	}
+
 	/**
 	* @brief Change the error weights in the state vector
 	* @details This sets the error weight to 0 for the network coupling equations, duplicated inlets
@@ -305,7 +445,13 @@ namespace cadet
 		cadet::Simulator* const sim = static_cast<cadet::Simulator*>(IDA_mem->ida_lmem);
 		const double t = IDA_mem->ida_tn;
 		const double alpha = IDA_mem->ida_cj;
-		const double tol = IDA_mem->ida_epsNewt;
+
+		++sim->_intStats.nLinearSolves;
+		if (sim->_recordStepStats)
+			sim->updateStepStatistics(IDA_mem);
+
+		// Either pass the tolerance of the Newton iteration or a forcing term
+		const double tol = sim->_forcingTermActive ? sim->forcingTerm(t, alpha, NVEC_DATA(rhs), NVEC_DATA(weight)) : IDA_mem->ida_epsNewt;
 
 		LOG(Trace) << "==> Solve at t = " << t << " alpha = " << alpha << " tol = " << tol;
 
@@ -337,13 +483,73 @@ namespace cadet
 			sensY, sensYdot, sensRes, sim->_vecADres, NVEC_DATA(tmp1), NVEC_DATA(tmp2), NVEC_DATA(tmp3));
 	}
 
+	/**
+	 * @brief Provides the model to RadauIIA
+	 * @details The Jacobian is evaluated once per step attempt at the beginning of the step.
+	 *          Its point is remembered for subsequent linear solves and matrix-vector products.
+	 */
+	class Simulator::RadauSystem : public timeint::IDaeSystem
+	{
+	public:
+		RadauSystem(Simulator& sim) : _sim(sim), _t(0.0), _y(nullptr), _yDot(nullptr) { }
+
+		virtual int residual(double t, double const* y, double const* yDot, double* res)
+		{
+			const unsigned int secIdx = _sim.getCurrentSection(t);
+
+			LOG(Trace) << "==> Residual at t = " << t << " sec = " << secIdx;
+
+			++_sim._intStats.nResEvals;
+			return _sim._model->residual(SimulationTime{t, secIdx}, ConstSimulationState{y, yDot}, res);
+		}
+
+		virtual int residualWithJacobian(double t, double const* y, double const* yDot, double* res)
+		{
+			const unsigned int secIdx = _sim.getCurrentSection(t);
+
+			LOG(Trace) << "==> Residual and Jacobian at t = " << t << " sec = " << secIdx;
+
+			// RadauIIA keeps the point of the Jacobian unchanged until the next update
+			_t = t;
+			_y = y;
+			_yDot = yDot;
+
+			++_sim._intStats.nResEvals;
+			return _sim._model->residualWithJacobian(SimulationTime{t, secIdx}, ConstSimulationState{y, yDot}, res,
+				AdJacobianParams{_sim._vecADres, _sim._vecADy, _sim.numSensitivityAdDirections()});
+		}
+
+		virtual void multiplyWithDerivativeJacobian(double const* x, double* z)
+		{
+			_sim._model->multiplyWithDerivativeJacobian(SimulationTime{_t, _sim.getCurrentSection(_t)}, ConstSimulationState{_y, _yDot}, x, z);
+		}
+
+		virtual int linearSolve(double alpha, double tol, double* rhs, double const* weight)
+		{
+			LOG(Trace) << "==> Solve at t = " << _t << " alpha = " << alpha << " tol = " << tol;
+
+			++_sim._intStats.nLinearSolves;
+			return _sim._model->linearSolve(_t, alpha, tol, rhs, weight, ConstSimulationState{_y, _yDot});
+		}
+
+	protected:
+		Simulator& _sim; //!< Simulator
+		double _t; //!< Time point of the last Jacobian update
+		double const* _y; //!< State vector of the last Jacobian update
+		double const* _yDot; //!< Time derivative of the state vector of the last Jacobian update
+	};
+
 	Simulator::Simulator() : _model(nullptr), _solRecorder(nullptr), _idaMemBlock(nullptr), _vecStateY(nullptr), 
-		_vecStateYdot(nullptr), _vecFwdYs(nullptr), _vecFwdYsDot(nullptr),
-		_relTolS(1.0e-9), _absTol(1, 1.0e-12), _relTol(1.0e-9), _initStepSize(1, 1.0e-6), _maxSteps(10000), _maxStepSize(0.0),
+		_vecStateYdot(nullptr), _vecFwdYs(nullptr), _vecFwdYsDot(nullptr), _numFwdSensVecs(0), _numIdaSens(0),
+		_paramHandleOffset(0), _relTolS(1.0e-9), _absTol(1, 1.0e-12), _relTol(1.0e-9), _initStepSize(1, 1.0e-6), _maxSteps(10000), _maxStepSize(0.0),
 		_nThreads(0), _sensErrorTestEnabled(true), _maxNewtonIter(3), _maxErrorTestFail(7), _maxConvTestFail(10),
-		_maxNewtonIterSens(3), _curSec(0), _skipConsistencyStateY(false), _skipConsistencySensitivity(false),
+		_maxNewtonIterSens(3), _maxNewtonIterRadau(7), _curSec(0), _secRangeStart(0), _secRangeEnd(0), _skipConsistencyStateY(false), _skipConsistencySensitivity(false),
 		_consistentInitMode(ConsistentInitialization::Full), _consistentInitModeSens(ConsistentInitialization::Full),
-		_vecADres(nullptr), _vecADy(nullptr), _lastIntTime(0.0), _notification(nullptr)
+		_vecADres(nullptr), _vecADy(nullptr), _lastIntTime(0.0), _notification(nullptr), _steadyStateTol(1.0),
+		_checkpoint(nullptr), _checkpointWallTime(0.0), _checkpointSimTime(0.0), _lastCheckpointSimTime(0.0),
+		_adaptiveLinearTol(false), _forcingTermActive(false), _forcingTime(0.0), _forcingAlpha(0.0), _recordStepStats(false),
+		_curStepStats{0.0, 0.0, 0u, 0u, 0u, 0ul}, _curStepIdx(-1), _curStepConvFails(0), _curStepErrTestFails(0), _curStepLinearIter(0),
+		_intStats{0ul, 0ul, 0ul, 0ul, 0ul, 0ul}, _intStatsLinearIter(0), _timeIntegrator(TimeIntegrator::IDAS)
 	{
 #if defined(ACTIVE_ADOLC) || defined(ACTIVE_SFAD) || defined(ACTIVE_SETFAD)
 		LOG(Debug) << "Resetting AD directions from " << ad::getDirections() << " to default " << ad::getMaxDirections();
@@ -360,35 +566,64 @@ namespace cadet
 	{
 		delete[] _vecADy;
 		delete[] _vecADres;
+		_vecADy = nullptr;
+		_vecADres = nullptr;
 
-		if ((_sensitiveParams.slices() > 0) && _vecFwdYs)
+		if ((_numFwdSensVecs > 0) && _vecFwdYs)
 		{
-			NVec_DestroyArray(_vecFwdYs, _sensitiveParams.slices());
-			NVec_DestroyArray(_vecFwdYsDot, _sensitiveParams.slices());
+			NVec_DestroyArray(_vecFwdYs, _numFwdSensVecs);
+			NVec_DestroyArray(_vecFwdYsDot, _numFwdSensVecs);
 		}
+		_vecFwdYs = nullptr;
+		_vecFwdYsDot = nullptr;
+		_numFwdSensVecs = 0;
 		_sensitiveParams.clear();
+		clearParameterHandles();
 		
 		if (_vecStateYdot)
 			NVec_Destroy(_vecStateYdot);
 		if (_vecStateY)
 			NVec_Destroy(_vecStateY);
+		_vecStateY = nullptr;
+		_vecStateYdot = nullptr;
 
 		if (_idaMemBlock)
 			IDAFree(&_idaMemBlock);
+		_idaMemBlock = nullptr;
+		_numIdaSens = 0;
 	}
 
 	void Simulator::initializeModel(IModelSystem& model)
 	{
-		// Clean up
-		clearModel();
-
 		// Require ISimulatableModel descendant
-		_model = reinterpret_cast<ISimulatableModel*>(&model);
+		ISimulatableModel* const newModel = reinterpret_cast<ISimulatableModel*>(&model);
+		const unsigned int nDOFs = newModel->numDofs();
+
+		// Keep IDAS memory, state vectors, and AD vectors alive if the new model has
+		// the same structure as the previous one (e.g., for many short runs)
+		const bool reuseMemory = _idaMemBlock && _vecStateY && (NVEC_LENGTH(_vecStateY) == nDOFs) && (!newModel->usesAD() || _vecADy);
+		if (reuseMemory)
+		{
+			LOG(Debug) << "Reusing time integrator memory for " << nDOFs << " DOFs";
+
+			// Sensitivity vectors are kept and reused by the next initializeFwdSensitivities() call
+			_sensitiveParams.clear();
+			_sensitiveParamsFactor.clear();
+			if (_numIdaSens > 0)
+				IDASensToggleOff(_idaMemBlock);
+		}
+		else
+		{
+			// Clean up
+			clearModel();
+
+			// Allocate state vectors
+			_vecStateY = NVec_New(nDOFs);
+			_vecStateYdot = NVec_New(nDOFs);
+		}
 
-		// Allocate and initialize state vectors
-		const unsigned int nDOFs = _model->numDofs();
-		_vecStateY = NVec_New(nDOFs);
-		_vecStateYdot = NVec_New(nDOFs);
+		_model = newModel;
+		clearParameterHandles();
 
 		// Propagate section times if available
 		if (_sectionTimes.size() > 0)
@@ -412,32 +647,26 @@ namespace cadet
 		NVec_Const(0.0, _vecStateYdot);
 
 		// Create IDAS internal memory
-		_idaMemBlock = IDACreate();
+		if (!reuseMemory)
+		{
+			_idaMemBlock = IDACreate();
 
-		// IDAS Step 4.1: Specify error handler function
-		IDASetErrHandlerFn(_idaMemBlock, &idasErrorHandler, this);
+			// IDAS Step 4.1: Specify error handler function
+			IDASetErrHandlerFn(_idaMemBlock, &idasErrorHandler, this);
+		}
 
 		// IDAS Step 5: Initialize the solver
 		_model->applyInitialCondition(SimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)});
 
 		// Use 0.0 as beginning of simulation time if we haven't set section times yet
-		if (_sectionTimes.size() > 0)
-			IDAInit(_idaMemBlock, &residualDaeWrapper, static_cast<double>(_sectionTimes[0]), _vecStateY, _vecStateYdot);
+		const double tStart = (_sectionTimes.size() > 0) ? static_cast<double>(_sectionTimes[0]) : 0.0;
+		if (reuseMemory)
+			IDAReInit(_idaMemBlock, tStart, _vecStateY, _vecStateYdot);
 		else
-			IDAInit(_idaMemBlock, &residualDaeWrapper, 0.0, _vecStateY, _vecStateYdot);			
+			IDAInit(_idaMemBlock, &residualDaeWrapper, tStart, _vecStateY, _vecStateYdot);
 
-		// IDAS Step 6: Specify integration tolerances (S: scalar; V: array)
-		updateMainErrorTolerances();
-
-		// IDAS Step 7.1: Set optional inputs
-
-		// Set time integrator parameters
-		IDASetMaxNumSteps(_idaMemBlock, _maxSteps);
-		IDASetMaxStep(_idaMemBlock, _maxStepSize);
-		IDASetMaxNonlinIters(_idaMemBlock, _maxNewtonIter);
-		IDASetMaxErrTestFails(_idaMemBlock, _maxErrorTestFail);
-		IDASetMaxConvFails(_idaMemBlock, _maxConvTestFail);
-		IDASetSensMaxNonlinIters(_idaMemBlock, _maxNewtonIterSens);
+		// IDAS Step 6 and 7.1: Specify integration tolerances and set optional inputs
+		applyTimeIntegratorSettings();
 
 		// Specify the linear solver.
 		IDAMem IDA_mem = static_cast<IDAMem>(_idaMemBlock);
@@ -458,7 +687,7 @@ namespace cadet
 		IDASetUserData(_idaMemBlock, this);
 
 		// Allocate memory for AD if required
-		if (_model->usesAD())
+		if (_model->usesAD() && !_vecADy)
 		{
 			_vecADres = new active[nDOFs];
 			_vecADy = new active[nDOFs];
@@ -476,23 +705,7 @@ namespace cadet
 				return;
 
 			N_Vector absTolTemp = NVec_New(_model->numDofs());
-			const unsigned int pureDofs = _model->numPureDofs();
-
-			// Check whether user has given us full absolute error for all (pure) DOFs
-			if (_absTol.size() >= pureDofs)
-			{
-				// Copy error tolerances for pure data
-				std::copy(_absTol.data(), _absTol.data() + pureDofs, NVEC_DATA(absTolTemp));
-
-				// Calculate error tolerances for coupling DOFs and append them
-				const std::vector<double> addAbsErrTol = _model->calculateErrorTolsForAdditionalDofs(_absTol.data(), _absTol.size());
-				std::copy(addAbsErrTol.data(), addAbsErrTol.data() + addAbsErrTol.size(), NVEC_DATA(absTolTemp) + pureDofs);
-			}
-			else
-			{
-				// We've received an expandable error specification
-				_model->expandErrorTol(_absTol.data(), _absTol.size(), NVEC_DATA(absTolTemp));
-			}
+			expandAbsoluteErrorTolerance(NVEC_DATA(absTolTemp));
 
 			IDASVtolerances(_idaMemBlock, _relTol, absTolTemp);
 			NVec_Destroy(absTolTemp);
@@ -501,27 +714,92 @@ namespace cadet
 			IDASStolerances(_idaMemBlock, _relTol, _absTol[0]);
 	}
 
+	void Simulator::expandAbsoluteErrorTolerance(double* const absTol) const
+	{
+		const unsigned int pureDofs = _model->numPureDofs();
+
+		// Check whether user has given us full absolute error for all (pure) DOFs
+		if (_absTol.size() >= pureDofs)
+		{
+			// Copy error tolerances for pure data
+			std::copy(_absTol.data(), _absTol.data() + pureDofs, absTol);
+
+			// Calculate error tolerances for coupling DOFs and append them
+			const std::vector<double> addAbsErrTol = _model->calculateErrorTolsForAdditionalDofs(_absTol.data(), _absTol.size());
+			std::copy(addAbsErrTol.data(), addAbsErrTol.data() + addAbsErrTol.size(), absTol + pureDofs);
+		}
+		else
+		{
+			// We've received an expandable error specification
+			_model->expandErrorTol(_absTol.data(), _absTol.size(), absTol);
+		}
+	}
+
+	void Simulator::applyTimeIntegratorSettings()
+	{
+		if (!_idaMemBlock)
+			return;
+
+		// Specify integration tolerances (S: scalar; V: array)
+		updateMainErrorTolerances();
+
+		// Set time integrator parameters
+		IDASetMaxNumSteps(_idaMemBlock, _maxSteps);
+		IDASetMaxStep(_idaMemBlock, _maxStepSize);
+		IDASetMaxNonlinIters(_idaMemBlock, _maxNewtonIter);
+		IDASetMaxErrTestFails(_idaMemBlock, _maxErrorTestFail);
+		IDASetMaxConvFails(_idaMemBlock, _maxConvTestFail);
+		IDASetSensMaxNonlinIters(_idaMemBlock, _maxNewtonIterSens);
+	}
+
+	void Simulator::applyRadauSettings()
+	{
+		const unsigned int nDof = _model->numDofs();
+		_radau.initialize(nDof);
+
+		if (_absTol.size() > 1)
+		{
+			std::vector<double> absTol(nDof, 0.0);
+			expandAbsoluteErrorTolerance(absTol.data());
+			_radau.setTolerances(_relTol, absTol.data(), true);
+		}
+		else
+			_radau.setTolerances(_relTol, _absTol.data(), false);
+
+		_radau.maxSteps(_maxSteps);
+		_radau.maxStepSize(_maxStepSize);
+		_radau.maxNewtonIter(_maxNewtonIterRadau);
+		_radau.maxErrTestFails(_maxErrorTestFail);
+		_radau.maxConvFails(_maxConvTestFail);
+		_radau.resetCounters();
+	}
+
 	void Simulator::preFwdSensInit(unsigned int nSens)
 	{
-		// Turn off solution of sensitivity systems (this will be overridden by a call to IDASensInit below)
-		// In fact, this has only an effect, if at first a computation with sensitivities is performed and then
-		// (without clearing and reallocating internal memory by cs_free/cs_malloc) another computation without
-		// sensitivities is started.
+		// Turn off solution of sensitivity systems (this will be overridden by a call to IDASensInit
+		// or IDASensReInit below). In fact, this has only an effect, if at first a computation with
+		// sensitivities is performed and then another computation without sensitivities is started.
 		IDASensToggleOff(_idaMemBlock);
 
-		if (_vecFwdYs)
+		// Existing sensitivity state vectors are reused if their number does not change
+		if (_vecFwdYs && (_numFwdSensVecs != nSens))
 		{
-			NVec_DestroyArray(_vecFwdYs, nSens);
-			NVec_DestroyArray(_vecFwdYsDot, nSens);
+			NVec_DestroyArray(_vecFwdYs, _numFwdSensVecs);
+			NVec_DestroyArray(_vecFwdYsDot, _numFwdSensVecs);
 			_vecFwdYs = nullptr;
 			_vecFwdYsDot = nullptr;
+			_numFwdSensVecs = 0;
 		}
 
 		// Allocate sensitivity state vectors
 		if (nSens > 0)
 		{
-			_vecFwdYs     = NVec_CloneArray(nSens, _vecStateY);
-			_vecFwdYsDot  = NVec_CloneArray(nSens, _vecStateYdot);
+			if (!_vecFwdYs)
+			{
+				_vecFwdYs     = NVec_CloneArray(nSens, _vecStateY);
+				_vecFwdYsDot  = NVec_CloneArray(nSens, _vecStateYdot);
+				_numFwdSensVecs = nSens;
+			}
 
 			// Allocate memory for AD if not already done
 			if (!_vecADres)
@@ -531,9 +809,17 @@ namespace cadet
 
 	void Simulator::postFwdSensInit(unsigned int nSens)
 	{
-		// Initialize IDA sensitivity computation
-		// TODO: Use IDASensReInit if this is not the first time sensitivities are activated
-		IDASensInit(_idaMemBlock, nSens, IDA_STAGGERED, &cadet::residualSensWrapper, _vecFwdYs, _vecFwdYsDot);
+		// Initialize IDA sensitivity computation, reuse internal memory if the number of sensitivities is unchanged
+		if (_numIdaSens == nSens)
+			IDASensReInit(_idaMemBlock, IDA_STAGGERED, _vecFwdYs, _vecFwdYsDot);
+		else
+		{
+			if (_numIdaSens > 0)
+				IDASensFree(_idaMemBlock);
+
+			IDASensInit(_idaMemBlock, nSens, IDA_STAGGERED, &cadet::residualSensWrapper, _vecFwdYs, _vecFwdYsDot);
+			_numIdaSens = nSens;
+		}
 
 		// Set sensitivity integration tolerances
 		IDASensSStolerances(_idaMemBlock, _relTolS, _absTolS.data());
@@ -749,6 +1035,7 @@ namespace cadet
 
 		_sensitiveParams.pushBackSlice(ids, numParams);
 		_absTolS.push_back(absTolS);
+		_sensParamHandles.clear();
 		
 		if (diffFactors)
 			_sensitiveParamsFactor.insert(_sensitiveParamsFactor.end(), diffFactors, diffFactors + numParams);
@@ -800,6 +1087,7 @@ namespace cadet
 		_sensitiveParams.clear();
 		_sensitiveParamsFactor.clear();
 		_absTolS.clear();
+		_sensParamHandles.clear();
 
 		_model->clearSensParams();
 		for (unsigned int i = 0; i < _sectionTimes.size(); ++i)
@@ -901,6 +1189,150 @@ namespace cadet
 			_model->setParameter(id, value);
 	}
 
+	bool Simulator::collectParameterStorage(const ParameterId& id, bool sectionTimes, std::vector<active*>& storage)
+	{
+		storage.clear();
+		if (sectionTimes && isSectionTimeParameter(id, _sectionTimes.size()))
+			storage.push_back(&_sectionTimes[id.section]);
+
+		if (!_model)
+			return true;
+
+		const std::size_t nSecTimes = storage.size();
+		const bool direct = _model->resolveParameterStorage(id, storage);
+
+		// Parameter is set by the model, only keep SECTION_TIMES
+		if (!direct)
+			storage.resize(nSecTimes);
+
+		return direct;
+	}
+
+	ParameterHandle Simulator::resolveParameterHandle(const ParameterId& id, bool sectionTimes)
+	{
+		std::unordered_map<ParameterId, ParameterHandle>& lookup = _paramHandleLookup[sectionTimes ? 1 : 0];
+		const std::unordered_map<ParameterId, ParameterHandle>::const_iterator it = lookup.find(id);
+		if (it != lookup.end())
+			return it->second;
+
+		std::vector<active*> storage;
+		const bool direct = collectParameterStorage(id, sectionTimes, storage);
+
+		_paramHandleStorage.pushBackSlice(storage);
+		_paramHandleIds.push_back(id);
+		_paramHandleDirect.push_back(direct);
+		_paramHandleSecTimes.push_back(sectionTimes);
+
+		const ParameterHandle handle = _paramHandleOffset + static_cast<ParameterHandle>(_paramHandleIds.size() - 1);
+		lookup[id] = handle;
+		return handle;
+	}
+
+	void Simulator::rebindParameterHandles()
+	{
+		if (_paramHandleIds.empty())
+			return;
+
+		util::SlicedVector<active*> newStorage;
+		newStorage.reserve(_paramHandleStorage.size(), _paramHandleIds.size());
+
+		std::vector<active*> storage;
+		for (std::size_t i = 0; i < _paramHandleIds.size(); ++i)
+		{
+			_paramHandleDirect[i] = collectParameterStorage(_paramHandleIds[i], _paramHandleSecTimes[i], storage);
+			newStorage.pushBackSlice(storage);
+		}
+
+		_paramHandleStorage = std::move(newStorage);
+	}
+
+	void Simulator::writeParameterHandle(ParameterHandle handle, double value, bool sensitive)
+	{
+		// Handles are part of the public API, check them also in release builds
+		if ((handle < _paramHandleOffset) || (handle - _paramHandleOffset >= _paramHandleIds.size()))
+			throw InvalidParameterException("Invalid or outdated parameter handle " + std::to_string(handle));
+
+		const unsigned int idx = handle - _paramHandleOffset;
+		active** const storage = _paramHandleStorage[idx];
+		for (unsigned int i = 0; i < _paramHandleStorage.sliceSize(idx); ++i)
+			storage[i]->setValue(value);
+
+		if (_paramHandleDirect[idx] || !_model)
+			return;
+
+		if (sensitive)
+			_model->setSensitiveParameterValue(_paramHandleIds[idx], value);
+		else
+			_model->setParameter(_paramHandleIds[idx], value);
+	}
+
+	bool Simulator::resolveParameterHandles(ParameterId const* ids, unsigned int numParams, ParameterHandle* handles)
+	{
+		bool found = true;
+		for (unsigned int i = 0; i < numParams; ++i)
+		{
+			if (!hasParameter(ids[i]))
+			{
+				LOG(Warning) << "Parameter " << ids[i] << " not found";
+				handles[i] = InvalidParameterHandle;
+				found = false;
+				continue;
+			}
+
+			handles[i] = resolveParameterHandle(ids[i], true);
+		}
+		return found;
+	}
+
+	void Simulator::setParameterValues(ParameterHandle const* handles, double const* values, unsigned int numParams)
+	{
+		for (unsigned int i = 0; i < numParams; ++i)
+			writeParameterHandle(handles[i], values[i], false);
+	}
+
+	void Simulator::setSensitiveParameterValues(double const* values)
+	{
+		// Resolve all (fused) sensitive parameters on first use,
+		// SECTION_TIMES are not resolved since they do not respect linear factors
+		if (_sensParamHandles.size() != _sensitiveParams.size())
+		{
+			_sensParamHandles.clear();
+			_sensParamHandles.reserve(_sensitiveParams.size());
+			for (unsigned int i = 0; i < _sensitiveParams.size(); ++i)
+				_sensParamHandles.push_back(resolveParameterHandle(_sensitiveParams.native(i), false));
+		}
+
+		for (unsigned int idx = 0; idx < _sensitiveParams.slices(); ++idx)
+		{
+			ParameterId const* const paramIds = _sensitiveParams[idx];
+			const util::SlicedVector<ParameterId>::size_type sliceOffset = _sensitiveParams.sliceOffset(idx);
+
+			for (unsigned int i = 0; i < _sensitiveParams.sliceSize(idx); ++i)
+			{
+				const ParameterId& id = paramIds[i];
+				if (isSectionTimeParameter(id, _sectionTimes.size()))
+					_sectionTimes[id.section].setValue(values[idx]);
+
+				// Take care of linear factors
+				writeParameterHandle(_sensParamHandles[sliceOffset + i], _sensitiveParamsFactor[sliceOffset + i] * values[idx], true);
+			}
+		}
+	}
+
+	void Simulator::clearParameterHandles() CADET_NOEXCEPT
+	{
+		// Do not reuse handles of the cleared parameters in order to detect outdated handles
+		_paramHandleOffset += static_cast<ParameterHandle>(_paramHandleIds.size());
+
+		_paramHandleStorage.clear();
+		_paramHandleIds.clear();
+		_paramHandleDirect.clear();
+		_paramHandleSecTimes.clear();
+		_paramHandleLookup[0].clear();
+		_paramHandleLookup[1].clear();
+		_sensParamHandles.clear();
+	}
+
 	void Simulator::setSolutionTimes(const std::vector<double>& solutionTimes)
 	{
 		_solutionTimes = solutionTimes;
@@ -942,7 +1374,11 @@ namespace cadet
 		for (unsigned int i = 0; i < sectionTimes.size(); ++i)
 			_sectionTimes.push_back(sectionTimes[i]);
 
+		// Parameter handles may point to the old section times
+		rebindParameterHandles();
+
 		_sectionContinuity = sectionContinuity;
+		_sectionTimesBeforeEvents.clear();
 
 		// Set AD sensitivities
 		unsigned int globalIdx = 0;
@@ -967,54 +1403,270 @@ namespace cadet
 		}
 	}
 
-	void Simulator::integrate()
+	void Simulator::addEvent(const SimulationEvent& evt)
 	{
-		// In this function the model is integrated by IDAS from the SUNDIALS package.
-		// The authors of IDAS recommend to restart the time integrator when a discontinuity
-		// is encountered (see https://computation.llnl.gov/casc/sundials/support/notes.html#disc).
-		// The sectionTime (together with the sectionContinuity) array indicates such
-		// discontinuitites and the solver is restarted accordingly. This also requires
-		// the computation of consistent initial values for each restart.
+		if ((evt.direction < -1) || (evt.direction > 1))
+			throw InvalidParameterException("Event direction has to be -1, 0, or 1 (event " + std::to_string(_events.size()) + ")");
 
-		// This sets up the tbb thread limiter
-		// TBB can use up to _nThreads but it may use fewer
-#ifdef CADET_PARALLELIZE
-		tbb::task_scheduler_init init(tbb::task_scheduler_init::deferred);
-		if (_nThreads > 0)
-			init.initialize(_nThreads);
-		else
-			init.initialize(tbb::task_scheduler_init::default_num_threads());
+		if ((evt.type == EventType::OutletPurity) && (evt.component < 0))
+			throw InvalidParameterException("Purity events require a component index (event " + std::to_string(_events.size()) + ")");
 
-		_model->setupParallelization(tbb::this_task_arena::max_concurrency());
-#else
-		_model->setupParallelization(1);
-#endif
+		_events.push_back(evt);
+	}
 
-		// Set number of threads in SUNDIALS OpenMP-enabled implementation
-#ifdef CADET_SUNDIALS_OPENMP
-		if (_vecStateY)
-			NVec_SetThreads(_vecStateY, _nThreads);
-		if (_vecStateYdot)
-			NVec_SetThreads(_vecStateYdot, _nThreads);
+	void Simulator::clearEvents() CADET_NOEXCEPT
+	{
+		_events.clear();
+		_eventTimes.clear();
+		_eventIndices.clear();
+	}
 
-		for (unsigned int i = 0; i < _sensitiveParams.slices(); ++i)
+	void Simulator::setupEvents()
+	{
+		_eventTimes.clear();
+		_eventIndices.clear();
+
+		// Restore section times that have been shifted by an event in a previous run
+		if (!_sectionTimesBeforeEvents.empty())
 		{
-			NVec_SetThreads(_vecFwdYs[i], _nThreads);
-			NVec_SetThreads(_vecFwdYsDot[i], _nThreads);
+			const std::vector<double> secTimes = std::move(_sectionTimesBeforeEvents);
+			setSectionTimes(secTimes, _sectionContinuity);
 		}
-#endif
 
-		// Set number of AD directions
-		// @todo This is problematic if multiple Simulators are run concurrently!
-#if defined(ACTIVE_ADOLC) || defined(ACTIVE_SFAD) || defined(ACTIVE_SETFAD)
-		LOG(Debug) << "Setting AD directions from " << ad::getDirections() << " to " << numSensitivityAdDirections() + _model->requiredADdirs();
-		if (numSensitivityAdDirections() + _model->requiredADdirs() > ad::getMaxDirections())
-			throw InvalidParameterException("Requested " + std::to_string(numSensitivityAdDirections() + _model->requiredADdirs()) + " AD directions, but only "
+		const unsigned int nEvents = _events.size();
+		_eventOffset.resize(nEvents);
+		_eventStride.resize(nEvents);
+		_eventNumComp.resize(nEvents);
+		_eventRootsFound.resize(nEvents);
+
+		std::vector<int> directions(nEvents, 0);
+		for (unsigned int i = 0; i < nEvents; ++i)
+		{
+			const SimulationEvent& evt = _events[i];
+			IUnitOperation const* const unitOp = static_cast<IUnitOperation const*>(_model->getUnitOperationModel(evt.unitOp));
+			if (!unitOp)
+				throw InvalidParameterException("Unit operation " + std::to_string(evt.unitOp) + " of event " + std::to_string(i) + " does not exist");
+
+			const unsigned int offset = _model->unitOperationDofOffset(evt.unitOp);
+			if (offset == InvalidDofOffset)
+				throw InvalidParameterException("Unit operation " + std::to_string(evt.unitOp) + " of event " + std::to_string(i) + " is not part of the model system");
+			if (evt.type == EventType::UnitState)
+			{
+				if ((evt.component < 0) || (static_cast<unsigned int>(evt.component) >= unitOp->numDofs()))
+					throw InvalidParameterException("State index " + std::to_string(evt.component) + " of event " + std::to_string(i) + " is out of range");
+
+				_eventOffset[i] = offset + evt.component;
+				_eventStride[i] = 0;
+				_eventNumComp[i] = 1;
+			}
+			else
+			{
+				if (!unitOp->hasOutlet() || (evt.port >= unitOp->numOutletPorts()))
+					throw InvalidParameterException("Unit operation " + std::to_string(evt.unitOp) + " does not have outlet port " + std::to_string(evt.port) + " (event " + std::to_string(i) + ")");
+				if ((evt.component < -1) || (evt.component >= static_cast<int>(unitOp->numComponents())))
+					throw InvalidParameterException("Component " + std::to_string(evt.component) + " of event " + std::to_string(i) + " is out of range");
+
+				_eventOffset[i] = offset + unitOp->localOutletComponentIndex(evt.port);
+				_eventStride[i] = unitOp->localOutletComponentStride(evt.port);
+				_eventNumComp[i] = unitOp->numComponents();
+			}
+
+			directions[i] = evt.direction;
+		}
+
+		IDARootInit(_idaMemBlock, nEvents, (nEvents > 0) ? &eventRootWrapper : nullptr);
+		if (nEvents > 0)
+			IDASetRootDirection(_idaMemBlock, directions.data());
+	}
+
+	EventAction Simulator::handleEvents(double t)
+	{
+		IDAGetRootInfo(_idaMemBlock, _eventRootsFound.data());
+
+		EventAction action = EventAction::Record;
+		for (unsigned int i = 0; i < _events.size(); ++i)
+		{
+			if (_eventRootsFound[i] == 0)
+				continue;
+
+			LOG(Debug) << "Event " << i << " triggered at t = " << t;
+
+			_eventTimes.push_back(t);
+			_eventIndices.push_back(i);
+
+			if (_events[i].action == EventAction::Stop)
+				action = EventAction::Stop;
+			else if ((_events[i].action == EventAction::NextSection) && (action != EventAction::Stop))
+				action = EventAction::NextSection;
+		}
+
+		if (action != EventAction::NextSection)
+			return action;
+
+		// Stop if there is no next section
+		const unsigned int nextSec = getCurrentSection(t) + 1;
+		if (nextSec >= _sectionTimes.size() - 1)
+			return EventAction::Stop;
+
+		// Let the next section start at the event time and preserve the durations of all subsequent sections
+		if (_sectionTimesBeforeEvents.empty())
+		{
+			_sectionTimesBeforeEvents.reserve(_sectionTimes.size());
+			for (unsigned int i = 0; i < _sectionTimes.size(); ++i)
+				_sectionTimesBeforeEvents.push_back(static_cast<double>(_sectionTimes[i]));
+		}
+
+		// Set the start of the next section exactly (subtracting the shift may introduce round-off)
+		const double shift = static_cast<double>(_sectionTimes[nextSec]) - t;
+		_sectionTimes[nextSec] = t;
+		for (unsigned int i = nextSec + 1; i < _sectionTimes.size(); ++i)
+			_sectionTimes[i] -= shift;
+
+		LOG(Debug) << "Section " << nextSec << " starts at event time t = " << t << ", subsequent sections shifted by " << -shift;
+
+		// std::vector<bool> does not provide contiguous storage
+		const std::unique_ptr<bool[]> secCont(new bool[_sectionContinuity.size()]);
+		std::copy(_sectionContinuity.begin(), _sectionContinuity.end(), secCont.get());
+
+		std::vector<double> secTimes(_sectionTimes.size());
+		for (unsigned int i = 0; i < _sectionTimes.size(); ++i)
+			secTimes[i] = static_cast<double>(_sectionTimes[i]);
+
+		_model->setSectionTimes(secTimes.data(), secCont.get(), _sectionTimes.size() - 1);
+
+		return EventAction::NextSection;
+	}
+
+	void Simulator::setSectionRange(unsigned int startSec, unsigned int endSec)
+	{
+		if ((endSec > 0) && (startSec >= endSec))
+			throw InvalidParameterException("First section of range (" + std::to_string(startSec) + ") has to be smaller than its end (" + std::to_string(endSec) + ")");
+
+		_secRangeStart = startSec;
+		_secRangeEnd = endSec;
+	}
+
+	void Simulator::setSteadyStateDetection(const std::vector<bool>& sections, double tol)
+	{
+		if (tol <= 0.0)
+			throw InvalidParameterException("Steady-state tolerance has to be positive");
+
+		_steadyStateSections = sections;
+		_steadyStateTol = tol;
+	}
+
+	bool Simulator::steadyStateDetectionEnabled(unsigned int secIdx) const CADET_NOEXCEPT
+	{
+		if (_steadyStateSections.size() == 1)
+			return _steadyStateSections[0];
+
+		return (secIdx < _steadyStateSections.size()) && _steadyStateSections[secIdx];
+	}
+
+	bool Simulator::isSteadyState(double t, unsigned int secIdx, double tEnd)
+	{
+		const unsigned int nDof = _model->numDofs();
+		const double remaining = tEnd - t;
+		if (remaining <= 0.0)
+			return false;
+
+		// First half of buffer holds error weights, second half residual
+		_steadyStateBuffer.resize(2 * nDof);
+		double* const weight = _steadyStateBuffer.data();
+		double* const res = _steadyStateBuffer.data() + nDof;
+
+		if (_timeIntegrator == TimeIntegrator::RadauIIA)
+			_radau.errorWeights(weight);
+		else
+		{
+			N_Vector vecWeight = NVec_NewEmpty(nDof);
+			NVEC_DATA(vecWeight) = weight;
+			IDAGetErrWeights(_idaMemBlock, vecWeight);
+			NVec_Destroy(vecWeight);
+		}
+
+		double norm = weightedRmsNorm(NVEC_DATA(_vecStateYdot), weight, nDof);
+		if (remaining * norm > _steadyStateTol)
+			return false;
+
+		for (unsigned int i = 0; i < _sensitiveParams.slices(); ++i)
+		{
+			norm = std::max(norm, weightedRmsNorm(NVEC_DATA(_vecFwdYsDot[i]), weight, nDof));
+			if (remaining * norm > _steadyStateTol)
+				return false;
+		}
+
+		_model->residual(SimulationTime{t, secIdx}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)}, res);
+		norm = std::max(norm, weightedRmsNorm(res, weight, nDof));
+
+		LOG(Debug) << "Steady-state test at t = " << t << ": " << remaining * norm << " (tol " << _steadyStateTol << ")";
+		return remaining * norm <= _steadyStateTol;
+	}
+
+	void Simulator::integrate()
+	{
+		// In this function the model is integrated by IDAS from the SUNDIALS package.
+		// The authors of IDAS recommend to restart the time integrator when a discontinuity
+		// is encountered (see https://computation.llnl.gov/casc/sundials/support/notes.html#disc).
+		// The sectionTime (together with the sectionContinuity) array indicates such
+		// discontinuitites and the solver is restarted accordingly. This also requires
+		// the computation of consistent initial values for each restart.
+
+		// This sets up the tbb thread limiter
+		// TBB can use up to _nThreads but it may use fewer
+#ifdef CADET_PARALLELIZE
+		tbb::task_scheduler_init init(tbb::task_scheduler_init::deferred);
+		if (_nThreads > 0)
+			init.initialize(_nThreads);
+		else
+			init.initialize(tbb::task_scheduler_init::default_num_threads());
+
+		_model->setupParallelization(tbb::this_task_arena::max_concurrency());
+#else
+		_model->setupParallelization(1);
+#endif
+
+		// Set number of threads in SUNDIALS OpenMP-enabled implementation
+#ifdef CADET_SUNDIALS_OPENMP
+		if (_vecStateY)
+			NVec_SetThreads(_vecStateY, _nThreads);
+		if (_vecStateYdot)
+			NVec_SetThreads(_vecStateYdot, _nThreads);
+
+		for (unsigned int i = 0; i < _sensitiveParams.slices(); ++i)
+		{
+			NVec_SetThreads(_vecFwdYs[i], _nThreads);
+			NVec_SetThreads(_vecFwdYsDot[i], _nThreads);
+		}
+#endif
+
+		// Set number of AD directions
+		// @todo This is problematic if multiple Simulators are run concurrently!
+#if defined(ACTIVE_ADOLC) || defined(ACTIVE_SFAD) || defined(ACTIVE_SETFAD)
+		LOG(Debug) << "Setting AD directions from " << ad::getDirections() << " to " << numSensitivityAdDirections() + _model->requiredADdirs();
+		if (numSensitivityAdDirections() + _model->requiredADdirs() > ad::getMaxDirections())
+			throw InvalidParameterException("Requested " + std::to_string(numSensitivityAdDirections() + _model->requiredADdirs()) + " AD directions, but only "
 				+ std::to_string(ad::getMaxDirections()) + " are supported");
 
 		ad::setDirections(numSensitivityAdDirections() + _model->requiredADdirs());
 #endif
 
+		const bool useRadau = (_timeIntegrator == TimeIntegrator::RadauIIA);
+		if (useRadau)
+		{
+			if (_sensitiveParams.slices() > 0)
+				throw InvalidParameterException("Time integrator RADAU_IIA does not support forward sensitivities");
+			if (!_events.empty())
+				throw InvalidParameterException("Time integrator RADAU_IIA does not support events");
+			if (!_resumeState.empty())
+				throw InvalidParameterException("Time integrator RADAU_IIA cannot resume from checkpoints");
+
+			if (_checkpoint && ((_checkpointWallTime > 0.0) || (_checkpointSimTime > 0.0)))
+				throw InvalidParameterException("Time integrator RADAU_IIA does not support writing checkpoints");
+
+			applyRadauSettings();
+		}
+
 		if (_notification)
 			_notification->timeIntegrationStart();
 
@@ -1023,12 +1675,39 @@ namespace cadet
 		// Setup AD vectors by model
 		_model->prepareADvectors(AdJacobianParams{_vecADres, _vecADy, numSensitivityAdDirections()});
 
+		// Register event functions with IDAS
+		setupEvents();
+
+		_steadyStateSkippedTime.clear();
+		if (!_steadyStateSections.empty())
+			_steadyStateSkippedTime.resize(_sectionTimes.size() - 1, 0.0);
+
 		std::vector<double>::const_iterator it;
 		double tOut = 0.0;
 
 		const bool writeAtUserTimes = _solutionTimes.size() > 0;
 		const bool wantSensitivities = _sensitiveParams.slices() > 0;
 
+		// Forcing terms are computed from the Newton residual of the state, which does not
+		// carry over to the sensitivity systems
+		_forcingTermActive = _adaptiveLinearTol && !wantSensitivities && !useRadau;
+		_forcingTime = -1.0;
+		_model->setAdaptiveLinearSolverTolerance(_forcingTermActive);
+		if (_adaptiveLinearTol && wantSensitivities)
+		{
+			LOG(Warning) << "Adaptive linear solver tolerances are disabled since sensitivities are computed";
+		}
+		else if (_adaptiveLinearTol && useRadau)
+		{
+			LOG(Warning) << "Adaptive linear solver tolerances are not supported by time integrator RADAU_IIA";
+		}
+
+		_stepStats.clear();
+		_curStepIdx = -1;
+
+		_intStats = IntegratorStatistics{0ul, 0ul, 0ul, 0ul, 0ul, 0ul};
+		_intStatsLinearIter = _model->numLinearSolverIterations();
+
 		LOG(Debug) << "#MaxNewton: " << _maxNewtonIter << ", #MaxErrTestFail: " << _maxErrorTestFail << ", #MaxConvTestFail: " << _maxConvTestFail;
 		if (wantSensitivities)
 		{
@@ -1049,27 +1728,64 @@ namespace cadet
 			idaTask = IDA_NORMAL;
 		}
 
-		LOG(Debug) << "Integration span: [" << static_cast<double>(_sectionTimes[0]) << ", " << static_cast<double>(_sectionTimes.back()) << "] sections";
+		// Determine the integrated range of sections
+		const unsigned int nSections = _sectionTimes.size() - 1;
+		const unsigned int secRangeEnd = ((_secRangeEnd == 0) || (_secRangeEnd > nSections)) ? nSections : _secRangeEnd;
+		if (_secRangeStart >= secRangeEnd)
+			throw InvalidParameterException("Section range [" + std::to_string(_secRangeStart) + ", " + std::to_string(secRangeEnd) + ") is empty");
+
+		const double tStart = static_cast<double>(_sectionTimes[_secRangeStart]);
+		const auto rangeEndTime = [&]() -> double
+			{
+				if (secRangeEnd == nSections)
+					return writeAtUserTimes ? _solutionTimes.back() : static_cast<double>(_sectionTimes.back());
+				return writeAtUserTimes ? std::min(_solutionTimes.back(), static_cast<double>(_sectionTimes[secRangeEnd])) : static_cast<double>(_sectionTimes[secRangeEnd]);
+			};
+
+		LOG(Debug) << "Integration span: [" << tStart << ", " << static_cast<double>(_sectionTimes[secRangeEnd]) << "] sections " << _secRangeStart << " to " << secRangeEnd - 1;
 		
 		if (writeAtUserTimes)
 		{
 			LOG(Debug) << "Solution time span: [" << _solutionTimes[0] << ", " << _solutionTimes.back() << "]";
 		}
 
-		double curT = static_cast<double>(_sectionTimes[0]);
-		_curSec = 0;
-		const double tEnd = writeAtUserTimes ? _solutionTimes.back() : static_cast<double>(_sectionTimes.back());
-		while (curT < tEnd)
+		double curT = tStart;
+		_curSec = _secRangeStart;
+		double tEnd = rangeEndTime();
+
+		// Continue from a checkpoint inside the continuous slice of sections starting at _curSec
+		bool resumeSection = !_resumeState.empty();
+		StateBufferReader resumeState(_resumeState.data(), _resumeState.size());
+		if (resumeSection)
+		{
+			restoreSimulatorState(resumeState, curT, tEnd);
+			LOG(Debug) << "Resuming from checkpoint at t = " << curT << " in section " << _curSec;
+		}
+
+		// Restore section dependent state of the model if integration does not start in the first section
+		const unsigned int firstSec = _curSec;
+		for (unsigned int i = 0; i < firstSec; ++i)
+			_model->notifyDiscontinuousSectionTransition(static_cast<double>(_sectionTimes[i]), i, AdJacobianParams{_vecADres, _vecADy, numSensitivityAdDirections()});
+
+		if (resumeSection && _checkpoint)
+			_checkpoint->resumeFromCheckpoint(_curSec, curT);
+
+		_lastCheckpointSimTime = curT;
+		_lastCheckpointWallTime = std::chrono::steady_clock::now();
+
+		bool stopAtEvent = false;
+		while ((curT < tEnd) && !stopAtEvent)
 		{
 			// Get smallest index with t_i >= curT (t_i being a _sectionTimes element)
 			// This will return i if curT == _sectionTimes[i], which effectively advances
-			// the index if required
-			_curSec = getNextSection(curT, _curSec);
+			// the index if required. A resumed section already starts at the checkpoint.
+			if (!resumeSection)
+				_curSec = getNextSection(curT, _curSec);
 			const double startTime = static_cast<double>(_sectionTimes[_curSec]);
 
 			// Determine continuous time slice
 			unsigned int skip = 1; // Always finish the current section
-			for (size_t i = _curSec; i < _sectionTimes.size() - 2; ++i)
+			for (size_t i = _curSec; i < secRangeEnd - 1; ++i)
 			{
 				if (!_sectionContinuity[i])
 					break;
@@ -1080,7 +1796,14 @@ namespace cadet
 			}
 
 			const double endTime = writeAtUserTimes ? std::min(static_cast<double>(_sectionTimes[_curSec + skip]), tEnd) : static_cast<double>(_sectionTimes[_curSec + skip]);
-			curT = startTime;
+			if (!resumeSection)
+				curT = startTime;
+			else
+			{
+				// The checkpointed state is consistent
+				_skipConsistencyStateY = true;
+				_skipConsistencySensitivity = true;
+			}
 
 			LOG(Debug) << " ###### SECTION " << _curSec << " from " << startTime << " to " << endTime;
 
@@ -1092,12 +1815,13 @@ namespace cadet
 			IDASetStopTime(_idaMemBlock, endTime);
 
 			// Update Jacobian
-			_model->notifyDiscontinuousSectionTransition(curT, _curSec, AdJacobianParams{_vecADres, _vecADy, numSensitivityAdDirections()});
+			_model->notifyDiscontinuousSectionTransition(startTime, _curSec, AdJacobianParams{_vecADres, _vecADy, numSensitivityAdDirections()});
 
 			// Compute consistent initial values
 			LOG(Debug) << "---====--- CONSISTENCY ---====--- ";
-			const double consPrev = _model->residualNorm(SimulationTime{curT, _curSec}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)});
-			LOG(Debug) << " ==========> Consistency error prev: " << consPrev;
+			// Residual norms are only evaluated if the log statement is emitted
+			const auto consistencyError = log::lazy([&]() { return _model->residualNorm(SimulationTime{curT, _curSec}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)}); });
+			LOG(Debug) << " ==========> Consistency error prev: " << consistencyError;
 
 			if (!_skipConsistencyStateY && (_consistentInitMode != ConsistentInitialization::None))
 			{
@@ -1107,16 +1831,14 @@ namespace cadet
 					_model->consistentInitialConditions(SimulationTime{curT, _curSec}, SimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)}, 
 						AdJacobianParams{_vecADres, _vecADy, numSensitivityAdDirections()}, _algTol);
 
-					const double consPost = _model->residualNorm(SimulationTime{curT, _curSec}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)});
-					LOG(Debug) << " ==========> Consistency error post Full: " << consPost;
+					LOG(Debug) << " ==========> Consistency error post Full: " << consistencyError;
 				}
 				else if (mode == ConsistentInitialization::Lean)
 				{
 					_model->leanConsistentInitialConditions(SimulationTime{curT, _curSec}, SimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)},
 						AdJacobianParams{_vecADres, _vecADy, numSensitivityAdDirections()}, _algTol);
 
-					const double consPost = _model->residualNorm(SimulationTime{curT, _curSec}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)});
-					LOG(Debug) << " ==========> Consistency error post Lean: " << consPost;
+					LOG(Debug) << " ==========> Consistency error post Lean: " << consistencyError;
 				}
 				else
 				{
@@ -1125,7 +1847,7 @@ namespace cadet
 
 				LOG(Debug) << "y = " << log::VectorPtr<double>(NVEC_DATA(_vecStateY), _model->numDofs()) << ";";
 				LOG(Debug) << "yDot = " << log::VectorPtr<double>(NVEC_DATA(_vecStateYdot), _model->numDofs()) << ";";
-				LOG(Debug) << "Contains NaN: y = " << hasNaN(_vecStateY) << " yDot = " << hasNaN(_vecStateYdot);
+				LOG(Debug) << "Contains NaN: y = " << log::lazy([&]() { return hasNaN(_vecStateY); }) << " yDot = " << log::lazy([&]() { return hasNaN(_vecStateYdot); });
 			}
 			_skipConsistencyStateY = false;
 
@@ -1137,10 +1859,13 @@ namespace cadet
 
 				std::vector<double> norms(_sensitiveParams.slices(), 0.0);
 				std::vector<double> temp(_model->numDofs(), 0.0);
-				_model->residualSensFwdNorm(_sensitiveParams.slices(), SimulationTime{curT, _curSec}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)},
-					sensYdbg, sensYdotDbg, norms.data(), _vecADres, temp.data());
+				if (LOG_ACTIVE(Debug))
+				{
+					_model->residualSensFwdNorm(_sensitiveParams.slices(), SimulationTime{curT, _curSec}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)},
+						sensYdbg, sensYdotDbg, norms.data(), _vecADres, temp.data());
 
-				LOG(Debug) << " ==========> Sens consistency error prev: " << norms;
+					LOG(Debug) << " ==========> Sens consistency error prev: " << norms;
+				}
 #endif
 
 				const ConsistentInitialization mode = currentConsistentInitMode(_consistentInitModeSens, _curSec);
@@ -1152,10 +1877,13 @@ namespace cadet
 					_model->consistentInitialSensitivity(SimulationTime{curT, _curSec}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)}, sensY, sensYdot, _vecADres, _vecADy);
 
 #ifdef CADET_DEBUG
-					_model->residualSensFwdNorm(_sensitiveParams.slices(), SimulationTime{curT, _curSec}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)},
-						sensYdbg, sensYdotDbg, norms.data(), _vecADres, temp.data());
+					if (LOG_ACTIVE(Debug))
+					{
+						_model->residualSensFwdNorm(_sensitiveParams.slices(), SimulationTime{curT, _curSec}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)},
+							sensYdbg, sensYdotDbg, norms.data(), _vecADres, temp.data());
 
-					LOG(Debug) << " ==========> Sens consistency error post Full: " << norms;
+						LOG(Debug) << " ==========> Sens consistency error post Full: " << norms;
+					}
 #endif
 				}
 				else if (mode == ConsistentInitialization::Lean)
@@ -1166,10 +1894,13 @@ namespace cadet
 					_model->leanConsistentInitialSensitivity(SimulationTime{curT, _curSec}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)}, sensY, sensYdot, _vecADres, _vecADy);
 
 #ifdef CADET_DEBUG
-					_model->residualSensFwdNorm(_sensitiveParams.slices(), SimulationTime{curT, _curSec}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)},
-						sensYdbg, sensYdotDbg, norms.data(), _vecADres, temp.data());
+					if (LOG_ACTIVE(Debug))
+					{
+						_model->residualSensFwdNorm(_sensitiveParams.slices(), SimulationTime{curT, _curSec}, ConstSimulationState{NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot)},
+							sensYdbg, sensYdotDbg, norms.data(), _vecADres, temp.data());
 
-					LOG(Debug) << " ==========> Sens consistency error post Lean: " << norms;
+						LOG(Debug) << " ==========> Sens consistency error post Lean: " << norms;
+					}
 #endif
 				}
 				else
@@ -1182,7 +1913,7 @@ namespace cadet
 				{
 					LOG(Debug) << "sensY[" << j << "] = " << log::VectorPtr<double>(NVEC_DATA(_vecFwdYs[j]), _model->numDofs()) << ";";
 					LOG(Debug) << "sensYdot[" << j << "] = " << log::VectorPtr<double>(NVEC_DATA(_vecFwdYsDot[j]), _model->numDofs()) << ";";
-					LOG(Debug) << "Contains NaN: sensY[" << j << "] = " << hasNaN(_vecFwdYs[j]) << " sensYdot[" << j << "] = " << hasNaN(_vecFwdYsDot[j]);
+					LOG(Debug) << "Contains NaN: sensY[" << j << "] = " << log::lazy([&]() { return hasNaN(_vecFwdYs[j]); }) << " sensYdot[" << j << "] = " << log::lazy([&]() { return hasNaN(_vecFwdYsDot[j]); });
 				}
 #endif
 			}
@@ -1191,42 +1922,67 @@ namespace cadet
 			// Notify user and check for user abort
 			if (_notification)
 			{
-				const double progress = (curT - static_cast<double>(_sectionTimes[0])) / (tEnd - static_cast<double>(_sectionTimes[0]));
+				const double progress = (curT - tStart) / (tEnd - tStart);
 				if (!_notification->timeIntegrationSection(_curSec, curT, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), progress))
 					return;
 			}
 
 			// IDAS Step 5.2: Re-initialization of the solver
-			IDAReInit(_idaMemBlock, startTime, _vecStateY, _vecStateYdot);
-			if (wantSensitivities)
-				IDASensReInit(_idaMemBlock, IDA_STAGGERED, _vecFwdYs, _vecFwdYsDot);
+			if (useRadau)
+				_radau.reinit(startTime, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), stepSize);
+			else
+			{
+				IDAReInit(_idaMemBlock, startTime, _vecStateY, _vecStateYdot);
+				if (wantSensitivities)
+					IDASensReInit(_idaMemBlock, IDA_STAGGERED, _vecFwdYs, _vecFwdYsDot);
+
+				// Continue with step size, order, and history of the checkpoint
+				if (resumeSection)
+					restoreIntegratorState(resumeState);
+			}
 
 			// Inititalize the IDA solver flag
 			int solverFlag = IDA_SUCCESS;
+			bool leaveSection = false;
 
 			if (writeAtUserTimes)
 			{
 				// Write initial conditions only if desired by user
-				if (_curSec == 0 && _solutionTimes.front() == curT)
+				if (!resumeSection && _curSec == 0 && _solutionTimes.front() == curT)
 					writeSolution(curT);
 
 				// Initialize iterator and forward it to the first solution time that lies inside the current section
+				// (or after the checkpoint)
 				it = _solutionTimes.begin();
-				while ((*it) <= startTime) ++it;
+				while ((it != _solutionTimes.end()) && ((*it) <= curT)) ++it;
 			}
 			else
 			{
 				// Always write initial conditions if solutions are written at integration times
-				if (_curSec == 0) writeSolution(curT);
+				if (!resumeSection && _curSec == 0) writeSolution(curT);
 
 				// Here tOut - only during the first call to IDASolve - specifies the direction
 				// and rough scale of the independent variable, see IDAS Guide p.33
 				tOut = endTime;
 			}
 
+			if (resumeSection)
+			{
+				resumeSection = false;
+				_resumeState.clear();
+			}
+
+			if (useRadau)
+			{
+				if (!integrateRadau(curT, endTime, tStart, tEnd, it))
+					return;
+
+				continue;
+			}
+
 			// Main loop which integrates the system until reaching the end time of the current section
 			// or until an error occures
-			while ((solverFlag == IDA_SUCCESS) || (solverFlag == IDA_ROOT_RETURN))
+			while (((solverFlag == IDA_SUCCESS) || (solverFlag == IDA_ROOT_RETURN)) && !leaveSection)
 			{
 				// Update tOut if we write solutions at user specified times
 				if (writeAtUserTimes)
@@ -1303,23 +2059,82 @@ namespace cadet
 						IDAGetSensDky(_idaMemBlock, curT, 1, _vecFwdYsDot);
 					}
 					writeSolution(curT);
-					++it;
+					if (writeAtUserTimes)
+						++it;
 
 					// Notify user and check for user abort
 					if (_notification)
 					{
-						const double progress = (curT - static_cast<double>(_sectionTimes[0])) / (tEnd - static_cast<double>(_sectionTimes[0]));
+						const double progress = (curT - tStart) / (tEnd - tStart);
 						if (!_notification->timeIntegrationStep(_curSec, curT, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), progress))
 						{
+							accumulateIntegratorStatistics();
 							_lastIntTime = _timerIntegration.stop();
 							return;
 						}
 					}
+
+					// Fast-forward to the end of the section if steady state has been reached
+					if (!_steadyStateSections.empty())
+					{
+						const unsigned int sec = getCurrentSection(curT);
+						const double secEnd = std::min(static_cast<double>(_sectionTimes[sec + 1]), endTime);
+						if (steadyStateDetectionEnabled(sec) && isSteadyState(curT, sec, secEnd))
+						{
+							LOG(Debug) << "Steady state reached in section " << sec << " at t = " << curT << ", skipping to " << secEnd;
+
+							_steadyStateSkippedTime[sec] += secEnd - curT;
+
+							// Hold the state constant until the end of the section
+							NVec_Const(0.0, _vecStateYdot);
+							for (unsigned int i = 0; i < _sensitiveParams.slices(); ++i)
+								NVec_Const(0.0, _vecFwdYsDot[i]);
+
+							if (writeAtUserTimes)
+							{
+								for (; (it != _solutionTimes.end()) && (*it <= secEnd); ++it)
+									writeSolution(*it);
+							}
+							else
+								writeSolution(secEnd);
+
+							curT = secEnd;
+							leaveSection = true;
+						}
+					}
+
+					if (_checkpoint && !leaveSection && checkpointDue(curT))
+						writeCheckpoint(curT, tEnd);
 					break;
 				case IDA_ROOT_RETURN:
-					// A root was found
-					// Eventually call some routine
+				{
+					// An event has been located
+					if (wantSensitivities)
+					{
+						IDAGetSens(_idaMemBlock, &curT, _vecFwdYs);
+						IDAGetSensDky(_idaMemBlock, curT, 1, _vecFwdYsDot);
+					}
+
+					// Event times are additional time points if solutions are written at integration times
+					if (!writeAtUserTimes)
+						writeSolution(curT);
+
+					const EventAction action = handleEvents(curT);
+					if (action == EventAction::Stop)
+					{
+						leaveSection = true;
+						stopAtEvent = true;
+					}
+					else if (action == EventAction::NextSection)
+					{
+						// Section times have been shifted, which may move the end of the simulation
+						leaveSection = true;
+						tEnd = rangeEndTime();
+						if (writeAtUserTimes && (secRangeEnd == nSections))
+							tEnd = std::min(tEnd, static_cast<double>(_sectionTimes.back()));
+					}
 					break;
+				}
 				case IDA_TSTOP_RETURN:
 					// Extract sensitivity information from IDA (required for consistent initialization
 					// and output of sensitivities)
@@ -1340,15 +2155,17 @@ namespace cadet
 					// Notify user and check for user abort
 					if (_notification)
 					{
-						const double progress = (curT - static_cast<double>(_sectionTimes[0])) / (tEnd - static_cast<double>(_sectionTimes[0]));
+						const double progress = (curT - tStart) / (tEnd - tStart);
 						if (!_notification->timeIntegrationStep(_curSec, curT, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), progress))
 						{
+							accumulateIntegratorStatistics();
 							_lastIntTime = _timerIntegration.stop();
 							return;
 						}
 					}
 					break;
 				default:
+					accumulateIntegratorStatistics();
 					_lastIntTime = _timerIntegration.stop();
 
 					// An error occured
@@ -1357,7 +2174,7 @@ namespace cadet
 
 					if (_notification)
 					{
-						const double progress = (curT - static_cast<double>(_sectionTimes[0])) / (tEnd - static_cast<double>(_sectionTimes[0]));
+						const double progress = (curT - tStart) / (tEnd - tStart);
 						_notification->timeIntegrationError(errorFlag.c_str(), _curSec, curT, progress);
 					}
 
@@ -1367,6 +2184,11 @@ namespace cadet
 
 			} // while
 
+			// IDAS counters are reset when the next section starts
+			if (_recordStepStats)
+				finishStepStatistics();
+			accumulateIntegratorStatistics();
+
 		} // for (_sec ...)
 
 		_lastIntTime = _timerIntegration.stop();
@@ -1375,6 +2197,205 @@ namespace cadet
 			_notification->timeIntegrationEnd();
 	}
 
+	bool Simulator::integrateRadau(double& curT, double endTime, double tStart, double tEnd, std::vector<double>::const_iterator& it)
+	{
+		const bool writeAtUserTimes = _solutionTimes.size() > 0;
+		const unsigned int nDof = _model->numDofs();
+		RadauSystem sys(*this);
+
+		// Limits the number of steps between two written solutions (like the maximum number of steps per call to IDASolve())
+		unsigned int nStepsSinceOutput = 0;
+		while (_radau.time() < endTime)
+		{
+			if (writeAtUserTimes && (it == _solutionTimes.end()))
+				break;
+
+			const unsigned long nNewtonIter = _radau.numNewtonIter();
+			const unsigned long nConvFails = _radau.numConvFails();
+			const unsigned long nErrTestFails = _radau.numErrTestFails();
+			const unsigned long nLinearIter = _model->numLinearSolverIterations() + _radau.numLinearIter();
+
+			timeint::RadauIIA::Status status = timeint::RadauIIA::Status::TooMuchWork;
+			if ((_maxSteps == 0) || (nStepsSinceOutput < _maxSteps))
+				status = _radau.step(sys, endTime);
+
+			if (status != timeint::RadauIIA::Status::Success)
+			{
+				curT = _radau.time();
+				accumulateIntegratorStatistics();
+				_lastIntTime = _timerIntegration.stop();
+
+				const std::string errorFlag = getRadauStatusName(status);
+				LOG(Error) << "RadauIIA returned " << errorFlag << " at t = " << curT;
+
+				if (_notification)
+				{
+					const double progress = (curT - tStart) / (tEnd - tStart);
+					_notification->timeIntegrationError(errorFlag.c_str(), _curSec, curT, progress);
+				}
+
+				throw IntegrationException(std::string("Error in RadauIIA: ") + errorFlag + std::string(" at t = ") + std::to_string(curT));
+			}
+
+			++nStepsSinceOutput;
+			curT = _radau.time();
+
+			LOG(Debug) << "Step to " << curT << " with size " << _radau.lastStepSize() << ", next step size " << _radau.nextStepSize();
+
+			if (_recordStepStats)
+			{
+				_stepStats.push_back(StepStatistics{curT, _radau.lastStepSize(),
+					static_cast<unsigned int>(_radau.numNewtonIter() - nNewtonIter),
+					static_cast<unsigned int>(_radau.numConvFails() - nConvFails),
+					static_cast<unsigned int>(_radau.numErrTestFails() - nErrTestFails),
+					_model->numLinearSolverIterations() + _radau.numLinearIter() - nLinearIter});
+			}
+
+			if (writeAtUserTimes)
+			{
+				// Evaluate the collocation polynomial at the user specified times covered by the step
+				for (; (it != _solutionTimes.end()) && (*it <= curT); ++it)
+				{
+					_radau.interpolate(*it, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot));
+					writeSolution(*it);
+					nStepsSinceOutput = 0;
+				}
+			}
+
+			std::copy(_radau.state(), _radau.state() + nDof, NVEC_DATA(_vecStateY));
+			std::copy(_radau.stateDerivative(), _radau.stateDerivative() + nDof, NVEC_DATA(_vecStateYdot));
+
+			// Section end times are only written in the last section (see IDA_TSTOP_RETURN)
+			if (!writeAtUserTimes)
+			{
+				if ((curT < endTime) || (endTime == static_cast<double>(_sectionTimes.back())))
+					writeSolution(curT);
+				nStepsSinceOutput = 0;
+			}
+
+			// Notify user and check for user abort
+			if (_notification)
+			{
+				const double progress = (curT - tStart) / (tEnd - tStart);
+				if (!_notification->timeIntegrationStep(_curSec, curT, NVEC_DATA(_vecStateY), NVEC_DATA(_vecStateYdot), progress))
+				{
+					accumulateIntegratorStatistics();
+					_lastIntTime = _timerIntegration.stop();
+					return false;
+				}
+			}
+
+			// Fast-forward to the end of the section if steady state has been reached
+			if (!_steadyStateSections.empty())
+			{
+				const unsigned int sec = getCurrentSection(curT);
+				const double secEnd = std::min(static_cast<double>(_sectionTimes[sec + 1]), endTime);
+				if (steadyStateDetectionEnabled(sec) && isSteadyState(curT, sec, secEnd))
+				{
+					LOG(Debug) << "Steady state reached in section " << sec << " at t = " << curT << ", skipping to " << secEnd;
+
+					_steadyStateSkippedTime[sec] += secEnd - curT;
+
+					// Hold the state constant until the end of the section
+					NVec_Const(0.0, _vecStateYdot);
+
+					if (writeAtUserTimes)
+					{
+						for (; (it != _solutionTimes.end()) && (*it <= secEnd); ++it)
+							writeSolution(*it);
+					}
+					else
+						writeSolution(secEnd);
+
+					curT = secEnd;
+					break;
+				}
+			}
+		}
+
+		accumulateIntegratorStatistics();
+		return true;
+	}
+
+	double Simulator::forcingTerm(double t, double alpha, double const* rhs, double const* weight)
+	{
+		if ((t != _forcingTime) || (alpha != _forcingAlpha))
+		{
+			_forcingTerm.reset();
+			_forcingTime = t;
+			_forcingAlpha = alpha;
+		}
+
+		// Weighted root mean square norm of the Newton residual
+		const unsigned int nDof = numDofs();
+		double norm = 0.0;
+		for (unsigned int i = 0; i < nDof; ++i)
+		{
+			const double v = rhs[i] * weight[i];
+			norm += v * v;
+		}
+		norm = std::sqrt(norm / nDof);
+
+		return _forcingTerm.next(norm);
+	}
+
+	void Simulator::updateStepStatistics(IDAMem IDA_mem)
+	{
+		if (IDA_mem->ida_nst != _curStepIdx)
+		{
+			finishStepStatistics();
+
+			_curStepIdx = IDA_mem->ida_nst;
+			_curStepStats = StepStatistics{0.0, 0.0, 0u, 0u, 0u, 0ul};
+			_curStepConvFails = IDA_mem->ida_ncfn;
+			_curStepErrTestFails = IDA_mem->ida_netf;
+			_curStepLinearIter = _model->numLinearSolverIterations();
+		}
+
+		_curStepStats.time = IDA_mem->ida_tn;
+		_curStepStats.stepSize = IDA_mem->ida_hh;
+		++_curStepStats.nNewtonIter;
+	}
+
+	void Simulator::finishStepStatistics()
+	{
+		if (_curStepIdx < 0)
+			return;
+
+		IDAMem IDA_mem = static_cast<IDAMem>(_idaMemBlock);
+		_curStepStats.nConvFails = static_cast<unsigned int>(std::max(IDA_mem->ida_ncfn - _curStepConvFails, 0l));
+		_curStepStats.nErrTestFails = static_cast<unsigned int>(std::max(IDA_mem->ida_netf - _curStepErrTestFails, 0l));
+		_curStepStats.nLinearIter = _model->numLinearSolverIterations() - _curStepLinearIter;
+		_stepStats.push_back(_curStepStats);
+
+		_curStepIdx = -1;
+	}
+
+	void Simulator::accumulateIntegratorStatistics()
+	{
+		// Iterations of the linear solvers of the model since the last call
+		const unsigned long nLinearIter = _model->numLinearSolverIterations();
+		_intStats.nLinearIter += nLinearIter - _intStatsLinearIter;
+		_intStatsLinearIter = nLinearIter;
+
+		if (_timeIntegrator == TimeIntegrator::RadauIIA)
+		{
+			_intStats.nSteps += _radau.numSteps();
+			_intStats.nConvFails += _radau.numConvFails();
+			_intStats.nErrTestFails += _radau.numErrTestFails();
+			_intStats.nLinearIter += _radau.numLinearIter();
+
+			// Do not add the same counts again on the next call
+			_radau.resetCounters();
+			return;
+		}
+
+		IDAMem IDA_mem = static_cast<IDAMem>(_idaMemBlock);
+		_intStats.nSteps += static_cast<unsigned long>(std::max(IDA_mem->ida_nst, 0l));
+		_intStats.nConvFails += static_cast<unsigned long>(std::max(IDA_mem->ida_ncfn, 0l));
+		_intStats.nErrTestFails += static_cast<unsigned long>(std::max(IDA_mem->ida_netf, 0l));
+	}
+
 	double const* Simulator::getLastSolution(unsigned int& len) const
 	{
 		len = NVEC_LENGTH(_vecStateY);
@@ -1464,6 +2485,19 @@ namespace cadet
 		if (paramProvider.exists("MAX_NEWTON_ITER_SENS"))
 			_maxNewtonIterSens = paramProvider.getInt("MAX_NEWTON_ITER_SENS");
 
+		if (paramProvider.exists("MAX_NEWTON_ITER_RADAU"))
+			_maxNewtonIterRadau = paramProvider.getInt("MAX_NEWTON_ITER_RADAU");
+
+		if (paramProvider.exists("USE_ADAPTIVE_LINEAR_TOL"))
+			_adaptiveLinearTol = paramProvider.getBool("USE_ADAPTIVE_LINEAR_TOL");
+		else
+			_adaptiveLinearTol = false;
+
+		if (paramProvider.exists("INTEGRATOR_TYPE"))
+			_timeIntegrator = toTimeIntegrator(paramProvider.getString("INTEGRATOR_TYPE"));
+		else
+			_timeIntegrator = TimeIntegrator::IDAS;
+
 		paramProvider.popScope();
 
 		if (paramProvider.exists("NTHREADS"))
@@ -1481,12 +2515,63 @@ namespace cadet
 		if (paramProvider.exists("CONSISTENT_INIT_MODE_SENS"))
 			_consistentInitModeSens = toConsistentInitialization(paramProvider.getInt("CONSISTENT_INIT_MODE_SENS"));
 
+		if (paramProvider.exists("sections"))
+		{
+			paramProvider.pushScope("sections");
+
+			_steadyStateSections.clear();
+			if (paramProvider.exists("STEADY_STATE_DETECTION"))
+			{
+				const std::vector<int> ssd = paramProvider.getIntArray("STEADY_STATE_DETECTION");
+				_steadyStateSections.insert(_steadyStateSections.end(), ssd.begin(), ssd.end());
+			}
+
+			_steadyStateTol = 1.0;
+			if (paramProvider.exists("STEADY_STATE_TOL"))
+				setSteadyStateDetection(_steadyStateSections, paramProvider.getDouble("STEADY_STATE_TOL"));
+
+			paramProvider.popScope();
+		}
+
+		clearEvents();
+		if (paramProvider.exists("events"))
+		{
+			paramProvider.pushScope("events");
+
+			const unsigned int nEvents = paramProvider.getInt("NEVENTS");
+			std::ostringstream oss;
+			for (unsigned int i = 0; i < nEvents; ++i)
+			{
+				oss.str("");
+				oss << "event_" << std::setfill('0') << std::setw(3) << std::setprecision(0) << i;
+
+				paramProvider.pushScope(oss.str());
+
+				SimulationEvent evt;
+				evt.type = toEventType(paramProvider.getString("EVENT_TYPE"));
+				evt.unitOp = paramProvider.getInt("EVENT_UNIT");
+				evt.port = paramProvider.exists("EVENT_PORT") ? paramProvider.getInt("EVENT_PORT") : 0;
+				evt.component = paramProvider.exists("EVENT_COMP") ? paramProvider.getInt("EVENT_COMP") : -1;
+				evt.threshold = paramProvider.getDouble("EVENT_THRESHOLD");
+				evt.direction = paramProvider.exists("EVENT_DIRECTION") ? paramProvider.getInt("EVENT_DIRECTION") : 0;
+				evt.action = paramProvider.exists("EVENT_ACTION") ? toEventAction(paramProvider.getString("EVENT_ACTION")) : EventAction::Stop;
+				addEvent(evt);
+
+				paramProvider.popScope();
+			}
+
+			paramProvider.popScope();
+		}
+
 		// @todo: Read more configuration values
 	}
 
 	void Simulator::reconfigure(IParameterProvider& paramProvider)
 	{
 		configure(paramProvider);
+
+		// Settings of an already initialized time integrator have to be updated
+		applyTimeIntegratorSettings();
 	}
 
 	void Simulator::setSensitivityErrorTolerance(double relTol, double const* absTol)
@@ -1593,6 +2678,12 @@ namespace cadet
 			IDASetSensMaxNonlinIters(_idaMemBlock, nIter);
 	}
 
+	void Simulator::setMaxRadauNewtonIteration(unsigned int nIter)
+	{
+		_maxNewtonIterRadau = nIter;
+		_radau.maxNewtonIter(nIter);
+	}
+
 
 
 	bool Simulator::reconfigureModel(IParameterProvider& paramProvider)
@@ -1602,6 +2693,7 @@ namespace cadet
 
 		// Reconfigure the model
 		const bool success = _model->configure(paramProvider);
+		rebindParameterHandles();
 
 		// Set all AD directions for parameter sensitivities again
 		resetSensParams();
@@ -1616,6 +2708,7 @@ namespace cadet
 
 		// Reconfigure the model
 		const bool success = _model->configureModel(paramProvider, unitOpIdx);
+		rebindParameterHandles();
 
 		// Set all AD directions for parameter sensitivities again
 		resetSensParams();
@@ -1657,26 +2750,39 @@ namespace cadet
 		if (t < _sectionTimes[startIdx])
 			return -1;
 
-		for (unsigned int i = startIdx; i < _sectionTimes.size() - 1; ++i)
-		{
-			if (_sectionTimes[i] >= t)
-				return i;
-		}
+		// Binary search for lowest index i >= startIdx with t_i >= t
+		const std::vector<active>::const_iterator last = _sectionTimes.end() - 1;
+		const std::vector<active>::const_iterator it = std::lower_bound(_sectionTimes.begin() + startIdx, last, t,
+			[](const active& a, double b) -> bool { return static_cast<double>(a) < b; });
 
-		return -1;
+		if (it == last)
+			return -1;
+
+		return it - _sectionTimes.begin();
 	}
 
 	unsigned int Simulator::getCurrentSection(double t) const
 	{
-		//TODO: Use binary search
-		
-		for (unsigned int i = _curSec; i < _sectionTimes.size() - 1; ++i)
-		{
-			if ((t >= _sectionTimes[i]) && (t <= _sectionTimes[i+1]))
-				return i;
-		}
+		const unsigned int nSec = _sectionTimes.size() - 1;
+		if (_curSec >= nSec)
+			return -1;
 
-		return -1;
+		// Residual evaluations almost always query the current section
+		if ((t >= _sectionTimes[_curSec]) && (t <= _sectionTimes[_curSec + 1]))
+			return _curSec;
+
+		// Binary search for lowest index j > _curSec with t_j >= t, which yields section j-1
+		const std::vector<active>::const_iterator it = std::lower_bound(_sectionTimes.begin() + _curSec + 1, _sectionTimes.end(), t,
+			[](const active& a, double b) -> bool { return static_cast<double>(a) < b; });
+
+		if (it == _sectionTimes.end())
+			return -1;
+
+		const unsigned int idx = (it - _sectionTimes.begin()) - 1;
+		if (t < _sectionTimes[idx])
+			return -1;
+
+		return idx;
 	}
 
 	IModelSystem* const Simulator::model() CADET_NOEXCEPT
@@ -1706,4 +2812,277 @@ namespace cadet
 		_notification = nc;
 	}
 
+	void Simulator::setCheckpointing(double wallTime, double simTime, ICheckpointCallback* callback)
+	{
+		_checkpointWallTime = wallTime;
+		_checkpointSimTime = simTime;
+		_checkpoint = callback;
+	}
+
+	void Simulator::restoreCheckpoint(double const* state, unsigned int len)
+	{
+		if (!state || (len == 0))
+		{
+			_resumeState.clear();
+			return;
+		}
+
+		_resumeState.assign(state, state + len);
+	}
+
+	bool Simulator::checkpointDue(double t) const
+	{
+		if ((_checkpointSimTime > 0.0) && (t - _lastCheckpointSimTime >= _checkpointSimTime))
+			return true;
+
+		if (_checkpointWallTime > 0.0)
+		{
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - _lastCheckpointWallTime;
+			return elapsed.count() >= _checkpointWallTime;
+		}
+
+		return false;
+	}
+
+	void Simulator::writeCheckpoint(double t, double tEnd)
+	{
+		const unsigned int nSens = _sensitiveParams.slices();
+		const unsigned int nDof = numDofs();
+
+		_checkpointBuffer.clear();
+		StateBufferWriter buffer(_checkpointBuffer);
+
+		// Header for detecting mismatching configurations
+		buffer.scalar(checkpointFormatVersion);
+		buffer.scalar(checkpointSundialsVersion);
+		buffer.scalar(nDof);
+		buffer.scalar(nSens);
+		buffer.scalar(_sectionTimes.size());
+		buffer.scalar(_events.size());
+
+		// Time integration loop
+		buffer.scalar(t);
+		buffer.scalar(tEnd);
+		buffer.scalar(_curSec);
+
+		std::vector<double> secTimes(_sectionTimes.size());
+		for (unsigned int i = 0; i < _sectionTimes.size(); ++i)
+			secTimes[i] = static_cast<double>(_sectionTimes[i]);
+		buffer.vector(secTimes);
+		buffer.vector(_sectionTimesBeforeEvents);
+		buffer.vector(_eventTimes);
+		buffer.vector(_eventIndices);
+		buffer.vector(_steadyStateSkippedTime);
+
+		// State vectors
+		buffer.array(NVEC_DATA(_vecStateY), nDof);
+		buffer.array(NVEC_DATA(_vecStateYdot), nDof);
+		for (unsigned int i = 0; i < nSens; ++i)
+		{
+			buffer.array(NVEC_DATA(_vecFwdYs[i]), nDof);
+			buffer.array(NVEC_DATA(_vecFwdYsDot[i]), nDof);
+		}
+
+		// Internal state of IDAS
+		IDAMem IDA_mem = static_cast<IDAMem>(_idaMemBlock);
+		const int maxCol = std::max(IDA_mem->ida_maxord, 3);
+		buffer.scalar(maxCol);
+		buffer.scalar(IDA_mem->ida_kk);
+		buffer.scalar(IDA_mem->ida_kused);
+		buffer.scalar(IDA_mem->ida_knew);
+		buffer.scalar(IDA_mem->ida_phase);
+		buffer.scalar(IDA_mem->ida_ns);
+		buffer.scalar(IDA_mem->ida_hh);
+		buffer.scalar(IDA_mem->ida_hused);
+		buffer.scalar(IDA_mem->ida_rr);
+		buffer.scalar(IDA_mem->ida_tn);
+		buffer.scalar(IDA_mem->ida_tretlast);
+		buffer.scalar(IDA_mem->ida_cj);
+		buffer.scalar(IDA_mem->ida_cjlast);
+		buffer.scalar(IDA_mem->ida_cjold);
+		buffer.scalar(IDA_mem->ida_cjratio);
+		buffer.scalar(IDA_mem->ida_ss);
+		buffer.scalar(IDA_mem->ida_ssS);
+		buffer.scalar(IDA_mem->ida_epsNewt);
+
+		buffer.scalar(IDA_mem->ida_nst);
+		buffer.scalar(IDA_mem->ida_nre);
+		buffer.scalar(IDA_mem->ida_ncfn);
+		buffer.scalar(IDA_mem->ida_netf);
+		buffer.scalar(IDA_mem->ida_nni);
+		buffer.scalar(IDA_mem->ida_nsetups);
+		buffer.scalar(IDA_mem->ida_nrSe);
+		buffer.scalar(IDA_mem->ida_ncfnS);
+		buffer.scalar(IDA_mem->ida_netfS);
+		buffer.scalar(IDA_mem->ida_nniS);
+		buffer.scalar(IDA_mem->ida_nsetupsS);
+
+		buffer.array(IDA_mem->ida_psi, MXORDP1);
+		buffer.array(IDA_mem->ida_alpha, MXORDP1);
+		buffer.array(IDA_mem->ida_beta, MXORDP1);
+		buffer.array(IDA_mem->ida_sigma, MXORDP1);
+		buffer.array(IDA_mem->ida_gamma, MXORDP1);
+
+		for (int j = 0; j <= maxCol; ++j)
+			buffer.array(NVEC_DATA(IDA_mem->ida_phi[j]), nDof);
+
+		for (int j = 0; j <= maxCol; ++j)
+		{
+			for (unsigned int i = 0; i < nSens; ++i)
+				buffer.array(NVEC_DATA(IDA_mem->ida_phiS[j][i]), nDof);
+		}
+
+		// Root finding (events)
+		buffer.scalar(IDA_mem->ida_nrtfn);
+		if (IDA_mem->ida_nrtfn > 0)
+		{
+			buffer.scalar(IDA_mem->ida_tlo);
+			buffer.scalar(IDA_mem->ida_irfnd);
+			buffer.scalar(IDA_mem->ida_nge);
+			buffer.array(IDA_mem->ida_glo, IDA_mem->ida_nrtfn);
+			buffer.array(IDA_mem->ida_gactive, IDA_mem->ida_nrtfn);
+		}
+
+		LOG(Debug) << "Checkpoint at t = " << t << " in section " << _curSec << " (" << _checkpointBuffer.size() << " entries)";
+
+		_checkpoint->saveCheckpoint(_curSec, t, _checkpointBuffer.data(), _checkpointBuffer.size());
+
+		_lastCheckpointSimTime = t;
+		_lastCheckpointWallTime = std::chrono::steady_clock::now();
+	}
+
+	void Simulator::restoreSimulatorState(StateBufferReader& buffer, double& t, double& tEnd)
+	{
+		const unsigned int nSens = _sensitiveParams.slices();
+		const unsigned int nDof = numDofs();
+
+		if (buffer.scalar<int>() != checkpointFormatVersion)
+			throw InvalidParameterException("Unsupported checkpoint format");
+
+		const int sundialsVersion = buffer.scalar<int>();
+		if (sundialsVersion != checkpointSundialsVersion)
+			throw InvalidParameterException("Checkpoint has been written with SUNDIALS version " + std::to_string(sundialsVersion)
+				+ ", but version " + std::to_string(checkpointSundialsVersion) + " is used");
+
+		if ((buffer.scalar<unsigned int>() != nDof) || (buffer.scalar<unsigned int>() != nSens)
+			|| (buffer.scalar<std::size_t>() != _sectionTimes.size()) || (buffer.scalar<std::size_t>() != _events.size()))
+			throw InvalidParameterException("Checkpoint does not match the configured simulation");
+
+		t = buffer.scalar<double>();
+		tEnd = buffer.scalar<double>();
+		_curSec = buffer.scalar<SectionIdx>();
+
+		if ((_curSec < _secRangeStart) || (static_cast<std::size_t>(_curSec) + 1 >= _sectionTimes.size()))
+			throw InvalidParameterException("Section " + std::to_string(_curSec) + " of checkpoint is outside of the integrated range");
+
+		// Section times may have been shifted by events
+		std::vector<double> secTimes(_sectionTimes.size());
+		buffer.array(secTimes.data(), secTimes.size());
+		buffer.vector(_sectionTimesBeforeEvents);
+		if (!_sectionTimesBeforeEvents.empty())
+		{
+			// Preserve the AD directions of SECTION_TIMES sensitivities
+			for (unsigned int i = 0; i < _sectionTimes.size(); ++i)
+				_sectionTimes[i] -= static_cast<double>(_sectionTimes[i]) - secTimes[i];
+
+			bool* const secCont = new bool[_sectionContinuity.size()];
+			std::copy(_sectionContinuity.begin(), _sectionContinuity.end(), secCont);
+
+			_model->setSectionTimes(secTimes.data(), secCont, secTimes.size() - 1);
+
+			delete[] secCont;
+		}
+
+		buffer.vector(_eventTimes);
+		buffer.vector(_eventIndices);
+
+		std::vector<double> skippedTime;
+		buffer.vector(skippedTime);
+		if (skippedTime.size() != _steadyStateSkippedTime.size())
+			throw InvalidParameterException("Steady-state detection of checkpoint does not match the configured simulation");
+		_steadyStateSkippedTime = std::move(skippedTime);
+
+		buffer.array(NVEC_DATA(_vecStateY), nDof);
+		buffer.array(NVEC_DATA(_vecStateYdot), nDof);
+		for (unsigned int i = 0; i < nSens; ++i)
+		{
+			buffer.array(NVEC_DATA(_vecFwdYs[i]), nDof);
+			buffer.array(NVEC_DATA(_vecFwdYsDot[i]), nDof);
+		}
+	}
+
+	void Simulator::restoreIntegratorState(StateBufferReader& buffer)
+	{
+		const unsigned int nSens = _sensitiveParams.slices();
+		const unsigned int nDof = numDofs();
+
+		IDAMem IDA_mem = static_cast<IDAMem>(_idaMemBlock);
+		const int maxCol = std::max(IDA_mem->ida_maxord, 3);
+		if (buffer.scalar<int>() != maxCol)
+			throw InvalidParameterException("Maximum BDF order of checkpoint does not match the configured time integrator");
+
+		IDA_mem->ida_kk = buffer.scalar<int>();
+		IDA_mem->ida_kused = buffer.scalar<int>();
+		IDA_mem->ida_knew = buffer.scalar<int>();
+		IDA_mem->ida_phase = buffer.scalar<int>();
+		IDA_mem->ida_ns = buffer.scalar<int>();
+		IDA_mem->ida_hh = buffer.scalar<double>();
+		IDA_mem->ida_hused = buffer.scalar<double>();
+		IDA_mem->ida_rr = buffer.scalar<double>();
+		IDA_mem->ida_tn = buffer.scalar<double>();
+		IDA_mem->ida_tretlast = buffer.scalar<double>();
+		IDA_mem->ida_cj = buffer.scalar<double>();
+		IDA_mem->ida_cjlast = buffer.scalar<double>();
+		IDA_mem->ida_cjold = buffer.scalar<double>();
+		IDA_mem->ida_cjratio = buffer.scalar<double>();
+		IDA_mem->ida_ss = buffer.scalar<double>();
+		IDA_mem->ida_ssS = buffer.scalar<double>();
+		IDA_mem->ida_epsNewt = buffer.scalar<double>();
+
+		IDA_mem->ida_nst = buffer.scalar<long int>();
+		IDA_mem->ida_nre = buffer.scalar<long int>();
+		IDA_mem->ida_ncfn = buffer.scalar<long int>();
+		IDA_mem->ida_netf = buffer.scalar<long int>();
+		IDA_mem->ida_nni = buffer.scalar<long int>();
+		IDA_mem->ida_nsetups = buffer.scalar<long int>();
+		IDA_mem->ida_nrSe = buffer.scalar<long int>();
+		IDA_mem->ida_ncfnS = buffer.scalar<long int>();
+		IDA_mem->ida_netfS = buffer.scalar<long int>();
+		IDA_mem->ida_nniS = buffer.scalar<long int>();
+		IDA_mem->ida_nsetupsS = buffer.scalar<long int>();
+
+		buffer.array(IDA_mem->ida_psi, MXORDP1);
+		buffer.array(IDA_mem->ida_alpha, MXORDP1);
+		buffer.array(IDA_mem->ida_beta, MXORDP1);
+		buffer.array(IDA_mem->ida_sigma, MXORDP1);
+		buffer.array(IDA_mem->ida_gamma, MXORDP1);
+
+		for (int j = 0; j <= maxCol; ++j)
+			buffer.array(NVEC_DATA(IDA_mem->ida_phi[j]), nDof);
+
+		for (int j = 0; j <= maxCol; ++j)
+		{
+			for (unsigned int i = 0; i < nSens; ++i)
+				buffer.array(NVEC_DATA(IDA_mem->ida_phiS[j][i]), nDof);
+		}
+
+		if (buffer.scalar<int>() != IDA_mem->ida_nrtfn)
+			throw InvalidParameterException("Events of checkpoint do not match the configured simulation");
+
+		if (IDA_mem->ida_nrtfn > 0)
+		{
+			IDA_mem->ida_tlo = buffer.scalar<double>();
+			IDA_mem->ida_irfnd = buffer.scalar<int>();
+			IDA_mem->ida_nge = buffer.scalar<long int>();
+			buffer.array(IDA_mem->ida_glo, IDA_mem->ida_nrtfn);
+			buffer.array(IDA_mem->ida_gactive, IDA_mem->ida_nrtfn);
+		}
+
+		if (!buffer.atEnd())
+			throw InvalidParameterException("Checkpoint contains unexpected trailing data");
+
+		// Error weights are usually updated after each step
+		IDA_mem->ida_efun(IDA_mem->ida_phi[0], IDA_mem->ida_ewt, IDA_mem->ida_edata);
+	}
+
 } // namespace cadet
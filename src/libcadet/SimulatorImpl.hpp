@@ -20,6 +20,7 @@
 
 #include <vector>
 #include <unordered_map>
+#include <chrono>
 
 #include "SundialsVector.hpp"
 #include <idas/idas_impl.h>
@@ -27,7 +28,11 @@
 #include "cadet/Simulator.hpp"
 #include "AutoDiff.hpp"
 #include "SlicedVector.hpp"
+#include "ParamIdUtil.hpp"
 #include "common/Timer.hpp"
+#include "common/StateBuffer.hpp"
+#include "linalg/EisenstatWalker.hpp"
+#include "timeint/RadauIIA.hpp"
 
 namespace cadet
 {
@@ -40,6 +45,8 @@ int residualSensWrapper(int ns, double t, N_Vector y, N_Vector yDot, N_Vector re
 		N_Vector* yS, N_Vector* ySDot, N_Vector* resS,
 		void *userData, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
 
+int eventRootWrapper(double t, N_Vector y, N_Vector yDot, double* gout, void* userData);
+
 //int weightWrapper(N_Vector y, N_Vector ewt, void *user_data);
 
 class ISimulatableModel;
@@ -69,11 +76,16 @@ public:
 	virtual void setSensitiveParameter(ParameterId const* ids, double const* diffFactors, unsigned int numParams, double absTolS);
 	virtual void setSensitiveParameter(ParameterId const* ids, unsigned int numParams, double absTolS);
 	virtual void setParameterValue(const ParameterId& id, double value);
+	virtual bool resolveParameterHandles(ParameterId const* ids, unsigned int numParams, ParameterHandle* handles);
+	virtual void setParameterValues(ParameterHandle const* handles, double const* values, unsigned int numParams);
+	virtual void setSensitiveParameterValues(double const* values);
+	virtual void clearParameterHandles() CADET_NOEXCEPT;
 
 	virtual void setSolutionTimes(const std::vector<double>& solutionTimes);
 	virtual const std::vector<double>& getSolutionTimes() const;
 	virtual void setSectionTimes(const std::vector<double>& sectionTimes);
 	virtual void setSectionTimes(const std::vector<double>& sectionTimes, const std::vector<bool>& sectionContinuity);
+	virtual void setSectionRange(unsigned int startSec, unsigned int endSec);
 
 	virtual void initializeModel(IModelSystem& model);
 
@@ -93,6 +105,26 @@ public:
 
 	virtual void integrate();
 
+	virtual void addEvent(const SimulationEvent& evt);
+	virtual void clearEvents() CADET_NOEXCEPT;
+	virtual unsigned int numEvents() const CADET_NOEXCEPT { return _events.size(); }
+	virtual const std::vector<double>& getEventTimes() const CADET_NOEXCEPT { return _eventTimes; }
+	virtual const std::vector<unsigned int>& getEventIndices() const CADET_NOEXCEPT { return _eventIndices; }
+
+	virtual void setSteadyStateDetection(const std::vector<bool>& sections, double tol);
+	virtual const std::vector<double>& getSteadyStateSkippedTimes() const CADET_NOEXCEPT { return _steadyStateSkippedTime; }
+
+	virtual void setAdaptiveLinearSolverTolerance(bool enabled) CADET_NOEXCEPT { _adaptiveLinearTol = enabled; }
+	virtual void setStepStatisticsRecording(bool enabled) CADET_NOEXCEPT { _recordStepStats = enabled; }
+	virtual const std::vector<StepStatistics>& getStepStatistics() const CADET_NOEXCEPT { return _stepStats; }
+	virtual const IntegratorStatistics& getIntegratorStatistics() const CADET_NOEXCEPT { return _intStats; }
+
+	virtual void setTimeIntegrator(TimeIntegrator ti) { _timeIntegrator = ti; }
+	virtual TimeIntegrator getTimeIntegrator() const CADET_NOEXCEPT { return _timeIntegrator; }
+
+	virtual void setCheckpointing(double wallTime, double simTime, ICheckpointCallback* callback);
+	virtual void restoreCheckpoint(double const* state, unsigned int len);
+
 	virtual double const* getLastSolution(unsigned int& len) const;
 	virtual double const* getLastSolutionDerivative(unsigned int& len) const;
 
@@ -119,6 +151,7 @@ public:
 	virtual void setMaxErrorTestFails(unsigned int nFails);
 	virtual void setMaxConvergenceFails(unsigned int nFails);
 	virtual void setMaxSensNewtonIteration(unsigned int nIter);
+	virtual void setMaxRadauNewtonIteration(unsigned int nIter);
 
 	virtual bool reconfigureModel(IParameterProvider& paramProvider);
 	virtual bool reconfigureModel(IParameterProvider& paramProvider, unsigned int unitOpIdx);
@@ -203,6 +236,42 @@ protected:
 	 */
 	void resetSensParams();
 
+	/**
+	 * @brief Resolves a parameter to a handle
+	 * @details Adds a handle that stores the locations of all values affected by the parameter.
+	 *          If the model cannot resolve the parameter, it is set by the model on update.
+	 * @param [in] id Parameter Id
+	 * @param [in] sectionTimes Determines whether matching SECTION_TIMES are included in the handle
+	 * @return Handle of the parameter
+	 */
+	ParameterHandle resolveParameterHandle(const ParameterId& id, bool sectionTimes);
+
+	/**
+	 * @brief Collects the locations of all values affected by a parameter
+	 * @param [in] id Parameter Id
+	 * @param [in] sectionTimes Determines whether matching SECTION_TIMES are included
+	 * @param [out] storage Receives the locations of the affected values
+	 * @return @c true if the parameter is fully resolved, @c false if it has to be set by the model
+	 */
+	bool collectParameterStorage(const ParameterId& id, bool sectionTimes, std::vector<active*>& storage);
+
+	/**
+	 * @brief Resolves all existing parameter handles again
+	 * @details Keeps the handles valid if the underlying values have been reallocated
+	 *          (e.g., by setting the section times or reconfiguring the model).
+	 */
+	void rebindParameterHandles();
+
+	/**
+	 * @brief Sets the value of a parameter given by its handle
+	 * @details Throws an InvalidParameterException if the handle is invalid.
+	 * @param [in] handle Handle of the parameter
+	 * @param [in] value Value of the parameter
+	 * @param [in] sensitive Determines whether parameters that cannot be written directly are set by
+	 *                       ISimulatableModel::setSensitiveParameterValue() instead of ISimulatableModel::setParameter()
+	 */
+	void writeParameterHandle(ParameterHandle handle, double value, bool sensitive);
+
 	/**
 	 * @brief Updates the error tolerances in IDAS
 	 * @details Sets the absolute and relative error tolerances in IDAS. If the absolute error
@@ -213,16 +282,149 @@ protected:
 	 */
 	void updateMainErrorTolerances();
 
+	/**
+	 * @brief Expands the vector of absolute error tolerances to all DOFs of the model
+	 * @details Requires a model and more than one absolute error tolerance. Missing tolerances
+	 *          of coupling DOFs are calculated by the model.
+	 * @param [out] absTol Absolute error tolerance of each DOF of the model
+	 */
+	void expandAbsoluteErrorTolerance(double* const absTol) const;
+
+	/**
+	 * @brief Passes the time integrator settings (step limits, iteration limits, tolerances) on to IDAS
+	 * @details If IDAS has not been initialized yet, nothing happens.
+	 */
+	void applyTimeIntegratorSettings();
+
+	/**
+	 * @brief Passes the time integrator settings (step limits, iteration limits, tolerances) on to RadauIIA
+	 * @details Allocates memory of RadauIIA for the current model and resets its counters.
+	 */
+	void applyRadauSettings();
+
+	/**
+	 * @brief Integrates a continuous slice of sections using RadauIIA
+	 * @details Replaces the IDAS loop of integrate() after RadauIIA has been reinitialized at the
+	 *          beginning of the slice. Solutions at user specified times are obtained from the
+	 *          collocation polynomial of the step they lie in.
+	 * @param [in,out] curT Current time
+	 * @param [in] endTime End time of the slice
+	 * @param [in] tStart Start time of the time integration (for progress notifications)
+	 * @param [in] tEnd End time of the time integration (for progress notifications)
+	 * @param [in,out] it Next user specified solution time
+	 * @return @c true if the slice has been integrated, @c false if the user aborted the time integration
+	 */
+	bool integrateRadau(double& curT, double endTime, double tStart, double tEnd, std::vector<double>::const_iterator& it);
+
+	/**
+	 * @brief Determines the locations of the monitored quantities in the global state vector
+	 * @details Registers the event functions with IDAS. Has to be called before the time integration starts.
+	 */
+	void setupEvents();
+
+	/**
+	 * @brief Handles events that have been located by IDAS at the current time point @p t
+	 * @details Records the triggered events and performs their actions. If the next section is
+	 *          requested, the section times are shifted and sent to the model.
+	 * @param [in] t Current time
+	 * @return Action that has to be performed by the time integration loop
+	 */
+	EventAction handleEvents(double t);
+
+	/**
+	 * @brief Returns whether steady-state detection is enabled in the given section
+	 * @param [in] secIdx Index of the section
+	 * @return @c true if steady-state detection is enabled, otherwise @c false
+	 */
+	bool steadyStateDetectionEnabled(unsigned int secIdx) const CADET_NOEXCEPT;
+
+	/**
+	 * @brief Checks whether the current state is steady until the given end time
+	 * @details See setSteadyStateDetection() for the criterion.
+	 * @param [in] t Current time
+	 * @param [in] secIdx Index of the current section
+	 * @param [in] tEnd Time up to which the state is held constant
+	 * @return @c true if the state is steady, otherwise @c false
+	 */
+	bool isSteadyState(double t, unsigned int secIdx, double tEnd);
+
+	/**
+	 * @brief Returns whether a checkpoint is due at the given time @p t
+	 * @param [in] t Current time
+	 * @return @c true if the wall clock or simulation time interval has elapsed since the last checkpoint, otherwise @c false
+	 */
+	bool checkpointDue(double t) const;
+
+	/**
+	 * @brief Serializes the current state of the time integration and hands it to the checkpoint callback
+	 * @param [in] t Current time
+	 * @param [in] tEnd End time of the current continuous slice of sections
+	 */
+	void writeCheckpoint(double t, double tEnd);
+
+	/**
+	 * @brief Restores the section times, events, and state vectors of a checkpoint
+	 * @details Reads the first part of a checkpoint written by writeCheckpoint(). Afterwards,
+	 *          the @p buffer is positioned at the internal state of IDAS, which is restored by
+	 *          restoreIntegratorState() once IDAS has been reinitialized.
+	 * @param [in,out] buffer Checkpoint data
+	 * @param [out] t Time of the checkpoint
+	 * @param [out] tEnd End time of the continuous slice of sections the checkpoint belongs to
+	 */
+	void restoreSimulatorState(StateBufferReader& buffer, double& t, double& tEnd);
+
+	/**
+	 * @brief Restores the internal state of IDAS (step size, order, history array)
+	 * @details Has to be called after IDAS has been reinitialized in the section of the checkpoint.
+	 * @param [in,out] buffer Checkpoint data positioned by restoreSimulatorState()
+	 */
+	void restoreIntegratorState(StateBufferReader& buffer);
+
+	/**
+	 * @brief Computes the forcing term for the linear solve of the current Newton iteration
+	 * @details Starts a new residual history if time point or @f$ \alpha @f$ have changed since
+	 *          the last call, that is, if a new Newton iteration has been started.
+	 * @param [in] t Current time point
+	 * @param [in] alpha Value of @f$ \alpha @f$ (arises from BDF time discretization)
+	 * @param [in] rhs Current Newton residual
+	 * @param [in] weight Error weights
+	 * @return Forcing term
+	 */
+	double forcingTerm(double t, double alpha, double const* rhs, double const* weight);
+
+	/**
+	 * @brief Accounts a linear solve (i.e., a Newton iteration) in the step statistics
+	 * @details Starts a new record if IDAS has taken a step since the last call.
+	 * @param [in] IDA_mem IDAS memory
+	 */
+	void updateStepStatistics(IDAMem IDA_mem);
+
+	/**
+	 * @brief Completes the record of the current step and appends it to the step statistics
+	 */
+	void finishStepStatistics();
+
+	/**
+	 * @brief Adds the counters of the time integrator to the integrator statistics
+	 * @details Has to be called before IDAS is reinitialized, which resets its counters.
+	 *          The counters of RadauIIA are reset after they have been added.
+	 */
+	void accumulateIntegratorStatistics();
+
 	friend int ::cadet::residualDaeWrapper(double t, N_Vector y, N_Vector yDot, N_Vector res, void* userData);
 
 	friend int ::cadet::linearSolveWrapper(IDAMem IDA_mem, N_Vector rhs, N_Vector weight, N_Vector yCur, N_Vector yDotCur, N_Vector resCur);
 
+	friend int ::cadet::eventRootWrapper(double t, N_Vector y, N_Vector yDot, double* gout, void* userData);
+
 //	friend int ::cadet::weightWrapper(N_Vector y, N_Vector ewt, void *user_data);
 
 	friend int ::cadet::residualSensWrapper(int ns, double t, N_Vector y, N_Vector yDot, N_Vector res, 
 			N_Vector* yS, N_Vector* ySDot, N_Vector* resS,
 			void *userData, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
 
+	class RadauSystem;
+
 	ISimulatableModel* _model; //!< Simulated model, not owned by the Simulator
 
 	ISolutionRecorder* _solRecorder;
@@ -243,9 +445,18 @@ protected:
 	N_Vector _vecStateYdot; //!< IDAS state vector time derivative
 	N_Vector* _vecFwdYs; //!< IDAS sensitivities vector	
 	N_Vector* _vecFwdYsDot; //!< IDAS sensitivities vector time derivative
+	unsigned int _numFwdSensVecs; //!< Number of allocated sensitivity vectors in _vecFwdYs and _vecFwdYsDot
+	unsigned int _numIdaSens; //!< Number of sensitivity systems IDAS has been initialized with (0 if not initialized)
 	util::SlicedVector<ParameterId> _sensitiveParams; //!< Stores (fused) sensitive parameters
 	std::vector<double> _sensitiveParamsFactor; //!< Stores the factors of the linear sensitive parameter combinations
 	std::vector<active> _sectionTimes; //!< Stores the AD variables used for SECTION_TIMES parameter derivatives
+	util::SlicedVector<active*> _paramHandleStorage; //!< Locations of the values affected by each parameter handle (one slice per handle)
+	std::vector<ParameterId> _paramHandleIds; //!< Parameter ID of each parameter handle
+	std::vector<bool> _paramHandleDirect; //!< Determines whether a parameter handle is fully resolved or has to be set by the model
+	std::vector<bool> _paramHandleSecTimes; //!< Determines whether a parameter handle includes matching SECTION_TIMES
+	std::unordered_map<ParameterId, ParameterHandle> _paramHandleLookup[2]; //!< Existing handles of each parameter without (index 0) and with (index 1) SECTION_TIMES
+	ParameterHandle _paramHandleOffset; //!< First valid parameter handle, handles below have been invalidated
+	std::vector<ParameterHandle> _sensParamHandles; //!< Parameter handles of the individual (fused) sensitive parameters
 	
 	double _relTolS; //!< Relative tolerance for forward sensitivity systems in the time integration
 	std::vector<double> _absTolS; //!< Absolute tolerances for forward sensitivity systems in the time integration
@@ -263,8 +474,11 @@ protected:
 	unsigned int _maxErrorTestFail; //!< Maximum number of local time integration error test failures
 	unsigned int _maxConvTestFail; //!< Maximum number of Newton iteration failures
 	unsigned int _maxNewtonIterSens; //!< Maximum number of Newton iterations for forward sensitivity systems
+	unsigned int _maxNewtonIterRadau; //!< Maximum number of Newton iterations of the Radau IIA time integrator
 
 	SectionIdx _curSec; //!< Index of the current section
+	unsigned int _secRangeStart; //!< Index of the first section integrated by integrate()
+	unsigned int _secRangeEnd; //!< Index of the section after the last one integrated by integrate() (0 denotes the last section)
 
 	bool _skipConsistencyStateY; //!< Flag that determines whether the consistent initialization is skipped
 	bool _skipConsistencySensitivity; //!< Flag that determines whether the consistent initialization of the sensitivity systems is skipped
@@ -279,6 +493,48 @@ protected:
 	double _lastIntTime; //!< Last simulation duration
 
 	INotificationCallback* _notification; //!< Callback handler for notifications
+
+	std::vector<SimulationEvent> _events; //!< Events monitored during time integration
+	std::vector<unsigned int> _eventOffset; //!< Index of the first monitored DOF of each event in the global state vector
+	std::vector<unsigned int> _eventStride; //!< Stride between components of the monitored outlet of each event
+	std::vector<unsigned int> _eventNumComp; //!< Number of components of the monitored outlet of each event
+	std::vector<int> _eventRootsFound; //!< Buffer for root information returned by IDAS
+	std::vector<double> _eventTimes; //!< Times at which events have been triggered
+	std::vector<unsigned int> _eventIndices; //!< Indices of triggered events
+	std::vector<double> _sectionTimesBeforeEvents; //!< Original section times if they have been shifted by an event
+
+	std::vector<bool> _steadyStateSections; //!< Determines in which sections steady-state detection is enabled (one element applies to all sections)
+	double _steadyStateTol; //!< Tolerance of the steady-state test
+	std::vector<double> _steadyStateSkippedTime; //!< Time skipped by steady-state detection in each section
+	std::vector<double> _steadyStateBuffer; //!< Buffer for error weights and residual used in the steady-state test
+
+	ICheckpointCallback* _checkpoint; //!< Receives checkpoints, not owned by the Simulator
+	double _checkpointWallTime; //!< Wall clock time in seconds between two checkpoints (non-positive disables)
+	double _checkpointSimTime; //!< Simulation time between two checkpoints (non-positive disables)
+	double _lastCheckpointSimTime; //!< Simulation time of the last checkpoint
+	std::chrono::steady_clock::time_point _lastCheckpointWallTime; //!< Wall clock time of the last checkpoint
+	std::vector<double> _checkpointBuffer; //!< Buffer holding the serialized state of a checkpoint
+	std::vector<double> _resumeState; //!< Checkpoint the next call to integrate() resumes from (empty if none)
+
+	bool _adaptiveLinearTol; //!< Determines whether iterative linear solvers use adaptive tolerances (if no sensitivities are computed)
+	bool _forcingTermActive; //!< Determines whether forcing terms are passed to linearSolve() in the current time integration
+	linalg::EisenstatWalker _forcingTerm; //!< Computes forcing terms from the history of the Newton residual
+	double _forcingTime; //!< Time point of the current Newton iteration
+	double _forcingAlpha; //!< Value of alpha of the current Newton iteration
+
+	bool _recordStepStats; //!< Determines whether statistics of each time step are recorded
+	std::vector<StepStatistics> _stepStats; //!< Statistics of each time step
+	StepStatistics _curStepStats; //!< Statistics of the current time step
+	long int _curStepIdx; //!< Number of steps taken by IDAS before the current step (@c -1 if there is no current step)
+	long int _curStepConvFails; //!< Number of convergence failures of IDAS at the beginning of the current step
+	long int _curStepErrTestFails; //!< Number of error test failures of IDAS at the beginning of the current step
+	unsigned long _curStepLinearIter; //!< Number of iterations of iterative linear solvers at the beginning of the current step
+
+	IntegratorStatistics _intStats; //!< Accumulated statistics of the time integrator
+	unsigned long _intStatsLinearIter; //!< Number of iterations of iterative linear solvers of the model at the last update of the integrator statistics
+
+	TimeIntegrator _timeIntegrator; //!< Time integration method
+	timeint::RadauIIA _radau; //!< Radau IIA time integrator (used instead of IDAS if selected)
 };
 
 } // namespace cadet
@@ -149,6 +149,23 @@ public:
 	 */
 	virtual void setSensitiveParameterValue(const ParameterId& id, double value) = 0;
 
+	/**
+	 * @brief Resolves the storage of a parameter
+	 * @details Appends the addresses of all values that are set by setParameter() to @p storage, including
+	 *          all multiplexed copies of the parameter. Writing a value to each address is then equivalent to
+	 *          calling setParameter(), which allows to skip the parameter lookup on repeated updates.
+	 *          
+	 *          Some parameters cannot be written directly since changing them requires further updates of
+	 *          the unit operation (e.g., of derived quantities or caches). In this case, @c false is returned
+	 *          and the contents of @p storage are undefined. Such parameters have to be set by setParameter().
+	 *          
+	 *          The addresses are invalidated when the unit operation is (re)configured.
+	 * @param [in] pId Parameter ID
+	 * @param [in,out] storage Vector the addresses of the parameter values are appended to
+	 * @return @c true if the parameter can be written directly, otherwise @c false
+	 */
+	virtual bool resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage) = 0;
+
 	/**
 	 * @brief Clears all sensitive parameters
 	 */
@@ -239,6 +256,24 @@ public:
 	virtual int linearSolve(double t, double alpha, double tol, double* const rhs, double const* const weight,
 		const ConstSimulationState& simState) = 0;
 
+	/**
+	 * @brief Selects the meaning of the tolerance passed to linearSolve()
+	 * @details By default, the tolerance @c tol passed to linearSolve() is the tolerance of the outer
+	 *          Newton iteration, which is scaled by a safety factor before it is used by iterative
+	 *          linear solvers. If adaptive tolerances are enabled, @c tol is a forcing term @f$ \eta @f$
+	 *          and iterative linear solvers reduce their residual relative to their right hand side by
+	 *          this factor.
+	 *
+	 * @param [in] adaptive Determines whether the tolerance passed to linearSolve() is a forcing term
+	 */
+	virtual void setAdaptiveLinearSolverTolerance(bool adaptive) CADET_NOEXCEPT = 0;
+
+	/**
+	 * @brief Returns the total number of iterations of iterative linear solvers in linearSolve()
+	 * @return Number of iterations of iterative linear solvers
+	 */
+	virtual unsigned long numLinearSolverIterations() const CADET_NOEXCEPT = 0;
+
 	/**
 	 * @brief Prepares the AD system vectors by constructing seed vectors
 	 * @details Sets the seed vectors used in AD. Since the AD vector slice is fully managed by the model,
@@ -392,9 +427,13 @@ public:
 	 * @brief Computes the residual of the forward sensitivity systems using the result of residualSensFwdAdOnly()
 	 * @details Assembles and evaluates the residuals of the sensitivity systems
 	 *          @f[ \frac{F}{\partial y} s + \frac{F}{\partial \dot{y}} \dot{s} + \frac{\partial F}{\partial p_i} = 0. @f]
+	 *          
+	 *          A @c nullptr in @p yS marks a sensitivity that is structurally zero in this unit operation
+	 *          (i.e., the parameter neither belongs to the unit operation nor reaches it through the
+	 *          flowsheet). Such sensitivities are skipped and the caller takes care of their residuals.
 	 * @param [in] simTime Simulation time information (time point, section index, pre-factor of time derivatives)
 	 * @param [in] simState State of the simulation (state vector and its time derivative)
-	 * @param [in] yS Pointers to local sensitivity state vectors
+	 * @param [in] yS Pointers to local sensitivity state vectors, @c nullptr for structurally zero sensitivities
 	 * @param [in] ySdot Pointers to local sensitivity time derivative state vectors
 	 * @param [out] resS Pointers to local sensitivity residuals
 	 * @param [in] adRes Pointer to local residual vector of AD datatypes with the sensitivity derivatives from residualSensFwdAdOnly()
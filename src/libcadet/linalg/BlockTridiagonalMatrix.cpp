@@ -0,0 +1,190 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "linalg/BlockTridiagonalMatrix.hpp"
+
+namespace cadet
+{
+
+namespace linalg
+{
+
+void BlockTridiagonalMatrix::resize(unsigned int nBlocks, unsigned int blockSize)
+{
+	_nBlocks = nBlocks;
+	_blockSize = blockSize;
+
+	const unsigned int nDiag = nBlocks * blockSize;
+	_diag.resize(nDiag * blockSize, 0.0);
+	_lower.resize(nDiag, 0.0);
+	_upper.resize(nDiag, 0.0);
+	_coupling.resize(nDiag * blockSize, 0.0);
+	_couplingCols.resize(nDiag, 0);
+	_numCouplingCols.resize(nBlocks, 0);
+	_pivot.resize(nDiag, 0);
+}
+
+void BlockTridiagonalMatrix::setAll(double val)
+{
+	std::fill(_diag.begin(), _diag.end(), val);
+	std::fill(_lower.begin(), _lower.end(), val);
+	std::fill(_upper.begin(), _upper.end(), val);
+}
+
+bool BlockTridiagonalMatrix::factorize()
+{
+	const unsigned int s = _blockSize;
+	const unsigned int ss = s * s;
+
+	lapackInt_t n = s;
+	lapackInt_t flag = 0;
+
+	// For LAPACK the row-major blocks look like they are transposed. We, thus,
+	// solve the transposed equation which uses the original matrix.
+	char trans[] = "T";
+
+	for (unsigned int k = 0; k < _nBlocks; ++k)
+	{
+		double* const sk = _diag.data() + k * ss;
+		lapackInt_t* const piv = _pivot.data() + k * s;
+
+		if (k > 0)
+		{
+			// S_k = D_k - L_k * W_{k-1}, only nonzero columns of W_{k-1} contribute
+			double const* const w = _coupling.data() + (k - 1) * ss;
+			unsigned int const* const wCols = _couplingCols.data() + (k - 1) * s;
+			double const* const l = _lower.data() + k * s;
+
+			for (unsigned int c = 0; c < _numCouplingCols[k - 1]; ++c)
+			{
+				const unsigned int j = wCols[c];
+				double const* const wCol = w + c * s;
+				for (unsigned int i = 0; i < s; ++i)
+					sk[i * s + j] -= l[i] * wCol[i];
+			}
+		}
+
+		// Since LAPACK uses column-major storage and we use row-major,
+		// we actually factorize the transposed matrix
+		LapackFactorDense(&n, &n, sk, &n, piv, &flag);
+		if (flag != 0)
+			return false;
+
+		if (k + 1 >= _nBlocks)
+			break;
+
+		// W_k = S_k^{-1} U_k, only for nonzero columns of U_k (packed column-major)
+		double* const w = _coupling.data() + k * ss;
+		unsigned int* const wCols = _couplingCols.data() + k * s;
+		double const* const u = _upper.data() + k * s;
+
+		unsigned int nCols = 0;
+		for (unsigned int j = 0; j < s; ++j)
+		{
+			if (u[j] == 0.0)
+				continue;
+
+			double* const wCol = w + nCols * s;
+			std::fill(wCol, wCol + s, 0.0);
+			wCol[j] = u[j];
+			wCols[nCols] = j;
+			++nCols;
+		}
+		_numCouplingCols[k] = nCols;
+
+		if (nCols == 0)
+			continue;
+
+		lapackInt_t nrhs = nCols;
+		LapackSolveDense(trans, &n, &nrhs, sk, &n, piv, w, &n, &flag);
+		if (flag != 0)
+			return false;
+	}
+
+	return true;
+}
+
+bool BlockTridiagonalMatrix::solve(double* const rhs) const
+{
+	const unsigned int s = _blockSize;
+	const unsigned int ss = s * s;
+
+	lapackInt_t n = s;
+	lapackInt_t nrhs = 1;
+	lapackInt_t flag = 0;
+	char trans[] = "T";
+
+	// Forward sweep: z_k = S_k^{-1} (b_k - L_k z_{k-1})
+	for (unsigned int k = 0; k < _nBlocks; ++k)
+	{
+		double* const bk = rhs + k * s;
+		if (k > 0)
+		{
+			double const* const zPrev = rhs + (k - 1) * s;
+			double const* const l = _lower.data() + k * s;
+			for (unsigned int i = 0; i < s; ++i)
+				bk[i] -= l[i] * zPrev[i];
+		}
+
+		LapackSolveDense(trans, &n, &nrhs, const_cast<double*>(_diag.data() + k * ss), &n, const_cast<lapackInt_t*>(_pivot.data() + k * s), bk, &n, &flag);
+		if (flag != 0)
+			return false;
+	}
+
+	// Backward sweep: x_k = z_k - W_k x_{k+1}
+	for (int k = static_cast<int>(_nBlocks) - 2; k >= 0; --k)
+	{
+		double* const xk = rhs + k * s;
+		double const* const xNext = rhs + (k + 1) * s;
+		double const* const w = _coupling.data() + k * ss;
+		unsigned int const* const wCols = _couplingCols.data() + k * s;
+
+		for (unsigned int c = 0; c < _numCouplingCols[k]; ++c)
+		{
+			const double xj = xNext[wCols[c]];
+			double const* const wCol = w + c * s;
+			for (unsigned int i = 0; i < s; ++i)
+				xk[i] -= wCol[i] * xj;
+		}
+	}
+
+	return true;
+}
+
+void BlockTridiagonalMatrix::multiplyVector(double const* const x, double* const y) const
+{
+	const unsigned int s = _blockSize;
+	for (unsigned int k = 0; k < _nBlocks; ++k)
+	{
+		double const* const d = _diag.data() + k * s * s;
+		double const* const xk = x + k * s;
+		double* const yk = y + k * s;
+
+		for (unsigned int i = 0; i < s; ++i)
+		{
+			double sum = 0.0;
+			for (unsigned int j = 0; j < s; ++j)
+				sum += d[i * s + j] * xk[j];
+
+			if (k > 0)
+				sum += _lower[k * s + i] * x[(k - 1) * s + i];
+			if (k + 1 < _nBlocks)
+				sum += _upper[k * s + i] * x[(k + 1) * s + i];
+
+			yk[i] = sum;
+		}
+	}
+}
+
+} // namespace linalg
+
+} // namespace cadet
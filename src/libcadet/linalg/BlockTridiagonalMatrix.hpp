@@ -0,0 +1,257 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Implements a block tridiagonal matrix with dense diagonal blocks and diagonal off-diagonal blocks
+ */
+
+#ifndef LIBCADET_BLOCKTRIDIAGONALMATRIX_HPP_
+#define LIBCADET_BLOCKTRIDIAGONALMATRIX_HPP_
+
+#include "cadet/cadetCompilerInfo.hpp"
+#include "common/CompilerSpecific.hpp"
+#include "LapackInterface.hpp"
+#include "DenseMatrix.hpp"
+
+#include <vector>
+#include <algorithm>
+
+namespace cadet
+{
+
+namespace linalg
+{
+
+/**
+ * @brief Block tridiagonal matrix with dense diagonal blocks and diagonal off-diagonal blocks
+ * @details The matrix consists of @f$ n @f$ square blocks of size @f$ s @f$ on its diagonal. The
+ *          blocks on the first sub- and superdiagonal are diagonal matrices:
+ *          @f[ \begin{pmatrix} D_0 & U_0 & & \\ L_1 & D_1 & U_1 & \\ & \ddots & \ddots & \ddots \\ & & L_{n-1} & D_{n-1} \end{pmatrix}. @f]
+ *          This is the structure of the particle Jacobian of the general rate model if there is no
+ *          surface diffusion (the shells are only coupled by pore diffusion of the mobile phase).
+ *
+ *          The matrix is factorized by the block Thomas algorithm (block LU decomposition without
+ *          pivoting across blocks): @f$ S_0 = D_0 @f$, @f$ W_k = S_k^{-1} U_k @f$, and
+ *          @f$ S_k = D_k - L_k W_{k-1} @f$. The Schur complements @f$ S_k @f$ are LU factorized with
+ *          partial pivoting by LAPACK. Only the columns of @f$ W_k @f$ that correspond to nonzero
+ *          entries of @f$ U_k @f$ are computed. Compared to a banded LU factorization with bandwidth
+ *          @f$ s @f$, this avoids fill-in and pivoting over the full band.
+ *
+ *          The dense blocks are stored in row-major ordering. The matrix is factorized in-place.
+ */
+class BlockTridiagonalMatrix
+{
+public:
+
+	BlockTridiagonalMatrix() CADET_NOEXCEPT : _nBlocks(0), _blockSize(0) { }
+	~BlockTridiagonalMatrix() CADET_NOEXCEPT { }
+
+	// Default copy and assignment semantics
+	BlockTridiagonalMatrix(const BlockTridiagonalMatrix& cpy) = default;
+	BlockTridiagonalMatrix(BlockTridiagonalMatrix&& cpy) CADET_NOEXCEPT = default;
+
+	BlockTridiagonalMatrix& operator=(const BlockTridiagonalMatrix& cpy) = default;
+
+#ifdef COMPILER_SUPPORT_NOEXCEPT_DEFAULTED_MOVE
+	BlockTridiagonalMatrix& operator=(BlockTridiagonalMatrix&& cpy) CADET_NOEXCEPT = default;
+#else
+	BlockTridiagonalMatrix& operator=(BlockTridiagonalMatrix&& cpy) = default;
+#endif
+
+	/**
+	 * @brief Allocates memory for the given number of blocks
+	 * @details Existing content is lost.
+	 * @param [in] nBlocks Number of diagonal blocks
+	 * @param [in] blockSize Size of a (square) block
+	 */
+	void resize(unsigned int nBlocks, unsigned int blockSize);
+
+	/**
+	 * @brief Sets all matrix elements to the given value
+	 * @param [in] val Value all matrix elements are set to
+	 */
+	void setAll(double val);
+
+	/**
+	 * @brief Copies the block tridiagonal pattern of a banded matrix
+	 * @details Entries of the banded matrix that are not part of the block tridiagonal pattern
+	 *          (i.e., off-diagonal entries of the off-diagonal blocks) are ignored. The banded
+	 *          matrix has to be assembled but not factorized.
+	 * @param [in] bm Banded matrix (e.g., BandMatrix or FactorizableBandMatrix) of size `rows()`
+	 * @tparam BandMatrix_t Type of the banded matrix
+	 */
+	template <class BandMatrix_t>
+	void copyOver(const BandMatrix_t& bm)
+	{
+		cadet_assert(bm.rows() == rows());
+
+		const int s = static_cast<int>(_blockSize);
+		const int lb = static_cast<int>(bm.lowerBandwidth());
+		const int ub = static_cast<int>(bm.upperBandwidth());
+
+		for (int blk = 0; blk < static_cast<int>(_nBlocks); ++blk)
+		{
+			double* const d = _diag.data() + blk * s * s;
+			for (int i = 0; i < s; ++i)
+			{
+				const int row = blk * s + i;
+
+				// Columns of the diagonal block are consecutive diagonals of the banded matrix
+				double* const dRow = d + i * s;
+				const int jStart = std::max(0, i - lb);
+				const int jEnd = std::min(s - 1, i + ub);
+				std::fill(dRow, dRow + jStart, 0.0);
+				for (int j = jStart; j <= jEnd; ++j)
+					dRow[j] = bm(row, j - i);
+				std::fill(dRow + jEnd + 1, dRow + s, 0.0);
+
+				if (blk > 0)
+					_lower[row] = (lb >= s) ? bm(row, -s) : 0.0;
+				if (blk + 1 < static_cast<int>(_nBlocks))
+					_upper[row] = (ub >= s) ? bm(row, s) : 0.0;
+			}
+		}
+	}
+
+	/**
+	 * @brief Provides a view on a diagonal block
+	 * @details The view can be used to modify the diagonal block before factorization.
+	 * @param [in] blk Index of the block
+	 * @return Dense matrix view on @f$ D_{\text{blk}} @f$
+	 */
+	inline DenseMatrixView diagonalBlock(unsigned int blk)
+	{
+		cadet_assert(blk < _nBlocks);
+		return DenseMatrixView(_diag.data() + blk * _blockSize * _blockSize, _pivot.data() + blk * _blockSize, _blockSize, _blockSize);
+	}
+
+	/**
+	 * @brief Accesses an element of a diagonal block
+	 * @param [in] blk Index of the block
+	 * @param [in] row Row index within the block
+	 * @param [in] col Column index within the block
+	 * @return Matrix element @f$ (D_{\text{blk}})_{\text{row},\text{col}} @f$
+	 */
+	inline double& diagonalBlock(unsigned int blk, unsigned int row, unsigned int col)
+	{
+		cadet_assert(blk < _nBlocks);
+		cadet_assert(row < _blockSize);
+		cadet_assert(col < _blockSize);
+		return _diag[(blk * _blockSize + row) * _blockSize + col];
+	}
+
+	inline double diagonalBlock(unsigned int blk, unsigned int row, unsigned int col) const
+	{
+		cadet_assert(blk < _nBlocks);
+		cadet_assert(row < _blockSize);
+		cadet_assert(col < _blockSize);
+		return _diag[(blk * _blockSize + row) * _blockSize + col];
+	}
+
+	/**
+	 * @brief Accesses an element of a subdiagonal block
+	 * @param [in] blk Index of the block row, must be at least @c 1
+	 * @param [in] idx Index of the diagonal element
+	 * @return Matrix element @f$ (L_{\text{blk}})_{\text{idx},\text{idx}} @f$
+	 */
+	inline double& lowerDiagonal(unsigned int blk, unsigned int idx)
+	{
+		cadet_assert((blk >= 1) && (blk < _nBlocks));
+		cadet_assert(idx < _blockSize);
+		return _lower[blk * _blockSize + idx];
+	}
+
+	inline double lowerDiagonal(unsigned int blk, unsigned int idx) const
+	{
+		cadet_assert((blk >= 1) && (blk < _nBlocks));
+		cadet_assert(idx < _blockSize);
+		return _lower[blk * _blockSize + idx];
+	}
+
+	/**
+	 * @brief Accesses an element of a superdiagonal block
+	 * @param [in] blk Index of the block row, must be less than `numBlocks() - 1`
+	 * @param [in] idx Index of the diagonal element
+	 * @return Matrix element @f$ (U_{\text{blk}})_{\text{idx},\text{idx}} @f$
+	 */
+	inline double& upperDiagonal(unsigned int blk, unsigned int idx)
+	{
+		cadet_assert(blk + 1 < _nBlocks);
+		cadet_assert(idx < _blockSize);
+		return _upper[blk * _blockSize + idx];
+	}
+
+	inline double upperDiagonal(unsigned int blk, unsigned int idx) const
+	{
+		cadet_assert(blk + 1 < _nBlocks);
+		cadet_assert(idx < _blockSize);
+		return _upper[blk * _blockSize + idx];
+	}
+
+	/**
+	 * @brief Factorizes the matrix in-place using the block Thomas algorithm
+	 * @return @c true if the factorization was successful, otherwise @c false
+	 */
+	bool factorize();
+
+	/**
+	 * @brief Solves a system of linear equations using the factorized matrix
+	 * @details The matrix has to be factorized by factorize() before.
+	 * @param [in,out] rhs Pointer to right hand side vector of size `rows()`, overwritten by the solution
+	 * @return @c true if the solution process was successful, otherwise @c false
+	 */
+	bool solve(double* const rhs) const;
+
+	/**
+	 * @brief Multiplies the (not factorized) matrix with a vector
+	 * @details Computes @f$ y = Ax @f$.
+	 * @param [in] x Vector of size `rows()`
+	 * @param [out] y Vector of size `rows()`
+	 */
+	void multiplyVector(double const* const x, double* const y) const;
+
+	/**
+	 * @brief Returns the number of rows
+	 * @return Number of rows
+	 */
+	inline unsigned int rows() const CADET_NOEXCEPT { return _nBlocks * _blockSize; }
+
+	/**
+	 * @brief Returns the number of diagonal blocks
+	 * @return Number of diagonal blocks
+	 */
+	inline unsigned int numBlocks() const CADET_NOEXCEPT { return _nBlocks; }
+
+	/**
+	 * @brief Returns the size of a (square) block
+	 * @return Number of rows of a block
+	 */
+	inline unsigned int blockSize() const CADET_NOEXCEPT { return _blockSize; }
+
+protected:
+	unsigned int _nBlocks; //!< Number of diagonal blocks
+	unsigned int _blockSize; //!< Size of a block
+	std::vector<double> _diag; //!< Dense diagonal blocks @f$ D_k @f$ (row-major), overwritten by LU factors of @f$ S_k @f$
+	std::vector<double> _lower; //!< Diagonals of subdiagonal blocks @f$ L_k @f$ (first block unused)
+	std::vector<double> _upper; //!< Diagonals of superdiagonal blocks @f$ U_k @f$ (last block unused)
+	std::vector<double> _coupling; //!< Nonzero columns of @f$ W_k = S_k^{-1} U_k @f$ (column-major, packed)
+	std::vector<unsigned int> _couplingCols; //!< Column indices of the packed columns in @f$ W_k @f$
+	std::vector<unsigned int> _numCouplingCols; //!< Number of nonzero columns in @f$ W_k @f$
+	std::vector<lapackInt_t> _pivot; //!< Pivot indices of the LU factorizations of @f$ S_k @f$
+};
+
+} // namespace linalg
+
+} // namespace cadet
+
+#endif  // LIBCADET_BLOCKTRIDIAGONALMATRIX_HPP_
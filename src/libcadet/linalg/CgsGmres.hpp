@@ -0,0 +1,460 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a restarted GMRES method with classical Gram-Schmidt orthogonalization and selective reorthogonalization.
+ */
+
+#ifndef LIBCADET_CGSGMRES_HPP_
+#define LIBCADET_CGSGMRES_HPP_
+
+#include "cadet/cadetCompilerInfo.hpp"
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+
+#ifdef CADET_PARALLELIZE
+	#include <tbb/parallel_reduce.h>
+	#include <tbb/blocked_range.h>
+#endif
+
+namespace cadet
+{
+
+namespace linalg
+{
+
+namespace detail
+{
+#ifdef CADET_PARALLELIZE
+	/**
+	 * @brief Minimum vector length for which the Krylov kernels are parallelized
+	 */
+	constexpr unsigned int minParallelKrylovSize = 16384;
+
+	/**
+	 * @brief Grain size of the parallel Krylov kernels
+	 */
+	constexpr unsigned int krylovGrainSize = 4096;
+#endif
+
+	inline void projectOntoBasisSerial(double const* V, unsigned int ldV, unsigned int nVec, double const* w, unsigned int begin, unsigned int end, double* h) CADET_NOEXCEPT
+	{
+		for (unsigned int i = begin; i < end; ++i)
+		{
+			const double wi = w[i];
+			double const* const row = V + static_cast<std::size_t>(i) * ldV;
+			for (unsigned int k = 0; k < nVec; ++k)
+				h[k] += row[k] * wi;
+		}
+	}
+
+	inline double subtractBasisSerial(double const* V, unsigned int ldV, unsigned int nVec, double const* h, double* w, unsigned int begin, unsigned int end) CADET_NOEXCEPT
+	{
+		double norm = 0.0;
+		for (unsigned int i = begin; i < end; ++i)
+		{
+			double const* const row = V + static_cast<std::size_t>(i) * ldV;
+			double wi = w[i];
+			for (unsigned int k = 0; k < nVec; ++k)
+				wi -= row[k] * h[k];
+
+			w[i] = wi;
+			norm += wi * wi;
+		}
+		return norm;
+	}
+} // namespace detail
+
+/**
+ * @brief Computes the projections @f$ h = V^T w @f$ of a vector onto a basis
+ * @details The basis @f$ V @f$ is stored row-major with leading dimension @p ldV, that is, the
+ *          @p nVec basis vectors are interleaved. Hence, all projections are computed in a single
+ *          pass over @f$ w @f$ with contiguous memory access (transposed matrix-vector product).
+ *          Large vectors are processed in parallel with a deterministic reduction.
+ * @param [in] V Basis with @p n rows
+ * @param [in] ldV Leading dimension (row stride) of @p V
+ * @param [in] nVec Number of basis vectors
+ * @param [in] w Vector of length @p n
+ * @param [in] n Length of the vectors
+ * @param [out] h Projections of length @p nVec
+ */
+inline void projectOntoBasis(double const* V, unsigned int ldV, unsigned int nVec, double const* w, unsigned int n, double* h)
+{
+	std::fill(h, h + nVec, 0.0);
+
+#ifdef CADET_PARALLELIZE
+	if (n >= detail::minParallelKrylovSize)
+	{
+		const std::vector<double> result = tbb::parallel_deterministic_reduce(tbb::blocked_range<unsigned int>(0, n, detail::krylovGrainSize), std::vector<double>(nVec, 0.0),
+			[=](const tbb::blocked_range<unsigned int>& r, std::vector<double> acc) -> std::vector<double>
+			{
+				detail::projectOntoBasisSerial(V, ldV, nVec, w, r.begin(), r.end(), acc.data());
+				return acc;
+			},
+			[](std::vector<double> a, const std::vector<double>& b) -> std::vector<double>
+			{
+				for (std::size_t k = 0; k < a.size(); ++k)
+					a[k] += b[k];
+				return a;
+			}
+		);
+		std::copy(result.begin(), result.end(), h);
+		return;
+	}
+#endif
+
+	detail::projectOntoBasisSerial(V, ldV, nVec, w, 0, n, h);
+}
+
+/**
+ * @brief Subtracts a linear combination of basis vectors @f$ w \leftarrow w - Vh @f$ and returns the squared norm of the result
+ * @details The basis is stored as in projectOntoBasis(). The update and the norm are fused into a
+ *          single pass over @f$ w @f$.
+ * @param [in] V Basis with @p n rows
+ * @param [in] ldV Leading dimension (row stride) of @p V
+ * @param [in] nVec Number of basis vectors
+ * @param [in] h Coefficients of length @p nVec
+ * @param [in,out] w Vector of length @p n
+ * @param [in] n Length of the vectors
+ * @return Squared @f$ \ell^2 @f$-norm of the updated vector
+ */
+inline double subtractBasis(double const* V, unsigned int ldV, unsigned int nVec, double const* h, double* w, unsigned int n)
+{
+#ifdef CADET_PARALLELIZE
+	if (n >= detail::minParallelKrylovSize)
+	{
+		return tbb::parallel_deterministic_reduce(tbb::blocked_range<unsigned int>(0, n, detail::krylovGrainSize), 0.0,
+			[=](const tbb::blocked_range<unsigned int>& r, double acc) -> double
+			{
+				return acc + detail::subtractBasisSerial(V, ldV, nVec, h, w, r.begin(), r.end());
+			},
+			[](double a, double b) -> double { return a + b; }
+		);
+	}
+#endif
+
+	return detail::subtractBasisSerial(V, ldV, nVec, h, w, 0, n);
+}
+
+/**
+ * @brief Restarted GMRES method with classical Gram-Schmidt orthogonalization and selective reorthogonalization (CGS2)
+ * @details Solves @f$ Ax = b @f$ with the same scaling and convergence criterion as the SUNDIALS SPGMR
+ *          implementation without preconditioning: With the diagonal matrix @f$ W @f$ of weights, GMRES is
+ *          applied to @f$ WAW^{-1} (Wx) = Wb @f$ and terminates if @f$ \lVert W(b - Ax) \rVert_2 \leq \text{tol} @f$.
+ *          A nonzero initial guess is used if provided.
+ *
+ *          The Krylov basis is stored row-major (interleaved) so that each Gram-Schmidt sweep over all
+ *          previous basis vectors is a single matrix-vector product (see projectOntoBasis() and subtractBasis()),
+ *          which is much more cache friendly than orthogonalizing against one vector at a time as in modified
+ *          Gram-Schmidt. The loss of orthogonality of classical Gram-Schmidt is remedied by a second sweep if
+ *          the norm of the new vector dropped below a threshold relative to its norm before orthogonalization
+ *          (criterion of Daniel, Gragg, Kaufman, and Stewart).
+ */
+class CgsGmres
+{
+public:
+
+	/**
+	 * @brief Result of solve()
+	 */
+	enum class Status : int
+	{
+		Success, //!< Converged
+		ResidualReduced, //!< Did not converge, but the residual has been reduced
+		ConvergenceFailure, //!< Did not converge
+		MatVecFailRecoverable, //!< Matrix-vector product failed recoverably
+		MatVecFailUnrecoverable, //!< Matrix-vector product failed unrecoverably
+		QrSolveFailure //!< Hessenberg matrix is singular
+	};
+
+	/**
+	 * @brief Matrix-vector product @f$ z = Ax @f$
+	 * @details Returns @c 0 on success, a positive value on recoverable and a negative value on unrecoverable error.
+	 */
+	typedef std::function<int(double const* x, double* z)> MatrixVectorMultFun;
+
+	CgsGmres() CADET_NOEXCEPT : _n(0), _maxKrylov(0), _maxRestarts(0), _reorthThreshold(1.0 / std::sqrt(2.0)), _numIter(0), _numReorth(0), _resNorm(0.0) { }
+
+	/**
+	 * @brief Allocates memory
+	 * @param [in] n Size of the square matrix
+	 * @param [in] maxKrylov Maximum number of Krylov vectors (between @c 1 and @p n)
+	 * @param [in] maxRestarts Maximum number of restarts
+	 */
+	inline void initialize(unsigned int n, unsigned int maxKrylov, unsigned int maxRestarts)
+	{
+		_n = n;
+		_maxKrylov = std::max(1u, std::min(maxKrylov, n));
+		_maxRestarts = maxRestarts;
+
+		const unsigned int ld = _maxKrylov + 1;
+		_basis.resize(static_cast<std::size_t>(_n) * ld);
+		_hess.resize(static_cast<std::size_t>(ld) * _maxKrylov);
+		_givensC.resize(_maxKrylov);
+		_givensS.resize(_maxKrylov);
+		_g.resize(ld);
+		_y.resize(_maxKrylov);
+		_corr.resize(ld);
+		_w.resize(_n);
+		_tmp.resize(_n);
+	}
+
+	/**
+	 * @brief Solves the linear system @f$ Ax = b @f$
+	 * @param [in] matVec Matrix-vector product with @f$ A @f$
+	 * @param [in] tolerance Threshold on the weighted @f$ \ell^2 @f$-norm of the residual
+	 * @param [in] weight Weights
+	 * @param [in] rhs Right hand side @f$ b @f$
+	 * @param [in,out] sol On entry the initial guess, on exit the solution
+	 * @return Status of the solution
+	 */
+	Status solve(const MatrixVectorMultFun& matVec, double tolerance, double const* weight, double const* rhs, double* sol)
+	{
+		const unsigned int ld = _maxKrylov + 1;
+		_numIter = 0;
+
+		// Scaled initial residual w = W(b - Ax_0), skip the matrix-vector product for a zero initial guess
+		const bool zeroGuess = std::all_of(sol, sol + _n, [](double v) { return v == 0.0; });
+		if (zeroGuess)
+			std::copy(rhs, rhs + _n, _w.begin());
+		else
+		{
+			const int flag = matVec(sol, _w.data());
+			if (flag != 0)
+				return matVecFailure(flag);
+
+			for (unsigned int i = 0; i < _n; ++i)
+				_w[i] = rhs[i] - _w[i];
+		}
+
+		double beta = scaleAndNorm(weight);
+		_resNorm = beta;
+		if (beta <= tolerance)
+			return Status::Success;
+
+		const double initialNorm = beta;
+		for (unsigned int restart = 0; ; ++restart)
+		{
+			for (unsigned int i = 0; i < _n; ++i)
+				_basis[static_cast<std::size_t>(i) * ld] = _w[i] / beta;
+
+			std::fill(_g.begin(), _g.end(), 0.0);
+			_g[0] = beta;
+
+			bool converged = false;
+			unsigned int k = 0;
+			for (unsigned int j = 0; j < _maxKrylov; ++j)
+			{
+				// w = W A W^{-1} v_j
+				for (unsigned int i = 0; i < _n; ++i)
+					_tmp[i] = _basis[static_cast<std::size_t>(i) * ld + j] / weight[i];
+
+				const int flag = matVec(_tmp.data(), _w.data());
+				if (flag != 0)
+					return matVecFailure(flag);
+
+				const double normBefore = scaleAndNorm(weight);
+
+				// Classical Gram-Schmidt sweep
+				double* const h = _hess.data() + static_cast<std::size_t>(j) * ld;
+				projectOntoBasis(_basis.data(), ld, j + 1, _w.data(), _n, h);
+				double normSqr = subtractBasis(_basis.data(), ld, j + 1, h, _w.data(), _n);
+
+				// Selective reorthogonalization if cancellation occurred
+				if (std::sqrt(normSqr) < _reorthThreshold * normBefore)
+				{
+					projectOntoBasis(_basis.data(), ld, j + 1, _w.data(), _n, _corr.data());
+					normSqr = subtractBasis(_basis.data(), ld, j + 1, _corr.data(), _w.data(), _n);
+					for (unsigned int l = 0; l <= j; ++l)
+						h[l] += _corr[l];
+
+					++_numReorth;
+				}
+
+				const double hNext = std::sqrt(normSqr);
+				h[j + 1] = hNext;
+
+				++_numIter;
+				k = j + 1;
+
+				// Apply previous Givens rotations to the new column of the Hessenberg matrix
+				for (unsigned int l = 0; l < j; ++l)
+				{
+					const double t = _givensC[l] * h[l] + _givensS[l] * h[l + 1];
+					h[l + 1] = -_givensS[l] * h[l] + _givensC[l] * h[l + 1];
+					h[l] = t;
+				}
+
+				// Compute new rotation that eliminates the subdiagonal element
+				const double denom = std::hypot(h[j], h[j + 1]);
+				if (denom == 0.0)
+				{
+					_givensC[j] = 1.0;
+					_givensS[j] = 0.0;
+				}
+				else
+				{
+					_givensC[j] = h[j] / denom;
+					_givensS[j] = h[j + 1] / denom;
+				}
+				h[j] = denom;
+				h[j + 1] = 0.0;
+
+				_g[j + 1] = -_givensS[j] * _g[j];
+				_g[j] = _givensC[j] * _g[j];
+				_resNorm = std::abs(_g[j + 1]);
+
+				if ((_resNorm <= tolerance) || (hNext == 0.0))
+				{
+					converged = (_resNorm <= tolerance);
+					break;
+				}
+
+				// Next basis vector
+				const double invNorm = 1.0 / hNext;
+				for (unsigned int i = 0; i < _n; ++i)
+					_basis[static_cast<std::size_t>(i) * ld + j + 1] = _w[i] * invNorm;
+			}
+
+			// Solve upper triangular system R y = g
+			for (unsigned int l = k; l-- > 0; )
+			{
+				double sum = _g[l];
+				for (unsigned int q = l + 1; q < k; ++q)
+					sum -= _hess[static_cast<std::size_t>(q) * ld + l] * _y[q];
+
+				const double diag = _hess[static_cast<std::size_t>(l) * ld + l];
+				if (diag == 0.0)
+					return Status::QrSolveFailure;
+
+				_y[l] = sum / diag;
+			}
+
+			// Update solution x = x + W^{-1} V y
+			for (unsigned int i = 0; i < _n; ++i)
+			{
+				double const* const row = _basis.data() + static_cast<std::size_t>(i) * ld;
+				double acc = 0.0;
+				for (unsigned int l = 0; l < k; ++l)
+					acc += row[l] * _y[l];
+
+				sol[i] += acc / weight[i];
+			}
+
+			if (converged)
+				return Status::Success;
+
+			if (restart >= _maxRestarts)
+				break;
+
+			// Compute residual for restart
+			const int flag = matVec(sol, _w.data());
+			if (flag != 0)
+				return matVecFailure(flag);
+
+			for (unsigned int i = 0; i < _n; ++i)
+				_w[i] = rhs[i] - _w[i];
+
+			beta = scaleAndNorm(weight);
+			_resNorm = beta;
+			if (beta <= tolerance)
+				return Status::Success;
+		}
+
+		return (_resNorm < initialNorm) ? Status::ResidualReduced : Status::ConvergenceFailure;
+	}
+
+	/**
+	 * @brief Returns the size of the square matrix
+	 * @return Number of rows of the square matrix
+	 */
+	inline unsigned int size() const CADET_NOEXCEPT { return _n; }
+
+	inline unsigned int maxKrylov() const CADET_NOEXCEPT { return _maxKrylov; }
+
+	inline unsigned int maxRestarts() const CADET_NOEXCEPT { return _maxRestarts; }
+	inline void maxRestarts(unsigned int mr) CADET_NOEXCEPT { _maxRestarts = mr; }
+
+	/**
+	 * @brief Returns the threshold of the reorthogonalization criterion
+	 * @details A second Gram-Schmidt sweep is performed if the norm of the orthogonalized vector is
+	 *          less than the threshold times its norm before orthogonalization. A threshold of @c 0
+	 *          disables reorthogonalization, a threshold greater than @c 1 always reorthogonalizes.
+	 * @return Reorthogonalization threshold
+	 */
+	inline double reorthogonalizationThreshold() const CADET_NOEXCEPT { return _reorthThreshold; }
+	inline void reorthogonalizationThreshold(double t) CADET_NOEXCEPT { _reorthThreshold = t; }
+
+	/**
+	 * @brief Returns the number of iterations of the last call to solve()
+	 * @return Number of iterations
+	 */
+	inline unsigned int numIterations() const CADET_NOEXCEPT { return _numIter; }
+
+	/**
+	 * @brief Returns the total number of reorthogonalizations since construction
+	 * @return Number of reorthogonalizations
+	 */
+	inline unsigned long numReorthogonalizations() const CADET_NOEXCEPT { return _numReorth; }
+
+	/**
+	 * @brief Returns the weighted residual norm at the end of the last call to solve()
+	 * @return Weighted residual norm
+	 */
+	inline double residualNorm() const CADET_NOEXCEPT { return _resNorm; }
+
+protected:
+
+	inline double scaleAndNorm(double const* weight) CADET_NOEXCEPT
+	{
+		double norm = 0.0;
+		for (unsigned int i = 0; i < _n; ++i)
+		{
+			_w[i] *= weight[i];
+			norm += _w[i] * _w[i];
+		}
+		return std::sqrt(norm);
+	}
+
+	static inline Status matVecFailure(int flag) CADET_NOEXCEPT
+	{
+		return (flag > 0) ? Status::MatVecFailRecoverable : Status::MatVecFailUnrecoverable;
+	}
+
+	unsigned int _n; //!< Size of the square matrix
+	unsigned int _maxKrylov; //!< Maximum number of Krylov vectors
+	unsigned int _maxRestarts; //!< Maximum number of restarts
+	double _reorthThreshold; //!< Threshold of the reorthogonalization criterion
+	unsigned int _numIter; //!< Number of iterations of the last solve
+	unsigned long _numReorth; //!< Total number of reorthogonalizations
+	double _resNorm; //!< Weighted residual norm of the last solve
+
+	std::vector<double> _basis; //!< Krylov basis (row-major, n rows, maxKrylov + 1 columns)
+	std::vector<double> _hess; //!< Hessenberg matrix (column-major, maxKrylov + 1 rows, maxKrylov columns), upper triangular after Givens rotations
+	std::vector<double> _givensC; //!< Cosines of the Givens rotations
+	std::vector<double> _givensS; //!< Sines of the Givens rotations
+	std::vector<double> _g; //!< Rotated right hand side of the least squares problem
+	std::vector<double> _y; //!< Solution of the least squares problem
+	std::vector<double> _corr; //!< Correction of the projections in the reorthogonalization sweep
+	std::vector<double> _w; //!< Current vector
+	std::vector<double> _tmp; //!< Unscaled basis vector
+};
+
+} // namespace linalg
+
+} // namespace cadet
+
+#endif  // LIBCADET_CGSGMRES_HPP_
@@ -0,0 +1,146 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides adaptive forcing terms for inexact Newton methods.
+ */
+
+#ifndef LIBCADET_EISENSTATWALKER_HPP_
+#define LIBCADET_EISENSTATWALKER_HPP_
+
+#include <cmath>
+#include <algorithm>
+#include "common/CompilerSpecific.hpp"
+
+namespace cadet
+{
+
+namespace linalg
+{
+
+/**
+ * @brief Computes forcing terms of an inexact Newton method following Eisenstat and Walker
+ * @details In an inexact Newton method, the linear system @f$ J_k s_k = -F_k @f$ is only solved
+ *          up to a relative residual @f$ \lVert F_k + J_k s_k \rVert \leq \eta_k \lVert F_k \rVert @f$.
+ *          The forcing term @f$ \eta_k @f$ is chosen based on the reduction of the Newton residual
+ *          (choice 2 in Eisenstat and Walker, SIAM J. Sci. Comput. 17(1), 1996):
+ *          @f[ \eta_k = \gamma \left( \frac{\lVert F_k \rVert}{\lVert F_{k-1} \rVert} \right)^{\alpha}. @f]
+ *          The forcing term is safeguarded against decreasing too fast by
+ *          @f$ \eta_k \geq \gamma \eta_{k-1}^{\alpha} @f$ if @f$ \gamma \eta_{k-1}^{\alpha} > 0.1 @f$
+ *          and is restricted to @f$ [\eta_{\text{min}}, \eta_{\text{max}}] @f$. The first Newton
+ *          iteration uses @f$ \eta_0 = \eta_{\text{max}} @f$.
+ */
+class EisenstatWalker
+{
+public:
+
+	EisenstatWalker() CADET_NOEXCEPT : _gamma(0.9), _alpha(2.0), _etaMin(1e-6), _etaMax(0.1), _prevNorm(-1.0), _prevEta(0.1) { }
+
+	/**
+	 * @brief Starts a new Newton iteration
+	 * @details Discards the residual history.
+	 */
+	inline void reset() CADET_NOEXCEPT
+	{
+		_prevNorm = -1.0;
+		_prevEta = _etaMax;
+	}
+
+	/**
+	 * @brief Computes the forcing term of the next Newton iteration
+	 * @param [in] resNorm Norm of the current Newton residual @f$ \lVert F_k \rVert @f$
+	 * @return Forcing term @f$ \eta_k @f$
+	 */
+	inline double next(double resNorm) CADET_NOEXCEPT
+	{
+		double eta = _etaMax;
+		if ((_prevNorm > 0.0) && (resNorm >= 0.0))
+		{
+			eta = _gamma * std::pow(resNorm / _prevNorm, _alpha);
+
+			// Safeguard against oversolving due to a single large residual reduction
+			const double safeguard = _gamma * std::pow(_prevEta, _alpha);
+			if (safeguard > 0.1)
+				eta = std::max(eta, safeguard);
+
+			eta = std::max(_etaMin, std::min(eta, _etaMax));
+		}
+
+		_prevNorm = resNorm;
+		_prevEta = eta;
+		return eta;
+	}
+
+	inline double gamma() const CADET_NOEXCEPT { return _gamma; }
+	inline void gamma(double g) CADET_NOEXCEPT { _gamma = g; }
+
+	inline double alpha() const CADET_NOEXCEPT { return _alpha; }
+	inline void alpha(double a) CADET_NOEXCEPT { _alpha = a; }
+
+	inline double etaMin() const CADET_NOEXCEPT { return _etaMin; }
+	inline void etaMin(double e) CADET_NOEXCEPT { _etaMin = e; }
+
+	inline double etaMax() const CADET_NOEXCEPT { return _etaMax; }
+	inline void etaMax(double e) CADET_NOEXCEPT { _etaMax = e; }
+
+	/**
+	 * @brief Returns the forcing term computed by the last call to next()
+	 * @return Last forcing term
+	 */
+	inline double lastEta() const CADET_NOEXCEPT { return _prevEta; }
+
+protected:
+	double _gamma; //!< Scaling factor @f$ \gamma @f$
+	double _alpha; //!< Exponent @f$ \alpha @f$
+	double _etaMin; //!< Minimum forcing term
+	double _etaMax; //!< Maximum forcing term (also used in the first Newton iteration)
+	double _prevNorm; //!< Norm of the previous Newton residual or negative if there is none
+	double _prevEta; //!< Previous forcing term
+};
+
+/**
+ * @brief Computes the tolerance of a GMRES iteration that solves (part of) the Newton system
+ * @details The tolerance refers to the scaled @f$ \ell^2 @f$-norm @f$ \lVert Wr \rVert_2 @f$ of the residual
+ *          @f$ r @f$ used by GMRES, where @f$ W @f$ is the diagonal matrix of error weights.
+ *          If @p adaptive is @c false, @p tol is the tolerance of the outer Newton iteration and the
+ *          fixed tolerance @f$ \sqrt{n} \cdot \text{tol} \cdot \text{safety} @f$ is returned. Otherwise,
+ *          @p tol is a forcing term @f$ \eta @f$ (see EisenstatWalker) and the tolerance is relative to
+ *          the right hand side, that is, @f$ \eta \lVert Wb \rVert_2 @f$.
+ * @param [in] adaptive Determines whether @p tol is a forcing term
+ * @param [in] tol Tolerance of the outer Newton iteration or forcing term
+ * @param [in] safety Safety factor applied to the tolerance of the outer Newton iteration
+ * @param [in] rhs Right hand side @f$ b @f$ of the linear system solved by GMRES
+ * @param [in] weight Error weights
+ * @param [in] n Size of the linear system solved by GMRES
+ * @param [in] nScale Number of elements used for converting the tolerance of the outer Newton iteration
+ * @return Tolerance of the GMRES iteration
+ */
+inline double gmresTolerance(bool adaptive, double tol, double safety, double const* rhs, double const* weight, unsigned int n, unsigned int nScale)
+{
+	if (!adaptive)
+		return std::sqrt(static_cast<double>(nScale)) * tol * safety;
+
+	double norm = 0.0;
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		const double v = rhs[i] * weight[i];
+		norm += v * v;
+	}
+	return tol * std::sqrt(norm);
+}
+
+} // namespace linalg
+
+} // namespace cadet
+
+#endif  // LIBCADET_EISENSTATWALKER_HPP_
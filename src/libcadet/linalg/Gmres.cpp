@@ -22,6 +22,7 @@
 #include "SundialsVector.hpp"
 
 #include <type_traits>
+#include <algorithm>
 
 namespace cadet
 {
@@ -43,7 +44,7 @@ Gmres::Gmres() CADET_NOEXCEPT :
 #elif CADET_SUNDIALS_IFACE == 3
 	_linearSolver(nullptr),
 #endif
-	_ortho(Orthogonalization::ModifiedGramSchmidt), _maxRestarts(0), _matrixSize(0), _matVecMul(nullptr), _userData(nullptr)
+	_ortho(Orthogonalization::ModifiedGramSchmidt), _maxRestarts(0), _matrixSize(0), _maxKrylov(0), _numIterations(0), _matVecMul(nullptr), _userData(nullptr)
 {
 }
 
@@ -68,19 +69,49 @@ void Gmres::initialize(unsigned int matrixSize, unsigned int maxKrylov, Orthogon
 	_matrixSize = matrixSize;
 	if (maxKrylov == 0)
 		maxKrylov = _matrixSize;
+	_maxKrylov = maxKrylov;
 
 	_maxRestarts = maxRestarts;
 	_ortho = om;
 
+	if (_ortho == Orthogonalization::ClassicalGramSchmidtReorth)
+	{
+		_native.initialize(_matrixSize, _maxKrylov, _maxRestarts);
+
+		// Release SUNDIALS memory of a previous initialization, which does not match the new size
+#if CADET_SUNDIALS_IFACE == 2
+		if (_mem)
+			SpgmrFree(_mem);
+		_mem = nullptr;
+#elif CADET_SUNDIALS_IFACE == 3
+		if (_linearSolver)
+			SUNLinSolFree(_linearSolver);
+		_linearSolver = nullptr;
+#endif
+	}
+	else
+		initializeSundials();
+}
+
+void Gmres::initializeSundials()
+{
+#if CADET_SUNDIALS_IFACE == 2
+	if (_mem)
+		SpgmrFree(_mem);
+#elif CADET_SUNDIALS_IFACE == 3
+	if (_linearSolver)
+		SUNLinSolFree(_linearSolver);
+#endif
+
 	// Create a template vector for the malloc routine of SPGMR
-	N_Vector NV_tmpl = NVec_New(matrixSize);
+	N_Vector NV_tmpl = NVec_New(_matrixSize);
 	NVec_Const(0.0, NV_tmpl);
 
 	// Size of allocated memory is either _maxKrylov or _cc.neq_bnd()
 #if CADET_SUNDIALS_IFACE == 2
-	_mem = SpgmrMalloc(maxKrylov, NV_tmpl);
+	_mem = SpgmrMalloc(_maxKrylov, NV_tmpl);
 #elif CADET_SUNDIALS_IFACE == 3
-	_linearSolver = SUNSPGMR(NV_tmpl, PREC_NONE, maxKrylov);
+	_linearSolver = SUNSPGMR(NV_tmpl, PREC_NONE, _maxKrylov);
 	SUNLinSolSetATimes(_linearSolver, this, &gmresCallback);
 	SUNLinSolInitialize_SPGMR(_linearSolver);
 #endif
@@ -90,6 +121,18 @@ void Gmres::initialize(unsigned int matrixSize, unsigned int maxKrylov, Orthogon
 
 int Gmres::solve(double tolerance, double const* weight, double const* rhs, double* sol)
 {
+	if (_ortho == Orthogonalization::ClassicalGramSchmidtReorth)
+		return solveNative(tolerance, weight, rhs, sol);
+
+	// Orthogonalization method may have been changed after initialization
+#if CADET_SUNDIALS_IFACE == 2
+	if (!_mem)
+		initializeSundials();
+#elif CADET_SUNDIALS_IFACE == 3
+	if (!_linearSolver)
+		initializeSundials();
+#endif
+
 	// Create init-guess/solution vector by bending pointer
 	N_Vector NV_sol = NVec_NewEmpty(_matrixSize);
 	NVEC_DATA(NV_sol) = sol;
@@ -118,13 +161,15 @@ int Gmres::solve(double tolerance, double const* weight, double const* rhs, doub
 	SUNLinSolSetScalingVectors(_linearSolver, NV_weight, NV_weight);
 	SUNLinSolSetup(_linearSolver, nullptr);
 	const int flag = SUNLinSolSolve(_linearSolver, nullptr, NV_sol, NV_rhs, tolerance);
+	const int nIter = SUNLinSolNumIters(_linearSolver);
 
 #ifdef CADET_DEBUG
-	const int nIter = SUNLinSolNumIters(_linearSolver);
 	const double resNorm = SUNLinSolResNorm(_linearSolver);
 #endif
 #endif
 
+	_numIterations += nIter;
+
 	// Free NVector memory space
 	NVec_Destroy(NV_rhs);
 	NVec_Destroy(NV_weight);
@@ -133,6 +178,41 @@ int Gmres::solve(double tolerance, double const* weight, double const* rhs, doub
 	return flag;
 }
 
+int Gmres::solveNative(double tolerance, double const* weight, double const* rhs, double* sol)
+{
+	// Orthogonalization method may have been changed after initialization
+	if ((_native.size() != _matrixSize) || (_native.maxKrylov() != std::min(_maxKrylov, _matrixSize)))
+		_native.initialize(_matrixSize, _maxKrylov, _maxRestarts);
+	else
+		_native.maxRestarts(_maxRestarts);
+
+	const CgsGmres::Status status = _native.solve([this](double const* x, double* z) -> int { return _matVecMul(_userData, x, z); },
+		tolerance, weight, rhs, sol);
+
+	_numIterations += _native.numIterations();
+
+	// Translate status to SUNDIALS return flags
+	switch (status)
+	{
+#if CADET_SUNDIALS_IFACE == 2
+		case CgsGmres::Status::Success: return 0;
+		case CgsGmres::Status::ResidualReduced: return 1;
+		case CgsGmres::Status::ConvergenceFailure: return 2;
+		case CgsGmres::Status::MatVecFailRecoverable: return 5;
+		case CgsGmres::Status::MatVecFailUnrecoverable: return -2;
+		case CgsGmres::Status::QrSolveFailure: return -5;
+#elif CADET_SUNDIALS_IFACE == 3
+		case CgsGmres::Status::Success: return 0;
+		case CgsGmres::Status::ResidualReduced: return 1;
+		case CgsGmres::Status::ConvergenceFailure: return 2;
+		case CgsGmres::Status::MatVecFailRecoverable: return 3;
+		case CgsGmres::Status::MatVecFailUnrecoverable: return -4;
+		case CgsGmres::Status::QrSolveFailure: return -9;
+#endif
+	}
+	return -1;
+}
+
 #if CADET_SUNDIALS_IFACE == 2
 	const char* Gmres::getReturnFlagName(int flag) const CADET_NOEXCEPT
 	{
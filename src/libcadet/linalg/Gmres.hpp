@@ -20,6 +20,7 @@
 
 #include "cadet/cadetCompilerInfo.hpp"
 #include "cadet/Exceptions.hpp"
+#include "linalg/CgsGmres.hpp"
 
 #include <functional>
 
@@ -43,6 +44,7 @@ enum class Orthogonalization : unsigned int
 {
 	ClassicalGramSchmidt = 0,
 	ModifiedGramSchmidt = 1, 
+	ClassicalGramSchmidtReorth = 2
 };
 
 /**
@@ -58,13 +60,17 @@ inline Orthogonalization toOrthogonalization(unsigned int ortho)
 			return Orthogonalization::ClassicalGramSchmidt;
 		case static_cast<typename std::underlying_type<Orthogonalization>::type>(Orthogonalization::ModifiedGramSchmidt):
 			return Orthogonalization::ModifiedGramSchmidt;
+		case static_cast<typename std::underlying_type<Orthogonalization>::type>(Orthogonalization::ClassicalGramSchmidtReorth):
+			return Orthogonalization::ClassicalGramSchmidtReorth;
 	}
 	throw InvalidParameterException("Unknown orthogonalization type");
 }
 
 /**
  * @brief Implements the Generalized Minimal Residual (GMRES) method for solving the linear system @f$ Ax = b @f$
- * @details Wraps the implementation provided by SUNDIALS.
+ * @details Wraps the implementation provided by SUNDIALS for classical and modified Gram-Schmidt
+ *          orthogonalization. Classical Gram-Schmidt with selective reorthogonalization is handled
+ *          by the native implementation CgsGmres, which does not require SUNDIALS memory.
  */
 class Gmres
 {
@@ -145,6 +151,18 @@ public:
 	 */
 	inline unsigned int matrixSize() const CADET_NOEXCEPT { return _matrixSize; }
 
+	/**
+	 * @brief Returns the maximum number of stored Krylov vectors
+	 * @return Maximum size of the Krylov subspace
+	 */
+	inline unsigned int maxKrylov() const CADET_NOEXCEPT { return _maxKrylov; }
+
+	/**
+	 * @brief Returns the total number of GMRES iterations performed by solve()
+	 * @return Number of GMRES iterations since construction
+	 */
+	inline unsigned long numIterations() const CADET_NOEXCEPT { return _numIterations; }
+
 	/**
 	 * @brief Returns the matrix-vector multiplication function
 	 * @return Matrix-vector multiplication function
@@ -186,14 +204,20 @@ public:
 
 protected:
 
+	void initializeSundials();
+	int solveNative(double tolerance, double const* weight, double const* rhs, double* sol);
+
 #if CADET_SUNDIALS_IFACE == 2
 	SpgmrMemRec* _mem; //!< SUNDIALS memory
 #elif CADET_SUNDIALS_IFACE == 3
 	SUNLinearSolver _linearSolver; //!< SUNDIALS linear solver object
 #endif
+	CgsGmres _native; //!< Native GMRES implementation used for classical Gram-Schmidt with reorthogonalization
 	Orthogonalization _ortho; //!< Orthogonalization method
 	unsigned int _maxRestarts; //!< Maximum number of restarts
 	unsigned int _matrixSize; //!< Size of the square matrix
+	unsigned int _maxKrylov; //!< Maximum size of the Krylov subspace
+	unsigned long _numIterations; //!< Total number of GMRES iterations
 	MatrixVectorMultFun _matVecMul; //!< Matrix-vector multiplication function required for GMRES algorithm
 	void* _userData; //!< User data for matrix-vector multiplication function
 };
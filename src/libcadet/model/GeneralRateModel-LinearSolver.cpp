@@ -15,6 +15,7 @@
 #include "model/parts/BindingCellKernel.hpp"
 #include "linalg/DenseMatrix.hpp"
 #include "linalg/BandMatrix.hpp"
+#include "linalg/EisenstatWalker.hpp"
 #include "AdUtils.hpp"
 
 #include <algorithm>
@@ -115,6 +116,9 @@ int GeneralRateModel::linearSolve(double t, double alpha, double outerTol, doubl
 
 	Indexer idxr(_disc);
 
+	// Particle blocks are processed in batches of same-structured particle types
+	const unsigned int nBatch = _parTypeBatchOffset.size() - 1;
+
 	// ==== Step 1: Factorize diagonal Jacobian blocks
 
 	// Factorize partial Jacobians only if required
@@ -144,23 +148,29 @@ int GeneralRateModel::linearSolve(double t, double alpha, double outerTol, doubl
 #endif
 		{
 #ifdef CADET_PARALLELIZE
-			tbb::parallel_for(size_t(0), size_t(_disc.nCol * _disc.nParType), [&](size_t pblk)
+			tbb::parallel_for(size_t(0), size_t(_disc.nCol * nBatch), [&](size_t bblk)
 #else
-			for (unsigned int pblk = 0; pblk < _disc.nCol * _disc.nParType; ++pblk)
+			for (unsigned int bblk = 0; bblk < _disc.nCol * nBatch; ++bblk)
 #endif
 			{
-				const unsigned int type = pblk / _disc.nCol;
-				const unsigned int par = pblk % _disc.nCol;
-
-				// Assemble
-				assembleDiscretizedJacobianParticleBlock(type, par, alpha, idxr);
+				const unsigned int batch = bblk / _disc.nCol;
+				const unsigned int par = bblk % _disc.nCol;
 
-				// Factorize
-				const bool result = _jacPdisc[pblk].factorize();
-				if (cadet_unlikely(!result))
+				// Process all particle types of the batch in the same task
+				for (unsigned int lane = _parTypeBatchOffset[batch]; lane < _parTypeBatchOffset[batch + 1]; ++lane)
 				{
+					const unsigned int type = _parTypeBatch[lane];
+
+					// Assemble
+					assembleDiscretizedJacobianParticleBlock(type, par, alpha, idxr);
+
+					// Factorize
+					const bool result = factorizeDiscretizedJacobianParticleBlock(type, par);
+					if (cadet_unlikely(!result))
 					{
-						LOG(Error) << "Factorize() failed for par block " << pblk;
+						{
+							LOG(Error) << "Factorize() failed for par block " << type * _disc.nCol + par;
+						}
 					}
 				}
 			} CADET_PARFOR_END;
@@ -204,17 +214,21 @@ int GeneralRateModel::linearSolve(double t, double alpha, double outerTol, doubl
 #endif
 	{
 #ifdef CADET_PARALLELIZE
-		tbb::parallel_for(size_t(0), size_t(_disc.nCol * _disc.nParType), [&](size_t pblk)
+		tbb::parallel_for(size_t(0), size_t(_disc.nCol * nBatch), [&](size_t bblk)
 #else
-		for (unsigned int pblk = 0; pblk < _disc.nCol * _disc.nParType; ++pblk)
+		for (unsigned int bblk = 0; bblk < _disc.nCol * nBatch; ++bblk)
 #endif
 		{
-			const unsigned int type = pblk / _disc.nCol;
-			const unsigned int par = pblk % _disc.nCol;
-			const bool result = _jacPdisc[pblk].solve(rhs + idxr.offsetCp(ParticleTypeIndex{type}, ParticleIndex{par}));
-			if (cadet_unlikely(!result))
+			const unsigned int batch = bblk / _disc.nCol;
+			const unsigned int par = bblk % _disc.nCol;
+			for (unsigned int lane = _parTypeBatchOffset[batch]; lane < _parTypeBatchOffset[batch + 1]; ++lane)
 			{
-				LOG(Error) << "Solve() failed for par block " << pblk;
+				const unsigned int type = _parTypeBatch[lane];
+				const bool result = solveDiscretizedJacobianParticleBlock(type, par, rhs + idxr.offsetCp(ParticleTypeIndex{type}, ParticleIndex{par}));
+				if (cadet_unlikely(!result))
+				{
+					LOG(Error) << "Solve() failed for par block " << type * _disc.nCol + par;
+				}
 			}
 		} CADET_PARFOR_END;
 	} CADET_PARNODE_END;
@@ -251,7 +265,7 @@ int GeneralRateModel::linearSolve(double t, double alpha, double outerTol, doubl
 
 		// Note that rhs is updated in-place with the solution of the Schur-complement
 		// The temporary storage is only needed to hold the right hand side of the Schur-complement
-		const double tolerance = std::sqrt(static_cast<double>(_gmres.matrixSize())) * outerTol * _schurSafety;
+		const double tolerance = linalg::gmresTolerance(_adaptiveLinearTol, outerTol, _schurSafety, rhs + idxr.offsetJf(), weight + idxr.offsetJf(), _gmres.matrixSize(), _gmres.matrixSize());
 
 		BENCH_START(_timerGmres);
 		const int gmresResult = _gmres.solve(tolerance, weight + idxr.offsetJf(), _tempState + idxr.offsetJf(), rhs + idxr.offsetJf());
@@ -295,29 +309,34 @@ int GeneralRateModel::linearSolve(double t, double alpha, double outerTol, doubl
 #endif
 	{
 #ifdef CADET_PARALLELIZE
-		tbb::parallel_for(size_t(0), size_t(_disc.nCol * _disc.nParType), [&](size_t pblk)
+		tbb::parallel_for(size_t(0), size_t(_disc.nCol * nBatch), [&](size_t bblk)
 #else
-		for (unsigned int pblk = 0; pblk < _disc.nCol * _disc.nParType; ++pblk)
+		for (unsigned int bblk = 0; bblk < _disc.nCol * nBatch; ++bblk)
 #endif
 		{
-			const unsigned int type = pblk / _disc.nCol;
-			const unsigned int par = pblk % _disc.nCol;
+			const unsigned int batch = bblk / _disc.nCol;
+			const unsigned int par = bblk % _disc.nCol;
+			for (unsigned int lane = _parTypeBatchOffset[batch]; lane < _parTypeBatchOffset[batch + 1]; ++lane)
+			{
+				const unsigned int type = _parTypeBatch[lane];
+				const unsigned int pblk = type * _disc.nCol + par;
 
-			double* const localPar = _tempState + idxr.offsetCp(ParticleTypeIndex{type}, ParticleIndex{par});
-			double* const rhsPar = rhs + idxr.offsetCp(ParticleTypeIndex{type}, ParticleIndex{par});
+				double* const localPar = _tempState + idxr.offsetCp(ParticleTypeIndex{type}, ParticleIndex{par});
+				double* const rhsPar = rhs + idxr.offsetCp(ParticleTypeIndex{type}, ParticleIndex{par});
 
-			// Compute tempState_i = J_{i,f} * y_f
-			_jacPF[pblk].multiplyAdd(rhs + idxr.offsetJf(), localPar);
-			// Apply J_i^{-1} to tempState_i
-			const bool result = _jacPdisc[pblk].solve(localPar);
-			if (cadet_unlikely(!result))
-			{
-				LOG(Error) << "Solve() failed for par block " << pblk;
-			}
+				// Compute tempState_i = J_{i,f} * y_f
+				_jacPF[pblk].multiplyAdd(rhs + idxr.offsetJf(), localPar);
+				// Apply J_i^{-1} to tempState_i
+				const bool result = solveDiscretizedJacobianParticleBlock(type, par, localPar);
+				if (cadet_unlikely(!result))
+				{
+					LOG(Error) << "Solve() failed for par block " << pblk;
+				}
 
-			// Compute rhs_i = y_i - J_i^{-1} * J_{i,f} * y_f = y_i - tempState_i
-			for (int i = 0; i < idxr.strideParBlock(type); ++i)
-				rhsPar[i] -= localPar[i];
+				// Compute rhs_i = y_i - J_i^{-1} * J_{i,f} * y_f = y_i - tempState_i
+				for (int i = 0; i < idxr.strideParBlock(type); ++i)
+					rhsPar[i] -= localPar[i];
+			}
 		} CADET_PARFOR_END;
 	} CADET_PARNODE_END;
 
@@ -425,7 +444,7 @@ int GeneralRateModel::schurComplementMatrixVector(double const* x, double* z) co
 			// Apply J_{i,f}
 			_jacPF[pblk].multiplyAdd(x, tmp);
 			// Apply J_{i}^{-1}
-			const bool result = _jacPdisc[pblk].solve(tmp);
+			const bool result = solveDiscretizedJacobianParticleBlock(type, par, tmp);
 			if (cadet_unlikely(!result))
 			{
 				LOG(Error) << "Solve() failed for par block " << pblk;
@@ -485,9 +504,27 @@ int GeneralRateModel::schurComplementMatrixVector(double const* x, double* z) co
  */
 void GeneralRateModel::assembleDiscretizedJacobianParticleBlock(unsigned int parType, unsigned int pblk, double alpha, const Indexer& idxr)
 {
-	linalg::FactorizableBandMatrix& fbm = _jacPdisc[_disc.nCol * parType + pblk];
 	const linalg::BandMatrix& bm = _jacP[_disc.nCol * parType + pblk];
 
+	if (_parBlockTridiag[parType])
+	{
+		linalg::BlockTridiagonalMatrix& btm = _jacPdiscBlk[_disc.nCol * parType + pblk];
+
+		// Copy normal matrix over to block tridiagonal matrix
+		btm.copyOver(bm);
+
+		// Add time derivatives to particle shells (diagonal blocks)
+		for (unsigned int j = 0; j < _disc.nParCell[parType]; ++j)
+		{
+			linalg::DenseMatrixView shell = btm.diagonalBlock(j);
+			linalg::DenseBandedRowIterator jac = shell.row(0);
+			addTimeDerivativeToJacobianParticleShell(jac, idxr, alpha, parType);
+		}
+		return;
+	}
+
+	linalg::FactorizableBandMatrix& fbm = _jacPdisc[_disc.nCol * parType + pblk];
+
 	// Copy normal matrix over to factorizable matrix
 	fbm.copyOver(bm);
 
@@ -500,6 +537,37 @@ void GeneralRateModel::assembleDiscretizedJacobianParticleBlock(unsigned int par
 	}
 }
 
+/**
+ * @brief Factorizes a particle block of the time-discretized Jacobian
+ * @details Uses the block tridiagonal solver if the particle type admits it and the banded solver otherwise.
+ *          The block has to be assembled by assembleDiscretizedJacobianParticleBlock() before.
+ * @param [in] parType Index of the particle type
+ * @param [in] pblk Index of the particle block within a type
+ * @return @c true if the factorization was successful, otherwise @c false
+ */
+bool GeneralRateModel::factorizeDiscretizedJacobianParticleBlock(unsigned int parType, unsigned int pblk)
+{
+	if (_parBlockTridiag[parType])
+		return _jacPdiscBlk[_disc.nCol * parType + pblk].factorize();
+
+	return _jacPdisc[_disc.nCol * parType + pblk].factorize();
+}
+
+/**
+ * @brief Solves a linear system with a factorized particle block of the time-discretized Jacobian
+ * @param [in] parType Index of the particle type
+ * @param [in] pblk Index of the particle block within a type
+ * @param [in,out] rhs On entry, right hand side of the particle block; on exit, solution
+ * @return @c true if the solution process was successful, otherwise @c false
+ */
+bool GeneralRateModel::solveDiscretizedJacobianParticleBlock(unsigned int parType, unsigned int pblk, double* const rhs) const
+{
+	if (_parBlockTridiag[parType])
+		return _jacPdiscBlk[_disc.nCol * parType + pblk].solve(rhs);
+
+	return _jacPdisc[_disc.nCol * parType + pblk].solve(rhs);
+}
+
 /**
  * @brief Adds Jacobian @f$ \frac{\partial F}{\partial \dot{y}} @f$ to bead rows of system Jacobian
  * @details Actually adds @f$ \alpha \frac{\partial F}{\partial \dot{y}} @f$, which is useful
@@ -516,6 +584,12 @@ void GeneralRateModel::addTimeDerivativeToJacobianParticleShell(linalg::Factoriz
 		_poreAccessFactor.data() + _disc.nComp * parType, _disc.strideBound[parType], _disc.boundOffset + _disc.nComp * parType, _binding[parType]->reactionQuasiStationarity());
 }
 
+void GeneralRateModel::addTimeDerivativeToJacobianParticleShell(linalg::DenseBandedRowIterator& jac, const Indexer& idxr, double alpha, unsigned int parType)
+{
+	parts::cell::addTimeDerivativeToJacobianParticleShell<linalg::DenseBandedRowIterator, true>(jac, alpha, static_cast<double>(_parPorosity[parType]), _disc.nComp, _disc.nBound + _disc.nComp * parType,
+		_poreAccessFactor.data() + _disc.nComp * parType, _disc.strideBound[parType], _disc.boundOffset + _disc.nComp * parType, _binding[parType]->reactionQuasiStationarity());
+}
+
 
 }  // namespace model
 
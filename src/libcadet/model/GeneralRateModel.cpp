@@ -62,7 +62,7 @@ int schurComplementMultiplierGRM(void* userData, double const* x, double* z)
 GeneralRateModel::GeneralRateModel(UnitOpIdx unitOpIdx) : UnitOperationBase(unitOpIdx),
 	_hasSurfaceDiffusion(0, false), _dynReactionBulk(nullptr),
 	_jacP(nullptr), _jacPdisc(nullptr), _jacPF(nullptr), _jacFP(nullptr), _jacInlet(),
-	_analyticJac(true), _jacobianAdDirs(0), _factorizeJacobian(false), _tempState(nullptr),
+	_analyticJac(true), _jacobianAdDirs(0), _factorizeJacobian(false), _tempState(nullptr), _adaptiveLinearTol(false),
 	_initC(0), _initCp(0), _initQ(0), _initState(0), _initStateDot(0)
 {
 }
@@ -259,6 +259,9 @@ bool GeneralRateModel::configureModelDiscretization(IParameterProvider& paramPro
 	// Determine whether surface diffusion optimization is applied (decreases Jacobian size)
 	const bool optimizeSurfDiffusion = paramProvider.exists("FIX_ZERO_SURFACE_DIFFUSION") ? paramProvider.getBool("FIX_ZERO_SURFACE_DIFFUSION") : false;
 
+	// Determine whether same-structured particle types are evaluated together
+	const bool batchParTypes = paramProvider.exists("BATCH_PARTICLE_TYPES") ? paramProvider.getBool("BATCH_PARTICLE_TYPES") : false;
+
 	// Create nonlinear solver for consistent initialization
 	configureNonlinearSolver(paramProvider);
 
@@ -414,6 +417,23 @@ bool GeneralRateModel::configureModelDiscretization(IParameterProvider& paramPro
 		}
 	}
 
+	// Without surface diffusion, neighboring particle shells are only coupled by the (diagonal)
+	// pore diffusion of the mobile phase, which allows the block tridiagonal solver
+	_parBlockTridiag.resize(_disc.nParType);
+	_jacPdiscBlk.clear();
+	_jacPdiscBlk.resize(_disc.nCol * _disc.nParType);
+	for (unsigned int j = 0; j < _disc.nParType; ++j)
+	{
+		_parBlockTridiag[j] = !_hasSurfaceDiffusion[j];
+		if (!_parBlockTridiag[j])
+			continue;
+
+		for (unsigned int i = 0; i < _disc.nCol; ++i)
+			_jacPdiscBlk[_disc.nCol * j + i].resize(_disc.nParCell[j], _disc.nComp + _disc.strideBound[j]);
+	}
+
+	updateParticleTypeBatches(batchParTypes);
+
 	_jacPF = new linalg::DoubleSparseMatrix[_disc.nCol * _disc.nParType];
 	_jacFP = new linalg::DoubleSparseMatrix[_disc.nCol * _disc.nParType];
 	for (unsigned int i = 0; i < _disc.nCol * _disc.nParType; ++i)
@@ -635,6 +655,9 @@ bool GeneralRateModel::configure(IParameterProvider& paramProvider)
 		}
 	}
 
+	// Binding models know whether they have dynamic reactions only after configuration
+	updateParticleKernels();
+
 	return transportSuccess && bindingConfSuccess && dynReactionConfSuccess;
 }
 
@@ -655,6 +678,25 @@ unsigned int GeneralRateModel::threadLocalMemorySize() const CADET_NOEXCEPT
 	if (_dynReactionBulk && _dynReactionBulk->requiresWorkspace())
 		lms.fitBlock(_dynReactionBulk->workspaceSize(_disc.nComp, 0, nullptr));
 
+	// Memory for residualParticleBatch()
+	for (unsigned int i = 0; i + 1 < _parTypeBatchOffset.size(); ++i)
+	{
+		const unsigned int nLanes = _parTypeBatchOffset[i + 1] - _parTypeBatchOffset[i];
+		if (nLanes <= 1)
+			continue;
+
+		const unsigned int nParCell = _disc.nParCell[_parTypeBatch[_parTypeBatchOffset[i]]];
+
+		LinearMemorySizer lmsBatch;
+		lmsBatch.add<active>(nParCell * _disc.nComp * nLanes);
+		lmsBatch.add<active>(nParCell * _disc.nComp * nLanes);
+		lmsBatch.add<active>(4 * nParCell * nLanes);
+		lmsBatch.add<active>(_disc.nComp * nLanes);
+		lmsBatch.add<double>(2 * nParCell * _disc.nComp * nLanes);
+		lmsBatch.commit();
+		lms.fitBlock(lmsBatch.bufferSize());
+	}
+
 	const unsigned int maxStrideBound = *std::max_element(_disc.strideBound, _disc.strideBound + _disc.nParType);
 	lms.add<active>(_disc.nComp + maxStrideBound);
 	lms.add<double>((maxStrideBound + _disc.nComp) * (maxStrideBound + _disc.nComp));
@@ -979,21 +1021,38 @@ int GeneralRateModel::residual(const SimulationTime& simTime, const ConstSimulat
 template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
 int GeneralRateModel::residualImpl(double t, unsigned int secIdx, StateType const* const y, double const* const yDot, ResidualType* const res, util::ThreadLocalStorage& threadLocalMem)
 {
+	typedef int (GeneralRateModel::*ParticleKernel)(double, unsigned int, unsigned int, unsigned int, StateType const*, double const*, ResidualType*, util::ThreadLocalStorage&);
+
+	// Variants of residualParticle() indexed by _parKernel (see updateParticleKernels())
+	static const ParticleKernel parKernels[] = {
+		&GeneralRateModel::residualParticle<StateType, ResidualType, ParamType, wantJac, false, false>,
+		&GeneralRateModel::residualParticle<StateType, ResidualType, ParamType, wantJac, true, false>,
+		&GeneralRateModel::residualParticle<StateType, ResidualType, ParamType, wantJac, true, true>
+	};
+
 	BENCH_START(_timerResidualPar);
 
+	const unsigned int nBatch = _parTypeBatchOffset.size() - 1;
+
 #ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), size_t(_disc.nCol * _disc.nParType + 1), [&](size_t pblk)
+	tbb::parallel_for(size_t(0), size_t(_disc.nCol * nBatch + 1), [&](size_t pblk)
 #else
-	for (unsigned int pblk = 0; pblk < _disc.nCol * _disc.nParType + 1; ++pblk)
+	for (unsigned int pblk = 0; pblk < _disc.nCol * nBatch + 1; ++pblk)
 #endif
 	{
 		if (cadet_unlikely(pblk == 0))
 			residualBulk<StateType, ResidualType, ParamType, wantJac>(t, secIdx, y, yDot, res, threadLocalMem);
 		else
 		{
-			const unsigned int type = (pblk - 1) / _disc.nCol;
+			const unsigned int batch = (pblk - 1) / _disc.nCol;
 			const unsigned int par = (pblk - 1) % _disc.nCol;
-			residualParticle<StateType, ResidualType, ParamType, wantJac>(t, type, par, secIdx, y, yDot, res, threadLocalMem);
+			if (cadet_likely(_parTypeBatchOffset[batch + 1] - _parTypeBatchOffset[batch] == 1))
+			{
+				const unsigned int parType = _parTypeBatch[_parTypeBatchOffset[batch]];
+				(this->*parKernels[_parKernel[parType]])(t, parType, par, secIdx, y, yDot, res, threadLocalMem);
+			}
+			else
+				residualParticleBatch<StateType, ResidualType, ParamType, wantJac>(t, batch, par, secIdx, y, yDot, res, threadLocalMem);
 		}
 	} CADET_PARFOR_END;
 
@@ -1038,7 +1097,14 @@ int GeneralRateModel::residualBulk(double t, unsigned int secIdx, StateType cons
 	return 0;
 }
 
-template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
+/**
+ * @brief Computes the residual of the particle block of a given particle type in a column cell
+ * @details The variant is selected per particle type by updateParticleKernels() such that the
+ *          configuration dependent branches are resolved at compile time.
+ * @tparam surfDiff Determines whether surface diffusion is present in the particle type
+ * @tparam solidSurfDiff Determines whether surface diffusion acts on the dynamic bound states
+ */
+template <typename StateType, typename ResidualType, typename ParamType, bool wantJac, bool surfDiff, bool solidSurfDiff>
 int GeneralRateModel::residualParticle(double t, unsigned int parType, unsigned int colCell, unsigned int secIdx, StateType const* yBase,
 	double const* yDotBase, ResidualType* resBase, util::ThreadLocalStorage& threadLocalMem)
 {
@@ -1114,8 +1180,18 @@ int GeneralRateModel::residualParticle(double t, unsigned int parType, unsigned
 				const ResidualType gradCp = (y[-idxr.strideParShell(parType)] - y[0]) / dr;
 				*res -= outerAreaPerVolume * dp * gradCp;
 
+				if (wantJac)
+				{
+					const double ouApV = static_cast<double>(outerAreaPerVolume);
+					const double ldr = static_cast<double>(dr);
+
+					// Liquid phase
+					jac[0] += ouApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j)
+					jac[-idxr.strideParShell(parType)] += -ouApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j-1)
+				}
+
 				// Surface diffusion contribution for quasi-stationary bound states
-				if (cadet_unlikely(_hasSurfaceDiffusion[parType]))
+				if (surfDiff)
 				{
 					for (unsigned int i = 0; i < nBound; ++i)
 					{
@@ -1135,10 +1211,6 @@ int GeneralRateModel::residualParticle(double t, unsigned int parType, unsigned
 						const double ouApV = static_cast<double>(outerAreaPerVolume);
 						const double ldr = static_cast<double>(dr);
 
-						// Liquid phase
-						jac[0] += ouApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j)
-						jac[-idxr.strideParShell(parType)] += -ouApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j-1)
-
 						// Solid phase
 						for (unsigned int i = 0; i < nBound; ++i)
 						{
@@ -1162,8 +1234,18 @@ int GeneralRateModel::residualParticle(double t, unsigned int parType, unsigned
 				const ResidualType gradCp = (y[0] - y[idxr.strideParShell(parType)]) / dr;
 				*res += innerAreaPerVolume * dp * gradCp;
 
+				if (wantJac)
+				{
+					const double inApV = static_cast<double>(innerAreaPerVolume);
+					const double ldr = static_cast<double>(dr);
+
+					// Liquid phase
+					jac[0] += inApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j)
+					jac[idxr.strideParShell(parType)] += -inApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j+1)
+				}
+
 				// Surface diffusion contribution
-				if (cadet_unlikely(_hasSurfaceDiffusion[parType]))
+				if (surfDiff)
 				{
 					for (unsigned int i = 0; i < nBound; ++i)
 					{
@@ -1179,10 +1261,6 @@ int GeneralRateModel::residualParticle(double t, unsigned int parType, unsigned
 						const double inApV = static_cast<double>(innerAreaPerVolume);
 						const double ldr = static_cast<double>(dr);
 
-						// Liquid phase
-						jac[0] += inApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j)
-						jac[idxr.strideParShell(parType)] += -inApV * static_cast<double>(dp) / ldr; // dres / dc_p,i^(p,j+1)
-
 						// Solid phase
 						for (unsigned int i = 0; i < nBound; ++i)
 						{
@@ -1197,7 +1275,7 @@ int GeneralRateModel::residualParticle(double t, unsigned int parType, unsigned
 		}
 
 		// Solid phase
-		if (cadet_unlikely(_hasSurfaceDiffusion[parType] && _binding[parType]->hasDynamicReactions()))
+		if (solidSurfDiff)
 		{
 			for (unsigned int bnd = 0; bnd < _disc.strideBound[parType]; ++bnd, ++res, ++y, ++jac)
 			{
@@ -1260,6 +1338,212 @@ int GeneralRateModel::residualParticle(double t, unsigned int parType, unsigned
 	return 0;
 }
 
+/**
+ * @brief Computes the residual of the particle blocks of a batch of particle types in a column cell
+ * @details The particle types of a batch share the same structure (number of shells and bound states)
+ *          and do not have surface diffusion. Time derivatives, binding, and reactions are handled
+ *          for each type (lane) separately. Pore diffusion is evaluated for all lanes at once on
+ *          packed states in which the lanes are stored contiguously (shell-major, then component,
+ *          then lane), such that the innermost loops run over the lanes and can be vectorized.
+ *          The floating point operations are the same as in residualParticle() and performed in
+ *          the same order. Hence, the results are identical to evaluating the types separately.
+ */
+template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
+int GeneralRateModel::residualParticleBatch(double t, unsigned int batch, unsigned int colCell, unsigned int secIdx, StateType const* yBase,
+	double const* yDotBase, ResidualType* resBase, util::ThreadLocalStorage& threadLocalMem)
+{
+	Indexer idxr(_disc);
+
+	unsigned int const* const lanes = _parTypeBatch.data() + _parTypeBatchOffset[batch];
+	const unsigned int nLanes = _parTypeBatchOffset[batch + 1] - _parTypeBatchOffset[batch];
+
+	// All lanes share the same structure
+	const unsigned int nComp = _disc.nComp;
+	const unsigned int nParCell = _disc.nParCell[lanes[0]];
+	const int strideShell = idxr.strideParShell(lanes[0]);
+
+	LinearBufferAllocator tlmAlloc = threadLocalMem.get();
+
+	// Midpoint of current column cell (z coordinate) - needed in externally dependent adsorption kinetic
+	const double z = (0.5 + static_cast<double>(colCell)) / static_cast<double>(_disc.nCol);
+
+	// Handle time derivatives, binding, dynamic reactions of each lane
+	for (unsigned int l = 0; l < nLanes; ++l)
+	{
+		const unsigned int parType = lanes[l];
+		const int offset = idxr.offsetCp(ParticleTypeIndex{parType}, ParticleIndex{colCell});
+
+		StateType const* y = yBase + offset;
+		double const* yDot = yDotBase + offset;
+		ResidualType* res = resBase + offset;
+
+		// Reset Jacobian
+		if (wantJac)
+			_jacP[_disc.nCol * parType + colCell].setAll(0.0);
+
+		linalg::BandMatrix::RowIterator jac = _jacP[_disc.nCol * parType + colCell].row(0);
+
+		active const* const parCenterRadius = _parCenterRadius.data() + _disc.nParCellsBeforeType[parType];
+		int const* const qsReaction = _binding[parType]->reactionQuasiStationarity();
+		const parts::cell::CellParameters cellResParams = makeCellResidualParams(parType, qsReaction);
+
+		for (unsigned int par = 0; par < nParCell; ++par, y += strideShell, yDot += strideShell, res += strideShell, jac += strideShell)
+		{
+			const ColumnPosition colPos{z, 0.0, static_cast<double>(parCenterRadius[par]) / static_cast<double>(_parRadius[parType])};
+
+			parts::cell::residualKernel<StateType, ResidualType, ParamType, parts::cell::CellParameters, linalg::BandMatrix::RowIterator, wantJac, true>(
+				t, secIdx, colPos, y, yDotBase ? yDot : nullptr, res, jac, cellResParams, tlmAlloc
+			);
+		}
+	}
+
+	// Pack mobile phase states, residuals, and transport parameters of all lanes
+	const unsigned int nPacked = nParCell * nComp * nLanes;
+	BufferedArray<StateType> yPackBuffer = tlmAlloc.array<StateType>(nPacked);
+	BufferedArray<ResidualType> resPackBuffer = tlmAlloc.array<ResidualType>(nPacked);
+	BufferedArray<ParamType> geomBuffer = tlmAlloc.array<ParamType>(4 * nParCell * nLanes);
+	BufferedArray<ParamType> parDiffBuffer = tlmAlloc.array<ParamType>(nComp * nLanes);
+	BufferedArray<double> jacPackBuffer = tlmAlloc.array<double>(wantJac ? 2 * nPacked : 0);
+
+	StateType* const yPack = static_cast<StateType*>(yPackBuffer);
+	ResidualType* const resPack = static_cast<ResidualType*>(resPackBuffer);
+	ParamType* const outerAreaPerVolume = static_cast<ParamType*>(geomBuffer);
+	ParamType* const innerAreaPerVolume = outerAreaPerVolume + nParCell * nLanes;
+	ParamType* const drOuter = innerAreaPerVolume + nParCell * nLanes;
+	ParamType* const drInner = drOuter + nParCell * nLanes;
+	ParamType* const parDiff = static_cast<ParamType*>(parDiffBuffer);
+	double* const jacOuterPack = static_cast<double*>(jacPackBuffer);
+	double* const jacInnerPack = jacOuterPack + nPacked;
+
+	for (unsigned int l = 0; l < nLanes; ++l)
+	{
+		const unsigned int parType = lanes[l];
+		const int offset = idxr.offsetCp(ParticleTypeIndex{parType}, ParticleIndex{colCell});
+
+		active const* const laneParDiff = getSectionDependentSlice(_parDiffusion, _disc.nComp * _disc.nParType, secIdx) + parType * _disc.nComp;
+		for (unsigned int comp = 0; comp < nComp; ++comp)
+			parDiff[comp * nLanes + l] = static_cast<ParamType>(laneParDiff[comp]);
+
+		active const* const outerSurfPerVol = _parOuterSurfAreaPerVolume.data() + _disc.nParCellsBeforeType[parType];
+		active const* const innerSurfPerVol = _parInnerSurfAreaPerVolume.data() + _disc.nParCellsBeforeType[parType];
+		active const* const parCenterRadius = _parCenterRadius.data() + _disc.nParCellsBeforeType[parType];
+
+		for (unsigned int par = 0; par < nParCell; ++par)
+		{
+			outerAreaPerVolume[par * nLanes + l] = static_cast<ParamType>(outerSurfPerVol[par]);
+			innerAreaPerVolume[par * nLanes + l] = static_cast<ParamType>(innerSurfPerVol[par]);
+
+			// Differences between two cell-centers
+			if (cadet_likely(par != 0))
+				drOuter[par * nLanes + l] = static_cast<ParamType>(parCenterRadius[par - 1]) - static_cast<ParamType>(parCenterRadius[par]);
+			if (cadet_likely(par != nParCell - 1))
+				drInner[par * nLanes + l] = static_cast<ParamType>(parCenterRadius[par]) - static_cast<ParamType>(parCenterRadius[par + 1]);
+
+			StateType const* const y = yBase + offset + par * strideShell;
+			ResidualType const* const res = resBase + offset + par * strideShell;
+			for (unsigned int comp = 0; comp < nComp; ++comp)
+			{
+				yPack[(par * nComp + comp) * nLanes + l] = y[comp];
+				resPack[(par * nComp + comp) * nLanes + l] = res[comp];
+			}
+		}
+	}
+
+	// Pore diffusion of all lanes
+	for (unsigned int par = 0; par < nParCell; ++par)
+	{
+		ParamType const* const ouApV = outerAreaPerVolume + par * nLanes;
+		ParamType const* const inApV = innerAreaPerVolume + par * nLanes;
+		ParamType const* const drOu = drOuter + par * nLanes;
+		ParamType const* const drIn = drInner + par * nLanes;
+
+		for (unsigned int comp = 0; comp < nComp; ++comp)
+		{
+			const unsigned int idx = (par * nComp + comp) * nLanes;
+			ResidualType* const res = resPack + idx;
+			StateType const* const y = yPack + idx;
+			ParamType const* const dp = parDiff + comp * nLanes;
+
+			// Add flow through outer surface
+			// Note that inflow boundary conditions are handled in residualFlux().
+			if (cadet_likely(par != 0))
+			{
+				StateType const* const yOuter = y - nComp * nLanes;
+				for (unsigned int l = 0; l < nLanes; ++l)
+				{
+					const ResidualType gradCp = (yOuter[l] - y[l]) / drOu[l];
+					res[l] -= ouApV[l] * dp[l] * gradCp;
+				}
+
+				if (wantJac)
+				{
+					double* const jacOuter = jacOuterPack + idx;
+					for (unsigned int l = 0; l < nLanes; ++l)
+						jacOuter[l] = static_cast<double>(ouApV[l]) * static_cast<double>(dp[l]) / static_cast<double>(drOu[l]);
+				}
+			}
+
+			// Add flow through inner surface
+			// Note that this term vanishes for the most inner shell due to boundary conditions
+			if (cadet_likely(par != nParCell - 1))
+			{
+				StateType const* const yInner = y + nComp * nLanes;
+				for (unsigned int l = 0; l < nLanes; ++l)
+				{
+					const ResidualType gradCp = (y[l] - yInner[l]) / drIn[l];
+					res[l] += inApV[l] * dp[l] * gradCp;
+				}
+
+				if (wantJac)
+				{
+					double* const jacInner = jacInnerPack + idx;
+					for (unsigned int l = 0; l < nLanes; ++l)
+						jacInner[l] = static_cast<double>(inApV[l]) * static_cast<double>(dp[l]) / static_cast<double>(drIn[l]);
+				}
+			}
+		}
+	}
+
+	// Unpack residuals and add pore diffusion to the Jacobian of each lane
+	for (unsigned int l = 0; l < nLanes; ++l)
+	{
+		ResidualType* res = resBase + idxr.offsetCp(ParticleTypeIndex{lanes[l]}, ParticleIndex{colCell});
+		for (unsigned int par = 0; par < nParCell; ++par, res += strideShell)
+		{
+			for (unsigned int comp = 0; comp < nComp; ++comp)
+				res[comp] = resPack[(par * nComp + comp) * nLanes + l];
+		}
+
+		if (wantJac)
+		{
+			linalg::BandMatrix::RowIterator jac = _jacP[_disc.nCol * lanes[l] + colCell].row(0);
+			for (unsigned int par = 0; par < nParCell; ++par)
+			{
+				for (unsigned int comp = 0; comp < nComp; ++comp, ++jac)
+				{
+					const unsigned int idx = (par * nComp + comp) * nLanes + l;
+					if (cadet_likely(par != 0))
+					{
+						jac[0] += jacOuterPack[idx]; // dres / dc_p,i^(p,j)
+						jac[-strideShell] += -jacOuterPack[idx]; // dres / dc_p,i^(p,j-1)
+					}
+
+					if (cadet_likely(par != nParCell - 1))
+					{
+						jac[0] += jacInnerPack[idx]; // dres / dc_p,i^(p,j)
+						jac[strideShell] += -jacInnerPack[idx]; // dres / dc_p,i^(p,j+1)
+					}
+				}
+
+				// Skip solid phase
+				jac += strideShell - static_cast<int>(nComp);
+			}
+		}
+	}
+
+	return 0;
+}
+
 template <typename StateType, typename ResidualType, typename ParamType>
 int GeneralRateModel::residualFlux(double t, unsigned int secIdx, StateType const* yBase, double const* yDotBase, ResidualType* resBase)
 {
@@ -1493,6 +1777,9 @@ int GeneralRateModel::residualSensFwdCombine(const SimulationTime& simTime, cons
 
 	for (unsigned int param = 0; param < yS.size(); ++param)
 	{
+		if (!yS[param])
+			continue;
+
 		// Directional derivative (dF / dy) * s
 		multiplyWithJacobian(SimulationTime{0.0, 0u}, ConstSimulationState{nullptr, nullptr}, yS[param], 1.0, 0.0, tmp1);
 
@@ -1796,6 +2083,80 @@ void GeneralRateModel::updateRadialDisc()
 	}
 }
 
+/**
+ * @brief Groups particle types into batches that are evaluated together
+ * @details Particle types without surface diffusion that have the same number of shells and
+ *          the same number of bound states for each component form a batch. All other types
+ *          are put into a batch of their own. The batches are ordered by their first type.
+ * @param [in] batchParTypes Determines whether same-structured particle types are grouped
+ */
+void GeneralRateModel::updateParticleTypeBatches(bool batchParTypes)
+{
+	std::vector<std::vector<unsigned int>> batches;
+	batches.reserve(_disc.nParType);
+
+	for (unsigned int i = 0; i < _disc.nParType; ++i)
+	{
+		bool found = false;
+		if (batchParTypes && !_hasSurfaceDiffusion[i])
+		{
+			for (std::vector<unsigned int>& b : batches)
+			{
+				const unsigned int j = b[0];
+				if (_hasSurfaceDiffusion[j] || (_disc.nParCell[i] != _disc.nParCell[j]))
+					continue;
+
+				if (!std::equal(_disc.nBound + i * _disc.nComp, _disc.nBound + (i + 1) * _disc.nComp, _disc.nBound + j * _disc.nComp))
+					continue;
+
+				b.push_back(i);
+				found = true;
+				break;
+			}
+		}
+
+		if (!found)
+			batches.push_back(std::vector<unsigned int>(1, i));
+	}
+
+	_parTypeBatch.clear();
+	_parTypeBatch.reserve(_disc.nParType);
+	_parTypeBatchOffset.clear();
+	_parTypeBatchOffset.reserve(batches.size() + 1);
+	for (const std::vector<unsigned int>& b : batches)
+	{
+		_parTypeBatchOffset.push_back(_parTypeBatch.size());
+		_parTypeBatch.insert(_parTypeBatch.end(), b.begin(), b.end());
+	}
+	_parTypeBatchOffset.push_back(_parTypeBatch.size());
+}
+
+/**
+ * @brief Selects the variant of residualParticle() used for each particle type
+ * @details Surface diffusion and dynamic binding are fixed after configuration. Resolving them
+ *          once here removes the corresponding branches from the loops over the particle shells.
+ *          The indices refer to the variant table in residualImpl():
+ *            - @c 0 No surface diffusion
+ *            - @c 1 Surface diffusion of quasi-stationary bound states only
+ *            - @c 2 Surface diffusion of all bound states (dynamic binding)
+ *
+ *          Other settings (e.g., WENO order, film diffusion, external functions, and particle
+ *          discretization) are not part of the variants and are still evaluated at run time.
+ */
+void GeneralRateModel::updateParticleKernels()
+{
+	_parKernel.resize(_disc.nParType);
+	for (unsigned int i = 0; i < _disc.nParType; ++i)
+	{
+		if (!_hasSurfaceDiffusion[i])
+			_parKernel[i] = 0;
+		else if (_binding[i]->hasDynamicReactions())
+			_parKernel[i] = 2;
+		else
+			_parKernel[i] = 1;
+	}
+}
+
 bool GeneralRateModel::setParameter(const ParameterId& pId, double value)
 {
 	if (pId.unitOperation == _unitOpIdx)
@@ -1848,6 +2209,47 @@ bool GeneralRateModel::setParameter(const ParameterId& pId, double value)
 	return result;
 }
 
+bool GeneralRateModel::resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage)
+{
+	if (pId.unitOperation == _unitOpIdx)
+	{
+		if (multiplexCompTypeSecParameterStorage(pId, hashString("PORE_ACCESSIBILITY"), _poreAccessFactorMode, _poreAccessFactor, _disc.nParType, _disc.nComp, storage))
+			return true;
+		if (multiplexCompTypeSecParameterStorage(pId, hashString("FILM_DIFFUSION"), _filmDiffusionMode, _filmDiffusion, _disc.nParType, _disc.nComp, storage))
+			return true;
+		if (multiplexCompTypeSecParameterStorage(pId, hashString("PAR_DIFFUSION"), _parDiffusionMode, _parDiffusion, _disc.nParType, _disc.nComp, storage))
+			return true;
+		if (multiplexBndCompTypeSecParameterStorage(pId, hashString("PAR_SURFDIFFUSION"), _parSurfDiffusionMode, _parSurfDiffusion, _disc.nParType, _disc.nComp, _disc.strideBound, _disc.nBound, _disc.boundOffset, storage))
+			return true;
+
+		// Multiplexed initial conditions and particle radii (which require an update of the radial discretization) are set by setParameter()
+		if ((pId.name == hashString("INIT_CP")) || (pId.name == hashString("INIT_Q")) || (pId.name == hashString("PAR_RADIUS")) || (pId.name == hashString("PAR_CORERADIUS")))
+			return false;
+
+		// Intercept changes to PAR_TYPE_VOLFRAC when not specified per axial cell (but once globally)
+		if (_axiallyConstantParTypeVolFrac && (pId.name == hashString("PAR_TYPE_VOLFRAC")))
+		{
+			if ((pId.section != SectionIndep) || (pId.component != CompIndep) || (pId.boundState != BoundStateIndep) || (pId.reaction != ReactionIndep))
+				return true;
+			if (pId.particleType >= _disc.nParType)
+				return true;
+
+			for (unsigned int i = 0; i < _disc.nCol; ++i)
+				storage.push_back(&_parTypeVolFrac[i * _disc.nParType + pId.particleType]);
+
+			return true;
+		}
+
+		if (multiplexTypeParameterStorage(pId, hashString("PAR_POROSITY"), _singleParPorosity, _parPorosity, storage))
+			return true;
+
+		if (_convDispOp.resolveParameterStorage(pId, storage))
+			return true;
+	}
+
+	return UnitOperationBase::resolveParameterStorage(pId, storage);
+}
+
 void GeneralRateModel::setSensitiveParameterValue(const ParameterId& pId, double value)
 {
 	if (pId.unitOperation == _unitOpIdx)
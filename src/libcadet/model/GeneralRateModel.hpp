@@ -25,6 +25,7 @@
 #include "AutoDiff.hpp"
 #include "linalg/SparseMatrix.hpp"
 #include "linalg/BandMatrix.hpp"
+#include "linalg/BlockTridiagonalMatrix.hpp"
 #include "linalg/Gmres.hpp"
 #include "Memory.hpp"
 #include "model/ModelUtils.hpp"
@@ -115,6 +116,8 @@ public:
 
 	virtual int linearSolve(double t, double alpha, double tol, double* const rhs, double const* const weight,
 		const ConstSimulationState& simState);
+	virtual void setAdaptiveLinearSolverTolerance(bool adaptive) CADET_NOEXCEPT { _adaptiveLinearTol = adaptive; }
+	virtual unsigned long numLinearSolverIterations() const CADET_NOEXCEPT { return _gmres.numIterations(); }
 
 	virtual void prepareADvectors(const AdJacobianParams& adJac) const;
 
@@ -158,6 +161,7 @@ public:
 	virtual bool setParameter(const ParameterId& pId, double value);
 	virtual bool setSensitiveParameter(const ParameterId& pId, unsigned int adDirection, double adValue);
 	virtual void setSensitiveParameterValue(const ParameterId& id, double value);
+	virtual bool resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage);
 
 	virtual unsigned int threadLocalMemorySize() const CADET_NOEXCEPT;
 
@@ -212,9 +216,12 @@ protected:
 	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
 	int residualBulk(double t, unsigned int secIdx, StateType const* y, double const* yDot, ResidualType* res, util::ThreadLocalStorage& threadLocalMem);
 
-	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
+	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac, bool surfDiff, bool solidSurfDiff>
 	int residualParticle(double t, unsigned int parType, unsigned int colCell, unsigned int secIdx, StateType const* y, double const* yDot, ResidualType* res, util::ThreadLocalStorage& threadLocalMem);
 
+	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
+	int residualParticleBatch(double t, unsigned int batch, unsigned int colCell, unsigned int secIdx, StateType const* y, double const* yDot, ResidualType* res, util::ThreadLocalStorage& threadLocalMem);
+
 	template <typename StateType, typename ResidualType, typename ParamType>
 	int residualFlux(double t, unsigned int secIdx, StateType const* y, double const* yDot, ResidualType* res);
 
@@ -223,13 +230,18 @@ protected:
 
 	int schurComplementMatrixVector(double const* x, double* z) const;
 	void assembleDiscretizedJacobianParticleBlock(unsigned int parType, unsigned int pblk, double alpha, const Indexer& idxr);
+	bool factorizeDiscretizedJacobianParticleBlock(unsigned int parType, unsigned int pblk);
+	bool solveDiscretizedJacobianParticleBlock(unsigned int parType, unsigned int pblk, double* const rhs) const;
 	
 	void setEquidistantRadialDisc(unsigned int parType);
 	void setEquivolumeRadialDisc(unsigned int parType);
 	void setUserdefinedRadialDisc(unsigned int parType);
 	void updateRadialDisc();
+	void updateParticleTypeBatches(bool batchParTypes);
+	void updateParticleKernels();
 
 	void addTimeDerivativeToJacobianParticleShell(linalg::FactorizableBandMatrix::RowIterator& jac, const Indexer& idxr, double alpha, unsigned int parType);
+	void addTimeDerivativeToJacobianParticleShell(linalg::DenseBandedRowIterator& jac, const Indexer& idxr, double alpha, unsigned int parType);
 	void solveForFluxes(double* const vecState, const Indexer& idxr) const;
 	
 	unsigned int numAdDirsForJacobian() const CADET_NOEXCEPT;
@@ -284,6 +296,11 @@ protected:
 
 	linalg::BandMatrix* _jacP; //!< Particle jacobian diagonal blocks (all of them)
 	linalg::FactorizableBandMatrix* _jacPdisc; //!< Particle jacobian diagonal blocks (all of them) with time derivatives from BDF method
+	std::vector<linalg::BlockTridiagonalMatrix> _jacPdiscBlk; //!< Particle jacobian diagonal blocks with time derivatives in block tridiagonal storage (only types without surface diffusion)
+	std::vector<bool> _parBlockTridiag; //!< Determines whether the particle blocks of each type are solved by the block tridiagonal solver
+	std::vector<unsigned int> _parTypeBatch; //!< Particle type indices grouped by batches of same-structured types
+	std::vector<unsigned int> _parTypeBatchOffset; //!< Offset of each batch in _parTypeBatch, additional last element contains number of particle types
+	std::vector<unsigned int> _parKernel; //!< Variant of residualParticle() used for each particle type (see updateParticleKernels())
 
 	linalg::DoubleSparseMatrix _jacCF; //!< Jacobian block connecting interstitial states and fluxes (interstitial transport equation)
 	linalg::DoubleSparseMatrix _jacFC; //!< Jacobian block connecting fluxes and interstitial states (flux equation)
@@ -328,6 +345,7 @@ protected:
 	double* _tempState; //!< Temporary storage with the size of the state vector or larger if binding models require it
 	linalg::Gmres _gmres; //!< GMRES algorithm for the Schur-complement in linearSolve()
 	double _schurSafety; //!< Safety factor for Schur-complement solution
+	bool _adaptiveLinearTol; //!< Determines whether the tolerance passed to linearSolve() is a forcing term
 
 	std::vector<active> _initC; //!< Liquid bulk phase initial conditions
 	std::vector<active> _initCp; //!< Liquid particle phase initial conditions
@@ -634,7 +634,9 @@ void GeneralRateModel2D::consistentInitialState(const SimulationTime& simTime, d
 			LinearBufferAllocator tlmAlloc = threadLocalMem.get();
 
 			// Reuse memory of band matrix for dense matrix
-			linalg::DenseMatrixView fullJacobianMatrix(_jacPdisc[type * _disc.nCol * _disc.nRad + pblk].data(), nullptr, mask.len, mask.len);
+			linalg::FactorizableBandMatrix localScratch;
+			linalg::FactorizableBandMatrix& scratch = particleJacobianScratch(type * _disc.nCol * _disc.nRad + pblk, localScratch);
+			linalg::DenseMatrixView fullJacobianMatrix(scratch.data(), nullptr, mask.len, mask.len);
 
 			// Midpoint of current column cell (z, rho coordinate) - needed in externally dependent adsorption kinetic
 			const unsigned int axialCell = pblk / _disc.nRad;
@@ -661,7 +663,7 @@ void GeneralRateModel2D::consistentInitialState(const SimulationTime& simTime, d
 			BufferedArray<double> conservedQuantsBuffer = tlmAlloc.array<double>(numActiveComp);
 			double* const conservedQuants = static_cast<double*>(conservedQuantsBuffer);
 
-			linalg::DenseMatrixView jacobianMatrix(jacobianMem, _jacPdisc[type * _disc.nCol * _disc.nRad + pblk].pivot(), probSize, probSize);
+			linalg::DenseMatrixView jacobianMatrix(jacobianMem, scratch.pivot(), probSize, probSize);
 			const parts::cell::CellParameters cellResParams
 				{
 					_disc.nComp,
@@ -729,16 +731,16 @@ void GeneralRateModel2D::consistentInitialState(const SimulationTime& simTime, d
 
 						// Compare
 						const double diff = ad::compareDenseJacobianWithBandedAd(
-							localAdRes - localOffsetInParticle, localOffsetInParticle, adJac.adDirOffset, _jacP[type * _disc.nCol * _disc.nRad].lowerBandwidth(),
-							_jacP[type * _disc.nCol * _disc.nRad].lowerBandwidth(), _jacP[type * _disc.nCol * _disc.nRad].upperBandwidth(), fullJacobianMatrix
+							localAdRes - localOffsetInParticle, localOffsetInParticle, adJac.adDirOffset, particleJacobianLowerBandwidth(type),
+							particleJacobianLowerBandwidth(type), particleJacobianUpperBandwidth(type), fullJacobianMatrix
 						);
 						LOG(Debug) << "MaxDiff: " << diff;
 #endif
 
 						// Extract Jacobian from AD
 						ad::extractDenseJacobianFromBandedAd(
-							localAdRes - localOffsetInParticle, localOffsetInParticle, adJac.adDirOffset, _jacP[type * _disc.nCol * _disc.nRad].lowerBandwidth(),
-							_jacP[type * _disc.nCol * _disc.nRad].lowerBandwidth(), _jacP[type * _disc.nCol * _disc.nRad].upperBandwidth(), fullJacobianMatrix
+							localAdRes - localOffsetInParticle, localOffsetInParticle, adJac.adDirOffset, particleJacobianLowerBandwidth(type),
+							particleJacobianLowerBandwidth(type), particleJacobianUpperBandwidth(type), fullJacobianMatrix
 						);
 
 						// Extract Jacobian from full Jacobian
@@ -972,11 +974,18 @@ void GeneralRateModel2D::consistentInitialTimeDerivative(const SimulationTime& s
 		const double z = (0.5 + static_cast<double>(axialCell)) / static_cast<double>(_disc.nCol);
 
 		// Assemble
-		linalg::FactorizableBandMatrix& fbm = _jacPdisc[pblk];
+		linalg::FactorizableBandMatrix localScratch;
+		linalg::FactorizableBandMatrix& fbm = particleJacobianScratch(pblk, localScratch);
 		fbm.setAll(0.0);
 
 		linalg::FactorizableBandMatrix::RowIterator jac = fbm.row(0);
 
+		// Particle Jacobian blocks are not stored in Jacobian-free mode
+		linalg::BandMatrix localJacP;
+		if (_jacobianFree && _binding[type]->hasQuasiStationaryReactions())
+			particleJacobianBlock(simTime.t, simTime.secIdx, pblk, vecStateY, localJacP, threadLocalMem);
+		linalg::BandMatrix& jacP = _jacobianFree ? localJacP : _jacP[pblk];
+
 		LinearBufferAllocator tlmAlloc = threadLocalMem.get();
 		double* const dFluxDt = _tempState + idxr.offsetCp(ParticleTypeIndex{type}, ParticleIndex{par});
 
@@ -989,7 +998,7 @@ void GeneralRateModel2D::consistentInitialTimeDerivative(const SimulationTime& s
 				continue;
 
 			// Get iterators to beginning of solid phase
-			linalg::BandMatrix::RowIterator jacSolidOrig = _jacP[pblk].row(j * static_cast<unsigned int>(idxr.strideParShell(type)) + static_cast<unsigned int>(idxr.strideParLiquid()));
+			linalg::BandMatrix::RowIterator jacSolidOrig = jacP.row(j * static_cast<unsigned int>(idxr.strideParShell(type)) + static_cast<unsigned int>(idxr.strideParLiquid()));
 			linalg::FactorizableBandMatrix::RowIterator jacSolid = jac - idxr.strideParBound(type);
 
 			int const* const mask = _binding[type]->reactionQuasiStationarity();
@@ -1324,7 +1333,15 @@ void GeneralRateModel2D::consistentInitialSensitivity(const SimulationTime& simT
 #endif
 			{
 				// Reuse memory of band matrix for dense matrix
-				linalg::DenseMatrixView jacobianMatrix(_jacPdisc[type * _disc.nCol * _disc.nRad + pblk].data(), _jacPdisc[type * _disc.nCol * _disc.nRad + pblk].pivot(), probSize, probSize);
+				linalg::FactorizableBandMatrix localScratch;
+				linalg::FactorizableBandMatrix& scratch = particleJacobianScratch(type * _disc.nCol * _disc.nRad + pblk, localScratch);
+				linalg::DenseMatrixView jacobianMatrix(scratch.data(), scratch.pivot(), probSize, probSize);
+
+				// Particle Jacobian blocks are not stored in Jacobian-free mode
+				linalg::BandMatrix localJacP;
+				if (_jacobianFree)
+					particleJacobianBlock(simTime.t, simTime.secIdx, type * _disc.nCol * _disc.nRad + pblk, simState.vecStateY, localJacP, threadLocalMem);
+				linalg::BandMatrix& jacP = _jacobianFree ? localJacP : _jacP[type * _disc.nCol * _disc.nRad + pblk];
 
 				// Get workspace memory
 				LinearBufferAllocator tlmAlloc = threadLocalMem.get();
@@ -1345,7 +1362,7 @@ void GeneralRateModel2D::consistentInitialSensitivity(const SimulationTime& simT
 
 					// Extract subproblem Jacobian from full Jacobian
 					jacobianMatrix.setAll(0.0);
-					linalg::copyMatrixSubset(_jacP[type * _disc.nCol * _disc.nRad + pblk], mask, mask, jacRowOffset, 0, jacobianMatrix);
+					linalg::copyMatrixSubset(jacP, mask, mask, jacRowOffset, 0, jacobianMatrix);
 
 					// Construct right hand side
 					linalg::selectVectorSubset(sensYdot + localQOffset, mask, rhs);
@@ -1355,7 +1372,7 @@ void GeneralRateModel2D::consistentInitialSensitivity(const SimulationTime& simT
 					linalg::fillVectorSubset(maskedMultiplier + _disc.nComp, mask, 0.0);
 
 					// Assemble right hand side
-					_jacP[type * _disc.nCol * _disc.nRad + pblk].submatrixMultiplyVector(maskedMultiplier, jacRowOffset, -static_cast<int>(_disc.nComp), _disc.strideBound[type], idxr.strideParShell(type), rhsUnmasked);
+					jacP.submatrixMultiplyVector(maskedMultiplier, jacRowOffset, -static_cast<int>(_disc.nComp), _disc.strideBound[type], idxr.strideParShell(type), rhsUnmasked);
 					linalg::vectorSubsetAdd(rhsUnmasked, mask, -1.0, 1.0, rhs);
 
 					// Precondition
@@ -1401,9 +1418,16 @@ void GeneralRateModel2D::consistentInitialSensitivity(const SimulationTime& simT
 			const unsigned int par = pblk % (_disc.nCol * _disc.nRad);
 
 			// Assemble
-			linalg::FactorizableBandMatrix& fbm = _jacPdisc[pblk];
+			linalg::FactorizableBandMatrix localScratch;
+			linalg::FactorizableBandMatrix& fbm = particleJacobianScratch(pblk, localScratch);
 			fbm.setAll(0.0);
 
+			// Particle Jacobian blocks are not stored in Jacobian-free mode
+			linalg::BandMatrix localJacP;
+			if (_jacobianFree && _binding[type]->hasQuasiStationaryReactions())
+				particleJacobianBlock(simTime.t, simTime.secIdx, pblk, simState.vecStateY, localJacP, threadLocalMem);
+			linalg::BandMatrix& jacP = _jacobianFree ? localJacP : _jacP[pblk];
+
 			linalg::FactorizableBandMatrix::RowIterator jac = fbm.row(0);
 			for (unsigned int j = 0; j < _disc.nParCell[type]; ++j)
 			{
@@ -1415,7 +1439,7 @@ void GeneralRateModel2D::consistentInitialSensitivity(const SimulationTime& simT
 				if (_binding[type]->hasQuasiStationaryReactions())
 				{
 					// Get iterators to beginning of solid phase
-					linalg::BandMatrix::RowIterator jacSolidOrig = _jacP[pblk].row(j * static_cast<unsigned int>(idxr.strideParShell(type)) + static_cast<unsigned int>(idxr.strideParLiquid()));
+					linalg::BandMatrix::RowIterator jacSolidOrig = jacP.row(j * static_cast<unsigned int>(idxr.strideParShell(type)) + static_cast<unsigned int>(idxr.strideParLiquid()));
 					linalg::FactorizableBandMatrix::RowIterator jacSolid = jac - idxr.strideParBound(type);
 
 					int const* const mask = _binding[type]->reactionQuasiStationarity();
@@ -15,10 +15,13 @@
 #include "model/parts/BindingCellKernel.hpp"
 #include "linalg/DenseMatrix.hpp"
 #include "linalg/BandMatrix.hpp"
+#include "linalg/EisenstatWalker.hpp"
+#include "linalg/Norms.hpp"
 #include "AdUtils.hpp"
 
 #include <algorithm>
 #include <functional>
+#include <limits>
 
 #include "LoggingUtils.hpp"
 #include "Logging.hpp"
@@ -113,6 +116,9 @@ int GeneralRateModel2D::linearSolve(double t, double alpha, double outerTol, dou
 {
 	BENCH_SCOPE(_timerLinearSolve);
 
+	if (_jacobianFree)
+		return linearSolveJacobianFree(t, alpha, outerTol, rhs, weight, simState);
+
 	Indexer idxr(_disc);
 
 	// ==== Step 1: Factorize diagonal Jacobian blocks
@@ -251,7 +257,7 @@ int GeneralRateModel2D::linearSolve(double t, double alpha, double outerTol, dou
 
 		// Note that rhs is updated in-place with the solution of the Schur-complement
 		// The temporary storage is only needed to hold the right hand side of the Schur-complement
-		const double tolerance = std::sqrt(static_cast<double>(_gmres.matrixSize())) * outerTol * _schurSafety;
+		const double tolerance = linalg::gmresTolerance(_adaptiveLinearTol, outerTol, _schurSafety, rhs + idxr.offsetJf(), weight + idxr.offsetJf(), _gmres.matrixSize(), _gmres.matrixSize());
 
 		BENCH_START(_timerGmres);
 		const int gmresResult = _gmres.solve(tolerance, weight + idxr.offsetJf(), _tempState + idxr.offsetJf(), rhs + idxr.offsetJf());
@@ -465,6 +471,406 @@ int GeneralRateModel2D::schurComplementMatrixVector(double const* x, double* z)
 	return 0;
 }
 
+/**
+ * @brief Solves the linear system involving the system Jacobian without storing the Jacobian
+ * @details Solves the full system @f$ J x = b @f$ with @f$ J = \frac{\partial F}{\partial y} + \alpha \frac{\partial F}{\partial \dot{y}} @f$
+ *          by left preconditioned GMRES, that is, @f$ P^{-1} J x = P^{-1} b @f$ is solved. As in IDAS, the residual
+ *          of the preconditioned system is measured in the weighted norm of the state, which is well scaled in contrast
+ *          to the residual of the (badly scaled) binding equations. The matrix-vector products with @f$ J @f$ are
+ *          directional derivatives of the residual at the given point, see jacobianFreeMatrixVector(). The block
+ *          preconditioner @f$ P @f$ is described in applyBlockPreconditioner(). It is factorized once per Jacobian update.
+ *
+ *          Compared to linearSolve(), the particle Jacobian blocks are not stored (only their preconditioner) and the
+ *          bulk block is not factorized by a direct solver (unless selected), which reduces memory consumption at the cost
+ *          of one residual evaluation per linear iteration.
+ *
+ * @param [in] t Current time point
+ * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+ * @param [in] outerTol Error tolerance for the solution of the linear system from outer Newton iteration
+ * @param [in,out] rhs On entry the right hand side of the linear equation system, on exit the solution
+ * @param [in] weight Vector with error weights
+ * @param [in] simState State of the simulation (state vector and its time derivatives) at which the Jacobian is evaluated
+ * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+ */
+int GeneralRateModel2D::linearSolveJacobianFree(double t, double alpha, double outerTol, double* const rhs, double const* const weight, const ConstSimulationState& simState)
+{
+	// Update the preconditioner only if the Jacobian has changed
+	if (_factorizeJacobian)
+	{
+		BENCH_SCOPE(_timerFactorize);
+
+		const bool result = _convDispOp.assembleAndFactorizeDiscretizedJacobian(alpha);
+		if (cadet_unlikely(!result))
+		{
+			LOG(Error) << "Factorize() failed for bulk block";
+		}
+
+		factorizeBlockPreconditioner(alpha);
+
+		_factorizeJacobian = false;
+	}
+
+	// Save point of linearization for the directional derivatives
+	_jfnkAlpha = alpha;
+	_jfnkTime = t;
+	_jfnkY = simState.vecStateY;
+	_jfnkYdot = simState.vecStateYdot;
+
+	_jfnkThreadLocalMem.resize(threadLocalMemorySize());
+	residual(SimulationTime{t, _jfnkSecIdx}, simState, _jfnkRes.data(), _jfnkThreadLocalMem);
+
+	// Solve P^{-1} * J * x = P^{-1} * b starting from x = 0
+	std::copy(rhs, rhs + numDofs(), _jfnkRhs.data());
+	applyBlockPreconditioner(_jfnkRhs.data());
+	std::fill(rhs, rhs + numDofs(), 0.0);
+
+	const double tolerance = linalg::gmresTolerance(_adaptiveLinearTol, outerTol, _schurSafety, _jfnkRhs.data(), weight, numDofs(), _gmres.matrixSize());
+
+	BENCH_START(_timerGmres);
+	const int gmresResult = _gmres.solve(tolerance, weight, _jfnkRhs.data(), rhs);
+	BENCH_STOP(_timerGmres);
+
+	if (cadet_unlikely(gmresResult < 0))
+	{
+		LOG(Error) << "GMRES failed in Jacobian-free mode: " << _gmres.getReturnFlagName(gmresResult);
+		return -1;
+	}
+
+	// Let the time integrator reduce the step size if GMRES did not converge
+	return (gmresResult == 0) ? 0 : 1;
+}
+
+/**
+ * @brief Performs the matrix-vector product @f$ z = P^{-1} J x @f$ with the left preconditioned system Jacobian
+ * @details The Jacobian @f$ J = \frac{\partial F}{\partial y} + \alpha \frac{\partial F}{\partial \dot{y}} @f$ is not
+ *          assembled. Instead, the product @f$ J x @f$ is approximated by a directional derivative of the residual,
+ *          see residualDirectionalDerivative(). The increment is relative to the norm of the state vector and does
+ *          not depend on the error weights, which may be arbitrary.
+ * @param [in] x Vector @f$ x @f$ the matrix is multiplied with
+ * @param [out] z Result of the matrix-vector multiplication
+ * @return @c 0 if successful, any other value in case of failure
+ */
+int GeneralRateModel2D::jacobianFreeMatrixVector(double const* x, double* z)
+{
+	BENCH_SCOPE(_timerMatVec);
+
+	// Relative increment, see Brown and Saad (1990)
+	const double yNorm = linalg::l2Norm(_jfnkY, numDofs());
+	const double xNorm = linalg::l2Norm(x, numDofs());
+	const double sigma = (xNorm > 0.0) ? std::sqrt(std::numeric_limits<double>::epsilon()) * (1.0 + yNorm) / xNorm : 1.0;
+	const int retCode = residualDirectionalDerivative(_jfnkTime, _jfnkSecIdx, _jfnkY, _jfnkYdot, _jfnkRes.data(), _jfnkAlpha, sigma, x, z);
+
+	// Apply preconditioner
+	applyBlockPreconditioner(z);
+	return retCode;
+}
+
+/**
+ * @brief Keeps the part of a particle Jacobian block that is required by the preconditioner in Jacobian-free mode
+ * @details Depending on the preconditioner, the full block is copied or only the diagonal blocks of the particle
+ *          shells. The time derivatives are added and the blocks are factorized in factorizeBlockPreconditioner().
+ * @param [in] pblk Index of the particle block (type-major ordering)
+ * @param [in] jacBlock Jacobian of the particle block
+ */
+void GeneralRateModel2D::storeParticlePreconditionerBlock(unsigned int pblk, const linalg::BandMatrix& jacBlock)
+{
+	if (_jfnkParticlePrecond)
+	{
+		_jacPdisc[pblk].copyOver(jacBlock);
+		return;
+	}
+
+	Indexer idxr(_disc);
+	const unsigned int type = pblk / (_disc.nCol * _disc.nRad);
+	const unsigned int par = pblk % (_disc.nCol * _disc.nRad);
+	const unsigned int strideShell = idxr.strideParShell(type);
+	double* const shellJac = _jfnkShellJac.data() + _jfnkShellOffset[type] + par * _disc.nParCell[type] * strideShell * strideShell;
+
+	for (unsigned int shell = 0; shell < _disc.nParCell[type]; ++shell)
+	{
+		linalg::DenseMatrixView jac(shellJac + shell * strideShell * strideShell, nullptr, strideShell, strideShell);
+		jac.copySubmatrixFromBanded(jacBlock, shell * strideShell, 0, strideShell, strideShell);
+	}
+}
+
+/**
+ * @brief Factorizes the particle blocks and the flux Schur complements of the preconditioner
+ * @details This is called once per Jacobian update in Jacobian-free mode after the bulk block has been
+ *          factorized. The time derivatives are added to the particle blocks before they are factorized.
+ *
+ *          The fluxes of a column cell are only coupled to the bulk cell and the particles in this cell.
+ *          Hence, the Schur complement @f$ S = I - J_{f,0} D_0^{-1} J_{0,f} - \sum_i J_{f,i} J_i^{-1} J_{i,f} @f$
+ *          of the flux equations is block diagonal with one dense block per column cell, where @f$ D_0 @f$
+ *          is the diagonal of the bulk block. These blocks are assembled column by column by applying the
+ *          operators to vectors that have a unit entry in one flux of every column cell.
+ * @param [in] alpha Value of \f$ \alpha \f$ (arises from BDF time discretization)
+ */
+void GeneralRateModel2D::factorizeBlockPreconditioner(double alpha)
+{
+	Indexer idxr(_disc);
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nCol * _disc.nRad * _disc.nParType), [&](size_t pblk)
+#else
+	for (unsigned int pblk = 0; pblk < _disc.nCol * _disc.nRad * _disc.nParType; ++pblk)
+#endif
+	{
+		const unsigned int type = pblk / (_disc.nCol * _disc.nRad);
+		const unsigned int par = pblk % (_disc.nCol * _disc.nRad);
+
+		if (_jfnkParticlePrecond)
+		{
+			linalg::FactorizableBandMatrix::RowIterator jac = _jacPdisc[pblk].row(0);
+			for (unsigned int shell = 0; shell < _disc.nParCell[type]; ++shell)
+				addTimeDerivativeToJacobianParticleShell(jac, idxr, alpha, type);
+
+			const bool result = _jacPdisc[pblk].factorize();
+			if (cadet_unlikely(!result))
+			{
+				LOG(Error) << "Factorize() failed for par block " << pblk;
+			}
+		}
+		else
+		{
+			const unsigned int strideShell = idxr.strideParShell(type);
+			double* const shellJac = _jfnkShellJac.data() + _jfnkShellOffset[type] + par * _disc.nParCell[type] * strideShell * strideShell;
+			lapackInt_t* const shellPivot = _jfnkShellPivot.data() + idxr.offsetCp(ParticleTypeIndex{type}, ParticleIndex{par}) - idxr.offsetCp();
+
+			for (unsigned int shell = 0; shell < _disc.nParCell[type]; ++shell)
+			{
+				linalg::DenseMatrixView jacMat(shellJac + shell * strideShell * strideShell, shellPivot + shell * strideShell, strideShell, strideShell);
+				linalg::DenseMatrixView::RowIterator jac = jacMat.row(0);
+				parts::cell::addTimeDerivativeToJacobianParticleShell<linalg::DenseMatrixView::RowIterator, true>(jac, alpha, static_cast<double>(_parPorosity[type]), _disc.nComp, _disc.nBound + _disc.nComp * type,
+					_poreAccessFactor.data() + _disc.nComp * type, _disc.strideBound[type], _disc.boundOffset + _disc.nComp * type, _binding[type]->reactionQuasiStationarity());
+
+				const bool result = jacMat.factorize();
+				if (cadet_unlikely(!result))
+				{
+					LOG(Error) << "Factorize() failed for shell " << shell << " of par block " << pblk;
+				}
+			}
+		}
+	} CADET_PARFOR_END;
+
+	// Assemble flux Schur complements
+	const unsigned int nCells = _disc.nCol * _disc.nRad;
+	const unsigned int nFluxCell = _disc.nComp * _disc.nParType;
+	const linalg::CompressedSparseMatrix& jacC = _convDispOp.jacobian();
+	double* const u = _jfnkPrecondWork.data();
+
+	for (unsigned int k = 0; k < nFluxCell; ++k)
+	{
+		const unsigned int type = k / _disc.nComp;
+		const unsigned int comp = k % _disc.nComp;
+
+		std::fill(u, u + numDofs(), 0.0);
+		for (unsigned int cell = 0; cell < nCells; ++cell)
+			u[idxr.offsetJf(ParticleTypeIndex{type}) + cell * idxr.strideColRadialCell() + comp] = 1.0;
+
+		// Apply D_0^{-1} J_{0,f}
+		_jacCF.multiplyAdd(u + idxr.offsetJf(), u + idxr.offsetC());
+		for (unsigned int i = 0; i < nCells * _disc.nComp; ++i)
+			u[idxr.offsetC() + i] /= jacC.centered(i, 0) + alpha;
+
+		// Apply J_i^{-1} J_{i,f}
+		for (unsigned int pblk = 0; pblk < nCells * _disc.nParType; ++pblk)
+		{
+			double* const localU = u + idxr.offsetCp(ParticleTypeIndex{pblk / nCells}, ParticleIndex{pblk % nCells});
+			_jacPF[pblk].multiplyAdd(u + idxr.offsetJf(), localU);
+			solveParticlePreconditionerBlock(pblk, localU);
+		}
+
+		// Apply J_{f,0} and J_{f,i} and subtract results from unit vector
+		_jacFC.multiplySubtract(u + idxr.offsetC(), u + idxr.offsetJf());
+		for (unsigned int pblk = 0; pblk < nCells * _disc.nParType; ++pblk)
+			_jacFP[pblk].multiplySubtract(u + idxr.offsetCp(ParticleTypeIndex{pblk / nCells}, ParticleIndex{pblk % nCells}), u + idxr.offsetJf());
+
+		// Extract column k of each cell's Schur complement
+		for (unsigned int cell = 0; cell < nCells; ++cell)
+		{
+			linalg::DenseMatrixView schur(_jfnkFluxSchur.data() + cell * nFluxCell * nFluxCell, _jfnkFluxSchurPivot.data() + cell * nFluxCell, nFluxCell, nFluxCell);
+			for (unsigned int row = 0; row < nFluxCell; ++row)
+				schur.native(row, k) = u[idxr.offsetJf(ParticleTypeIndex{row / _disc.nComp}) + cell * idxr.strideColRadialCell() + row % _disc.nComp];
+		}
+	}
+
+	for (unsigned int cell = 0; cell < nCells; ++cell)
+	{
+		linalg::DenseMatrixView schur(_jfnkFluxSchur.data() + cell * nFluxCell * nFluxCell, _jfnkFluxSchurPivot.data() + cell * nFluxCell, nFluxCell, nFluxCell);
+		const bool result = schur.factorize();
+		if (cadet_unlikely(!result))
+		{
+			LOG(Error) << "Factorize() failed for flux Schur complement of cell " << cell;
+		}
+	}
+}
+
+/**
+ * @brief Applies the block preconditioner @f$ P^{-1} @f$ in-place
+ * @details The preconditioner is a block LU decomposition of the time discretized Jacobian that neglects
+ *          the coupling of the column cells via the fluxes (see factorizeBlockPreconditioner()). The diagonal
+ *          blocks are solved twice, before and after solving the flux Schur complements (see
+ *          solveDiagonalPreconditionerBlocks()). Inlet DOFs are left unchanged (identity block).
+ * @param [in,out] x On entry, vector to be preconditioned; on exit, preconditioned vector
+ */
+void GeneralRateModel2D::applyBlockPreconditioner(double* const x)
+{
+	Indexer idxr(_disc);
+	const unsigned int nCells = _disc.nCol * _disc.nRad;
+	const unsigned int nFluxCell = _disc.nComp * _disc.nParType;
+
+	// Solve diagonal blocks
+	double* const u = _jfnkPrecondWork.data();
+	std::copy(x + idxr.offsetC(), x + idxr.offsetJf(), u + idxr.offsetC());
+	solveDiagonalPreconditionerBlocks(u);
+
+	// Right hand side of flux Schur complement
+	_jacFC.multiplySubtract(u + idxr.offsetC(), x + idxr.offsetJf());
+	for (unsigned int pblk = 0; pblk < nCells * _disc.nParType; ++pblk)
+		_jacFP[pblk].multiplySubtract(u + idxr.offsetCp(ParticleTypeIndex{pblk / nCells}, ParticleIndex{pblk % nCells}), x + idxr.offsetJf());
+
+	// Solve flux Schur complements of the column cells
+	double* const fluxCell = _jfnkFluxBuffer.data();
+	for (unsigned int cell = 0; cell < nCells; ++cell)
+	{
+		for (unsigned int k = 0; k < nFluxCell; ++k)
+			fluxCell[k] = x[idxr.offsetJf(ParticleTypeIndex{k / _disc.nComp}) + cell * idxr.strideColRadialCell() + k % _disc.nComp];
+
+		linalg::DenseMatrixView schur(_jfnkFluxSchur.data() + cell * nFluxCell * nFluxCell, _jfnkFluxSchurPivot.data() + cell * nFluxCell, nFluxCell, nFluxCell);
+		const bool result = schur.solve(fluxCell);
+		if (cadet_unlikely(!result))
+		{
+			LOG(Error) << "Solve() failed for flux Schur complement of cell " << cell;
+		}
+
+		for (unsigned int k = 0; k < nFluxCell; ++k)
+			x[idxr.offsetJf(ParticleTypeIndex{k / _disc.nComp}) + cell * idxr.strideColRadialCell() + k % _disc.nComp] = fluxCell[k];
+	}
+
+	// Back substitution of fluxes
+	_jacCF.multiplySubtract(x + idxr.offsetJf(), x + idxr.offsetC());
+	for (unsigned int pblk = 0; pblk < nCells * _disc.nParType; ++pblk)
+		_jacPF[pblk].multiplySubtract(x + idxr.offsetJf(), x + idxr.offsetCp(ParticleTypeIndex{pblk / nCells}, ParticleIndex{pblk % nCells}));
+
+	solveDiagonalPreconditionerBlocks(x);
+}
+
+/**
+ * @brief Solves the bulk and particle blocks of the preconditioner in-place
+ * @details The bulk block is handled by the configured bulk linear solver (by default, its diagonal is used).
+ *          Particle blocks are either full particle blocks or independent particle shells (block diagonal
+ *          of the particle block, cheaper but less accurate).
+ * @param [in,out] x On entry, vector with right hand sides; on exit, solution (inlet and flux DOFs are unchanged)
+ */
+void GeneralRateModel2D::solveDiagonalPreconditionerBlocks(double* const x)
+{
+	Indexer idxr(_disc);
+
+#ifdef CADET_PARALLELIZE
+	tbb::parallel_for(size_t(0), size_t(_disc.nCol * _disc.nRad * _disc.nParType + 1), [&](size_t idx)
+#else
+	for (unsigned int idx = 0; idx < _disc.nCol * _disc.nRad * _disc.nParType + 1; ++idx)
+#endif
+	{
+		if (cadet_unlikely(idx == 0))
+		{
+			const bool result = _convDispOp.solveDiscretizedJacobian(x + idxr.offsetC(), nullptr, nullptr, 0.0);
+			if (cadet_unlikely(!result))
+			{
+				LOG(Error) << "Solve() failed for bulk block";
+			}
+		}
+		else
+		{
+			const unsigned int pblk = idx - 1;
+			const unsigned int type = pblk / (_disc.nCol * _disc.nRad);
+			const unsigned int par = pblk % (_disc.nCol * _disc.nRad);
+			solveParticlePreconditionerBlock(pblk, x + idxr.offsetCp(ParticleTypeIndex{type}, ParticleIndex{par}));
+		}
+	} CADET_PARFOR_END;
+}
+
+/**
+ * @brief Solves a particle block of the preconditioner in-place
+ * @param [in] pblk Index of the particle block (type-major ordering)
+ * @param [in,out] localX On entry, right hand side of the particle block; on exit, solution
+ */
+void GeneralRateModel2D::solveParticlePreconditionerBlock(unsigned int pblk, double* const localX)
+{
+	if (_jfnkParticlePrecond)
+	{
+		const bool result = _jacPdisc[pblk].solve(localX);
+		if (cadet_unlikely(!result))
+		{
+			LOG(Error) << "Solve() failed for par block " << pblk;
+		}
+		return;
+	}
+
+	Indexer idxr(_disc);
+	const unsigned int type = pblk / (_disc.nCol * _disc.nRad);
+	const unsigned int par = pblk % (_disc.nCol * _disc.nRad);
+	const unsigned int strideShell = idxr.strideParShell(type);
+	double* const shellJac = _jfnkShellJac.data() + _jfnkShellOffset[type] + par * _disc.nParCell[type] * strideShell * strideShell;
+	lapackInt_t* const shellPivot = _jfnkShellPivot.data() + idxr.offsetCp(ParticleTypeIndex{type}, ParticleIndex{par}) - idxr.offsetCp();
+
+	for (unsigned int shell = 0; shell < _disc.nParCell[type]; ++shell)
+	{
+		const linalg::DenseMatrixView jacMat(shellJac + shell * strideShell * strideShell, shellPivot + shell * strideShell, strideShell, strideShell);
+		const bool result = jacMat.solve(localX + shell * strideShell);
+		if (cadet_unlikely(!result))
+		{
+			LOG(Error) << "Solve() failed for shell " << shell << " of par block " << pblk;
+		}
+	}
+}
+
+/**
+ * @brief Returns the time discretized particle Jacobian block or scratch memory for it
+ * @details In Jacobian-free mode, the time discretized blocks are not stored (or hold the preconditioner)
+ *          and the given local scratch block is resized and returned instead.
+ * @param [in] pblk Index of the particle block (type-major ordering)
+ * @param [in,out] localScratch Scratch block owned by the caller, only used in Jacobian-free mode
+ * @return Time discretized particle Jacobian block
+ */
+linalg::FactorizableBandMatrix& GeneralRateModel2D::particleJacobianScratch(unsigned int pblk, linalg::FactorizableBandMatrix& localScratch)
+{
+	if (!_jacobianFree)
+		return _jacPdisc[pblk];
+
+	resizeParticleJacobianBlock(pblk / (_disc.nCol * _disc.nRad), localScratch);
+	return localScratch;
+}
+
+/**
+ * @brief Returns the memory occupied by Jacobian blocks, factorizations, and the Krylov solver
+ * @return Memory in bytes
+ */
+std::size_t GeneralRateModel2D::jacobianMemoryUsage() const CADET_NOEXCEPT
+{
+	std::size_t mem = _convDispOp.jacobianMemoryUsage();
+
+	for (unsigned int i = 0; i < _disc.nCol * _disc.nRad * _disc.nParType; ++i)
+	{
+		if (_jacP)
+			mem += static_cast<std::size_t>(_jacP[i].rows()) * _jacP[i].stride() * sizeof(double);
+		if (_jacPdisc)
+			mem += static_cast<std::size_t>(_jacPdisc[i].rows()) * (_jacPdisc[i].stride() * sizeof(double) + sizeof(lapackInt_t));
+	}
+
+	// Shell preconditioner and flux Schur complements in Jacobian-free mode
+	mem += _jfnkShellJac.size() * sizeof(double) + _jfnkShellPivot.size() * sizeof(lapackInt_t);
+	mem += _jfnkFluxSchur.size() * sizeof(double) + _jfnkFluxSchurPivot.size() * sizeof(lapackInt_t);
+
+	// Krylov subspace of GMRES (stored basis vectors and work vectors)
+	mem += static_cast<std::size_t>(_gmres.matrixSize()) * (_gmres.maxKrylov() + 2) * sizeof(double);
+
+	// Work vectors of Jacobian-free mode
+	mem += (_jfnkRhs.size() + _jfnkRes.size() + _jfnkResDir.size() + _jfnkStatePerturbed.size() + _jfnkStateDotPerturbed.size() + _jfnkPrecondWork.size() + _jfnkFluxBuffer.size()) * sizeof(double);
+
+	return mem;
+}
+
 /**
  * @brief Assembles a particle Jacobian block @f$ J_i @f$ (@f$ i > 0 @f$) of the time-discretized equations
  * @details The system \f[ \left( \frac{\partial F}{\partial y} + \alpha \frac{\partial F}{\partial \dot{y}} \right) x = b \f]
@@ -37,6 +37,7 @@
 #include <algorithm>
 #include <functional>
 #include <numeric>
+#include <limits>
 
 #include "ParallelSupport.hpp"
 #ifdef CADET_PARALLELIZE
@@ -326,10 +327,17 @@ int schurComplementMultiplierGRM2D(void* userData, double const* x, double* z)
 	return grm->schurComplementMatrixVector(x, z);
 }
 
+int jacobianFreeMultiplierGRM2D(void* userData, double const* x, double* z)
+{
+	GeneralRateModel2D* const grm = static_cast<GeneralRateModel2D*>(userData);
+	return grm->jacobianFreeMatrixVector(x, z);
+}
+
 
 GeneralRateModel2D::GeneralRateModel2D(UnitOpIdx unitOpIdx) : UnitOperationBase(unitOpIdx),
 	_dynReactionBulk(nullptr), _jacP(nullptr), _jacPdisc(nullptr), _jacPF(nullptr), _jacFP(nullptr), _jacInlet(),
-	_analyticJac(true), _jacobianAdDirs(0), _factorizeJacobian(false), _tempState(nullptr),
+	_analyticJac(true), _jacobianAdDirs(0), _factorizeJacobian(false), _tempState(nullptr), _adaptiveLinearTol(false), _jacobianFree(false), _jfnkParticlePrecond(false), _jfnkAlpha(0.0),
+	_jfnkTime(0.0), _jfnkSecIdx(0), _jfnkY(nullptr), _jfnkYdot(nullptr),
 	_initC(0), _singleRadiusInitC(true), _initCp(0), _singleRadiusInitCp(true), _initQ(0), _singleRadiusInitQ(true), _initState(0), _initStateDot(0)
 {
 }
@@ -514,9 +522,45 @@ bool GeneralRateModel2D::configureModelDiscretization(IParameterProvider& paramP
 	const bool analyticJac = false;
 #endif
 
-	// Initialize and configure GMRES for solving the Schur-complement
-	_gmres.initialize(_disc.nCol * _disc.nRad * _disc.nComp * _disc.nParType, paramProvider.getInt("MAX_KRYLOV"), linalg::toOrthogonalization(paramProvider.getInt("GS_TYPE")), paramProvider.getInt("MAX_RESTARTS"));
-	_gmres.matrixVectorMultiplier(&schurComplementMultiplierGRM2D, this);
+	_jacobianFree = paramProvider.exists("USE_JFNK") && paramProvider.getBool("USE_JFNK");
+	if (_jacobianFree)
+	{
+		// Initialize and configure GMRES for solving the full system, the Krylov subspace is always limited
+		const int maxKrylov = paramProvider.getInt("MAX_KRYLOV");
+		_gmres.initialize(numDofs(), (maxKrylov > 0) ? maxKrylov : std::min(numDofs(), 30u), linalg::toOrthogonalization(paramProvider.getInt("GS_TYPE")), paramProvider.getInt("MAX_RESTARTS"));
+		_gmres.matrixVectorMultiplier(&jacobianFreeMultiplierGRM2D, this);
+		_jfnkRhs.resize(numDofs());
+		_jfnkRes.resize(numDofs());
+		_jfnkResDir.resize(numDofs());
+		_jfnkStatePerturbed.resize(numDofs());
+		_jfnkStateDotPerturbed.resize(numDofs());
+		_jfnkPrecondWork.resize(numDofs(), 0.0);
+
+		// Flux Schur complements are dense blocks coupling all fluxes of a column cell
+		const unsigned int nFluxCell = _disc.nComp * _disc.nParType;
+		_jfnkFluxSchur.resize(_disc.nCol * _disc.nRad * nFluxCell * nFluxCell, 0.0);
+		_jfnkFluxSchurPivot.resize(_disc.nCol * _disc.nRad * nFluxCell);
+		_jfnkFluxBuffer.resize(nFluxCell);
+
+		_jfnkParticlePrecond = false;
+		if (paramProvider.exists("JFNK_PRECONDITIONER"))
+		{
+			const std::string precond = paramProvider.getString("JFNK_PRECONDITIONER");
+			if (precond == "PARTICLE")
+				_jfnkParticlePrecond = true;
+			else if (precond != "SHELL")
+				throw InvalidParameterException("Unknown preconditioner " + precond + " in field JFNK_PRECONDITIONER");
+		}
+
+		if (paramProvider.exists("LINEAR_SOLVER_BULK") && (paramProvider.getString("LINEAR_SOLVER_BULK") == "GMRES"))
+			LOG(Warning) << "Bulk solver GMRES is not a fixed preconditioner and may slow down convergence in Jacobian-free mode";
+	}
+	else
+	{
+		// Initialize and configure GMRES for solving the Schur-complement
+		_gmres.initialize(_disc.nCol * _disc.nRad * _disc.nComp * _disc.nParType, paramProvider.getInt("MAX_KRYLOV"), linalg::toOrthogonalization(paramProvider.getInt("GS_TYPE")), paramProvider.getInt("MAX_RESTARTS"));
+		_gmres.matrixVectorMultiplier(&schurComplementMultiplierGRM2D, this);
+	}
 	_schurSafety = paramProvider.getDouble("SCHUR_SAFETY");
 
 	// Allocate space for initial conditions
@@ -534,17 +578,33 @@ bool GeneralRateModel2D::configureModelDiscretization(IParameterProvider& paramP
 
 	_jacInlet.resize(_disc.nComp * _disc.nRad);
 
-	_jacP = new linalg::BandMatrix[_disc.nCol * _disc.nRad * _disc.nParType];
-	_jacPdisc = new linalg::FactorizableBandMatrix[_disc.nCol * _disc.nRad * _disc.nParType];
-	for (unsigned int j = 0; j < _disc.nParType; ++j)
+	// In Jacobian-free mode, the particle Jacobian blocks are not stored but only their preconditioner
+	if (!_jacobianFree)
+	{
+		_jacP = new linalg::BandMatrix[_disc.nCol * _disc.nRad * _disc.nParType];
+		for (unsigned int i = 0; i < _disc.nCol * _disc.nRad * _disc.nParType; ++i)
+			resizeParticleJacobianBlock(i / (_disc.nCol * _disc.nRad), _jacP[i]);
+	}
+
+	if (!_jacobianFree || _jfnkParticlePrecond)
 	{
-		linalg::BandMatrix* const ptrJac = _jacP + _disc.nCol * _disc.nRad * j;
-		linalg::FactorizableBandMatrix* const ptrJacDisc = _jacPdisc + _disc.nCol * _disc.nRad * j;
-		for (unsigned int i = 0; i < _disc.nCol * _disc.nRad; ++i)
+		_jacPdisc = new linalg::FactorizableBandMatrix[_disc.nCol * _disc.nRad * _disc.nParType];
+		for (unsigned int i = 0; i < _disc.nCol * _disc.nRad * _disc.nParType; ++i)
+			resizeParticleJacobianBlock(i / (_disc.nCol * _disc.nRad), _jacPdisc[i]);
+	}
+	else
+	{
+		// Shell preconditioner: One dense block per particle shell
+		_jfnkShellOffset.resize(_disc.nParType);
+		unsigned int shellJacSize = 0;
+		for (unsigned int j = 0; j < _disc.nParType; ++j)
 		{
-			ptrJacDisc[i].resize(_disc.nParCell[j] * (_disc.nComp + _disc.strideBound[j]), _disc.nComp + _disc.strideBound[j], _disc.nComp + 2 * _disc.strideBound[j]);
-			ptrJac[i].resize(_disc.nParCell[j] * (_disc.nComp + _disc.strideBound[j]), _disc.nComp + _disc.strideBound[j], _disc.nComp + 2 * _disc.strideBound[j]);
+			_jfnkShellOffset[j] = shellJacSize;
+			shellJacSize += _disc.nCol * _disc.nRad * _disc.nParCell[j] * idxr.strideParShell(j) * idxr.strideParShell(j);
 		}
+
+		_jfnkShellJac.resize(shellJacSize, 0.0);
+		_jfnkShellPivot.resize(_disc.parTypeOffset[_disc.nParType]);
 	}
 
 	_jacPF = new linalg::DoubleSparseMatrix[_disc.nCol * _disc.nRad * _disc.nParType];
@@ -665,6 +725,9 @@ bool GeneralRateModel2D::configureModelDiscretization(IParameterProvider& paramP
 	// Setup the memory for tempState based on state vector
 	_tempState = new double[numDofs()];
 
+	LOG(Info) << "Jacobian memory of unit " << static_cast<int>(_unitOpIdx) << ": " << static_cast<double>(jacobianMemoryUsage()) / (1024.0 * 1024.0)
+		<< " MiB for " << numDofs() << " DOFs" << (_jacobianFree ? " (Jacobian-free mode)" : "");
+
 	return transportSuccess && bindingConfSuccess && reactionConfSuccess;
 }
 
@@ -958,7 +1021,7 @@ unsigned int GeneralRateModel2D::numAdDirsForJacobian() const CADET_NOEXCEPT
 	unsigned int maxStride = 0;
 	for (unsigned int type = 0; type < _disc.nParType; ++type)
 	{
-		maxStride = std::max(maxStride, _jacP[type * _disc.nCol * _disc.nRad].stride());
+		maxStride = std::max(maxStride, particleJacobianLowerBandwidth(type) + particleJacobianUpperBandwidth(type) + 1);
 	}
 
 	return maxStride;
@@ -981,6 +1044,9 @@ void GeneralRateModel2D::useAnalyticJacobian(const bool analyticJac)
 
 void GeneralRateModel2D::notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, const AdJacobianParams& adJac)
 {
+	// Residuals evaluated in linearSolve() require the section index
+	_jfnkSecIdx = secIdx;
+
 	// Setup flux Jacobian blocks at the beginning of the simulation or in case of
 	// section dependent film or particle diffusion coefficients
 	if ((secIdx == 0) || isSectionDependent(_filmDiffusionMode) || isSectionDependent(_parDiffusionMode))
@@ -1058,8 +1124,8 @@ void GeneralRateModel2D::prepareADvectors(const AdJacobianParams& adJac) const
 	// Particle blocks
 	for (unsigned int type = 0; type < _disc.nParType; ++type)
 	{
-		const unsigned int lowerParBandwidth = _jacP[type * _disc.nCol * _disc.nRad].lowerBandwidth();
-		const unsigned int upperParBandwidth = _jacP[type * _disc.nCol * _disc.nRad].upperBandwidth();
+		const unsigned int lowerParBandwidth = particleJacobianLowerBandwidth(type);
+		const unsigned int upperParBandwidth = particleJacobianUpperBandwidth(type);
 
 		for (unsigned int pblk = 0; pblk < _disc.nCol * _disc.nRad; ++pblk)
 		{
@@ -1080,6 +1146,19 @@ void GeneralRateModel2D::extractJacobianFromAD(active const* const adRes, unsign
 	// Particles
 	for (unsigned int type = 0; type < _disc.nParType; ++type)
 	{
+		if (_jacobianFree)
+		{
+			// Only keep the preconditioner of the particle blocks
+			linalg::BandMatrix jacMat;
+			resizeParticleJacobianBlock(type, jacMat);
+			for (unsigned int pblk = 0; pblk < _disc.nCol * _disc.nRad; ++pblk)
+			{
+				ad::extractBandedJacobianFromAd(adRes + idxr.offsetCp(ParticleTypeIndex{type}, ParticleIndex{pblk}), adDirOffset, jacMat.lowerBandwidth(), jacMat);
+				storeParticlePreconditionerBlock(_disc.nCol * _disc.nRad * type + pblk, jacMat);
+			}
+			continue;
+		}
+
 		for (unsigned int pblk = 0; pblk < _disc.nCol * _disc.nRad; ++pblk)
 		{
 			linalg::BandMatrix& jacMat = _jacP[_disc.nCol * _disc.nRad * type + pblk];
@@ -1100,7 +1179,11 @@ void GeneralRateModel2D::checkAnalyticJacobianAgainstAd(active const* const adRe
 {
 	Indexer idxr(_disc);
 
-	LOG(Debug) << "AD dir offset: " << adDirOffset << " DiagDirPar: " << _jacP[0].lowerBandwidth();
+	LOG(Debug) << "AD dir offset: " << adDirOffset << " DiagDirPar: " << particleJacobianLowerBandwidth(0);
+
+	// Particle Jacobian blocks are not stored in Jacobian-free mode
+	if (_jacobianFree)
+		return;
 
 	// Particles
 	double maxDiffPar = 0.0;
@@ -1253,7 +1336,20 @@ int GeneralRateModel2D::residualImpl(double t, unsigned int secIdx, StateType co
 		{
 			const unsigned int type = (pblk - 1) / (_disc.nCol * _disc.nRad);
 			const unsigned int par = (pblk - 1) % (_disc.nCol * _disc.nRad);
-			residualParticle<StateType, ResidualType, ParamType, wantJac>(t, type, par, secIdx, y, yDot, res, threadLocalMem);
+			if (!_jacobianFree)
+				residualParticle<StateType, ResidualType, ParamType, wantJac>(t, type, par, secIdx, y, yDot, res, _jacP[pblk - 1], threadLocalMem);
+			else
+			{
+				// Particle Jacobian blocks are not stored in Jacobian-free mode, only their preconditioner is kept
+				linalg::BandMatrix jacBlock;
+				if (wantJac)
+					resizeParticleJacobianBlock(type, jacBlock);
+
+				residualParticle<StateType, ResidualType, ParamType, wantJac>(t, type, par, secIdx, y, yDot, res, jacBlock, threadLocalMem);
+
+				if (wantJac)
+					storeParticlePreconditionerBlock(pblk - 1, jacBlock);
+			}
 		}
 	} CADET_PARFOR_END;
 
@@ -1304,7 +1400,7 @@ int GeneralRateModel2D::residualBulk(double t, unsigned int secIdx, StateType co
 }
 
 template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
-int GeneralRateModel2D::residualParticle(double t, unsigned int parType, unsigned int colCell, unsigned int secIdx, StateType const* yBase, double const* yDotBase, ResidualType* resBase, util::ThreadLocalStorage& threadLocalMem)
+int GeneralRateModel2D::residualParticle(double t, unsigned int parType, unsigned int colCell, unsigned int secIdx, StateType const* yBase, double const* yDotBase, ResidualType* resBase, linalg::BandMatrix& jacBlock, util::ThreadLocalStorage& threadLocalMem)
 {
 	Indexer idxr(_disc);
 
@@ -1330,14 +1426,16 @@ int GeneralRateModel2D::residualParticle(double t, unsigned int parType, unsigne
 
 	// Reset Jacobian
 	if (wantJac)
-		_jacP[_disc.nCol * _disc.nRad * parType + colCell].setAll(0.0);
+		jacBlock.setAll(0.0);
 
 	// The RowIterator is always centered on the main diagonal.
 	// This means that jac[0] is the main diagonal, jac[-1] is the first lower diagonal,
 	// and jac[1] is the first upper diagonal. We can also access the rows from left to
 	// right beginning with the last lower diagonal moving towards the main diagonal and
 	// continuing to the last upper diagonal by using the native() method.
-	linalg::BandMatrix::RowIterator jac = _jacP[_disc.nCol * _disc.nRad * parType + colCell].row(0);
+	// The iterator is not dereferenced if no Jacobian is requested, in which case the
+	// block may be empty (Jacobian-free mode).
+	linalg::BandMatrix::RowIterator jac(jacBlock);
 
 	active const* const outerSurfPerVol = _parOuterSurfAreaPerVolume.data() + _disc.nParCellsBeforeType[parType];
 	active const* const innerSurfPerVol = _parInnerSurfAreaPerVolume.data() + _disc.nParCellsBeforeType[parType];
@@ -1747,6 +1845,8 @@ int GeneralRateModel2D::residualSensFwdCombine(const SimulationTime& simTime, co
 	const ConstSimulationState css{nullptr, nullptr};
 	for (unsigned int param = 0; param < yS.size(); ++param)
 	{
+		if (!yS[param])
+			continue;
 
 		// Directional derivative (dF / dy) * s
 		multiplyWithJacobian(cst, css, yS[param], 1.0, 0.0, tmp1);
@@ -1781,6 +1881,8 @@ int GeneralRateModel2D::residualSensFwdCombine(const SimulationTime& simTime, co
  * 
  *          Note that residual() or one of its cousins has to be called with the requested point @f$ (t, y, \dot{y}) @f$ once
  *          before calling multiplyWithJacobian() as this implementation ignores the given @f$ (t, y, \dot{y}) @f$.
+ *          In Jacobian-free mode, the particle Jacobian blocks are not stored. Hence, the product is approximated by a
+ *          directional derivative of the residual at the given point @f$ (t, y, \dot{y}) @f$.
  * @param [in] simTime Current simulation time point
  * @param [in] simState Simulation state vectors
  * @param [in] yS Vector @f$ x @f$ that is transformed by the Jacobian @f$ \frac{\partial F}{\partial y} @f$
@@ -1790,6 +1892,23 @@ int GeneralRateModel2D::residualSensFwdCombine(const SimulationTime& simTime, co
  */
 void GeneralRateModel2D::multiplyWithJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, double const* yS, double alpha, double beta, double* ret)
 {
+	if (_jacobianFree)
+	{
+		_jfnkThreadLocalMem.resize(threadLocalMemorySize());
+		residualImpl<double, double, double, false>(simTime.t, simTime.secIdx, simState.vecStateY, simState.vecStateYdot, _jfnkRes.data(), _jfnkThreadLocalMem);
+
+		// Relative increment, see Brown and Saad (1990)
+		const double yNorm = linalg::l2Norm(simState.vecStateY, numDofs());
+		const double dirNorm = linalg::l2Norm(yS, numDofs());
+		const double sigma = (dirNorm > 0.0) ? std::sqrt(std::numeric_limits<double>::epsilon()) * (1.0 + yNorm) / dirNorm : 1.0;
+
+		residualDirectionalDerivative(simTime.t, simTime.secIdx, simState.vecStateY, simState.vecStateYdot, _jfnkRes.data(), 0.0, sigma, yS, _jfnkResDir.data());
+
+		for (unsigned int i = 0; i < numDofs(); ++i)
+			ret[i] = alpha * _jfnkResDir[i] + beta * ret[i];
+		return;
+	}
+
 	Indexer idxr(_disc);
 
 	// Handle identity matrix of inlet DOFs
@@ -1843,6 +1962,66 @@ void GeneralRateModel2D::multiplyWithJacobian(const SimulationTime& simTime, con
 	_jacInlet.multiplyAdd(yS, ret + idxr.offsetC(), alpha);
 }
 
+/**
+ * @brief Approximates a directional derivative of the residual by forward differences
+ * @details Computes @f[ z = \frac{1}{\sigma} \left[ F\left(t, y + \sigma v, \dot{y} + \alpha \sigma v\right) - F\left(t, y, \dot{y}\right) \right]
+ *          \approx \left( \frac{\partial F}{\partial y} + \alpha \frac{\partial F}{\partial \dot{y}} \right) v. @f]
+ *          This is used in Jacobian-free mode, where the particle Jacobian blocks are not stored.
+ * @param [in] t Current time point
+ * @param [in] secIdx Index of the current section
+ * @param [in] y State vector
+ * @param [in] yDot Time derivative of the state vector
+ * @param [in] res Residual @f$ F(t, y, \dot{y}) @f$ at the given point
+ * @param [in] alpha Factor @f$ \alpha @f$ in front of @f$ \frac{\partial F}{\partial \dot{y}} @f$
+ * @param [in] sigma Increment @f$ \sigma @f$
+ * @param [in] dir Direction @f$ v @f$
+ * @param [out] out Directional derivative @f$ z @f$
+ * @return @c 0 on success, any other value in case of failure
+ */
+int GeneralRateModel2D::residualDirectionalDerivative(double t, unsigned int secIdx, double const* y, double const* yDot, double const* res, double alpha, double sigma, double const* dir, double* out)
+{
+	double* const yPerturbed = _jfnkStatePerturbed.data();
+	double* const yDotPerturbed = yDot ? _jfnkStateDotPerturbed.data() : nullptr;
+
+	for (unsigned int i = 0; i < numDofs(); ++i)
+		yPerturbed[i] = y[i] + sigma * dir[i];
+
+	if (yDot)
+	{
+		for (unsigned int i = 0; i < numDofs(); ++i)
+			yDotPerturbed[i] = yDot[i] + alpha * sigma * dir[i];
+	}
+
+	const int retCode = residualImpl<double, double, double, false>(t, secIdx, yPerturbed, yDotPerturbed, out, _jfnkThreadLocalMem);
+
+	const double invSigma = 1.0 / sigma;
+	for (unsigned int i = 0; i < numDofs(); ++i)
+		out[i] = (out[i] - res[i]) * invSigma;
+
+	return retCode;
+}
+
+/**
+ * @brief Computes the Jacobian of a particle block at the given state
+ * @details In Jacobian-free mode, the particle Jacobian blocks are not stored. Consistent initialization
+ *          recomputes them on demand with this function. The residual of the particle block is written
+ *          to the corresponding part of _tempState.
+ * @param [in] t Current time point
+ * @param [in] secIdx Index of the current section
+ * @param [in] pblk Index of the particle block (type-major ordering)
+ * @param [in] y State vector
+ * @param [out] jacBlock Particle Jacobian block
+ * @param [in] threadLocalMem Thread local memory
+ */
+void GeneralRateModel2D::particleJacobianBlock(double t, unsigned int secIdx, unsigned int pblk, double const* y, linalg::BandMatrix& jacBlock, util::ThreadLocalStorage& threadLocalMem)
+{
+	const unsigned int type = pblk / (_disc.nCol * _disc.nRad);
+	const unsigned int par = pblk % (_disc.nCol * _disc.nRad);
+
+	resizeParticleJacobianBlock(type, jacBlock);
+	residualParticle<double, double, double, true>(t, type, par, secIdx, y, nullptr, _tempState, jacBlock, threadLocalMem);
+}
+
 /**
  * @brief Multiplies the time derivative Jacobian @f$ \frac{\partial F}{\partial \dot{y}}\left(t, y, \dot{y}\right) @f$ with a given vector
  * @details The operation @f$ z = \frac{\partial F}{\partial \dot{y}} x @f$ is performed.
@@ -2088,6 +2267,32 @@ bool GeneralRateModel2D::setParameter(const ParameterId& pId, double value)
 	return result;
 }
 
+bool GeneralRateModel2D::resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage)
+{
+	if (pId.unitOperation == _unitOpIdx)
+	{
+		// Parameters multiplexed over radial zones, multiplexed initial conditions, and particle radii
+		// (which require an update of the radial discretization) are set by setParameter()
+		if ((pId.name == hashString("PAR_TYPE_VOLFRAC")) || (pId.name == hashString("INIT_CP")) || (pId.name == hashString("INIT_Q"))
+			|| (pId.name == hashString("PAR_RADIUS")) || (pId.name == hashString("PAR_CORERADIUS")) || (pId.name == hashString("COL_POROSITY"))
+			|| (pId.name == hashString("VELOCITY")) || (pId.name == hashString("COL_DISPERSION")) || (pId.name == hashString("COL_DISPERSION_RADIAL")))
+			return false;
+
+		if (multiplexCompTypeSecParameterStorage(pId, hashString("PORE_ACCESSIBILITY"), _poreAccessFactorMode, _poreAccessFactor, _disc.nParType, _disc.nComp, storage))
+			return true;
+		if (multiplexCompTypeSecParameterStorage(pId, hashString("FILM_DIFFUSION"), _filmDiffusionMode, _filmDiffusion, _disc.nParType, _disc.nComp, storage))
+			return true;
+		if (multiplexCompTypeSecParameterStorage(pId, hashString("PAR_DIFFUSION"), _parDiffusionMode, _parDiffusion, _disc.nParType, _disc.nComp, storage))
+			return true;
+		if (multiplexBndCompTypeSecParameterStorage(pId, hashString("PAR_SURFDIFFUSION"), _parSurfDiffusionMode, _parSurfDiffusion, _disc.nParType, _disc.nComp, _disc.strideBound, _disc.nBound, _disc.boundOffset, storage))
+			return true;
+		if (multiplexTypeParameterStorage(pId, hashString("PAR_POROSITY"), _singleParPorosity, _parPorosity, storage))
+			return true;
+	}
+
+	return UnitOperationBase::resolveParameterStorage(pId, storage);
+}
+
 void GeneralRateModel2D::setSensitiveParameterValue(const ParameterId& pId, double value)
 {
 	if (pId.unitOperation == _unitOpIdx)
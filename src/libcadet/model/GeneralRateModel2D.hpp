@@ -27,6 +27,7 @@
 #include "linalg/BandMatrix.hpp"
 #include "linalg/Gmres.hpp"
 #include "Memory.hpp"
+#include "ParallelSupport.hpp"
 #include "model/ModelUtils.hpp"
 #include "model/ParameterMultiplexing.hpp"
 
@@ -107,6 +108,8 @@ public:
 
 	virtual int linearSolve(double t, double alpha, double tol, double* const rhs, double const* const weight,
 		const ConstSimulationState& simState);
+	virtual void setAdaptiveLinearSolverTolerance(bool adaptive) CADET_NOEXCEPT { _adaptiveLinearTol = adaptive; }
+	virtual unsigned long numLinearSolverIterations() const CADET_NOEXCEPT { return _gmres.numIterations(); }
 
 	virtual void prepareADvectors(const AdJacobianParams& adJac) const;
 
@@ -150,6 +153,7 @@ public:
 	virtual bool setParameter(const ParameterId& pId, double value);
 	virtual bool setSensitiveParameter(const ParameterId& pId, unsigned int adDirection, double adValue);
 	virtual void setSensitiveParameterValue(const ParameterId& id, double value);
+	virtual bool resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage);
 
 	virtual unsigned int threadLocalMemorySize() const CADET_NOEXCEPT;
 
@@ -205,7 +209,7 @@ protected:
 	int residualBulk(double t, unsigned int secIdx, StateType const* y, double const* yDot, ResidualType* res, util::ThreadLocalStorage& threadLocalMem);
 
 	template <typename StateType, typename ResidualType, typename ParamType, bool wantJac>
-	int residualParticle(double t, unsigned int parType, unsigned int colCell, unsigned int secIdx, StateType const* y, double const* yDot, ResidualType* res, util::ThreadLocalStorage& threadLocalMem);
+	int residualParticle(double t, unsigned int parType, unsigned int colCell, unsigned int secIdx, StateType const* y, double const* yDot, ResidualType* res, linalg::BandMatrix& jacBlock, util::ThreadLocalStorage& threadLocalMem);
 
 	template <typename StateType, typename ResidualType, typename ParamType>
 	int residualFlux(double t, unsigned int secIdx, StateType const* y, double const* yDot, ResidualType* res);
@@ -215,6 +219,27 @@ protected:
 
 	int schurComplementMatrixVector(double const* x, double* z) const;
 	void assembleDiscretizedJacobianParticleBlock(unsigned int parType, unsigned int pblk, double alpha, const Indexer& idxr);
+
+	int linearSolveJacobianFree(double t, double alpha, double outerTol, double* const rhs, double const* const weight, const ConstSimulationState& simState);
+	int jacobianFreeMatrixVector(double const* x, double* z);
+	int residualDirectionalDerivative(double t, unsigned int secIdx, double const* y, double const* yDot, double const* res, double alpha, double sigma, double const* dir, double* out);
+	void storeParticlePreconditionerBlock(unsigned int pblk, const linalg::BandMatrix& jacBlock);
+	void factorizeBlockPreconditioner(double alpha);
+	void applyBlockPreconditioner(double* const x);
+	void solveDiagonalPreconditionerBlocks(double* const x);
+	void solveParticlePreconditionerBlock(unsigned int pblk, double* const localX);
+	void particleJacobianBlock(double t, unsigned int secIdx, unsigned int pblk, double const* y, linalg::BandMatrix& jacBlock, util::ThreadLocalStorage& threadLocalMem);
+	linalg::FactorizableBandMatrix& particleJacobianScratch(unsigned int pblk, linalg::FactorizableBandMatrix& localScratch);
+	std::size_t jacobianMemoryUsage() const CADET_NOEXCEPT;
+
+	inline unsigned int particleJacobianLowerBandwidth(unsigned int parType) const CADET_NOEXCEPT { return _disc.nComp + _disc.strideBound[parType]; }
+	inline unsigned int particleJacobianUpperBandwidth(unsigned int parType) const CADET_NOEXCEPT { return _disc.nComp + 2 * _disc.strideBound[parType]; }
+
+	template <typename MatrixType>
+	inline void resizeParticleJacobianBlock(unsigned int parType, MatrixType& mat) const
+	{
+		mat.resize(_disc.nParCell[parType] * (_disc.nComp + _disc.strideBound[parType]), particleJacobianLowerBandwidth(parType), particleJacobianUpperBandwidth(parType));
+	}
 	
 	void setEquidistantRadialDisc(unsigned int parType);
 	void setEquivolumeRadialDisc(unsigned int parType);
@@ -272,8 +297,8 @@ protected:
 	parts::TwoDimensionalConvectionDispersionOperator _convDispOp; //!< Convection dispersion operator for interstitial volume transport
 	IDynamicReactionModel* _dynReactionBulk; //!< Dynamic reactions in the bulk volume
 
-	linalg::BandMatrix* _jacP; //!< Particle jacobian diagonal blocks (all of them)
-	linalg::FactorizableBandMatrix* _jacPdisc; //!< Particle jacobian diagonal blocks (all of them) with time derivatives from BDF method
+	linalg::BandMatrix* _jacP; //!< Particle jacobian diagonal blocks (all of them), not allocated in Jacobian-free mode
+	linalg::FactorizableBandMatrix* _jacPdisc; //!< Particle jacobian diagonal blocks (all of them) with time derivatives from BDF method, only allocated for the particle preconditioner in Jacobian-free mode
 
 	linalg::DoubleSparseMatrix _jacCF; //!< Jacobian block connecting interstitial states and fluxes (interstitial transport equation)
 	linalg::DoubleSparseMatrix _jacFC; //!< Jacobian block connecting fluxes and interstitial states (flux equation)
@@ -315,8 +340,30 @@ protected:
 
 	bool _factorizeJacobian; //!< Determines whether the Jacobian needs to be factorized
 	double* _tempState; //!< Temporary storage with the size of the state vector or larger if binding models require it
-	linalg::Gmres _gmres; //!< GMRES algorithm for the Schur-complement in linearSolve()
+	linalg::Gmres _gmres; //!< GMRES algorithm for the Schur-complement (or the full system in Jacobian-free mode) in linearSolve()
 	double _schurSafety; //!< Safety factor for Schur-complement solution
+	bool _adaptiveLinearTol; //!< Determines whether the tolerance passed to linearSolve() is a forcing term
+
+	bool _jacobianFree; //!< Determines whether linear systems are solved by preconditioned GMRES on the full system without factorizing Jacobian blocks
+	bool _jfnkParticlePrecond; //!< Determines whether the preconditioner uses full particle blocks (@c true) or particle shells (@c false)
+	double _jfnkAlpha; //!< Factor @f$ \alpha @f$ of the current linear system in Jacobian-free mode
+	double _jfnkTime; //!< Time point of the current linear system in Jacobian-free mode
+	unsigned int _jfnkSecIdx; //!< Index of the current section, required for residual evaluations in Jacobian-free mode
+	double const* _jfnkY; //!< State vector of the current linear system in Jacobian-free mode
+	double const* _jfnkYdot; //!< Time derivative of the state vector of the current linear system in Jacobian-free mode
+	std::vector<double> _jfnkRhs; //!< Right hand side of the GMRES iteration in Jacobian-free mode
+	std::vector<double> _jfnkRes; //!< Residual at the point of linearization in Jacobian-free mode
+	std::vector<double> _jfnkResDir; //!< Directional derivative of the residual in Jacobian-free mode
+	std::vector<double> _jfnkStatePerturbed; //!< Perturbed state vector for directional derivatives in Jacobian-free mode
+	std::vector<double> _jfnkStateDotPerturbed; //!< Perturbed time derivative of the state vector for directional derivatives in Jacobian-free mode
+	std::vector<double> _jfnkShellJac; //!< Diagonal shell blocks of the particle Jacobians (shell preconditioner in Jacobian-free mode)
+	std::vector<lapackInt_t> _jfnkShellPivot; //!< Pivots of the factorized shell blocks
+	std::vector<unsigned int> _jfnkShellOffset; //!< Offset of the first shell block of each particle type in _jfnkShellJac
+	std::vector<double> _jfnkFluxSchur; //!< Schur complements of the flux equations of each column cell (preconditioner in Jacobian-free mode)
+	std::vector<lapackInt_t> _jfnkFluxSchurPivot; //!< Pivots of the factorized flux Schur complements
+	std::vector<double> _jfnkFluxBuffer; //!< Flux variables of one column cell for solving with the flux Schur complement
+	std::vector<double> _jfnkPrecondWork; //!< Work vector of the preconditioner in Jacobian-free mode
+	util::ThreadLocalStorage _jfnkThreadLocalMem; //!< Thread local storage for residual evaluations in Jacobian-free mode
 
 	std::vector<active> _initC; //!< Liquid bulk phase initial conditions
 	bool _singleRadiusInitC;
@@ -342,6 +389,7 @@ protected:
 
 	// Wrapper for calling the corresponding function in GeneralRateModel class
 	friend int schurComplementMultiplierGRM2D(void* userData, double const* x, double* z);
+	friend int jacobianFreeMultiplierGRM2D(void* userData, double const* x, double* z);
 
 	class Indexer
 	{
@@ -34,7 +34,8 @@ namespace model
 {
 
 InletModel::InletModel(UnitOpIdx unitOpIdx) : _unitOpIdx(unitOpIdx), _inlet(nullptr),
-	_inletConcentrationsRaw(nullptr), _inletDerivatives(nullptr), _inletConcentrations(nullptr)
+	_inletConcentrationsRaw(nullptr), _inletDerivatives(nullptr), _inletConcentrations(nullptr),
+	_cacheTime(0.0), _cacheSec(0), _cacheValid(false), _cacheAdValid(false)
 {
 }
 
@@ -81,11 +82,13 @@ bool InletModel::configureModelDiscretization(IParameterProvider& paramProvider,
 
 bool InletModel::configure(IParameterProvider& paramProvider)
 {
+	invalidateInletCache();
 	return _inlet->configure(&paramProvider, _nComp);
 }
 
 void InletModel::setSectionTimes(double const* secTimes, bool const* secContinuity, unsigned int nSections)
 {
+	invalidateInletCache();
 	if (_inlet)
 		_inlet->setSectionTimes(secTimes, secContinuity, nSections);
 }
@@ -152,6 +155,7 @@ bool InletModel::setParameter(const ParameterId& pId, double value)
 	if (_inlet && ((pId.unitOperation == _unitOpIdx) || (pId.unitOperation == UnitOpIndep)))
 	{
 		_inlet->setParameterValue(pId, value);
+		invalidateInletCache();
 		return true;
 	}
 
@@ -163,11 +167,20 @@ bool InletModel::setParameter(const ParameterId& pId, bool value)
 	return false;
 }
 
+bool InletModel::resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage)
+{
+	// Inlet parameters are set by setParameter() since the inlet cache has to be invalidated
+	return !(_inlet && ((pId.unitOperation == _unitOpIdx) || (pId.unitOperation == UnitOpIndep)));
+}
+
 void InletModel::setSensitiveParameterValue(const ParameterId& pId, double value)
 {
 	// Check inlet and filter parameters
 	if (_inlet && ((pId.unitOperation == _unitOpIdx) || (pId.unitOperation == UnitOpIndep)) && (_sensParamsInlet.find(pId) != _sensParamsInlet.end()))
+	{
 		_inlet->setParameterValue(pId, value);
+		invalidateInletCache();
+	}
 }
 
 bool InletModel::setSensitiveParameter(const ParameterId& pId, unsigned int adDirection, double adValue)
@@ -197,6 +210,7 @@ bool InletModel::setSensitiveParameter(const ParameterId& pId, unsigned int adDi
 			
 			// Register parameter and reserve AD direction
 			_sensParamsInlet[pId] = std::make_tuple(adDirection, adValue);
+			_cacheAdValid = false;
 			return true;
 		}
 	}
@@ -207,6 +221,7 @@ bool InletModel::setSensitiveParameter(const ParameterId& pId, unsigned int adDi
 void InletModel::clearSensParams()
 {
 	_sensParamsInlet.clear();
+	_cacheAdValid = false;
 }
 
 unsigned int InletModel::numSensParams() const
@@ -222,6 +237,10 @@ template<> double const* InletModel::moveInletValues(double const* const rawValu
 
 template<> active const* InletModel::moveInletValues(double const* const rawValues, double t, unsigned int secIdx) const
 {
+	// Parameter derivatives are only evaluated on request and memoized along with the raw values
+	if (_cacheAdValid)
+		return _inletConcentrations;
+
 	// Convert to active
 	for (unsigned int i = 0; i < _nComp; ++i)
 		_inletConcentrations[i] = rawValues[i];
@@ -246,6 +265,7 @@ template<> active const* InletModel::moveInletValues(double const* const rawValu
 //		LOG(Debug) << "totalInlet " << adDir << " " << cadet::log::VectorPtr<cadet::active>(_inletConcentrations, _nComp);
 	}
 
+	_cacheAdValid = true;
 	return _inletConcentrations;
 }
 
@@ -260,7 +280,31 @@ template<> active const* const InletModel::getData() const
 }
 
 void InletModel::useAnalyticJacobian(const bool analyticJac) { }
-void InletModel::notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, const AdJacobianParams& adJac) { }
+void InletModel::notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, const AdJacobianParams& adJac)
+{
+	invalidateInletCache();
+}
+
+/**
+ * @brief Evaluates the inlet profile at the given time and section
+ * @details Newton iterations evaluate the residual repeatedly at the same time point. The
+ *          evaluation is memoized for the last pair @f$ (t, \text{secIdx}) @f$ and is only
+ *          repeated if time, section, or parameters have changed.
+ * @param [in] t Current time point
+ * @param [in] secIdx Index of the current section
+ */
+void InletModel::evaluateInletProfile(double t, unsigned int secIdx)
+{
+	if (_cacheValid && (t == _cacheTime) && (secIdx == _cacheSec))
+		return;
+
+	_inlet->inletConcentration(t, secIdx, _inletConcentrationsRaw);
+
+	_cacheTime = t;
+	_cacheSec = secIdx;
+	_cacheValid = true;
+	_cacheAdValid = false;
+}
 
 void InletModel::reportSolution(ISolutionRecorder& recorder, double const* const solution) const
 {
@@ -288,7 +332,7 @@ void InletModel::readInitialCondition(IParameterProvider& paramProvider) { }
 
 void InletModel::consistentInitialState(const SimulationTime& simTime, double* const vecStateY, const AdJacobianParams& adJac, double errorTol, util::ThreadLocalStorage& threadLocalMem)
 { 
-	_inlet->inletConcentration(simTime.t, simTime.secIdx, _inletConcentrationsRaw);
+	evaluateInletProfile(simTime.t, simTime.secIdx);
 	std::copy_n(_inletConcentrationsRaw, _nComp, vecStateY);
 }
 
@@ -318,7 +362,7 @@ template <typename ResidualType, typename ParamType>
 int InletModel::residualImpl(double t, unsigned int secIdx, const ConstSimulationState& simState, ResidualType* const res, util::ThreadLocalStorage& threadLocalMem)
 {
 	// Evaluate the user-specified function for the inlet concentration
-	_inlet->inletConcentration(t, secIdx, _inletConcentrationsRaw);
+	evaluateInletProfile(t, secIdx);
 
 	// Copy inlet concentrations over to active types if necessary
 	moveInletValues<ResidualType>(_inletConcentrationsRaw, t, secIdx);
@@ -349,6 +393,9 @@ int InletModel::residualSensFwdCombine(const SimulationTime& simTime, const Cons
 {
 	for (unsigned int param = 0; param < yS.size(); ++param)
 	{
+		if (!yS[param])
+			continue;
+
 		double* const ptrResS = resS[param];
 		double const* const ptrYs = yS[param];
 
@@ -80,6 +80,7 @@ public:
 
 	virtual bool setSensitiveParameter(const ParameterId& pId, unsigned int adDirection, double adValue);
 	virtual void setSensitiveParameterValue(const ParameterId& id, double value);
+	virtual bool resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage);
 
 	virtual void clearSensParams();
 	virtual unsigned int numSensParams() const;
@@ -101,6 +102,8 @@ public:
 	// linearSolve is a null operation (the result is I^-1 *rhs -> rhs) since the Jacobian is an identity matrix
 	virtual int linearSolve(double t, double alpha, double tol, double* const rhs, double const* const weight,
 		const ConstSimulationState& simState) { return 0; }
+	virtual void setAdaptiveLinearSolverTolerance(bool adaptive) CADET_NOEXCEPT { }
+	virtual unsigned long numLinearSolverIterations() const CADET_NOEXCEPT { return 0; }
 
 	virtual void prepareADvectors(const AdJacobianParams& adJac) const;
 
@@ -148,6 +151,9 @@ protected:
 
 	template <typename T> T const* moveInletValues(double const* const rawValues, double t, unsigned int secIdx) const;
 
+	void evaluateInletProfile(double t, unsigned int secIdx);
+	inline void invalidateInletCache() CADET_NOEXCEPT { _cacheValid = false; _cacheAdValid = false; }
+
 	template <typename T> T const* const getData() const;
 
 	template <typename ResidualType, typename ParamType>
@@ -165,6 +171,11 @@ protected:
 
 	std::unordered_map<ParameterId, std::tuple<unsigned int, double>> _sensParamsInlet; //!< Maps an inlet parameter to its AD direction and derivative value
 
+	double _cacheTime; //!< Time of the memoized inlet profile evaluation
+	unsigned int _cacheSec; //!< Section index of the memoized inlet profile evaluation
+	bool _cacheValid; //!< Determines whether _inletConcentrationsRaw holds the inlet profile at (_cacheTime, _cacheSec)
+	mutable bool _cacheAdValid; //!< Determines whether _inletConcentrations holds the parameter derivatives at (_cacheTime, _cacheSec)
+
 	class Exporter : public ISolutionExporter
 	{
 	public:
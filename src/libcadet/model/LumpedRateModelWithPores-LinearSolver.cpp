@@ -14,6 +14,7 @@
 #include "model/BindingModel.hpp"
 #include "linalg/DenseMatrix.hpp"
 #include "linalg/BandMatrix.hpp"
+#include "linalg/EisenstatWalker.hpp"
 #include "AdUtils.hpp"
 
 #include <algorithm>
@@ -237,7 +238,7 @@ int LumpedRateModelWithPores::linearSolve(double t, double alpha, double outerTo
 
 		// Note that rhs is updated in-place with the solution of the Schur-complement
 		// The temporary storage is only needed to hold the right hand side of the Schur-complement
-		const double tolerance = std::sqrt(static_cast<double>(numDofs())) * outerTol * _schurSafety;
+		const double tolerance = linalg::gmresTolerance(_adaptiveLinearTol, outerTol, _schurSafety, rhs + idxr.offsetJf(), weight + idxr.offsetJf(), _gmres.matrixSize(), numDofs());
 
 		BENCH_START(_timerGmres);
 		const int gmresResult = _gmres.solve(tolerance, weight + idxr.offsetJf(), _tempState + idxr.offsetJf(), rhs + idxr.offsetJf());
@@ -57,7 +57,7 @@ int schurComplementMultiplierLRMPores(void* userData, double const* x, double* z
 
 LumpedRateModelWithPores::LumpedRateModelWithPores(UnitOpIdx unitOpIdx) : UnitOperationBase(unitOpIdx),
 	_dynReactionBulk(nullptr), _jacP(0), _jacPdisc(0), _jacPF(0), _jacFP(0), _jacInlet(), _analyticJac(true),
-	_jacobianAdDirs(0), _factorizeJacobian(false), _tempState(nullptr), _initC(0), _initCp(0), _initQ(0),
+	_jacobianAdDirs(0), _factorizeJacobian(false), _tempState(nullptr), _adaptiveLinearTol(false), _initC(0), _initCp(0), _initQ(0),
 	_initState(0), _initStateDot(0)
 {
 }
@@ -1126,6 +1126,9 @@ int LumpedRateModelWithPores::residualSensFwdCombine(const SimulationTime& simTi
 
 	for (unsigned int param = 0; param < yS.size(); ++param)
 	{
+		if (!yS[param])
+			continue;
+
 		// Directional derivative (dF / dy) * s
 		multiplyWithJacobian(SimulationTime{0.0, 0u}, ConstSimulationState{nullptr, nullptr}, yS[param], 1.0, 0.0, tmp1);
 
@@ -1376,6 +1379,45 @@ bool LumpedRateModelWithPores::setParameter(const ParameterId& pId, double value
 	return UnitOperationBase::setParameter(pId, value);
 }
 
+bool LumpedRateModelWithPores::resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage)
+{
+	if (pId.unitOperation == _unitOpIdx)
+	{
+		// Intercept changes to PAR_TYPE_VOLFRAC when not specified per axial cell (but once globally)
+		if (_axiallyConstantParTypeVolFrac && (pId.name == hashString("PAR_TYPE_VOLFRAC")))
+		{
+			if ((pId.section != SectionIndep) || (pId.component != CompIndep) || (pId.boundState != BoundStateIndep) || (pId.reaction != ReactionIndep))
+				return true;
+			if (pId.particleType >= _disc.nParType)
+				return true;
+
+			for (unsigned int i = 0; i < _disc.nCol; ++i)
+				storage.push_back(&_parTypeVolFrac[i * _disc.nParType + pId.particleType]);
+
+			return true;
+		}
+
+		if (multiplexTypeParameterStorage(pId, hashString("PAR_RADIUS"), _singleParRadius, _parRadius, storage))
+			return true;
+		if (multiplexTypeParameterStorage(pId, hashString("PAR_POROSITY"), _singleParPorosity, _parPorosity, storage))
+			return true;
+
+		if (multiplexCompTypeSecParameterStorage(pId, hashString("FILM_DIFFUSION"), _filmDiffusionMode, _filmDiffusion, _disc.nParType, _disc.nComp, storage))
+			return true;
+		if (multiplexCompTypeSecParameterStorage(pId, hashString("PORE_ACCESSIBILITY"), _poreAccessFactorMode, _poreAccessFactor, _disc.nParType, _disc.nComp, storage))
+			return true;
+
+		// Multiplexed initial conditions are set by setParameter()
+		if ((pId.name == hashString("INIT_CP")) || (pId.name == hashString("INIT_Q")))
+			return false;
+
+		if (_convDispOp.resolveParameterStorage(pId, storage))
+			return true;
+	}
+
+	return UnitOperationBase::resolveParameterStorage(pId, storage);
+}
+
 void LumpedRateModelWithPores::setSensitiveParameterValue(const ParameterId& pId, double value)
 {
 	if (pId.unitOperation == _unitOpIdx)
@@ -105,6 +105,8 @@ public:
 
 	virtual int linearSolve(double t, double alpha, double tol, double* const rhs, double const* const weight,
 		const ConstSimulationState& simState);
+	virtual void setAdaptiveLinearSolverTolerance(bool adaptive) CADET_NOEXCEPT { _adaptiveLinearTol = adaptive; }
+	virtual unsigned long numLinearSolverIterations() const CADET_NOEXCEPT { return _gmres.numIterations(); }
 
 	virtual void prepareADvectors(const AdJacobianParams& adJac) const;
 
@@ -148,6 +150,7 @@ public:
 	virtual bool setParameter(const ParameterId& pId, double value);
 	virtual bool setSensitiveParameter(const ParameterId& pId, unsigned int adDirection, double adValue);
 	virtual void setSensitiveParameterValue(const ParameterId& id, double value);
+	virtual bool resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage);
 
 	virtual unsigned int threadLocalMemorySize() const CADET_NOEXCEPT;
 
@@ -275,6 +278,7 @@ protected:
 	double* _tempState; //!< Temporary storage with the size of the state vector or larger if binding models require it
 	linalg::Gmres _gmres; //!< GMRES algorithm for the Schur-complement in linearSolve()
 	double _schurSafety; //!< Safety factor for Schur-complement solution
+	bool _adaptiveLinearTol; //!< Determines whether the tolerance passed to linearSolve() is a forcing term
 
 	std::vector<active> _initC; //!< Liquid bulk phase initial conditions
 	std::vector<active> _initCp; //!< Liquid particle phase initial conditions
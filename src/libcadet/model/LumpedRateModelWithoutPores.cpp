@@ -650,6 +650,9 @@ int LumpedRateModelWithoutPores::residualSensFwdCombine(const SimulationTime& si
 
 	for (unsigned int param = 0; param < yS.size(); ++param)
 	{
+		if (!yS[param])
+			continue;
+
 		// Directional derivative (dF / dy) * s
 		multiplyWithJacobian(SimulationTime{0.0, 0u}, ConstSimulationState{nullptr, nullptr}, yS[param], 1.0, 0.0, tmp1);
 
@@ -1767,6 +1770,14 @@ bool LumpedRateModelWithoutPores::setParameter(const ParameterId& pId, double va
 	return UnitOperationBase::setParameter(pId, value);
 }
 
+bool LumpedRateModelWithoutPores::resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage)
+{
+	if (_convDispOp.resolveParameterStorage(pId, storage))
+		return true;
+
+	return UnitOperationBase::resolveParameterStorage(pId, storage);
+}
+
 void LumpedRateModelWithoutPores::setSensitiveParameterValue(const ParameterId& pId, double value)
 {
 	if (_convDispOp.setSensitiveParameterValue(_sensParams, pId, value))
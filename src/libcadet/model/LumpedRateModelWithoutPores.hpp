@@ -140,6 +140,7 @@ public:
 	virtual bool setParameter(const ParameterId& pId, double value);
 	virtual bool setSensitiveParameter(const ParameterId& pId, unsigned int adDirection, double adValue);
 	virtual void setSensitiveParameterValue(const ParameterId& id, double value);
+	virtual bool resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage);
 
 	virtual unsigned int threadLocalMemorySize() const CADET_NOEXCEPT;
 
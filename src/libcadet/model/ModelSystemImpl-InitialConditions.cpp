@@ -102,19 +102,15 @@ int ModelSystem::dResDpFwdWithJacobian(const SimulationTime& simTime, const Cons
 
 	// Evaluate residual for all parameters using AD in vector mode and at the same time update the 
 	// Jacobian (in one AD run, if analytic Jacobians are disabled)
-#ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), _models.size(), [&](size_t i)
-#else
-	for (unsigned int i = 0; i < _models.size(); ++i)
-#endif
+	forEachUnitOperation([&](unsigned int i, util::ThreadLocalStorage& tls)
 	{
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
 
 		_errorIndicator[i] = m->residualSensFwdWithJacobian(simTime, applyOffset(simState, offset),
-			applyOffset(adJac, offset), _threadLocalStorage);
+			applyOffset(adJac, offset), tls);
 
-	} CADET_PARFOR_END;
+	});
 
 	// Handle connections
 	residualConnectUnitOps<double, active, active>(simTime.secIdx, simState.vecStateY, simState.vecStateYdot, adJac.adRes);
@@ -13,6 +13,7 @@
 #include "model/ModelSystemImpl.hpp"
 
 #include "SimulationTypes.hpp"
+#include "linalg/EisenstatWalker.hpp"
 
 #include "LoggingUtils.hpp"
 #include "Logging.hpp"
@@ -45,6 +46,21 @@ int ModelSystem::linearSolve(double t, double alpha, double outerTol, double* co
 	}
 }
 
+void ModelSystem::setAdaptiveLinearSolverTolerance(bool adaptive) CADET_NOEXCEPT
+{
+	_adaptiveLinearTol = adaptive;
+	for (IUnitOperation* m : _models)
+		m->setAdaptiveLinearSolverTolerance(adaptive);
+}
+
+unsigned long ModelSystem::numLinearSolverIterations() const CADET_NOEXCEPT
+{
+	unsigned long nIter = _gmres.numIterations();
+	for (IUnitOperation const* m : _models)
+		nIter += m->numLinearSolverIterations();
+	return nIter;
+}
+
 int ModelSystem::linearSolveSequential(double t, double alpha, double outerTol, double* const rhs, double const* const weight,
 	const ConstSimulationState& simState)
 {
@@ -91,7 +107,10 @@ int ModelSystem::linearSolveSequential(double t, double alpha, double outerTol,
 		}
 
 		// Solve unit operation itself
-		_errorIndicator[idxUnit] = m->linearSolve(t, alpha, outerTol, rhs + offset, weight + offset, applyOffset(simState, offset));
+		if (skipLinearSolve(idxUnit, rhs + offset))
+			_errorIndicator[idxUnit] = 0;
+		else
+			_errorIndicator[idxUnit] = m->linearSolve(t, alpha, outerTol, rhs + offset, weight + offset, applyOffset(simState, offset));
 	}
 
 	return totalErrorIndicatorFromLocal(_errorIndicator);
@@ -106,16 +125,15 @@ int ModelSystem::linearSolveParallel(double t, double alpha, double outerTol, do
 
 	const unsigned int finalOffset = _dofOffset[_models.size()];
 
-#ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), _models.size(), [=](size_t i)
-#else
-	for (unsigned int i = 0; i < _models.size(); ++i)
-#endif
+	forEachUnitOperation([=](unsigned int i, util::ThreadLocalStorage& tls)
 	{
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
-		_errorIndicator[i] = m->linearSolve(t, alpha, outerTol, rhs + offset, weight + offset, applyOffset(simState, offset));
-	} CADET_PARFOR_END;
+		if (skipLinearSolve(i, rhs + offset))
+			_errorIndicator[i] = 0;
+		else
+			_errorIndicator[i] = m->linearSolve(t, alpha, outerTol, rhs + offset, weight + offset, applyOffset(simState, offset));
+	});
 
 	// Solve last row of L with backwards substitution: y_f = b_f - \sum_{i=0}^{N_z} J_{f,i} y_i
 	// Note that we cannot easily parallelize this loop since the results of the sparse
@@ -143,7 +161,7 @@ int ModelSystem::linearSolveParallel(double t, double alpha, double outerTol, do
 
 	// Note that rhs is updated in-place with the solution of the Schur-complement
 	// The temporary storage is only needed to hold the right hand side of the Schur-complement
-	const double tolerance = std::sqrt(static_cast<double>(numDofs())) * outerTol * _schurSafety;
+	const double tolerance = linalg::gmresTolerance(_adaptiveLinearTol, outerTol, _schurSafety, rhs + finalOffset, weight + finalOffset, numCouplingDOF(), numDofs());
 
 	// The network version of the schurCompletmentMatrixVector function need access to more information than the current interface
 	// Instead of changing the interface a lambda function is used and closed over the additional variables
@@ -183,8 +201,11 @@ int ModelSystem::linearSolveParallel(double t, double alpha, double outerTol, do
 		_jacNF[idxModel].multiplyVector(rhs + finalOffset, _tempState + offset);
 
 		// Apply N_i^{-1} to tempState_i
-		const int linSolve = m->linearSolve(t, alpha, outerTol, _tempState + offset, weight + offset, applyOffset(simState, offset));
-		_errorIndicator[idxModel] = updateErrorIndicator(_errorIndicator[idxModel], linSolve);
+		if (!skipLinearSolve(idxModel, _tempState + offset))
+		{
+			const int linSolve = m->linearSolve(t, alpha, outerTol, _tempState + offset, weight + offset, applyOffset(simState, offset));
+			_errorIndicator[idxModel] = updateErrorIndicator(_errorIndicator[idxModel], linSolve);
+		}
 
 		// Compute rhs_i = y_i - N_i^{-1} * N_{i,f} * y_f = y_i - tempState_i
 		const unsigned int offsetNext = _dofOffset[idxModel + 1];
@@ -238,8 +259,11 @@ int ModelSystem::schurComplementMatrixVector(double const* x, double* z, double
 		_jacNF[idxModel].multiplyVector(x, _tempState + offset);
 
 		// Apply N_i^{-1} to tempState_i
-		const int linSolve = m->linearSolve(t, alpha, outerTol, _tempState + offset, weight + offset, applyOffset(simState, offset));
-		_errorIndicator[idxModel] = updateErrorIndicator(_errorIndicator[idxModel], linSolve);
+		if (!skipLinearSolve(idxModel, _tempState + offset))
+		{
+			const int linSolve = m->linearSolve(t, alpha, outerTol, _tempState + offset, weight + offset, applyOffset(simState, offset));
+			_errorIndicator[idxModel] = updateErrorIndicator(_errorIndicator[idxModel], linSolve);
+		}
 
 		// Apply J_{f,i} and subtract results from z
 		{
@@ -92,6 +92,8 @@ void ModelSystem::notifyDiscontinuousSectionTransition(double t, unsigned int se
 	// Check if simulation is (re-)starting from the very beginning
 	if (secIdx == 0)
 		_curSwitchIndex = 0;
+	else
+		rebalanceThreadBudgets();
 
 	const unsigned int wrapSec = secIdx % _switchSectionIndex.size();
 	const unsigned int prevSwitch = _curSwitchIndex;
@@ -187,6 +189,8 @@ void ModelSystem::notifyDiscontinuousSectionTransition(double t, unsigned int se
 
 	if ((0 == secIdx) || (prevSwitch != _curSwitchIndex))
 		assembleSuperStructMatrices(secIdx);		
+
+	updateSensitivityPruning(secIdx);
 }
 
 /**
@@ -365,16 +369,12 @@ int ModelSystem::residual(const SimulationTime& simTime, const ConstSimulationSt
 {
 	BENCH_START(_timerResidual);
 
-#ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), _models.size(), [&](size_t i)
-#else
-	for (unsigned int i = 0; i < _models.size(); ++i)
-#endif
+	forEachUnitOperation([&](unsigned int i, util::ThreadLocalStorage& tls)
 	{
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
-		_errorIndicator[i] = m->residual(simTime, applyOffset(simState, offset), res + offset, _threadLocalStorage);
-	} CADET_PARFOR_END;
+		_errorIndicator[i] = m->residual(simTime, applyOffset(simState, offset), res + offset, tls);
+	});
 
 	// Handle connections
 	residualConnectUnitOps<double, double, double>(simTime.secIdx, simState.vecStateY, simState.vecStateYdot, res);
@@ -388,19 +388,15 @@ int ModelSystem::residualWithJacobian(const SimulationTime& simTime, const Const
 {
 	BENCH_START(_timerResidual);
 
-#ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), _models.size(), [&](size_t i)
-#else
-	for (unsigned int i = 0; i < _models.size(); ++i)
-#endif
+	forEachUnitOperation([&](unsigned int i, util::ThreadLocalStorage& tls)
 	{
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
 
 		_errorIndicator[i] = m->residualWithJacobian(simTime, applyOffset(simState, offset),
-			res + offset, applyOffset(adJac, offset), _threadLocalStorage);
+			res + offset, applyOffset(adJac, offset), tls);
 
-	} CADET_PARFOR_END;
+	});
 
 	// Handle connections
 	residualConnectUnitOps<double, double, double>(simTime.secIdx, simState.vecStateY, simState.vecStateYdot, res);
@@ -458,7 +454,7 @@ int ModelSystem::residualSensFwd(unsigned int nSens, const SimulationTime& simTi
 	return residualSensFwdWithJacobianAlgorithm<false>(nSens, simTime, simState, res, yS, ySdot, resS, AdJacobianParams{adRes, nullptr, 0}, tmp1, tmp2, tmp3);
 }
 
-void ModelSystem::multiplyWithMacroJacobian(double const* yS, double alpha, double beta, double* ret)
+void ModelSystem::multiplyWithMacroJacobian(double const* yS, double alpha, double beta, double* ret, char const* nonzeroUnits)
 {
 	const unsigned int finalOffset = _dofOffset.back();
 	
@@ -471,8 +467,12 @@ void ModelSystem::multiplyWithMacroJacobian(double const* yS, double alpha, doub
 	}
 
 	// N_{x,f} Inlets (Right) matrices
+	// Unit operations in which yS is structurally zero also receive zero inlet values and do not emit anything
 	for (unsigned int i = 0; i < _models.size(); ++i)
 	{
+		if (nonzeroUnits && !nonzeroUnits[i])
+			continue;
+
 		const unsigned int offset = _dofOffset[i];
 		_jacNF[i].multiplyAdd(yS + finalOffset, ret + offset, alpha);
 	}
@@ -480,6 +480,9 @@ void ModelSystem::multiplyWithMacroJacobian(double const* yS, double alpha, doub
 	// N_{f,x} Outlet (Lower) matrices
 	for (unsigned int i = 0; i < _models.size(); ++i)
 	{
+		if (nonzeroUnits && !nonzeroUnits[i])
+			continue;
+
 		const unsigned int offset = _dofOffset[i];
 		_jacFN[i].multiplyAdd(yS + offset, ret + finalOffset, alpha);
 	}
@@ -544,19 +547,44 @@ int ModelSystem::residualSensFwdWithJacobianAlgorithm(unsigned int nSens, const
 		_resSTemp[i].resize(resS.size());
 	}
 
+	// Determine structurally zero blocks (unit operation, sensitivity), see updateSensitivityPruning()
+	const unsigned int nPrunable = std::min<std::size_t>(yS.size(), _sensNonzero.size() / std::max<std::size_t>(nModels, 1));
+	_unitSensNonzero.assign(nModels, 0);
+	for (unsigned int i = 0; i < nModels; ++i)
+	{
+		if (nPrunable < yS.size())
+		{
+			_unitSensNonzero[i] = 1;
+			continue;
+		}
+
+		for (unsigned int j = 0; j < nPrunable; ++j)
+		{
+			if (_sensNonzero[j * nModels + i])
+			{
+				_unitSensNonzero[i] = 1;
+				break;
+			}
+		}
+	}
+
 	// Step 1: Calculate sensitivities using AD in vector mode
 
-#ifdef CADET_PARALLELIZE
-	tbb::parallel_for(size_t(0), size_t(nModels), [&](size_t i)
-#else
-	for (unsigned int i = 0; i < nModels; ++i)
-#endif
+	forEachUnitOperation([&](unsigned int i, util::ThreadLocalStorage& tls)
 	{
+		// The sensitivity derivatives are not required if all sensitivities vanish in this unit operation,
+		// but the Jacobian still has to be updated if requested
+		if (!evalJacobian && !_unitSensNonzero[i])
+		{
+			_errorIndicator[i] = 0;
+			return;
+		}
+
 		IUnitOperation* const m = _models[i];
 		const unsigned int offset = _dofOffset[i];
 
-		_errorIndicator[i] = ResidualSensCaller<evalJacobian>::call(m, simTime, applyOffset(simState, offset), applyOffset(adJac, offset), _threadLocalStorage);
-	} CADET_PARFOR_END;
+		_errorIndicator[i] = ResidualSensCaller<evalJacobian>::call(m, simTime, applyOffset(simState, offset), applyOffset(adJac, offset), tls);
+	});
 
 	// Connect units
 	residualConnectUnitOps<double, active, active>(simTime.secIdx, simState.vecStateY, simState.vecStateYdot, adJac.adRes);
@@ -573,15 +601,29 @@ int ModelSystem::residualSensFwdWithJacobianAlgorithm(unsigned int nSens, const
 
 		// Move this outside the loop, these are memory addresses and should never change
 		// Use correct offset in sensitivity state vectors
+		// Structurally zero sensitivities are marked by nullptr and their residual is set here
 		for (unsigned int j = 0; j < yS.size(); ++j)
 		{
+			if ((j < nPrunable) && !_sensNonzero[j * nModels + i])
+			{
+				_yStemp[i][j] = nullptr;
+				_yStempDot[i][j] = nullptr;
+				_resSTemp[i][j] = resS[j] + offset;
+				std::fill_n(resS[j] + offset, _dofs[i], 0.0);
+				++_sensBlocksSkipped[i];
+				continue;
+			}
+
 			_yStemp[i][j] = yS[j] + offset;
 			_yStempDot[i][j] = ySdot[j] + offset;
 			_resSTemp[i][j] = resS[j] + offset;
 		}
 
-		const int intermediateRes = m->residualSensFwdCombine(simTime, applyOffset(simState, offset), _yStemp[i], _yStempDot[i], _resSTemp[i], adJac.adRes + offset, tmp1 + offset, tmp2 + offset, tmp3 + offset);
-		_errorIndicator[i] = updateErrorIndicator(_errorIndicator[i], intermediateRes);
+		if (_unitSensNonzero[i])
+		{
+			const int intermediateRes = m->residualSensFwdCombine(simTime, applyOffset(simState, offset), _yStemp[i], _yStempDot[i], _resSTemp[i], adJac.adRes + offset, tmp1 + offset, tmp2 + offset, tmp3 + offset);
+			_errorIndicator[i] = updateErrorIndicator(_errorIndicator[i], intermediateRes);
+		}
 	} CADET_PARFOR_END;
 
 	// tmp1 stores result of (dF / dy) * s
@@ -601,7 +643,7 @@ int ModelSystem::residualSensFwdWithJacobianAlgorithm(unsigned int nSens, const
 
 		// Directional derivative: res_{con} = (dF / dy) * s
 		// Also adds contribution of the right macro column blocks
-		multiplyWithMacroJacobian(yS[param], ptrResS);
+		multiplyWithMacroJacobian(yS[param], 1.0, 0.0, ptrResS, (param < nPrunable) ? _sensNonzero.data() + param * nModels : nullptr);
 
 		// Directional derivative (dF / dyDot) * sDot  (always zero so ignore it)
 
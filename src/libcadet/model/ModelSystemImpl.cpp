@@ -85,7 +85,8 @@ namespace cadet
 namespace model
 {
 
-ModelSystem::ModelSystem() : _jacNF(nullptr), _jacFN(nullptr), _jacActiveFN(nullptr), _curSwitchIndex(0), _tempState(nullptr), _initState(0, 0.0), _initStateDot(0, 0.0)
+ModelSystem::ModelSystem() : _jacNF(nullptr), _jacFN(nullptr), _jacActiveFN(nullptr), _curSwitchIndex(0), _tempState(nullptr), _sensPruning(false), _sensPruningSec(-1), _adaptiveLinearTol(false), _initState(0, 0.0), _initStateDot(0, 0.0),
+	_threadBudgetMode(0), _numThreads(1), _unitWallTime(0.0), _unitWallTimeTotal(0.0)
 {
 }
 
@@ -289,6 +290,16 @@ unsigned int ModelSystem::numPureDofs() const CADET_NOEXCEPT
 	return dofs;
 }
 
+unsigned int ModelSystem::unitOperationDofOffset(UnitOpIdx unitOpIdx) const CADET_NOEXCEPT
+{
+	for (unsigned int i = 0; i < _models.size(); ++i)
+	{
+		if (_models[i]->unitOperationId() == unitOpIdx)
+			return _dofOffset[i];
+	}
+	return InvalidDofOffset;
+}
+
 bool ModelSystem::usesAD() const CADET_NOEXCEPT
 {
 	for (IUnitOperation* m : _models)
@@ -450,6 +461,12 @@ bool ModelSystem::configureModelDiscretization(IParameterProvider& paramProvider
 
 	paramProvider.pushScope("solver");
 	readLinearSolutionMode(paramProvider);
+	readThreadBudgetMode(paramProvider);
+
+	// Default: disabled (sensitivity systems are evaluated for all unit operations)
+	_sensPruning = false;
+	if (paramProvider.exists("SENS_PRUNING"))
+		_sensPruning = paramProvider.getBool("SENS_PRUNING");
 	paramProvider.popScope();
 
 	configureSwitches(paramProvider);
@@ -597,6 +614,7 @@ bool ModelSystem::configure(IParameterProvider& paramProvider)
 	const int maxRestarts = paramProvider.getInt("MAX_RESTARTS");
 	_schurSafety = paramProvider.getDouble("SCHUR_SAFETY");
 	readLinearSolutionMode(paramProvider);
+	readThreadBudgetMode(paramProvider);
 
 	paramProvider.popScope();
 
@@ -820,6 +838,19 @@ void ModelSystem::readLinearSolutionMode(IParameterProvider& paramProvider)
 		_linearSolutionMode = paramProvider.getInt("LINEAR_SOLUTION_MODE");
 }
 
+void ModelSystem::readThreadBudgetMode(IParameterProvider& paramProvider)
+{
+	// Default: disabled (all unit operations share all threads)
+	_threadBudgetMode = 0;
+
+	// Override default by user option
+	if (paramProvider.exists("THREAD_BUDGET_MODE"))
+		_threadBudgetMode = paramProvider.getInt("THREAD_BUDGET_MODE");
+
+	if ((_threadBudgetMode < 0) || (_threadBudgetMode > 2))
+		throw InvalidParameterException("THREAD_BUDGET_MODE has to be 0, 1, or 2");
+}
+
 /**
  * @brief Checks the given unit operation connection list and reformats it
  * @details Throws an exception if something is incorrect. Reformats the connection list by
@@ -1068,6 +1099,50 @@ bool ModelSystem::setParameter(const ParameterId& pId, bool value)
 	return setParameterImpl(pId, value);
 }
 
+bool ModelSystem::resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage)
+{
+	auto paramHandle = _parameters.find(pId);
+	if (paramHandle != _parameters.end())
+	{
+		storage.push_back(paramHandle->second);
+
+		// Multiplex flow rate parameters
+#if CADET_COMPILER_CXX_CONSTEXPR
+		constexpr StringHash flowHash = hashString("CONNECTION");
+#else
+		const StringHash flowHash = hashString("CONNECTION");
+#endif
+		if (flowHash == pId.name)
+		{
+			// Find the index of the valve switch
+			const auto it = std::find(_switchSectionIndex.begin(), _switchSectionIndex.end(), pId.section);
+			if (it != _switchSectionIndex.end())
+			{
+				const unsigned int idxSwitch = std::distance(_switchSectionIndex.begin(), it);
+				int const* ptrConn = _connections[idxSwitch];
+				active* conRates = _flowRates[idxSwitch];
+
+				// Collect all flow rates of the same connection (except for components)
+				for (unsigned int i = 0; i < _connections.sliceSize(idxSwitch) / 6; ++i, ptrConn += 6, ++conRates)
+				{
+					if ((ptrConn[2] != pId.component) || (ptrConn[3] != pId.particleType) || (ptrConn[0] != pId.boundState) || (ptrConn[1] != pId.reaction))
+						continue;
+
+					storage.push_back(conRates);
+				}
+			}
+		}
+	}
+
+	// Filter by unit operation ID
+	for (IUnitOperation* m : _models)
+	{
+		if ((m->unitOperationId() == pId.unitOperation) || (pId.unitOperation == UnitOpIndep))
+			return m->resolveParameterStorage(pId, storage);
+	}
+	return true;
+}
+
 void ModelSystem::setSensitiveParameterValue(const ParameterId& pId, double value)
 {
 	if (pId.unitOperation == UnitOpIndep)
@@ -1121,6 +1196,19 @@ bool ModelSystem::setSensitiveParameter(const ParameterId& pId, unsigned int adD
 {
 	bool found = false;
 
+	// Record the unit operations owning the parameter for pruning the sensitivity systems,
+	// independent parameters (e.g., flow rates) may affect all unit operations
+	const std::size_t nModels = _models.size();
+	if (_sensOwner.size() < (adDirection + 1) * nModels)
+		_sensOwner.resize((adDirection + 1) * nModels, 0);
+
+	for (std::size_t i = 0; i < nModels; ++i)
+	{
+		if ((pId.unitOperation == UnitOpIndep) || (_models[i]->unitOperationId() == pId.unitOperation))
+			_sensOwner[adDirection * nModels + i] = 1;
+	}
+	resetSensitivityPruning();
+
 	// Check own parameters
 	if (pId.unitOperation == UnitOpIndep)
 	{
@@ -1182,6 +1270,8 @@ void ModelSystem::clearSensParams()
 		sp->setADValue(0.0);
 
 	_sensParams.clear();
+	_sensOwner.clear();
+	resetSensitivityPruning();
 
 	// Propagate call to models
 	for (IUnitOperation* m : _models)
@@ -1271,6 +1361,177 @@ void ModelSystem::setupParallelization(unsigned int numThreads)
 		tlsSize = std::max(tlsSize, m->threadLocalMemorySize());
 
 	_threadLocalStorage.resize(numThreads, tlsSize);
+
+	_numThreads = std::max(numThreads, 1u);
+	_unitThreads.clear();
+	_unitThreadLocalStorage.clear();
+#ifdef CADET_PARALLELIZE
+	_unitArenas.clear();
+#endif
+
+	_unitBusyTime.assign(_models.size(), 0.0);
+	_unitBusyTimeTotal.assign(_models.size(), 0.0);
+	_unitWallTime = 0.0;
+	_unitWallTimeTotal = 0.0;
+
+	if (_threadBudgetMode == 0)
+		return;
+
+	// Initial budgets are proportional to the number of DOFs
+	std::vector<double> weights(_models.size(), 0.0);
+	for (unsigned int i = 0; i < _models.size(); ++i)
+		weights[i] = _dofs[i];
+
+	assignThreadBudgets(weights);
+}
+
+/**
+ * @brief Assigns thread budgets to the unit operations proportional to the given weights
+ * @details Each unit operation receives a task arena with the concurrency given by its thread
+ *          budget along with thread local storage for each of its threads. Arenas are only
+ *          recreated if the budget of the corresponding unit operation changes.
+ * @param [in] weights Estimated cost of each unit operation
+ */
+void ModelSystem::assignThreadBudgets(const std::vector<double>& weights)
+{
+	const std::vector<unsigned int> budget = util::distributeThreads(weights, _numThreads);
+
+	_unitThreadLocalStorage.resize(_models.size());
+#ifdef CADET_PARALLELIZE
+	_unitArenas.resize(_models.size());
+#endif
+
+	const bool initial = _unitThreads.empty();
+	for (unsigned int i = 0; i < _models.size(); ++i)
+	{
+		if (!initial && (budget[i] == _unitThreads[i]))
+			continue;
+
+		_unitThreadLocalStorage[i] = util::ThreadLocalStorage();
+		_unitThreadLocalStorage[i].resize(budget[i], _models[i]->threadLocalMemorySize());
+#ifdef CADET_PARALLELIZE
+		_unitArenas[i].reset(new tbb::task_arena(static_cast<int>(budget[i])));
+#endif
+	}
+
+	_unitThreads = budget;
+
+	LOG(Debug) << "Unit operation thread budgets: " << log::VectorPtr<unsigned int>(_unitThreads.data(), _unitThreads.size());
+}
+
+/**
+ * @brief Invalidates the structurally zero blocks of the sensitivity systems
+ * @details Pruning is disabled until the next call of updateSensitivityPruning().
+ */
+void ModelSystem::resetSensitivityPruning()
+{
+	_sensNonzero.clear();
+	_sensPruningSec = -1;
+}
+
+/**
+ * @brief Determines the unit operations in which each sensitivity may be nonzero
+ * @details At the beginning of the simulation, a sensitivity is only nonzero in the unit operations
+ *          that own its parameter. In each section, it spreads to all unit operations reachable by
+ *          the connections of the current valve configuration. Since the sensitivity state is
+ *          carried over to the next section, the sets only grow until the simulation is restarted.
+ *          If a section is skipped, the history is unknown and no blocks are pruned.
+ * @param [in] secIdx Index of the new section
+ */
+void ModelSystem::updateSensitivityPruning(unsigned int secIdx)
+{
+	const std::size_t nModels = _models.size();
+	if (!_sensPruning || _sensOwner.empty())
+	{
+		resetSensitivityPruning();
+		return;
+	}
+
+	if (secIdx == 0)
+	{
+		_sensNonzero = _sensOwner;
+		_sensBlocksSkipped.assign(nModels, 0);
+		_linSolvesSkipped.assign(nModels, 0);
+	}
+	else if (_sensNonzero.empty() || ((static_cast<int>(secIdx) != _sensPruningSec) && (static_cast<int>(secIdx) != _sensPruningSec + 1)))
+	{
+		_sensNonzero.assign(_sensOwner.size(), 1);
+		_sensBlocksSkipped.resize(nModels, 0);
+		_linSolvesSkipped.resize(nModels, 0);
+	}
+
+	_sensPruningSec = secIdx;
+
+	// Propagate sensitivities downstream along the connections (depth-first search)
+	const util::SlicedVector<int> adjList = graph::adjacencyListFromConnectionList(_connections[_curSwitchIndex], nModels, _connections.sliceSize(_curSwitchIndex) / 6);
+	const std::size_t nSens = _sensNonzero.size() / nModels;
+	std::vector<int> stack;
+	stack.reserve(nModels);
+
+	std::size_t nZero = 0;
+	for (std::size_t sens = 0; sens < nSens; ++sens)
+	{
+		char* const nonzero = _sensNonzero.data() + sens * nModels;
+		for (std::size_t i = 0; i < nModels; ++i)
+		{
+			if (nonzero[i])
+				stack.push_back(i);
+		}
+
+		while (!stack.empty())
+		{
+			const int cur = stack.back();
+			stack.pop_back();
+
+			int const* const adj = adjList[cur];
+			for (std::size_t j = 0; j < adjList.sliceSize(cur); ++j)
+			{
+				if (nonzero[adj[j]])
+					continue;
+
+				nonzero[adj[j]] = 1;
+				stack.push_back(adj[j]);
+			}
+		}
+
+		nZero += std::count(nonzero, nonzero + nModels, 0);
+	}
+
+	LOG(Debug) << "Sensitivity pruning in section " << secIdx << ": " << nZero << " of " << nSens * nModels << " unit operation blocks are structurally zero, skipped "
+		<< numSkippedSensitivityBlocks() << " residual blocks and " << numSkippedLinearSolves() << " linear solves so far";
+}
+
+/**
+ * @brief Reassigns thread budgets based on the measured cost of the unit operations
+ * @details The cost of a unit operation is estimated by its accumulated wall time multiplied
+ *          by its current thread budget (i.e., the amount of work assuming linear scaling).
+ *          The utilization of each unit operation since the last rebalancing is reported.
+ */
+void ModelSystem::rebalanceThreadBudgets()
+{
+	if (_unitThreads.empty() || (_unitWallTime <= 0.0))
+		return;
+
+	std::vector<double> utilization(_models.size(), 0.0);
+	std::vector<double> weights(_models.size(), 0.0);
+	for (unsigned int i = 0; i < _models.size(); ++i)
+	{
+		utilization[i] = _unitBusyTime[i] / _unitWallTime;
+		weights[i] = _unitBusyTime[i] * _unitThreads[i];
+	}
+
+	LOG(Debug) << "Unit operation thread utilization: " << log::VectorPtr<double>(utilization.data(), utilization.size());
+
+	if (_threadBudgetMode == 2)
+		assignThreadBudgets(weights);
+
+	for (unsigned int i = 0; i < _models.size(); ++i)
+	{
+		_unitBusyTimeTotal[i] += _unitBusyTime[i];
+		_unitBusyTime[i] = 0.0;
+	}
+	_unitWallTimeTotal += _unitWallTime;
+	_unitWallTime = 0.0;
 }
 
 }  // namespace model
@@ -25,15 +25,20 @@
 #include "ParamIdUtil.hpp"
 
 #include <vector>
+#include <algorithm>
 #include <tuple>
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
+#include <memory>
 
 #ifdef CADET_PARALLELIZE
 	#include <tbb/spin_mutex.h>
+	#include <tbb/parallel_for.h>
+	#include <tbb/task_arena.h>
 #endif
 #include "ParallelSupport.hpp"
+#include "common/Timer.hpp"
 
 #include "linalg/SparseMatrix.hpp"
 #include "linalg/Gmres.hpp"
@@ -76,6 +81,7 @@ public:
 
 	virtual unsigned int numDofs() const CADET_NOEXCEPT;
 	virtual unsigned int numPureDofs() const CADET_NOEXCEPT;
+	virtual unsigned int unitOperationDofOffset(UnitOpIdx unitOpIdx) const CADET_NOEXCEPT;
 	virtual bool usesAD() const CADET_NOEXCEPT;
 	virtual unsigned int requiredADdirs() const CADET_NOEXCEPT;
 
@@ -94,6 +100,7 @@ public:
 
 	virtual bool setSensitiveParameter(const ParameterId& pId, unsigned int adDirection, double adValue);
 	virtual void setSensitiveParameterValue(const ParameterId& id, double value);
+	virtual bool resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage);
 
 	virtual void clearSensParams();
 
@@ -122,6 +129,9 @@ public:
 
 	virtual int linearSolve(double t, double alpha, double tol, double* const rhs, double const* const weight,
 		const ConstSimulationState& simState);
+	virtual void multiplyWithDerivativeJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, double const* yS, double* ret);
+	virtual void setAdaptiveLinearSolverTolerance(bool adaptive) CADET_NOEXCEPT;
+	virtual unsigned long numLinearSolverIterations() const CADET_NOEXCEPT;
 
 	virtual void prepareADvectors(const AdJacobianParams& adJac) const;
 
@@ -145,6 +155,75 @@ public:
 
 	virtual void setupParallelization(unsigned int numThreads);
 
+	/**
+	 * @brief Returns the number of threads assigned to the given unit operation
+	 * @details Thread budgets are only assigned if hierarchical parallelization is enabled
+	 *          (see @c THREAD_BUDGET_MODE). Otherwise, all unit operations share all threads.
+	 * @param [in] idxUnit Index of the unit operation
+	 * @return Number of threads the unit operation may use
+	 */
+	inline unsigned int unitThreadBudget(unsigned int idxUnit) const CADET_NOEXCEPT { return _unitThreads.empty() ? _numThreads : _unitThreads[idxUnit]; }
+
+	/**
+	 * @brief Returns the fraction of time a unit operation was busy in parallel regions
+	 * @details Relates the wall time spent in the given unit operation to the wall time of all
+	 *          scheduled parallel regions over the unit operations. Only recorded if hierarchical
+	 *          parallelization is enabled.
+	 * @param [in] idxUnit Index of the unit operation
+	 * @return Utilization of the unit operation's thread budget in @f$ [0, 1] @f$
+	 */
+	inline double unitUtilization(unsigned int idxUnit) const CADET_NOEXCEPT
+	{
+		const double wallTime = _unitWallTimeTotal + _unitWallTime;
+		if (_unitBusyTime.empty() || (wallTime <= 0.0))
+			return 0.0;
+		return (_unitBusyTimeTotal[idxUnit] + _unitBusyTime[idxUnit]) / wallTime;
+	}
+
+	/**
+	 * @brief Returns whether a sensitivity is structurally zero in the given unit operation
+	 * @details A sensitivity is structurally zero in a unit operation if its parameter does not
+	 *          belong to the unit operation and the unit operation cannot be reached from an owning
+	 *          unit operation via the connections of the current or any previous section. The
+	 *          information is updated on each discontinuous section transition.
+	 * @param [in] idxSens Index of the sensitivity (i.e., AD direction)
+	 * @param [in] idxUnit Index of the unit operation
+	 * @return @c true if the sensitivity is zero in the unit operation, otherwise @c false
+	 */
+	inline bool isSensitivityStructurallyZero(unsigned int idxSens, unsigned int idxUnit) const CADET_NOEXCEPT
+	{
+		const std::size_t idx = static_cast<std::size_t>(idxSens) * _models.size() + idxUnit;
+		return (idx < _sensNonzero.size()) && !_sensNonzero[idx];
+	}
+
+	/**
+	 * @brief Returns the number of unit operation blocks skipped in sensitivity residuals
+	 * @details Counts the blocks (unit operation and sensitivity) whose residual evaluation was
+	 *          skipped since they are structurally zero (see isSensitivityStructurallyZero()).
+	 * @return Number of skipped blocks since the start of the simulation
+	 */
+	inline std::size_t numSkippedSensitivityBlocks() const CADET_NOEXCEPT
+	{
+		std::size_t n = 0;
+		for (std::size_t v : _sensBlocksSkipped)
+			n += v;
+		return n;
+	}
+
+	/**
+	 * @brief Returns the number of skipped unit operation linear solves
+	 * @details A linear solve of a unit operation is skipped if its right hand side is zero,
+	 *          which is the case for structurally zero sensitivities.
+	 * @return Number of skipped linear solves since the start of the simulation
+	 */
+	inline std::size_t numSkippedLinearSolves() const CADET_NOEXCEPT
+	{
+		std::size_t n = 0;
+		for (std::size_t v : _linSolvesSkipped)
+			n += v;
+		return n;
+	}
+
 #ifdef CADET_BENCHMARK_MODE
 	virtual std::vector<double> benchmarkTimings() const
 	{
@@ -173,7 +252,6 @@ public:
 #endif
 
 	void multiplyWithJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, double const* yS, double alpha, double beta, double* ret);
-	void multiplyWithDerivativeJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, double const* yS, double* ret);
 
 #ifdef CADET_DEBUG
 	void genJacobian(const SimulationTime& simTime, const ConstSimulationState& simState);
@@ -195,13 +273,31 @@ protected:
 	int schurComplementMatrixVector(double const* x, double* z, double t, double alpha, double outerTol, double const* const weight,
 		const ConstSimulationState& simState) const;
 
+	/**
+	 * @brief Determines whether the linear solve of a unit operation can be skipped
+	 * @details The solution of a linear system with zero right hand side is zero. This is the case
+	 *          for structurally zero sensitivities, which are not identified by IDAS. Hence, the check
+	 *          is only performed if sensitivity pruning is active. Skipped solves are counted.
+	 * @param [in] idxUnit Index of the unit operation
+	 * @param [in] rhs Right hand side of the unit operation
+	 * @return @c true if the right hand side is zero, otherwise @c false
+	 */
+	inline bool skipLinearSolve(unsigned int idxUnit, double const* rhs) const
+	{
+		if (_sensNonzero.empty() || std::any_of(rhs, rhs + _dofs[idxUnit], [](double v) { return v != 0.0; }))
+			return false;
+
+		++_linSolvesSkipped[idxUnit];
+		return true;
+	}
+
 	void configureSwitches(IParameterProvider& paramProvider);
 
 	template <typename StateType, typename ResidualType, typename ParamType>
 	void residualConnectUnitOps(unsigned int secIdx, StateType const* const y, double const* const yDot, ResidualType* const res) CADET_NOEXCEPT;
 	void solveCouplingDOF(double * const vec);
 
-	void multiplyWithMacroJacobian(double const* yS, double alpha, double beta, double* ret);
+	void multiplyWithMacroJacobian(double const* yS, double alpha, double beta, double* ret, char const* nonzeroUnits = nullptr);
 	inline void multiplyWithMacroJacobian(double const* yS, double* ret)
 	{
 		multiplyWithMacroJacobian(yS, 1.0, 0.0, ret);
@@ -210,6 +306,61 @@ protected:
 	int dResDpFwdWithJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, const AdJacobianParams& adJac);
 
 	void readLinearSolutionMode(IParameterProvider& paramProvider);
+	void readThreadBudgetMode(IParameterProvider& paramProvider);
+	void updateSensitivityPruning(unsigned int secIdx);
+	void resetSensitivityPruning();
+	void assignThreadBudgets(const std::vector<double>& weights);
+	void rebalanceThreadBudgets();
+
+	/**
+	 * @brief Executes the given function for each unit operation in parallel
+	 * @details If hierarchical parallelization is enabled, each unit operation is executed in
+	 *          its own task arena whose concurrency is limited by the unit's thread budget.
+	 *          Internal parallelization of the unit operation is confined to this arena, which
+	 *          prevents both levels from competing for the same threads. The wall time of each
+	 *          unit operation is recorded for load balancing and utilization reports.
+	 *
+	 *          Otherwise, all unit operations share the global arena and thread local storage.
+	 * @param [in] f Function with signature <tt>void(unsigned int idxUnit, util::ThreadLocalStorage& tls)</tt>
+	 * @tparam Func_t Type of the function
+	 */
+	template <typename Func_t>
+	void forEachUnitOperation(Func_t f)
+	{
+		if (_unitThreads.empty())
+		{
+#ifdef CADET_PARALLELIZE
+			tbb::parallel_for(size_t(0), _models.size(), [&](size_t i)
+#else
+			for (unsigned int i = 0; i < _models.size(); ++i)
+#endif
+			{
+				f(i, _threadLocalStorage);
+			} CADET_PARFOR_END;
+			return;
+		}
+
+		Timer wallTimer;
+		wallTimer.start();
+
+#ifdef CADET_PARALLELIZE
+		tbb::parallel_for(size_t(0), _models.size(), [&](size_t i)
+#else
+		for (unsigned int i = 0; i < _models.size(); ++i)
+#endif
+		{
+			Timer unitTimer;
+			unitTimer.start();
+#ifdef CADET_PARALLELIZE
+			_unitArenas[i]->execute([&]() { f(i, _unitThreadLocalStorage[i]); });
+#else
+			f(i, _unitThreadLocalStorage[i]);
+#endif
+			_unitBusyTime[i] += unitTimer.stop();
+		} CADET_PARFOR_END;
+
+		_unitWallTime += wallTimer.stop();
+	}
 	void rebuildInternalDataStructures();
 	void allocateSuperStructMatrices();
 	void assembleSuperStructMatrices(unsigned int secIdx);
@@ -274,8 +425,17 @@ protected:
 	std::unordered_map<ParameterId, active*> _parameters; //!< Provides access to all parameters
 	std::unordered_set<active*> _sensParams; //!< Holds all parameters with activated AD directions
 
+	bool _sensPruning; //!< Determines whether structurally zero sensitivity blocks are skipped
+	std::vector<char> _sensOwner; //!< Marks the unit operations owning the parameters of each sensitivity (sensitivity-major)
+	std::vector<char> _sensNonzero; //!< Marks the unit operations in which each sensitivity may be nonzero (sensitivity-major, empty if unknown)
+	int _sensPruningSec; //!< Section index of the last update of _sensNonzero (@c -1 if none)
+	std::vector<char> _unitSensNonzero; //!< Marks the unit operations in which at least one sensitivity may be nonzero
+	std::vector<std::size_t> _sensBlocksSkipped; //!< Number of skipped sensitivity residual blocks of each unit operation
+	mutable std::vector<std::size_t> _linSolvesSkipped; //!< Number of skipped linear solves of each unit operation
+
 	linalg::Gmres _gmres; //!< GMRES algorithm for the Schur-complement in linearSolve()
 	double _schurSafety; //!< Safety factor for Schur-complement solution
+	bool _adaptiveLinearTol; //!< Determines whether the tolerance passed to linearSolve() is a forcing term
 
 	std::vector<unsigned int> _inOutModels; //!< Indices of unit operation models in _models that have inlet and outlet
 
@@ -284,6 +444,18 @@ protected:
 
 	util::ThreadLocalStorage _threadLocalStorage; //!< Local storage for each thread
 
+	int _threadBudgetMode; //!< Hierarchical parallelization mode (0: disabled, 1: budgets by DOF, 2: budgets by DOF and measured cost)
+	unsigned int _numThreads; //!< Total number of threads available to the model system
+	std::vector<unsigned int> _unitThreads; //!< Thread budget of each unit operation (empty if hierarchical parallelization is disabled)
+	std::vector<util::ThreadLocalStorage> _unitThreadLocalStorage; //!< Local storage for each thread of each unit operation's arena
+	std::vector<double> _unitBusyTime; //!< Wall time spent in each unit operation since the last rebalancing
+	std::vector<double> _unitBusyTimeTotal; //!< Wall time spent in each unit operation since the start of the simulation
+	double _unitWallTime; //!< Wall time of scheduled parallel regions since the last rebalancing
+	double _unitWallTimeTotal; //!< Wall time of scheduled parallel regions since the start of the simulation
+#ifdef CADET_PARALLELIZE
+	std::vector<std::unique_ptr<tbb::task_arena>> _unitArenas; //!< Task arena of each unit operation
+#endif
+
 #ifdef CADET_PARALLELIZE
 	typedef tbb::spin_mutex SchurComplementMutex;
 	mutable SchurComplementMutex _schurMutex;
@@ -107,6 +107,11 @@ bool OutletModel::setParameter(const ParameterId& pId, bool value)
 	return false;
 }
 
+bool OutletModel::resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage)
+{
+	return true;
+}
+
 void OutletModel::setSensitiveParameterValue(const ParameterId& pId, double value)
 {
 }
@@ -185,6 +190,9 @@ int OutletModel::residualSensFwdCombine(const SimulationTime& simTime, const Con
 	// Directional derivative (dF / dy) * s does nothing since dF / dy = I (identity)
 	for (unsigned int param = 0; param < resS.size(); ++param)
 	{
+		if (!yS[param])
+			continue;
+
 		double const* const y = yS[param];
 		double* const res = resS[param];
 		std::copy(y, y + _nComp, res);
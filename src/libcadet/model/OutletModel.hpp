@@ -77,6 +77,7 @@ public:
 
 	virtual bool setSensitiveParameter(const ParameterId& pId, unsigned int adDirection, double adValue);
 	virtual void setSensitiveParameterValue(const ParameterId& id, double value);
+	virtual bool resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage);
 
 	virtual void clearSensParams();
 	virtual unsigned int numSensParams() const;
@@ -99,6 +100,8 @@ public:
 	// linearSolve and assembleAndPrepareDAEJacobian are null operations since there are only inlet DOFs, which are treated by ModelSystem
 	virtual int linearSolve(double t, double alpha, double tol, double* const rhs, double const* const weight,
 		const ConstSimulationState& simState) { return 0; }
+	virtual void setAdaptiveLinearSolverTolerance(bool adaptive) CADET_NOEXCEPT { }
+	virtual unsigned long numLinearSolverIterations() const CADET_NOEXCEPT { return 0; }
 
 	virtual void prepareADvectors(const AdJacobianParams& adJac) const;
 
@@ -0,0 +1,920 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "model/StirredTankArrayModel.hpp"
+#include "ParamReaderHelper.hpp"
+#include "cadet/Exceptions.hpp"
+#include "cadet/SolutionRecorder.hpp"
+#include "SimulationTypes.hpp"
+#include "ParallelSupport.hpp"
+#include "linalg/DenseMatrix.hpp"
+
+#ifdef SUPERLU_FOUND
+	#include "linalg/SuperLUSparseMatrix.hpp"
+#endif
+#ifdef UMFPACK_FOUND
+	#include "linalg/UMFPackSparseMatrix.hpp"
+#endif
+
+#include "ConfigurationHelper.hpp"
+#include "AdUtils.hpp"
+
+#include "LoggingUtils.hpp"
+#include "Logging.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <string>
+
+namespace cadet
+{
+
+namespace model
+{
+
+/**
+ * @brief Solver for the tank block @f$ \alpha \operatorname{diag}(V) + J @f$ of a single component
+ */
+class CSTRArrayModel::LinearSolver
+{
+public:
+
+	virtual ~LinearSolver() CADET_NOEXCEPT { }
+
+	virtual void setSparsityPattern(const linalg::SparsityPattern& pattern) = 0;
+	virtual void assemble(const linalg::CompressedSparseMatrix& jac, double alpha, const std::vector<active>& volume) = 0;
+	virtual bool factorize() = 0;
+	virtual bool solve(double* rhs) const = 0;
+};
+
+#if defined(UMFPACK_FOUND) || defined(SUPERLU_FOUND)
+
+	template <typename sparse_t>
+	class CSTRArrayModel::SparseDirectSolver : public CSTRArrayModel::LinearSolver
+	{
+	public:
+
+		SparseDirectSolver() { }
+		virtual ~SparseDirectSolver() CADET_NOEXCEPT { }
+
+		virtual void setSparsityPattern(const linalg::SparsityPattern& pattern)
+		{
+			_mat.assignPattern(pattern);
+			_mat.prepare();
+		}
+
+		virtual void assemble(const linalg::CompressedSparseMatrix& jac, double alpha, const std::vector<active>& volume)
+		{
+			_mat.copyFromSamePattern(jac);
+
+			for (unsigned int i = 0; i < jac.rows(); ++i)
+				_mat.centered(i, 0) += alpha * static_cast<double>(volume[i]);
+		}
+
+		virtual bool factorize()
+		{
+			return _mat.factorize();
+		}
+
+		virtual bool solve(double* rhs) const
+		{
+			return _mat.solve(rhs);
+		}
+
+	protected:
+		sparse_t _mat;
+	};
+
+#endif
+
+class CSTRArrayModel::DenseDirectSolver : public CSTRArrayModel::LinearSolver
+{
+public:
+
+	DenseDirectSolver() { }
+	virtual ~DenseDirectSolver() CADET_NOEXCEPT { }
+
+	virtual void setSparsityPattern(const linalg::SparsityPattern& pattern)
+	{
+		_mat.resize(pattern.rows(), pattern.rows());
+	}
+
+	virtual void assemble(const linalg::CompressedSparseMatrix& jac, double alpha, const std::vector<active>& volume)
+	{
+		_mat.setAll(0.0);
+
+		for (unsigned int i = 0; i < jac.rows(); ++i)
+		{
+			linalg::sparse_int_t const* const colIdx = jac.columnIndicesOfRow(i);
+			double const* const vals = jac.valuesOfRow(i);
+			const int nnz = jac.numNonZerosInRow(i);
+
+			// Copy row from sparse matrix to dense matrix
+			for (int c = 0; c < nnz; ++c)
+				_mat.native(i, colIdx[c]) = vals[c];
+
+			// Add time derivative
+			_mat.native(i, i) += alpha * static_cast<double>(volume[i]);
+		}
+	}
+
+	virtual bool factorize()
+	{
+		return _mat.factorize();
+	}
+
+	virtual bool solve(double* rhs) const
+	{
+		return _mat.solve(rhs);
+	}
+
+protected:
+	linalg::DenseMatrix _mat;
+};
+
+
+CSTRArrayModel::CSTRArrayModel(UnitOpIdx unitOpIdx) : UnitOperationBase(unitOpIdx), _nComp(0), _nTank(0), _linearSolver(nullptr), _factorizeJac(false),
+	_initConditions(0), _initConditionsDot(0)
+{
+}
+
+CSTRArrayModel::~CSTRArrayModel() CADET_NOEXCEPT
+{
+	delete _linearSolver;
+}
+
+unsigned int CSTRArrayModel::numDofs() const CADET_NOEXCEPT
+{
+	// Inlet, outlet, and tanks
+	return 2 * _nComp + _nTank * _nComp;
+}
+
+unsigned int CSTRArrayModel::numPureDofs() const CADET_NOEXCEPT
+{
+	return _nComp + _nTank * _nComp;
+}
+
+bool CSTRArrayModel::usesAD() const CADET_NOEXCEPT
+{
+	// The model is linear in the state, so its Jacobian is always computed analytically
+	return false;
+}
+
+unsigned int CSTRArrayModel::requiredADdirs() const CADET_NOEXCEPT
+{
+	return 0;
+}
+
+void CSTRArrayModel::setFlowRates(active const* in, active const* out) CADET_NOEXCEPT
+{
+	_flowRateIn = in[0];
+}
+
+bool CSTRArrayModel::configureModelDiscretization(IParameterProvider& paramProvider, IConfigHelper& helper)
+{
+	_nComp = paramProvider.getInt("NCOMP");
+
+	const int nTank = paramProvider.getInt("NTANK");
+	if (nTank < 1)
+		throw InvalidParameterException("Field NTANK has to be positive");
+
+	_nTank = nTank;
+
+	_initConditions.resize(numPureDofs());
+	_initConditionsDot.resize(numPureDofs(), 0.0);
+	_outletWeight.resize(_nTank, 0.0);
+	_solveBuffer.resize(_nTank * _nComp, 0.0);
+
+	delete _linearSolver;
+	_linearSolver = nullptr;
+
+	if (paramProvider.exists("LINEAR_SOLVER"))
+	{
+		const std::string sol = paramProvider.getString("LINEAR_SOLVER");
+		if (sol == "DENSE")
+			_linearSolver = new DenseDirectSolver();
+#ifdef UMFPACK_FOUND
+		else if (sol == "UMFPACK")
+			_linearSolver = new SparseDirectSolver<linalg::UMFPackSparseMatrix>();
+#endif
+#ifdef SUPERLU_FOUND
+		else if (sol == "SUPERLU")
+			_linearSolver = new SparseDirectSolver<linalg::SuperLUSparseMatrix>();
+#endif
+		else
+			throw InvalidParameterException("Unknown linear solver " + sol + " in field LINEAR_SOLVER");
+	}
+
+	// Default to sparse solver if available (preferably UMFPACK), fall back to dense
+	if (!_linearSolver)
+	{
+#if defined(UMFPACK_FOUND)
+		_linearSolver = new SparseDirectSolver<linalg::UMFPackSparseMatrix>();
+#elif defined(SUPERLU_FOUND)
+		_linearSolver = new SparseDirectSolver<linalg::SuperLUSparseMatrix>();
+#else
+		_linearSolver = new DenseDirectSolver();
+
+		// Dense LU requires O(NTANK^3) operations per factorization (about 13 ms for 512 tanks)
+		if (_nTank > 256)
+			LOG(Warning) << "CSTR_ARRAY with " << _nTank << " tanks falls back to dense LU since CADET has been built without UMFPACK and SuperLU, expect slow factorizations";
+#endif
+	}
+
+	return true;
+}
+
+bool CSTRArrayModel::configure(IParameterProvider& paramProvider)
+{
+	readScalarParameterOrArray(_volume, paramProvider, "TANK_VOLUME", _nTank);
+	if ((_volume.size() == 1) && (_nTank > 1))
+	{
+		const active vol = _volume[0];
+		_volume.resize(_nTank, vol);
+	}
+	if (_volume.size() != _nTank)
+		throw InvalidParameterException("Number of elements in field TANK_VOLUME does not match NTANK");
+
+	if (paramProvider.exists("INLET_DISTRIBUTION"))
+	{
+		readScalarParameterOrArray(_inletDistribution, paramProvider, "INLET_DISTRIBUTION", 1);
+		if (_inletDistribution.size() != _nTank)
+			throw InvalidParameterException("Number of elements in field INLET_DISTRIBUTION does not match NTANK");
+
+		const double distSum = std::accumulate(_inletDistribution.begin(), _inletDistribution.end(), 0.0,
+			[](double a, const active& b) -> double { return a + static_cast<double>(b); });
+		if (std::abs(1.0 - distSum) > 1e-10)
+			throw InvalidParameterException("Sum of field INLET_DISTRIBUTION differs from 1.0 (is " + std::to_string(distSum) + ")");
+	}
+	else
+	{
+		// Feed everything into the first tank
+		_inletDistribution.clear();
+		_inletDistribution.resize(_nTank, 0.0);
+		_inletDistribution[0] = 1.0;
+	}
+
+	// Tank i depends on itself and on all tanks that feed into it
+	linalg::SparsityPattern pattern(_nTank, 2);
+	for (unsigned int i = 0; i < _nTank; ++i)
+		pattern.add(i, i);
+
+	// Internal connections are given as rows of (source tank, target tank, flow rate)
+	_connSource.clear();
+	_connTarget.clear();
+	_connFlowRate.clear();
+	if (paramProvider.exists("TANK_CONNECTIONS"))
+	{
+		const std::vector<double> conn = paramProvider.getDoubleArray("TANK_CONNECTIONS");
+		if (conn.size() % 3 != 0)
+			throw InvalidParameterException("Number of elements in field TANK_CONNECTIONS is not a multiple of 3");
+
+		const unsigned int nConn = conn.size() / 3;
+		_connSource.reserve(nConn);
+		_connTarget.reserve(nConn);
+		_connFlowRate.reserve(nConn);
+
+		for (unsigned int k = 0; k < nConn; ++k)
+		{
+			const int source = static_cast<int>(conn[3 * k]);
+			const int target = static_cast<int>(conn[3 * k + 1]);
+			const double flowRate = conn[3 * k + 2];
+
+			if ((source < 0) || (source >= static_cast<int>(_nTank)) || (target < 0) || (target >= static_cast<int>(_nTank)))
+				throw InvalidParameterException("Tank index out of range in row " + std::to_string(k) + " of TANK_CONNECTIONS");
+			if (source == target)
+				throw InvalidParameterException("Tank " + std::to_string(source) + " is connected to itself in row " + std::to_string(k) + " of TANK_CONNECTIONS");
+			if (flowRate < 0.0)
+				throw InvalidParameterException("Negative flow rate in row " + std::to_string(k) + " of TANK_CONNECTIONS");
+
+			if (pattern.isNonZero(target, source))
+				throw InvalidParameterException("Duplicate connection from tank " + std::to_string(source) + " to tank " + std::to_string(target) + " in TANK_CONNECTIONS");
+
+			pattern.add(target, source);
+			_connSource.push_back(source);
+			_connTarget.push_back(target);
+			_connFlowRate.push_back(flowRate);
+		}
+	}
+
+	_jac.assignPattern(pattern);
+	_linearSolver->setSparsityPattern(pattern);
+
+	_parameters.clear();
+	registerParam1DArray(_parameters, _volume, [=](bool multi, unsigned int tank) { return makeParamId(hashString("TANK_VOLUME"), _unitOpIdx, CompIndep, tank, BoundStateIndep, ReactionIndep, SectionIndep); });
+	registerParam1DArray(_parameters, _inletDistribution, [=](bool multi, unsigned int tank) { return makeParamId(hashString("INLET_DISTRIBUTION"), _unitOpIdx, CompIndep, tank, BoundStateIndep, ReactionIndep, SectionIndep); });
+
+	// Connection flow rates use the particle type index for the source and the bound state index for the target tank
+	for (std::size_t k = 0; k < _connFlowRate.size(); ++k)
+		_parameters[makeParamId(hashString("TANK_CONNECTION"), _unitOpIdx, CompIndep, _connSource[k], _connTarget[k], ReactionIndep, SectionIndep)] = &_connFlowRate[k];
+
+	// Register initial conditions parameters
+	for (unsigned int tank = 0; tank < _nTank; ++tank)
+	{
+		for (unsigned int i = 0; i < _nComp; ++i)
+			_parameters[makeParamId(hashString("INIT_C"), _unitOpIdx, i, tank, BoundStateIndep, ReactionIndep, SectionIndep)] = _initConditions.data() + _nComp + tank * _nComp + i;
+	}
+
+	return true;
+}
+
+unsigned int CSTRArrayModel::threadLocalMemorySize() const CADET_NOEXCEPT
+{
+	LinearMemorySizer lms;
+
+	// Memory for residualImpl()
+	lms.add<active>(_nTank);
+	lms.add<active>(_nTank);
+	lms.commit();
+
+	return lms.bufferSize();
+}
+
+void CSTRArrayModel::notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, const AdJacobianParams& adJac)
+{
+	// Flow rates may have changed
+	updateOutletWeights();
+	_factorizeJac = true;
+
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		if (_outletWeight[i] < -1e-10)
+			throw InvalidParameterException("Flow rates of unit " + std::to_string(_unitOpIdx) + " lead to negative outflow of tank " + std::to_string(i));
+	}
+}
+
+void CSTRArrayModel::reportSolution(ISolutionRecorder& recorder, double const* const solution) const
+{
+	Exporter expr(_nComp, _nTank, solution);
+	recorder.beginUnitOperation(_unitOpIdx, *this, expr);
+	recorder.endUnitOperation();
+}
+
+void CSTRArrayModel::reportSolutionStructure(ISolutionRecorder& recorder) const
+{
+	Exporter expr(_nComp, _nTank, nullptr);
+	recorder.unitOperationStructure(_unitOpIdx, *this, expr);
+}
+
+void CSTRArrayModel::applyInitialCondition(const SimulationState& simState) const
+{
+	// Inlet DOFs
+	std::fill(simState.vecStateY, simState.vecStateY + _nComp, 0.0);
+	std::fill(simState.vecStateYdot, simState.vecStateYdot + _nComp, 0.0);
+
+	const unsigned int nDof = numPureDofs();
+	ad::copyFromAd(_initConditions.data(), simState.vecStateY + _nComp, nDof);
+
+	std::copy(_initConditionsDot.data(), _initConditionsDot.data() + nDof, simState.vecStateYdot + _nComp);
+}
+
+void CSTRArrayModel::readInitialCondition(IParameterProvider& paramProvider)
+{
+	// Clear time derivative
+	std::fill(_initConditionsDot.begin(), _initConditionsDot.end(), 0.0);
+
+	// Check if INIT_STATE is present
+	if (paramProvider.exists("INIT_STATE"))
+	{
+		const unsigned int nDof = numPureDofs();
+		const std::vector<double> initState = paramProvider.getDoubleArray("INIT_STATE");
+
+		ad::copyToAd(initState.data(), _initConditions.data(), nDof);
+
+		// Check if INIT_STATE contains the full state and its time derivative
+		if (initState.size() >= 2 * nDof)
+			std::copy(initState.data() + nDof, initState.data() + 2 * nDof, _initConditionsDot.data());
+
+		return;
+	}
+
+	const std::vector<double> initC = paramProvider.getDoubleArray("INIT_C");
+
+	// Outlet is determined by consistent initialization
+	ad::fillAd(_initConditions.data(), _nComp, 0.0);
+
+	active* const initTank = _initConditions.data() + _nComp;
+	if (initC.size() >= _nTank * _nComp)
+	{
+		ad::copyToAd(initC.data(), initTank, _nTank * _nComp);
+	}
+	else if (initC.size() >= _nComp)
+	{
+		// Same initial concentrations in all tanks
+		for (unsigned int tank = 0; tank < _nTank; ++tank)
+			ad::copyToAd(initC.data(), initTank + tank * _nComp, _nComp);
+	}
+	else
+		throw InvalidParameterException("INIT_C does not contain enough values for all components");
+}
+
+/**
+ * @brief Computes the total inflow and the outflow to the unit outlet of each tank
+ * @param [out] inflow Total volumetric flow rate entering each tank
+ * @param [out] outflow Volumetric flow rate leaving each tank towards the unit outlet
+ * @tparam ParamType Type of the parameters
+ */
+template <typename ParamType>
+void CSTRArrayModel::tankFlowRates(ParamType* const inflow, ParamType* const outflow) const
+{
+	const ParamType flowIn = static_cast<ParamType>(_flowRateIn);
+	for (unsigned int i = 0; i < _nTank; ++i)
+		inflow[i] = static_cast<ParamType>(_inletDistribution[i]) * flowIn;
+
+	for (std::size_t k = 0; k < _connFlowRate.size(); ++k)
+		inflow[_connTarget[k]] += static_cast<ParamType>(_connFlowRate[k]);
+
+	std::copy(inflow, inflow + _nTank, outflow);
+
+	for (std::size_t k = 0; k < _connFlowRate.size(); ++k)
+		outflow[_connSource[k]] -= static_cast<ParamType>(_connFlowRate[k]);
+}
+
+/**
+ * @brief Updates the contribution of each tank to the mixed outlet stream
+ * @details If no liquid leaves the unit, the outlet reports the volume-averaged concentration.
+ */
+void CSTRArrayModel::updateOutletWeights()
+{
+	const double flowIn = static_cast<double>(_flowRateIn);
+	for (unsigned int i = 0; i < _nTank; ++i)
+		_outletWeight[i] = static_cast<double>(_inletDistribution[i]) * flowIn;
+
+	for (std::size_t k = 0; k < _connFlowRate.size(); ++k)
+	{
+		const double q = static_cast<double>(_connFlowRate[k]);
+		_outletWeight[_connTarget[k]] += q;
+		_outletWeight[_connSource[k]] -= q;
+	}
+
+	const double totalOutflow = std::accumulate(_outletWeight.begin(), _outletWeight.end(), 0.0);
+	if (totalOutflow > 0.0)
+	{
+		for (unsigned int i = 0; i < _nTank; ++i)
+			_outletWeight[i] /= totalOutflow;
+	}
+	else
+	{
+		const double totalVolume = std::accumulate(_volume.begin(), _volume.end(), 0.0,
+			[](double a, const active& b) -> double { return a + static_cast<double>(b); });
+		for (unsigned int i = 0; i < _nTank; ++i)
+			_outletWeight[i] = static_cast<double>(_volume[i]) / totalVolume;
+	}
+}
+
+int CSTRArrayModel::residual(const SimulationTime& simTime, const ConstSimulationState& simState, double* const res, util::ThreadLocalStorage& threadLocalMem)
+{
+	return residualImpl<double, double, false>(simTime.t, simTime.secIdx, simState.vecStateY, simState.vecStateYdot, res, threadLocalMem.get());
+}
+
+int CSTRArrayModel::residual(const SimulationTime& simTime, const ConstSimulationState& simState, double* const res,
+	const AdJacobianParams& adJac, util::ThreadLocalStorage& threadLocalMem, bool updateJacobian, bool paramSensitivity)
+{
+	if (updateJacobian)
+		_factorizeJac = true;
+
+	if (paramSensitivity)
+	{
+		const int retCode = updateJacobian ? residualImpl<active, active, true>(simTime.t, simTime.secIdx, simState.vecStateY, simState.vecStateYdot, adJac.adRes, threadLocalMem.get())
+			: residualImpl<active, active, false>(simTime.t, simTime.secIdx, simState.vecStateY, simState.vecStateYdot, adJac.adRes, threadLocalMem.get());
+
+		// Copy AD residuals to original residuals vector
+		if (res)
+			ad::copyFromAd(adJac.adRes, res, numDofs());
+
+		return retCode;
+	}
+
+	if (updateJacobian)
+		return residualImpl<double, double, true>(simTime.t, simTime.secIdx, simState.vecStateY, simState.vecStateYdot, res, threadLocalMem.get());
+
+	return residualImpl<double, double, false>(simTime.t, simTime.secIdx, simState.vecStateY, simState.vecStateYdot, res, threadLocalMem.get());
+}
+
+template <typename ResidualType, typename ParamType, bool wantJac>
+int CSTRArrayModel::residualImpl(double t, unsigned int secIdx, double const* const y, double const* const yDot, ResidualType* const res, LinearBufferAllocator tlmAlloc)
+{
+	double const* const cIn = y;
+	double const* const cOut = y + _nComp;
+	double const* const c = y + 2 * _nComp;
+	double const* const cDot = yDot ? yDot + 2 * _nComp : nullptr;
+
+	BufferedArray<ParamType> inflowBuffer = tlmAlloc.array<ParamType>(_nTank);
+	BufferedArray<ParamType> outflowBuffer = tlmAlloc.array<ParamType>(_nTank);
+	ParamType* const inflow = static_cast<ParamType*>(inflowBuffer);
+	ParamType* const outflow = static_cast<ParamType*>(outflowBuffer);
+	tankFlowRates(inflow, outflow);
+
+	// Inlet DOF
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		res[i] = cIn[i];
+	}
+
+	// Tanks: V_i * dc_i / dt - f_i * F_in * c_in + (f_i * F_in + sum_k Q_{k->i}) * c_i - sum_k Q_{k->i} * c_k
+	// All loops run over the components in the innermost position, which is contiguous in memory
+	const ParamType flowIn = static_cast<ParamType>(_flowRateIn);
+	ResidualType* const resTank = res + 2 * _nComp;
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		const ParamType feed = static_cast<ParamType>(_inletDistribution[i]) * flowIn;
+		double const* const ci = c + i * _nComp;
+		ResidualType* const ri = resTank + i * _nComp;
+
+		if (cadet_likely(cDot))
+		{
+			const ParamType vol = static_cast<ParamType>(_volume[i]);
+			double const* const ciDot = cDot + i * _nComp;
+			for (unsigned int j = 0; j < _nComp; ++j)
+				ri[j] = vol * ciDot[j] + inflow[i] * ci[j] - feed * cIn[j];
+		}
+		else
+		{
+			for (unsigned int j = 0; j < _nComp; ++j)
+				ri[j] = inflow[i] * ci[j] - feed * cIn[j];
+		}
+	}
+
+	for (std::size_t k = 0; k < _connFlowRate.size(); ++k)
+	{
+		const ParamType q = static_cast<ParamType>(_connFlowRate[k]);
+		double const* const cs = c + _connSource[k] * _nComp;
+		ResidualType* const rt = resTank + _connTarget[k] * _nComp;
+		for (unsigned int j = 0; j < _nComp; ++j)
+			rt[j] -= q * cs[j];
+	}
+
+	// Outlet: c_out - sum_i w_i * c_i with w_i = F_{out,i} / sum_k F_{out,k}
+	ResidualType* const resOut = res + _nComp;
+	for (unsigned int j = 0; j < _nComp; ++j)
+		resOut[j] = cOut[j];
+
+	ParamType totalOutflow = 0.0;
+	for (unsigned int i = 0; i < _nTank; ++i)
+		totalOutflow += outflow[i];
+
+	if (static_cast<double>(totalOutflow) > 0.0)
+	{
+		for (unsigned int i = 0; i < _nTank; ++i)
+		{
+			const ParamType w = outflow[i] / totalOutflow;
+			double const* const ci = c + i * _nComp;
+			for (unsigned int j = 0; j < _nComp; ++j)
+				resOut[j] -= w * ci[j];
+		}
+	}
+	else
+	{
+		// No liquid leaves the unit, report volume-averaged concentration
+		ParamType totalVolume = 0.0;
+		for (unsigned int i = 0; i < _nTank; ++i)
+			totalVolume += static_cast<ParamType>(_volume[i]);
+
+		for (unsigned int i = 0; i < _nTank; ++i)
+		{
+			const ParamType w = static_cast<ParamType>(_volume[i]) / totalVolume;
+			double const* const ci = c + i * _nComp;
+			for (unsigned int j = 0; j < _nComp; ++j)
+				resOut[j] -= w * ci[j];
+		}
+	}
+
+	if (wantJac)
+	{
+		// The Jacobian of the tank block is identical for all components
+		_jac.setAll(0.0);
+		for (unsigned int i = 0; i < _nTank; ++i)
+			_jac(i, i) = static_cast<double>(inflow[i]);
+
+		for (std::size_t k = 0; k < _connFlowRate.size(); ++k)
+			_jac(_connTarget[k], _connSource[k]) -= static_cast<double>(_connFlowRate[k]);
+
+		updateOutletWeights();
+	}
+
+	return 0;
+}
+
+int CSTRArrayModel::residualWithJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, double* const res, const AdJacobianParams& adJac, util::ThreadLocalStorage& threadLocalMem)
+{
+	return residual(simTime, simState, res, adJac, threadLocalMem, true, false);
+}
+
+int CSTRArrayModel::residualSensFwdAdOnly(const SimulationTime& simTime, const ConstSimulationState& simState, active* const adRes, util::ThreadLocalStorage& threadLocalMem)
+{
+	// Evaluate residual for all parameters using AD in vector mode
+	return residualImpl<active, active, false>(simTime.t, simTime.secIdx, simState.vecStateY, simState.vecStateYdot, adRes, threadLocalMem.get());
+}
+
+int CSTRArrayModel::residualSensFwdWithJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, const AdJacobianParams& adJac, util::ThreadLocalStorage& threadLocalMem)
+{
+	// Evaluate residual for all parameters using AD in vector mode and at the same time update the Jacobian
+	return residual(simTime, simState, nullptr, adJac, threadLocalMem, true, true);
+}
+
+void CSTRArrayModel::consistentInitialState(const SimulationTime& simTime, double* const vecStateY, const AdJacobianParams& adJac, double errorTol, util::ThreadLocalStorage& threadLocalMem)
+{
+	// All tank concentrations are dynamic, only the outlet mixing equation is algebraic
+	updateOutletWeights();
+
+	double* const cOut = vecStateY + _nComp;
+	double const* const c = vecStateY + 2 * _nComp;
+
+	std::fill_n(cOut, _nComp, 0.0);
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		double const* const ci = c + i * _nComp;
+		for (unsigned int j = 0; j < _nComp; ++j)
+			cOut[j] += _outletWeight[i] * ci[j];
+	}
+}
+
+void CSTRArrayModel::leanConsistentInitialState(const SimulationTime& simTime, double* const vecStateY, const AdJacobianParams& adJac, double errorTol, util::ThreadLocalStorage& threadLocalMem)
+{
+	consistentInitialState(simTime, vecStateY, adJac, errorTol, threadLocalMem);
+}
+
+void CSTRArrayModel::consistentInitialTimeDerivative(const SimulationTime& simTime, double const* vecStateY, double* const vecStateYdot, util::ThreadLocalStorage& threadLocalMem)
+{
+	// Note that the residual has not been negated, yet. We will do that now.
+	for (unsigned int i = 0; i < numDofs(); ++i)
+		vecStateYdot[i] = -vecStateYdot[i];
+
+	double* const cOutDot = vecStateYdot + _nComp;
+	double* const cDot = vecStateYdot + 2 * _nComp;
+
+	// Tanks: V_i * dc_i / dt = -res_i
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		const double invV = 1.0 / static_cast<double>(_volume[i]);
+		double* const ciDot = cDot + i * _nComp;
+		for (unsigned int j = 0; j < _nComp; ++j)
+			ciDot[j] *= invV;
+	}
+
+	// Outlet: Time derivative of the mixing equation
+	std::fill_n(cOutDot, _nComp, 0.0);
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		double const* const ciDot = cDot + i * _nComp;
+		for (unsigned int j = 0; j < _nComp; ++j)
+			cOutDot[j] += _outletWeight[i] * ciDot[j];
+	}
+}
+
+void CSTRArrayModel::leanConsistentInitialTimeDerivative(double t, double const* const vecStateY, double* const vecStateYdot, double* const res, util::ThreadLocalStorage& threadLocalMem)
+{
+	double* const cOutDot = vecStateYdot + _nComp;
+	double* const cDot = vecStateYdot + 2 * _nComp;
+	double const* const resTank = res + 2 * _nComp;
+
+	// Tanks: V_i * dc_i / dt = -res_i
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		const double invV = 1.0 / static_cast<double>(_volume[i]);
+		double* const ciDot = cDot + i * _nComp;
+		double const* const ri = resTank + i * _nComp;
+		for (unsigned int j = 0; j < _nComp; ++j)
+			ciDot[j] = -ri[j] * invV;
+	}
+
+	// Outlet: Time derivative of the mixing equation
+	std::fill_n(cOutDot, _nComp, 0.0);
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		double const* const ciDot = cDot + i * _nComp;
+		for (unsigned int j = 0; j < _nComp; ++j)
+			cOutDot[j] += _outletWeight[i] * ciDot[j];
+	}
+}
+
+void CSTRArrayModel::initializeSensitivityStates(const std::vector<double*>& vecSensY) const
+{
+	const unsigned int nDof = numPureDofs();
+	for (unsigned int param = 0; param < vecSensY.size(); ++param)
+	{
+		double* const sensY = vecSensY[param];
+		ad::copyFromAdDirection(_initConditions.data(), sensY + _nComp, nDof, param);
+	}
+}
+
+void CSTRArrayModel::consistentInitialSensitivity(const SimulationTime& simTime, const ConstSimulationState& simState,
+	std::vector<double*>& vecSensY, std::vector<double*>& vecSensYdot, active const* const adRes, util::ThreadLocalStorage& threadLocalMem)
+{
+	const unsigned int nTankDof = _nTank * _nComp;
+
+	for (unsigned int param = 0; param < vecSensY.size(); ++param)
+	{
+		double* const sensY = vecSensY[param];
+		double* const sensYdot = vecSensYdot[param];
+
+		double* const sOut = sensY + _nComp;
+		double const* const sTank = sensY + 2 * _nComp;
+		double* const sOutDot = sensYdot + _nComp;
+		double* const sTankDot = sensYdot + 2 * _nComp;
+
+		// Step 1: Solve algebraic outlet equations, s_out = sum_i w_i * s_i - dF_out / dp
+		for (unsigned int j = 0; j < _nComp; ++j)
+			sOut[j] = -adRes[_nComp + j].getADValue(param);
+
+		for (unsigned int i = 0; i < _nTank; ++i)
+		{
+			double const* const si = sTank + i * _nComp;
+			for (unsigned int j = 0; j < _nComp; ++j)
+				sOut[j] += _outletWeight[i] * si[j];
+		}
+
+		// Step 2: Compute the time derivative of the tank states, V_i * \dot{s}_i = -dF_i / dp - (dF_i / dy) * s
+
+		// Copy parameter derivative dF / dp from AD and negate it
+		for (unsigned int i = 0; i < nTankDof; ++i)
+			sTankDot[i] = -adRes[2 * _nComp + i].getADValue(param);
+
+		multiplyWithTankJacobian(sensY, -1.0, 1.0, sensYdot);
+
+		for (unsigned int i = 0; i < _nTank; ++i)
+		{
+			const double invV = 1.0 / static_cast<double>(_volume[i]);
+			double* const siDot = sTankDot + i * _nComp;
+			for (unsigned int j = 0; j < _nComp; ++j)
+				siDot[j] *= invV;
+		}
+
+		std::fill_n(sOutDot, _nComp, 0.0);
+		for (unsigned int i = 0; i < _nTank; ++i)
+		{
+			double const* const siDot = sTankDot + i * _nComp;
+			for (unsigned int j = 0; j < _nComp; ++j)
+				sOutDot[j] += _outletWeight[i] * siDot[j];
+		}
+	}
+}
+
+void CSTRArrayModel::leanConsistentInitialSensitivity(const SimulationTime& simTime, const ConstSimulationState& simState,
+	std::vector<double*>& vecSensY, std::vector<double*>& vecSensYdot, active const* const adRes, util::ThreadLocalStorage& threadLocalMem)
+{
+	consistentInitialSensitivity(simTime, simState, vecSensY, vecSensYdot, adRes, threadLocalMem);
+}
+
+/**
+ * @brief Computes @f$ r = \alpha J y + \beta r @f$ for the tank rows of the Jacobian
+ * @details The shared sparse tank Jacobian is applied to all components at once and the inlet
+ *          DOFs are mapped to the tanks.
+ * @param [in] yS Vector @f$ y @f$ with all DOFs of the unit operation
+ * @param [in] alpha Factor @f$ \alpha @f$ in front of @f$ J @f$
+ * @param [in] beta Factor @f$ \beta @f$ in front of @f$ r @f$
+ * @param [in,out] ret Vector @f$ r @f$ with all DOFs of the unit operation, only tank DOFs are touched
+ */
+void CSTRArrayModel::multiplyWithTankJacobian(double const* yS, double alpha, double beta, double* ret) const
+{
+	const double flowIn = static_cast<double>(_flowRateIn);
+	double const* const sIn = yS;
+	double const* const sTank = yS + 2 * _nComp;
+	double* const retTank = ret + 2 * _nComp;
+
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		double* const ri = retTank + i * _nComp;
+		const double feed = alpha * static_cast<double>(_inletDistribution[i]) * flowIn;
+		for (unsigned int j = 0; j < _nComp; ++j)
+			ri[j] = beta * ri[j] - feed * sIn[j];
+
+		linalg::sparse_int_t const* const colIdx = _jac.columnIndicesOfRow(i);
+		double const* const vals = _jac.valuesOfRow(i);
+		const int nnz = _jac.numNonZerosInRow(i);
+		for (int c = 0; c < nnz; ++c)
+		{
+			const double v = alpha * vals[c];
+			double const* const sk = sTank + colIdx[c] * _nComp;
+			for (unsigned int j = 0; j < _nComp; ++j)
+				ri[j] += v * sk[j];
+		}
+	}
+}
+
+void CSTRArrayModel::multiplyWithJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, double const* yS, double alpha, double beta, double* ret)
+{
+	// Inlet DOFs
+	for (unsigned int i = 0; i < _nComp; ++i)
+	{
+		ret[i] = alpha * yS[i] + beta * ret[i];
+	}
+
+	// Outlet: dRes / dc_out = I, dRes / dc_i = -w_i * I
+	double const* const sOut = yS + _nComp;
+	double const* const sTank = yS + 2 * _nComp;
+	double* const retOut = ret + _nComp;
+	for (unsigned int j = 0; j < _nComp; ++j)
+		retOut[j] = alpha * sOut[j] + beta * retOut[j];
+
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		const double w = alpha * _outletWeight[i];
+		double const* const si = sTank + i * _nComp;
+		for (unsigned int j = 0; j < _nComp; ++j)
+			retOut[j] -= w * si[j];
+	}
+
+	multiplyWithTankJacobian(yS, alpha, beta, ret);
+}
+
+void CSTRArrayModel::multiplyWithDerivativeJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, double const* sDot, double* ret)
+{
+	// Inlet and outlet DOFs are algebraic
+	std::fill_n(ret, 2 * _nComp, 0.0);
+
+	double const* const sTankDot = sDot + 2 * _nComp;
+	double* const retTank = ret + 2 * _nComp;
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		const double vol = static_cast<double>(_volume[i]);
+		for (unsigned int j = 0; j < _nComp; ++j)
+			retTank[i * _nComp + j] = vol * sTankDot[i * _nComp + j];
+	}
+}
+
+/**
+ * @brief Solves the tank block of the Jacobian for all components
+ * @details Each component is a separate right hand side for the same factorized matrix.
+ * @param [in,out] rhs On entry, right hand side in tank-major ordering; on exit, the solution
+ * @return @c true if all solves were successful, otherwise @c false
+ */
+bool CSTRArrayModel::solveTanks(double* const rhs) const
+{
+	// Transpose to component-major ordering such that each component is a contiguous vector
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		for (unsigned int j = 0; j < _nComp; ++j)
+			_solveBuffer[j * _nTank + i] = rhs[i * _nComp + j];
+	}
+
+	bool success = true;
+	for (unsigned int j = 0; j < _nComp; ++j)
+		success = _linearSolver->solve(_solveBuffer.data() + j * _nTank) && success;
+
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		for (unsigned int j = 0; j < _nComp; ++j)
+			rhs[i * _nComp + j] = _solveBuffer[j * _nTank + i];
+	}
+
+	return success;
+}
+
+int CSTRArrayModel::linearSolve(double t, double alpha, double tol, double* const rhs, double const* const weight,
+	const ConstSimulationState& simState)
+{
+	const double flowIn = static_cast<double>(_flowRateIn);
+	double* const rhsOut = rhs + _nComp;
+	double* const rhsTank = rhs + 2 * _nComp;
+
+	// Handle inlet equations by backsubstitution
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		const double feed = static_cast<double>(_inletDistribution[i]) * flowIn;
+		double* const ri = rhsTank + i * _nComp;
+		for (unsigned int j = 0; j < _nComp; ++j)
+			ri[j] += feed * rhs[j];
+	}
+
+	bool success = true;
+	if (_factorizeJac)
+	{
+		// Factorization is necessary
+		_factorizeJac = false;
+		_linearSolver->assemble(_jac, alpha, _volume);
+		success = _linearSolver->factorize();
+	}
+	success = success && solveTanks(rhsTank);
+
+	// The outlet rows only depend on the tanks: c_out = rhs_out + sum_i w_i * c_i
+	for (unsigned int i = 0; i < _nTank; ++i)
+	{
+		double const* const ci = rhsTank + i * _nComp;
+		for (unsigned int j = 0; j < _nComp; ++j)
+			rhsOut[j] += _outletWeight[i] * ci[j];
+	}
+
+	// Return 0 on success and 1 on failure
+	return success ? 0 : 1;
+}
+
+void registerCSTRArrayModel(std::unordered_map<std::string, std::function<IUnitOperation*(UnitOpIdx)>>& models)
+{
+	models[CSTRArrayModel::identifier()] = [](UnitOpIdx uoId) { return new CSTRArrayModel(uoId); };
+}
+
+}  // namespace model
+
+}  // namespace cadet
@@ -0,0 +1,267 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Defines an array of connected continuous stirred tanks (compartment model).
+ */
+
+#ifndef LIBCADET_CSTRARRAY_HPP_
+#define LIBCADET_CSTRARRAY_HPP_
+
+#include "model/UnitOperationBase.hpp"
+#include "cadet/SolutionExporter.hpp"
+#include "AutoDiff.hpp"
+#include "linalg/CompressedSparseMatrix.hpp"
+#include "Memory.hpp"
+
+#include <array>
+#include <vector>
+
+namespace cadet
+{
+
+namespace model
+{
+
+/**
+ * @brief Array of continuous stirred tanks with internal connections
+ * @details This unit operation represents @f$ N @f$ well-mixed tanks of constant volume that
+ *          exchange liquid according to an internal connection network. It is intended for
+ *          compartment models that would otherwise require hundreds of individual CSTR units.
+ *          Let @f$ Q_{k \to i} @f$ denote the volumetric flow rate from tank @f$ k @f$ to tank @f$ i @f$
+ *          and @f$ f_i @f$ the fraction of the unit inlet stream fed to tank @f$ i @f$.
+ * @f[\begin{align}
+	V_i \frac{\mathrm{d} c_{i,j}}{\mathrm{d} t} &= f_i F_{\text{in}} c_{\text{in},j} + \sum_{k} Q_{k \to i} c_{k,j} - \left( f_i F_{\text{in}} + \sum_{k} Q_{k \to i} \right) c_{i,j} \\
+	c_{\text{out},j} &= \sum_{i} \frac{F_{\text{out},i}}{\sum_k F_{\text{out},k}} c_{i,j}
+\end{align} @f]
+ *          The outflow of each tank to the unit outlet @f$ F_{\text{out},i} = f_i F_{\text{in}} + \sum_{k} Q_{k \to i} - \sum_{k} Q_{i \to k} @f$
+ *          closes the volume balance. Since the tanks are coupled only through the components' own concentrations,
+ *          the Jacobian with respect to the tank concentrations is the same sparse @f$ N \times N @f$ matrix for
+ *          each component. It is factorized once and applied to all components.
+ */
+class CSTRArrayModel : public UnitOperationBase
+{
+public:
+
+	CSTRArrayModel(UnitOpIdx unitOpIdx);
+	virtual ~CSTRArrayModel() CADET_NOEXCEPT;
+
+	virtual unsigned int numDofs() const CADET_NOEXCEPT;
+	virtual unsigned int numPureDofs() const CADET_NOEXCEPT;
+	virtual bool usesAD() const CADET_NOEXCEPT;
+	virtual unsigned int requiredADdirs() const CADET_NOEXCEPT;
+
+	virtual UnitOpIdx unitOperationId() const CADET_NOEXCEPT { return _unitOpIdx; }
+	virtual unsigned int numComponents() const CADET_NOEXCEPT { return _nComp; }
+	virtual void setFlowRates(active const* in, active const* out) CADET_NOEXCEPT;
+	virtual unsigned int numInletPorts() const CADET_NOEXCEPT { return 1; }
+	virtual unsigned int numOutletPorts() const CADET_NOEXCEPT { return 1; }
+	virtual bool canAccumulate() const CADET_NOEXCEPT { return false; }
+
+	static const char* identifier() { return "CSTR_ARRAY"; }
+	virtual const char* unitOperationName() const CADET_NOEXCEPT { return "CSTR_ARRAY"; }
+
+	virtual bool configureModelDiscretization(IParameterProvider& paramProvider, IConfigHelper& helper);
+	virtual bool configure(IParameterProvider& paramProvider);
+	virtual void notifyDiscontinuousSectionTransition(double t, unsigned int secIdx, const AdJacobianParams& adJac);
+
+	virtual void useAnalyticJacobian(const bool analyticJac) { }
+
+	virtual void reportSolution(ISolutionRecorder& recorder, double const* const solution) const;
+	virtual void reportSolutionStructure(ISolutionRecorder& recorder) const;
+
+	virtual int residual(const SimulationTime& simTime, const ConstSimulationState& simState, double* const res, util::ThreadLocalStorage& threadLocalMem);
+
+	virtual int residualWithJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, double* const res, const AdJacobianParams& adJac, util::ThreadLocalStorage& threadLocalMem);
+	virtual int residualSensFwdAdOnly(const SimulationTime& simTime, const ConstSimulationState& simState, active* const adRes, util::ThreadLocalStorage& threadLocalMem);
+	virtual int residualSensFwdWithJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, const AdJacobianParams& adJac, util::ThreadLocalStorage& threadLocalMem);
+
+	virtual int linearSolve(double t, double alpha, double tol, double* const rhs, double const* const weight,
+		const ConstSimulationState& simState);
+
+	virtual void prepareADvectors(const AdJacobianParams& adJac) const { }
+
+	virtual void applyInitialCondition(const SimulationState& simState) const;
+	virtual void readInitialCondition(IParameterProvider& paramProvider);
+
+	virtual void consistentInitialState(const SimulationTime& simTime, double* const vecStateY, const AdJacobianParams& adJac, double errorTol, util::ThreadLocalStorage& threadLocalMem);
+	virtual void consistentInitialTimeDerivative(const SimulationTime& simTime, double const* vecStateY, double* const vecStateYdot, util::ThreadLocalStorage& threadLocalMem);
+
+	virtual void initializeSensitivityStates(const std::vector<double*>& vecSensY) const;
+	virtual void consistentInitialSensitivity(const SimulationTime& simTime, const ConstSimulationState& simState,
+		std::vector<double*>& vecSensY, std::vector<double*>& vecSensYdot, active const* const adRes, util::ThreadLocalStorage& threadLocalMem);
+
+	virtual void leanConsistentInitialState(const SimulationTime& simTime, double* const vecStateY, const AdJacobianParams& adJac, double errorTol, util::ThreadLocalStorage& threadLocalMem);
+	virtual void leanConsistentInitialTimeDerivative(double t, double const* const vecStateY, double* const vecStateYdot, double* const res, util::ThreadLocalStorage& threadLocalMem);
+
+	virtual void leanConsistentInitialSensitivity(const SimulationTime& simTime, const ConstSimulationState& simState,
+		std::vector<double*>& vecSensY, std::vector<double*>& vecSensYdot, active const* const adRes, util::ThreadLocalStorage& threadLocalMem);
+
+	virtual void setExternalFunctions(IExternalFunction** extFuns, unsigned int size) { }
+
+	virtual void multiplyWithJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, double const* yS, double alpha, double beta, double* ret);
+	virtual void multiplyWithDerivativeJacobian(const SimulationTime& simTime, const ConstSimulationState& simState, double const* sDot, double* ret);
+
+	virtual bool hasInlet() const CADET_NOEXCEPT { return true; }
+	virtual bool hasOutlet() const CADET_NOEXCEPT { return true; }
+
+	virtual unsigned int localOutletComponentIndex(unsigned int port) const CADET_NOEXCEPT { return _nComp; }
+	virtual unsigned int localOutletComponentStride(unsigned int port) const CADET_NOEXCEPT { return 1; }
+	virtual unsigned int localInletComponentIndex(unsigned int port) const CADET_NOEXCEPT { return 0; }
+	virtual unsigned int localInletComponentStride(unsigned int port) const CADET_NOEXCEPT { return 1; }
+
+	virtual void setSectionTimes(double const* secTimes, bool const* secContinuity, unsigned int nSections) { }
+
+	virtual void expandErrorTol(double const* errorSpec, unsigned int errorSpecSize, double* expandOut) { }
+
+	virtual unsigned int threadLocalMemorySize() const CADET_NOEXCEPT;
+
+#ifdef CADET_BENCHMARK_MODE
+	virtual std::vector<double> benchmarkTimings() const { return std::vector<double>(0); }
+	virtual char const* const* benchmarkDescriptions() const { return nullptr; }
+#endif
+
+	inline unsigned int numTanks() const CADET_NOEXCEPT { return _nTank; }
+
+	class LinearSolver;
+
+protected:
+
+	class DenseDirectSolver;
+
+#if defined(UMFPACK_FOUND) || defined(SUPERLU_FOUND)
+	template <typename sparse_t>
+	class SparseDirectSolver;
+#endif
+
+	int residual(const SimulationTime& simTime, const ConstSimulationState& simState, double* const res, const AdJacobianParams& adJac, util::ThreadLocalStorage& threadLocalMem, bool updateJacobian, bool paramSensitivity);
+
+	template <typename ResidualType, typename ParamType, bool wantJac>
+	int residualImpl(double t, unsigned int secIdx, double const* const y, double const* const yDot, ResidualType* const res, LinearBufferAllocator threadLocalMem);
+
+	template <typename ParamType>
+	void tankFlowRates(ParamType* const inflow, ParamType* const outflow) const;
+
+	void updateOutletWeights();
+	void multiplyWithTankJacobian(double const* yS, double alpha, double beta, double* ret) const;
+	bool solveTanks(double* const rhs) const;
+
+	unsigned int _nComp; //!< Number of components
+	unsigned int _nTank; //!< Number of tanks
+
+	active _flowRateIn; //!< Volumetric flow rate of incoming stream
+	std::vector<active> _volume; //!< Constant liquid volume of each tank
+	std::vector<active> _inletDistribution; //!< Fraction of the incoming stream fed to each tank
+	std::vector<unsigned int> _connSource; //!< Source tank of each internal connection
+	std::vector<unsigned int> _connTarget; //!< Target tank of each internal connection
+	std::vector<active> _connFlowRate; //!< Volumetric flow rate of each internal connection
+
+	linalg::CompressedSparseMatrix _jac; //!< Jacobian of one component's tank concentrations (shared by all components)
+	std::vector<double> _outletWeight; //!< Contribution of each tank to the mixed outlet stream
+	LinearSolver* _linearSolver; //!< Solver for the tank block of the Jacobian
+	bool _factorizeJac; //!< Flag that tracks whether the Jacobian needs to be factorized
+	mutable std::vector<double> _solveBuffer; //!< Component-major buffer used by the batched linear solve
+
+	std::vector<active> _initConditions; //!< Initial conditions, ordering: Outlet, tank-major concentrations
+	std::vector<double> _initConditionsDot; //!< Initial conditions for time derivative
+
+	class Exporter : public ISolutionExporter
+	{
+	public:
+
+		Exporter(unsigned int nComp, unsigned int nTank, double const* data) : _data(data), _nComp(nComp), _nTank(nTank) { }
+
+		virtual bool hasParticleFlux() const CADET_NOEXCEPT { return false; }
+		virtual bool hasParticleMobilePhase() const CADET_NOEXCEPT { return false; }
+		virtual bool hasSolidPhase() const CADET_NOEXCEPT { return false; }
+		virtual bool hasVolume() const CADET_NOEXCEPT { return false; }
+
+		virtual unsigned int numComponents() const CADET_NOEXCEPT { return _nComp; }
+		virtual unsigned int numAxialCells() const CADET_NOEXCEPT { return _nTank; }
+		virtual unsigned int numRadialCells() const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numInletPorts() const CADET_NOEXCEPT { return 1; }
+		virtual unsigned int numOutletPorts() const CADET_NOEXCEPT { return 1; }
+		virtual unsigned int numParticleTypes() const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numParticleShells(unsigned int parType) const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numBoundStates(unsigned int parType) const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numBulkDofs() const CADET_NOEXCEPT { return _nComp * _nTank; }
+		virtual unsigned int numParticleMobilePhaseDofs(unsigned int parType) const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numSolidPhaseDofs(unsigned int parType) const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numFluxDofs() const CADET_NOEXCEPT { return 0; }
+		virtual unsigned int numVolumeDofs() const CADET_NOEXCEPT { return 0; }
+
+		virtual double const* concentration() const { return _data + 2 * _nComp; }
+		virtual double const* flux() const { return nullptr; }
+		virtual double const* particleMobilePhase(unsigned int parType) const { return nullptr; }
+		virtual double const* solidPhase(unsigned int parType) const { return nullptr; }
+		virtual double const* volume() const { return nullptr; }
+		virtual double const* inlet(unsigned int port, unsigned int& stride) const
+		{
+			stride = 1;
+			return _data;
+		}
+		virtual double const* outlet(unsigned int port, unsigned int& stride) const
+		{
+			stride = 1;
+			return _data + _nComp;
+		}
+
+		virtual StateOrdering const* concentrationOrdering(unsigned int& len) const
+		{
+			len = _concentrationOrdering.size();
+			return _concentrationOrdering.data();
+		}
+
+		virtual StateOrdering const* fluxOrdering(unsigned int& len) const
+		{
+			len = 0;
+			return nullptr;
+		}
+
+		virtual StateOrdering const* mobilePhaseOrdering(unsigned int& len) const
+		{
+			len = 0;
+			return nullptr;
+		}
+
+		virtual StateOrdering const* solidPhaseOrdering(unsigned int& len) const
+		{
+			len = 0;
+			return nullptr;
+		}
+
+		virtual unsigned int bulkMobilePhaseStride() const { return _nComp; }
+		virtual unsigned int particleMobilePhaseStride(unsigned int parType) const { return 0; }
+		virtual unsigned int solidPhaseStride(unsigned int parType) const { return 0; }
+
+		virtual void axialCoordinates(double* coords) const
+		{
+			for (unsigned int i = 0; i < _nTank; ++i)
+				coords[i] = i;
+		}
+		virtual void radialCoordinates(double* coords) const { }
+		virtual void particleCoordinates(unsigned int parType, double* coords) const { }
+
+	protected:
+		double const* const _data;
+		unsigned int _nComp;
+		unsigned int _nTank;
+
+		const std::array<StateOrdering, 2> _concentrationOrdering = { { StateOrdering::AxialCell, StateOrdering::Component } };
+	};
+};
+
+} // namespace model
+} // namespace cadet
+
+#endif  // LIBCADET_CSTRARRAY_HPP_
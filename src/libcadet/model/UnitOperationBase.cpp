@@ -145,6 +145,43 @@ namespace
 		return false;
 	}
 
+	template <typename T>
+	bool resolveParameterStorageImpl(const ParameterId& pId, std::vector<active*>& storage, const std::vector<T*>& items, bool singleItem)
+	{
+		if (items.empty())
+			return false;
+
+		if (singleItem)
+		{
+			if (!items[0])
+				return false;
+
+			active* const val = items[0]->getParameter(pId);
+			if (val)
+			{
+				storage.push_back(val);
+				return true;
+			}
+		}
+		else
+		{
+			for (T* bm : items)
+			{
+				if (!bm)
+					continue;
+
+				active* const val = bm->getParameter(pId);
+				if (val)
+				{
+					storage.push_back(val);
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
 	template <typename T>
 	bool setSensitiveParameterValueImpl(const ParameterId& pId, double value, const std::unordered_set<active*>& sensParams, const std::vector<T*>& items, bool singleItem)
 	{
@@ -344,6 +381,25 @@ bool UnitOperationBase::setParameter(const ParameterId& pId, double value)
 	return false;
 }
 
+bool UnitOperationBase::resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage)
+{
+	if ((pId.unitOperation != _unitOpIdx) && (pId.unitOperation != UnitOpIndep))
+		return true;
+
+	paramMap_t::iterator paramHandle = _parameters.find(pId);
+	if (paramHandle != _parameters.end())
+	{
+		storage.push_back(paramHandle->second);
+		return true;
+	}
+
+	if (resolveParameterStorageImpl(pId, storage, _binding, _singleBinding))
+		return true;
+	resolveParameterStorageImpl(pId, storage, _dynReaction, _singleDynReaction);
+
+	return true;
+}
+
 bool UnitOperationBase::setParameter(const ParameterId& pId, bool value)
 {
 	if ((pId.unitOperation != _unitOpIdx) && (pId.unitOperation != UnitOpIndep))
@@ -452,6 +508,9 @@ int UnitOperationBase::residualSensFwdCombine(const SimulationTime& simTime, con
 {
 	for (unsigned int param = 0; param < yS.size(); ++param)
 	{
+		if (!yS[param])
+			continue;
+
 		// tmp1 stores result of (dF / dy) * s
 		// tmp2 stores result of (dF / dyDot) * sDot
 
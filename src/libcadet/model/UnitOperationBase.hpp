@@ -59,6 +59,7 @@ public:
 
 	virtual bool setSensitiveParameter(const ParameterId& pId, unsigned int adDirection, double adValue);
 	virtual void setSensitiveParameterValue(const ParameterId& id, double value);
+	virtual bool resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage);
 
 	virtual void clearSensParams();
 	virtual unsigned int numSensParams() const;
@@ -67,6 +68,9 @@ public:
 		const std::vector<const double*>& yS, const std::vector<const double*>& ySdot, const std::vector<double*>& resS, active const* adRes,
 		double* const tmp1, double* const tmp2, double* const tmp3);
 
+	virtual void setAdaptiveLinearSolverTolerance(bool adaptive) CADET_NOEXCEPT { }
+	virtual unsigned long numLinearSolverIterations() const CADET_NOEXCEPT { return 0; }
+
 protected:
 
 	void clearBindingModels() CADET_NOEXCEPT;
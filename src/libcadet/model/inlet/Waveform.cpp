@@ -0,0 +1,267 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides an inlet profile that interpolates a sampled waveform.
+ */
+
+#include "cadet/InletProfile.hpp"
+#include "cadet/ParameterProvider.hpp"
+#include "cadet/Exceptions.hpp"
+#include "common/CompilerSpecific.hpp"
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string>
+#include <cmath>
+
+namespace cadet
+{
+
+namespace model
+{
+
+/**
+ * @brief Inlet profile that interpolates a sampled waveform
+ * @details The concentrations of all components are given at sample times. In between, they
+ *          are interpolated by monotone piecewise cubic Hermite polynomials (Fritsch-Carlson)
+ *          whose slopes are estimated from the data. Outside of the sampled time interval, the
+ *          first or last sample is continued constantly.
+ *
+ *          This profile is used for feeding the outlet of one unit operation into another one
+ *          that is integrated by a separate simulator (waveform relaxation). Since the data is
+ *          independent of section times, the profile does not expose any parameters.
+ */
+class WaveformInlet : public cadet::IInletProfile
+{
+public:
+	WaveformInlet() : _nComp(0), _lastIdx(0) { }
+
+	virtual ~WaveformInlet() CADET_NOEXCEPT { }
+
+	static const char* identifier() { return "WAVEFORM"; }
+	virtual const char* name() const CADET_NOEXCEPT { return WaveformInlet::identifier(); }
+
+	virtual std::vector<cadet::ParameterId> availableParameters(unsigned int unitOpIdx) CADET_NOEXCEPT
+	{
+		return std::vector<cadet::ParameterId>();
+	}
+
+	virtual void inletConcentration(double t, unsigned int sec, double* inletConc)
+	{
+		if (_time.size() == 1)
+		{
+			std::copy(_data.begin(), _data.end(), inletConc);
+			return;
+		}
+
+		if (t <= _time.front())
+		{
+			std::copy(_data.begin(), _data.begin() + _nComp, inletConc);
+			return;
+		}
+
+		if (t >= _time.back())
+		{
+			std::copy(_data.end() - _nComp, _data.end(), inletConc);
+			return;
+		}
+
+		const unsigned int idx = findInterval(t);
+		const double h = _time[idx + 1] - _time[idx];
+		const double s = (t - _time[idx]) / h;
+
+		// Cubic Hermite basis functions
+		const double h00 = (1.0 + 2.0 * s) * (1.0 - s) * (1.0 - s);
+		const double h10 = s * (1.0 - s) * (1.0 - s);
+		const double h01 = s * s * (3.0 - 2.0 * s);
+		const double h11 = s * s * (s - 1.0);
+
+		double const* const y0 = _data.data() + idx * _nComp;
+		double const* const y1 = y0 + _nComp;
+		double const* const d0 = _slope.data() + idx * _nComp;
+		double const* const d1 = d0 + _nComp;
+
+		for (unsigned int comp = 0; comp < _nComp; ++comp)
+			inletConc[comp] = h00 * y0[comp] + h10 * h * d0[comp] + h01 * y1[comp] + h11 * h * d1[comp];
+	}
+
+	virtual void parameterDerivative(double t, unsigned int sec, const cadet::ParameterId& pId, double* paramDeriv)
+	{
+		std::fill(paramDeriv, paramDeriv + _nComp, 0.0);
+	}
+
+	virtual void timeDerivative(double t, unsigned int sec, double* timeDerivative)
+	{
+		if ((_time.size() == 1) || (t <= _time.front()) || (t >= _time.back()))
+		{
+			std::fill(timeDerivative, timeDerivative + _nComp, 0.0);
+			return;
+		}
+
+		const unsigned int idx = findInterval(t);
+		const double h = _time[idx + 1] - _time[idx];
+		const double s = (t - _time[idx]) / h;
+
+		// Derivatives of cubic Hermite basis functions with respect to s
+		const double dh00 = 6.0 * s * (s - 1.0);
+		const double dh10 = (3.0 * s - 4.0) * s + 1.0;
+		const double dh01 = -dh00;
+		const double dh11 = (3.0 * s - 2.0) * s;
+
+		double const* const y0 = _data.data() + idx * _nComp;
+		double const* const y1 = y0 + _nComp;
+		double const* const d0 = _slope.data() + idx * _nComp;
+		double const* const d1 = d0 + _nComp;
+
+		for (unsigned int comp = 0; comp < _nComp; ++comp)
+			timeDerivative[comp] = (dh00 * y0[comp] + dh01 * y1[comp]) / h + dh10 * d0[comp] + dh11 * d1[comp];
+	}
+
+	virtual void timeParameterDerivative(double t, unsigned int sec, const ParameterId& pId, double* deriv)
+	{
+		std::fill(deriv, deriv + _nComp, 0.0);
+	}
+
+	virtual void setParameterValue(const cadet::ParameterId& pId, double value) { }
+
+	virtual double getParameterValue(const cadet::ParameterId& pId)
+	{
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+
+	virtual void numComponents(unsigned int nComp) CADET_NOEXCEPT { _nComp = nComp; }
+
+	inline const std::vector<double>& time() const CADET_NOEXCEPT { return _time; }
+	inline const std::vector<double>& data() const CADET_NOEXCEPT { return _data; }
+
+	virtual void setSectionTimes(double const* secTimes, bool const* secContinuity, unsigned int nSections) CADET_NOEXCEPT { }
+
+	virtual bool configure(IParameterProvider* paramProvider, unsigned int nComp)
+	{
+		_nComp = nComp;
+		_lastIdx = 0;
+
+		if (!paramProvider)
+			return false;
+
+		_time = paramProvider->getDoubleArray("TIME");
+		_data = paramProvider->getDoubleArray("DATA");
+
+		if (_time.empty())
+			throw InvalidParameterException("Waveform inlet requires at least one sample in TIME");
+		if (_data.size() < _time.size() * _nComp)
+			throw InvalidParameterException("Waveform inlet requires DATA with at least NCOMP * " + std::to_string(_time.size()) + " elements");
+
+		for (std::size_t i = 1; i < _time.size(); ++i)
+		{
+			if (_time[i] <= _time[i-1])
+				throw InvalidParameterException("Waveform inlet requires strictly increasing TIME");
+		}
+
+		_data.resize(_time.size() * _nComp);
+		computeSlopes();
+		return true;
+	}
+
+private:
+
+	/**
+	 * @brief Locates the sampling interval that contains the given time point
+	 * @details Successive calls usually query nearby time points, so the last
+	 *          interval is checked before searching.
+	 * @param [in] t Time point strictly inside the sampled time interval
+	 * @return Index of the left sample of the interval
+	 */
+	inline unsigned int findInterval(double t)
+	{
+		if ((_time[_lastIdx] <= t) && (t < _time[_lastIdx + 1]))
+			return _lastIdx;
+
+		const std::vector<double>::const_iterator it = std::upper_bound(_time.begin(), _time.end(), t);
+		_lastIdx = std::min(static_cast<unsigned int>(it - _time.begin()) - 1, static_cast<unsigned int>(_time.size()) - 2);
+		return _lastIdx;
+	}
+
+	/**
+	 * @brief Estimates shape-preserving slopes at the samples
+	 * @details Uses the Fritsch-Carlson scheme with one-sided three point estimates at the end points.
+	 */
+	void computeSlopes()
+	{
+		const unsigned int n = _time.size();
+		_slope.assign(n * _nComp, 0.0);
+		if (n < 2)
+			return;
+
+		for (unsigned int comp = 0; comp < _nComp; ++comp)
+		{
+			const auto delta = [&](unsigned int i) -> double { return (_data[(i+1) * _nComp + comp] - _data[i * _nComp + comp]) / (_time[i+1] - _time[i]); };
+
+			if (n == 2)
+			{
+				_slope[comp] = delta(0);
+				_slope[_nComp + comp] = delta(0);
+				continue;
+			}
+
+			for (unsigned int i = 1; i < n - 1; ++i)
+			{
+				const double dl = delta(i-1);
+				const double dr = delta(i);
+				if (dl * dr <= 0.0)
+					continue;
+
+				const double hl = _time[i] - _time[i-1];
+				const double hr = _time[i+1] - _time[i];
+				const double w1 = 2.0 * hr + hl;
+				const double w2 = hr + 2.0 * hl;
+				_slope[i * _nComp + comp] = (w1 + w2) / (w1 / dl + w2 / dr);
+			}
+
+			_slope[comp] = endSlope(_time[1] - _time[0], _time[2] - _time[1], delta(0), delta(1));
+			_slope[(n-1) * _nComp + comp] = endSlope(_time[n-1] - _time[n-2], _time[n-2] - _time[n-3], delta(n-2), delta(n-3));
+		}
+	}
+
+	static inline double endSlope(double h0, double h1, double d0, double d1)
+	{
+		const double d = ((2.0 * h0 + h1) * d0 - h0 * d1) / (h0 + h1);
+		if (d * d0 <= 0.0)
+			return 0.0;
+		if ((d0 * d1 <= 0.0) && (std::abs(d) > 3.0 * std::abs(d0)))
+			return 3.0 * d0;
+		return d;
+	}
+
+	unsigned int _nComp;
+	unsigned int _lastIdx; //!< Index of the sampling interval of the last query
+
+	std::vector<double> _time; //!< Sample times
+	std::vector<double> _data; //!< Samples in time-major ordering (i.e., components are fastest)
+	std::vector<double> _slope; //!< Estimated time derivatives at the samples
+};
+
+namespace inlet
+{
+	void registerWaveform(std::unordered_map<std::string, std::function<IInletProfile*()>>& inlets)
+	{
+		inlets[WaveformInlet::identifier()] = []() { return new WaveformInlet(); };
+	}
+} // namespace inlet
+
+} // namespace model
+} // namespace cadet
@@ -389,6 +389,37 @@ bool ConvectionDispersionOperatorBase::setParameter(const ParameterId& pId, doub
 	return true;
 }
 
+bool ConvectionDispersionOperatorBase::resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage)
+{
+	// We only need to do something if COL_DISPERSION is component independent
+	if (!_dispersionCompIndep)
+		return false;
+
+	if ((pId.name != hashString("COL_DISPERSION")) || (pId.component != CompIndep) || (pId.boundState != BoundStateIndep) || (pId.reaction != ReactionIndep) || (pId.particleType != ParTypeIndep))
+		return false;
+
+	if (_colDispersion.size() > _nComp)
+	{
+		// Section dependent
+		if (pId.section == SectionIndep)
+			return false;
+
+		for (unsigned int i = 0; i < _nComp; ++i)
+			storage.push_back(&_colDispersion[pId.section * _nComp + i]);
+	}
+	else
+	{
+		// Section independent
+		if (pId.section != SectionIndep)
+			return false;
+
+		for (unsigned int i = 0; i < _nComp; ++i)
+			storage.push_back(&_colDispersion[i]);
+	}
+
+	return true;
+}
+
 bool ConvectionDispersionOperatorBase::setSensitiveParameterValue(const std::unordered_set<active*>& sensParams, const ParameterId& pId, double value)
 {
 	// We only need to do something if COL_DISPERSION is component independent
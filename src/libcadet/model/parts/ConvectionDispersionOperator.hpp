@@ -98,6 +98,7 @@ public:
 	bool setParameter(const ParameterId& pId, double value);
 	bool setSensitiveParameter(std::unordered_set<active*>& sensParams, const ParameterId& pId, unsigned int adDirection, double adValue);
 	bool setSensitiveParameterValue(const std::unordered_set<active*>& sensParams, const ParameterId& id, double value);
+	bool resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage);
 
 protected:
 
@@ -214,6 +215,10 @@ public:
 	{
 		return _baseOp.setSensitiveParameterValue(sensParams, id, value);
 	}
+	inline bool resolveParameterStorage(const ParameterId& pId, std::vector<active*>& storage)
+	{
+		return _baseOp.resolveParameterStorage(pId, storage);
+	}
 
 protected:
 
@@ -471,6 +471,7 @@ public:
 	virtual void assembleDiscretizedJacobian(double alpha) = 0;
 	virtual bool factorize() = 0;
 	virtual bool solveDiscretizedJacobian(double* rhs, double const* weight, double const* init, double outerTol) const = 0;
+	virtual std::size_t memoryUsage() const CADET_NOEXCEPT = 0;
 };
 
 int schurComplementMultiplier2DCDO(void* userData, double const* x, double* z);
@@ -511,6 +512,12 @@ public:
 		return gmresResult == 0;
 	}
 
+	virtual std::size_t memoryUsage() const CADET_NOEXCEPT
+	{
+		// The Krylov subspace may grow up to the size of the matrix
+		return (_cache.size() + 2) * _cache.size() * sizeof(double);
+	}
+
 protected:
 	linalg::CompressedSparseMatrix const* const _jacC;
 	double _alpha;
@@ -574,6 +581,12 @@ int schurComplementMultiplier2DCDO(void* userData, double const* x, double* z)
 			return _jacCdisc.solve(rhs);
 		}
 
+		virtual std::size_t memoryUsage() const CADET_NOEXCEPT
+		{
+			// Fill-in of the factors is managed by the sparse solver library and not accounted for
+			return _jacC->numNonZeros() * (sizeof(double) + sizeof(linalg::sparse_int_t)) + (_jacC->rows() + 1) * sizeof(linalg::sparse_int_t);
+		}
+
 	protected:
 		linalg::CompressedSparseMatrix const* const _jacC;
 		sparse_t _jacCdisc;
@@ -644,11 +657,77 @@ public:
 		return _jacCdisc.solve(rhs);
 	}
 
+	virtual std::size_t memoryUsage() const CADET_NOEXCEPT
+	{
+		return _jacCdisc.rows() * (_jacCdisc.stride() * sizeof(double) + sizeof(lapackInt_t));
+	}
+
 protected:
 	linalg::CompressedSparseMatrix const* const _jacC;
 	linalg::FactorizableBandMatrix _jacCdisc;
 };
 
+/**
+ * @brief Approximates the bulk block by its diagonal
+ * @details Only stores the diagonal of the time discretized Jacobian. Hence, the solution of the
+ *          linear system is approximate and this solver is only suitable as preconditioner (e.g.,
+ *          in the Jacobian-free mode of the unit operation).
+ */
+class TwoDimensionalConvectionDispersionOperator::JacobiSolver : public TwoDimensionalConvectionDispersionOperator::LinearSolver
+{
+public:
+
+	JacobiSolver(linalg::CompressedSparseMatrix const* jacC) : _jacC(jacC) { }
+	virtual ~JacobiSolver() CADET_NOEXCEPT { }
+
+	virtual bool initialize(IParameterProvider& paramProvider, unsigned int nComp, unsigned int nCol, unsigned int nRad, const Weno& weno)
+	{
+		_invDiag.resize(nCol * nComp * nRad, 1.0);
+		return true;
+	}
+
+	virtual void setSparsityPattern(const linalg::SparsityPattern& pattern) { }
+
+	virtual void assembleDiscretizedJacobian(double alpha)
+	{
+		const linalg::CompressedSparseMatrix& jac = *_jacC;
+		for (std::size_t i = 0; i < _invDiag.size(); ++i)
+			_invDiag[i] = jac.centered(i, 0) + alpha;
+	}
+
+	virtual bool factorize()
+	{
+		bool result = true;
+		for (std::size_t i = 0; i < _invDiag.size(); ++i)
+		{
+			if (cadet_unlikely(_invDiag[i] == 0.0))
+			{
+				_invDiag[i] = 1.0;
+				result = false;
+			}
+			else
+				_invDiag[i] = 1.0 / _invDiag[i];
+		}
+		return result;
+	}
+
+	virtual bool solveDiscretizedJacobian(double* rhs, double const* weight, double const* init, double outerTol) const 
+	{
+		for (std::size_t i = 0; i < _invDiag.size(); ++i)
+			rhs[i] *= _invDiag[i];
+		return true;
+	}
+
+	virtual std::size_t memoryUsage() const CADET_NOEXCEPT
+	{
+		return _invDiag.size() * sizeof(double);
+	}
+
+protected:
+	linalg::CompressedSparseMatrix const* const _jacC;
+	std::vector<double> _invDiag; //!< Inverse of the diagonal of the time discretized Jacobian
+};
+
 
 /**
  * @brief Creates a TwoDimensionalConvectionDispersionOperator
@@ -697,6 +776,8 @@ bool TwoDimensionalConvectionDispersionOperator::configureModelDiscretization(IP
 			_linearSolver = new DenseDirectSolver(&_jacC);
 		else if (sol == "GMRES")
 			_linearSolver = new GmresSolver(&_jacC);
+		else if (sol == "JACOBI")
+			_linearSolver = new JacobiSolver(&_jacC);
 #ifdef UMFPACK_FOUND
 		else if (sol == "UMFPACK")
 			_linearSolver = new SparseDirectSolver<linalg::UMFPackSparseMatrix>(&_jacC);
@@ -709,6 +790,10 @@ bool TwoDimensionalConvectionDispersionOperator::configureModelDiscretization(IP
 			throw InvalidParameterException("Unknown linear solver " + sol + " in field LINEAR_SOLVER_BULK");
 	}
 
+	// The Jacobian-free mode only requires a preconditioner, which defaults to the diagonal
+	if (!_linearSolver && paramProvider.exists("USE_JFNK") && paramProvider.getBool("USE_JFNK"))
+		_linearSolver = new JacobiSolver(&_jacC);
+
 	// Default to sparse solver if available (preferably UMFPACK), fall back to dense
 	if (!_linearSolver)
 	{
@@ -1242,6 +1327,16 @@ bool TwoDimensionalConvectionDispersionOperator::solveDiscretizedJacobian(double
 	return _linearSolver->solveDiscretizedJacobian(rhs, weight, init, outerTol);
 }
 
+/**
+ * @brief Returns the memory occupied by the bulk Jacobian and the linear solver
+ * @return Memory in bytes
+ */
+std::size_t TwoDimensionalConvectionDispersionOperator::jacobianMemoryUsage() const CADET_NOEXCEPT
+{
+	const std::size_t jacMem = _jacC.numNonZeros() * (sizeof(double) + sizeof(linalg::sparse_int_t)) + (_jacC.rows() + 2) * sizeof(linalg::sparse_int_t);
+	return jacMem + (_linearSolver ? _linearSolver->memoryUsage() : 0);
+}
+
 /**
  * @brief Solves a system with the time derivative Jacobian and given right hand side
  * @details Note that the given right hand side vector @p rhs is not shifted by the inlet DOFs. That
@@ -84,6 +84,7 @@ public:
 
 	bool assembleAndFactorizeDiscretizedJacobian(double alpha);
 	bool solveDiscretizedJacobian(double* rhs, double const* weight, double const* init, double outerTol) const;
+	std::size_t jacobianMemoryUsage() const CADET_NOEXCEPT;
 
 	bool setParameter(const ParameterId& pId, double value);
 	bool setSensitiveParameter(std::unordered_set<active*>& sensParams, const ParameterId& pId, unsigned int adDirection, double adValue);
@@ -112,6 +113,7 @@ protected:
 	class GmresSolver;
 	template <typename sparse_t> class SparseDirectSolver;
 	class DenseDirectSolver;
+	class JacobiSolver;
 
 	friend int schurComplementMultiplier2DCDO(void* userData, double const* x, double* z);
 
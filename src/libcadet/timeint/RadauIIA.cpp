@@ -0,0 +1,664 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include "timeint/RadauIIA.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	/**
+	 * @brief Collocation nodes (the third node is @c 1)
+	 */
+	const double c1 = 0.15505102572168219018;
+	const double c2 = 0.64494897427831780982;
+
+	/**
+	 * @brief Inverse of the Runge-Kutta matrix
+	 */
+	const double invA[3][3] = {
+		{ 3.2247448713915890491, 1.1678400846904054949, -0.25319726474218082622},
+		{-3.5678400846904054951, 0.77525512860841095075, 1.0531972647421808261},
+		{ 5.5319726474218082609, -7.5319726474218082614, 5.0}
+	};
+
+	/**
+	 * @brief Transformation @f$ T @f$ with @f$ T^{-1} A^{-1} T = \operatorname{diag}\left(\gamma, \begin{pmatrix} \alpha & -\beta \\ \beta & \alpha \end{pmatrix} \right) @f$
+	 */
+	const double T[3][3] = {
+		{0.091232394870892942792, -0.14125529502095420843, -0.030029194105147424492},
+		{0.24171793270710701896, 0.20412935229379993199, 0.38294211275726193779},
+		{0.96604818261509293619, 1.0, 0.0}
+	};
+
+	/**
+	 * @brief Inverse transformation @f$ T^{-1} @f$
+	 */
+	const double TI[3][3] = {
+		{4.3255798900631553514, 0.33919925181580986957, 0.54177053993587487123},
+		{-4.1787185915519047276, -0.3276828207610623871, 0.47662355450055045197},
+		{-0.50287263494578687606, 2.5719269498556054294, -0.59603920482822492504}
+	};
+
+	/**
+	 * @brief Eigenvalues @f$ \gamma @f$ and @f$ \alpha \pm i \beta @f$ of the inverse Runge-Kutta matrix
+	 */
+	const double gammaEig = 3.6378342527444957326;
+	const double alphaEig = 2.681082873627752134;
+	const double betaEig = 3.0504301992474105692;
+
+	/**
+	 * @brief Coefficients of the embedded error estimate (applied to the stage increments)
+	 */
+	const double dd[3] = {-10.048809399827415562, 1.3821427331607488957, -1.0 / 3.0};
+
+	const double safety = 0.9; //!< Safety factor of the step size control
+	const double quotMin = 0.125; //!< Lower bound of h_old / h_new (i.e., maximum increase of the step size)
+	const double quotMax = 5.0; //!< Upper bound of h_old / h_new (i.e., maximum decrease of the step size)
+
+	/**
+	 * @brief Evaluates the Lagrange basis of the collocation polynomial and its derivative
+	 * @details The nodes are @f$ 0, c_1, c_2, 1 @f$. The basis polynomial of node @f$ 0 @f$ is omitted
+	 *          since the collocation polynomial of the stage increments vanishes there.
+	 * @param [in] s Normalized time @f$ (t - t_n) / h @f$
+	 * @param [out] L Basis polynomials of the nodes @f$ c_1, c_2, 1 @f$
+	 * @param [out] dL Derivatives of the basis polynomials with respect to @p s
+	 */
+	inline void collocationBasis(double s, double* L, double* dL)
+	{
+		const double nodes[4] = {0.0, c1, c2, 1.0};
+		for (int k = 1; k < 4; ++k)
+		{
+			double val = 1.0;
+			double der = 0.0;
+			for (int j = 0; j < 4; ++j)
+			{
+				if (j == k)
+					continue;
+
+				const double denom = nodes[k] - nodes[j];
+				der = der * (s - nodes[j]) / denom + val / denom;
+				val *= (s - nodes[j]) / denom;
+			}
+			L[k-1] = val;
+			dL[k-1] = der;
+		}
+	}
+}
+
+namespace cadet
+{
+
+namespace timeint
+{
+
+RadauIIA::RadauIIA() : _n(0), _relTol(1e-6), _absTol(1, 1e-8), _rTol(0.0), _aTol(1, 0.0), _newtonTol(0.03),
+	_t(0.0), _tOld(0.0), _h(0.0), _hLast(0.0), _hAcc(0.0), _errAcc(1e-2), _faccon(1.0), _first(true), _reject(false),
+	_maxKrylov(10), _maxSteps(10000), _maxStepSize(0.0), _maxNewtonIter(7), _maxErrTestFails(7), _maxConvFails(10),
+	_nSteps(0), _nNewtonIter(0), _nConvFails(0), _nErrTestFails(0), _nLinearIter(0)
+{
+	const double absTol = _absTol[0];
+	setTolerances(_relTol, &absTol, false);
+}
+
+void RadauIIA::initialize(unsigned int nDof)
+{
+	_n = nDof;
+
+	_y.resize(_n, 0.0);
+	_yDot.resize(_n, 0.0);
+	_yOld.resize(_n, 0.0);
+	_weight.resize(_n, 1.0);
+	_tmpY.resize(_n, 0.0);
+	_tmpYdot.resize(_n, 0.0);
+	_tmpRes.resize(_n, 0.0);
+
+	_z.resize(3 * _n, 0.0);
+	_zLast.resize(3 * _n, 0.0);
+	_work.resize(3 * _n, 0.0);
+
+	_gmres.initialize(2 * _n, _maxKrylov, 4);
+	_gmresRhs.resize(2 * _n, 0.0);
+	_gmresSol.resize(2 * _n, 0.0);
+	_gmresWeight.resize(2 * _n, 1.0);
+
+	// Vector tolerances of a system with different size are invalid
+	if ((_absTol.size() > 1) && (_absTol.size() != _n))
+	{
+		const double absTol = _absTol[0];
+		setTolerances(_relTol, &absTol, false);
+	}
+}
+
+void RadauIIA::setTolerances(double relTol, double const* absTol, bool vectorAbsTol)
+{
+	const double eps = std::numeric_limits<double>::epsilon();
+
+	_relTol = relTol;
+	_absTol.assign(absTol, absTol + ((vectorAbsTol && (_n > 0)) ? _n : 1));
+
+	// Transformation of RADAU5, which accounts for the higher order compared to BDF methods
+	const double rTol = std::max(relTol, 1e2 * eps);
+	_rTol = 0.1 * std::pow(rTol, 2.0 / 3.0);
+
+	_aTol.resize(_absTol.size());
+	for (std::size_t i = 0; i < _absTol.size(); ++i)
+		_aTol[i] = _rTol * _absTol[i] / rTol;
+
+	_newtonTol = std::max(10.0 * eps / _rTol, std::min(0.03, std::sqrt(_rTol)));
+}
+
+void RadauIIA::reinit(double t, double const* y, double const* yDot, double initStepSize)
+{
+	_t = t;
+	_tOld = t;
+	std::copy(y, y + _n, _y.begin());
+	std::copy(yDot, yDot + _n, _yDot.begin());
+	std::copy(y, y + _n, _yOld.begin());
+	std::fill(_zLast.begin(), _zLast.end(), 0.0);
+
+	_h = (initStepSize > 0.0) ? initStepSize : 1e-6;
+	_hLast = 0.0;
+	_hAcc = 0.0;
+	_errAcc = 1e-2;
+	_faccon = 1.0;
+	_first = true;
+	_reject = false;
+
+	updateWeights();
+}
+
+RadauIIA::Status RadauIIA::step(IDaeSystem& sys, double tStop)
+{
+	const double eps = std::numeric_limits<double>::epsilon();
+
+	unsigned int nErrTestFails = 0;
+	unsigned int nConvFails = 0;
+	while (true)
+	{
+		double h = _h;
+		if (_maxStepSize > 0.0)
+			h = std::min(h, _maxStepSize);
+
+		// Hit the stop time exactly
+		bool last = false;
+		if (_t + 1.0001 * h >= tStop)
+		{
+			h = tStop - _t;
+			last = true;
+		}
+
+		if ((h <= 0.0) || (0.1 * h <= std::abs(_t) * eps))
+			return Status::StepSizeTooSmall;
+
+		bool convFail = false;
+		Status status = Status::Success;
+		const Attempt result = attemptStep(sys, h, last, tStop, convFail, status);
+
+		if (result == Attempt::Accepted)
+			return Status::Success;
+		if (result == Attempt::Failed)
+			return status;
+
+		if (convFail)
+		{
+			++_nConvFails;
+			if (++nConvFails > _maxConvFails)
+				return Status::ConvFailure;
+		}
+		else
+		{
+			++_nErrTestFails;
+			if (++nErrTestFails > _maxErrTestFails)
+				return Status::ErrTestFailure;
+		}
+	}
+}
+
+RadauIIA::Status RadauIIA::advance(IDaeSystem& sys, double tOut, double tStop)
+{
+	const double tEnd = std::min(tOut, tStop);
+	unsigned int nSteps = 0;
+	while (_t < tEnd)
+	{
+		if ((_maxSteps > 0) && (nSteps >= _maxSteps))
+			return Status::TooMuchWork;
+
+		const Status status = step(sys, tStop);
+		if (status != Status::Success)
+			return status;
+
+		++nSteps;
+	}
+
+	return Status::Success;
+}
+
+RadauIIA::Attempt RadauIIA::attemptStep(IDaeSystem& sys, double h, bool last, double tStop, bool& convFail, Status& status)
+{
+	// The Jacobian is evaluated at the beginning of the step and factorized with shift gamma / h
+	int flag = sys.residualWithJacobian(_t, _y.data(), _yDot.data(), _tmpRes.data());
+	if (flag != 0)
+	{
+		// The point is fixed, so a smaller step size does not help
+		status = Status::SystemFailure;
+		return Attempt::Failed;
+	}
+
+	extrapolateStages(h);
+
+	unsigned int nIter = 0;
+	double hFactor = 0.5;
+	flag = newtonIteration(sys, h, nIter, hFactor);
+	if (flag == 0)
+	{
+		double err = 0.0;
+		flag = estimateError(sys, h, err);
+		if (flag == 0)
+		{
+			// Step size proposal, which is more cautious if many Newton iterations have been necessary
+			const double fac = std::min(safety, safety * (2 * _maxNewtonIter + 1) / static_cast<double>(nIter + 2 * _maxNewtonIter));
+			double quot = std::max(quotMin, std::min(quotMax, std::pow(err, 0.25) / fac));
+			double hNew = h / quot;
+
+			if (err < 1.0)
+			{
+				// Predictive step size control of Gustafsson
+				if (!_first)
+				{
+					const double facGus = std::max(quotMin, std::min(quotMax, (_hAcc / h) * std::pow(err * err / _errAcc, 0.25) / safety));
+					quot = std::max(quot, facGus);
+					hNew = h / quot;
+				}
+				_hAcc = h;
+				_errAcc = std::max(1e-2, err);
+
+				// Advance to the end of the step, which is the last stage
+				double const* const z1 = _z.data();
+				double const* const z2 = _z.data() + _n;
+				double const* const z3 = _z.data() + 2 * _n;
+
+				std::copy(_y.begin(), _y.end(), _yOld.begin());
+				for (unsigned int i = 0; i < _n; ++i)
+				{
+					_y[i] += z3[i];
+					_yDot[i] = (invA[2][0] * z1[i] + invA[2][1] * z2[i] + invA[2][2] * z3[i]) / h;
+				}
+
+				_tOld = _t;
+				_t = last ? tStop : _t + h;
+				_hLast = h;
+				_z.swap(_zLast);
+
+				// Do not increase the step size right after a rejection
+				if (_reject)
+					hNew = std::min(hNew, h);
+
+				_h = hNew;
+				_first = false;
+				_reject = false;
+				++_nSteps;
+
+				updateWeights();
+				return Attempt::Accepted;
+			}
+
+			// Error test failed
+			_h = _first ? 0.1 * h : hNew;
+			_reject = true;
+			return Attempt::Rejected;
+		}
+	}
+
+	if (flag < 0)
+	{
+		status = Status::SystemFailure;
+		return Attempt::Failed;
+	}
+
+	// Newton iteration failed to converge or the system failed recoverably
+	convFail = true;
+	_h = hFactor * h;
+	_reject = true;
+	return Attempt::Rejected;
+}
+
+int RadauIIA::newtonIteration(IDaeSystem& sys, double h, unsigned int& nIter, double& hFactor)
+{
+	const double eps = std::numeric_limits<double>::epsilon();
+
+	double* const z1 = _z.data();
+	double* const z2 = _z.data() + _n;
+	double* const z3 = _z.data() + 2 * _n;
+	double const* const dv1 = _work.data();
+	double const* const dv2 = _work.data() + _n;
+	double const* const dv3 = _work.data() + 2 * _n;
+
+	double faccon = std::pow(std::max(_faccon, eps), 0.8);
+	double dynOld = 0.0;
+	double thqOld = 0.0;
+
+	nIter = 0;
+	while (true)
+	{
+		if (nIter >= _maxNewtonIter)
+		{
+			hFactor = 0.5;
+			return 1;
+		}
+
+		int flag = stageResiduals(sys, h);
+		if (flag == 0)
+			flag = solveStageSystem(sys, h);
+
+		if (flag != 0)
+		{
+			hFactor = 0.5;
+			return flag;
+		}
+
+		++nIter;
+		++_nNewtonIter;
+
+		const double n1 = weightedNorm(dv1);
+		const double n2 = weightedNorm(dv2);
+		const double n3 = weightedNorm(dv3);
+		const double dyno = std::sqrt((n1 * n1 + n2 * n2 + n3 * n3) / 3.0);
+
+		// Estimate the rate of convergence
+		if ((nIter > 1) && (nIter < _maxNewtonIter))
+		{
+			const double thq = dyno / dynOld;
+			const double theta = (nIter == 2) ? thq : std::sqrt(thq * thqOld);
+			thqOld = thq;
+
+			if (theta >= 0.99)
+			{
+				// Diverging
+				hFactor = 0.5;
+				return 1;
+			}
+
+			faccon = theta / (1.0 - theta);
+			const double remaining = static_cast<double>(_maxNewtonIter - 1 - nIter);
+			const double dyth = faccon * dyno * std::pow(theta, remaining) / _newtonTol;
+			if (dyth >= 1.0)
+			{
+				// Convergence is predicted to fail, so retry with a step size that is expected to converge
+				const double qNewt = std::max(1e-4, std::min(20.0, dyth));
+				hFactor = 0.8 * std::pow(qNewt, -1.0 / (4.0 + remaining));
+				return 1;
+			}
+		}
+		dynOld = std::max(dyno, eps);
+
+		// Transform back: Z += (T x I) dV
+		for (unsigned int i = 0; i < _n; ++i)
+		{
+			z1[i] += T[0][0] * dv1[i] + T[0][1] * dv2[i] + T[0][2] * dv3[i];
+			z2[i] += T[1][0] * dv1[i] + T[1][1] * dv2[i] + T[1][2] * dv3[i];
+			z3[i] += T[2][0] * dv1[i] + T[2][1] * dv2[i];
+		}
+
+		if (faccon * dyno <= _newtonTol)
+		{
+			_faccon = faccon;
+			return 0;
+		}
+	}
+}
+
+int RadauIIA::stageResiduals(IDaeSystem& sys, double h)
+{
+	double const* const z1 = _z.data();
+	double const* const z2 = _z.data() + _n;
+	double const* const z3 = _z.data() + 2 * _n;
+	const double nodes[3] = {c1, c2, 1.0};
+
+	for (unsigned int stage = 0; stage < 3; ++stage)
+	{
+		double const* const zs = _z.data() + stage * _n;
+		for (unsigned int i = 0; i < _n; ++i)
+		{
+			_tmpY[i] = _y[i] + zs[i];
+			_tmpYdot[i] = (invA[stage][0] * z1[i] + invA[stage][1] * z2[i] + invA[stage][2] * z3[i]) / h;
+		}
+
+		const int flag = sys.residual(_t + nodes[stage] * h, _tmpY.data(), _tmpYdot.data(), _work.data() + stage * _n);
+		if (flag != 0)
+			return flag;
+	}
+
+	return 0;
+}
+
+int RadauIIA::solveStageSystem(IDaeSystem& sys, double h)
+{
+	double* const w1 = _work.data();
+	double* const w2 = _work.data() + _n;
+	double* const w3 = _work.data() + 2 * _n;
+
+	// Transform the right hand side: -(T^{-1} x I) G
+	for (unsigned int i = 0; i < _n; ++i)
+	{
+		const double g1 = w1[i];
+		const double g2 = w2[i];
+		const double g3 = w3[i];
+		w1[i] = -(TI[0][0] * g1 + TI[0][1] * g2 + TI[0][2] * g3);
+		w2[i] = -(TI[1][0] * g1 + TI[1][1] * g2 + TI[1][2] * g3);
+		w3[i] = -(TI[2][0] * g1 + TI[2][1] * g2 + TI[2][2] * g3);
+	}
+
+	const int flag = sys.linearSolve(gammaEig / h, _newtonTol, w1, _weight.data());
+	if (flag != 0)
+		return flag;
+
+	return solveComplexSystem(sys, h, w2, w3);
+}
+
+int RadauIIA::solveComplexSystem(IDaeSystem& sys, double h, double* x2, double* x3)
+{
+	const double shift = gammaEig / h;
+	const double a = (alphaEig - gammaEig) / h;
+	const double b = betaEig / h;
+	const unsigned int n = _n;
+
+	// Preconditioned right hand side
+	int flag = sys.linearSolve(shift, _newtonTol, x2, _weight.data());
+	if (flag == 0)
+		flag = sys.linearSolve(shift, _newtonTol, x3, _weight.data());
+	if (flag != 0)
+		return flag;
+
+	std::copy(x2, x2 + n, _gmresRhs.begin());
+	std::copy(x3, x3 + n, _gmresRhs.begin() + n);
+	std::copy(_weight.begin(), _weight.end(), _gmresWeight.begin());
+	std::copy(_weight.begin(), _weight.end(), _gmresWeight.begin() + n);
+
+	// The preconditioned right hand side is a good initial guess since the operator is close to the identity
+	// for the stiff components
+	std::copy(_gmresRhs.begin(), _gmresRhs.end(), _gmresSol.begin());
+
+	double* const dx2 = _tmpY.data();
+	double* const dx3 = _tmpYdot.data();
+	const linalg::CgsGmres::Status status = _gmres.solve([&](double const* x, double* z) -> int
+		{
+			double* const z2 = z;
+			double* const z3 = z + n;
+
+			sys.multiplyWithDerivativeJacobian(x, dx2);
+			sys.multiplyWithDerivativeJacobian(x + n, dx3);
+			for (unsigned int i = 0; i < n; ++i)
+			{
+				z2[i] = a * dx2[i] - b * dx3[i];
+				z3[i] = a * dx3[i] + b * dx2[i];
+			}
+
+			int flag = sys.linearSolve(shift, _newtonTol, z2, _weight.data());
+			if (flag == 0)
+				flag = sys.linearSolve(shift, _newtonTol, z3, _weight.data());
+			if (flag != 0)
+				return flag;
+
+			for (unsigned int i = 0; i < 2 * n; ++i)
+				z[i] += x[i];
+
+			return 0;
+		}, 0.05 * _newtonTol * std::sqrt(2.0 * n), _gmresWeight.data(), _gmresRhs.data(), _gmresSol.data());
+
+	_nLinearIter += _gmres.numIterations();
+
+	switch (status)
+	{
+		case linalg::CgsGmres::Status::Success:
+		case linalg::CgsGmres::Status::ResidualReduced:
+			// An inexact solution is acceptable in the simplified Newton iteration
+			std::copy(_gmresSol.begin(), _gmresSol.begin() + n, x2);
+			std::copy(_gmresSol.begin() + n, _gmresSol.end(), x3);
+			return 0;
+		case linalg::CgsGmres::Status::MatVecFailUnrecoverable:
+			return -1;
+		default:
+			return 1;
+	}
+}
+
+int RadauIIA::estimateError(IDaeSystem& sys, double h, double& err)
+{
+	double const* const z1 = _z.data();
+	double const* const z2 = _z.data() + _n;
+	double const* const z3 = _z.data() + 2 * _n;
+
+	// Since F is linear in yDot, the error estimate of RADAU5 for M yDot = f(t, y) is given by
+	// err = (dF/dy + gamma / h * dF/dyDot)^{-1} (-F(t_n, y_n, -sum_i dd_i Z_i / h))
+	for (unsigned int i = 0; i < _n; ++i)
+		_tmpYdot[i] = -(dd[0] * z1[i] + dd[1] * z2[i] + dd[2] * z3[i]) / h;
+
+	int flag = sys.residual(_t, _y.data(), _tmpYdot.data(), _tmpRes.data());
+	if (flag != 0)
+		return flag;
+
+	for (unsigned int i = 0; i < _n; ++i)
+		_tmpRes[i] = -_tmpRes[i];
+
+	flag = sys.linearSolve(gammaEig / h, _newtonTol, _tmpRes.data(), _weight.data());
+	if (flag != 0)
+		return flag;
+
+	err = std::max(weightedNorm(_tmpRes.data()), 1e-10);
+	if ((err < 1.0) || (!_first && !_reject))
+		return 0;
+
+	// Improve the estimate for stiff components in the first step and after rejections
+	for (unsigned int i = 0; i < _n; ++i)
+		_tmpY[i] = _y[i] + _tmpRes[i];
+
+	flag = sys.residual(_t, _tmpY.data(), _tmpYdot.data(), _tmpRes.data());
+	if (flag != 0)
+		return flag;
+
+	for (unsigned int i = 0; i < _n; ++i)
+		_tmpRes[i] = -_tmpRes[i];
+
+	flag = sys.linearSolve(gammaEig / h, _newtonTol, _tmpRes.data(), _weight.data());
+	if (flag != 0)
+		return flag;
+
+	err = std::max(weightedNorm(_tmpRes.data()), 1e-10);
+	return 0;
+}
+
+void RadauIIA::extrapolateStages(double h)
+{
+	if (_first || (_hLast <= 0.0))
+	{
+		std::fill(_z.begin(), _z.end(), 0.0);
+		return;
+	}
+
+	// Evaluate the collocation polynomial of the last step at the new stages
+	double const* const zl1 = _zLast.data();
+	double const* const zl2 = _zLast.data() + _n;
+	double const* const zl3 = _zLast.data() + 2 * _n;
+	const double nodes[3] = {c1, c2, 1.0};
+
+	for (unsigned int stage = 0; stage < 3; ++stage)
+	{
+		double L[3];
+		double dL[3];
+		collocationBasis(1.0 + nodes[stage] * h / _hLast, L, dL);
+
+		double* const zs = _z.data() + stage * _n;
+		for (unsigned int i = 0; i < _n; ++i)
+			zs[i] = L[0] * zl1[i] + L[1] * zl2[i] + (L[2] - 1.0) * zl3[i];
+	}
+}
+
+void RadauIIA::interpolate(double t, double* y, double* yDot) const
+{
+	if (_hLast <= 0.0)
+	{
+		std::copy(_y.begin(), _y.end(), y);
+		std::copy(_yDot.begin(), _yDot.end(), yDot);
+		return;
+	}
+
+	double L[3];
+	double dL[3];
+	collocationBasis((t - _tOld) / _hLast, L, dL);
+
+	double const* const zl1 = _zLast.data();
+	double const* const zl2 = _zLast.data() + _n;
+	double const* const zl3 = _zLast.data() + 2 * _n;
+	for (unsigned int i = 0; i < _n; ++i)
+	{
+		y[i] = _yOld[i] + L[0] * zl1[i] + L[1] * zl2[i] + L[2] * zl3[i];
+		yDot[i] = (dL[0] * zl1[i] + dL[1] * zl2[i] + dL[2] * zl3[i]) / _hLast;
+	}
+}
+
+void RadauIIA::errorWeights(double* weight) const
+{
+	for (unsigned int i = 0; i < _n; ++i)
+		weight[i] = 1.0 / (_relTol * std::abs(_y[i]) + ((_absTol.size() > 1) ? _absTol[i] : _absTol[0]));
+}
+
+void RadauIIA::resetCounters() CADET_NOEXCEPT
+{
+	_nSteps = 0;
+	_nNewtonIter = 0;
+	_nConvFails = 0;
+	_nErrTestFails = 0;
+	_nLinearIter = 0;
+}
+
+void RadauIIA::updateWeights()
+{
+	for (unsigned int i = 0; i < _n; ++i)
+		_weight[i] = 1.0 / (_rTol * std::abs(_y[i]) + ((_aTol.size() > 1) ? _aTol[i] : _aTol[0]));
+}
+
+double RadauIIA::weightedNorm(double const* x) const
+{
+	double sum = 0.0;
+	for (unsigned int i = 0; i < _n; ++i)
+	{
+		const double v = x[i] * _weight[i];
+		sum += v * v;
+	}
+	return std::sqrt(sum / _n);
+}
+
+} // namespace timeint
+
+} // namespace cadet
@@ -0,0 +1,311 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+/**
+ * @file
+ * Provides a three-stage Radau IIA implicit Runge-Kutta method for fully implicit DAEs.
+ */
+
+#ifndef LIBCADET_RADAUIIA_HPP_
+#define LIBCADET_RADAUIIA_HPP_
+
+#include "cadet/cadetCompilerInfo.hpp"
+#include "linalg/CgsGmres.hpp"
+
+#include <vector>
+#include <algorithm>
+
+namespace cadet
+{
+
+namespace timeint
+{
+
+/**
+ * @brief Fully implicit DAE system @f$ F(t, y, \dot{y}) = 0 @f$ integrated by RadauIIA
+ * @details The residual is assumed to be linear in @f$ \dot{y} @f$. The Jacobians @f$ \frac{\partial F}{\partial y} @f$
+ *          and @f$ \frac{\partial F}{\partial \dot{y}} @f$ are updated by residualWithJacobian(). All subsequent calls to
+ *          multiplyWithDerivativeJacobian() and linearSolve() refer to the point of the last Jacobian update.
+ *
+ *          Functions returning @c int return @c 0 on success, a positive value on recoverable and a negative
+ *          value on unrecoverable error.
+ */
+class IDaeSystem
+{
+public:
+	virtual ~IDaeSystem() CADET_NOEXCEPT { }
+
+	/**
+	 * @brief Evaluates the residual
+	 * @param [in] t Time point
+	 * @param [in] y State vector
+	 * @param [in] yDot Time derivative of the state vector
+	 * @param [out] res Residual vector
+	 * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+	 */
+	virtual int residual(double t, double const* y, double const* yDot, double* res) = 0;
+
+	/**
+	 * @brief Evaluates the residual and updates the Jacobians
+	 * @param [in] t Time point
+	 * @param [in] y State vector
+	 * @param [in] yDot Time derivative of the state vector
+	 * @param [out] res Residual vector
+	 * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+	 */
+	virtual int residualWithJacobian(double t, double const* y, double const* yDot, double* res) = 0;
+
+	/**
+	 * @brief Multiplies a vector with the time derivative Jacobian
+	 * @details Computes @f$ z = \frac{\partial F}{\partial \dot{y}} x @f$.
+	 * @param [in] x Vector @f$ x @f$
+	 * @param [out] z Result @f$ z @f$
+	 */
+	virtual void multiplyWithDerivativeJacobian(double const* x, double* z) = 0;
+
+	/**
+	 * @brief Solves the linear system @f$ \left( \frac{\partial F}{\partial y} + \alpha \frac{\partial F}{\partial \dot{y}} \right) x = b @f$
+	 * @details All calls between two Jacobian updates use the same @f$ \alpha @f$, which allows
+	 *          to factorize the matrix once after each Jacobian update.
+	 * @param [in] alpha Value of @f$ \alpha @f$
+	 * @param [in] tol Error tolerance of the Newton iteration
+	 * @param [in,out] rhs On entry the right hand side @f$ b @f$, on exit the solution @f$ x @f$
+	 * @param [in] weight Error weights
+	 * @return @c 0 on success, @c -1 on non-recoverable error, and @c +1 on recoverable error
+	 */
+	virtual int linearSolve(double alpha, double tol, double* rhs, double const* weight) = 0;
+};
+
+
+/**
+ * @brief Three-stage Radau IIA implicit Runge-Kutta method of order 5 for fully implicit DAEs of index 1
+ * @details The method follows RADAU5 by Hairer and Wanner (Solving Ordinary Differential Equations II,
+ *          Section IV.8): The stage increments @f$ Z_i = Y_i - y_n @f$ are computed by a simplified
+ *          Newton iteration with the Jacobian evaluated at the beginning of the step. The coupled stage
+ *          system is decoupled by the eigendecomposition of the inverse Runge-Kutta matrix into a real
+ *          system with shift @f$ \gamma / h @f$ and a complex conjugate pair with shift @f$ (\alpha \pm i \beta) / h @f$.
+ *
+ *          Since IDaeSystem only provides solves with a single real shift per Jacobian update, the real
+ *          system is solved directly, whereas the complex pair is solved in its real @f$ 2n @f$-dimensional
+ *          form by GMRES preconditioned with the real system. The preconditioned operator is
+ *          @f[ I + \begin{pmatrix} (\alpha - \gamma) K & -\beta K \\ \beta K & (\alpha - \gamma) K \end{pmatrix}, \quad K = \frac{1}{h} \left( \frac{\partial F}{\partial y} + \frac{\gamma}{h} \frac{\partial F}{\partial \dot{y}} \right)^{-1} \frac{\partial F}{\partial \dot{y}}, @f]
+ *          whose spectrum is clustered around @f$ 1 @f$ and @f$ (\alpha \pm i \beta) / \gamma @f$.
+ *
+ *          The local error is estimated by the embedded formula of RADAU5 and the step size is controlled
+ *          by the predictive controller of Gustafsson. The tolerances are transformed as in RADAU5 such that
+ *          they yield a similar accuracy as with BDF methods. Dense output is provided by the collocation
+ *          polynomial of the last step.
+ */
+class RadauIIA
+{
+public:
+
+	/**
+	 * @brief Result of a time step
+	 */
+	enum class Status : int
+	{
+		Success, //!< Step has been taken
+		TooMuchWork, //!< Maximum number of steps has been taken without reaching the output time
+		ErrTestFailure, //!< Too many error test failures in one step
+		ConvFailure, //!< Too many convergence failures of the Newton iteration in one step
+		StepSizeTooSmall, //!< Step size has become too small
+		SystemFailure //!< Unrecoverable failure of the DAE system
+	};
+
+	RadauIIA();
+
+	/**
+	 * @brief Allocates memory for a system of the given size
+	 * @param [in] nDof Number of degrees of freedom
+	 */
+	void initialize(unsigned int nDof);
+
+	/**
+	 * @brief Sets the error tolerances
+	 * @details The tolerances are given in the same way as for IDAS and transformed internally.
+	 * @param [in] relTol Relative tolerance
+	 * @param [in] absTol Absolute tolerances
+	 * @param [in] vectorAbsTol Determines whether @p absTol contains one tolerance for each degree of freedom or a single value
+	 */
+	void setTolerances(double relTol, double const* absTol, bool vectorAbsTol);
+
+	/**
+	 * @brief Starts the time integration at a consistent initial point
+	 * @details The history of previous steps is discarded.
+	 * @param [in] t Initial time point
+	 * @param [in] y Initial state vector
+	 * @param [in] yDot Initial time derivative of the state vector
+	 * @param [in] initStepSize Initial step size (non-positive values select a default)
+	 */
+	void reinit(double t, double const* y, double const* yDot, double initStepSize);
+
+	/**
+	 * @brief Takes one step that does not pass the stop time
+	 * @param [in] sys DAE system
+	 * @param [in] tStop Stop time
+	 * @return Status of the step
+	 */
+	Status step(IDaeSystem& sys, double tStop);
+
+	/**
+	 * @brief Takes steps until the output time is reached or passed
+	 * @details At most maxSteps() steps are taken. The solution at @p tOut is obtained by interpolate().
+	 * @param [in] sys DAE system
+	 * @param [in] tOut Output time
+	 * @param [in] tStop Stop time, which is never passed
+	 * @return Status of the last step
+	 */
+	Status advance(IDaeSystem& sys, double tOut, double tStop);
+
+	/**
+	 * @brief Evaluates the collocation polynomial of the last step
+	 * @details The time point @p t is supposed to lie in the last step.
+	 * @param [in] t Time point
+	 * @param [out] y State vector at @p t
+	 * @param [out] yDot Time derivative of the state vector at @p t
+	 */
+	void interpolate(double t, double* y, double* yDot) const;
+
+	/**
+	 * @brief Computes the error weights @f$ 1 / (\text{relTol} \left| y_i \right| + \text{absTol}_i) @f$ of the current state
+	 * @details The weights are based on the untransformed tolerances and match the error weights of IDAS.
+	 * @param [out] weight Error weights
+	 */
+	void errorWeights(double* weight) const;
+
+	inline unsigned int size() const CADET_NOEXCEPT { return _n; }
+	inline double time() const CADET_NOEXCEPT { return _t; }
+	inline double const* state() const CADET_NOEXCEPT { return _y.data(); }
+	inline double const* stateDerivative() const CADET_NOEXCEPT { return _yDot.data(); }
+
+	/**
+	 * @brief Returns the size of the last accepted step
+	 * @return Size of the last accepted step
+	 */
+	inline double lastStepSize() const CADET_NOEXCEPT { return _hLast; }
+
+	/**
+	 * @brief Returns the size of the next step attempt
+	 * @return Size of the next step attempt
+	 */
+	inline double nextStepSize() const CADET_NOEXCEPT { return _h; }
+
+	inline unsigned int maxSteps() const CADET_NOEXCEPT { return _maxSteps; }
+	inline void maxSteps(unsigned int n) CADET_NOEXCEPT { _maxSteps = n; }
+	inline double maxStepSize() const CADET_NOEXCEPT { return _maxStepSize; }
+	inline void maxStepSize(double h) CADET_NOEXCEPT { _maxStepSize = h; }
+	inline unsigned int maxNewtonIter() const CADET_NOEXCEPT { return _maxNewtonIter; }
+	inline void maxNewtonIter(unsigned int n) CADET_NOEXCEPT { _maxNewtonIter = std::max(n, 2u); }
+	inline unsigned int maxErrTestFails() const CADET_NOEXCEPT { return _maxErrTestFails; }
+	inline void maxErrTestFails(unsigned int n) CADET_NOEXCEPT { _maxErrTestFails = n; }
+	inline unsigned int maxConvFails() const CADET_NOEXCEPT { return _maxConvFails; }
+	inline void maxConvFails(unsigned int n) CADET_NOEXCEPT { _maxConvFails = n; }
+
+	/**
+	 * @brief Sets the dimension of the Krylov space used for the complex stage system
+	 * @details Takes effect on the next call to initialize().
+	 * @param [in] n Maximum number of Krylov vectors
+	 */
+	inline void maxKrylov(unsigned int n) CADET_NOEXCEPT { _maxKrylov = std::max(n, 1u); }
+	inline unsigned int maxKrylov() const CADET_NOEXCEPT { return _maxKrylov; }
+
+	/**
+	 * @brief Resets all counters
+	 */
+	void resetCounters() CADET_NOEXCEPT;
+
+	inline unsigned long numSteps() const CADET_NOEXCEPT { return _nSteps; }
+	inline unsigned long numNewtonIter() const CADET_NOEXCEPT { return _nNewtonIter; }
+	inline unsigned long numConvFails() const CADET_NOEXCEPT { return _nConvFails; }
+	inline unsigned long numErrTestFails() const CADET_NOEXCEPT { return _nErrTestFails; }
+
+	/**
+	 * @brief Returns the number of GMRES iterations spent on the complex stage systems
+	 * @return Number of GMRES iterations
+	 */
+	inline unsigned long numLinearIter() const CADET_NOEXCEPT { return _nLinearIter; }
+
+protected:
+
+	/**
+	 * @brief Action taken after a step attempt
+	 */
+	enum class Attempt : int
+	{
+		Accepted, //!< Step has been accepted
+		Rejected, //!< Step has been rejected and is retried with a smaller step size
+		Failed //!< Unrecoverable failure
+	};
+
+	Attempt attemptStep(IDaeSystem& sys, double h, bool last, double tStop, bool& convFail, Status& status);
+	int newtonIteration(IDaeSystem& sys, double h, unsigned int& nIter, double& hFactor);
+	int stageResiduals(IDaeSystem& sys, double h);
+	int solveStageSystem(IDaeSystem& sys, double h);
+	int solveComplexSystem(IDaeSystem& sys, double h, double* x2, double* x3);
+	int estimateError(IDaeSystem& sys, double h, double& err);
+	void extrapolateStages(double h);
+	void updateWeights();
+	double weightedNorm(double const* x) const;
+
+	unsigned int _n; //!< Number of degrees of freedom
+	double _relTol; //!< Relative tolerance as given by the user
+	std::vector<double> _absTol; //!< Absolute tolerances as given by the user (one or one per DOF)
+	double _rTol; //!< Transformed relative tolerance
+	std::vector<double> _aTol; //!< Transformed absolute tolerances (one or one per DOF)
+	double _newtonTol; //!< Tolerance of the Newton iteration
+
+	double _t; //!< Current time
+	double _tOld; //!< Time at the beginning of the last accepted step
+	double _h; //!< Size of the next step attempt
+	double _hLast; //!< Size of the last accepted step
+	double _hAcc; //!< Size of the last accepted step used by the predictive step size controller
+	double _errAcc; //!< Error of the last accepted step used by the predictive step size controller
+	double _faccon; //!< Contraction estimate of the Newton iteration carried over to the next step
+	bool _first; //!< Determines whether no step has been accepted since the last reinit()
+	bool _reject; //!< Determines whether the last step attempt has been rejected
+
+	std::vector<double> _y; //!< Current state vector
+	std::vector<double> _yDot; //!< Time derivative of the current state vector
+	std::vector<double> _yOld; //!< State vector at the beginning of the last accepted step
+	std::vector<double> _weight; //!< Scaling weights of the current state (based on transformed tolerances)
+	std::vector<double> _z; //!< Stage increments of the current step attempt (3 blocks)
+	std::vector<double> _zLast; //!< Stage increments of the last accepted step (3 blocks)
+	std::vector<double> _work; //!< Stage residuals and Newton increments (3 blocks)
+	std::vector<double> _tmpY; //!< Temporary state vector
+	std::vector<double> _tmpYdot; //!< Temporary time derivative vector
+	std::vector<double> _tmpRes; //!< Temporary residual vector
+
+	linalg::CgsGmres _gmres; //!< GMRES for the complex stage system
+	std::vector<double> _gmresRhs; //!< Right hand side of the complex stage system
+	std::vector<double> _gmresSol; //!< Solution of the complex stage system
+	std::vector<double> _gmresWeight; //!< Weights of the complex stage system
+	unsigned int _maxKrylov; //!< Maximum number of Krylov vectors
+
+	unsigned int _maxSteps; //!< Maximum number of steps in advance()
+	double _maxStepSize; //!< Maximum step size (non-positive disables)
+	unsigned int _maxNewtonIter; //!< Maximum number of Newton iterations
+	unsigned int _maxErrTestFails; //!< Maximum number of error test failures in one step
+	unsigned int _maxConvFails; //!< Maximum number of Newton convergence failures in one step
+
+	unsigned long _nSteps; //!< Number of accepted steps
+	unsigned long _nNewtonIter; //!< Number of Newton iterations
+	unsigned long _nConvFails; //!< Number of Newton convergence failures
+	unsigned long _nErrTestFails; //!< Number of error test failures
+	unsigned long _nLinearIter; //!< Number of GMRES iterations
+};
+
+} // namespace timeint
+
+} // namespace cadet
+
+#endif  // LIBCADET_RADAUIIA_HPP_
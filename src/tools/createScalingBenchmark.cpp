@@ -0,0 +1,401 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <tclap/CmdLine.h>
+#include "common/TclapUtils.hpp"
+#include "io/hdf5/HDF5Writer.hpp"
+#include "ToolsHelper.hpp"
+
+struct ProgramOptions
+{
+	std::string fileName;
+	bool isKinetic;
+	bool solverTimes;
+	double endTime;
+	bool adJacobian;
+	int nPar;
+	int nCol;
+	int nComp;
+	int nParType;
+	int width;
+	int nThreads;
+	std::string scaleDim;
+	std::vector<int> factors;
+	std::string outSol;
+	std::string unitType;
+};
+
+/**
+ * @brief Size of a problem of the family
+ */
+struct ProblemSize
+{
+	int nCol; //!< Number of axial cells
+	int nPar; //!< Number of particle cells
+	int nComp; //!< Number of components
+	int nParType; //!< Number of particle types
+	int width; //!< Number of parallel columns in the flowsheet
+};
+
+/**
+ * @brief Writes a load-wash problem with the given size
+ * @details The flowsheet consists of an inlet (unit @c 0) that feeds @c width identical columns
+ *          (units @c 1 to @c width), which are all connected to an outlet (unit @c width+1).
+ *          All components bind with linear isotherms of different strength and all particle
+ *          types share the same binding model.
+ * @param [in] fileName Name of the output file
+ * @param [in] size Size of the problem
+ * @param [in] opts Program options
+ */
+void writeProblem(const std::string& fileName, const ProblemSize& size, const ProgramOptions& opts)
+{
+	cadet::io::HDF5Writer writer;
+	writer.openFile(fileName, "co");
+	writer.pushGroup("input");
+
+	const bool hasParticles = (opts.unitType != "LUMPED_RATE_MODEL_WITHOUT_PORES");
+	const int nComp = size.nComp;
+	const int nParType = size.nParType;
+	const double feedTime = 60.0;
+
+	// Model
+	{
+		Scope<cadet::io::HDF5Writer> s(writer, "model");
+		writer.scalar<int>("NUNITS", size.width + 2);
+
+		// Inlet - unit 000
+		{
+			Scope<cadet::io::HDF5Writer> su(writer, "unit_000");
+
+			writer.scalar("UNIT_TYPE", std::string("INLET"));
+			writer.scalar("INLET_TYPE", std::string("PIECEWISE_CUBIC_POLY"));
+			writer.scalar<int>("NCOMP", nComp);
+
+			const std::vector<double> feed(nComp, 1.0);
+			const std::vector<double> zero(nComp, 0.0);
+			{
+				Scope<cadet::io::HDF5Writer> s3(writer, "sec_000");
+
+				writer.vector<double>("CONST_COEFF", nComp, feed.data());
+				writer.vector<double>("LIN_COEFF", nComp, zero.data());
+				writer.vector<double>("QUAD_COEFF", nComp, zero.data());
+				writer.vector<double>("CUBE_COEFF", nComp, zero.data());
+			}
+			{
+				Scope<cadet::io::HDF5Writer> s3(writer, "sec_001");
+
+				writer.vector<double>("CONST_COEFF", nComp, zero.data());
+				writer.vector<double>("LIN_COEFF", nComp, zero.data());
+				writer.vector<double>("QUAD_COEFF", nComp, zero.data());
+				writer.vector<double>("CUBE_COEFF", nComp, zero.data());
+			}
+		}
+
+		// Columns - units 001 to width
+		std::ostringstream oss;
+		for (int col = 1; col <= size.width; ++col)
+		{
+			oss.str("");
+			oss << "unit_" << std::setfill('0') << std::setw(3) << col;
+			Scope<cadet::io::HDF5Writer> su(writer, oss.str());
+
+			writer.scalar("UNIT_TYPE", opts.unitType);
+			writer.scalar<int>("NCOMP", nComp);
+
+			// Transport
+			writer.scalar<double>("VELOCITY", 5.75e-4);
+			writer.scalar<double>("COL_DISPERSION", 5.75e-8);
+
+			std::vector<double> filmDiff(nComp * nParType, 6.9e-6);
+			std::vector<double> parDiff(nComp * nParType);
+			std::vector<double> parSurfDiff(nComp * nParType, 0.0);
+			for (int t = 0; t < nParType; ++t)
+			{
+				for (int c = 0; c < nComp; ++c)
+					parDiff[t * nComp + c] = 7e-10 / (1.0 + c);
+			}
+
+			// Geometry
+			writer.scalar<double>("COL_LENGTH", 0.014);
+			writer.scalar<double>("COL_POROSITY", 0.37);
+			writer.scalar<double>("TOTAL_POROSITY", 0.37 + (1.0 - 0.37) * 0.75);
+
+			if (hasParticles)
+			{
+				writer.scalar<int>("NPARTYPE", nParType);
+				writer.vector<double>("FILM_DIFFUSION", filmDiff.size(), filmDiff.data());
+				writer.vector<double>("PAR_DIFFUSION", parDiff.size(), parDiff.data());
+				writer.vector<double>("PAR_SURFDIFFUSION", parSurfDiff.size(), parSurfDiff.data());
+
+				// Particle types differ in size
+				std::vector<double> parRadius(nParType);
+				const std::vector<double> parCoreRadius(nParType, 0.0);
+				const std::vector<double> parPorosity(nParType, 0.75);
+				const std::vector<double> volFrac(nParType, 1.0 / nParType);
+				for (int t = 0; t < nParType; ++t)
+					parRadius[t] = 4.5e-5 * (1.0 - 0.5 * t / nParType);
+
+				writer.vector<double>("PAR_RADIUS", nParType, parRadius.data());
+				writer.vector<double>("PAR_CORERADIUS", nParType, parCoreRadius.data());
+				writer.vector<double>("PAR_POROSITY", nParType, parPorosity.data());
+				writer.vector<double>("PAR_TYPE_VOLFRAC", nParType, volFrac.data());
+			}
+
+			// Initial conditions
+			const std::vector<double> zero(nComp, 0.0);
+			writer.vector<double>("INIT_C", nComp, zero.data());
+			writer.vector<double>("INIT_Q", nComp, zero.data());
+
+			// Adsorption
+			writer.scalar("ADSORPTION_MODEL", std::string("LINEAR"));
+			writer.scalar<int>("ADSORPTION_MODEL_MULTIPLEX", 1);
+			{
+				Scope<cadet::io::HDF5Writer> s2(writer, "adsorption");
+
+				writer.scalar<int>("IS_KINETIC", opts.isKinetic);
+
+				std::vector<double> kA(nComp);
+				const std::vector<double> kD(nComp, 1.0);
+				for (int c = 0; c < nComp; ++c)
+					kA[c] = 1.0 + 2.0 * c;
+
+				writer.vector<double>("LIN_KA", nComp, kA.data());
+				writer.vector<double>("LIN_KD", nComp, kD.data());
+			}
+
+			// Discretization
+			{
+				Scope<cadet::io::HDF5Writer> s2(writer, "discretization");
+
+				writer.scalar<int>("NCOL", size.nCol);
+				writer.scalar<int>("NPAR", size.nPar);
+				const std::vector<int> nBound(nComp, 1);
+				writer.vector<int>("NBOUND", nComp, nBound.data());
+
+				writer.scalar("PAR_DISC_TYPE", std::string("EQUIDISTANT_PAR"));
+
+				writer.scalar<int>("USE_ANALYTIC_JACOBIAN", !opts.adJacobian);
+				writer.scalar<int>("MAX_KRYLOV", 0);
+				writer.scalar<int>("GS_TYPE", 1);
+				writer.scalar<int>("MAX_RESTARTS", 10);
+				writer.scalar<double>("SCHUR_SAFETY", 1e-8);
+
+				// WENO
+				{
+					Scope<cadet::io::HDF5Writer> s3(writer, "weno");
+
+					writer.scalar<int>("WENO_ORDER", 3);
+					writer.scalar<int>("BOUNDARY_MODEL", 0);
+					writer.scalar<double>("WENO_EPS", 1e-10);
+				}
+			}
+		}
+
+		// Outlet - unit width+1
+		{
+			oss.str("");
+			oss << "unit_" << std::setfill('0') << std::setw(3) << size.width + 1;
+			Scope<cadet::io::HDF5Writer> su(writer, oss.str());
+
+			writer.scalar("UNIT_TYPE", std::string("OUTLET"));
+			writer.scalar<int>("NCOMP", nComp);
+		}
+
+		// Valve switches
+		{
+			Scope<cadet::io::HDF5Writer> su(writer, "connections");
+			writer.scalar<int>("NSWITCHES", 1);
+			writer.scalar<int>("CONNECTIONS_INCLUDE_PORTS", 1);
+
+			{
+				Scope<cadet::io::HDF5Writer> s1(writer, "switch_000");
+
+				// Inlet feeds all columns, all columns are connected to the outlet
+				std::vector<double> connMatrix;
+				connMatrix.reserve(size.width * 2 * 7);
+				for (int col = 1; col <= size.width; ++col)
+				{
+					const double conn[] = {0.0, static_cast<double>(col), -1.0, -1.0, -1.0, -1.0, 1.0,
+					                       static_cast<double>(col), static_cast<double>(size.width + 1), -1.0, -1.0, -1.0, -1.0, 1.0};
+					connMatrix.insert(connMatrix.end(), conn, conn + 14);
+				}
+
+				writer.vector<double>("CONNECTIONS", connMatrix.size(), connMatrix.data());
+				writer.scalar<int>("SECTION", 0);
+			}
+		}
+
+		// Solver settings
+		{
+			Scope<cadet::io::HDF5Writer> su(writer, "solver");
+
+			writer.scalar<int>("MAX_KRYLOV", 0);
+			writer.scalar<int>("GS_TYPE", 1);
+			writer.scalar<int>("MAX_RESTARTS", 10);
+			writer.scalar<double>("SCHUR_SAFETY", 1e-8);
+		}
+	}
+
+	// Return
+	{
+		Scope<cadet::io::HDF5Writer> s(writer, "return");
+		writer.template scalar<int>("WRITE_SOLUTION_TIMES", true);
+
+		std::ostringstream oss;
+		for (int col = 1; col <= size.width; ++col)
+		{
+			oss.str("");
+			oss << "unit_" << std::setfill('0') << std::setw(3) << col;
+
+			Scope<cadet::io::HDF5Writer> s2(writer, oss.str());
+			parseAndWriteOutputFormatsFromCmdLine(writer, opts.outSol, "");
+		}
+	}
+
+	// Solver
+	{
+		Scope<cadet::io::HDF5Writer> s(writer, "solver");
+
+		if (!opts.solverTimes)
+		{
+			std::vector<double> solTimes;
+			solTimes.reserve(static_cast<std::size_t>(opts.endTime) + 1);
+			for (double t = 0.0; t <= opts.endTime; t += 1.0)
+				solTimes.push_back(t);
+
+			writer.vector<double>("USER_SOLUTION_TIMES", solTimes.size(), solTimes.data());
+		}
+
+		writer.scalar<int>("NTHREADS", opts.nThreads);
+
+		// Sections
+		{
+			Scope<cadet::io::HDF5Writer> s2(writer, "sections");
+
+			writer.scalar<int>("NSEC", 2);
+
+			const double secTimes[] = {0.0, feedTime, opts.endTime};
+			writer.vector<double>("SECTION_TIMES", 3, secTimes);
+
+			const int secCont[] = {0};
+			writer.vector<int>("SECTION_CONTINUITY", 1, secCont);
+		}
+
+		// Time integrator
+		{
+			Scope<cadet::io::HDF5Writer> s2(writer, "time_integrator");
+
+			writer.scalar<double>("ABSTOL", 1e-8);
+			writer.scalar<double>("RELTOL", 1e-6);
+			writer.scalar<double>("ALGTOL", 1e-12);
+			writer.scalar<double>("INIT_STEP_SIZE", 1e-6);
+			writer.scalar<int>("MAX_STEPS", 100000);
+		}
+	}
+
+	writer.closeFile();
+}
+
+int main(int argc, char** argv)
+{
+	ProgramOptions opts;
+
+	try
+	{
+		TCLAP::CustomOutputWithoutVersion customOut("createScalingBenchmark");
+		TCLAP::CmdLine cmd("Create HDF5 input files for strong and weak scaling benchmarks with tunable problem size", ' ', "1.0");
+		cmd.setOutput(&customOut);
+
+		cmd >> (new TCLAP::ValueArg<std::string>("o", "out", "Write output to file (default: Scaling.h5)", false, "Scaling.h5", "File"))->storeIn(&opts.fileName);
+		cmd >> (new TCLAP::ValueArg<double>("T", "endTime", "End time of simulation (default: 600sec)", false, 600.0, "Time"))->storeIn(&opts.endTime);
+		cmd >> (new TCLAP::ValueArg<int>("", "comp", "Number of components (default: 4)", false, 4, "Value"))->storeIn(&opts.nComp);
+		cmd >> (new TCLAP::ValueArg<int>("", "parTypes", "Number of particle types (default: 1)", false, 1, "Value"))->storeIn(&opts.nParType);
+		cmd >> (new TCLAP::ValueArg<int>("", "width", "Number of parallel columns in the flowsheet (default: 1)", false, 1, "Value"))->storeIn(&opts.width);
+		cmd >> (new TCLAP::ValueArg<std::string>("", "scale", "Dimension scaled by the factors (col, par, comp, parTypes, width; default: col)", false, "col", "Dim"))->storeIn(&opts.scaleDim);
+		cmd >> (new TCLAP::MultiArg<int>("f", "factor", "Create a file for each factor with the scaled dimension multiplied by the factor", false, "Value"))->storeIn(&opts.factors);
+		addMiscToCmdLine(cmd, opts);
+		addUnitTypeToCmdLine(cmd, opts.unitType);
+		addOutputParserToCmdLine(cmd, opts.outSol);
+
+		cmd.parse(argc, argv);
+	}
+	catch (const TCLAP::ArgException &e)
+	{
+		std::cerr << "ERROR: " << e.error() << " for argument " << e.argId() << std::endl;
+		return 1;
+	}
+
+	parseUnitType(opts.unitType);
+	if ((opts.unitType != "GENERAL_RATE_MODEL") && (opts.unitType != "LUMPED_RATE_MODEL_WITH_PORES") && (opts.unitType != "LUMPED_RATE_MODEL_WITHOUT_PORES"))
+	{
+		std::cerr << "ERROR: Unit type " << opts.unitType << " is not supported" << std::endl;
+		return 1;
+	}
+
+	if ((opts.nCol <= 0) || (opts.nPar <= 0) || (opts.nComp <= 0) || (opts.nParType <= 0) || (opts.width <= 0))
+	{
+		std::cerr << "ERROR: Problem dimensions have to be positive" << std::endl;
+		return 1;
+	}
+
+	const ProblemSize baseSize{opts.nCol, opts.nPar, opts.nComp, opts.nParType, opts.width};
+	if (opts.factors.empty())
+	{
+		writeProblem(opts.fileName, baseSize, opts);
+		return 0;
+	}
+
+	// Write a family of problems with names <base>_x<factor>.<ext>
+	const std::size_t dotPos = opts.fileName.find_last_of('.');
+	const std::string baseName = opts.fileName.substr(0, dotPos);
+	const std::string ext = (dotPos == std::string::npos) ? std::string(".h5") : opts.fileName.substr(dotPos);
+
+	for (int f : opts.factors)
+	{
+		if (f <= 0)
+		{
+			std::cerr << "ERROR: Factors have to be positive" << std::endl;
+			return 1;
+		}
+
+		ProblemSize size = baseSize;
+		if (opts.scaleDim == "col")
+			size.nCol *= f;
+		else if (opts.scaleDim == "par")
+			size.nPar *= f;
+		else if (opts.scaleDim == "comp")
+			size.nComp *= f;
+		else if (opts.scaleDim == "parTypes")
+			size.nParType *= f;
+		else if (opts.scaleDim == "width")
+			size.width *= f;
+		else
+		{
+			std::cerr << "ERROR: Unknown dimension " << opts.scaleDim << std::endl;
+			return 1;
+		}
+
+		std::ostringstream oss;
+		oss << baseName << "_x" << f << ext;
+		writeProblem(oss.str(), size, opts);
+		std::cout << oss.str() << ": NCOL = " << size.nCol << ", NPAR = " << size.nPar << ", NCOMP = " << size.nComp
+			<< ", NPARTYPE = " << size.nParType << ", WIDTH = " << size.width << std::endl;
+	}
+
+	return 0;
+}
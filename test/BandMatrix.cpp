@@ -17,6 +17,7 @@
 #include <algorithm>
 
 #include "linalg/BandMatrix.hpp"
+#include "linalg/BlockTridiagonalMatrix.hpp"
 #include "linalg/Norms.hpp"
 
 #include "MatrixHelper.hpp"
@@ -178,3 +179,84 @@ TEST_CASE("BandMatrix::submatrixMultiplyVector", "[BandMatrix],[LinAlg]")
 		testSubMatrixMultiply(bm, 3, -1, 1, 3, {36, 37, 38});
 	}
 }
+
+/**
+ * @brief Creates a block tridiagonal BandMatrix with diagonal off-diagonal blocks
+ * @details The pattern corresponds to a particle Jacobian of the general rate model without surface diffusion.
+ *          Only the first @p nCoupled entries of each off-diagonal block are nonzero.
+ * @param [in] nBlocks Number of diagonal blocks
+ * @param [in] blockSize Size of the blocks
+ * @param [in] nCoupled Number of nonzero entries in the off-diagonal blocks
+ * @return Block tridiagonal matrix in banded storage
+ */
+inline cadet::linalg::BandMatrix createBlockTridiagonalBandMatrix(unsigned int nBlocks, unsigned int blockSize, unsigned int nCoupled)
+{
+	cadet::linalg::BandMatrix bm;
+	bm.resize(nBlocks * blockSize, blockSize, blockSize);
+	bm.setAll(0.0);
+
+	const int s = static_cast<int>(blockSize);
+	for (int row = 0; row < static_cast<int>(bm.rows()); ++row)
+	{
+		const int blk = row / s;
+		const int i = row % s;
+		for (int col = std::max(0, row - s); col < std::min(static_cast<int>(bm.rows()), row + s + 1); ++col)
+		{
+			const int colBlk = col / s;
+			if (colBlk == blk)
+				bm(row, col - row) = std::sin(0.7 * row + 1.3 * col) + ((col == row) ? 2.0 * s : 0.0);
+			else if ((col % s == i) && (i < static_cast<int>(nCoupled)))
+				bm(row, col - row) = -1.0 - 0.1 * std::cos(0.3 * row);
+		}
+	}
+	return bm;
+}
+
+TEST_CASE("BlockTridiagonalMatrix solves like FactorizableBandMatrix", "[BandMatrix],[LinAlg]")
+{
+	using cadet::linalg::BandMatrix;
+	using cadet::linalg::FactorizableBandMatrix;
+	using cadet::linalg::BlockTridiagonalMatrix;
+
+	for (unsigned int blockSize : {4u, 12u, 30u})
+	{
+		SECTION("Block size " + std::to_string(blockSize))
+		{
+			const unsigned int nBlocks = 10;
+			const BandMatrix bm = createBlockTridiagonalBandMatrix(nBlocks, blockSize, blockSize / 2);
+			FactorizableBandMatrix fbm = fromBandMatrix(bm);
+
+			BlockTridiagonalMatrix btm;
+			btm.resize(nBlocks, blockSize);
+			btm.copyOver(bm);
+
+			// Prepare some right hand side
+			std::vector<double> y(bm.rows(), 0.0);
+			for (unsigned int i = 0; i < bm.rows(); ++i)
+				y[i] = std::sin(6.283185307 * i / static_cast<double>(bm.rows()));
+
+			// Check matrix-vector product of copied pattern
+			std::vector<double> ref(bm.rows(), 0.0);
+			std::vector<double> res(bm.rows(), 0.0);
+			bm.multiplyVector(y.data(), ref.data());
+			btm.multiplyVector(y.data(), res.data());
+			for (unsigned int i = 0; i < bm.rows(); ++i)
+				CHECK(res[i] == Approx(ref[i]).epsilon(1e-12));
+
+			REQUIRE(fbm.factorize());
+			REQUIRE(btm.factorize());
+
+			std::vector<double> xBand = y;
+			std::vector<double> xBlock = y;
+			REQUIRE(fbm.solve(xBand.data()));
+			REQUIRE(btm.solve(xBlock.data()));
+
+			for (unsigned int i = 0; i < bm.rows(); ++i)
+				CHECK(xBlock[i] == Approx(xBand[i]).epsilon(1e-10));
+
+			// Calculate residual in y
+			bm.multiplyVector(xBlock.data(), 1.0, -1.0, y.data());
+			CHECK(cadet::linalg::linfNorm(y.data(), y.size()) <= 1e-10);
+		}
+	}
+}
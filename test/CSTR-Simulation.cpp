@@ -22,6 +22,9 @@
 #include "SimHelper.hpp"
 #include "ParticleHelper.hpp"
 #include "common/Driver.hpp"
+#include "common/SimulatorPool.hpp"
+#include "common/PararealDriver.hpp"
+#include "common/WaveformRelaxationDriver.hpp"
 #include "UnitOperation.hpp"
 #include "SimulationTypes.hpp"
 
@@ -42,6 +45,60 @@ inline void setFlowRateFilter(cadet::JsonParameterProvider& jpp, double filter)
 	jpp.popScope();
 }
 
+inline void addOutletEvent(cadet::JsonParameterProvider& jpp, double threshold, int direction, const std::string& action)
+{
+	jpp.pushScope("solver");
+	jpp.addScope("events");
+	jpp.pushScope("events");
+
+	jpp.set("NEVENTS", 1);
+	jpp.addScope("event_000");
+	jpp.pushScope("event_000");
+
+	jpp.set("EVENT_TYPE", "OUTLET_CONCENTRATION");
+	jpp.set("EVENT_UNIT", 0);
+	jpp.set("EVENT_COMP", 0);
+	jpp.set("EVENT_THRESHOLD", threshold);
+	jpp.set("EVENT_DIRECTION", direction);
+	jpp.set("EVENT_ACTION", action);
+
+	jpp.popScope();
+	jpp.popScope();
+	jpp.popScope();
+}
+
+inline void setCSTRArray(cadet::JsonParameterProvider& jpp, int nTank, const std::vector<double>& volume, const std::vector<double>& connections, const std::vector<double>& initC)
+{
+	jpp.pushScope("model");
+	jpp.pushScope("unit_000");
+
+	jpp.set("UNIT_TYPE", "CSTR_ARRAY");
+	jpp.set("NTANK", nTank);
+	jpp.set("TANK_VOLUME", volume);
+	jpp.set("TANK_CONNECTIONS", connections);
+	jpp.set("INIT_C", initC);
+
+	jpp.popScope();
+	jpp.popScope();
+}
+
+inline void runArraySim(cadet::JsonParameterProvider& jpp, std::function<double(double)> solC)
+{
+	cadet::Driver drv;
+	drv.configure(jpp);
+	drv.run();
+
+	cadet::InternalStorageUnitOpRecorder const* const simData = drv.solution()->unitOperation(0);
+	double const* outlet = simData->outlet();
+	double const* time = drv.solution()->time();
+
+	for (unsigned int i = 0; i < simData->numDataPoints(); ++i, ++outlet, ++time)
+	{
+		CAPTURE(*time);
+		CHECK((*outlet) == cadet::test::makeApprox(solC(*time), 1e-6, 4e-5));
+	}
+}
+
 inline cadet::JsonParameterProvider createMultiParticleTypesTestCase()
 {
 	cadet::JsonParameterProvider jpp = createCSTRBenchmark(2, 100.0, 1.0);
@@ -159,6 +216,41 @@ TEST_CASE("CSTR vs analytic solution (V constant) w/o binding model", "[CSTR],[S
 	});
 }
 
+TEST_CASE("CSTR vs analytic solution with many short pulsed sections", "[CSTR],[Simulation],[Inlet]")
+{
+	// Pulsed injection with alternating inlet concentration on 200 sections of length 0.5
+	const unsigned int nSec = 200;
+	const double secLen = 0.5;
+
+	cadet::JsonParameterProvider jpp = createCSTRBenchmark(nSec, nSec * secLen, 1.0);
+
+	std::vector<double> secTimes(nSec + 1, 0.0);
+	for (unsigned int i = 0; i <= nSec; ++i)
+		secTimes[i] = i * secLen;
+
+	cadet::test::setSectionTimes(jpp, secTimes);
+	cadet::test::setInitialConditions(jpp, {0.0}, {}, 10.0);
+	for (unsigned int i = 0; i < nSec; ++i)
+		cadet::test::setInletProfile(jpp, i, 0, (i % 2 == 0) ? 1.0 : 0.0, 0.0, 0.0, 0.0);
+
+	// Volume is constant with residence time V / Q = 10
+	runSim(jpp, [=](double t) {
+			double c = 0.0;
+			for (unsigned int i = 0; i < nSec; ++i)
+			{
+				const double cIn = (i % 2 == 0) ? 1.0 : 0.0;
+				const double dt = std::min(t - secTimes[i], secLen);
+				c = cIn + (c - cIn) * std::exp(-dt / 10.0);
+				if (t <= secTimes[i + 1])
+					break;
+			}
+			return c;
+		}, 
+		[](double t) {
+			return 10.0;
+	});
+}
+
 TEST_CASE("CSTR vs analytic solution (V increasing) w/o binding model", "[CSTR],[Simulation]")
 {
 	cadet::JsonParameterProvider jpp = createCSTRBenchmark(1, 100.0, 1.0);
@@ -471,3 +563,503 @@ TEST_CASE("CSTR linear binding single particle matches particle distribution", "
 	cadet::JsonParameterProvider jpp = createMultiParticleTypesTestCase();
 	cadet::test::particle::testLinearMixedParticleTypes(jpp, 5e-8, 5e-5);
 }
+
+TEST_CASE("CSTR outlet event stops time integration", "[CSTR],[Simulation],[Event]")
+{
+	// Outlet concentration is c(t) = 1 + t / 20 - t^2 / 800, which reaches 1.3 at t = 20 - sqrt(160)
+	cadet::JsonParameterProvider jpp = createCSTRBenchmark(1, 100.0, 1.0);
+	cadet::test::setSectionTimes(jpp, {0.0, 100.0});
+	cadet::test::setInitialConditions(jpp, {1.0}, {}, 10.0);
+	cadet::test::setInletProfile(jpp, 0, 0, 1.0, 0.0, 0.0, 0.0);
+	cadet::test::setFlowRates(jpp, 0, 1.5, 1.5, 0.5);
+	addOutletEvent(jpp, 1.3, 1, "STOP");
+
+	cadet::Driver drv;
+	drv.configure(jpp);
+	drv.run();
+
+	const double tEvent = 20.0 - std::sqrt(160.0);
+	const std::vector<double>& eventTimes = drv.simulator()->getEventTimes();
+	REQUIRE(eventTimes.size() == 1);
+	CHECK(eventTimes[0] == cadet::test::makeApprox(tEvent, 1e-4, 1e-3));
+	CHECK(drv.simulator()->getEventIndices()[0] == 0);
+
+	// Only solution times before the event have been written
+	cadet::InternalStorageUnitOpRecorder const* const simData = drv.solution()->unitOperation(0);
+	CHECK(simData->numDataPoints() == 8);
+
+	// Last state is located at the event
+	unsigned int len = 0;
+	double const* const lastY = drv.simulator()->getLastSolution(len);
+	cadet::IUnitOperation const* const cstr = static_cast<cadet::IUnitOperation const*>(drv.model()->getUnitOperationModel(0));
+	CHECK(lastY[cstr->localOutletComponentIndex(0)] == cadet::test::makeApprox(1.3, 1e-6, 1e-6));
+}
+
+TEST_CASE("CSTR outlet event records crossings and continues", "[CSTR],[Simulation],[Event]")
+{
+	// Outlet concentration is c(t) = 1 + t / 20 - t^2 / 800, which crosses 1.3 at t = 20 -+ sqrt(160)
+	cadet::JsonParameterProvider jpp = createCSTRBenchmark(1, 100.0, 1.0);
+	cadet::test::setSectionTimes(jpp, {0.0, 100.0});
+	cadet::test::setInitialConditions(jpp, {1.0}, {}, 10.0);
+	cadet::test::setInletProfile(jpp, 0, 0, 1.0, 0.0, 0.0, 0.0);
+	cadet::test::setFlowRates(jpp, 0, 1.5, 1.5, 0.5);
+	addOutletEvent(jpp, 1.3, 0, "RECORD");
+
+	cadet::Driver drv;
+	drv.configure(jpp);
+	drv.run();
+
+	const std::vector<double>& eventTimes = drv.simulator()->getEventTimes();
+	REQUIRE(eventTimes.size() == 2);
+	CHECK(eventTimes[0] == cadet::test::makeApprox(20.0 - std::sqrt(160.0), 1e-4, 1e-3));
+	CHECK(eventTimes[1] == cadet::test::makeApprox(20.0 + std::sqrt(160.0), 1e-4, 1e-3));
+
+	cadet::InternalStorageUnitOpRecorder const* const simData = drv.solution()->unitOperation(0);
+	CHECK(simData->numDataPoints() == 101);
+}
+
+TEST_CASE("CSTR steady-state detection skips remaining section", "[CSTR],[Simulation],[SteadyState]")
+{
+	cadet::JsonParameterProvider jpp = createCSTRBenchmark(1, 300.0, 1.0);
+	cadet::test::setSectionTimes(jpp, {0.0, 300.0});
+	cadet::test::setInitialConditions(jpp, {0.0}, {}, 10.0);
+	cadet::test::setInletProfile(jpp, 0, 0, 1.0, 0.0, 0.0, 0.0);
+	cadet::test::setFlowRates(jpp, 0, 1.0, 1.0, 0.0);
+
+	jpp.pushScope("solver");
+	jpp.pushScope("sections");
+	jpp.set("STEADY_STATE_DETECTION", std::vector<int>{1});
+	jpp.popScope();
+	jpp.popScope();
+
+	runSim(jpp, [](double t) {
+			return -std::expm1(-t / 10.0);
+		}, 
+		[](double t) {
+			return 10.0;
+	});
+
+	cadet::Driver drv;
+	drv.configure(jpp);
+	drv.run();
+
+	const std::vector<double>& skipped = drv.simulator()->getSteadyStateSkippedTimes();
+	REQUIRE(skipped.size() == 1);
+	CHECK(skipped[0] > 0.0);
+	CHECK(drv.solution()->unitOperation(0)->numDataPoints() == 301);
+}
+
+TEST_CASE("CSTR array with single tank matches analytical solution", "[CSTR],[CSTRArray],[Simulation]")
+{
+	cadet::JsonParameterProvider jpp = createCSTRBenchmark(1, 100.0, 1.0);
+	cadet::test::setSectionTimes(jpp, {0.0, 100.0});
+	cadet::test::setInletProfile(jpp, 0, 0, 1.0, 0.0, 0.0, 0.0);
+	cadet::test::setFlowRates(jpp, 0, 1.0, 1.0, 0.0);
+	setCSTRArray(jpp, 1, {10.0}, {}, {0.0});
+
+	runArraySim(jpp, [](double t) {
+		return -std::expm1(-t / 10.0);
+	});
+}
+
+TEST_CASE("CSTR array tanks in series match analytical solution", "[CSTR],[CSTRArray],[Simulation]")
+{
+	cadet::JsonParameterProvider jpp = createCSTRBenchmark(1, 100.0, 1.0);
+	cadet::test::setSectionTimes(jpp, {0.0, 100.0});
+	cadet::test::setInletProfile(jpp, 0, 0, 1.0, 0.0, 0.0, 0.0);
+	cadet::test::setFlowRates(jpp, 0, 1.0, 1.0, 0.0);
+
+	// Tank 0 -> tank 1 -> tank 2, only tank 2 drains to the outlet
+	setCSTRArray(jpp, 3, {5.0}, {0.0, 1.0, 1.0, 1.0, 2.0, 1.0}, {0.0});
+
+	runArraySim(jpp, [](double t) {
+		const double theta = t / 5.0;
+		return 1.0 - std::exp(-theta) * (1.0 + theta + 0.5 * theta * theta);
+	});
+}
+
+TEST_CASE("CSTR array with recirculation reaches feed concentration", "[CSTR],[CSTRArray],[Simulation]")
+{
+	cadet::JsonParameterProvider jpp = createCSTRBenchmark(1, 500.0, 500.0);
+	cadet::test::setSectionTimes(jpp, {0.0, 500.0});
+	cadet::test::setInletProfile(jpp, 0, 0, 1.0, 0.0, 0.0, 0.0);
+	cadet::test::setFlowRates(jpp, 0, 1.0, 1.0, 0.0);
+
+	// Loop 0 -> 1 -> 2 -> 0 with stronger internal flow than throughput, tank 2 drains to the outlet
+	setCSTRArray(jpp, 3, {2.0, 3.0, 4.0}, {0.0, 1.0, 5.0, 1.0, 2.0, 5.0, 2.0, 0.0, 4.0}, {0.5});
+
+	cadet::Driver drv;
+	drv.configure(jpp);
+	drv.run();
+
+	cadet::InternalStorageUnitOpRecorder const* const simData = drv.solution()->unitOperation(0);
+	REQUIRE(simData->numDataPoints() == 2);
+	CHECK(simData->outlet()[0] == cadet::test::makeApprox(0.5, 1e-6, 1e-8));
+	CHECK(simData->outlet()[1] == cadet::test::makeApprox(1.0, 1e-6, 1e-6));
+}
+
+TEST_CASE("CSTR outlet KPI recorder matches integrated outlet trace", "[CSTR],[Simulation],[Sensitivity],[KPI]")
+{
+	cadet::JsonParameterProvider jpp = createCSTRBenchmark(1, 100.0, 1.0);
+	cadet::test::setSectionTimes(jpp, {0.0, 100.0});
+	cadet::test::setInitialConditions(jpp, {0.0}, {}, 10.0);
+	cadet::test::setInletProfile(jpp, 0, 0, 1.0, 1.0, 0.0, 0.0);
+	cadet::test::setFlowRates(jpp, 0, 1.0, 0.5, 0.5);
+	cadet::test::addSensitivity(jpp, "LIN_COEFF", cadet::makeParamId("LIN_COEFF", 1, 0, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, 0), 1e-6);
+	cadet::test::returnSensitivities(jpp, 0);
+
+	jpp.pushScope("return");
+	jpp.pushScope("unit_000");
+	jpp.set("WRITE_SOLUTION_KPI", true);
+	jpp.set("WRITE_SENS_KPI", true);
+	jpp.set("KPI_FRACTION_START", std::vector<double>{0.0, 20.5});
+	jpp.set("KPI_FRACTION_END", std::vector<double>{20.5, 100.0});
+	jpp.popScope();
+	jpp.popScope();
+
+	cadet::Driver drv;
+	drv.configure(jpp);
+	drv.run();
+
+	cadet::InternalStorageUnitOpRecorder const* const simData = drv.solution()->unitOperation(0);
+	cadet::OutletKpiRecorder const* const kpi = drv.solution()->kpiUnitOperation(0);
+	REQUIRE(kpi);
+	REQUIRE(kpi->numDataPoints() == simData->numDataPoints());
+
+	// Integrate stored outlet trace with trapezoidal rule
+	double const* const time = drv.solution()->time();
+	double const* const outlet = simData->outlet();
+	double const* const sens = simData->sensOutlet(0);
+	double area = 0.0;
+	double firstMoment = 0.0;
+	double sensArea = 0.0;
+	double sensFirstMoment = 0.0;
+	double firstWindow = 0.0;
+	for (unsigned int i = 1; i < simData->numDataPoints(); ++i)
+	{
+		const double h = time[i] - time[i-1];
+		area += 0.5 * h * (outlet[i] + outlet[i-1]);
+		firstMoment += 0.5 * h * (time[i] * outlet[i] + time[i-1] * outlet[i-1]);
+		sensArea += 0.5 * h * (sens[i] + sens[i-1]);
+		sensFirstMoment += 0.5 * h * (time[i] * sens[i] + time[i-1] * sens[i-1]);
+
+		if (time[i] <= 20.0)
+			firstWindow += 0.5 * h * (outlet[i] + outlet[i-1]);
+		else if (time[i-1] == 20.0)
+			firstWindow += 0.25 * (outlet[i-1] + 0.5 * (outlet[i] + outlet[i-1]));
+	}
+
+	const double mean = firstMoment / area;
+	CHECK(kpi->area(0) == cadet::test::makeApprox(area, 1e-12, 1e-12));
+	CHECK(kpi->meanTime(0) == cadet::test::makeApprox(mean, 1e-4, 1e-8));
+	CHECK(kpi->peakMax(0) == cadet::test::makeApprox(*std::max_element(outlet, outlet + simData->numDataPoints()), 1e-12, 1e-12));
+	CHECK(kpi->peakTime(0) == 100.0);
+	CHECK(kpi->fractionYield(0, 0) == cadet::test::makeApprox(firstWindow / area, 1e-10, 1e-12));
+	CHECK(kpi->fractionYield(0, 0) + kpi->fractionYield(1, 0) == cadet::test::makeApprox(1.0, 1e-10, 1e-12));
+	CHECK(kpi->fractionPurity(1, 0) == cadet::test::makeApprox(1.0, 1e-12, 1e-12));
+
+	CHECK(kpi->sensArea(0, 0) == cadet::test::makeApprox(sensArea, 1e-12, 1e-12));
+	CHECK(kpi->sensMeanTime(0, 0) == cadet::test::makeApprox((sensFirstMoment - mean * sensArea) / area, 1e-4, 1e-8));
+	CHECK(kpi->sensPeakMax(0, 0) == cadet::test::makeApprox(sens[simData->numDataPoints() - 1], 1e-12, 1e-12));
+	CHECK(kpi->sensFractionPurity(0, 1, 0) == cadet::test::makeApprox(0.0, 1e-12, 1e-12));
+}
+
+TEST_CASE("CSTR simulator pool reuses driver for structure-identical runs", "[CSTR],[Simulation],[Sensitivity],[SimulatorPool]")
+{
+	cadet::JsonParameterProvider jpp = createCSTRBenchmark(1, 100.0, 1.0);
+	cadet::test::setSectionTimes(jpp, {0.0, 100.0});
+	cadet::test::setInitialConditions(jpp, {0.0}, {}, 10.0);
+	cadet::test::setInletProfile(jpp, 0, 0, 1.0, 0.0, 0.0, 0.0);
+	cadet::test::setFlowRates(jpp, 0, 1.0, 1.0, 0.0);
+	cadet::test::addSensitivity(jpp, "CONST_COEFF", cadet::makeParamId("CONST_COEFF", 1, 0, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, 0), 1e-6);
+	cadet::test::returnSensitivities(jpp, 0);
+
+	cadet::SimulatorPool pool;
+	cadet::Driver& first = pool.acquire("cstr", jpp);
+	first.run();
+	pool.release(first);
+
+	// Change parameter values and initial conditions only
+	cadet::test::setInletProfile(jpp, 0, 0, 2.0, 0.0, 0.0, 0.0);
+	cadet::test::setInitialConditions(jpp, {0.5}, {}, 10.0);
+
+	cadet::Driver& second = pool.acquire("cstr", jpp);
+	CHECK(&second == &first);
+	CHECK(pool.size() == 1);
+	CHECK(pool.numIdle() == 0);
+	second.run();
+
+	cadet::Driver fresh;
+	fresh.configure(jpp);
+	fresh.run();
+
+	cadet::InternalStorageUnitOpRecorder const* const pooled = second.solution()->unitOperation(0);
+	cadet::InternalStorageUnitOpRecorder const* const ref = fresh.solution()->unitOperation(0);
+	REQUIRE(pooled->numDataPoints() == ref->numDataPoints());
+	for (unsigned int i = 0; i < ref->numDataPoints(); ++i)
+	{
+		CAPTURE(i);
+		CHECK(pooled->outlet()[i] == cadet::test::makeApprox(ref->outlet()[i], 1e-10, 1e-12));
+		CHECK(pooled->sensOutlet(0)[i] == cadet::test::makeApprox(ref->sensOutlet(0)[i], 1e-10, 1e-12));
+	}
+
+	// Analytical solution c(t) = 2 - 1.5 exp(-t / 10)
+	CHECK(pooled->outlet()[ref->numDataPoints() - 1] == cadet::test::makeApprox(2.0 - 1.5 * std::exp(-10.0), 1e-6, 1e-8));
+
+	pool.release(second);
+
+	// Different structure keys obtain different drivers
+	cadet::Driver& other = pool.acquire("other", jpp);
+	CHECK(&other != &first);
+	CHECK(pool.size() == 2);
+	pool.release(other);
+
+	// Reusing a key for a different structure is rejected
+	jpp.pushScope("return");
+	jpp.pushScope("unit_000");
+	jpp.set("WRITE_SOLUTION_BULK", true);
+	jpp.popScope();
+	jpp.popScope();
+
+	CHECK_THROWS_AS(pool.acquire("cstr", jpp), cadet::InvalidParameterException);
+	CHECK(pool.size() == 2);
+	CHECK(pool.numIdle() == 2);
+
+	pool.clear();
+	CHECK(pool.size() == 0);
+}
+
+TEST_CASE("CSTR Parareal matches sequential time integration", "[CSTR],[Simulation],[Parareal]")
+{
+	// Pulsed injection on 8 sections of length 10
+	const unsigned int nSec = 8;
+	const double secLen = 10.0;
+
+	cadet::JsonParameterProvider jpp = createCSTRBenchmark(nSec, nSec * secLen, 1.0);
+
+	std::vector<double> secTimes(nSec + 1, 0.0);
+	for (unsigned int i = 0; i <= nSec; ++i)
+		secTimes[i] = i * secLen;
+
+	cadet::test::setSectionTimes(jpp, secTimes);
+	cadet::test::setInitialConditions(jpp, {0.0}, {}, 10.0);
+	for (unsigned int i = 0; i < nSec; ++i)
+		cadet::test::setInletProfile(jpp, i, 0, (i % 2 == 0) ? 1.0 : 0.0, 0.0, 0.0, 0.0);
+
+	cadet::Driver seq;
+	seq.configure(jpp);
+	seq.run();
+
+	jpp.pushScope("solver");
+	jpp.addScope("parareal");
+	jpp.pushScope("parareal");
+	jpp.set("NSLICES", 4);
+	jpp.popScope();
+	jpp.popScope();
+
+	cadet::PararealDriver par;
+	par.configure(jpp);
+	REQUIRE(par.numSlices() == 4);
+	CHECK(par.sliceBoundaries() == std::vector<unsigned int>{0, 2, 4, 6, 8});
+
+	par.run();
+	CHECK(par.numIterations() >= 1);
+	CHECK(par.numIterations() <= 4);
+	CHECK(par.converged());
+
+	cadet::InternalStorageUnitOpRecorder const* const parData = par.solution()->unitOperation(0);
+	cadet::InternalStorageUnitOpRecorder const* const seqData = seq.solution()->unitOperation(0);
+	REQUIRE(parData->numDataPoints() == seqData->numDataPoints());
+	for (unsigned int i = 0; i < seqData->numDataPoints(); ++i)
+	{
+		CAPTURE(i);
+		CHECK(parData->outlet()[i] == cadet::test::makeApprox(seqData->outlet()[i], 1e-5, 1e-7));
+	}
+
+	unsigned int len = 0;
+	double const* const lastPar = par.simulator()->getLastSolution(len);
+	double const* const lastSeq = seq.simulator()->getLastSolution(len);
+	for (unsigned int i = 0; i < len; ++i)
+		CHECK(lastPar[i] == cadet::test::makeApprox(lastSeq[i], 1e-5, 1e-7));
+
+	// A single iteration with a tight tolerance does not converge
+	jpp.pushScope("solver");
+	jpp.pushScope("parareal");
+	jpp.set("MAX_ITER", 1);
+	jpp.set("TOL", 1e-12);
+	jpp.popScope();
+	jpp.popScope();
+
+	cadet::PararealDriver parLimited;
+	parLimited.configure(jpp);
+	parLimited.run();
+	CHECK(parLimited.numIterations() == 1);
+	CHECK_FALSE(parLimited.converged());
+	CHECK(parLimited.finalDefect() > 1e-12);
+}
+
+TEST_CASE("CSTR waveform relaxation matches monolithic time integration", "[CSTR],[Simulation],[WaveformRelaxation]")
+{
+	// Inlet (unit 1) feeds a chain of two CSTRs (units 0 and 3) that ends in an outlet (unit 2)
+	cadet::JsonParameterProvider jpp = createCSTRBenchmark(1, 100.0, 0.1);
+	cadet::test::setSectionTimes(jpp, {0.0, 100.0});
+	cadet::test::setInletProfile(jpp, 0, 0, 1.0, 0.0, 0.0, 0.0);
+
+	jpp.pushScope("model");
+	jpp.copy("unit_000", "unit_003");
+	jpp.set("NUNITS", 4);
+	jpp.pushScope("unit_003");
+	jpp.set("INIT_VOLUME", 2.0);
+	jpp.popScope();
+	jpp.pushScope("connections");
+	jpp.pushScope("switch_000");
+	jpp.set("CONNECTIONS", std::vector<double>{1.0, 0.0, -1.0, -1.0, -1.0, -1.0, 1.0,
+	                                           0.0, 3.0, -1.0, -1.0, -1.0, -1.0, 1.0,
+	                                           3.0, 2.0, -1.0, -1.0, -1.0, -1.0, 1.0});
+	jpp.popScope();
+	jpp.popScope();
+	jpp.popScope();
+
+	jpp.pushScope("return");
+	jpp.copy("unit_000", "unit_003");
+	jpp.popScope();
+
+	cadet::Driver mono;
+	mono.configure(jpp);
+	mono.run();
+
+	jpp.pushScope("solver");
+	jpp.addScope("waveform_relaxation");
+	jpp.popScope();
+
+	cadet::WaveformRelaxationDriver wr;
+	wr.configure(jpp);
+
+	// Outlet joins the group of the last CSTR, inlet is replicated
+	REQUIRE(wr.numGroups() == 2);
+	CHECK(wr.unitGroups() == std::vector<int>{0, -1, 1, 1});
+	CHECK_FALSE(wr.isCyclic());
+
+	wr.run();
+	CHECK(wr.numSweeps() == 1);
+
+	for (unsigned int unit : {0u, 3u})
+	{
+		cadet::InternalStorageUnitOpRecorder const* const wrData = wr.solution()->unitOperation(unit);
+		cadet::InternalStorageUnitOpRecorder const* const monoData = mono.solution()->unitOperation(unit);
+		REQUIRE(wrData->numDataPoints() == monoData->numDataPoints());
+		for (unsigned int i = 0; i < monoData->numDataPoints(); ++i)
+		{
+			CAPTURE(unit);
+			CAPTURE(i);
+			CHECK(wrData->outlet()[i] == cadet::test::makeApprox(monoData->outlet()[i], 1e-3, 1e-4));
+			CHECK(wrData->volume()[i] == cadet::test::makeApprox(monoData->volume()[i], 1e-3, 1e-4));
+		}
+	}
+}
+
+namespace
+{
+	class MemoryCheckpoint : public cadet::ICheckpointCallback
+	{
+	public:
+		MemoryCheckpoint(cadet::InternalStorageSystemRecorder* storage) : numCheckpoints(0), section(0), time(0.0), storage(storage) { }
+
+		virtual void saveCheckpoint(unsigned int sec, double t, double const* state, unsigned int len)
+		{
+			// Keep the first checkpoint at or after t = 25
+			++numCheckpoints;
+			if (time >= 25.0)
+				return;
+
+			section = sec;
+			time = t;
+			simState.assign(state, state + len);
+
+			recState.clear();
+			cadet::StateBufferWriter buffer(recState);
+			storage->saveState(buffer);
+		}
+
+		virtual void resumeFromCheckpoint(unsigned int sec, double t)
+		{
+			CHECK(sec == section);
+			CHECK(t == time);
+
+			cadet::StateBufferReader buffer(recState.data(), recState.size());
+			storage->restoreState(buffer);
+		}
+
+		unsigned int numCheckpoints;
+		unsigned int section;
+		double time;
+		std::vector<double> simState;
+		std::vector<double> recState;
+		cadet::InternalStorageSystemRecorder* storage;
+	};
+}
+
+TEST_CASE("CSTR resumed from checkpoint matches uninterrupted time integration", "[CSTR],[Simulation],[Checkpoint]")
+{
+	// Pulsed injection on 4 sections of length 10
+	const unsigned int nSec = 4;
+	const double secLen = 10.0;
+
+	cadet::JsonParameterProvider jpp = createCSTRBenchmark(nSec, nSec * secLen, 1.0);
+
+	std::vector<double> secTimes(nSec + 1, 0.0);
+	for (unsigned int i = 0; i <= nSec; ++i)
+		secTimes[i] = i * secLen;
+
+	cadet::test::setSectionTimes(jpp, secTimes);
+	cadet::test::setInitialConditions(jpp, {0.0}, {}, 10.0);
+	for (unsigned int i = 0; i < nSec; ++i)
+		cadet::test::setInletProfile(jpp, i, 0, (i % 2 == 0) ? 1.0 : 0.0, 0.0, 0.0, 0.0);
+
+	jpp.pushScope("solver");
+	jpp.addScope("checkpoint");
+	jpp.pushScope("checkpoint");
+	jpp.set("SIM_TIME_INTERVAL", 2.5);
+	jpp.popScope();
+	jpp.popScope();
+
+	cadet::Driver full;
+	full.configure(jpp);
+	REQUIRE(full.checkpointsConfigured());
+
+	MemoryCheckpoint cp(full.solution());
+	full.setCheckpointHandler(&cp);
+	full.run();
+
+	REQUIRE(cp.numCheckpoints > 1);
+	REQUIRE(cp.time >= 25.0);
+	REQUIRE(cp.section >= 2);
+
+	cadet::Driver resumed;
+	resumed.configure(jpp);
+	cp.storage = resumed.solution();
+	resumed.setCheckpointHandler(&cp);
+	resumed.resumeFrom(cp.simState);
+	resumed.run();
+
+	cadet::InternalStorageUnitOpRecorder const* const resData = resumed.solution()->unitOperation(0);
+	cadet::InternalStorageUnitOpRecorder const* const fullData = full.solution()->unitOperation(0);
+	REQUIRE(resData->numDataPoints() == fullData->numDataPoints());
+	for (unsigned int i = 0; i < full.solution()->numDataPoints(); ++i)
+		CHECK(resumed.solution()->time()[i] == full.solution()->time()[i]);
+
+	for (unsigned int i = 0; i < fullData->numDataPoints(); ++i)
+	{
+		CAPTURE(i);
+		CHECK(resData->outlet()[i] == cadet::test::makeApprox(fullData->outlet()[i], 1e-10, 1e-12));
+	}
+
+	// Checkpoints written with a different SUNDIALS version are rejected
+	std::vector<double> otherSundials(cp.simState);
+	otherSundials[1] += 1.0;
+
+	cadet::Driver rejected;
+	rejected.configure(jpp);
+	rejected.resumeFrom(otherSundials);
+	CHECK_THROWS_AS(rejected.run(), cadet::InvalidParameterException);
+}
@@ -22,6 +22,7 @@
 #include "SimHelper.hpp"
 #include "ModelBuilderImpl.hpp"
 #include "common/Driver.hpp"
+#include "common/LaplaceDriver.hpp"
 #include "Weno.hpp"
 #include "linalg/Norms.hpp"
 #include "SimulationTypes.hpp"
@@ -33,6 +34,7 @@
 
 #include <cmath>
 #include <functional>
+#include <numeric>
 
 /**
  * @brief Returns the absolute path to the test/ folder of the project
@@ -408,6 +410,153 @@ namespace column
 		}
 	}
 
+	void enableLaplaceSolver(cadet::JsonParameterProvider& jpp)
+	{
+		jpp.pushScope("solver");
+		jpp.addScope("laplace");
+		jpp.pushScope("laplace");
+		jpp.set("NTERMS", 40);
+		jpp.popScope();
+		jpp.popScope();
+	}
+
+	void testLaplaceBenchmark(const char* uoType, const char* refFileRelPath, bool dynamicBinding, double absTol, double relTol)
+	{
+		SECTION(std::string("Laplace domain solution with ") + (dynamicBinding ? "dynamic" : "quasi-stationary") + " binding")
+		{
+			// Setup simulation
+			cadet::JsonParameterProvider jpp = createLinearBenchmark(dynamicBinding, false, uoType);
+			enableLaplaceSolver(jpp);
+
+			// Invert transfer function
+			cadet::LaplaceDriver drv;
+			drv.configure(jpp);
+			REQUIRE(drv.usesLaplaceSolver());
+			drv.run();
+
+			// Read reference data from test file
+			const std::string refFile = std::string(getTestDirectory()) + std::string(refFileRelPath);
+			ReferenceDataReader rd(refFile.c_str());
+			const std::vector<double> time = rd.time();
+			const std::vector<double> ref = (dynamicBinding ? rd.analyticDynamic() : rd.analyticQuasiStationary());
+
+			// Get data from solver
+			cadet::InternalStorageUnitOpRecorder const* const simData = drv.solution()->unitOperation(0);
+			double const* outlet = simData->outlet();
+			REQUIRE(simData->numDataPoints() * 2 - 1 == time.size());
+
+			// Compare (solution is only returned at every other reference time point)
+			for (unsigned int i = 0; i < simData->numDataPoints(); ++i, ++outlet)
+			{
+				CAPTURE(time[2 * i]);
+				CHECK((*outlet) == makeApprox(ref[2 * i], relTol, absTol));
+			}
+		}
+	}
+
+	void testLaplaceSensitivity(const char* uoType, bool dynamicBinding, double absTol, double relTol)
+	{
+		SECTION(std::string("Laplace domain sensitivities with ") + (dynamicBinding ? "dynamic" : "quasi-stationary") + " binding")
+		{
+			struct Param
+			{
+				const char* unitScope;
+				const char* subScope;
+				const char* name;
+				cadet::ParameterId id;
+			};
+
+			const Param params[] = {
+				{"unit_000", nullptr, "COL_DISPERSION", cadet::makeParamId("COL_DISPERSION", 0, cadet::CompIndep, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, cadet::SectionIndep)},
+				{"unit_000", "adsorption", "LIN_KA", cadet::makeParamId("LIN_KA", 0, 0, cadet::ParTypeIndep, 0, cadet::ReactionIndep, cadet::SectionIndep)},
+				{"unit_001", "sec_000", "CONST_COEFF", cadet::makeParamId("CONST_COEFF", 1, 0, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, 0)}
+			};
+			const unsigned int nParams = sizeof(params) / sizeof(Param);
+
+			// Multiplies the first element of the parameter by the given factor and returns its original value
+			const auto scaleParam = [](cadet::JsonParameterProvider& jpp, const Param& p, double factor) -> double
+				{
+					jpp.pushScope("model");
+					jpp.pushScope(p.unitScope);
+					if (p.subScope)
+						jpp.pushScope(p.subScope);
+
+					double val = 0.0;
+					if (jpp.isArray(p.name))
+					{
+						std::vector<double> v = jpp.getDoubleArray(p.name);
+						val = v[0];
+						v[0] *= factor;
+						jpp.set(p.name, v);
+					}
+					else
+					{
+						val = jpp.getDouble(p.name);
+						jpp.set(p.name, val * factor);
+					}
+
+					if (p.subScope)
+						jpp.popScope();
+					jpp.popScope();
+					jpp.popScope();
+					return val;
+				};
+
+			// Returns the outlet profile followed by the outlet sensitivities
+			const auto solve = [=](cadet::JsonParameterProvider& jpp, unsigned int nSens) -> std::vector<double>
+				{
+					enableLaplaceSolver(jpp);
+
+					cadet::LaplaceDriver drv;
+					drv.configure(jpp);
+					REQUIRE(drv.usesLaplaceSolver());
+					drv.run();
+
+					cadet::InternalStorageUnitOpRecorder const* const simData = drv.solution()->unitOperation(0);
+					std::vector<double> res(simData->outlet(), simData->outlet() + simData->numDataPoints());
+					for (unsigned int s = 0; s < nSens; ++s)
+						res.insert(res.end(), simData->sensOutlet(s), simData->sensOutlet(s) + simData->numDataPoints());
+
+					return res;
+				};
+
+			// Sensitivities by forward mode AD
+			cadet::JsonParameterProvider jpp = createLinearBenchmark(dynamicBinding, false, uoType);
+			for (unsigned int i = 0; i < nParams; ++i)
+				cadet::test::addSensitivity(jpp, params[i].name, params[i].id, 1e-6);
+
+			jpp.pushScope("return");
+			jpp.pushScope("unit_000");
+			jpp.set("WRITE_SENS_OUTLET", true);
+			jpp.popScope();
+			jpp.popScope();
+
+			const std::vector<double> sol = solve(jpp, nParams);
+			const unsigned int nPoints = sol.size() / (nParams + 1);
+
+			// Compare parameter-scaled sensitivities against central finite differences
+			const double relStep = 1e-3;
+			for (unsigned int i = 0; i < nParams; ++i)
+			{
+				cadet::JsonParameterProvider jppPlus = createLinearBenchmark(dynamicBinding, false, uoType);
+				const double val = scaleParam(jppPlus, params[i], 1.0 + relStep);
+				const std::vector<double> solPlus = solve(jppPlus, 0);
+
+				cadet::JsonParameterProvider jppMinus = createLinearBenchmark(dynamicBinding, false, uoType);
+				scaleParam(jppMinus, params[i], 1.0 - relStep);
+				const std::vector<double> solMinus = solve(jppMinus, 0);
+
+				for (unsigned int j = 0; j < nPoints; ++j)
+				{
+					CAPTURE(params[i].name);
+					CAPTURE(j);
+					const double fd = (solPlus[j] - solMinus[j]) / (2.0 * relStep);
+					CHECK(val * sol[(i + 1) * nPoints + j] == makeApprox(fd, relTol, absTol));
+				}
+			}
+		}
+	}
+
 	void testJacobianWenoForwardBackward(const std::string& uoType, int wenoOrder)
 	{
 		cadet::IModelBuilder* const mb = cadet::createModelBuilder();
@@ -1043,6 +1192,175 @@ namespace column
 		destroyModelBuilder(mb);
 	}
 
+
+	void testDecimatedRecording(const char* uoType)
+	{
+		// Use Load-Wash-Elution test case
+		cadet::JsonParameterProvider jpp = createLWE(uoType);
+		jpp.pushScope("return");
+		jpp.pushScope("unit_000");
+		jpp.set("WRITE_SOLUTION_BULK", true);
+		jpp.set("WRITE_SOLUTION_PARTICLE", true);
+		jpp.popScope();
+		jpp.popScope();
+
+		cadet::Driver drvFull;
+		drvFull.configure(jpp);
+		drvFull.run();
+
+		const unsigned int timeStride = 3;
+		const unsigned int axialStride = 4;
+		const unsigned int shellStride = 2;
+
+		jpp.pushScope("return");
+		jpp.pushScope("unit_000");
+		jpp.set("DECIMATE_TIME", static_cast<int>(timeStride));
+		jpp.set("DECIMATE_AXIAL", static_cast<int>(axialStride));
+		jpp.set("DECIMATE_SHELL", static_cast<int>(shellStride));
+		jpp.set("SINGLE_PRECISION_DATA", true);
+		jpp.popScope();
+		jpp.popScope();
+
+		cadet::Driver drvDec;
+		drvDec.configure(jpp);
+		drvDec.run();
+
+		cadet::InternalStorageUnitOpRecorder const* const fullData = drvFull.solution()->unitOperation(0);
+		cadet::InternalStorageUnitOpRecorder const* const decData = drvDec.solution()->unitOperation(0);
+		REQUIRE(fullData->numDataPoints() == decData->numDataPoints());
+		REQUIRE(decData->numSpatialDataPoints() == (fullData->numDataPoints() + timeStride - 1) / timeStride);
+
+		// Compares decimated single precision field with full field, layouts are ordered time, axial cell, [shell,] component
+		const auto compare = [&](std::vector<std::size_t> fullLayout, std::vector<std::size_t> decLayout, const std::vector<unsigned int>& strides, double const* full, float const* dec)
+		{
+			fullLayout[0] = fullData->numDataPoints();
+			decLayout[0] = decData->numSpatialDataPoints();
+			REQUIRE(fullLayout.size() == decLayout.size());
+			for (std::size_t d = 0; d < decLayout.size(); ++d)
+				CHECK(decLayout[d] == (fullLayout[d] + strides[d] - 1) / strides[d]);
+
+			const std::size_t nDec = std::accumulate(decLayout.begin(), decLayout.end(), std::size_t(1), std::multiplies<std::size_t>());
+			for (std::size_t i = 0; i < nDec; ++i)
+			{
+				std::size_t rem = i;
+				std::size_t idxFull = 0;
+				std::size_t fullStride = 1;
+				for (std::size_t d = decLayout.size(); d > 0; --d)
+				{
+					idxFull += (rem % decLayout[d-1]) * strides[d-1] * fullStride;
+					rem /= decLayout[d-1];
+					fullStride *= fullLayout[d-1];
+				}
+
+				CAPTURE(i);
+				CHECK(dec[i] == static_cast<float>(full[idxFull]));
+			}
+		};
+
+		compare(fullData->bulkLayout(), decData->bulkLayout(), {timeStride, axialStride, 1}, fullData->bulk(), decData->bulkSingle());
+		compare(fullData->particleLayout(), decData->particleLayout(), {timeStride, axialStride, shellStride, 1}, fullData->particle(), decData->particleSingle());
+	}
+
+	void testParameterHandles(const char* uoType)
+	{
+		cadet::JsonParameterProvider jpp = createLWE(uoType);
+
+		const cadet::ParameterId ids[] = {
+			cadet::makeParamId("COL_DISPERSION", 0, cadet::CompIndep, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, cadet::SectionIndep),
+			cadet::makeParamId("VELOCITY", 0, cadet::CompIndep, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, cadet::SectionIndep),
+			cadet::makeParamId("FILM_DIFFUSION", 0, 1, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, cadet::SectionIndep),
+			cadet::makeParamId("PAR_DIFFUSION", 0, 2, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, cadet::SectionIndep),
+			cadet::makeParamId("PAR_RADIUS", 0, cadet::CompIndep, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, cadet::SectionIndep),
+			cadet::makeParamId("SMA_KA", 0, 1, cadet::ParTypeIndep, 0, cadet::ReactionIndep, cadet::SectionIndep),
+			cadet::makeParamId("SECTION_TIMES", cadet::UnitOpIndep, cadet::CompIndep, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, 2)
+		};
+		const double values[] = {6e-8, 5.5e-4, 7.1e-6, 6.5e-11, 4.4e-5, 30.0, 95.0};
+		const unsigned int nParams = sizeof(ids) / sizeof(ids[0]);
+
+		cadet::Driver drvRef;
+		drvRef.configure(jpp);
+
+		cadet::Driver drvHandle;
+		drvHandle.configure(jpp);
+
+		// Only use parameters that exist in the given unit operation
+		std::vector<cadet::ParameterId> usedIds;
+		std::vector<double> usedValues;
+		for (unsigned int i = 0; i < nParams; ++i)
+		{
+			if (!drvRef.simulator()->hasParameter(ids[i]))
+				continue;
+
+			usedIds.push_back(ids[i]);
+			usedValues.push_back(values[i]);
+			drvRef.simulator()->setParameterValue(ids[i], values[i]);
+		}
+
+		std::vector<cadet::ParameterHandle> handles(usedIds.size());
+		REQUIRE(drvHandle.simulator()->resolveParameterHandles(usedIds.data(), usedIds.size(), handles.data()));
+
+		// Resolving again reuses the handles
+		std::vector<cadet::ParameterHandle> handlesAgain(usedIds.size());
+		REQUIRE(drvHandle.simulator()->resolveParameterHandles(usedIds.data(), usedIds.size(), handlesAgain.data()));
+		CHECK(handlesAgain == handles);
+
+		// Handles survive setting the section times (e.g., when events restore shifted section times)
+		jpp.pushScope("solver");
+		jpp.pushScope("sections");
+		const std::vector<double> secTimes = jpp.getDoubleArray("SECTION_TIMES");
+		const std::vector<bool> secCont = jpp.getBoolArray("SECTION_CONTINUITY");
+		jpp.popScope();
+		jpp.popScope();
+		drvHandle.simulator()->setSectionTimes(secTimes, secCont);
+
+		// Apply a different set of values first to make sure handles overwrite them
+		std::vector<double> tempValues(usedValues);
+		for (double& v : tempValues)
+			v *= 1.5;
+		drvHandle.simulator()->setParameterValues(handles.data(), tempValues.data(), handles.size());
+		drvHandle.simulator()->setParameterValues(handles.data(), usedValues.data(), handles.size());
+
+		// SECTION_TIMES are not part of the model and are only compared through the solution
+		for (std::size_t i = 0; i < usedIds.size(); ++i)
+		{
+			const double refValue = drvRef.model()->getParameterDouble(usedIds[i]);
+			if (std::isnan(refValue))
+				continue;
+
+			CAPTURE(usedIds[i]);
+			CHECK(drvHandle.model()->getParameterDouble(usedIds[i]) == refValue);
+		}
+
+		drvRef.run();
+		drvHandle.run();
+
+		cadet::InternalStorageUnitOpRecorder const* const refData = drvRef.solution()->unitOperation(0);
+		cadet::InternalStorageUnitOpRecorder const* const handleData = drvHandle.solution()->unitOperation(0);
+		REQUIRE(refData->numDataPoints() == handleData->numDataPoints());
+
+		double const* const refOutlet = refData->outlet();
+		double const* const handleOutlet = handleData->outlet();
+		for (unsigned int i = 0; i < refData->numDataPoints() * refData->numComponents(); ++i)
+		{
+			CAPTURE(i);
+			CHECK(handleOutlet[i] == makeApprox(refOutlet[i], 1e-12, 1e-14));
+		}
+
+		// Unknown parameters receive invalid handles
+		const cadet::ParameterId unknownId = cadet::makeParamId("UNKNOWN_PARAMETER", 0, cadet::CompIndep, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, cadet::SectionIndep);
+		cadet::ParameterHandle unknownHandle = 0;
+		CHECK_FALSE(drvHandle.simulator()->resolveParameterHandles(&unknownId, 1, &unknownHandle));
+		CHECK(unknownHandle == cadet::InvalidParameterHandle);
+		CHECK_THROWS_AS(drvHandle.simulator()->setParameterValues(&unknownHandle, values, 1), cadet::InvalidParameterException);
+
+		// Cleared handles are rejected, even if new handles have been resolved since
+		drvHandle.simulator()->clearParameterHandles();
+		CHECK_THROWS_AS(drvHandle.simulator()->setParameterValues(handles.data(), usedValues.data(), handles.size()), cadet::InvalidParameterException);
+		REQUIRE(drvHandle.simulator()->resolveParameterHandles(usedIds.data(), usedIds.size(), handlesAgain.data()));
+		CHECK_THROWS_AS(drvHandle.simulator()->setParameterValues(handles.data(), usedValues.data(), handles.size()), cadet::InvalidParameterException);
+		CHECK_NOTHROW(drvHandle.simulator()->setParameterValues(handlesAgain.data(), usedValues.data(), handlesAgain.size()));
+	}
+
 } // namespace column
 } // namespace test
 } // namespace cadet
@@ -99,6 +99,33 @@ namespace column
 	 */
 	void testAnalyticNonBindingBenchmark(const char* uoType, const char* refFileRelPath, bool forwardFlow, unsigned int nCol, double absTol, double relTol);
 
+	/**
+	 * @brief Adds the Laplace domain solver to the solver settings
+	 * @param [in,out] jpp ParameterProvider to add the solver to
+	 */
+	void enableLaplaceSolver(cadet::JsonParameterProvider& jpp);
+
+	/**
+	 * @brief Runs the Laplace domain solver comparing against (semi-)analytic single component pulse injection reference data
+	 * @param [in] uoType Unit operation type
+	 * @param [in] refFileRelPath Path to the reference data file from the directory of this file
+	 * @param [in] dynamicBinding Determines whether dynamic binding is used
+	 * @param [in] absTol Absolute error tolerance
+	 * @param [in] relTol Relative error tolerance
+	 */
+	void testLaplaceBenchmark(const char* uoType, const char* refFileRelPath, bool dynamicBinding, double absTol, double relTol);
+
+	/**
+	 * @brief Checks the sensitivities of the Laplace domain solver against finite differences
+	 * @details Uses the single component pulse injection benchmark and checks the sensitivities of
+	 *          axial dispersion, adsorption rate, and inlet concentration.
+	 * @param [in] uoType Unit operation type
+	 * @param [in] dynamicBinding Determines whether dynamic binding is used
+	 * @param [in] absTol Absolute error tolerance
+	 * @param [in] relTol Relative error tolerance
+	 */
+	void testLaplaceSensitivity(const char* uoType, bool dynamicBinding, double absTol, double relTol);
+
 	/**
 	 * @brief Runs a simulation test comparing forward and backwards flow in the load-wash-elution example
 	 * @param [in] uoType Unit operation type
@@ -242,6 +269,20 @@ namespace column
 	 */
 	void testInletDofJacobian(const std::string& uoType);
 
+	/**
+	 * @brief Checks that decimated single precision recording of bulk and particle fields matches full recording
+	 * @details Uses the Load-Wash-Elution test case and decimates time points, axial cells, and particle shells.
+	 * @param [in] uoType Unit operation type
+	 */
+	void testDecimatedRecording(const char* uoType);
+
+	/**
+	 * @brief Checks that setting parameters via parameter handles yields the same solution as setting them by their ID
+	 * @details Uses the Load-Wash-Elution test case and modifies transport, binding, and SECTION_TIMES parameters.
+	 * @param [in] uoType Unit operation type
+	 */
+	void testParameterHandles(const char* uoType);
+
 } // namespace column
 } // namespace test
 } // namespace cadet
@@ -14,10 +14,15 @@
 
 #include "ColumnTests.hpp"
 #include "ParticleHelper.hpp"
+#include "UnitOperationTests.hpp"
 #include "ReactionModelTests.hpp"
 #include "JsonTestModels.hpp"
 #include "Weno.hpp"
 #include "Utils.hpp"
+#include "Approx.hpp"
+#include "Logging.hpp"
+#include "common/Driver.hpp"
+#include "cadet/DataView.hpp"
 
 TEST_CASE("GRM LWE forward vs backward flow", "[GRM],[Simulation]")
 {
@@ -40,6 +45,18 @@ TEST_CASE("GRM non-binding linear pulse vs analytic solution", "[GRM],[Simulatio
 	cadet::test::column::testAnalyticNonBindingBenchmark("GENERAL_RATE_MODEL", "/data/grm-nonBinding.data", false, 512, 6e-5, 1e-7);
 }
 
+TEST_CASE("GRM linear pulse Laplace domain solution vs analytic solution", "[GRM],[Laplace],[Analytic]")
+{
+	cadet::test::column::testLaplaceBenchmark("GENERAL_RATE_MODEL", "/data/grm-pulseBenchmark.data", true, 1e-7, 1e-6);
+	cadet::test::column::testLaplaceBenchmark("GENERAL_RATE_MODEL", "/data/grm-pulseBenchmark.data", false, 1e-7, 1e-6);
+}
+
+TEST_CASE("GRM Laplace domain sensitivities vs FD", "[GRM],[Laplace],[Sensitivity]")
+{
+	cadet::test::column::testLaplaceSensitivity("GENERAL_RATE_MODEL", true, 1e-5, 1e-3);
+	cadet::test::column::testLaplaceSensitivity("GENERAL_RATE_MODEL", false, 1e-5, 1e-3);
+}
+
 TEST_CASE("GRM Jacobian forward vs backward flow", "[GRM],[UnitOp],[Residual],[Jacobian],[AD]")
 {
 	// Test all WENO orders
@@ -136,6 +153,196 @@ TEST_CASE("GRM inlet DOF Jacobian", "[GRM],[UnitOp],[Jacobian],[Inlet]")
 	cadet::test::column::testInletDofJacobian("GENERAL_RATE_MODEL");
 }
 
+TEST_CASE("GRM decimated single precision recording matches full recording", "[GRM],[Simulation],[Recorder]")
+{
+	cadet::test::column::testDecimatedRecording("GENERAL_RATE_MODEL");
+}
+
+TEST_CASE("GRM result views refer to recorded data and last state", "[GRM],[Simulation],[Recorder]")
+{
+	cadet::JsonParameterProvider jpp = createLWE("GENERAL_RATE_MODEL");
+	jpp.pushScope("return");
+	jpp.pushScope("unit_000");
+	jpp.set("WRITE_SOLUTION_BULK", true);
+	jpp.set("WRITE_SOLUTION_PARTICLE", true);
+	jpp.popScope();
+	jpp.popScope();
+
+	cadet::Driver drv;
+	drv.configure(jpp);
+	drv.run();
+
+	cadet::InternalStorageUnitOpRecorder const* const rec = drv.solution()->unitOperation(0);
+
+	const cadet::DataView outlet = rec->outletView();
+	CHECK(outlet.data == rec->outlet());
+	CHECK(outlet.type == cadet::DataViewType::Double);
+	REQUIRE(outlet.rank == 3);
+	CHECK(outlet.shape[0] == rec->numDataPoints());
+	CHECK(outlet.shape[1] == rec->numOutletPorts());
+	CHECK(outlet.shape[2] == rec->numComponents());
+	CHECK(outlet.strides[0] == static_cast<std::ptrdiff_t>(rec->numOutletPorts() * rec->numComponents() * sizeof(double)));
+	CHECK(outlet.strides[1] == static_cast<std::ptrdiff_t>(rec->numComponents() * sizeof(double)));
+	CHECK(outlet.strides[2] == static_cast<std::ptrdiff_t>(sizeof(double)));
+
+	const auto checkField = [&](const cadet::DataView& view, double const* data, const std::vector<std::size_t>& layout)
+	{
+		CHECK(view.data == data);
+		REQUIRE(view.rank == layout.size());
+		CHECK(view.shape[0] == rec->numSpatialDataPoints());
+		for (unsigned int i = 1; i < view.rank; ++i)
+			CHECK(view.shape[i] == layout[i]);
+		CHECK(view.strides[view.rank - 1] == static_cast<std::ptrdiff_t>(sizeof(double)));
+	};
+
+	checkField(rec->bulkView(), rec->bulk(), rec->bulkLayout());
+	checkField(rec->particleView(), rec->particle(), rec->particleLayout());
+
+	// Fields that have not been recorded result in empty views
+	const cadet::DataView volume = rec->volumeView();
+	CHECK(volume.data == nullptr);
+	CHECK(volume.rank == 0);
+	CHECK(cadet::numElements(volume) == 0);
+
+	// Last state through the C API
+	unsigned int len = 0;
+	double const* const state = drv.simulator()->getLastSolution(len);
+
+	cadet::DataView view;
+	REQUIRE(cadetGetLastStateView(drv.simulator(), &view) == 0);
+	CHECK(view.data == state);
+	REQUIRE(view.rank == 1);
+	CHECK(view.shape[0] == len);
+	CHECK(view.strides[0] == static_cast<std::ptrdiff_t>(sizeof(double)));
+
+	CHECK(cadetGetLastStateView(nullptr, &view) < 0);
+	CHECK(cadetGetLastSensitivityView(drv.simulator(), 0, &view) < 0);
+}
+
+TEST_CASE("GRM block tridiagonal particle solver matches banded solver", "[GRM],[Simulation],[LinearSolver]")
+{
+	// Load-Wash-Elution test case has no surface diffusion
+	cadet::JsonParameterProvider jpp = createLWE("GENERAL_RATE_MODEL");
+
+	cadet::Driver drvBand;
+	drvBand.configure(jpp);
+	drvBand.run();
+
+	// Fixing zero surface diffusion selects the block tridiagonal particle solver
+	jpp.pushScope("model");
+	jpp.pushScope("unit_000");
+	jpp.pushScope("discretization");
+	jpp.set("FIX_ZERO_SURFACE_DIFFUSION", true);
+	jpp.popScope();
+	jpp.popScope();
+	jpp.popScope();
+
+	cadet::Driver drvBlock;
+	drvBlock.configure(jpp);
+	drvBlock.run();
+
+	cadet::InternalStorageUnitOpRecorder const* const bandData = drvBand.solution()->unitOperation(0);
+	cadet::InternalStorageUnitOpRecorder const* const blockData = drvBlock.solution()->unitOperation(0);
+	REQUIRE(bandData->numDataPoints() == blockData->numDataPoints());
+
+	double const* const bandOutlet = bandData->outlet();
+	double const* const blockOutlet = blockData->outlet();
+	for (unsigned int i = 0; i < bandData->numDataPoints() * bandData->numComponents(); ++i)
+	{
+		CAPTURE(i);
+		CHECK(blockOutlet[i] == cadet::test::makeApprox(bandOutlet[i], 1e-6, 1e-8));
+	}
+}
+
+TEST_CASE("GRM batched particle types match separate particle types", "[GRM],[Simulation],[ParticleType]")
+{
+	// Load-Wash-Elution test case has no surface diffusion
+	cadet::JsonParameterProvider jpp = createLWE("GENERAL_RATE_MODEL");
+
+	// Particle size distribution with three same-structured particle types
+	const double parFactor[] = {0.9, 0.8};
+	const double volFrac[] = {0.3, 0.6, 0.1};
+	cadet::test::particle::extendModelToManyParticleTypes(jpp, 0, 3, parFactor, volFrac);
+
+	jpp.pushScope("model");
+	jpp.pushScope("unit_000");
+	jpp.pushScope("discretization");
+	jpp.set("FIX_ZERO_SURFACE_DIFFUSION", true);
+	jpp.popScope();
+	jpp.popScope();
+	jpp.popScope();
+
+	cadet::Driver drvSep;
+	drvSep.configure(jpp);
+	drvSep.run();
+
+	jpp.pushScope("model");
+	jpp.pushScope("unit_000");
+	jpp.pushScope("discretization");
+	jpp.set("BATCH_PARTICLE_TYPES", true);
+	jpp.popScope();
+	jpp.popScope();
+	jpp.popScope();
+
+	cadet::Driver drvBatch;
+	drvBatch.configure(jpp);
+	drvBatch.run();
+
+	cadet::InternalStorageUnitOpRecorder const* const sepData = drvSep.solution()->unitOperation(0);
+	cadet::InternalStorageUnitOpRecorder const* const batchData = drvBatch.solution()->unitOperation(0);
+	REQUIRE(sepData->numDataPoints() == batchData->numDataPoints());
+
+	double const* const sepOutlet = sepData->outlet();
+	double const* const batchOutlet = batchData->outlet();
+	for (unsigned int i = 0; i < sepData->numDataPoints() * sepData->numComponents(); ++i)
+	{
+		CAPTURE(i);
+		CHECK(batchOutlet[i] == cadet::test::makeApprox(sepOutlet[i], 1e-15, 1e-15));
+	}
+}
+
+TEST_CASE("GRM batched particle types Jacobian analytic vs AD", "[GRM],[Jacobian],[AD],[ParticleType]")
+{
+	cadet::JsonParameterProvider jpp = createColumnWithTwoCompLinearBinding("GENERAL_RATE_MODEL");
+
+	// Particle types are only batched without surface diffusion
+	jpp.set("PAR_SURFDIFFUSION", std::vector<double>{0.0, 0.0});
+
+	const double parFactor[] = {0.9, 0.8};
+	const double volFrac[] = {0.3, 0.6, 0.1};
+	cadet::test::particle::extendModelToManyParticleTypes(jpp, 3, parFactor, volFrac);
+
+	jpp.pushScope("discretization");
+	jpp.set("FIX_ZERO_SURFACE_DIFFUSION", true);
+	jpp.set("BATCH_PARTICLE_TYPES", true);
+	jpp.popScope();
+
+	cadet::test::unitoperation::testJacobianAD(jpp);
+}
+
+TEST_CASE("GRM mixed surface diffusion particle types Jacobian analytic vs AD", "[GRM],[Jacobian],[AD],[ParticleType]")
+{
+	cadet::JsonParameterProvider jpp = createColumnWithTwoCompLinearBinding("GENERAL_RATE_MODEL");
+
+	const double parFactor[] = {0.9, 0.8};
+	const double volFrac[] = {0.3, 0.6, 0.1};
+	cadet::test::particle::extendModelToManyParticleTypes(jpp, 3, parFactor, volFrac);
+
+	// Each particle type uses a different residual kernel:
+	// dynamic binding with surface diffusion, quasi-stationary binding with surface diffusion, and no surface diffusion
+	jpp.set("PAR_SURFDIFFUSION", std::vector<double>{1e-11, 2e-11, 1e-11, 2e-11, 0.0, 0.0});
+
+	jpp.pushScope("adsorption_001");
+	jpp.set("IS_KINETIC", false);
+	jpp.popScope();
+
+	jpp.pushScope("discretization");
+	jpp.set("FIX_ZERO_SURFACE_DIFFUSION", true);
+	jpp.popScope();
+
+	cadet::test::unitoperation::testJacobianAD(jpp);
+}
+
 TEST_CASE("GRM LWE one vs two identical particle types match", "[GRM],[Simulation],[ParticleType]")
 {
 	cadet::test::particle::testOneVsTwoIdenticalParticleTypes("GENERAL_RATE_MODEL", 2e-8, 5e-5);
@@ -296,3 +503,8 @@ TEST_CASE("GRM multi particle types dynamic reactions time derivative Jacobian v
 	cadet::JsonParameterProvider jpp = createColumnWithTwoCompLinearBindingThreeParticleTypes();
 	cadet::test::reaction::testTimeDerivativeJacobianDynamicReactionsFD(jpp, true, true, true, 1e-6, 1e-14, 9e-4);
 }
+
+TEST_CASE("GRM parameter handles vs parameter IDs", "[GRM],[Simulation],[Parameter]")
+{
+	cadet::test::column::testParameterHandles("GENERAL_RATE_MODEL");
+}
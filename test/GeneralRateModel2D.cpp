@@ -19,6 +19,7 @@
 #include "Utils.hpp"
 #include "JsonTestModels.hpp"
 #include "JacobianHelper.hpp"
+#include "Approx.hpp"
 #include "cadet/ModelBuilder.hpp"
 #include "ModelBuilderImpl.hpp"
 #include "cadet/FactoryFuncs.hpp"
@@ -327,3 +328,120 @@ TEST_CASE("GRM2D with 1 radial zone matches GRM", "[GRM],[GRM2D],[UnitOp],[Jacob
 	mb->destroyUnitOperation(iUnitGrm);
 	cadet::destroyModelBuilder(mb);
 }
+
+namespace
+{
+	void testJacobianFreeLinearSolve(const std::string& precond, bool denseBulkSolver)
+	{
+		cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+		REQUIRE(nullptr != mb);
+
+		// Create a classic and a Jacobian-free unit
+		cadet::IModel* const iUnitSchur = mb->createUnitOperation("GENERAL_RATE_MODEL_2D", 0);
+		cadet::IModel* const iUnitJfnk = mb->createUnitOperation("GENERAL_RATE_MODEL_2D", 0);
+		REQUIRE(nullptr != iUnitSchur);
+		REQUIRE(nullptr != iUnitJfnk);
+
+		cadet::IUnitOperation* const schur = reinterpret_cast<cadet::IUnitOperation*>(iUnitSchur);
+		cadet::IUnitOperation* const jfnk = reinterpret_cast<cadet::IUnitOperation*>(iUnitJfnk);
+
+		cadet::JsonParameterProvider jpp = createColumnWithTwoCompLinearBinding("GENERAL_RATE_MODEL_2D");
+		const double velocity = jpp.getDouble("VELOCITY");
+		const double colRadius = jpp.getDouble("COL_RADIUS");
+		const double colPorosity = jpp.getDouble("COL_POROSITY");
+		const double crossSectionArea = 3.1415926535897932384626434 * colRadius * colRadius;
+
+		jpp.pushScope("discretization");
+		jpp.set("LINEAR_SOLVER_BULK", "DENSE");
+		jpp.popScope();
+
+		cadet::ModelBuilder& temp = *reinterpret_cast<cadet::ModelBuilder*>(mb);
+		REQUIRE(schur->configureModelDiscretization(jpp, temp));
+		REQUIRE(schur->configure(jpp));
+
+		// Use full Krylov subspace so that GMRES converges to the accuracy of the finite difference approximation
+		const unsigned int nDof = schur->numDofs();
+		jpp.pushScope("discretization");
+		jpp.set("USE_JFNK", true);
+		jpp.set("JFNK_PRECONDITIONER", precond);
+		jpp.set("MAX_KRYLOV", static_cast<int>(nDof));
+
+		// Without a bulk solver setting, the Jacobian-free unit falls back to the Jacobi preconditioner
+		if (!denseBulkSolver)
+			jpp.remove("LINEAR_SOLVER_BULK");
+		jpp.popScope();
+
+		REQUIRE(jfnk->configureModelDiscretization(jpp, temp));
+		REQUIRE(jfnk->configure(jpp));
+		REQUIRE(jfnk->numDofs() == nDof);
+
+		const cadet::active flowIn[] = {velocity * colPorosity * crossSectionArea};
+		const cadet::active flowOut[] = {velocity * colPorosity * crossSectionArea};
+		schur->setFlowRates(flowIn, flowOut);
+		jfnk->setFlowRates(flowIn, flowOut);
+
+		// Setup matrices
+		const cadet::AdJacobianParams noAdParams{nullptr, nullptr, 0u};
+		schur->notifyDiscontinuousSectionTransition(0.0, 0u, noAdParams);
+		jfnk->notifyDiscontinuousSectionTransition(0.0, 0u, noAdParams);
+
+		std::vector<double> y(nDof, 0.0);
+		std::vector<double> yDot(nDof, 0.0);
+		std::vector<double> weight(nDof, 1.0);
+		std::vector<double> sol1(nDof, 0.0);
+		std::vector<double> sol2(nDof, 0.0);
+		cadet::util::ThreadLocalStorage tls;
+		tls.resize(schur->threadLocalMemorySize());
+
+		cadet::test::util::populate(y.data(), [=](unsigned int idx) { return std::abs(std::sin(idx * 0.13)) + 1e-4; }, nDof);
+		cadet::test::util::populate(yDot.data(), [=](unsigned int idx) { return std::abs(std::sin((idx + nDof) * 0.13)) + 1e-4; }, nDof);
+
+		// Compute Jacobians
+		const cadet::SimulationTime simTime{0.0, 0u};
+		const cadet::ConstSimulationState simState{y.data(), yDot.data()};
+		schur->residualWithJacobian(simTime, simState, sol1.data(), noAdParams, tls);
+		jfnk->residualWithJacobian(simTime, simState, sol2.data(), noAdParams, tls);
+
+		// Compare solutions of the time discretized system
+		cadet::test::util::populate(sol1.data(), [=](unsigned int idx) { return std::abs(std::sin((idx + 2 * nDof) * 0.17)) + 1e-4; }, nDof);
+		std::copy(sol1.begin(), sol1.end(), sol2.begin());
+
+		REQUIRE(schur->linearSolve(0.0, 1.0, 1e-6, sol1.data(), weight.data(), simState) == 0);
+		REQUIRE(jfnk->linearSolve(0.0, 1.0, 1e-6, sol2.data(), weight.data(), simState) == 0);
+
+		// Matrix-vector products are approximated by finite differences of the residual, which limits
+		// the accuracy of the Jacobian-free solution (the system is ill-conditioned for small alpha)
+		double diffNorm = 0.0;
+		double solNorm = 0.0;
+		for (unsigned int i = 0; i < nDof; ++i)
+		{
+			diffNorm += (sol2[i] - sol1[i]) * (sol2[i] - sol1[i]);
+			solNorm += sol1[i] * sol1[i];
+		}
+		CHECK(std::sqrt(diffNorm) <= 1e-3 * std::sqrt(solNorm));
+
+		mb->destroyUnitOperation(iUnitJfnk);
+		mb->destroyUnitOperation(iUnitSchur);
+		cadet::destroyModelBuilder(mb);
+	}
+}
+
+TEST_CASE("GRM2D Jacobian-free linear solve matches Schur complement solve", "[GRM2D],[UnitOp],[LinearSolve]")
+{
+	SECTION("Shell preconditioner")
+	{
+		testJacobianFreeLinearSolve("SHELL", true);
+	}
+	SECTION("Particle preconditioner")
+	{
+		testJacobianFreeLinearSolve("PARTICLE", true);
+	}
+	SECTION("Shell preconditioner with default Jacobi bulk solver")
+	{
+		testJacobianFreeLinearSolve("SHELL", false);
+	}
+	SECTION("Particle preconditioner with default Jacobi bulk solver")
+	{
+		testJacobianFreeLinearSolve("PARTICLE", false);
+	}
+}
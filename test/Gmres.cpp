@@ -0,0 +1,182 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include <vector>
+#include <cmath>
+
+#include "linalg/CgsGmres.hpp"
+#include "linalg/Gmres.hpp"
+
+namespace
+{
+	/**
+	 * @brief Computes the matrix-vector product with a nonsymmetric tridiagonal convection-diffusion matrix
+	 * @param [in] n Size of the matrix
+	 * @param [in] x Vector
+	 * @param [out] z Result
+	 */
+	inline void convDispMatVec(unsigned int n, double const* x, double* z)
+	{
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			double v = 4.0 * x[i];
+			if (i > 0)
+				v -= 1.5 * x[i-1];
+			if (i + 1 < n)
+				v -= 0.5 * x[i+1];
+			z[i] = v;
+		}
+	}
+
+	/**
+	 * @brief Solves a convection-diffusion system with known solution and checks the residual and the solution
+	 * @param [in] n Size of the matrix
+	 * @param [in] maxKrylov Maximum number of Krylov vectors
+	 * @param [in] maxRestarts Maximum number of restarts
+	 * @param [in] reorthThreshold Threshold of the reorthogonalization criterion
+	 */
+	inline void checkCgsGmresSolve(unsigned int n, unsigned int maxKrylov, unsigned int maxRestarts, double reorthThreshold)
+	{
+		std::vector<double> ref(n);
+		std::vector<double> rhs(n);
+		std::vector<double> weight(n);
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			ref[i] = std::sin(0.3 * i) + 1.0;
+			weight[i] = 1.0 + 0.1 * (i % 7);
+		}
+		convDispMatVec(n, ref.data(), rhs.data());
+
+		cadet::linalg::CgsGmres gmres;
+		gmres.initialize(n, maxKrylov, maxRestarts);
+		gmres.reorthogonalizationThreshold(reorthThreshold);
+
+		const double tol = 1e-10;
+		std::vector<double> sol(n, 0.0);
+		const cadet::linalg::CgsGmres::Status status = gmres.solve([=](double const* x, double* z) -> int
+			{
+				convDispMatVec(n, x, z);
+				return 0;
+			}, tol, weight.data(), rhs.data(), sol.data());
+
+		CHECK(status == cadet::linalg::CgsGmres::Status::Success);
+		CHECK(gmres.residualNorm() <= tol);
+
+		// Check weighted residual independently
+		std::vector<double> res(n);
+		convDispMatVec(n, sol.data(), res.data());
+		double resNorm = 0.0;
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			const double r = weight[i] * (rhs[i] - res[i]);
+			resNorm += r * r;
+		}
+		CHECK(std::sqrt(resNorm) <= 10.0 * tol);
+
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			CAPTURE(i);
+			CHECK(sol[i] == Approx(ref[i]).epsilon(1e-8));
+		}
+	}
+}
+
+TEST_CASE("CgsGmres solves nonsymmetric system", "[Gmres],[LinAlg]")
+{
+	SECTION("Full Krylov space")
+	{
+		checkCgsGmresSolve(60, 60, 0, 1.0 / std::sqrt(2.0));
+	}
+	SECTION("Restarted")
+	{
+		checkCgsGmresSolve(60, 5, 100, 1.0 / std::sqrt(2.0));
+	}
+	SECTION("Without reorthogonalization")
+	{
+		checkCgsGmresSolve(60, 60, 0, 0.0);
+	}
+	SECTION("Always reorthogonalize")
+	{
+		checkCgsGmresSolve(60, 60, 0, 2.0);
+	}
+}
+
+TEST_CASE("CgsGmres uses initial guess", "[Gmres],[LinAlg]")
+{
+	const unsigned int n = 20;
+	std::vector<double> rhs(n);
+	std::vector<double> sol(n, 1.0);
+	std::vector<double> weight(n, 1.0);
+	convDispMatVec(n, sol.data(), rhs.data());
+
+	cadet::linalg::CgsGmres gmres;
+	gmres.initialize(n, 10, 2);
+
+	// Exact initial guess terminates without iterations
+	const cadet::linalg::CgsGmres::Status status = gmres.solve([=](double const* x, double* z) -> int
+		{
+			convDispMatVec(n, x, z);
+			return 0;
+		}, 1e-12, weight.data(), rhs.data(), sol.data());
+
+	CHECK(status == cadet::linalg::CgsGmres::Status::Success);
+	CHECK(gmres.numIterations() == 0);
+}
+
+TEST_CASE("CgsGmres reports matrix-vector product failures", "[Gmres],[LinAlg]")
+{
+	const unsigned int n = 10;
+	std::vector<double> rhs(n, 1.0);
+	std::vector<double> sol(n, 0.0);
+	std::vector<double> weight(n, 1.0);
+
+	cadet::linalg::CgsGmres gmres;
+	gmres.initialize(n, 5, 0);
+
+	CHECK(gmres.solve([](double const* x, double* z) -> int { return 1; }, 1e-10, weight.data(), rhs.data(), sol.data()) == cadet::linalg::CgsGmres::Status::MatVecFailRecoverable);
+	CHECK(gmres.solve([](double const* x, double* z) -> int { return -1; }, 1e-10, weight.data(), rhs.data(), sol.data()) == cadet::linalg::CgsGmres::Status::MatVecFailUnrecoverable);
+}
+
+TEST_CASE("Gmres with CGS2 orthogonalization matches SUNDIALS", "[Gmres],[LinAlg]")
+{
+	const unsigned int n = 40;
+	std::vector<double> rhs(n);
+	std::vector<double> weight(n, 1.0);
+	for (unsigned int i = 0; i < n; ++i)
+		rhs[i] = std::cos(0.2 * i);
+
+	const cadet::linalg::Gmres::MatrixVectorMultFun matVec = [=](void* userData, double const* x, double* z) -> int
+		{
+			convDispMatVec(n, x, z);
+			return 0;
+		};
+
+	std::vector<double> solNative(n, 0.0);
+	std::vector<double> solSundials(n, 0.0);
+
+	cadet::linalg::Gmres gmres;
+	gmres.initialize(n, 10, cadet::linalg::Orthogonalization::ClassicalGramSchmidtReorth, 20);
+	gmres.matrixVectorMultiplier(matVec, nullptr);
+	CHECK(gmres.solve(1e-10, weight.data(), rhs.data(), solNative.data()) == 0);
+
+	// Switch to SUNDIALS implementation after initialization
+	gmres.orthoMethod(cadet::linalg::Orthogonalization::ModifiedGramSchmidt);
+	CHECK(gmres.solve(1e-10, weight.data(), rhs.data(), solSundials.data()) == 0);
+
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		CAPTURE(i);
+		CHECK(solNative[i] == Approx(solSundials[i]).epsilon(1e-8));
+	}
+}
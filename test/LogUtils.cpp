@@ -17,8 +17,32 @@
 #define CADET_LOGGING_DISABLE
 #include "Logging.hpp"
 
+#include "common/Logger.hpp"
+#include "common/AsyncLogReceiver.hpp"
+
 #include <sstream>
 #include <vector>
+#include <string>
+#include <thread>
+
+namespace
+{
+	typedef cadet::log::NonFilteringLogger<cadet::log::StandardFormattingPolicy, cadet::log::StdOutWritePolicy> StdOutLogger;
+	typedef cadet::log::Logger<StdOutLogger, cadet::LogLevel::Warning> WarningLogger;
+
+	class CollectingLogReceiver : public cadet::ILogReceiver
+	{
+	public:
+		virtual void message(const char* file, const char* func, const unsigned int line, cadet::LogLevel lvl, const char* lvlStr, const char* message)
+		{
+			messages.push_back(message);
+			lines.push_back(line);
+		}
+
+		std::vector<std::string> messages;
+		std::vector<unsigned int> lines;
+	};
+}
 
 
 TEST_CASE("Log matrix output from linear array", "[Logging]")
@@ -59,3 +83,63 @@ TEST_CASE("Log matrix output from linear array", "[Logging]")
 		}
 	}
 }
+
+TEST_CASE("Lazy log arguments are only evaluated if the message is emitted", "[Logging]")
+{
+	int numCalls = 0;
+	const auto arg = cadet::log::lazy([&]() { ++numCalls; return 42; });
+
+	SECTION("Filtered at compile time")
+	{
+		LOG_BASE(WarningLogger, Debug) << "Value: " << arg;
+		CHECK(numCalls == 0);
+	}
+
+	SECTION("Formatted")
+	{
+		std::stringstream ss;
+		ss << arg;
+		CHECK(numCalls == 1);
+		CHECK(ss.str() == "42");
+	}
+}
+
+TEST_CASE("Asynchronous log receiver forwards all messages in order", "[Logging]")
+{
+	const unsigned int nThreads = 4;
+	const unsigned int nMessages = 2000;
+
+	CollectingLogReceiver sink;
+	{
+		// Use a small buffer to exercise wrap-around and full buffer
+		cadet::AsyncLogReceiver alr(sink, 16);
+		CHECK(alr.capacity() == 16);
+
+		std::vector<std::thread> threads;
+		for (unsigned int t = 0; t < nThreads; ++t)
+		{
+			threads.emplace_back([&alr, t]()
+			{
+				for (unsigned int i = 0; i < nMessages; ++i)
+					alr.message(__FILE__, __func__, t, cadet::LogLevel::Trace, "Trace", std::to_string(i).c_str());
+			});
+		}
+
+		for (std::thread& th : threads)
+			th.join();
+
+		alr.flush();
+		CHECK(alr.numDropped() == 0);
+		CHECK(sink.messages.size() == nThreads * nMessages);
+	}
+
+	// Messages of each producer arrive in the order they have been emitted
+	std::vector<unsigned int> next(nThreads, 0);
+	for (std::size_t i = 0; i < sink.messages.size(); ++i)
+	{
+		const unsigned int t = sink.lines[i];
+		REQUIRE(t < nThreads);
+		CHECK(sink.messages[i] == std::to_string(next[t]));
+		++next[t];
+	}
+}
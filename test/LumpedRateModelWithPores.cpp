@@ -40,6 +40,18 @@ TEST_CASE("LRMP non-binding linear pulse vs analytic solution", "[LRMP],[Simulat
 	cadet::test::column::testAnalyticNonBindingBenchmark("LUMPED_RATE_MODEL_WITH_PORES", "/data/lrmp-nonBinding.data", false, 512, 6e-5, 1e-7);
 }
 
+TEST_CASE("LRMP linear pulse Laplace domain solution vs analytic solution", "[LRMP],[Laplace],[Analytic]")
+{
+	cadet::test::column::testLaplaceBenchmark("LUMPED_RATE_MODEL_WITH_PORES", "/data/lrmp-pulseBenchmark.data", true, 1e-7, 1e-6);
+	cadet::test::column::testLaplaceBenchmark("LUMPED_RATE_MODEL_WITH_PORES", "/data/lrmp-pulseBenchmark.data", false, 1e-7, 1e-6);
+}
+
+TEST_CASE("LRMP Laplace domain sensitivities vs FD", "[LRMP],[Laplace],[Sensitivity]")
+{
+	cadet::test::column::testLaplaceSensitivity("LUMPED_RATE_MODEL_WITH_PORES", true, 1e-5, 1e-3);
+	cadet::test::column::testLaplaceSensitivity("LUMPED_RATE_MODEL_WITH_PORES", false, 1e-5, 1e-3);
+}
+
 TEST_CASE("LRMP Jacobian forward vs backward flow", "[LRMP],[UnitOp],[Residual],[Jacobian],[AD]")
 {
 	// Test all WENO orders
@@ -296,3 +308,8 @@ TEST_CASE("LRMP multi particle types dynamic reactions time derivative Jacobian
 	cadet::JsonParameterProvider jpp = createColumnWithTwoCompLinearBindingThreeParticleTypes();
 	cadet::test::reaction::testTimeDerivativeJacobianDynamicReactionsFD(jpp, true, true, true, 1e-6, 1e-14, 8e-4);
 }
+
+TEST_CASE("LRMP parameter handles vs parameter IDs", "[LRMP],[Simulation],[Parameter]")
+{
+	cadet::test::column::testParameterHandles("LUMPED_RATE_MODEL_WITH_PORES");
+}
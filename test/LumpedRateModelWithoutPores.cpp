@@ -38,6 +38,18 @@ TEST_CASE("LRM non-binding linear pulse vs analytic solution", "[LRM],[Simulatio
 	cadet::test::column::testAnalyticNonBindingBenchmark("LUMPED_RATE_MODEL_WITHOUT_PORES", "/data/lrm-nonBinding.data", false, 1024, 2e-5, 1e-7);
 }
 
+TEST_CASE("LRM linear pulse Laplace domain solution vs analytic solution", "[LRM],[Laplace],[Analytic]")
+{
+	cadet::test::column::testLaplaceBenchmark("LUMPED_RATE_MODEL_WITHOUT_PORES", "/data/lrm-pulseBenchmark.data", true, 1e-7, 1e-6);
+	cadet::test::column::testLaplaceBenchmark("LUMPED_RATE_MODEL_WITHOUT_PORES", "/data/lrm-pulseBenchmark.data", false, 1e-7, 1e-6);
+}
+
+TEST_CASE("LRM Laplace domain sensitivities vs FD", "[LRM],[Laplace],[Sensitivity]")
+{
+	cadet::test::column::testLaplaceSensitivity("LUMPED_RATE_MODEL_WITHOUT_PORES", true, 1e-5, 1e-3);
+	cadet::test::column::testLaplaceSensitivity("LUMPED_RATE_MODEL_WITHOUT_PORES", false, 1e-5, 1e-3);
+}
+
 TEST_CASE("LRM Jacobian forward vs backward flow", "[LRM],[UnitOp],[Residual],[Jacobian],[AD]")
 {
 	// Test all WENO orders
@@ -146,3 +158,8 @@ TEST_CASE("LRM dynamic reactions time derivative Jacobian vs FD modified bulk",
 {
 	cadet::test::reaction::testTimeDerivativeJacobianDynamicReactionsFD("LUMPED_RATE_MODEL_WITHOUT_PORES", true, false, true, 1e-6, 1e-14, 8e-4);
 }
+
+TEST_CASE("LRM parameter handles vs parameter IDs", "[LRM],[Simulation],[Parameter]")
+{
+	cadet::test::column::testParameterHandles("LUMPED_RATE_MODEL_WITHOUT_PORES");
+}
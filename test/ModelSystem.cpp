@@ -109,6 +109,7 @@ namespace
 
 		virtual bool setSensitiveParameter(const cadet::ParameterId& pId, unsigned int adDirection, double adValue) { return false; }
 		virtual void setSensitiveParameterValue(const cadet::ParameterId& id, double value) { }
+		virtual bool resolveParameterStorage(const cadet::ParameterId& pId, std::vector<cadet::active*>& storage) { return true; }
 		virtual void clearSensParams() { }
 		virtual unsigned int numSensParams() const { return 0; }
 
@@ -135,6 +136,9 @@ namespace
 			return 0;
 		}
 
+		virtual void setAdaptiveLinearSolverTolerance(bool adaptive) CADET_NOEXCEPT { }
+		virtual unsigned long numLinearSolverIterations() const CADET_NOEXCEPT { return 0; }
+
 		virtual void prepareADvectors(const cadet::AdJacobianParams& adJac) const { }
 		virtual void initializeSensitivityStates(const std::vector<double*>& vecSensY) const { }
 
@@ -866,6 +870,116 @@ TEST_CASE("ModelSystem sensitivity Jacobians", "[ModelSystem],[Sensitivity]")
 	destroyModelBuilder(mb);
 }
 
+TEST_CASE("ModelSystem structural sensitivity pruning", "[ModelSystem],[Sensitivity]")
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	// Inlet (unit 1) feeds column (unit 0)
+	cadet::JsonParameterProvider jpp = createLinearBenchmark(false, false, "GENERAL_RATE_MODEL");
+
+	jpp.pushScope("solver");
+	jpp.pushScope("sections");
+	const std::vector<double> secTimes = jpp.getDoubleArray("SECTION_TIMES");
+	jpp.popScope();
+	jpp.popScope();
+
+	jpp.pushScope("model");
+	cadet::test::column::setNumAxialCells(jpp, 10);
+	cadet::IModelSystem* const cadSysFull = mb->createSystem(jpp);
+	REQUIRE(cadSysFull);
+	cadet::model::ModelSystem* const sysFull = reinterpret_cast<cadet::model::ModelSystem*>(cadSysFull);
+
+	jpp.pushScope("solver");
+	jpp.set("SENS_PRUNING", true);
+	jpp.popScope();
+
+	cadet::IModelSystem* const cadSysPruned = mb->createSystem(jpp);
+	REQUIRE(cadSysPruned);
+	cadet::model::ModelSystem* const sysPruned = reinterpret_cast<cadet::model::ModelSystem*>(cadSysPruned);
+
+	bool* const secCont = new bool[secTimes.size() - 1];
+	std::fill(secCont, secCont + secTimes.size() - 1, false);
+
+	cadet::ad::setDirections(cadet::ad::getMaxDirections());
+	const unsigned int nDof = sysPruned->numDofs();
+	cadet::active* adResPruned = new cadet::active[nDof];
+	cadet::active* adResFull = new cadet::active[nDof];
+
+	// Sensitivity 0 is owned by the column, sensitivity 1 by the inlet
+	const cadet::ParameterId colDisp = cadet::makeParamId(cadet::hashString("COL_DISPERSION"), 0, cadet::CompIndep, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, cadet::SectionIndep);
+	const cadet::ParameterId constCoeff = cadet::makeParamId(cadet::hashString("CONST_COEFF"), 1, 0, cadet::ParTypeIndep, cadet::BoundStateIndep, cadet::ReactionIndep, 0);
+
+	for (cadet::model::ModelSystem* sys : {sysPruned, sysFull})
+	{
+		sys->setupParallelization(cadet::util::getMaxThreads());
+		sys->setSectionTimes(secTimes.data(), secCont, secTimes.size() - 1);
+
+		cadet::active* const adRes = (sys == sysPruned) ? adResPruned : adResFull;
+		sys->prepareADvectors(cadet::AdJacobianParams{adRes, nullptr, 0});
+		REQUIRE(sys->setSensitiveParameter(colDisp, 0, 1.0));
+		REQUIRE(sys->setSensitiveParameter(constCoeff, 1, 1.0));
+		sys->notifyDiscontinuousSectionTransition(0.0, 0u, cadet::AdJacobianParams{adRes, nullptr, 0u});
+	}
+	delete[] secCont;
+
+	// The column does not feed the inlet
+	CHECK(!sysPruned->isSensitivityStructurallyZero(0, 0));
+	CHECK(sysPruned->isSensitivityStructurallyZero(0, 1));
+	CHECK(!sysPruned->isSensitivityStructurallyZero(1, 0));
+	CHECK(!sysPruned->isSensitivityStructurallyZero(1, 1));
+	CHECK(!sysFull->isSensitivityStructurallyZero(0, 1));
+
+	std::vector<double> y(nDof, 0.0);
+	std::vector<double> yDot(nDof, 0.0);
+	std::vector<double> yS0(nDof, 0.0);
+	std::vector<double> yS1(nDof, 0.0);
+	std::vector<double> ySdot0(nDof, 0.0);
+	std::vector<double> ySdot1(nDof, 0.0);
+	std::vector<double> resPruned(2 * nDof, 0.0);
+	std::vector<double> resFull(2 * nDof, 0.0);
+	std::vector<double> temp(3 * nDof, 0.0);
+
+	cadet::test::util::populate(y.data(), [](unsigned int idx) { return std::abs(std::sin(idx * 0.13)) + 1e-4; }, nDof);
+	cadet::test::util::populate(yDot.data(), [=](unsigned int idx) { return std::abs(std::sin((idx + nDof) * 0.13)) + 1e-4; }, nDof);
+	cadet::test::util::populate(yS0.data(), [](unsigned int idx) { return std::sin(idx * 0.37); }, nDof);
+	cadet::test::util::populate(yS1.data(), [](unsigned int idx) { return std::cos(idx * 0.21); }, nDof);
+	cadet::test::util::populate(ySdot0.data(), [](unsigned int idx) { return std::cos(idx * 0.17); }, nDof);
+	cadet::test::util::populate(ySdot1.data(), [](unsigned int idx) { return std::sin(idx * 0.29); }, nDof);
+
+	// Sensitivity 0 vanishes in the inlet, which follows the column in the state vector
+	const unsigned int inletOffset = sysPruned->getUnitOperationModel(0)->numDofs();
+	const unsigned int inletDofs = sysPruned->getUnitOperationModel(1)->numDofs();
+	std::fill_n(yS0.data() + inletOffset, inletDofs, 0.0);
+	std::fill_n(ySdot0.data() + inletOffset, inletDofs, 0.0);
+
+	const std::vector<const double*> yS = {yS0.data(), yS1.data()};
+	const std::vector<const double*> ySdot = {ySdot0.data(), ySdot1.data()};
+	const std::vector<double*> resSPruned = {resPruned.data(), resPruned.data() + nDof};
+	const std::vector<double*> resSFull = {resFull.data(), resFull.data() + nDof};
+
+	const cadet::SimulationTime simTime{0.0, 0u};
+	const cadet::ConstSimulationState simState{y.data(), yDot.data()};
+	sysFull->residualWithJacobian(simTime, simState, temp.data(), cadet::AdJacobianParams{adResFull, nullptr, 0u});
+	sysPruned->residualWithJacobian(simTime, simState, temp.data(), cadet::AdJacobianParams{adResPruned, nullptr, 0u});
+
+	sysFull->residualSensFwd(2, simTime, simState, nullptr, yS, ySdot, resSFull, adResFull, temp.data(), temp.data() + nDof, temp.data() + 2 * nDof);
+	sysPruned->residualSensFwd(2, simTime, simState, nullptr, yS, ySdot, resSPruned, adResPruned, temp.data(), temp.data() + nDof, temp.data() + 2 * nDof);
+
+	for (unsigned int i = 0; i < 2 * nDof; ++i)
+	{
+		CAPTURE(i);
+		CHECK(resPruned[i] == resFull[i]);
+	}
+
+	CHECK(sysPruned->numSkippedSensitivityBlocks() == 1);
+	CHECK(sysFull->numSkippedSensitivityBlocks() == 0);
+
+	delete[] adResPruned;
+	delete[] adResFull;
+	destroyModelBuilder(mb);
+}
+
 TEST_CASE("ModelSystem coupling Jacobian linear chain single port (all) comp all", "[ModelSystem],[Jacobian],[Inlet]")
 {
 	const std::vector<unsigned int> sysDescription = {
@@ -1294,3 +1408,104 @@ TEST_CASE("ModelSystem coupling Jacobian component Y", "[ModelSystem],[Jacobian]
 
 	checkCouplingJacobian(sysDescription, connections, inFlow, outFlow);
 }
+
+TEST_CASE("ModelSystem thread budget distribution", "[ModelSystem],[Parallelization]")
+{
+	SECTION("More tasks than threads")
+	{
+		const std::vector<unsigned int> budget = cadet::util::distributeThreads({1.0, 5.0, 2.0}, 2);
+		CHECK(budget == std::vector<unsigned int>({1, 1, 1}));
+	}
+
+	SECTION("Proportional to weights")
+	{
+		const std::vector<unsigned int> budget = cadet::util::distributeThreads({1.0, 3.0, 4.0}, 8);
+		CHECK(budget == std::vector<unsigned int>({1, 3, 4}));
+	}
+
+	SECTION("Minimum of one thread and largest remainder")
+	{
+		const std::vector<unsigned int> budget = cadet::util::distributeThreads({0.01, 10.0, 5.0}, 6);
+		CHECK(budget == std::vector<unsigned int>({1, 3, 2}));
+	}
+
+	SECTION("Uniform for zero weights")
+	{
+		const std::vector<unsigned int> budget = cadet::util::distributeThreads({0.0, 0.0}, 4);
+		CHECK(budget == std::vector<unsigned int>({2, 2}));
+	}
+}
+
+TEST_CASE("ModelSystem residual with thread budgets matches shared threads", "[ModelSystem],[Parallelization]")
+{
+	cadet::IModelBuilder* const mb = cadet::createModelBuilder();
+	REQUIRE(nullptr != mb);
+
+	cadet::JsonParameterProvider jpp = createLinearBenchmark(false, false, "GENERAL_RATE_MODEL");
+
+	jpp.pushScope("solver");
+	jpp.pushScope("sections");
+	const std::vector<double> secTimes = jpp.getDoubleArray("SECTION_TIMES");
+	jpp.popScope();
+	jpp.popScope();
+
+	jpp.pushScope("model");
+	cadet::test::column::setNumAxialCells(jpp, 10);
+	cadet::IModelSystem* const cadSysShared = mb->createSystem(jpp);
+	REQUIRE(cadSysShared);
+	cadet::model::ModelSystem* const sysShared = reinterpret_cast<cadet::model::ModelSystem*>(cadSysShared);
+
+	jpp.pushScope("solver");
+	jpp.set("THREAD_BUDGET_MODE", 2);
+	jpp.popScope();
+
+	cadet::IModelSystem* const cadSysBudget = mb->createSystem(jpp);
+	REQUIRE(cadSysBudget);
+	cadet::model::ModelSystem* const sysBudget = reinterpret_cast<cadet::model::ModelSystem*>(cadSysBudget);
+
+	sysShared->setupParallelization(cadet::util::getMaxThreads());
+	sysBudget->setupParallelization(cadet::util::getMaxThreads());
+
+	bool* const secCont = new bool[secTimes.size() - 1];
+	std::fill(secCont, secCont + secTimes.size() - 1, false);
+	sysShared->setSectionTimes(secTimes.data(), secCont, secTimes.size() - 1);
+	sysBudget->setSectionTimes(secTimes.data(), secCont, secTimes.size() - 1);
+	delete[] secCont;
+
+	const cadet::AdJacobianParams noParams{nullptr, nullptr, 0u};
+	const unsigned int nDof = sysShared->numDofs();
+	std::vector<double> y(nDof, 0.0);
+	std::vector<double> yDot(nDof, 0.0);
+	std::vector<double> resShared(nDof, 0.0);
+	std::vector<double> resBudget(nDof, 0.0);
+
+	cadet::test::util::populate(y.data(), [](unsigned int idx) { return std::abs(std::sin(idx * 0.13)) + 1e-4; }, nDof);
+	cadet::test::util::populate(yDot.data(), [=](unsigned int idx) { return std::abs(std::sin((idx + nDof) * 0.13)) + 1e-4; }, nDof);
+
+	for (unsigned int sec = 0; sec < 2; ++sec)
+	{
+		// Second section transition rebalances thread budgets based on measured cost
+		sysShared->notifyDiscontinuousSectionTransition(secTimes[sec], sec, noParams);
+		sysBudget->notifyDiscontinuousSectionTransition(secTimes[sec], sec, noParams);
+
+		const cadet::SimulationTime simTime{secTimes[sec], sec};
+		sysShared->residualWithJacobian(simTime, cadet::ConstSimulationState{y.data(), yDot.data()}, resShared.data(), noParams);
+		sysBudget->residualWithJacobian(simTime, cadet::ConstSimulationState{y.data(), yDot.data()}, resBudget.data(), noParams);
+
+		for (unsigned int i = 0; i < nDof; ++i)
+			CHECK(resBudget[i] == resShared[i]);
+
+		unsigned int totalThreads = 0;
+		for (unsigned int i = 0; i < sysBudget->numModels(); ++i)
+		{
+			CHECK(sysBudget->unitThreadBudget(i) >= 1);
+			CHECK(sysBudget->unitUtilization(i) >= 0.0);
+			CHECK(sysBudget->unitUtilization(i) <= 1.0);
+			totalThreads += sysBudget->unitThreadBudget(i);
+		}
+		CHECK(totalThreads == std::max(cadet::util::getMaxThreads(), sysBudget->numModels()));
+	}
+
+	// Systems are owned and destroyed by the model builder
+	destroyModelBuilder(mb);
+}
@@ -0,0 +1,171 @@
+// =============================================================================
+//  CADET - The Chromatography Analysis and Design Toolkit
+//
+//  Copyright © 2008-2020: The CADET Authors
+//            Please see the AUTHORS and CONTRIBUTORS file.
+//
+//  All rights reserved. This program and the accompanying materials
+//  are made available under the terms of the GNU Public License v3.0 (or, at
+//  your option, any later version) which accompanies this distribution, and
+//  is available at http://www.gnu.org/licenses/gpl.html
+// =============================================================================
+
+#include <catch.hpp>
+
+#include <vector>
+#include <cmath>
+
+#include "timeint/RadauIIA.hpp"
+
+namespace
+{
+	/**
+	 * @brief Linear index 1 DAE with a stiff component and known solution
+	 * @details The system reads
+	 *          @f[ \begin{aligned} \dot{y}_0 &= -y_0, \\ \dot{y}_1 &= -k (y_1 - y_0), \\ 0 &= y_2 - 2 y_0. \end{aligned} @f]
+	 *          With @f$ y(0) = (1, 1, 2) @f$, its solution is given by @f$ y_0 = e^{-t} @f$,
+	 *          @f$ y_1 = \frac{k}{k-1} e^{-t} - \frac{1}{k-1} e^{-kt} @f$, and @f$ y_2 = 2 e^{-t} @f$.
+	 */
+	class LinearDae : public cadet::timeint::IDaeSystem
+	{
+	public:
+		LinearDae(double k) : _k(k), _numRes(0), _numJac(0) { }
+
+		virtual int residual(double t, double const* y, double const* yDot, double* res)
+		{
+			res[0] = yDot[0] + y[0];
+			res[1] = yDot[1] + _k * (y[1] - y[0]);
+			res[2] = y[2] - 2.0 * y[0];
+			++_numRes;
+			return 0;
+		}
+
+		virtual int residualWithJacobian(double t, double const* y, double const* yDot, double* res)
+		{
+			// The Jacobian is constant
+			++_numJac;
+			return residual(t, y, yDot, res);
+		}
+
+		virtual void multiplyWithDerivativeJacobian(double const* x, double* z)
+		{
+			z[0] = x[0];
+			z[1] = x[1];
+			z[2] = 0.0;
+		}
+
+		virtual int linearSolve(double alpha, double tol, double* rhs, double const* weight)
+		{
+			// Lower triangular system (dF/dy + alpha * dF/dyDot) x = rhs
+			rhs[0] = rhs[0] / (1.0 + alpha);
+			rhs[1] = (rhs[1] + _k * rhs[0]) / (_k + alpha);
+			rhs[2] = rhs[2] + 2.0 * rhs[0];
+			return 0;
+		}
+
+		static void solution(double k, double t, double* y, double* yDot)
+		{
+			const double e = std::exp(-t);
+			const double ek = std::exp(-k * t);
+			y[0] = e;
+			y[1] = k / (k - 1.0) * e - ek / (k - 1.0);
+			y[2] = 2.0 * e;
+			yDot[0] = -e;
+			yDot[1] = -k / (k - 1.0) * e + k * ek / (k - 1.0);
+			yDot[2] = -2.0 * e;
+		}
+
+		inline unsigned int numResiduals() const { return _numRes; }
+		inline unsigned int numJacobians() const { return _numJac; }
+
+	protected:
+		double _k;
+		unsigned int _numRes;
+		unsigned int _numJac;
+	};
+
+	/**
+	 * @brief Integrates the linear DAE and returns the maximum absolute error at the output times
+	 * @param [in] k Stiffness coefficient
+	 * @param [in] tol Relative and absolute tolerance
+	 * @param [in] dense Determines whether dense output is used or the integrator stops at each output time
+	 * @param [out] nSteps Number of time steps
+	 * @return Maximum absolute error
+	 */
+	inline double integrateLinearDae(double k, double tol, bool dense, unsigned long& nSteps)
+	{
+		LinearDae dae(k);
+		cadet::timeint::RadauIIA radau;
+		radau.initialize(3);
+		radau.setTolerances(tol, &tol, false);
+
+		std::vector<double> y(3);
+		std::vector<double> yDot(3);
+		std::vector<double> ref(3);
+		std::vector<double> refDot(3);
+		LinearDae::solution(k, 0.0, y.data(), yDot.data());
+		radau.reinit(0.0, y.data(), yDot.data(), 1e-6);
+
+		const double tEnd = 5.0;
+		double maxErr = 0.0;
+		for (unsigned int i = 1; i <= 50; ++i)
+		{
+			const double tOut = 0.1 * i;
+			if (dense)
+			{
+				REQUIRE(radau.advance(dae, tOut, tEnd) == cadet::timeint::RadauIIA::Status::Success);
+				radau.interpolate(tOut, y.data(), yDot.data());
+			}
+			else
+			{
+				REQUIRE(radau.advance(dae, tOut, tOut) == cadet::timeint::RadauIIA::Status::Success);
+				CHECK(radau.time() == tOut);
+				std::copy(radau.state(), radau.state() + 3, y.begin());
+			}
+
+			LinearDae::solution(k, tOut, ref.data(), refDot.data());
+			for (unsigned int j = 0; j < 3; ++j)
+				maxErr = std::max(maxErr, std::abs(y[j] - ref[j]));
+		}
+
+		CHECK(dae.numJacobians() >= radau.numSteps());
+		nSteps = radau.numSteps();
+		return maxErr;
+	}
+}
+
+TEST_CASE("RadauIIA integrates linear DAE", "[RadauIIA],[TimeIntegrator]")
+{
+	SECTION("Stop at output times")
+	{
+		unsigned long nSteps = 0;
+		CHECK(integrateLinearDae(1e3, 1e-6, false, nSteps) <= 1e-6);
+	}
+	SECTION("Dense output")
+	{
+		unsigned long nSteps = 0;
+		// Collocation polynomial is of lower order than the method
+		CHECK(integrateLinearDae(1e3, 1e-6, true, nSteps) <= 1e-5);
+	}
+	SECTION("Very stiff")
+	{
+		unsigned long nSteps = 0;
+		CHECK(integrateLinearDae(1e8, 1e-6, true, nSteps) <= 1e-5);
+	}
+}
+
+TEST_CASE("RadauIIA error decreases with tolerance", "[RadauIIA],[TimeIntegrator]")
+{
+	unsigned long nStepsLoose = 0;
+	unsigned long nStepsTight = 0;
+	const double errLoose = integrateLinearDae(1e3, 1e-4, true, nStepsLoose);
+	const double errTight = integrateLinearDae(1e3, 1e-10, true, nStepsTight);
+
+	CHECK(errLoose <= 1e-3);
+	CHECK(errTight <= 1e-7);
+	CHECK(errTight < errLoose);
+
+	// Fifth order method only needs few additional steps
+	CHECK(nStepsTight > nStepsLoose);
+	CHECK(nStepsTight < 20 * nStepsLoose);
+}